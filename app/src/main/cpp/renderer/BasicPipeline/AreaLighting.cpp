@@ -0,0 +1,610 @@
+/**
+ * @file AreaLighting.cpp
+ * @brief 区域光 LTC 着色实现
+ */
+
+#include "AreaLighting.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/** GL_RGBA32F */
+constexpr uint32_t kGlRgba32f = 0x8814;
+
+// ============================================================================
+// LTC 空间
+// ============================================================================
+
+/**
+ * @brief M⁻¹（只有 4 个可变元素，第二行为 (0, 1, 0)）
+ */
+struct LtcInverse {
+    float m00 = 1.0f, m02 = 0.0f, m20 = 0.0f, m22 = 1.0f;
+
+    static LtcInverse fromTexel(const Vector4& t) { return {t.x, t.z, t.y, t.w}; }
+
+    Vector3 apply(const Vector3& v) const {
+        return Vector3(m00 * v.x + m02 * v.z, v.y, m20 * v.x + m22 * v.z);
+    }
+};
+
+/** 光源在着色点局部坐标（T1, T2, N）中的形状 */
+struct LocalShape {
+    AreaLightShape shape;
+    Vector3 center;
+
+    /** 半宽、半高方向（长度为半轴） */
+    Vector3 axisX;
+    Vector3 axisY;
+};
+
+/** 一条边对向量形状因子的贡献 cross(v1, v2) θ / (2π sinθ)（v1、v2 为单位向量，有理近似） */
+Vector3 integrateEdge(const Vector3& v1, const Vector3& v2) {
+    const float x = glm::dot(v1, v2);
+    const float y = std::fabs(x);
+    const float a = 0.8543985f + (0.4965155f + 0.0145206f * y) * y;
+    const float b = 3.4175940f + (4.1616724f + y) * y;
+    const float v = a / b;
+    const float thetaSinTheta = x > 0.0f ? v : 0.5f / std::sqrt(std::max(1.0f - x * x, 1e-7f)) - v;
+    return glm::cross(v1, v2) * thetaSinTheta;
+}
+
+/**
+ * @brief 三次方程 c0 + c1 x + c2 x² + c3 x³ = 0 的三个实根（Blinn 2007），y 为最小根
+ */
+Vector3 solveCubic(float c0, float c1, float c2, float c3) {
+    // 归一化，中间两个系数除以 3
+    c0 /= c3;
+    c1 /= c3 * 3.0f;
+    c2 /= c3 * 3.0f;
+
+    const float A = 1.0f;
+    const float B = c2;
+    const float C = c1;
+    const float D = c0;
+
+    // Hessian 与判别式
+    const Vector3 delta(-c2 * c2 + c1, -c1 * c2 + c0, c2 * c0 - c1 * c1);
+    const float discriminant = 4.0f * delta.x * delta.z - delta.y * delta.y;
+    const float sqrtDiscriminant = std::sqrt(std::max(discriminant, 0.0f));
+
+    // 算法 A: 最大根
+    Vector2 xlc;
+    {
+        const float cA = delta.x;
+        const float dA = -2.0f * B * delta.x + delta.y;
+        const float theta = std::atan2(sqrtDiscriminant, -dA) / 3.0f;
+        const float x1 = 2.0f * std::sqrt(std::max(-cA, 0.0f)) * std::cos(theta);
+        const float x3 = 2.0f * std::sqrt(std::max(-cA, 0.0f)) * std::cos(theta + (2.0f / 3.0f) * kPi);
+        const float xl = (x1 + x3) > 2.0f * B ? x1 : x3;
+        xlc = Vector2(xl - B, A);
+    }
+
+    // 算法 D: 最小根
+    Vector2 xsc;
+    {
+        const float cD = delta.z;
+        const float dD = -D * delta.y + 2.0f * C * delta.z;
+        const float theta = std::atan2(D * sqrtDiscriminant, -dD) / 3.0f;
+        const float x1 = 2.0f * std::sqrt(std::max(-cD, 0.0f)) * std::cos(theta);
+        const float x3 = 2.0f * std::sqrt(std::max(-cD, 0.0f)) * std::cos(theta + (2.0f / 3.0f) * kPi);
+        const float xs = x1 + x3 < 2.0f * C ? x1 : x3;
+        xsc = Vector2(-D, xs + C);
+    }
+
+    const float E = xlc.y * xsc.y;
+    const float F = -xlc.x * xsc.y - xlc.y * xsc.x;
+    const float G = xlc.x * xsc.x;
+    const Vector2 xmc(C * F - B * G, -B * F + C * E);
+
+    Vector3 root(xsc.x / xsc.y, xmc.x / xmc.y, xlc.x / xlc.y);
+    if (root.x < root.y && root.x < root.z) {
+        root = Vector3(root.y, root.x, root.z);
+    } else if (root.z < root.x && root.z < root.y) {
+        root = Vector3(root.x, root.z, root.y);
+    }
+    return root;
+}
+
+/**
+ * @brief 把四边形裁剪到 z >= 0 的半空间（Heitz 2016），返回裁剪后的顶点数（0、3、4 或 5）
+ */
+uint32_t clipQuadToHorizon(Vector3 L[5]) {
+    uint32_t config = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (L[i].z > 0.0f) {
+            config |= 1u << i;
+        }
+    }
+
+    // 交点: a 在地平线上方、b 在下方（或相反）
+    auto cut = [](const Vector3& a, const Vector3& b) { return -b.z * a + a.z * b; };
+
+    uint32_t count = 0;
+    switch (config) {
+        case 0:
+            break;
+        case 1:  // V1
+            count = 3;
+            L[1] = cut(L[0], L[1]);
+            L[2] = cut(L[0], L[3]);
+            break;
+        case 2:  // V2
+            count = 3;
+            L[0] = cut(L[1], L[0]);
+            L[2] = cut(L[1], L[2]);
+            break;
+        case 3:  // V1 V2
+            count = 4;
+            L[2] = cut(L[1], L[2]);
+            L[3] = cut(L[0], L[3]);
+            break;
+        case 4:  // V3
+            count = 3;
+            L[0] = cut(L[2], L[3]);
+            L[1] = cut(L[2], L[1]);
+            break;
+        case 5:  // V1 V3 不可能出现
+            break;
+        case 6:  // V2 V3
+            count = 4;
+            L[0] = cut(L[1], L[0]);
+            L[3] = cut(L[2], L[3]);
+            break;
+        case 7:  // V1 V2 V3
+            count = 5;
+            L[4] = cut(L[0], L[3]);
+            L[3] = cut(L[2], L[3]);
+            break;
+        case 8:  // V4
+            count = 3;
+            L[0] = cut(L[3], L[0]);
+            L[1] = cut(L[3], L[2]);
+            L[2] = L[3];
+            break;
+        case 9:  // V1 V4
+            count = 4;
+            L[1] = cut(L[0], L[1]);
+            L[2] = cut(L[3], L[2]);
+            break;
+        case 10:  // V2 V4 不可能出现
+            break;
+        case 11:  // V1 V2 V4
+            count = 5;
+            L[4] = L[3];
+            L[3] = cut(L[3], L[2]);
+            L[2] = cut(L[1], L[2]);
+            break;
+        case 12:  // V3 V4
+            count = 4;
+            L[1] = cut(L[2], L[1]);
+            L[0] = cut(L[3], L[0]);
+            break;
+        case 13:  // V1 V3 V4
+            count = 5;
+            L[4] = L[3];
+            L[3] = L[2];
+            L[2] = cut(L[2], L[1]);
+            L[1] = cut(L[0], L[1]);
+            break;
+        case 14:  // V2 V3 V4
+            count = 5;
+            L[4] = cut(L[3], L[0]);
+            L[0] = cut(L[1], L[0]);
+            break;
+        case 15:
+            count = 4;
+            break;
+    }
+    return count;
+}
+
+/** 地平线裁剪比例: 表的 .w（table 为 nullptr 时解析计算） */
+float horizonClip(const LtcTable* table, float z, float formFactor) {
+    if (table) {
+        return formFactor * table->sampleAmplitude(z * 0.5f + 0.5f, formFactor).w;
+    }
+    return GetHorizonClippedSphereFormFactor(z, formFactor);
+}
+
+/**
+ * @brief 经 M⁻¹ 变换后的形状对钳位余弦分布的积分（地平线裁剪后的形状因子）
+ */
+float integrateShape(const LocalShape& local, const LtcInverse& inverse, const LtcTable* table) {
+    if (local.shape == AreaLightShape::Rectangle) {
+        Vector3 corners[5] = {
+            inverse.apply(local.center - local.axisX - local.axisY),
+            inverse.apply(local.center + local.axisX - local.axisY),
+            inverse.apply(local.center + local.axisX + local.axisY),
+            inverse.apply(local.center - local.axisX + local.axisY),
+        };
+        const uint32_t count = clipQuadToHorizon(corners);
+        if (count == 0) {
+            return 0.0f;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            corners[i] = glm::normalize(corners[i]);
+        }
+        Vector3 sum(0.0f);
+        for (uint32_t i = 0; i < count; ++i) {
+            sum += integrateEdge(corners[i], corners[(i + 1) % count]);
+        }
+
+        // 绕向随着色点在正面还是背面而反转
+        return std::fabs(sum.z);
+    }
+
+    // 椭圆: 中心与两个半轴
+    const Vector3 C = inverse.apply(local.center);
+    Vector3 V1 = inverse.apply(local.axisX);
+    Vector3 V2 = inverse.apply(local.axisY);
+
+    // 半轴的 Gram 矩阵特征分解，得到正交的主轴
+    float a, b;
+    const float d11 = glm::dot(V1, V1);
+    const float d22 = glm::dot(V2, V2);
+    const float d12 = glm::dot(V1, V2);
+    if (std::fabs(d12) / std::sqrt(d11 * d22) > 0.0001f) {
+        const float trace = d11 + d22;
+        const float det = std::sqrt(std::max(-d12 * d12 + d11 * d22, 0.0f));
+        const float u = 0.5f * std::sqrt(std::max(trace - 2.0f * det, 0.0f));
+        const float v = 0.5f * std::sqrt(trace + 2.0f * det);
+        const float eMax = (u + v) * (u + v);
+        const float eMin = (u - v) * (u - v);
+
+        Vector3 V1p, V2p;
+        if (d11 > d22) {
+            V1p = d12 * V1 + (eMax - d11) * V2;
+            V2p = d12 * V1 + (eMin - d11) * V2;
+        } else {
+            V1p = d12 * V2 + (eMax - d22) * V1;
+            V2p = d12 * V2 + (eMin - d22) * V1;
+        }
+        a = 1.0f / eMax;
+        b = 1.0f / eMin;
+        V1 = glm::normalize(V1p);
+        V2 = glm::normalize(V2p);
+    } else {
+        a = 1.0f / d11;
+        b = 1.0f / d22;
+        V1 *= std::sqrt(a);
+        V2 *= std::sqrt(b);
+    }
+
+    Vector3 V3 = glm::cross(V1, V2);
+    if (glm::dot(C, V3) < 0.0f) {
+        V3 = -V3;
+    }
+
+    const float L = glm::dot(V3, C);
+    if (!(L > 0.0f)) {
+        return 0.0f;
+    }
+    const float x0 = glm::dot(V1, C) / L;
+    const float y0 = glm::dot(V2, C) / L;
+    a *= L * L;
+    b *= L * L;
+
+    // 等效球体: 以椭圆锥的特征值求平均方向与形状因子
+    const float c0 = a * b;
+    const float c1 = a * b * (1.0f + x0 * x0 + y0 * y0) - a - b;
+    const float c2 = 1.0f - a * (1.0f + x0 * x0) - b * (1.0f + y0 * y0);
+    const Vector3 roots = solveCubic(c0, c1, c2, 1.0f);
+    const float e1 = roots.x;
+    const float e2 = roots.y;
+    const float e3 = roots.z;
+
+    Vector3 averageDirection(a * x0 / (a - e2), b * y0 / (b - e2), 1.0f);
+    averageDirection = glm::normalize(V1 * averageDirection.x + V2 * averageDirection.y + V3 * averageDirection.z);
+
+    const float L1 = std::sqrt(-e2 / e3);
+    const float L2 = std::sqrt(-e2 / e1);
+    const float formFactor = L1 * L2 / std::sqrt((1.0f + L1 * L1) * (1.0f + L2 * L2));
+    if (!(formFactor > 0.0f) || !(averageDirection.z == averageDirection.z)) {
+        return 0.0f;
+    }
+    return horizonClip(table, averageDirection.z, std::min(formFactor, 1.0f));
+}
+
+/** 着色点局部坐标系（T1 在 N、V 平面内）中的光源形状；背面且单面时返回 false */
+bool makeLocalShape(const LightData& light, const Vector3& position, const Vector3& normal, const Vector3& view,
+                    LocalShape& local) {
+    if (glm::dot(light.direction, position - light.position) <= 0.0f && !light.areaTwoSided) {
+        return false;
+    }
+
+    Vector3 t1 = view - normal * glm::dot(view, normal);
+    if (glm::dot(t1, t1) < 1e-8f) {
+        t1 = std::fabs(normal.x) < 0.9f ? Vector3(1.0f, 0.0f, 0.0f) : Vector3(0.0f, 1.0f, 0.0f);
+        t1 = t1 - normal * glm::dot(t1, normal);
+    }
+    t1 = glm::normalize(t1);
+    const Vector3 t2 = glm::cross(normal, t1);
+    auto toLocal = [&](const Vector3& v) { return Vector3(glm::dot(v, t1), glm::dot(v, t2), glm::dot(v, normal)); };
+
+    const Vector3 bitangent = glm::cross(light.direction, light.areaTangent);
+    local.shape = light.areaShape;
+    local.center = toLocal(light.position - position);
+    local.axisX = toLocal(light.areaTangent * (0.5f * light.areaSize.x));
+    local.axisY = toLocal(bitangent * (0.5f * light.areaSize.y));
+    return true;
+}
+
+Vector4 sampleBilinear(const TaggedVector<Vector4, MemoryTag::Lighting>& texels, uint32_t size, float u, float v) {
+    const float x = std::clamp(u, 0.0f, 1.0f) * static_cast<float>(size - 1);
+    const float y = std::clamp(v, 0.0f, 1.0f) * static_cast<float>(size - 1);
+    const uint32_t x0 = std::min(static_cast<uint32_t>(x), size - 2);
+    const uint32_t y0 = std::min(static_cast<uint32_t>(y), size - 2);
+    const float fx = x - static_cast<float>(x0);
+    const float fy = y - static_cast<float>(y0);
+
+    const Vector4* row0 = &texels[static_cast<size_t>(y0) * size];
+    const Vector4* row1 = row0 + size;
+    const Vector4 top = row0[x0] * (1.0f - fx) + row0[x0 + 1] * fx;
+    const Vector4 bottom = row1[x0] * (1.0f - fx) + row1[x0 + 1] * fx;
+    return top * (1.0f - fy) + bottom * fy;
+}
+
+bool readUint32(FILE* file, uint32_t& value) {
+    return std::fread(&value, sizeof(value), 1, file) == 1;
+}
+
+/** 读取单 mip 的 RGBA32F KTX 1.1 */
+bool readKtxRgba32f(const char* path, uint32_t& size, TaggedVector<Vector4, MemoryTag::Lighting>& texels) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    static const uint8_t identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    uint8_t header[12];
+    uint32_t fields[13];
+    bool ok = std::fread(header, sizeof(header), 1, file) == 1 && !std::memcmp(header, identifier, sizeof(header));
+    for (uint32_t& field : fields) {
+        ok = ok && readUint32(file, field);
+    }
+
+    // endianness, glType, glTypeSize, glFormat, glInternalFormat, glBaseInternalFormat, width, height, ...
+    const uint32_t width = fields[6];
+    const uint32_t height = fields[7];
+    ok = ok && fields[0] == 0x04030201 && fields[4] == kGlRgba32f && width == height && width >= 2;
+    ok = ok && std::fseek(file, static_cast<long>(fields[12]), SEEK_CUR) == 0;
+
+    uint32_t imageSize = 0;
+    ok = ok && readUint32(file, imageSize) && imageSize == static_cast<size_t>(width) * height * sizeof(Vector4);
+    if (ok) {
+        texels.resize(static_cast<size_t>(width) * height);
+        for (Vector4& texel : texels) {
+            float rgba[4];
+            ok = ok && std::fread(rgba, sizeof(rgba), 1, file) == 1;
+            texel = Vector4(rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+        size = width;
+    }
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace
+
+// ============================================================================
+// LtcTable
+// ============================================================================
+
+Vector4 LtcTable::sampleMatrix(float u, float v) const {
+    return sampleBilinear(matrix, size, u, v);
+}
+
+Vector4 LtcTable::sampleAmplitude(float u, float v) const {
+    return sampleBilinear(amplitude, size, u, v);
+}
+
+bool ReadLtcTableKtx(const char* matrixPath, const char* amplitudePath, LtcTable& table) {
+    uint32_t matrixSize = 0;
+    uint32_t amplitudeSize = 0;
+    if (!readKtxRgba32f(matrixPath, matrixSize, table.matrix)
+        || !readKtxRgba32f(amplitudePath, amplitudeSize, table.amplitude) || matrixSize != amplitudeSize) {
+        table = LtcTable();
+        return false;
+    }
+    table.size = matrixSize;
+    return true;
+}
+
+// ============================================================================
+// 几何
+// ============================================================================
+
+void GetAreaLightCorners(const LightData& light, Vector3 corners[4]) {
+    const Vector3 axisX = light.areaTangent * (0.5f * light.areaSize.x);
+    const Vector3 axisY = glm::cross(light.direction, light.areaTangent) * (0.5f * light.areaSize.y);
+    corners[0] = light.position - axisX - axisY;
+    corners[1] = light.position + axisX - axisY;
+    corners[2] = light.position + axisX + axisY;
+    corners[3] = light.position - axisX + axisY;
+}
+
+float GetAreaLightWindow(const LightData& light, const Vector3& position) {
+    const Vector3 offset = position - light.position;
+    const float ratio2 = glm::dot(offset, offset) / std::max(light.range * light.range, 1e-8f);
+    const float window = std::clamp(1.0f - ratio2 * ratio2, 0.0f, 1.0f);
+    return window * window;
+}
+
+float GetHorizonClippedSphereFormFactor(float cosTheta, float formFactor) {
+    const float sinSigma2 = std::min(formFactor, 0.9999f);
+    if (!(sinSigma2 > 0.0f)) {
+        return 0.0f;
+    }
+    cosTheta = std::clamp(cosTheta, -1.0f, 1.0f);
+
+    // 整个球体在地平线上方（或下方）
+    if (cosTheta * cosTheta > sinSigma2) {
+        return sinSigma2 * std::max(cosTheta, 0.0f);
+    }
+
+    const float sinTheta = std::sqrt(std::max(1.0f - cosTheta * cosTheta, 1e-8f));
+    const float x = std::sqrt(1.0f / sinSigma2 - 1.0f);
+    const float y = std::clamp(-x * cosTheta / sinTheta, -1.0f, 1.0f);
+    const float sinThetaSqrtY = sinTheta * std::sqrt(1.0f - y * y);
+    const float illuminance = (cosTheta * std::acos(y) - x * sinThetaSqrtY) * sinSigma2
+                            + std::atan(sinThetaSqrtY / x);
+    return std::max(illuminance, 0.0f) / kPi;
+}
+
+// ============================================================================
+// 着色
+// ============================================================================
+
+float EvaluateAreaLightFormFactor(const LightData& light, const Vector3& position, const Vector3& normal) {
+    const float window = GetAreaLightWindow(light, position);
+    LocalShape local;
+    if (!(window > 0.0f) || !makeLocalShape(light, position, normal, normal, local)) {
+        return 0.0f;
+    }
+    return integrateShape(local, LtcInverse(), nullptr) * window;
+}
+
+AreaLightShading EvaluateAreaLightLtc(const LightData& light, const LtcTable& table, const Vector3& position,
+                                      const Vector3& normal, const Vector3& view, float perceptualRoughness,
+                                      const Vector3& F0) {
+    AreaLightShading shading;
+    const float window = GetAreaLightWindow(light, position);
+    LocalShape local;
+    if (!(window > 0.0f) || !table.isValid() || !makeLocalShape(light, position, normal, view, local)) {
+        return shading;
+    }
+
+    const float NdotV = std::clamp(glm::dot(normal, view), 0.0f, 1.0f);
+    const float u = std::clamp(perceptualRoughness, 0.0f, 1.0f);
+    const float v = std::sqrt(1.0f - NdotV);
+    const LtcInverse inverse = LtcInverse::fromTexel(table.sampleMatrix(u, v));
+    const Vector4 amplitude = table.sampleAmplitude(u, v);
+
+    const Vector3 radiance = light.color * (light.intensity * window);
+    const float diffuse = integrateShape(local, LtcInverse(), &table);
+    const float specular = integrateShape(local, inverse, &table);
+
+    shading.diffuse = radiance * diffuse;
+    shading.specular = radiance * specular * (F0 * amplitude.x + (Vector3(1.0f) - F0) * amplitude.y);
+    return shading;
+}
+
+AreaLightShading IntegrateAreaLightReference(const LightData& light, const Vector3& position, const Vector3& normal,
+                                             const Vector3& view, float perceptualRoughness, const Vector3& F0,
+                                             uint32_t sampleCount) {
+    AreaLightShading shading;
+    const float window = GetAreaLightWindow(light, position);
+    LocalShape local;
+    if (!(window > 0.0f) || !makeLocalShape(light, position, normal, view, local)) {
+        return shading;
+    }
+
+    const float alpha = std::max(perceptualRoughness * perceptualRoughness, 1e-4f);
+    const float NdotV = std::clamp(glm::dot(normal, view), 0.0f, 1.0f);
+    const Vector3 viewLocal(std::sqrt(1.0f - NdotV * NdotV), 0.0f, NdotV);
+
+    // 局部坐标中 axisX × axisY 平行于发光面法线
+    const Vector3 faceNormal = glm::normalize(glm::cross(local.axisX, local.axisY));
+
+    const bool disk = light.areaShape == AreaLightShape::Disk;
+    const float area = light.areaSize.x * light.areaSize.y * (disk ? 0.25f * kPi : 1.0f);
+    const uint32_t n = std::max(static_cast<uint32_t>(std::sqrt(static_cast<float>(sampleCount))), 1u);
+    const float sampleArea = area / static_cast<float>(n * n);
+
+    float diffuse = 0.0f;
+    Vector3 specular(0.0f);
+    for (uint32_t j = 0; j < n; ++j) {
+        for (uint32_t i = 0; i < n; ++i) {
+            float s = 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(n) - 1.0f;
+            float t = 2.0f * (static_cast<float>(j) + 0.5f) / static_cast<float>(n) - 1.0f;
+            if (disk) {
+                // 同心映射: 正方形 → 单位圆盘（保持面积均匀）
+                float r, phi;
+                if (s * s > t * t) {
+                    r = s;
+                    phi = 0.25f * kPi * (t / s);
+                } else {
+                    r = t;
+                    phi = t != 0.0f ? 0.5f * kPi - 0.25f * kPi * (s / t) : 0.0f;
+                }
+                s = r * std::cos(phi);
+                t = r * std::sin(phi);
+            }
+
+            // 局部坐标中的采样点与方向
+            const Vector3 point = local.center + local.axisX * s + local.axisY * t;
+            const float distance2 = glm::dot(point, point);
+            if (!(distance2 > 0.0f)) {
+                continue;
+            }
+            const Vector3 direction = point / std::sqrt(distance2);
+            if (direction.z <= 0.0f) {
+                continue;
+            }
+
+            const float cosLight = std::fabs(glm::dot(faceNormal, direction));
+            const float solidAngle = sampleArea * cosLight / distance2;
+
+            diffuse += direction.z / kPi * solidAngle;
+
+            const Vector3 half = glm::normalize(viewLocal + direction);
+            const float fresnelWeight = std::pow(1.0f - std::clamp(glm::dot(viewLocal, half), 0.0f, 1.0f), 5.0f);
+            const Vector3 fresnel = F0 + (Vector3(1.0f) - F0) * fresnelWeight;
+            specular += fresnel * (EvaluateGgxCosine(viewLocal, direction, alpha) * solidAngle);
+        }
+    }
+
+    const Vector3 radiance = light.color * (light.intensity * window);
+    shading.diffuse = radiance * diffuse;
+    shading.specular = radiance * specular;
+    return shading;
+}
+
+float EvaluateGgxCosine(const Vector3& view, const Vector3& light, float alpha, float* pdf) {
+    if (pdf) {
+        *pdf = 0.0f;
+    }
+    if (view.z <= 0.0f) {
+        return 0.0f;
+    }
+
+    // Smith Λ（GGX）
+    auto lambda = [alpha](float cosTheta) {
+        if (cosTheta >= 1.0f) {
+            return 0.0f;
+        }
+        const float tan2 = (1.0f - cosTheta * cosTheta) / (cosTheta * cosTheta);
+        return 0.5f * (-1.0f + std::sqrt(1.0f + alpha * alpha * tan2));
+    };
+
+    // 高度相关的遮蔽-阴影
+    const float G2 = light.z > 0.0f ? 1.0f / (1.0f + lambda(view.z) + lambda(light.z)) : 0.0f;
+
+    const Vector3 half = glm::normalize(view + light);
+    if (!(half.z > 0.0f)) {
+        return 0.0f;
+    }
+    const float slopeX = half.x / half.z;
+    const float slopeY = half.y / half.z;
+    float D = 1.0f / (1.0f + (slopeX * slopeX + slopeY * slopeY) / (alpha * alpha));
+    D = D * D / (kPi * alpha * alpha * half.z * half.z * half.z * half.z);
+
+    if (pdf) {
+        *pdf = std::fabs(D * half.z / (4.0f * glm::dot(view, half)));
+    }
+    return D * G2 / (4.0f * view.z);
+}
+
+Vector3 SampleGgxDirection(const Vector3& view, float alpha, float u1, float u2) {
+    const float phi = 2.0f * kPi * u1;
+    const float r = alpha * std::sqrt(u2 / std::max(1.0f - u2, 1e-7f));
+    const Vector3 h = glm::normalize(Vector3(r * std::cos(phi), r * std::sin(phi), 1.0f));
+    return -view + h * (2.0f * glm::dot(h, view));
+}
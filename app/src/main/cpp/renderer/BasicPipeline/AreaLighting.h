@@ -0,0 +1,164 @@
+/**
+ * @file AreaLighting.h
+ * @brief 区域光（矩形 / 圆盘）- 线性变换余弦（LTC）着色的 CPU 实现与查找表
+ *
+ * LTC（Heitz et al. 2016）: GGX 的 BRDF·cos 波瓣用一个 3x3 矩阵 M 变换后的钳位余弦分布近似，
+ * 光源形状经 M⁻¹ 变换后对余弦分布的积分有解析解，每个像素每个光源只需两次查表:
+ * - ltc_1（matrix）: M⁻¹ 的 4 个非零可变元素（按 m11 归一化）
+ * - ltc_2（amplitude）: (BRDF 方向反照率 n, Schlick 菲涅尔项 f, 0, 地平线裁剪的球体形状因子比例)
+ * 两张表都以 u = 感知粗糙度、v = sqrt(1 - N·V) 索引（.w 例外，见下），由 LtcFitter 离线拟合，
+ * 以 RGBA32F KTX 纹理发布（assets 的 textures/LTC/），运行时与 PBRCommon.hlsl 共用
+ *
+ * 形状积分:
+ * - 矩形（Heitz 2016）: 四边形经 M⁻¹ 变换后精确裁剪到地平线以上（至多 5 个顶点），对边积分求和
+ * - 圆盘（Heitz & Hill 2017）: 椭圆经 M⁻¹ 变换后仍是椭圆，求等效球体的平均方向与形状因子，
+ *   查 ltc_2.w 得到地平线裁剪后的形状因子；.w 以 u = z * 0.5 + 0.5（z 为平均方向与法线夹角的余弦）、
+ *   v = 未裁剪的形状因子索引
+ *
+ * 约定:
+ * - 发光面辐射亮度为 color * intensity，光源以 range 为半径平滑截断（见 GetAreaLightWindow）
+ * - 光照贴图约定的值（LightingData::calculateLightingAtPoint）为 辐射亮度 × 漫反射形状因子
+ *   (1/π)∫ max(n·ω, 0) dω；覆盖整个半球的区域光与 N·L = 1 的定向光相同
+ * - 镜面项拟合的是高度相关 Smith 遮蔽的 GGX（α = 感知粗糙度²）
+ *
+ * 精度（镜面项相对 IntegrateAreaLightReference 的误差 Σ|差| / Σ参考，BasicPipelineLtcFit 的报告:
+ * 每个视角分段 1000 个随机矩形 / 圆盘光源；Benchmarks/Tests/AreaLightingTests.cpp 按粗糙度检查上限）:
+ *
+ *   粗糙度                           0.25    0.5   0.75    1.0
+ *   电介质 F0 = 0.04   视角 ≤ 45°     2.7%   5.8%   5.3%   5.0%
+ *                      N·V ≥ 0.5      3.2%  10.2%   8.9%   8.2%
+ *                      N·V 0.1-0.5    9.7%  26.3%  22.6%  22.6%
+ *   金属 F0 = 1        视角 ≤ 45°     2.4%   5.7%   4.2%   3.1%
+ *                      N·V ≥ 0.5      3.5%   9.9%   9.3%   5.3%
+ *                      N·V 0.1-0.5   15.5%  38.5%  48.0%  26.2%
+ *
+ * - 换一批随机光源，有效范围内的数字约变化 2-3 个百分点，掠射视角约 10 个百分点
+ * - 误差在粗糙度 0.5 附近最大: 波峰和长尾无法被同一个钳位余弦的线性变换同时逼近。
+ *   逐纹素多起点重新拟合得到同一个最优解，不是沿行预热的初值陷入了局部极小
+ * - 掠射视角的误差随视角增大，单个配置可偏高或偏低 2 倍以上: GGX 在地平线附近的遮蔽衰减
+ *   不是 LTC 能表示的。形状按 F0 = 0.1 的菲涅尔加权拟合（见 LtcFitter.h），金属在掠射视角因此偏差更大
+ * - 漫反射项不经过拟合，误差 < 1%
+ *
+ * 用法:
+ * @code
+ *
+ * LtcTable table;
+ * ReadLtcTableKtx("ltc_1.ktx", "ltc_2.ktx", table);
+ *
+ * AreaLightShading shading = EvaluateAreaLightLtc(light, table, position, normal, view, roughness, F0);
+ * Vector3 radiance = albedo * shading.diffuse + shading.specular;
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "LightingData.h"
+#include "MemoryTracker.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+
+/** 发布的 LTC 表边长 */
+constexpr uint32_t kLtcTableSize = 64;
+
+/** LTC 镜面项的有效范围: N·V 不低于该值（视角 ≤ 60°）时与参考积分的误差有上限（见文件头） */
+constexpr float kLtcMinValidNdotV = 0.5f;
+
+/**
+ * @brief LTC 查找表（两张 size x size 的 RGBA32F 纹理，行 = sqrt(1 - N·V)，列 = 感知粗糙度）
+ */
+struct LtcTable {
+    uint32_t size = 0;
+
+    /** ltc_1: (M⁻¹[0][0], M⁻¹[2][0], M⁻¹[0][2], M⁻¹[2][2])，行优先 */
+    TaggedVector<Vector4, MemoryTag::Lighting> matrix;
+
+    /** ltc_2: (方向反照率, 菲涅尔项, 0, 球体地平线裁剪比例)，行优先 */
+    TaggedVector<Vector4, MemoryTag::Lighting> amplitude;
+
+    bool isValid() const {
+        return size >= 2 && matrix.size() == size * size && amplitude.size() == size * size;
+    }
+
+    /**
+     * @brief 双线性采样（坐标 [0, 1]，端点对齐首尾纹素中心，同着色器的 LTC_LUT_SCALE / LTC_LUT_BIAS）
+     */
+    Vector4 sampleMatrix(float u, float v) const;
+    Vector4 sampleAmplitude(float u, float v) const;
+};
+
+/**
+ * @brief 读取 LtcFitter 写出的两张 KTX 纹理
+ * @return 文件不存在、格式不是 RGBA32F 或两张表尺寸不一致时返回 false
+ */
+bool ReadLtcTableKtx(const char* matrixPath, const char* amplitudePath, LtcTable& table);
+
+/**
+ * @brief 区域光着色结果（已乘光源辐射亮度与距离窗口）
+ */
+struct AreaLightShading {
+    /** 乘漫反射反照率后为出射辐射亮度 */
+    Vector3 diffuse = Vector3(0.0f);
+
+    /** 含 F0 的菲涅尔，直接为出射辐射亮度 */
+    Vector3 specular = Vector3(0.0f);
+};
+
+// ============================================================================
+// 几何
+// ============================================================================
+
+/**
+ * @brief 发光面的 4 个角点（圆盘为外接矩形），绕 direction 逆时针
+ */
+void GetAreaLightCorners(const LightData& light, Vector3 corners[4]);
+
+/**
+ * @brief 以 range 为半径的平滑截断 saturate(1 - (d / range)⁴)²，d 为到发光面中心的距离
+ */
+float GetAreaLightWindow(const LightData& light, const Vector3& position);
+
+/**
+ * @brief 球体（或其他形状的等效球体）经地平线裁剪的形状因子（Snyder 1996，解析）
+ * @param cosTheta 球心方向与法线夹角的余弦
+ * @param formFactor 未裁剪的形状因子 sin²σ（σ 为球体半角）
+ */
+float GetHorizonClippedSphereFormFactor(float cosTheta, float formFactor);
+
+// ============================================================================
+// 着色
+// ============================================================================
+
+/**
+ * @brief 漫反射形状因子 × 距离窗口（不需要查找表）
+ *
+ * 光照贴图约定的光照值为 color * intensity * 该值
+ */
+float EvaluateAreaLightFormFactor(const LightData& light, const Vector3& position, const Vector3& normal);
+
+/**
+ * @brief LTC 着色（与 PBRCommon.hlsl 的 CalculateAreaLighting 逐步一致）
+ * @param view 指向相机的单位向量
+ * @param perceptualRoughness 感知粗糙度（表的 u 坐标）
+ */
+AreaLightShading EvaluateAreaLightLtc(const LightData& light, const LtcTable& table, const Vector3& position,
+                                      const Vector3& normal, const Vector3& view, float perceptualRoughness,
+                                      const Vector3& F0);
+
+/**
+ * @brief 参考积分: 在发光面上分层采样 sampleCount 个点直接积分 Lambert 与 GGX（验证拟合与着色器）
+ */
+AreaLightShading IntegrateAreaLightReference(const LightData& light, const Vector3& position, const Vector3& normal,
+                                             const Vector3& view, float perceptualRoughness, const Vector3& F0,
+                                             uint32_t sampleCount = 4096);
+
+/**
+ * @brief LTC 拟合的目标函数: 局部坐标（法线为 +z）中 GGX 的 BRDF·cos
+ * @param pdf 可为 nullptr；输出 SampleGgxDirection 采样到 light 的概率密度
+ */
+float EvaluateGgxCosine(const Vector3& view, const Vector3& light, float alpha, float* pdf = nullptr);
+
+/**
+ * @brief 按 GGX 法线分布采样反射方向（局部坐标）
+ */
+Vector3 SampleGgxDirection(const Vector3& view, float alpha, float u1, float u2);
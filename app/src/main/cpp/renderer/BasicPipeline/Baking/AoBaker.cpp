@@ -0,0 +1,219 @@
+/**
+ * @file AoBaker.cpp
+ * @brief 环境光遮蔽烘焙器实现
+ */
+
+#include "AoBaker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+/** 每个工作项处理的顶点数 */
+constexpr uint32_t kVerticesPerTask = 64;
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+/** 世界空间的网格几何 */
+struct AoGeometry {
+    /** 每个网格的世界空间顶点、法线与三角形 */
+    std::vector<std::vector<Vector3>> meshPositions;
+    std::vector<std::vector<Vector3>> meshNormals;
+    std::vector<std::vector<uint32_t>> meshIndices;
+
+    uint32_t triangles = 0;
+};
+
+AoGeometry buildGeometry(const std::vector<BakeMesh>& meshes) {
+    AoGeometry geometry;
+    geometry.meshPositions.resize(meshes.size());
+    geometry.meshNormals.resize(meshes.size());
+    geometry.meshIndices.resize(meshes.size());
+
+    for (uint32_t m = 0; m < meshes.size(); ++m) {
+        const BakeMesh& mesh = meshes[m];
+        const Matrix4 normalMatrix = glm::transpose(glm::inverse(mesh.worldMatrix));
+
+        std::vector<Vector3>& positions = geometry.meshPositions[m];
+        positions.reserve(mesh.positions.size());
+        for (const Vector3& p : mesh.positions) {
+            positions.push_back(Vector3(mesh.worldMatrix * Vector4(p, 1.0f)));
+        }
+
+        // 没有法线时用面积加权的面法线
+        std::vector<Vector3>& normals = geometry.meshNormals[m];
+        const bool hasNormals = mesh.normals.size() == mesh.positions.size();
+        normals.assign(positions.size(), Vector3(0.0f));
+        for (uint32_t v = 0; hasNormals && v < mesh.normals.size(); ++v) {
+            normals[v] = Vector3(normalMatrix * Vector4(mesh.normals[v], 0.0f));
+        }
+
+        std::vector<uint32_t>& indices = geometry.meshIndices[m];
+        indices.reserve(mesh.indices.size());
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const uint32_t ia = mesh.indices[i + 0];
+            const uint32_t ib = mesh.indices[i + 1];
+            const uint32_t ic = mesh.indices[i + 2];
+            indices.push_back(ia);
+            indices.push_back(ib);
+            indices.push_back(ic);
+            if (!hasNormals) {
+                const Vector3 n = glm::cross(positions[ib] - positions[ia], positions[ic] - positions[ia]);
+                normals[ia] += n;
+                normals[ib] += n;
+                normals[ic] += n;
+            }
+        }
+        geometry.triangles += static_cast<uint32_t>(indices.size() / 3);
+
+        for (Vector3& n : normals) {
+            const float length = glm::length(n);
+            n = length > 0.0f ? n / length : Vector3(0.0f, 1.0f, 0.0f);
+        }
+    }
+    return geometry;
+}
+
+} // namespace
+
+float TraceAmbientOcclusion(const BakeBVH& bvh, const Vector3& origin, const Vector3& normal, uint32_t samples,
+                            float maxDistance, bool distanceFalloff, BakeRandom& random, uint64_t& rays) {
+    samples = std::max(samples, 1u);
+    float occlusion = 0.0f;
+    for (uint32_t s = 0; s < samples; ++s) {
+        // 余弦加权采样: 遮挡比例即 (1/π)∫ V cos dω 的估计，与漫反射的环境光一致
+        BakeRay ray;
+        ray.origin = origin;
+        ray.direction = SampleCosineHemisphere(normal, random);
+        ray.tMax = maxDistance;
+        ++rays;
+        if (!distanceFalloff) {
+            occlusion += bvh.occluded(ray) ? 1.0f : 0.0f;
+            continue;
+        }
+        BakeHit hit;
+        if (bvh.intersect(ray, hit)) {
+            const float falloff = 1.0f - hit.t / maxDistance;
+            occlusion += falloff * falloff;
+        }
+    }
+    return 1.0f - occlusion / static_cast<float>(samples);
+}
+
+AoBakeResult AoBaker::bake(const std::vector<BakeMesh>& meshes) const {
+    const Clock::time_point bakeStart = Clock::now();
+    AoBakeResult result;
+    AoBakeStats& stats = result.stats;
+    stats.meshes = static_cast<uint32_t>(meshes.size());
+
+    // 1. 世界空间几何与 BVH（共用一个，或每个网格一个）
+    Clock::time_point phaseStart = Clock::now();
+    const AoGeometry geometry = buildGeometry(meshes);
+    std::vector<BakeBVH> bvhs(settings_.includeNeighbours ? 1 : meshes.size());
+    if (settings_.includeNeighbours) {
+        std::vector<Vector3> positions;
+        std::vector<uint32_t> indices;
+        for (uint32_t m = 0; m < meshes.size(); ++m) {
+            const uint32_t baseVertex = static_cast<uint32_t>(positions.size());
+            positions.insert(positions.end(), geometry.meshPositions[m].begin(), geometry.meshPositions[m].end());
+            for (uint32_t index : geometry.meshIndices[m]) {
+                indices.push_back(baseVertex + index);
+            }
+        }
+        bvhs[0].build(positions, indices);
+    } else {
+        for (uint32_t m = 0; m < meshes.size(); ++m) {
+            bvhs[m].build(geometry.meshPositions[m], geometry.meshIndices[m]);
+        }
+    }
+    stats.triangles = geometry.triangles;
+    stats.bvhMs = elapsedMs(phaseStart);
+
+    // 2. 追踪
+    phaseStart = Clock::now();
+    struct Task {
+        uint32_t mesh;
+        uint32_t first;
+        uint32_t count;
+    };
+    std::vector<Task> tasks;
+    result.meshes.resize(meshes.size());
+    for (uint32_t m = 0; m < meshes.size(); ++m) {
+        const uint32_t vertexCount = static_cast<uint32_t>(geometry.meshPositions[m].size());
+        result.meshes[m].assign(vertexCount, 255);
+        stats.vertices += vertexCount;
+        for (uint32_t v = 0; v < vertexCount; v += kVerticesPerTask) {
+            tasks.push_back({m, v, std::min(kVerticesPerTask, vertexCount - v)});
+        }
+    }
+
+    // 每个顶点写入自己的位置，不需要同步
+    std::atomic<uint32_t> nextTask{0};
+    std::atomic<uint64_t> totalRays{0};
+    auto worker = [&]() {
+        uint64_t rays = 0;
+        for (;;) {
+            const uint32_t taskIndex = nextTask.fetch_add(1, std::memory_order_relaxed);
+            if (taskIndex >= tasks.size()) {
+                break;
+            }
+            const Task& task = tasks[taskIndex];
+            const BakeBVH& bvh = bvhs[settings_.includeNeighbours ? 0 : task.mesh];
+            for (uint32_t v = task.first; v < task.first + task.count; ++v) {
+                BakeRandom random(HashBakeSeed(settings_.seed, task.mesh, v));
+                const Vector3& normal = geometry.meshNormals[task.mesh][v];
+                const Vector3 origin = geometry.meshPositions[task.mesh][v] + normal * settings_.rayBias;
+                const float occlusion = TraceAmbientOcclusion(bvh, origin, normal, settings_.samples,
+                                                              settings_.maxDistance, settings_.distanceFalloff,
+                                                              random, rays);
+                result.meshes[task.mesh][v] = EncodeOcclusion(occlusion);
+            }
+        }
+        totalRays.fetch_add(rays, std::memory_order_relaxed);
+    };
+
+    const uint32_t threadCount = std::max(1u, std::min<uint32_t>(
+        settings_.threadCount > 0 ? settings_.threadCount : std::max(1u, std::thread::hardware_concurrency()),
+        static_cast<uint32_t>(tasks.size())));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    stats.threads = threadCount;
+    stats.rays = totalRays.load();
+    stats.traceMs = elapsedMs(phaseStart);
+
+    uint64_t occlusionSum = 0;
+    for (const std::vector<uint8_t>& mesh : result.meshes) {
+        for (uint8_t value : mesh) {
+            occlusionSum += value;
+        }
+    }
+    stats.meanOcclusion = stats.vertices > 0
+        ? static_cast<float>(static_cast<double>(occlusionSum) / (255.0 * stats.vertices)) : 1.0f;
+
+    stats.totalMs = elapsedMs(bakeStart);
+    return result;
+}
+
+void AoBakeResult::writeReport(FILE* out) const {
+    std::fprintf(out, "AO bake\n");
+    std::fprintf(out, "  meshes        %u, %u triangles\n", stats.meshes, stats.triangles);
+    std::fprintf(out, "  vertices      %u (%u bytes), mean occlusion %.3f\n",
+                 stats.vertices, stats.vertices, stats.meanOcclusion);
+    std::fprintf(out, "  rays          %llu on %u threads (%.2f Mrays/s)\n",
+                 static_cast<unsigned long long>(stats.rays), stats.threads, stats.megaRaysPerSecond());
+    std::fprintf(out, "  time (ms)     bvh %.1f, trace %.1f, total %.1f\n", stats.bvhMs, stats.traceMs, stats.totalMs);
+}
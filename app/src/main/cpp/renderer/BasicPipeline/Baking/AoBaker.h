@@ -0,0 +1,129 @@
+/**
+ * @file AoBaker.h
+ * @brief 环境光遮蔽烘焙器 - 为静态网格顶点烘焙 8 位环境光遮蔽
+ *
+ * 建筑与道具的遮蔽几乎不随帧变化，适合离线烘焙（着色器需开启 ENABLE_BAKED_AO 与 ENABLE_INDIRECT_LIGHTING）:
+ * - 每个顶点沿法线余弦采样 samples 条光线，命中距离在 maxDistance 内的光线计为遮挡
+ *   （distanceFalloff 时按 (1 - t / maxDistance)² 衰减），结果为 1 - 遮挡比例
+ * - includeNeighbours 时所有输入网格共用一个 BVH（邻近的静态网格互相遮挡）；
+ *   否则每个网格只被自身遮挡，适合单独摆放、可能被移动的道具
+ * - 存为每顶点 8 位（255 为无遮蔽），运行时作为顶点属性乘到 MaterialAttributes::occlusion
+ *   （PBRCommon.hlsl 的 ApplyBakedOcclusion）
+ *
+ * 有光照贴图的网格也可以把遮蔽烘焙进 shadowmask 的 a 通道（BakeSettings::occlusion），
+ * 两条路径共用 TraceAmbientOcclusion。与其他烘焙器一样多线程、结果与线程数无关
+ *
+ * 用法:
+ * @code
+ *
+ * AoBaker baker;
+ * baker.setSettings(settings);
+ * AoBakeResult result = baker.bake(meshes);
+ * // result.meshes[i][v]: 网格 i 顶点 v 的遮蔽（0-255）
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "BakeBVH.h"
+#include "BakeSampling.h"
+#include "LightmapBaker.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief 环境光遮蔽烘焙配置
+ */
+struct AoBakeSettings {
+    /** 每个顶点的光线数 */
+    uint32_t samples = 256;
+
+    /** 遮挡距离（米），更远的命中不计 */
+    float maxDistance = 1.0f;
+
+    /** 遮挡按 (1 - t / maxDistance)² 随距离衰减，避免 maxDistance 处的硬边界 */
+    bool distanceFalloff = true;
+
+    /** 光线起点沿法线的偏移（米） */
+    float rayBias = 0.002f;
+
+    /** 其他网格参与遮挡（false 时每个网格只被自身遮挡） */
+    bool includeNeighbours = true;
+
+    /** 工作线程数（0 为硬件线程数） */
+    uint32_t threadCount = 0;
+
+    uint32_t seed = 1;
+};
+
+/**
+ * @brief 环境光遮蔽烘焙统计
+ */
+struct AoBakeStats {
+    uint32_t meshes = 0;
+    uint32_t triangles = 0;
+    uint32_t vertices = 0;
+
+    /** 所有顶点的平均遮蔽（1 为无遮蔽） */
+    float meanOcclusion = 0.0f;
+
+    uint32_t threads = 0;
+    uint64_t rays = 0;
+
+    float bvhMs = 0.0f;
+    float traceMs = 0.0f;
+    float totalMs = 0.0f;
+
+    /** 每秒光线数（百万） */
+    float megaRaysPerSecond() const { return traceMs > 0.0f ? static_cast<float>(rays) / (traceMs * 1000.0f) : 0.0f; }
+};
+
+/**
+ * @brief 环境光遮蔽烘焙结果
+ */
+struct AoBakeResult {
+    /** 与输入网格一一对应，顶点顺序同 BakeMesh::positions（255 为无遮蔽） */
+    std::vector<std::vector<uint8_t>> meshes;
+
+    AoBakeStats stats;
+
+    void writeReport(FILE* out) const;
+};
+
+/**
+ * @brief 一个点的环境光遮蔽（1 为无遮蔽）
+ * @param origin 已沿法线偏移的光线起点
+ * @param rays 累加发射的光线数
+ */
+float TraceAmbientOcclusion(const BakeBVH& bvh, const Vector3& origin, const Vector3& normal, uint32_t samples,
+                            float maxDistance, bool distanceFalloff, BakeRandom& random, uint64_t& rays);
+
+/** 遮蔽量化为 8 位（四舍五入，255 为无遮蔽） */
+inline uint8_t EncodeOcclusion(float occlusion) {
+    const float clamped = occlusion < 0.0f ? 0.0f : (occlusion > 1.0f ? 1.0f : occlusion);
+    return static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+}
+
+inline float DecodeOcclusion(uint8_t value) {
+    return static_cast<float>(value) * (1.0f / 255.0f);
+}
+
+/**
+ * @brief CPU 环境光遮蔽烘焙器
+ */
+class AoBaker {
+public:
+    void setSettings(const AoBakeSettings& settings) { settings_ = settings; }
+    const AoBakeSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 烘焙（阻塞）
+     * @param meshes 静态几何，每个网格都烘焙顶点遮蔽
+     */
+    AoBakeResult bake(const std::vector<BakeMesh>& meshes) const;
+
+private:
+    AoBakeSettings settings_;
+};
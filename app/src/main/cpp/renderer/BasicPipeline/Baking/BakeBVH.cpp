@@ -0,0 +1,319 @@
+/**
+ * @file BakeBVH.cpp
+ * @brief 烘焙用三角形 BVH 实现
+ */
+
+#include "BakeBVH.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/** 构建期间的三角形包围盒与质心 */
+struct BuildTriangle {
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+    Vector3 centroid;
+};
+
+struct Bounds {
+    Vector3 min = Vector3(std::numeric_limits<float>::max());
+    Vector3 max = Vector3(-std::numeric_limits<float>::max());
+
+    void grow(const Vector3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void grow(const Vector3& bmin, const Vector3& bmax) {
+        min = glm::min(min, bmin);
+        max = glm::max(max, bmax);
+    }
+    float halfArea() const {
+        const Vector3 e = max - min;
+        return e.x < 0.0f ? 0.0f : e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+};
+
+/** SAH 中遍历一个内部节点相对求交一个三角形的开销 */
+constexpr float kTraversalCost = 1.0f;
+
+/** 叶子三角形数不超过该值且 SAH 认为不值得划分时停止 */
+constexpr uint32_t kMaxSahLeafTriangles = 16;
+
+constexpr uint32_t kStackSize = 64;
+
+float safeInverse(float d) {
+    constexpr float kEpsilon = 1e-12f;
+    return 1.0f / (std::fabs(d) > kEpsilon ? d : std::copysign(kEpsilon, d));
+}
+
+} // namespace
+
+// ============================================================================
+// 构建
+// ============================================================================
+
+void BakeBVH::build(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices) {
+    nodes_.clear();
+    triangles_.clear();
+    triangleIds_.clear();
+    depth_ = 0;
+
+    const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triangleCount == 0) {
+        return;
+    }
+
+    std::vector<BuildTriangle> build(triangleCount);
+    std::vector<uint32_t> order(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        const Vector3& a = positions[indices[i * 3 + 0]];
+        const Vector3& b = positions[indices[i * 3 + 1]];
+        const Vector3& c = positions[indices[i * 3 + 2]];
+        build[i].boundsMin = glm::min(a, glm::min(b, c));
+        build[i].boundsMax = glm::max(a, glm::max(b, c));
+        build[i].centroid = (build[i].boundsMin + build[i].boundsMax) * 0.5f;
+        order[i] = i;
+    }
+
+    struct Task {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t depth;
+    };
+    std::vector<Task> tasks;
+    tasks.push_back({0, 0, triangleCount, 1});
+
+    nodes_.reserve(triangleCount * 2);
+    nodes_.push_back(Node());
+
+    struct Bin {
+        Bounds bounds;
+        uint32_t count = 0;
+    };
+
+    while (!tasks.empty()) {
+        const Task task = tasks.back();
+        tasks.pop_back();
+        depth_ = std::max(depth_, task.depth);
+
+        Bounds bounds;
+        Bounds centroidBounds;
+        for (uint32_t i = task.begin; i < task.end; ++i) {
+            const BuildTriangle& tri = build[order[i]];
+            bounds.grow(tri.boundsMin, tri.boundsMax);
+            centroidBounds.grow(tri.centroid);
+        }
+
+        Node& node = nodes_[task.node];
+        node.boundsMin = bounds.min;
+        node.boundsMax = bounds.max;
+        node.offset = task.begin;
+        node.count = task.end - task.begin;
+
+        const uint32_t count = task.end - task.begin;
+        if (count <= MaxLeafTriangles) {
+            continue;
+        }
+
+        // 沿质心跨度最大的轴分箱
+        const Vector3 extent = centroidBounds.max - centroidBounds.min;
+        int axis = 0;
+        if (extent.y > extent[axis]) axis = 1;
+        if (extent.z > extent[axis]) axis = 2;
+
+        uint32_t mid = task.begin;
+        if (extent[axis] > 0.0f) {
+            Bin bins[BinCount];
+            const float binScale = static_cast<float>(BinCount) / extent[axis];
+            auto binOf = [&](const BuildTriangle& tri) {
+                const uint32_t b = static_cast<uint32_t>((tri.centroid[axis] - centroidBounds.min[axis]) * binScale);
+                return std::min(b, BinCount - 1);
+            };
+            for (uint32_t i = task.begin; i < task.end; ++i) {
+                const BuildTriangle& tri = build[order[i]];
+                Bin& bin = bins[binOf(tri)];
+                bin.bounds.grow(tri.boundsMin, tri.boundsMax);
+                ++bin.count;
+            }
+
+            // 从右向左累计右侧代价，再从左向右找最小 SAH
+            float rightCost[BinCount];
+            Bounds right;
+            uint32_t rightCount = 0;
+            for (uint32_t b = BinCount - 1; b > 0; --b) {
+                right.grow(bins[b].bounds.min, bins[b].bounds.max);
+                rightCount += bins[b].count;
+                rightCost[b] = right.halfArea() * static_cast<float>(rightCount);
+            }
+
+            Bounds left;
+            uint32_t leftCount = 0;
+            float bestCost = std::numeric_limits<float>::max();
+            uint32_t bestSplit = 0;
+            for (uint32_t b = 0; b + 1 < BinCount; ++b) {
+                left.grow(bins[b].bounds.min, bins[b].bounds.max);
+                leftCount += bins[b].count;
+                if (leftCount == 0 || leftCount == count) {
+                    continue;
+                }
+                const float cost = left.halfArea() * static_cast<float>(leftCount) + rightCost[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = b;
+                }
+            }
+
+            const float leafCost = bounds.halfArea() * static_cast<float>(count);
+            const float splitCost = kTraversalCost * bounds.halfArea() + bestCost;
+            if (splitCost >= leafCost && count <= kMaxSahLeafTriangles) {
+                continue;
+            }
+
+            if (bestCost < std::numeric_limits<float>::max()) {
+                mid = static_cast<uint32_t>(std::partition(order.begin() + task.begin, order.begin() + task.end,
+                    [&](uint32_t t) { return binOf(build[t]) <= bestSplit; }) - order.begin());
+            }
+        }
+
+        // 质心重合（或分箱失败）时按中位数划分
+        if (mid == task.begin || mid == task.end) {
+            mid = task.begin + count / 2;
+            std::nth_element(order.begin() + task.begin, order.begin() + mid, order.begin() + task.end,
+                [&](uint32_t a, uint32_t b) { return build[a].centroid[axis] < build[b].centroid[axis]; });
+        }
+
+        const uint32_t leftChild = static_cast<uint32_t>(nodes_.size());
+        nodes_[task.node].offset = leftChild;
+        nodes_[task.node].count = 0;
+        nodes_.push_back(Node());
+        nodes_.push_back(Node());
+
+        tasks.push_back({leftChild + 1, mid, task.end, task.depth + 1});
+        tasks.push_back({leftChild, task.begin, mid, task.depth + 1});
+    }
+
+    // 按叶子顺序重排三角形
+    triangles_.resize(triangleCount);
+    triangleIds_ = order;
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        const uint32_t t = order[i];
+        const Vector3& a = positions[indices[t * 3 + 0]];
+        const Vector3& b = positions[indices[t * 3 + 1]];
+        const Vector3& c = positions[indices[t * 3 + 2]];
+        triangles_[i].v0 = a;
+        triangles_[i].e1 = b - a;
+        triangles_[i].e2 = c - a;
+    }
+}
+
+// ============================================================================
+// 遍历
+// ============================================================================
+
+template <bool AnyHit>
+bool BakeBVH::traverse(const BakeRay& ray, BakeHit& hit) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    const Vector3 inverseDirection(safeInverse(ray.direction.x), safeInverse(ray.direction.y),
+                                   safeInverse(ray.direction.z));
+
+    // 返回进入距离，未相交时返回 +inf
+    auto intersectBounds = [&](const Node& node, float tMax) {
+        const Vector3 t0 = (node.boundsMin - ray.origin) * inverseDirection;
+        const Vector3 t1 = (node.boundsMax - ray.origin) * inverseDirection;
+        const Vector3 tNear = glm::min(t0, t1);
+        const Vector3 tFar = glm::max(t0, t1);
+        const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, ray.tMin));
+        const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+        return enter <= exit ? enter : std::numeric_limits<float>::infinity();
+    };
+
+    hit.t = ray.tMax;
+    bool found = false;
+
+    uint32_t stack[kStackSize];
+    uint32_t stackSize = 0;
+    uint32_t current = 0;
+    if (intersectBounds(nodes_[0], hit.t) == std::numeric_limits<float>::infinity()) {
+        return false;
+    }
+
+    for (;;) {
+        const Node& node = nodes_[current];
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+                const Triangle& tri = triangles_[i];
+                const Vector3 p = glm::cross(ray.direction, tri.e2);
+                const float det = glm::dot(tri.e1, p);
+                if (std::fabs(det) < 1e-12f) {
+                    continue;
+                }
+                const float inverseDet = 1.0f / det;
+                const Vector3 s = ray.origin - tri.v0;
+                const float u = glm::dot(s, p) * inverseDet;
+                if (u < 0.0f || u > 1.0f) {
+                    continue;
+                }
+                const Vector3 q = glm::cross(s, tri.e1);
+                const float v = glm::dot(ray.direction, q) * inverseDet;
+                if (v < 0.0f || u + v > 1.0f) {
+                    continue;
+                }
+                const float t = glm::dot(tri.e2, q) * inverseDet;
+                if (t <= ray.tMin || t >= hit.t) {
+                    continue;
+                }
+                if (AnyHit) {
+                    return true;
+                }
+                hit.t = t;
+                hit.u = u;
+                hit.v = v;
+                hit.triangle = triangleIds_[i];
+                found = true;
+            }
+        } else {
+            // 先访问较近的子节点
+            uint32_t nearChild = node.offset;
+            uint32_t farChild = node.offset + 1;
+            float nearT = intersectBounds(nodes_[nearChild], hit.t);
+            float farT = intersectBounds(nodes_[farChild], hit.t);
+            if (farT < nearT) {
+                std::swap(nearChild, farChild);
+                std::swap(nearT, farT);
+            }
+            if (nearT != std::numeric_limits<float>::infinity()) {
+                if (farT != std::numeric_limits<float>::infinity() && stackSize < kStackSize) {
+                    stack[stackSize++] = farChild;
+                }
+                current = nearChild;
+                continue;
+            }
+        }
+
+        if (stackSize == 0) {
+            break;
+        }
+        current = stack[--stackSize];
+    }
+    return found;
+}
+
+bool BakeBVH::intersect(const BakeRay& ray, BakeHit& hit) const {
+    hit = BakeHit();
+    if (!traverse<false>(ray, hit)) {
+        hit = BakeHit();
+        return false;
+    }
+    return true;
+}
+
+bool BakeBVH::occluded(const BakeRay& ray) const {
+    BakeHit hit;
+    return traverse<true>(ray, hit);
+}
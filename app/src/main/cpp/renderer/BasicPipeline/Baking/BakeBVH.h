@@ -0,0 +1,106 @@
+/**
+ * @file BakeBVH.h
+ * @brief 烘焙用三角形 BVH - 静态几何的最近命中与遮挡查询
+ *
+ * 光照贴图烘焙器对每个纹素发射数百条光线，求交是最主要的开销:
+ * - 分箱 SAH（16 个箱）自顶向下构建，叶子最多 MaxLeafTriangles 个三角形
+ * - 节点 32 字节（包围盒 + 子节点/三角形偏移），两个子节点相邻存放
+ * - 三角形按叶子顺序重排为 v0 / e1 / e2，Möller–Trumbore 求交
+ * - occluded() 找到任意命中立即返回（阴影光线）
+ *
+ * 构建后只读，多个烘焙线程可以同时查询
+ */
+
+#pragma once
+
+#include "../../../MathTypes.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief 烘焙光线
+ */
+struct BakeRay {
+    Vector3 origin = Vector3(0.0f);
+    Vector3 direction = Vector3(0.0f, 0.0f, 1.0f);
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::max();
+};
+
+/**
+ * @brief 最近命中
+ */
+struct BakeHit {
+    static constexpr uint32_t InvalidTriangle = 0xFFFFFFFFu;
+
+    float t = std::numeric_limits<float>::max();
+
+    /** 构建时传入的三角形下标（不是重排后的下标） */
+    uint32_t triangle = InvalidTriangle;
+
+    /** 重心坐标（相对 v1、v2） */
+    float u = 0.0f;
+    float v = 0.0f;
+
+    bool valid() const { return triangle != InvalidTriangle; }
+};
+
+/**
+ * @brief 静态三角形 BVH
+ */
+class BakeBVH {
+public:
+    static constexpr uint32_t MaxLeafTriangles = 4;
+    static constexpr uint32_t BinCount = 16;
+
+    /**
+     * @brief 构建
+     * @param positions 世界空间顶点
+     * @param indices 三角形索引（每3个一个三角形）
+     */
+    void build(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices);
+
+    /** 最近命中，未命中时 hit.valid() 为 false */
+    bool intersect(const BakeRay& ray, BakeHit& hit) const;
+
+    /** (tMin, tMax) 内是否有任意命中 */
+    bool occluded(const BakeRay& ray) const;
+
+    uint32_t getTriangleCount() const { return static_cast<uint32_t>(triangleIds_.size()); }
+    uint32_t getNodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+    uint32_t getDepth() const { return depth_; }
+
+    /** 场景包围盒 */
+    Vector3 getBoundsMin() const { return nodes_.empty() ? Vector3(0.0f) : nodes_[0].boundsMin; }
+    Vector3 getBoundsMax() const { return nodes_.empty() ? Vector3(0.0f) : nodes_[0].boundsMax; }
+
+private:
+    /**
+     * 32 字节节点:
+     * - 内部节点: offset 为左子节点下标（右子节点为 offset + 1），count == 0
+     * - 叶子:     offset 为首个三角形下标，count 为三角形数
+     */
+    struct Node {
+        Vector3 boundsMin;
+        uint32_t offset;
+        Vector3 boundsMax;
+        uint32_t count;
+    };
+    static_assert(sizeof(Node) == 32, "BakeBVH::Node should stay 32 bytes");
+
+    /** 叶子顺序的三角形: v0、e1 = v1 - v0、e2 = v2 - v0 */
+    struct Triangle {
+        Vector3 v0;
+        Vector3 e1;
+        Vector3 e2;
+    };
+
+    template <bool AnyHit>
+    bool traverse(const BakeRay& ray, BakeHit& hit) const;
+
+    std::vector<Node> nodes_;
+    std::vector<Triangle> triangles_;
+    std::vector<uint32_t> triangleIds_;
+    uint32_t depth_ = 0;
+};
@@ -0,0 +1,102 @@
+/**
+ * @file BakeSampling.h
+ * @brief 烘焙器共用的随机数与方向采样
+ *
+ * 随机数按（种子, 图集/探针, 纹素/顶点）哈希播种，每个工作项独立，结果与线程数无关
+ */
+
+#pragma once
+
+#include "../../../MathTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+constexpr float kBakePi = 3.14159265358979f;
+
+/**
+ * @brief PCG32
+ */
+class BakeRandom {
+public:
+    explicit BakeRandom(uint64_t seed) {
+        state_ = 0;
+        next();
+        state_ += seed;
+        next();
+    }
+
+    uint32_t next() {
+        const uint64_t old = state_;
+        state_ = old * 6364136223846793005ULL + 1442695040888963407ULL;
+        const uint32_t shifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+    }
+
+    /** [0, 1) */
+    float uniform() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+private:
+    uint64_t state_;
+};
+
+/**
+ * @brief 工作项的随机数种子
+ */
+inline uint64_t HashBakeSeed(uint32_t seed, uint32_t group, uint32_t item) {
+    uint64_t h = (static_cast<uint64_t>(seed) << 40) ^ (static_cast<uint64_t>(group) << 32) ^ item;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief 以 n 为 z 轴的正交基（Duff et al. 2017）
+ */
+inline void BuildBakeBasis(const Vector3& n, Vector3& tangent, Vector3& bitangent) {
+    const float sign = std::copysign(1.0f, n.z);
+    const float a = -1.0f / (sign + n.z);
+    const float b = n.x * n.y * a;
+    tangent = Vector3(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    bitangent = Vector3(b, sign + n.y * n.y * a, -n.y);
+}
+
+/**
+ * @brief 余弦加权半球采样（pdf = cos / π）
+ */
+inline Vector3 SampleCosineHemisphere(const Vector3& n, BakeRandom& random) {
+    const float u1 = random.uniform();
+    const float u2 = random.uniform();
+    const float r = std::sqrt(u1);
+    const float phi = 2.0f * kBakePi * u2;
+    Vector3 tangent;
+    Vector3 bitangent;
+    BuildBakeBasis(n, tangent, bitangent);
+    return tangent * (r * std::cos(phi)) + bitangent * (r * std::sin(phi)) + n * std::sqrt(std::max(0.0f, 1.0f - u1));
+}
+
+/**
+ * @brief 均匀球面采样（pdf = 1 / 4π）
+ */
+inline Vector3 SampleUniformSphere(BakeRandom& random) {
+    const float z = 1.0f - 2.0f * random.uniform();
+    const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+    const float phi = 2.0f * kBakePi * random.uniform();
+    return Vector3(r * std::cos(phi), r * std::sin(phi), z);
+}
+
+/**
+ * @brief 单位球内均匀采样（软阴影的光源抖动）
+ */
+inline Vector3 SampleUnitBall(BakeRandom& random) {
+    for (;;) {
+        const Vector3 p(random.uniform() * 2.0f - 1.0f, random.uniform() * 2.0f - 1.0f, random.uniform() * 2.0f - 1.0f);
+        if (glm::dot(p, p) <= 1.0f) {
+            return p;
+        }
+    }
+}
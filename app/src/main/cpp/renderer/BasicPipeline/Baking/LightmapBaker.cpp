@@ -0,0 +1,577 @@
+/**
+ * @file LightmapBaker.cpp
+ * @brief CPU 光照贴图烘焙器实现
+ */
+
+#include "LightmapBaker.h"
+#include "AoBaker.h"
+#include "BakeBVH.h"
+#include "BakeSampling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+
+namespace {
+
+/** 每个工作项处理的图集行数 */
+constexpr uint32_t kRowsPerTask = 4;
+
+/** 从第几次弹射开始俄罗斯轮盘赌 */
+constexpr uint32_t kRouletteBounce = 2;
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+float luminance(const Vector3& color) {
+    return color.x * 0.2126f + color.y * 0.7152f + color.z * 0.0722f;
+}
+
+/** 世界空间的场景几何 */
+struct WorldGeometry {
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+
+    /** 每三角形的几何法线与所属网格 */
+    std::vector<Vector3> faceNormals;
+    std::vector<uint32_t> triangleMesh;
+};
+
+/** 一个工作线程的追踪上下文 */
+struct TraceContext {
+    const BakeBVH& bvh;
+    const WorldGeometry& geometry;
+    const BakeScene& scene;
+    const BakeSettings& settings;
+
+    /** 纹素直接光: 只有 Baked；弹射点的直接光: Baked + Mixed */
+    const std::vector<const LightData*>& texelLights;
+    const std::vector<const LightData*>& bounceLights;
+
+    uint64_t rays = 0;
+
+    bool occluded(const Vector3& origin, const Vector3& direction, float distance) {
+        ++rays;
+        BakeRay ray;
+        ray.origin = origin;
+        ray.direction = direction;
+        ray.tMax = distance;
+        return bvh.occluded(ray);
+    }
+
+    /** 下一事件估计: 直接光照（含阴影） */
+    Vector3 directLighting(const Vector3& position, const Vector3& normal,
+                           const std::vector<const LightData*>& lights, BakeRandom& random) {
+        Vector3 total(0.0f);
+        for (const LightData* light : lights) {
+            if (light->type == LightType::Directional) {
+                Vector3 L = -light->direction;
+                if (settings.lightSize > 0.0f) {
+                    L = glm::normalize(L + SampleUnitBall(random) * settings.lightSize);
+                }
+                const float NdotL = glm::dot(normal, L);
+                if (NdotL <= 0.0f || occluded(position, L, std::numeric_limits<float>::max())) {
+                    continue;
+                }
+                total += light->color * (light->intensity * NdotL);
+                continue;
+            }
+
+            // 衰减和锥形按光源中心计算，阴影光线指向球面光源上的随机点
+            const Vector3 toCenter = light->position - position;
+            const float distance = glm::length(toCenter);
+            if (distance <= 0.0001f || distance >= light->range) {
+                continue;
+            }
+
+            float cone = 1.0f;
+            if (light->type == LightType::Spot) {
+                const float cosAngle = glm::dot(-toCenter / distance, light->direction);
+                const float cosOuter = std::cos(glm::radians(light->outerAngle));
+                const float cosInner = std::cos(glm::radians(light->innerAngle));
+                cone = std::clamp((cosAngle - cosOuter) / std::max(cosInner - cosOuter, 0.0001f), 0.0f, 1.0f);
+                if (cone <= 0.0f) {
+                    continue;
+                }
+            }
+
+            Vector3 toLight = toCenter;
+            if (settings.lightSize > 0.0f) {
+                toLight += SampleUnitBall(random) * settings.lightSize;
+            }
+            const float lightDistance = glm::length(toLight);
+            const Vector3 L = toLight / lightDistance;
+            const float NdotL = glm::dot(normal, L);
+            if (NdotL <= 0.0f || occluded(position, L, lightDistance - settings.rayBias)) {
+                continue;
+            }
+            total += light->color * (light->intensity * NdotL * cone * light->calculateAttenuation(distance));
+        }
+        return total;
+    }
+
+    /** shadowmask 可见度: 与 directLighting 相同的抖动阴影光线，不考虑 NdotL；光源范围外为 1 */
+    float visibility(const Vector3& position, const LightData& light, BakeRandom& random) {
+        if (light.type == LightType::Directional) {
+            Vector3 L = -light.direction;
+            if (settings.lightSize > 0.0f) {
+                L = glm::normalize(L + SampleUnitBall(random) * settings.lightSize);
+            }
+            return occluded(position, L, std::numeric_limits<float>::max()) ? 0.0f : 1.0f;
+        }
+
+        Vector3 toLight = light.position - position;
+        if (glm::dot(toLight, toLight) >= light.range * light.range) {
+            return 1.0f;
+        }
+        if (settings.lightSize > 0.0f) {
+            toLight += SampleUnitBall(random) * settings.lightSize;
+        }
+        const float distance = glm::length(toLight);
+        if (distance <= 0.0001f) {
+            return 1.0f;
+        }
+        return occluded(position, toLight / distance, distance - settings.rayBias) ? 0.0f : 1.0f;
+    }
+
+    /**
+     * @brief 从纹素出发的一条路径（直接光 + 间接光）
+     * @param backface 首条间接光线命中背面时置为 true
+     */
+    Vector3 tracePath(const Vector3& origin, const Vector3& normal, BakeRandom& random, bool& backface) {
+        Vector3 radiance = directLighting(origin, normal, texelLights, random);
+
+        Vector3 throughput(1.0f);
+        Vector3 position = origin;
+        Vector3 direction = SampleCosineHemisphere(normal, random);
+        for (uint32_t bounce = 0; bounce < settings.maxBounces; ++bounce) {
+            ++rays;
+            BakeRay ray;
+            ray.origin = position;
+            ray.direction = direction;
+            BakeHit hit;
+            if (!bvh.intersect(ray, hit)) {
+                radiance += throughput * scene.skyColor;
+                break;
+            }
+
+            const Vector3& hitNormal = geometry.faceNormals[hit.triangle];
+            if (glm::dot(hitNormal, direction) > 0.0f) {
+                // 背面: 光线穿进了几何体内部
+                backface = backface || bounce == 0;
+                break;
+            }
+
+            const BakeMesh& mesh = scene.meshes[geometry.triangleMesh[hit.triangle]];
+            const Vector3 hitPosition = position + direction * hit.t + hitNormal * settings.rayBias;
+
+            radiance += throughput * mesh.emission;
+            throughput = throughput * mesh.albedo;
+            radiance += throughput * directLighting(hitPosition, hitNormal, bounceLights, random);
+
+            if (bounce >= kRouletteBounce) {
+                const float survive = std::clamp(std::max(throughput.x, std::max(throughput.y, throughput.z)), 0.05f, 1.0f);
+                if (random.uniform() >= survive) {
+                    break;
+                }
+                throughput = throughput / survive;
+            }
+
+            position = hitPosition;
+            direction = SampleCosineHemisphere(hitNormal, random);
+        }
+        return radiance;
+    }
+};
+
+/** 一张图集的追踪输出 */
+struct AtlasTrace {
+    std::vector<Vector3> radiance;
+    std::vector<float> variance;
+    std::vector<uint8_t> inside;
+    std::vector<Vector4> shadowmask;
+};
+
+/** 烘焙 shadowmask 的光源 */
+struct ShadowmaskLight {
+    const LightData* light;
+    int32_t channel;
+};
+
+} // namespace
+
+std::vector<int32_t> AssignShadowmaskChannels(const std::vector<LightData>& lights, uint32_t maxChannels) {
+    std::vector<int32_t> channels(lights.size(), -1);
+    const int32_t channelCount = static_cast<int32_t>(std::min(maxChannels, 4u));
+    auto qualifies = [](const LightData& light) {
+        return light.lightMode == LightMode::Mixed && light.castShadows && light.type != LightType::Area;
+    };
+
+    // 定向光独占通道
+    int32_t nextChannel = 0;
+    for (size_t i = 0; i < lights.size() && nextChannel < channelCount; ++i) {
+        if (qualifies(lights[i]) && lights[i].type == LightType::Directional) {
+            channels[i] = nextChannel++;
+        }
+    }
+
+    // 局部光源: 选第一个与已分配光源的范围都不相交的通道
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const LightData& light = lights[i];
+        if (!qualifies(light) || light.type == LightType::Directional) {
+            continue;
+        }
+        for (int32_t channel = nextChannel; channel < channelCount; ++channel) {
+            bool free = true;
+            for (size_t j = 0; j < i && free; ++j) {
+                if (channels[j] != channel) {
+                    continue;
+                }
+                const float reach = light.range + lights[j].range;
+                const Vector3 offset = light.position - lights[j].position;
+                free = glm::dot(offset, offset) >= reach * reach;
+            }
+            if (free) {
+                channels[i] = channel;
+                break;
+            }
+        }
+    }
+    return channels;
+}
+
+void BakeScene::addLights(const LightingData& lighting) {
+    auto gather = [&](const LightDataList& list) {
+        for (const LightData& light : list) {
+            if (light.lightMode != LightMode::Realtime) {
+                lights.push_back(light);
+            }
+        }
+    };
+    // 区域光只做实时 LTC 着色，不参与烘焙
+    gather(lighting.directionalLights);
+    gather(lighting.pointLights);
+    gather(lighting.spotLights);
+    skyColor = lighting.ambientColor * lighting.ambientIntensity;
+}
+
+LightmapBakeResult LightmapBaker::bake(const BakeScene& scene) const {
+    const Clock::time_point bakeStart = Clock::now();
+    LightmapBakeResult result;
+    LightmapBakeStats& stats = result.stats;
+    stats.meshes = static_cast<uint32_t>(scene.meshes.size());
+
+    // 1. 世界空间几何与 BVH
+    Clock::time_point phaseStart = Clock::now();
+    WorldGeometry geometry;
+    std::vector<LightmapChartMesh> chartMeshes;
+    std::vector<uint32_t> chartMeshSource;
+    for (uint32_t m = 0; m < scene.meshes.size(); ++m) {
+        const BakeMesh& mesh = scene.meshes[m];
+        const Matrix4 normalMatrix = glm::transpose(glm::inverse(mesh.worldMatrix));
+        const uint32_t baseVertex = static_cast<uint32_t>(geometry.positions.size());
+
+        LightmapChartMesh chartMesh;
+        chartMesh.positions.reserve(mesh.positions.size());
+        for (const Vector3& p : mesh.positions) {
+            chartMesh.positions.push_back(Vector3(mesh.worldMatrix * Vector4(p, 1.0f)));
+        }
+        for (const Vector3& n : mesh.normals) {
+            chartMesh.normals.push_back(glm::normalize(Vector3(normalMatrix * Vector4(n, 0.0f))));
+        }
+        chartMesh.indices = mesh.indices;
+        chartMesh.lightmapUVs = mesh.lightmapUVs;
+        chartMesh.texelsPerUnit = settings_.texelsPerUnit * mesh.lightmapScale;
+
+        geometry.positions.insert(geometry.positions.end(), chartMesh.positions.begin(), chartMesh.positions.end());
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const Vector3& a = chartMesh.positions[mesh.indices[i + 0]];
+            const Vector3& b = chartMesh.positions[mesh.indices[i + 1]];
+            const Vector3& c = chartMesh.positions[mesh.indices[i + 2]];
+            const Vector3 n = glm::cross(b - a, c - a);
+            const float length = glm::length(n);
+            geometry.faceNormals.push_back(length > 0.0f ? n / length : Vector3(0.0f, 1.0f, 0.0f));
+            geometry.triangleMesh.push_back(m);
+            for (size_t k = 0; k < 3; ++k) {
+                geometry.indices.push_back(baseVertex + mesh.indices[i + k]);
+            }
+        }
+
+        if (mesh.receiveLightmap) {
+            chartMeshes.push_back(std::move(chartMesh));
+            chartMeshSource.push_back(m);
+        }
+    }
+    stats.triangles = static_cast<uint32_t>(geometry.faceNormals.size());
+    stats.lightmappedMeshes = static_cast<uint32_t>(chartMeshes.size());
+
+    BakeBVH bvh;
+    bvh.build(geometry.positions, geometry.indices);
+    stats.bvhNodes = bvh.getNodeCount();
+    stats.bvhDepth = bvh.getDepth();
+    stats.bvhMs = elapsedMs(phaseStart);
+
+    // 2. 展开、打包、光栅化
+    phaseStart = Clock::now();
+    LightmapPackResult packing = PackLightmaps(chartMeshes, settings_.packing);
+    result.meshes.resize(scene.meshes.size());
+    for (uint32_t i = 0; i < chartMeshSource.size(); ++i) {
+        result.meshes[chartMeshSource[i]] = std::move(packing.meshes[i]);
+    }
+    stats.charts = packing.chartCount;
+    stats.atlases = static_cast<uint32_t>(packing.atlases.size());
+    stats.occupancy = packing.occupancy;
+    for (const LightmapAtlasLayout& atlas : packing.atlases) {
+        stats.coveredTexels += atlas.coveredTexels;
+    }
+    stats.packMs = elapsedMs(phaseStart);
+
+    // 3. 路径追踪
+    phaseStart = Clock::now();
+    std::vector<const LightData*> texelLights;
+    std::vector<const LightData*> bounceLights;
+    for (const LightData& light : scene.lights) {
+        if (light.type == LightType::Area || light.lightMode == LightMode::Realtime) {
+            continue;
+        }
+        bounceLights.push_back(&light);
+        if (light.lightMode == LightMode::Baked) {
+            texelLights.push_back(&light);
+            ++stats.bakedLights;
+        } else {
+            ++stats.mixedLights;
+        }
+    }
+
+    std::vector<ShadowmaskLight> maskLights;
+    result.shadowmaskChannels.assign(scene.lights.size(), -1);
+    if (settings_.shadowmask) {
+        result.shadowmaskChannels = AssignShadowmaskChannels(
+            scene.lights, settings_.occlusion ? kShadowmaskOcclusionChannel : 4u);
+        for (size_t i = 0; i < scene.lights.size(); ++i) {
+            const LightData& light = scene.lights[i];
+            if (result.shadowmaskChannels[i] >= 0) {
+                maskLights.push_back({&light, result.shadowmaskChannels[i]});
+                ++stats.shadowmaskLights;
+            } else if (light.lightMode == LightMode::Mixed && light.castShadows && light.type != LightType::Area) {
+                ++stats.shadowmaskOverflow;
+            }
+        }
+    }
+
+    std::vector<AtlasTrace> traces(packing.atlases.size());
+    struct RowTask {
+        uint32_t atlas;
+        uint32_t row;
+    };
+    std::vector<RowTask> tasks;
+    for (uint32_t a = 0; a < packing.atlases.size(); ++a) {
+        const LightmapAtlasLayout& atlas = packing.atlases[a];
+        traces[a].radiance.assign(atlas.texels.size(), Vector3(0.0f));
+        traces[a].variance.assign(atlas.texels.size(), 0.0f);
+        traces[a].inside.assign(atlas.texels.size(), 0);
+        if (!maskLights.empty() || settings_.occlusion) {
+            traces[a].shadowmask.assign(atlas.texels.size(), Vector4(1.0f));
+        }
+        for (uint32_t row = 0; row < atlas.height; row += kRowsPerTask) {
+            tasks.push_back({a, row});
+        }
+    }
+
+    const uint32_t samples = std::max(settings_.samplesPerTexel, 1u);
+    std::atomic<uint32_t> nextTask{0};
+    std::atomic<uint64_t> totalRays{0};
+    auto worker = [&]() {
+        TraceContext context{bvh, geometry, scene, settings_, texelLights, bounceLights};
+        for (;;) {
+            const uint32_t taskIndex = nextTask.fetch_add(1, std::memory_order_relaxed);
+            if (taskIndex >= tasks.size()) {
+                break;
+            }
+            const RowTask& task = tasks[taskIndex];
+            const LightmapAtlasLayout& atlas = packing.atlases[task.atlas];
+            AtlasTrace& trace = traces[task.atlas];
+            const uint32_t rowEnd = std::min(task.row + kRowsPerTask, atlas.height);
+
+            for (uint32_t i = task.row * atlas.width; i < rowEnd * atlas.width; ++i) {
+                const LightmapTexel& texel = atlas.texels[i];
+                if (!texel.valid()) {
+                    continue;
+                }
+
+                BakeRandom random(HashBakeSeed(settings_.seed, task.atlas, i));
+                const Vector3 origin = texel.position + texel.normal * settings_.rayBias;
+                Vector3 sum(0.0f);
+                double sumSquares = 0.0;
+                uint32_t backfaces = 0;
+                for (uint32_t s = 0; s < samples; ++s) {
+                    bool backface = false;
+                    const Vector3 value = context.tracePath(origin, texel.normal, random, backface);
+                    sum += value;
+                    const float l = luminance(value);
+                    sumSquares += static_cast<double>(l) * l;
+                    backfaces += backface;
+                }
+
+                const Vector3 mean = sum / static_cast<float>(samples);
+                const float meanLuminance = luminance(mean);
+                const float sampleVariance = std::max(
+                    static_cast<float>(sumSquares / samples) - meanLuminance * meanLuminance, 0.0f);
+                trace.radiance[i] = mean;
+                trace.variance[i] = sampleVariance / static_cast<float>(samples);
+                trace.inside[i] = static_cast<float>(backfaces) > settings_.insideThreshold * static_cast<float>(samples);
+
+                // shadowmask 使用独立的随机序列，开关它不影响光照贴图；共用通道的光源范围不相交，可见度相乘
+                if (!maskLights.empty()) {
+                    BakeRandom maskRandom(HashBakeSeed(~settings_.seed, task.atlas, i));
+                    for (const ShadowmaskLight& mask : maskLights) {
+                        uint32_t visible = 0;
+                        for (uint32_t s = 0; s < samples; ++s) {
+                            visible += context.visibility(origin, *mask.light, maskRandom) > 0.0f;
+                        }
+                        trace.shadowmask[i][mask.channel] *= static_cast<float>(visible) / static_cast<float>(samples);
+                    }
+                }
+
+                if (settings_.occlusion) {
+                    BakeRandom occlusionRandom(HashBakeSeed(settings_.seed + 0x9E3779B9u, task.atlas, i));
+                    trace.shadowmask[i][kShadowmaskOcclusionChannel] = TraceAmbientOcclusion(
+                        bvh, origin, texel.normal, samples, settings_.occlusionDistance, true, occlusionRandom,
+                        context.rays);
+                }
+            }
+        }
+        totalRays.fetch_add(context.rays, std::memory_order_relaxed);
+    };
+
+    const uint32_t threadCount = std::max(1u, std::min<uint32_t>(
+        settings_.threadCount > 0 ? settings_.threadCount : std::max(1u, std::thread::hardware_concurrency()),
+        static_cast<uint32_t>(tasks.size())));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    stats.threads = threadCount;
+    stats.rays = totalRays.load();
+    stats.traceMs = elapsedMs(phaseStart);
+
+    // 4. 降噪与扩张（内部纹素不参与降噪，由扩张填充）
+    phaseStart = Clock::now();
+    std::vector<std::vector<uint8_t>> coverage(packing.atlases.size());
+    for (uint32_t a = 0; a < packing.atlases.size(); ++a) {
+        LightmapAtlasLayout& atlas = packing.atlases[a];
+        AtlasTrace& trace = traces[a];
+        coverage[a].assign(atlas.texels.size(), 0);
+        for (size_t i = 0; i < atlas.texels.size(); ++i) {
+            if (!atlas.texels[i].valid()) {
+                continue;
+            }
+            if (trace.inside[i]) {
+                atlas.texels[i].chart = LightmapTexel::InvalidChart;
+                trace.radiance[i] = Vector3(0.0f);
+                if (!trace.shadowmask.empty()) {
+                    trace.shadowmask[i] = Vector4(1.0f);
+                }
+                ++stats.insideTexels;
+                continue;
+            }
+            coverage[a][i] = 1;
+        }
+
+        if (!trace.shadowmask.empty()) {
+            std::vector<uint8_t> maskCoverage = coverage[a];
+            DilateLightmap(atlas.width, atlas.height, trace.shadowmask, maskCoverage, settings_.dilationPasses);
+        }
+        DenoiseLightmap(atlas, trace.radiance, trace.variance, settings_.denoise);
+        DilateLightmap(atlas.width, atlas.height, trace.radiance, coverage[a], settings_.dilationPasses);
+    }
+    stats.denoiseMs = elapsedMs(phaseStart);
+
+    // 5. 编码
+    phaseStart = Clock::now();
+    double errorSum = 0.0;
+    uint64_t errorCount = 0;
+    result.lightmaps.resize(packing.atlases.size());
+    for (uint32_t a = 0; a < packing.atlases.size(); ++a) {
+        const LightmapAtlasLayout& atlas = packing.atlases[a];
+        BakedLightmap& lightmap = result.lightmaps[a];
+        lightmap.width = atlas.width;
+        lightmap.height = atlas.height;
+        lightmap.radiance = std::move(traces[a].radiance);
+        lightmap.encoded = settings_.encoding == LightmapEncoding::BC6H
+            ? EncodeLightmapBC6H(lightmap.radiance, atlas.width, atlas.height)
+            : EncodeLightmapRGBM(lightmap.radiance, atlas.width, atlas.height, settings_.rgbmRange);
+        if (!traces[a].shadowmask.empty()) {
+            lightmap.shadowmask = std::move(traces[a].shadowmask);
+            lightmap.encodedShadowmask = EncodeShadowmask(lightmap.shadowmask, atlas.width, atlas.height);
+        }
+
+        for (uint32_t y = 0; y < atlas.height; ++y) {
+            for (uint32_t x = 0; x < atlas.width; ++x) {
+                const size_t i = static_cast<size_t>(y) * atlas.width + x;
+                if (!atlas.texels[i].valid()) {
+                    continue;
+                }
+                const float reference = luminance(lightmap.radiance[i]);
+                const float decoded = luminance(DecodeLightmapTexel(lightmap.encoded, x, y));
+                errorSum += std::fabs(decoded - reference) / std::max(reference, 1e-3f);
+                ++errorCount;
+            }
+        }
+    }
+    stats.encodingError = errorCount > 0 ? static_cast<float>(errorSum / static_cast<double>(errorCount)) : 0.0f;
+    stats.encodeMs = elapsedMs(phaseStart);
+
+    stats.totalMs = elapsedMs(bakeStart);
+    return result;
+}
+
+bool LightmapBakeResult::writeKtx(const char* directory, const char* prefix) const {
+    bool ok = true;
+    for (uint32_t a = 0; a < lightmaps.size(); ++a) {
+        const std::string path = std::string(directory) + "/" + prefix + "_" + std::to_string(a) + ".ktx";
+        ok = WriteLightmapKtx(lightmaps[a].encoded, path.c_str()) && ok;
+        if (!lightmaps[a].encodedShadowmask.data.empty()) {
+            const std::string maskPath = std::string(directory) + "/" + prefix + "_" + std::to_string(a) + "_shadowmask.ktx";
+            ok = WriteLightmapKtx(lightmaps[a].encodedShadowmask, maskPath.c_str()) && ok;
+        }
+    }
+    return ok;
+}
+
+void LightmapBakeResult::writeReport(FILE* out) const {
+    std::fprintf(out, "Lightmap bake\n");
+    std::fprintf(out, "  meshes        %u (%u lightmapped), %u triangles\n",
+                 stats.meshes, stats.lightmappedMeshes, stats.triangles);
+    std::fprintf(out, "  lights        %u baked, %u mixed (indirect only)\n", stats.bakedLights, stats.mixedLights);
+    std::fprintf(out, "  shadowmask    %u lights, %u without a free channel\n",
+                 stats.shadowmaskLights, stats.shadowmaskOverflow);
+    std::fprintf(out, "  bvh           %u nodes, depth %u\n", stats.bvhNodes, stats.bvhDepth);
+    std::fprintf(out, "  atlases       %u, %u charts, %u texels (%.1f%% occupancy, %u inside)\n",
+                 stats.atlases, stats.charts, stats.coveredTexels, stats.occupancy * 100.0f, stats.insideTexels);
+    for (uint32_t a = 0; a < lightmaps.size(); ++a) {
+        const EncodedLightmap& encoded = lightmaps[a].encoded;
+        std::fprintf(out, "    [%u] %ux%u %s, %zu bytes\n", a, encoded.width, encoded.height,
+                     GetLightmapEncodingName(encoded.encoding), encoded.data.size());
+        if (!lightmaps[a].encodedShadowmask.data.empty()) {
+            std::fprintf(out, "        shadowmask %s, %zu bytes\n",
+                         GetLightmapEncodingName(lightmaps[a].encodedShadowmask.encoding),
+                         lightmaps[a].encodedShadowmask.data.size());
+        }
+    }
+    std::fprintf(out, "  rays          %llu on %u threads (%.2f Mrays/s)\n",
+                 static_cast<unsigned long long>(stats.rays), stats.threads, stats.megaRaysPerSecond());
+    std::fprintf(out, "  encoding      %.2f%% mean relative error\n", stats.encodingError * 100.0f);
+    std::fprintf(out, "  time (ms)     bvh %.1f, pack %.1f, trace %.1f, denoise %.1f, encode %.1f, total %.1f\n",
+                 stats.bvhMs, stats.packMs, stats.traceMs, stats.denoiseMs, stats.encodeMs, stats.totalMs);
+}
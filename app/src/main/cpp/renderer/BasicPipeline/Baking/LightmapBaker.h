@@ -0,0 +1,265 @@
+/**
+ * @file LightmapBaker.h
+ * @brief CPU 光照贴图烘焙器 - 为 LightMode::Baked / Mixed 光源离线生成光照贴图
+ *
+ * 多线程路径追踪，不依赖 GPU，可以在 Linux 主机（构建机、CI）上运行:
+ * 1. 网格变换到世界空间，构建静态几何的 BVH（BakeBVH）
+ * 2. 展开并打包光照贴图 UV，光栅化出每个纹素的世界位置和法线（PackLightmaps）
+ * 3. 每个纹素发射 samplesPerTexel 条余弦加权路径:
+ *    - 直接光: 对每个烘焙光源做下一事件估计（阴影光线，光源按 lightSize 抖动得到软阴影）
+ *    - 间接光: 最多 maxBounces 次漫反射弹射，未命中时取天空（环境光），
+ *      第 3 次弹射起俄罗斯轮盘赌
+ *    工作按图集行分块，线程通过原子计数器领取；随机数按纹素编号播种，结果与线程数无关
+ * 4. 多数样本首先命中背面的纹素视为埋在几何体内部，丢弃后由扩张填充
+ * 5. 边缘感知降噪、扩张（LightmapDenoiser），编码为 BC6H 或 RGBM8（LightmapEncoder）
+ * 6. shadowmask: 投射阴影的 Mixed 光源分配到 RGBA 四个通道之一（AssignShadowmaskChannels），
+ *    每个纹素用同样的抖动阴影光线估计可见度，扩张后编码为 Shadowmask8
+ * 7. occlusion: shadowmask 的 a 通道改存环境光遮蔽（AoBaker.h 的 TraceAmbientOcclusion），
+ *    Mixed 光源只分配 RGB 三个通道
+ *
+ * 光源模式:
+ * - Baked:    直接光和间接光都烘焙进光照贴图，运行时不再计算
+ * - Mixed:    只烘焙间接光，直接光由运行时计算；静态投射者的阴影烘焙进 shadowmask，
+ *             运行时静态接收者采样 shadowmask，实时阴影贴图只渲染动态投射者
+ *             （ShadowSettings::enableShadowmask）
+ * - Realtime: 不参与烘焙
+ *
+ * 光照贴图的值与 LightingData::calculateLightingAtPoint 的约定一致
+ * （Σ color * intensity * NdotL * 衰减 + 环境光），运行时 diffuse = albedo * lightmap
+ *
+ * 用法:
+ * @code
+ *
+ * BakeScene scene;
+ * scene.meshes.push_back(mesh);
+ * scene.addLights(lightingData);
+ *
+ * LightmapBaker baker;
+ * baker.setSettings(settings);
+ * LightmapBakeResult result = baker.bake(scene);
+ * result.writeKtx("out", "level01");
+ * // result.meshes[i]: 网格 i 的图集编号、拆分后的顶点与光照贴图 UV
+ * // result.shadowmaskChannels[i]: scene.lights[i] 的 shadowmask 通道，写回 LightData::shadowmaskChannel
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "LightmapDenoiser.h"
+#include "LightmapEncoder.h"
+#include "LightmapPacker.h"
+#include "../LightingData.h"
+#include "../../../MathTypes.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief 参与烘焙的静态网格
+ */
+struct BakeMesh {
+    /** 对象空间顶点 */
+    std::vector<Vector3> positions;
+
+    /** 对象空间法线（为空时使用面法线） */
+    std::vector<Vector3> normals;
+
+    std::vector<uint32_t> indices;
+
+    /** 第二套 UV（为空时自动展开） */
+    std::vector<Vector2> lightmapUVs;
+
+    Matrix4 worldMatrix = Matrix4(1.0f);
+
+    /** 漫反射率（弹射） */
+    Vector3 albedo = Vector3(0.8f);
+
+    /** 自发光（线性） */
+    Vector3 emission = Vector3(0.0f);
+
+    /** 纹素密度的倍数 */
+    float lightmapScale = 1.0f;
+
+    /** false: 只参与遮挡和弹射，不分配光照贴图（小物体通常改用光照探针） */
+    bool receiveLightmap = true;
+};
+
+/**
+ * @brief 烘焙场景
+ */
+struct BakeScene {
+    std::vector<BakeMesh> meshes;
+
+    /** 光源（Realtime 光源会被忽略） */
+    std::vector<LightData> lights;
+
+    /** 天空辐射度（未命中的光线） */
+    Vector3 skyColor = Vector3(0.0f);
+
+    /**
+     * @brief 收集 LightingData 中的 Baked / Mixed 光源，天空取环境光
+     */
+    void addLights(const LightingData& lighting);
+};
+
+/**
+ * @brief 烘焙配置
+ */
+struct BakeSettings {
+    /** 纹素密度（每米纹素数） */
+    float texelsPerUnit = 16.0f;
+
+    LightmapPackSettings packing;
+
+    uint32_t samplesPerTexel = 256;
+
+    /** 间接光弹射次数（0 只烘焙直接光） */
+    uint32_t maxBounces = 3;
+
+    /** 光线起点沿法线的偏移（米） */
+    float rayBias = 0.002f;
+
+    /** 点光源、聚光灯的半径（米）；定向光的角半径（弧度）。0 为硬阴影 */
+    float lightSize = 0.05f;
+
+    /** 工作线程数（0 为硬件线程数） */
+    uint32_t threadCount = 0;
+
+    /** 随机数种子 */
+    uint32_t seed = 1;
+
+    /** 首次命中背面的样本超过该比例时纹素视为在几何体内部 */
+    float insideThreshold = 0.5f;
+
+    LightmapDenoiseSettings denoise;
+
+    /** 扩张圈数 */
+    uint32_t dilationPasses = 4;
+
+    LightmapEncoding encoding = LightmapEncoding::BC6H;
+    float rgbmRange = 8.0f;
+
+    /** 为投射阴影的 Mixed 光源烘焙 shadowmask */
+    bool shadowmask = true;
+
+    /** 在 shadowmask 的 a 通道烘焙环境光遮蔽（每纹素 samplesPerTexel 条光线） */
+    bool occlusion = false;
+
+    /** 环境光遮蔽的遮挡距离（米） */
+    float occlusionDistance = 1.0f;
+};
+
+/**
+ * @brief 一张烘焙好的光照贴图
+ */
+struct BakedLightmap {
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /** 降噪、扩张后的线性值（行优先） */
+    std::vector<Vector3> radiance;
+
+    EncodedLightmap encoded;
+
+    /** 每通道一个 Mixed 光源的可见度，occlusion 时 a 为环境光遮蔽（两者都没有时为空） */
+    std::vector<Vector4> shadowmask;
+
+    EncodedLightmap encodedShadowmask;
+};
+
+/**
+ * @brief 烘焙统计
+ */
+struct LightmapBakeStats {
+    uint32_t meshes = 0;
+    uint32_t lightmappedMeshes = 0;
+    uint32_t triangles = 0;
+    uint32_t bakedLights = 0;
+    uint32_t mixedLights = 0;
+
+    /** 分配到 shadowmask 通道的 Mixed 光源 */
+    uint32_t shadowmaskLights = 0;
+
+    /** 通道不足而没有 shadowmask 的 Mixed 光源（运行时仍用实时阴影） */
+    uint32_t shadowmaskOverflow = 0;
+
+    uint32_t bvhNodes = 0;
+    uint32_t bvhDepth = 0;
+
+    uint32_t charts = 0;
+    uint32_t atlases = 0;
+    uint32_t coveredTexels = 0;
+
+    /** 判定为在几何体内部而丢弃的纹素 */
+    uint32_t insideTexels = 0;
+
+    float occupancy = 0.0f;
+
+    uint32_t threads = 0;
+    uint64_t rays = 0;
+
+    float bvhMs = 0.0f;
+    float packMs = 0.0f;
+    float traceMs = 0.0f;
+    float denoiseMs = 0.0f;
+    float encodeMs = 0.0f;
+    float totalMs = 0.0f;
+
+    /** 编码后与编码前的平均相对亮度误差（覆盖纹素） */
+    float encodingError = 0.0f;
+
+    /** 每秒光线数（百万） */
+    float megaRaysPerSecond() const { return traceMs > 0.0f ? static_cast<float>(rays) / (traceMs * 1000.0f) : 0.0f; }
+};
+
+/**
+ * @brief 烘焙结果
+ */
+struct LightmapBakeResult {
+    std::vector<BakedLightmap> lightmaps;
+
+    /** 与 BakeScene::meshes 一一对应（receiveLightmap 为 false 的网格为空布局） */
+    std::vector<LightmapMeshLayout> meshes;
+
+    /** 与 BakeScene::lights 一一对应的 shadowmask 通道（-1 表示没有） */
+    std::vector<int32_t> shadowmaskChannels;
+
+    LightmapBakeStats stats;
+
+    /**
+     * @brief 写出 <directory>/<prefix>_<图集编号>.ktx（有 shadowmask 时另写 <prefix>_<图集编号>_shadowmask.ktx）
+     * @return 任一文件写入失败时返回 false
+     */
+    bool writeKtx(const char* directory, const char* prefix) const;
+
+    void writeReport(FILE* out) const;
+};
+
+/** BakeSettings::occlusion 时环境光遮蔽所在的 shadowmask 通道 */
+constexpr uint32_t kShadowmaskOcclusionChannel = 3;
+
+/**
+ * @brief 为投射阴影的 Mixed 光源分配 shadowmask 通道
+ *
+ * 定向光先分配（影响所有纹素，各占一个通道）；点光源、聚光灯按顺序贪心着色，
+ * 范围球不相交的光源可以共用通道。分不到通道的光源为 -1
+ *
+ * @return 与 lights 一一对应的通道
+ */
+std::vector<int32_t> AssignShadowmaskChannels(const std::vector<LightData>& lights, uint32_t maxChannels = 4);
+
+/**
+ * @brief CPU 光照贴图烘焙器
+ */
+class LightmapBaker {
+public:
+    void setSettings(const BakeSettings& settings) { settings_ = settings; }
+    const BakeSettings& getSettings() const { return settings_; }
+
+    /** 烘焙（阻塞，内部使用 threadCount 个线程） */
+    LightmapBakeResult bake(const BakeScene& scene) const;
+
+private:
+    BakeSettings settings_;
+};
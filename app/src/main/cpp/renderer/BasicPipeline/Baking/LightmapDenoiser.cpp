@@ -0,0 +1,150 @@
+/**
+ * @file LightmapDenoiser.cpp
+ * @brief 光照贴图降噪与扩张实现
+ */
+
+#include "LightmapDenoiser.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/** B3 样条核 */
+constexpr float kKernel[5] = {1.0f / 16.0f, 1.0f / 4.0f, 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f};
+
+constexpr float kEpsilon = 1e-6f;
+
+float luminance(const Vector3& c) {
+    return 0.2126f * c.x + 0.7152f * c.y + 0.0722f * c.z;
+}
+
+/** 扩张（光照值与 shadowmask 共用） */
+template <typename T>
+void dilate(uint32_t width, uint32_t height, std::vector<T>& values, std::vector<uint8_t>& coverage, uint32_t passes) {
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+    std::vector<uint8_t> nextCoverage;
+
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        nextCoverage = coverage;
+        bool changed = false;
+
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                const size_t p = static_cast<size_t>(y) * w + x;
+                if (coverage[p]) {
+                    continue;
+                }
+
+                T sum(0.0f);
+                uint32_t count = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int sx = x + dx;
+                        const int sy = y + dy;
+                        if (sx < 0 || sy < 0 || sx >= w || sy >= h) {
+                            continue;
+                        }
+                        const size_t q = static_cast<size_t>(sy) * w + sx;
+                        if (coverage[q]) {
+                            sum += values[q];
+                            ++count;
+                        }
+                    }
+                }
+                if (count > 0) {
+                    values[p] = sum / static_cast<float>(count);
+                    nextCoverage[p] = 1;
+                    changed = true;
+                }
+            }
+        }
+
+        coverage.swap(nextCoverage);
+        if (!changed) {
+            break;
+        }
+    }
+}
+
+} // namespace
+
+void DenoiseLightmap(const LightmapAtlasLayout& layout, std::vector<Vector3>& radiance, std::vector<float>& variance,
+                     const LightmapDenoiseSettings& settings) {
+    if (!settings.enabled || settings.iterations == 0) {
+        return;
+    }
+
+    const int width = static_cast<int>(layout.width);
+    const int height = static_cast<int>(layout.height);
+    std::vector<Vector3> nextRadiance(radiance.size());
+    std::vector<float> nextVariance(variance.size());
+
+    for (uint32_t iteration = 0; iteration < settings.iterations; ++iteration) {
+        const int step = 1 << iteration;
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const size_t p = static_cast<size_t>(y) * width + x;
+                const LightmapTexel& center = layout.texels[p];
+                if (!center.valid()) {
+                    nextRadiance[p] = radiance[p];
+                    nextVariance[p] = variance[p];
+                    continue;
+                }
+
+                const float centerLuminance = luminance(radiance[p]);
+                const float sigma = settings.luminanceSigma * std::sqrt(std::max(variance[p], 0.0f)) + kEpsilon;
+
+                Vector3 sum(0.0f);
+                float sumVariance = 0.0f;
+                float sumWeight = 0.0f;
+                for (int ky = 0; ky < 5; ++ky) {
+                    const int sy = y + (ky - 2) * step;
+                    if (sy < 0 || sy >= height) {
+                        continue;
+                    }
+                    for (int kx = 0; kx < 5; ++kx) {
+                        const int sx = x + (kx - 2) * step;
+                        if (sx < 0 || sx >= width) {
+                            continue;
+                        }
+                        const size_t q = static_cast<size_t>(sy) * width + sx;
+                        const LightmapTexel& sample = layout.texels[q];
+                        if (sample.chart != center.chart) {
+                            continue;
+                        }
+
+                        const float normalWeight =
+                            std::pow(std::max(glm::dot(center.normal, sample.normal), 0.0f), settings.normalPower);
+                        const float luminanceWeight =
+                            std::exp(-std::fabs(luminance(radiance[q]) - centerLuminance) / sigma);
+                        const float weight = kKernel[kx] * kKernel[ky] * normalWeight * luminanceWeight;
+
+                        sum += radiance[q] * weight;
+                        sumVariance += variance[q] * weight * weight;
+                        sumWeight += weight;
+                    }
+                }
+
+                // 中心纹素的权重恒为正
+                nextRadiance[p] = sum / sumWeight;
+                nextVariance[p] = sumVariance / (sumWeight * sumWeight);
+            }
+        }
+
+        radiance.swap(nextRadiance);
+        variance.swap(nextVariance);
+    }
+}
+
+void DilateLightmap(uint32_t width, uint32_t height, std::vector<Vector3>& radiance, std::vector<uint8_t>& coverage,
+                    uint32_t passes) {
+    dilate(width, height, radiance, coverage, passes);
+}
+
+void DilateLightmap(uint32_t width, uint32_t height, std::vector<Vector4>& values, std::vector<uint8_t>& coverage,
+                    uint32_t passes) {
+    dilate(width, height, values, coverage, passes);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file LightmapDenoiser.h
+ * @brief 光照贴图降噪与扩张
+ *
+ * 路径追踪每纹素只有几百个样本，间接光仍有明显噪点。降噪使用边缘感知的 à-trous 小波滤波
+ * （5x5 B3 样条核，每次迭代步长翻倍），权重由 G-Buffer 式的引导数据决定:
+ * - 图表编号: 不同图表（不同网格、折边两侧）之间不混合
+ * - 法线: pow(max(0, dot(n_p, n_q)), normalPower)
+ * - 亮度: exp(-|L_p - L_q| / (luminanceSigma * σ_p))，σ_p 为烘焙时估计的样本均值标准差，
+ *   噪声大的纹素滤得更多，收敛良好的阴影边缘保持锐利
+ * 方差随权重平方传播到下一次迭代（与 SVGF 相同）
+ *
+ * 扩张把有效纹素的值逐圈复制到相邻的未覆盖纹素（图表边缘和 padding），
+ * 运行时双线性采样和 mip 不会混入黑色
+ */
+
+#pragma once
+
+#include "LightmapPacker.h"
+#include "../../../MathTypes.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 降噪配置
+ */
+struct LightmapDenoiseSettings {
+    bool enabled = true;
+
+    /** à-trous 迭代次数（步长 1、2、4 ...） */
+    uint32_t iterations = 3;
+
+    float normalPower = 64.0f;
+
+    /** 亮度权重对标准差的倍数（越大越平滑） */
+    float luminanceSigma = 4.0f;
+};
+
+/**
+ * @brief 边缘感知 à-trous 降噪（只处理有效纹素）
+ *
+ * @param layout 图集纹素布局（法线、图表编号）
+ * @param radiance 每纹素的光照值，就地滤波
+ * @param variance 每纹素亮度均值的方差，就地更新
+ */
+void DenoiseLightmap(const LightmapAtlasLayout& layout, std::vector<Vector3>& radiance, std::vector<float>& variance,
+                     const LightmapDenoiseSettings& settings);
+
+/**
+ * @brief 扩张: 每一圈用相邻有效纹素的平均值填充未覆盖纹素
+ *
+ * @param coverage 每纹素是否有值，就地更新（扩张出的纹素置为 1）
+ * @param passes 扩张圈数（通常等于打包的 padding）
+ */
+void DilateLightmap(uint32_t width, uint32_t height, std::vector<Vector3>& radiance, std::vector<uint8_t>& coverage,
+                    uint32_t passes);
+
+/** 扩张 shadowmask（四通道） */
+void DilateLightmap(uint32_t width, uint32_t height, std::vector<Vector4>& values, std::vector<uint8_t>& coverage,
+                    uint32_t passes);
@@ -0,0 +1,422 @@
+/**
+ * @file LightmapEncoder.cpp
+ * @brief 光照贴图编码实现
+ */
+
+#include "LightmapEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+constexpr uint32_t kGlRgba8 = 0x8058;
+constexpr uint32_t kGlRgba = 0x1908;
+constexpr uint32_t kGlRgb = 0x1907;
+constexpr uint32_t kGlUnsignedByte = 0x1401;
+constexpr uint32_t kGlCompressedRgbBptcUnsignedFloat = 0x8E8F;
+
+/** 最大有限半精度值的位模式（65504） */
+constexpr uint32_t kMaxHalfBits = 0x7BFF;
+
+/** BC6H 4 位索引的插值权重 */
+constexpr int kWeights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/** BC6H 模式 11 的5位模式号 */
+constexpr uint32_t kBC6HMode11 = 0x03;
+
+constexpr int kEndpointBits = 10;
+
+// ============================================================================
+// 半精度
+// ============================================================================
+
+uint32_t floatToHalfBits(float value) {
+    if (!(value > 0.0f)) {
+        return 0;  // 负值与 NaN
+    }
+    value = std::min(value, 65504.0f);
+
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (exponent <= 0) {
+        // 非规格化数
+        if (exponent < -10) {
+            return 0;
+        }
+        mantissa |= 0x800000;
+        const int shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1) {
+            ++half;
+        }
+        return half;
+    }
+
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) {
+        ++half;  // 进位会正确地进入指数
+    }
+    return std::min(half, kMaxHalfBits);
+}
+
+float halfBitsToFloat(uint32_t half) {
+    const int exponent = static_cast<int>((half >> 10) & 0x1F);
+    const int mantissa = static_cast<int>(half & 0x3FF);
+    if (exponent == 0) {
+        return std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    return std::ldexp(static_cast<float>(1024 + mantissa), exponent - 25);
+}
+
+// ============================================================================
+// BC6H 量化（无符号）
+// ============================================================================
+
+int unquantize(int value) {
+    if (value == 0) {
+        return 0;
+    }
+    if (value == (1 << kEndpointBits) - 1) {
+        return 0xFFFF;
+    }
+    return ((value << 16) + 0x8000) >> kEndpointBits;
+}
+
+int finishUnquantize(int value) {
+    return (value * 31) >> 6;
+}
+
+int interpolate(int a, int b, int weight) {
+    return finishUnquantize(((64 - weight) * a + weight * b + 32) >> 6);
+}
+
+/** 解码后最接近 half 的 10 位端点 */
+int quantize(int half) {
+    const int guess = std::clamp(half * 1023 / static_cast<int>(kMaxHalfBits), 0, 1023);
+    int best = guess;
+    int bestError = std::abs(finishUnquantize(unquantize(guess)) - half);
+    for (int candidate = std::max(guess - 2, 0); candidate <= std::min(guess + 2, 1023); ++candidate) {
+        const int error = std::abs(finishUnquantize(unquantize(candidate)) - half);
+        if (error < bestError) {
+            best = candidate;
+            bestError = error;
+        }
+    }
+    return best;
+}
+
+/** 128 位块的按位写入 */
+class BlockWriter {
+public:
+    void write(uint32_t value, uint32_t bitCount) {
+        for (uint32_t i = 0; i < bitCount; ++i) {
+            if (value & (1u << i)) {
+                bytes_[(position_ + i) / 8] |= static_cast<uint8_t>(1u << ((position_ + i) % 8));
+            }
+        }
+        position_ += bitCount;
+    }
+    const uint8_t* data() const { return bytes_; }
+
+private:
+    uint8_t bytes_[16] = {};
+    uint32_t position_ = 0;
+};
+
+class BlockReader {
+public:
+    explicit BlockReader(const uint8_t* bytes) : bytes_(bytes) {}
+
+    uint32_t read(uint32_t bitCount) {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < bitCount; ++i) {
+            value |= static_cast<uint32_t>((bytes_[(position_ + i) / 8] >> ((position_ + i) % 8)) & 1) << i;
+        }
+        position_ += bitCount;
+        return value;
+    }
+
+private:
+    const uint8_t* bytes_;
+    uint32_t position_ = 0;
+};
+
+/** 用给定端点求每个像素的最佳索引，返回半精度位空间的平方误差 */
+int64_t fitIndices(const int (*pixels)[3], const int* endpoint0, const int* endpoint1, uint8_t* indices) {
+    int palette[16][3];
+    int unquantized0[3];
+    int unquantized1[3];
+    for (int c = 0; c < 3; ++c) {
+        unquantized0[c] = unquantize(endpoint0[c]);
+        unquantized1[c] = unquantize(endpoint1[c]);
+    }
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            palette[i][c] = interpolate(unquantized0[c], unquantized1[c], kWeights4[i]);
+        }
+    }
+
+    int64_t total = 0;
+    for (int p = 0; p < 16; ++p) {
+        int64_t bestError = INT64_MAX;
+        for (int i = 0; i < 16; ++i) {
+            int64_t error = 0;
+            for (int c = 0; c < 3; ++c) {
+                const int64_t d = palette[i][c] - pixels[p][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                indices[p] = static_cast<uint8_t>(i);
+            }
+        }
+        total += bestError;
+    }
+    return total;
+}
+
+void encodeBlockBC6H(const int (*pixels)[3], uint8_t* out) {
+    int minValue[3] = {INT32_MAX, INT32_MAX, INT32_MAX};
+    int maxValue[3] = {0, 0, 0};
+    for (int p = 0; p < 16; ++p) {
+        for (int c = 0; c < 3; ++c) {
+            minValue[c] = std::min(minValue[c], pixels[p][c]);
+            maxValue[c] = std::max(maxValue[c], pixels[p][c]);
+        }
+    }
+
+    // 包围盒的4条对角线（R 固定从小到大，G/B 方向可翻转）
+    int bestEndpoints[2][3] = {};
+    uint8_t bestIndices[16] = {};
+    int64_t bestError = INT64_MAX;
+    for (int diagonal = 0; diagonal < 4; ++diagonal) {
+        int endpoint0[3];
+        int endpoint1[3];
+        for (int c = 0; c < 3; ++c) {
+            const bool flip = (c == 1 && (diagonal & 1)) || (c == 2 && (diagonal & 2));
+            endpoint0[c] = quantize(flip ? maxValue[c] : minValue[c]);
+            endpoint1[c] = quantize(flip ? minValue[c] : maxValue[c]);
+        }
+        uint8_t indices[16];
+        const int64_t error = fitIndices(pixels, endpoint0, endpoint1, indices);
+        if (error < bestError) {
+            bestError = error;
+            std::memcpy(bestEndpoints[0], endpoint0, sizeof(endpoint0));
+            std::memcpy(bestEndpoints[1], endpoint1, sizeof(endpoint1));
+            std::memcpy(bestIndices, indices, sizeof(indices));
+        }
+        if (bestError == 0) {
+            break;
+        }
+    }
+
+    // 锚点（像素0）索引的最高位隐含为0: 交换端点并反转索引
+    if (bestIndices[0] & 0x8) {
+        for (int c = 0; c < 3; ++c) {
+            std::swap(bestEndpoints[0][c], bestEndpoints[1][c]);
+        }
+        for (uint8_t& index : bestIndices) {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    BlockWriter writer;
+    writer.write(kBC6HMode11, 5);
+    for (int e = 0; e < 2; ++e) {
+        for (int c = 0; c < 3; ++c) {
+            writer.write(static_cast<uint32_t>(bestEndpoints[e][c]), kEndpointBits);
+        }
+    }
+    writer.write(bestIndices[0], 3);
+    for (int p = 1; p < 16; ++p) {
+        writer.write(bestIndices[p], 4);
+    }
+    std::memcpy(out, writer.data(), 16);
+}
+
+Vector3 decodeTexelBC6H(const uint8_t* block, uint32_t pixel) {
+    BlockReader reader(block);
+    if (reader.read(5) != kBC6HMode11) {
+        return Vector3(0.0f);  // 只解码本编码器输出的模式
+    }
+    int endpoints[2][3];
+    for (int e = 0; e < 2; ++e) {
+        for (int c = 0; c < 3; ++c) {
+            endpoints[e][c] = unquantize(static_cast<int>(reader.read(kEndpointBits)));
+        }
+    }
+    uint32_t index = reader.read(3);
+    for (uint32_t p = 1; p <= pixel; ++p) {
+        index = reader.read(4);
+    }
+    Vector3 result;
+    for (int c = 0; c < 3; ++c) {
+        result[c] = halfBitsToFloat(static_cast<uint32_t>(
+            interpolate(endpoints[0][c], endpoints[1][c], kWeights4[index])));
+    }
+    return result;
+}
+
+uint8_t toUnorm8(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+bool writeUint32(FILE* file, uint32_t value) {
+    return std::fwrite(&value, sizeof(value), 1, file) == 1;
+}
+
+} // namespace
+
+const char* GetLightmapEncodingName(LightmapEncoding encoding) {
+    switch (encoding) {
+        case LightmapEncoding::BC6H: return "BC6H";
+        case LightmapEncoding::RGBM8: return "RGBM8";
+        case LightmapEncoding::Shadowmask8: return "Shadowmask8";
+    }
+    return "Unknown";
+}
+
+uint32_t EncodedLightmap::getGlInternalFormat() const {
+    return encoding == LightmapEncoding::BC6H ? kGlCompressedRgbBptcUnsignedFloat : kGlRgba8;
+}
+
+EncodedLightmap EncodeLightmapBC6H(const std::vector<Vector3>& radiance, uint32_t width, uint32_t height) {
+    EncodedLightmap lightmap;
+    lightmap.encoding = LightmapEncoding::BC6H;
+    lightmap.width = width;
+    lightmap.height = height;
+
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    lightmap.data.resize(static_cast<size_t>(blocksX) * blocksY * 16);
+
+    int pixels[16][3];
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            for (uint32_t p = 0; p < 16; ++p) {
+                const uint32_t x = std::min(bx * 4 + p % 4, width - 1);
+                const uint32_t y = std::min(by * 4 + p / 4, height - 1);
+                const Vector3& value = radiance[static_cast<size_t>(y) * width + x];
+                for (int c = 0; c < 3; ++c) {
+                    pixels[p][c] = static_cast<int>(floatToHalfBits(value[c]));
+                }
+            }
+            encodeBlockBC6H(pixels, &lightmap.data[(static_cast<size_t>(by) * blocksX + bx) * 16]);
+        }
+    }
+    return lightmap;
+}
+
+EncodedLightmap EncodeLightmapRGBM(const std::vector<Vector3>& radiance, uint32_t width, uint32_t height,
+                                   float rgbmRange) {
+    EncodedLightmap lightmap;
+    lightmap.encoding = LightmapEncoding::RGBM8;
+    lightmap.width = width;
+    lightmap.height = height;
+    lightmap.rgbmRange = rgbmRange;
+    lightmap.data.resize(static_cast<size_t>(width) * height * 4);
+
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+        const Vector3 value = glm::max(radiance[i], Vector3(0.0f));
+        const float peak = std::max(value.x, std::max(value.y, value.z)) / rgbmRange;
+
+        // M 向上取整到 8 位，保证 rgb / M 不超过 1
+        const float multiplier = std::max(std::ceil(std::clamp(peak, 1e-6f, 1.0f) * 255.0f) / 255.0f, 1.0f / 255.0f);
+        const float scale = 1.0f / (multiplier * rgbmRange);
+
+        uint8_t* out = &lightmap.data[i * 4];
+        out[0] = toUnorm8(value.x * scale);
+        out[1] = toUnorm8(value.y * scale);
+        out[2] = toUnorm8(value.z * scale);
+        out[3] = toUnorm8(multiplier);
+    }
+    return lightmap;
+}
+
+EncodedLightmap EncodeShadowmask(const std::vector<Vector4>& visibility, uint32_t width, uint32_t height) {
+    EncodedLightmap lightmap;
+    lightmap.encoding = LightmapEncoding::Shadowmask8;
+    lightmap.width = width;
+    lightmap.height = height;
+    lightmap.data.resize(static_cast<size_t>(width) * height * 4);
+
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+        uint8_t* out = &lightmap.data[i * 4];
+        for (int c = 0; c < 4; ++c) {
+            out[c] = toUnorm8(visibility[i][c]);
+        }
+    }
+    return lightmap;
+}
+
+Vector3 DecodeLightmapTexel(const EncodedLightmap& lightmap, uint32_t x, uint32_t y) {
+    if (x >= lightmap.width || y >= lightmap.height) {
+        return Vector3(0.0f);
+    }
+    if (lightmap.encoding == LightmapEncoding::BC6H) {
+        const uint32_t blocksX = (lightmap.width + 3) / 4;
+        const size_t block = static_cast<size_t>(y / 4) * blocksX + x / 4;
+        return decodeTexelBC6H(&lightmap.data[block * 16], (y % 4) * 4 + x % 4);
+    }
+
+    const uint8_t* texel = &lightmap.data[(static_cast<size_t>(y) * lightmap.width + x) * 4];
+    if (lightmap.encoding == LightmapEncoding::Shadowmask8) {
+        return Vector3(texel[0], texel[1], texel[2]) * (1.0f / 255.0f);
+    }
+    const float scale = static_cast<float>(texel[3]) / 255.0f * lightmap.rgbmRange / 255.0f;
+    return Vector3(texel[0], texel[1], texel[2]) * scale;
+}
+
+bool WriteLightmapKtx(const EncodedLightmap& lightmap, const char* path) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    static const uint8_t identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    const bool compressed = lightmap.encoding == LightmapEncoding::BC6H;
+
+    // 键值对: 键和值都以 '\0' 结尾，整体补齐到 4 字节
+    char value[64];
+    std::snprintf(value, sizeof(value), "encoding=%s;range=%g", GetLightmapEncodingName(lightmap.encoding),
+                  lightmap.encoding == LightmapEncoding::RGBM8 ? lightmap.rgbmRange : 0.0f);
+    std::string keyValue = "PrismaLightmap";
+    keyValue.push_back('\0');
+    keyValue += value;
+    keyValue.push_back('\0');
+    const uint32_t keyValueSize = static_cast<uint32_t>(keyValue.size());
+    const uint32_t keyValuePadding = (4 - keyValueSize % 4) % 4;
+
+    bool ok = std::fwrite(identifier, sizeof(identifier), 1, file) == 1;
+    ok = ok && writeUint32(file, 0x04030201);                                  // endianness
+    ok = ok && writeUint32(file, compressed ? 0 : kGlUnsignedByte);            // glType
+    ok = ok && writeUint32(file, 1);                                           // glTypeSize
+    ok = ok && writeUint32(file, compressed ? 0 : kGlRgba);                    // glFormat
+    ok = ok && writeUint32(file, lightmap.getGlInternalFormat());              // glInternalFormat
+    ok = ok && writeUint32(file, compressed ? kGlRgb : kGlRgba);               // glBaseInternalFormat
+    ok = ok && writeUint32(file, lightmap.width);
+    ok = ok && writeUint32(file, lightmap.height);
+    ok = ok && writeUint32(file, 0);                                           // pixelDepth
+    ok = ok && writeUint32(file, 0);                                           // numberOfArrayElements
+    ok = ok && writeUint32(file, 1);                                           // numberOfFaces
+    ok = ok && writeUint32(file, 1);                                           // numberOfMipmapLevels
+    ok = ok && writeUint32(file, 4 + keyValueSize + keyValuePadding);          // bytesOfKeyValueData
+    ok = ok && writeUint32(file, keyValueSize);
+    ok = ok && std::fwrite(keyValue.data(), 1, keyValueSize, file) == keyValueSize;
+    const uint8_t padding[4] = {};
+    ok = ok && std::fwrite(padding, 1, keyValuePadding, file) == keyValuePadding;
+
+    // 单个 mip: imageSize + 数据（两种格式的数据长度都是 4 的倍数）
+    ok = ok && writeUint32(file, static_cast<uint32_t>(lightmap.data.size()));
+    ok = ok && std::fwrite(lightmap.data.data(), 1, lightmap.data.size(), file) == lightmap.data.size();
+
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file LightmapEncoder.h
+ * @brief 光照贴图压缩编码与 KTX 输出
+ *
+ * 两种 HDR 编码:
+ * - BC6H（无符号，GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT）: 每 4x4 块 16 字节（8 bpp），
+ *   只使用模式 11（单分区、10 位端点、4 位索引），端点在半精度位模式空间中选取包围盒
+ *   四条对角线中误差最小的一条。桌面 GPU 与支持 textureCompressionBC 的设备
+ * - RGBM8（GL_RGBA8）: rgb * a * rgbmRange 还原线性值，所有移动 GPU 都支持（32 bpp）
+ *
+ * 另有 Shadowmask8（GL_RGBA8）: 烘焙 shadowmask，每个通道是一个 Mixed 光源的可见度 [0, 1]
+ *
+ * 输出 KTX 1.1 文件（单 mip），键值对 "PrismaLightmap" 记录编码和 RGBM 范围，
+ * 加载端据此选择解码方式
+ */
+
+#pragma once
+
+#include "../../../MathTypes.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 光照贴图编码
+ */
+enum class LightmapEncoding : uint32_t {
+    /** BC6H 无符号浮点（模式 11） */
+    BC6H,
+    /** RGBA8，rgb * a * rgbmRange */
+    RGBM8,
+    /** RGBA8 unorm，每通道一个光源的可见度（shadowmask） */
+    Shadowmask8
+};
+
+const char* GetLightmapEncodingName(LightmapEncoding encoding);
+
+/**
+ * @brief 编码后的一张光照贴图
+ */
+struct EncodedLightmap {
+    LightmapEncoding encoding = LightmapEncoding::RGBM8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /** RGBM8 的最大可表示值 */
+    float rgbmRange = 8.0f;
+
+    std::vector<uint8_t> data;
+
+    /** KTX / glCompressedTexImage2D 使用的内部格式 */
+    uint32_t getGlInternalFormat() const;
+};
+
+/**
+ * @brief 编码为 BC6H（宽高不是 4 的倍数时边缘块复制最后一行/列）
+ * @param radiance 行优先，width * height 个线性 HDR 值（负值截断为 0）
+ */
+EncodedLightmap EncodeLightmapBC6H(const std::vector<Vector3>& radiance, uint32_t width, uint32_t height);
+
+/**
+ * @brief 编码为 RGBM8（超过 rgbmRange 的值截断）
+ */
+EncodedLightmap EncodeLightmapRGBM(const std::vector<Vector3>& radiance, uint32_t width, uint32_t height,
+                                   float rgbmRange = 8.0f);
+
+/**
+ * @brief 编码 shadowmask（RGBA8 unorm）
+ * @param visibility 行优先，width * height 个纹素，分量 i 为通道 i 的可见度
+ */
+EncodedLightmap EncodeShadowmask(const std::vector<Vector4>& visibility, uint32_t width, uint32_t height);
+
+/**
+ * @brief 解码一个纹素（Shadowmask8 返回前三个通道）（验证编码误差、调试视图）
+ */
+Vector3 DecodeLightmapTexel(const EncodedLightmap& lightmap, uint32_t x, uint32_t y);
+
+/**
+ * @brief 写入 KTX 1.1 文件
+ * @return 无法打开或写入文件时返回 false
+ */
+bool WriteLightmapKtx(const EncodedLightmap& lightmap, const char* path);
@@ -0,0 +1,410 @@
+/**
+ * @file LightmapPacker.cpp
+ * @brief 光照贴图展开、打包与光栅化实现
+ */
+
+#include "LightmapPacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+/** 图表: 一组三角形及其在图表空间（纹素单位）中的顶点坐标 */
+struct Chart {
+    std::vector<uint32_t> triangles;
+
+    /** 与 triangles 对应的每个角的图表坐标（每三角形3个） */
+    std::vector<Vector2> corners;
+
+    Vector2 min = Vector2(0.0f);
+    Vector2 max = Vector2(0.0f);
+
+    /** 含 padding 的矩形尺寸与在网格矩形中的位置 */
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+/** 网格的所有图表打包成的矩形 */
+struct MeshRect {
+    uint32_t mesh = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t atlas = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+/** 货架式打包的一张图集 */
+struct AtlasShelves {
+    uint32_t cursorX = 0;
+    uint32_t shelfY = 0;
+    uint32_t shelfHeight = 0;
+    uint32_t usedWidth = 0;
+    uint32_t usedHeight = 0;
+};
+
+uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+Vector3 faceNormal(const LightmapChartMesh& mesh, uint32_t triangle) {
+    const Vector3& a = mesh.positions[mesh.indices[triangle * 3 + 0]];
+    const Vector3& b = mesh.positions[mesh.indices[triangle * 3 + 1]];
+    const Vector3& c = mesh.positions[mesh.indices[triangle * 3 + 2]];
+    return glm::cross(b - a, c - a);
+}
+
+float triangleArea(const Vector3& a, const Vector3& b, const Vector3& c) {
+    return 0.5f * glm::length(glm::cross(b - a, c - a));
+}
+
+float triangleArea(const Vector2& a, const Vector2& b, const Vector2& c) {
+    return 0.5f * std::fabs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+}
+
+/** 主轴分类: 0..5 = +X -X +Y -Y +Z -Z */
+uint32_t dominantAxis(const Vector3& n) {
+    const Vector3 a = glm::abs(n);
+    if (a.x >= a.y && a.x >= a.z) return n.x >= 0.0f ? 0 : 1;
+    if (a.y >= a.z) return n.y >= 0.0f ? 2 : 3;
+    return n.z >= 0.0f ? 4 : 5;
+}
+
+Vector2 projectToAxis(const Vector3& p, uint32_t axisClass) {
+    switch (axisClass / 2) {
+        case 0: return Vector2(p.z, p.y);
+        case 1: return Vector2(p.x, p.z);
+        default: return Vector2(p.x, p.y);
+    }
+}
+
+void finishChart(Chart& chart, uint32_t padding) {
+    chart.min = Vector2(std::numeric_limits<float>::max());
+    chart.max = Vector2(-std::numeric_limits<float>::max());
+    for (const Vector2& c : chart.corners) {
+        chart.min = Vector2(std::min(chart.min.x, c.x), std::min(chart.min.y, c.y));
+        chart.max = Vector2(std::max(chart.max.x, c.x), std::max(chart.max.y, c.y));
+    }
+    // +1: 边缘上的纹素中心也能落在矩形内
+    chart.width = static_cast<uint32_t>(std::ceil(chart.max.x - chart.min.x)) + 1 + padding * 2;
+    chart.height = static_cast<uint32_t>(std::ceil(chart.max.y - chart.min.y)) + 1 + padding * 2;
+}
+
+/** 按指定密度生成网格的图表 */
+std::vector<Chart> buildCharts(const LightmapChartMesh& mesh, float texelsPerUnit, uint32_t padding) {
+    const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    std::vector<Chart> charts;
+
+    if (!mesh.lightmapUVs.empty()) {
+        // 整套 UV 作为一个图表，按面积比换算到纹素
+        float worldArea = 0.0f;
+        float uvArea = 0.0f;
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            const uint32_t i0 = mesh.indices[t * 3 + 0];
+            const uint32_t i1 = mesh.indices[t * 3 + 1];
+            const uint32_t i2 = mesh.indices[t * 3 + 2];
+            worldArea += triangleArea(mesh.positions[i0], mesh.positions[i1], mesh.positions[i2]);
+            uvArea += triangleArea(mesh.lightmapUVs[i0], mesh.lightmapUVs[i1], mesh.lightmapUVs[i2]);
+        }
+        const float scale = uvArea > 0.0f ? std::sqrt(worldArea / uvArea) * texelsPerUnit : 0.0f;
+
+        Chart chart;
+        chart.triangles.resize(triangleCount);
+        std::iota(chart.triangles.begin(), chart.triangles.end(), 0u);
+        chart.corners.reserve(triangleCount * 3);
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            for (uint32_t k = 0; k < 3; ++k) {
+                chart.corners.push_back(mesh.lightmapUVs[mesh.indices[t * 3 + k]] * scale);
+            }
+        }
+        finishChart(chart, padding);
+        charts.push_back(std::move(chart));
+        return charts;
+    }
+
+    // 自动展开: 同一主轴且共享顶点的三角形合并
+    std::vector<uint32_t> axisOf(triangleCount);
+    std::vector<uint32_t> parent(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        axisOf[t] = dominantAxis(faceNormal(mesh, t));
+        parent[t] = t;
+    }
+
+    // 每个顶点、每个主轴记住第一个三角形
+    std::vector<uint32_t> firstTriangle(mesh.positions.size() * 6, 0xFFFFFFFFu);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (uint32_t k = 0; k < 3; ++k) {
+            uint32_t& first = firstTriangle[mesh.indices[t * 3 + k] * 6 + axisOf[t]];
+            if (first == 0xFFFFFFFFu) {
+                first = t;
+            } else {
+                parent[findRoot(parent, t)] = findRoot(parent, first);
+            }
+        }
+    }
+
+    std::vector<uint32_t> chartOfRoot(triangleCount, 0xFFFFFFFFu);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const uint32_t root = findRoot(parent, t);
+        if (chartOfRoot[root] == 0xFFFFFFFFu) {
+            chartOfRoot[root] = static_cast<uint32_t>(charts.size());
+            charts.emplace_back();
+        }
+        Chart& chart = charts[chartOfRoot[root]];
+        chart.triangles.push_back(t);
+        for (uint32_t k = 0; k < 3; ++k) {
+            chart.corners.push_back(projectToAxis(mesh.positions[mesh.indices[t * 3 + k]], axisOf[t]) * texelsPerUnit);
+        }
+    }
+    for (Chart& chart : charts) {
+        finishChart(chart, padding);
+    }
+    return charts;
+}
+
+/** 货架式打包图表，返回网格矩形尺寸 */
+void packCharts(std::vector<Chart>& charts, uint32_t& width, uint32_t& height) {
+    std::vector<uint32_t> order(charts.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return charts[a].height > charts[b].height; });
+
+    double area = 0.0;
+    uint32_t widest = 0;
+    for (const Chart& chart : charts) {
+        area += static_cast<double>(chart.width) * chart.height;
+        widest = std::max(widest, chart.width);
+    }
+    const uint32_t shelfWidth = std::max(widest, static_cast<uint32_t>(std::ceil(std::sqrt(area) * 1.1)));
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t shelfHeight = 0;
+    width = 0;
+    for (uint32_t i : order) {
+        Chart& chart = charts[i];
+        if (x + chart.width > shelfWidth) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        chart.x = x;
+        chart.y = y;
+        x += chart.width;
+        shelfHeight = std::max(shelfHeight, chart.height);
+        width = std::max(width, x);
+    }
+    height = y + shelfHeight;
+}
+
+uint32_t roundUpTo4(uint32_t v) {
+    return (v + 3) & ~3u;
+}
+
+/** 在图集纹素空间中光栅化一个三角形（纹素中心采样） */
+void rasterizeTriangle(LightmapAtlasLayout& atlas, const Vector2* texel, const Vector3* position,
+                       const Vector3* normal, uint32_t chart, uint32_t mesh) {
+    const float area = (texel[1].x - texel[0].x) * (texel[2].y - texel[0].y) -
+                       (texel[2].x - texel[0].x) * (texel[1].y - texel[0].y);
+    if (std::fabs(area) < 1e-12f) {
+        return;
+    }
+    const float inverseArea = 1.0f / area;
+
+    const float minX = std::min(texel[0].x, std::min(texel[1].x, texel[2].x));
+    const float maxX = std::max(texel[0].x, std::max(texel[1].x, texel[2].x));
+    const float minY = std::min(texel[0].y, std::min(texel[1].y, texel[2].y));
+    const float maxY = std::max(texel[0].y, std::max(texel[1].y, texel[2].y));
+
+    const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(static_cast<int>(atlas.width) - 1, static_cast<int>(std::ceil(maxX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(static_cast<int>(atlas.height) - 1, static_cast<int>(std::ceil(maxY)));
+
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const Vector2 p(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+            const float w1 = ((p.x - texel[0].x) * (texel[2].y - texel[0].y) -
+                              (texel[2].x - texel[0].x) * (p.y - texel[0].y)) * inverseArea;
+            const float w2 = ((texel[1].x - texel[0].x) * (p.y - texel[0].y) -
+                              (p.x - texel[0].x) * (texel[1].y - texel[0].y)) * inverseArea;
+            const float w0 = 1.0f - w1 - w2;
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                continue;
+            }
+
+            LightmapTexel& out = atlas.texels[static_cast<size_t>(y) * atlas.width + x];
+            if (!out.valid()) {
+                ++atlas.coveredTexels;
+            }
+            out.position = position[0] * w0 + position[1] * w1 + position[2] * w2;
+            const Vector3 n = normal[0] * w0 + normal[1] * w1 + normal[2] * w2;
+            const float length = glm::length(n);
+            out.normal = length > 0.0f ? n / length : normal[0];
+            out.chart = chart;
+            out.mesh = mesh;
+        }
+    }
+}
+
+} // namespace
+
+LightmapPackResult PackLightmaps(const std::vector<LightmapChartMesh>& meshes, const LightmapPackSettings& settings) {
+    LightmapPackResult result;
+    result.meshes.resize(meshes.size());
+
+    const uint32_t atlasSize = std::max(settings.atlasSize, 4u);
+
+    // 1. 每个网格展开并打包成一个矩形，放不进图集时降低密度
+    std::vector<std::vector<Chart>> meshCharts(meshes.size());
+    std::vector<MeshRect> rects;
+    for (uint32_t m = 0; m < meshes.size(); ++m) {
+        const LightmapChartMesh& mesh = meshes[m];
+        if (mesh.indices.size() < 3) {
+            continue;
+        }
+
+        float densityScale = 1.0f;
+        MeshRect rect;
+        rect.mesh = m;
+        for (;;) {
+            meshCharts[m] = buildCharts(mesh, mesh.texelsPerUnit * densityScale, settings.padding);
+            packCharts(meshCharts[m], rect.width, rect.height);
+            const uint32_t largest = std::max(rect.width, rect.height);
+            if (largest <= atlasSize || densityScale < 1e-3f) {
+                break;
+            }
+            densityScale *= 0.95f * static_cast<float>(atlasSize) / static_cast<float>(largest);
+        }
+        result.meshes[m].densityScale = densityScale;
+        rects.push_back(rect);
+    }
+
+    // 2. 网格矩形按高度降序货架式打包到图集
+    std::sort(rects.begin(), rects.end(), [](const MeshRect& a, const MeshRect& b) {
+        return a.height != b.height ? a.height > b.height : a.mesh < b.mesh;
+    });
+    std::vector<AtlasShelves> shelves;
+    for (MeshRect& rect : rects) {
+        bool placed = false;
+        for (uint32_t a = 0; a < shelves.size() && !placed; ++a) {
+            AtlasShelves& atlas = shelves[a];
+            if (atlas.cursorX + rect.width > atlasSize) {
+                atlas.cursorX = 0;
+                atlas.shelfY += atlas.shelfHeight;
+                atlas.shelfHeight = 0;
+            }
+            if (atlas.shelfY + rect.height > atlasSize) {
+                continue;
+            }
+            rect.atlas = a;
+            rect.x = atlas.cursorX;
+            rect.y = atlas.shelfY;
+            placed = true;
+        }
+        if (!placed) {
+            rect.atlas = static_cast<uint32_t>(shelves.size());
+            rect.x = 0;
+            rect.y = 0;
+            shelves.emplace_back();
+        }
+
+        AtlasShelves& atlas = shelves[rect.atlas];
+        atlas.cursorX = rect.x + rect.width;
+        atlas.shelfHeight = std::max(atlas.shelfHeight, rect.height);
+        atlas.usedWidth = std::max(atlas.usedWidth, atlas.cursorX);
+        atlas.usedHeight = std::max(atlas.usedHeight, atlas.shelfY + atlas.shelfHeight);
+    }
+
+    // 图集裁剪到实际使用的尺寸（4 的倍数，块压缩要求）
+    result.atlases.resize(shelves.size());
+    for (uint32_t a = 0; a < shelves.size(); ++a) {
+        LightmapAtlasLayout& atlas = result.atlases[a];
+        atlas.width = std::min(atlasSize, roundUpTo4(shelves[a].usedWidth));
+        atlas.height = std::min(atlasSize, roundUpTo4(shelves[a].usedHeight));
+        atlas.texels.resize(static_cast<size_t>(atlas.width) * atlas.height);
+    }
+
+    // 3. 生成图集 UV 并光栅化
+    uint32_t nextChart = 0;
+    std::vector<uint32_t> vertexStamp;
+    std::vector<uint32_t> vertexSlot;
+    for (const MeshRect& rect : rects) {
+        const LightmapChartMesh& mesh = meshes[rect.mesh];
+        LightmapMeshLayout& layout = result.meshes[rect.mesh];
+        LightmapAtlasLayout& atlas = result.atlases[rect.atlas];
+        std::vector<Chart>& charts = meshCharts[rect.mesh];
+
+        layout.atlasIndex = rect.atlas;
+        layout.firstChart = nextChart;
+        layout.chartCount = static_cast<uint32_t>(charts.size());
+
+        const bool ownUVs = !mesh.lightmapUVs.empty();
+        if (ownUVs) {
+            layout.vertexRemap.resize(mesh.positions.size());
+            std::iota(layout.vertexRemap.begin(), layout.vertexRemap.end(), 0u);
+            layout.indices = mesh.indices;
+            layout.uvs.assign(mesh.positions.size(), Vector2(0.0f));
+        } else {
+            layout.indices.resize(mesh.indices.size());
+            vertexStamp.assign(mesh.positions.size(), 0xFFFFFFFFu);
+            vertexSlot.resize(mesh.positions.size());
+        }
+
+        for (uint32_t c = 0; c < charts.size(); ++c) {
+            const Chart& chart = charts[c];
+            const uint32_t chartId = nextChart + c;
+            const Vector2 offset(
+                static_cast<float>(rect.x + chart.x + settings.padding) + 0.5f - chart.min.x,
+                static_cast<float>(rect.y + chart.y + settings.padding) + 0.5f - chart.min.y);
+
+            for (uint32_t i = 0; i < chart.triangles.size(); ++i) {
+                const uint32_t t = chart.triangles[i];
+                Vector2 texel[3];
+                Vector3 position[3];
+                Vector3 normal[3];
+                const Vector3 face = glm::normalize(faceNormal(mesh, t));
+                for (uint32_t k = 0; k < 3; ++k) {
+                    const uint32_t vertex = mesh.indices[t * 3 + k];
+                    texel[k] = chart.corners[i * 3 + k] + offset;
+                    position[k] = mesh.positions[vertex];
+                    normal[k] = mesh.normals.empty() ? face : mesh.normals[vertex];
+
+                    const Vector2 uv(texel[k].x / static_cast<float>(atlas.width),
+                                     texel[k].y / static_cast<float>(atlas.height));
+                    if (ownUVs) {
+                        layout.uvs[vertex] = uv;
+                    } else {
+                        // 每个图表内的顶点只生成一次
+                        if (vertexStamp[vertex] != chartId) {
+                            vertexStamp[vertex] = chartId;
+                            vertexSlot[vertex] = static_cast<uint32_t>(layout.vertexRemap.size());
+                            layout.vertexRemap.push_back(vertex);
+                            layout.uvs.push_back(uv);
+                        }
+                        layout.indices[t * 3 + k] = vertexSlot[vertex];
+                    }
+                }
+                rasterizeTriangle(atlas, texel, position, normal, chartId, rect.mesh);
+            }
+        }
+        nextChart += layout.chartCount;
+    }
+    result.chartCount = nextChart;
+
+    size_t totalTexels = 0;
+    size_t coveredTexels = 0;
+    for (const LightmapAtlasLayout& atlas : result.atlases) {
+        totalTexels += atlas.texels.size();
+        coveredTexels += atlas.coveredTexels;
+    }
+    result.occupancy = totalTexels > 0 ? static_cast<float>(coveredTexels) / static_cast<float>(totalTexels) : 0.0f;
+    return result;
+}
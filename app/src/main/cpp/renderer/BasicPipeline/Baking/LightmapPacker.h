@@ -0,0 +1,125 @@
+/**
+ * @file LightmapPacker.h
+ * @brief 光照贴图 UV 展开、图集打包与纹素光栅化
+ *
+ * 每个接收光照贴图的网格:
+ * - 带第二套 UV（lightmapUVs）时整套 UV 作为一个图表，按世界面积 / UV 面积换算纹素密度
+ * - 否则自动展开: 三角形按面法线的主轴（±X/±Y/±Z）分组，组内共享顶点的三角形连通为一个图表，
+ *   图表投影到主轴平面（纹素密度在世界空间均匀）
+ *
+ * 同一网格的图表先打包成一个矩形（网格只引用一张图集，运行时每个绘制绑定一张光照贴图），
+ * 网格矩形再按高度降序货架式打包到 atlasSize 的图集中。图表之间保留 padding 纹素，
+ * 避免双线性采样和扩张（dilation）时相互渗色
+ *
+ * 打包后把每个图表的三角形光栅化到图集，记录每个覆盖纹素中心的世界位置、法线和图表编号，
+ * 供烘焙器发射光线，供降噪器判断边缘
+ */
+
+#pragma once
+
+#include "../../../MathTypes.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 参与打包的网格（世界空间）
+ */
+struct LightmapChartMesh {
+    std::vector<Vector3> positions;
+
+    /** 每顶点法线（为空时使用面法线） */
+    std::vector<Vector3> normals;
+
+    std::vector<uint32_t> indices;
+
+    /** 第二套 UV（[0,1]，为空时自动展开） */
+    std::vector<Vector2> lightmapUVs;
+
+    /** 纹素密度（每米纹素数） */
+    float texelsPerUnit = 16.0f;
+};
+
+/**
+ * @brief 打包配置
+ */
+struct LightmapPackSettings {
+    /** 图集最大边长（纹素） */
+    uint32_t atlasSize = 1024;
+
+    /** 图表四周保留的纹素数 */
+    uint32_t padding = 2;
+};
+
+/**
+ * @brief 一个网格在图集中的布局
+ *
+ * 自动展开会在图表边界拆分顶点: vertexRemap[i] 为新顶点 i 对应的原顶点，
+ * indices 引用新顶点。使用第二套 UV 时 vertexRemap 为恒等映射
+ */
+struct LightmapMeshLayout {
+    uint32_t atlasIndex = 0;
+
+    std::vector<uint32_t> vertexRemap;
+    std::vector<uint32_t> indices;
+
+    /** 图集 UV（[0,1]，纹素中心在 (x + 0.5) / width） */
+    std::vector<Vector2> uvs;
+
+    /** 全局图表编号范围 [firstChart, firstChart + chartCount) */
+    uint32_t firstChart = 0;
+    uint32_t chartCount = 0;
+
+    /** 图集放不下时纹素密度被缩小的比例（1 表示未缩小） */
+    float densityScale = 1.0f;
+};
+
+/**
+ * @brief 图集中的一个纹素
+ */
+struct LightmapTexel {
+    static constexpr uint32_t InvalidChart = 0xFFFFFFFFu;
+
+    Vector3 position = Vector3(0.0f);
+    Vector3 normal = Vector3(0.0f, 1.0f, 0.0f);
+
+    /** 全局图表编号，纹素中心未被任何三角形覆盖时为 InvalidChart */
+    uint32_t chart = InvalidChart;
+
+    /** 所属网格 */
+    uint32_t mesh = 0;
+
+    bool valid() const { return chart != InvalidChart; }
+};
+
+/**
+ * @brief 一张图集的纹素布局
+ */
+struct LightmapAtlasLayout {
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /** 行优先，width * height 个 */
+    std::vector<LightmapTexel> texels;
+
+    uint32_t coveredTexels = 0;
+};
+
+/**
+ * @brief 打包结果
+ */
+struct LightmapPackResult {
+    /** 与输入网格一一对应 */
+    std::vector<LightmapMeshLayout> meshes;
+
+    std::vector<LightmapAtlasLayout> atlases;
+
+    uint32_t chartCount = 0;
+
+    /** 被覆盖纹素占图集总纹素的比例 */
+    float occupancy = 0.0f;
+};
+
+/**
+ * @brief 展开、打包并光栅化
+ */
+LightmapPackResult PackLightmaps(const std::vector<LightmapChartMesh>& meshes, const LightmapPackSettings& settings);
@@ -0,0 +1,517 @@
+/**
+ * @file LtcFitter.cpp
+ * @brief LTC 查找表拟合实现
+ */
+
+#include "LtcFitter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/** α 的下限（粗糙度 0 的 GGX 是 δ 分布） */
+constexpr float kMinAlpha = 0.00001f;
+
+/** 拟合参数: m11、m22、m13、m31 */
+constexpr int kFitParams = 4;
+
+/** Nelder-Mead 初始单纯形的步长与收敛阈值 */
+constexpr float kSimplexDelta = 0.05f;
+constexpr float kTolerance = 0.00001f;
+
+/** GL_RGBA32F、GL_RGBA、GL_FLOAT */
+constexpr uint32_t kGlRgba32f = 0x8814;
+constexpr uint32_t kGlRgba = 0x1908;
+constexpr uint32_t kGlFloat = 0x1406;
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+/** 行优先 3x3 矩阵 */
+struct Matrix3x3 {
+    float m[3][3] = {};
+
+    Vector3 operator*(const Vector3& v) const {
+        return Vector3(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+                       m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+                       m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+    }
+
+    Matrix3x3 operator*(const Matrix3x3& o) const {
+        Matrix3x3 r;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                r.m[i][j] = m[i][0] * o.m[0][j] + m[i][1] * o.m[1][j] + m[i][2] * o.m[2][j];
+            }
+        }
+        return r;
+    }
+
+    float determinant() const {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+             - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+
+    Matrix3x3 inverse() const {
+        const float invDet = 1.0f / determinant();
+        Matrix3x3 r;
+        r.m[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * invDet;
+        r.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+        r.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+        r.m[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * invDet;
+        r.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+        r.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+        r.m[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * invDet;
+        r.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+        r.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+        return r;
+    }
+};
+
+/**
+ * @brief 线性变换余弦: M = [X Y Z] * [[m11, 0, m13], [0, m22, 0], [m31, 0, 1]]
+ */
+struct Ltc {
+    float m11 = 1.0f;
+    float m22 = 1.0f;
+    float m13 = 0.0f;
+    float m31 = 0.0f;
+
+    /** 方向反照率（LTC 的幅值）与菲涅尔项 */
+    float magnitude = 1.0f;
+    float fresnel = 1.0f;
+
+    Vector3 X = Vector3(1.0f, 0.0f, 0.0f);
+    Vector3 Y = Vector3(0.0f, 1.0f, 0.0f);
+    Vector3 Z = Vector3(0.0f, 0.0f, 1.0f);
+
+    Matrix3x3 M;
+    Matrix3x3 invM;
+    float detM = 1.0f;
+
+    void update() {
+        Matrix3x3 basis;
+        for (int r = 0; r < 3; ++r) {
+            basis.m[r][0] = X[r];
+            basis.m[r][1] = Y[r];
+            basis.m[r][2] = Z[r];
+        }
+        Matrix3x3 scale;
+        scale.m[0][0] = m11;
+        scale.m[0][2] = m13;
+        scale.m[1][1] = m22;
+        scale.m[2][0] = m31;
+        scale.m[2][2] = 1.0f;
+        M = basis * scale;
+        invM = M.inverse();
+        detM = std::fabs(M.determinant());
+    }
+
+    /** 变换后的余弦分布 × magnitude */
+    float eval(const Vector3& L) const {
+        const Vector3 original = glm::normalize(invM * L);
+        const Vector3 transformed = M * original;
+        const float l = glm::length(transformed);
+        const float jacobian = detM / (l * l * l);
+        return magnitude * std::max(original.z, 0.0f) / kPi / jacobian;
+    }
+
+    Vector3 sample(float u1, float u2) const {
+        const float cosTheta = std::sqrt(u1);
+        const float sinTheta = std::sqrt(1.0f - u1);
+        const float phi = 2.0f * kPi * u2;
+        return glm::normalize(M * Vector3(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta));
+    }
+};
+
+/** Schlick 菲涅尔 F0 + (1 - F0)(1 - V·H)⁵ */
+float fresnelWeight(const Vector3& view, const Vector3& L, float f0) {
+    const Vector3 H = glm::normalize(view + L);
+    return f0 + (1.0f - f0) * std::pow(1.0f - std::max(glm::dot(view, H), 0.0f), 5.0f);
+}
+
+/** 一个纹素的拟合目标 */
+struct LtcFitContext {
+    Vector3 view;
+    float alpha;
+    uint32_t sampleCount;
+    bool isotropic;
+    float fresnelF0;
+    uint64_t evaluations = 0;
+
+    void apply(Ltc& ltc, const float params[kFitParams]) const {
+        ltc.m11 = std::max(params[0], 1e-7f);
+        ltc.m22 = isotropic ? ltc.m11 : std::max(params[1], 1e-7f);
+        ltc.m13 = isotropic ? 0.0f : params[2];
+        ltc.m31 = isotropic ? 0.0f : params[3];
+        ltc.update();
+    }
+
+    /** Σ |BRDF·F·cos - LTC|³，LTC 与 GGX 采样按 pdf 之和合并（ltc.magnitude 为带菲涅尔的反照率） */
+    float error(const Ltc& ltc) {
+        ++evaluations;
+        double sum = 0.0;
+        const float inverseCount = 1.0f / static_cast<float>(sampleCount);
+        auto accumulate = [&](const Vector3& L) {
+            float brdfPdf = 0.0f;
+            const float brdf = EvaluateGgxCosine(view, L, alpha, &brdfPdf) * fresnelWeight(view, L, fresnelF0);
+            const float lobe = ltc.eval(L);
+            const float ltcPdf = lobe / ltc.magnitude;
+            const float difference = std::fabs(brdf - lobe);
+            if (ltcPdf + brdfPdf > 0.0f) {
+                sum += static_cast<double>(difference * difference * difference / (ltcPdf + brdfPdf));
+            }
+        };
+        for (uint32_t j = 0; j < sampleCount; ++j) {
+            for (uint32_t i = 0; i < sampleCount; ++i) {
+                const float u1 = (static_cast<float>(i) + 0.5f) * inverseCount;
+                const float u2 = (static_cast<float>(j) + 0.5f) * inverseCount;
+                accumulate(ltc.sample(u1, u2));
+                accumulate(SampleGgxDirection(view, alpha, u1, u2));
+            }
+        }
+        return static_cast<float>(sum / (static_cast<double>(sampleCount) * sampleCount));
+    }
+};
+
+/**
+ * @brief kFitParams 维 Nelder-Mead（标准系数），返回最优点的目标值
+ */
+template <typename Func>
+float minimizeNelderMead(float result[kFitParams], const float start[kFitParams], uint32_t maxIterations,
+                         Func&& func) {
+    constexpr int kDim = kFitParams;
+    constexpr int kPoints = kDim + 1;
+    float s[kPoints][kDim];
+    float f[kPoints];
+
+    for (int i = 0; i < kPoints; ++i) {
+        for (int d = 0; d < kDim; ++d) {
+            s[i][d] = start[d];
+        }
+        if (i > 0) {
+            s[i][i - 1] += kSimplexDelta;
+        }
+        f[i] = func(s[i]);
+    }
+
+    int lo = 0;
+    for (uint32_t iteration = 0; iteration < maxIterations; ++iteration) {
+        // 最低、最高、次高
+        lo = 0;
+        int hi = f[0] > f[1] ? 0 : 1;
+        int nh = 1 - hi;
+        for (int i = 0; i < kPoints; ++i) {
+            if (f[i] < f[lo]) lo = i;
+            if (f[i] > f[hi]) {
+                nh = hi;
+                hi = i;
+            } else if (i != hi && f[i] > f[nh]) {
+                nh = i;
+            }
+        }
+
+        const float a = std::fabs(f[lo]);
+        const float b = std::fabs(f[hi]);
+        if (2.0f * std::fabs(a - b) < (a + b) * kTolerance) {
+            break;
+        }
+
+        // 除最高点外的重心
+        float o[kDim] = {};
+        for (int i = 0; i < kPoints; ++i) {
+            if (i == hi) continue;
+            for (int d = 0; d < kDim; ++d) {
+                o[d] += s[i][d] / kDim;
+            }
+        }
+
+        auto along = [&](float t, const float* from, float* out) {
+            for (int d = 0; d < kDim; ++d) {
+                out[d] = o[d] + t * (from[d] - o[d]);
+            }
+        };
+        auto replaceHigh = [&](const float* point, float value) {
+            for (int d = 0; d < kDim; ++d) {
+                s[hi][d] = point[d];
+            }
+            f[hi] = value;
+        };
+
+        // 反射
+        float r[kDim];
+        along(-1.0f, s[hi], r);
+        const float fr = func(r);
+        if (fr < f[lo]) {
+            // 扩展
+            float e[kDim];
+            along(2.0f, r, e);
+            const float fe = func(e);
+            if (fe < fr) {
+                replaceHigh(e, fe);
+            } else {
+                replaceHigh(r, fr);
+            }
+            continue;
+        }
+        if (fr < f[nh]) {
+            replaceHigh(r, fr);
+            continue;
+        }
+
+        // 收缩
+        float c[kDim];
+        along(0.5f, s[hi], c);
+        const float fc = func(c);
+        if (fc < f[hi]) {
+            replaceHigh(c, fc);
+            continue;
+        }
+
+        // 向最低点整体缩小
+        for (int i = 0; i < kPoints; ++i) {
+            if (i == lo) continue;
+            for (int d = 0; d < kDim; ++d) {
+                s[i][d] = s[lo][d] + 0.5f * (s[i][d] - s[lo][d]);
+            }
+            f[i] = func(s[i]);
+        }
+    }
+
+    lo = static_cast<int>(std::min_element(f, f + kPoints) - f);
+    for (int d = 0; d < kDim; ++d) {
+        result[d] = s[lo][d];
+    }
+    return f[lo];
+}
+
+/** 一行（同一粗糙度）共享的 v 坐标约定: cosθ = 1 - v² */
+Vector3 viewForRow(uint32_t row, uint32_t size) {
+    const float v = static_cast<float>(row) / static_cast<float>(size - 1);
+    const float theta = std::min(1.57f, std::acos(1.0f - v * v));
+    return Vector3(std::sin(theta), 0.0f, std::cos(theta));
+}
+
+float alphaForColumn(uint32_t column, uint32_t size) {
+    const float roughness = static_cast<float>(column) / static_cast<float>(size - 1);
+    return std::max(roughness * roughness, kMinAlpha);
+}
+
+/**
+ * @brief GGX 重要性采样积分方向反照率、菲涅尔项与平均方向（y 分量置 0）
+ *
+ * 平均方向按 fresnelF0 的菲涅尔加权，与拟合目标一致
+ */
+void computeAverageTerms(const Vector3& view, float alpha, uint32_t sampleCount, float fresnelF0, Ltc& ltc,
+                         Vector3& averageDirection) {
+    double norm = 0.0;
+    double fresnel = 0.0;
+    averageDirection = Vector3(0.0f);
+    const float inverseCount = 1.0f / static_cast<float>(sampleCount);
+    for (uint32_t j = 0; j < sampleCount; ++j) {
+        for (uint32_t i = 0; i < sampleCount; ++i) {
+            const Vector3 L = SampleGgxDirection(view, alpha, (static_cast<float>(i) + 0.5f) * inverseCount,
+                                                 (static_cast<float>(j) + 0.5f) * inverseCount);
+            float pdf = 0.0f;
+            const float brdf = EvaluateGgxCosine(view, L, alpha, &pdf);
+            if (!(pdf > 0.0f)) continue;
+
+            const float weight = brdf / pdf;
+            const Vector3 H = glm::normalize(view + L);
+            norm += weight;
+            fresnel += weight * std::pow(1.0f - std::max(glm::dot(view, H), 0.0f), 5.0f);
+            averageDirection += L * (weight * fresnelWeight(view, L, fresnelF0));
+        }
+    }
+    const double count = static_cast<double>(sampleCount) * sampleCount;
+    ltc.magnitude = static_cast<float>(norm / count);
+    ltc.fresnel = static_cast<float>(fresnel / count);
+    averageDirection.y = 0.0f;
+    averageDirection = glm::normalize(averageDirection);
+}
+
+/**
+ * @brief 拟合一个纹素；ltc 的 m11 / m22 / m13 / m31 为初值
+ * @param isotropic N·V = 1 的行: 基为单位矩阵，只拟合 m11 = m22
+ */
+void fitTexel(const LtcFitSettings& settings, uint32_t column, uint32_t row, bool isotropic, Ltc& ltc,
+               uint64_t& evaluations) {
+    const Vector3 view = viewForRow(row, settings.size);
+    const float alpha = alphaForColumn(column, settings.size);
+
+    Vector3 averageDirection;
+    computeAverageTerms(view, alpha, settings.sampleCount, settings.fresnelF0, ltc, averageDirection);
+    if (isotropic) {
+        ltc.X = Vector3(1.0f, 0.0f, 0.0f);
+        ltc.Y = Vector3(0.0f, 1.0f, 0.0f);
+        ltc.Z = Vector3(0.0f, 0.0f, 1.0f);
+        ltc.m13 = 0.0f;
+        ltc.m31 = 0.0f;
+    } else {
+        ltc.X = Vector3(averageDirection.z, 0.0f, -averageDirection.x);
+        ltc.Y = Vector3(0.0f, 1.0f, 0.0f);
+        ltc.Z = averageDirection;
+    }
+    ltc.update();
+
+    // 拟合的形状逼近 F0 = fresnelF0 的 BRDF，幅值取对应的反照率；写表的仍是分开的两项
+    const float magnitude = ltc.magnitude;
+    ltc.magnitude = settings.fresnelF0 * ltc.magnitude + (1.0f - settings.fresnelF0) * ltc.fresnel;
+
+    LtcFitContext context{view, alpha, settings.sampleCount, isotropic, settings.fresnelF0};
+    const float start[kFitParams] = {ltc.m11, ltc.m22, ltc.m13, ltc.m31};
+    float best[kFitParams];
+    minimizeNelderMead(best, start, settings.maxIterations, [&](const float* params) {
+        context.apply(ltc, params);
+        return context.error(ltc);
+    });
+    context.apply(ltc, best);
+    ltc.magnitude = magnitude;
+    evaluations += context.evaluations;
+}
+
+/** M⁻¹ 按 [1][1] 归一化后的 4 个可变元素 + 幅值 */
+void storeTexel(const Ltc& ltc, uint32_t column, uint32_t row, LtcTable& table) {
+    const Matrix3x3 inverse = ltc.invM;
+    const float scale = 1.0f / inverse.m[1][1];
+    const size_t index = static_cast<size_t>(row) * table.size + column;
+    table.matrix[index] = Vector4(inverse.m[0][0], inverse.m[2][0], inverse.m[0][2], inverse.m[2][2]) * scale;
+    table.amplitude[index].x = ltc.magnitude;
+    table.amplitude[index].y = ltc.fresnel;
+    table.amplitude[index].z = 0.0f;
+}
+
+bool writeUint32(FILE* file, uint32_t value) {
+    return std::fwrite(&value, sizeof(value), 1, file) == 1;
+}
+
+bool writeKtxRgba32f(const TaggedVector<Vector4, MemoryTag::Lighting>& texels, uint32_t size, const char* path) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    static const uint8_t identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    bool ok = std::fwrite(identifier, sizeof(identifier), 1, file) == 1;
+    ok = ok && writeUint32(file, 0x04030201);                                  // endianness
+    ok = ok && writeUint32(file, kGlFloat);                                    // glType
+    ok = ok && writeUint32(file, 4);                                           // glTypeSize
+    ok = ok && writeUint32(file, kGlRgba);                                     // glFormat
+    ok = ok && writeUint32(file, kGlRgba32f);                                  // glInternalFormat
+    ok = ok && writeUint32(file, kGlRgba);                                     // glBaseInternalFormat
+    ok = ok && writeUint32(file, size);
+    ok = ok && writeUint32(file, size);
+    ok = ok && writeUint32(file, 0);                                           // pixelDepth
+    ok = ok && writeUint32(file, 0);                                           // numberOfArrayElements
+    ok = ok && writeUint32(file, 1);                                           // numberOfFaces
+    ok = ok && writeUint32(file, 1);                                           // numberOfMipmapLevels
+    ok = ok && writeUint32(file, 0);                                           // bytesOfKeyValueData
+
+    ok = ok && writeUint32(file, static_cast<uint32_t>(texels.size() * sizeof(Vector4)));
+    for (const Vector4& texel : texels) {
+        const float rgba[4] = {texel.x, texel.y, texel.z, texel.w};
+        ok = ok && std::fwrite(rgba, sizeof(rgba), 1, file) == 1;
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+} // namespace
+
+LtcFitStats FitLtcTable(const LtcFitSettings& settings, LtcTable& table) {
+    const Clock::time_point start = Clock::now();
+
+    LtcFitSettings fit = settings;
+    fit.size = std::max(fit.size, 2u);
+    fit.sampleCount = std::max(fit.sampleCount, 1u);
+
+    const uint32_t size = fit.size;
+    table.size = size;
+    table.matrix.assign(static_cast<size_t>(size) * size, Vector4(1.0f, 0.0f, 0.0f, 1.0f));
+    table.amplitude.assign(static_cast<size_t>(size) * size, Vector4(0.0f));
+
+    LtcFitStats stats;
+    stats.size = size;
+
+    // N·V = 1 的行: 粗糙度从 1 向 0，以上一粗糙度的结果为初值
+    std::vector<Ltc> firstColumn(size);
+    Ltc previous;
+    for (uint32_t column = size; column-- > 0;) {
+        Ltc ltc;
+        ltc.m11 = previous.m11;
+        ltc.m22 = previous.m22;
+        fitTexel(fit, column, 0, true, ltc, stats.evaluations);
+        storeTexel(ltc, column, 0, table);
+        firstColumn[column] = ltc;
+        previous = ltc;
+    }
+
+    // 其余行: 每个粗糙度一个工作项，沿 v 方向以上一纹素为初值
+    std::atomic<uint32_t> nextColumn{0};
+    std::atomic<uint64_t> evaluations{0};
+    auto worker = [&]() {
+        uint64_t localEvaluations = 0;
+        for (;;) {
+            const uint32_t column = nextColumn.fetch_add(1, std::memory_order_relaxed);
+            if (column >= size) {
+                break;
+            }
+            Ltc ltc = firstColumn[column];
+            for (uint32_t row = 1; row < size; ++row) {
+                fitTexel(fit, column, row, false, ltc, localEvaluations);
+                storeTexel(ltc, column, row, table);
+            }
+        }
+        evaluations.fetch_add(localEvaluations, std::memory_order_relaxed);
+    };
+
+    const uint32_t threadCount = std::max(1u, std::min<uint32_t>(
+        fit.threadCount > 0 ? fit.threadCount : std::max(1u, std::thread::hardware_concurrency()), size));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    stats.threads = threadCount;
+    stats.evaluations += evaluations.load();
+
+    // 球体地平线裁剪比例（u = z * 0.5 + 0.5，v = 未裁剪的形状因子）
+    for (uint32_t row = 0; row < size; ++row) {
+        for (uint32_t column = 0; column < size; ++column) {
+            const float z = 2.0f * static_cast<float>(column) / static_cast<float>(size - 1) - 1.0f;
+            const float formFactor = static_cast<float>(row) / static_cast<float>(size - 1);
+            table.amplitude[static_cast<size_t>(row) * size + column].w =
+                formFactor > 0.0f ? GetHorizonClippedSphereFormFactor(z, formFactor) / formFactor : std::max(z, 0.0f);
+        }
+    }
+
+    stats.totalMs = elapsedMs(start);
+    return stats;
+}
+
+bool WriteLtcTableKtx(const LtcTable& table, const char* matrixPath, const char* amplitudePath) {
+    return table.isValid() && writeKtxRgba32f(table.matrix, table.size, matrixPath)
+        && writeKtxRgba32f(table.amplitude, table.size, amplitudePath);
+}
+
+void LtcFitStats::writeReport(FILE* out) const {
+    std::fprintf(out, "LTC fit\n");
+    std::fprintf(out, "  table         %ux%u\n", size, size);
+    std::fprintf(out, "  evaluations   %llu on %u threads\n", static_cast<unsigned long long>(evaluations), threads);
+    std::fprintf(out, "  time (ms)     %.1f\n", totalMs);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file LtcFitter.h
+ * @brief LTC 查找表拟合 - 为区域光着色（AreaLighting.h）离线生成 ltc_1 / ltc_2
+ *
+ * 按 Heitz et al. 2016 的方法，对每个 (感知粗糙度, sqrt(1 - N·V)) 用 Nelder-Mead 拟合一个
+ * 线性变换余弦 M（4 个参数 m11、m22、m13、m31，基为 BRDF 平均方向），使其逼近 EvaluateGgxCosine:
+ * - 误差为 |BRDF·F·cos - LTC|³，LTC 与 GGX 两种重要性采样以多重重要性采样合并。
+ *   F 为 F0 = fresnelF0 的 Schlick 菲涅尔: 只拟合不带菲涅尔的形状时，电介质（F0 ≈ 0.04）
+ *   在中高粗糙度下误差明显偏大；取 0.1 让电介质与金属在有效范围内都比不加权时更准确
+ * - m31 让 xz 平面内的 2x2 块不再受限于下三角为 0（Heitz 的 3 参数形式），表中存储的 M⁻¹
+ *   本来就是完整的 2x2 块，着色器无需改动
+ * - N·V = 1 的第一行各向同性，粗糙度从 1 向 0 推进，以上一粗糙度的结果为初值（顺序执行）；
+ *   其余行以同一粗糙度上一行的结果为初值，不同粗糙度的列之间互不依赖（多线程）
+ * - 误差在粗糙度趋于 0 时随 BRDF 峰值发散，不作为质量指标；BasicPipelineLtcFit 拟合后
+ *   以 IntegrateAreaLightReference 抽查着色误差，按 kLtcMinValidNdotV 分有效范围与掠射视角报告
+ *   （掠射视角的误差是 LTC 近似本身的限制，见 AreaLighting.h）
+ * - ltc_2 的方向反照率与菲涅尔项由 GGX 重要性采样积分得到，.w 为球体地平线裁剪比例
+ *   GetHorizonClippedSphereFormFactor(z, f) / f（与粗糙度无关，u = z * 0.5 + 0.5、v = f）
+ *
+ * 结果与线程数无关。工具 BasicPipelineLtcFit 用它生成 assets 中 textures/LTC/ 下发布的两张表
+ *
+ * 用法:
+ * @code
+ *
+ * LtcTable table;
+ * LtcFitStats stats = FitLtcTable(LtcFitSettings(), table);
+ * WriteLtcTableKtx(table, "ltc_1.ktx", "ltc_2.ktx");
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "../AreaLighting.h"
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief 拟合配置
+ */
+struct LtcFitSettings {
+    /** 表的边长 */
+    uint32_t size = kLtcTableSize;
+
+    /** 每种重要性采样的分层采样数为 sampleCount² */
+    uint32_t sampleCount = 32;
+
+    /** 每个纹素的 Nelder-Mead 迭代上限 */
+    uint32_t maxIterations = 100;
+
+    /** 工作线程数（0 为硬件线程数） */
+    uint32_t threadCount = 0;
+
+    /** 拟合形状时使用的菲涅尔 F0（1 为不加权）；ltc_2 的反照率与菲涅尔项不受影响 */
+    float fresnelF0 = 0.1f;
+};
+
+/**
+ * @brief 拟合统计
+ */
+struct LtcFitStats {
+    uint32_t size = 0;
+    uint32_t threads = 0;
+
+    /** 目标函数求值次数 */
+    uint64_t evaluations = 0;
+
+    float totalMs = 0.0f;
+
+    void writeReport(FILE* out) const;
+};
+
+/**
+ * @brief 拟合整张表（阻塞）
+ */
+LtcFitStats FitLtcTable(const LtcFitSettings& settings, LtcTable& table);
+
+/**
+ * @brief 写出两张 RGBA32F KTX 1.1 纹理（单 mip，ReadLtcTableKtx 读取）
+ * @return 表无效、无法打开或写入文件时返回 false
+ */
+bool WriteLtcTableKtx(const LtcTable& table, const char* matrixPath, const char* amplitudePath);
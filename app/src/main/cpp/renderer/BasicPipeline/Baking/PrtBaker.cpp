@@ -0,0 +1,305 @@
+/**
+ * @file PrtBaker.cpp
+ * @brief 预计算辐射传输烘焙器实现
+ */
+
+#include "PrtBaker.h"
+#include "BakeBVH.h"
+#include "BakeSampling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+/** 每个工作项处理的顶点数（探针每个工作项一个） */
+constexpr uint32_t kVerticesPerTask = 64;
+
+/** 工作项的网格编号: 探针 */
+constexpr uint32_t kProbeTask = ~0u;
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+/** 世界空间的场景几何 */
+struct PrtGeometry {
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    std::vector<Vector3> faceNormals;
+    std::vector<uint32_t> triangleMesh;
+
+    /** 每个网格的世界空间顶点与法线 */
+    std::vector<std::vector<Vector3>> meshPositions;
+    std::vector<std::vector<Vector3>> meshNormals;
+};
+
+PrtGeometry buildGeometry(const std::vector<BakeMesh>& meshes) {
+    PrtGeometry geometry;
+    geometry.meshPositions.resize(meshes.size());
+    geometry.meshNormals.resize(meshes.size());
+
+    for (uint32_t m = 0; m < meshes.size(); ++m) {
+        const BakeMesh& mesh = meshes[m];
+        const Matrix4 normalMatrix = glm::transpose(glm::inverse(mesh.worldMatrix));
+        const uint32_t baseVertex = static_cast<uint32_t>(geometry.positions.size());
+
+        std::vector<Vector3>& positions = geometry.meshPositions[m];
+        positions.reserve(mesh.positions.size());
+        for (const Vector3& p : mesh.positions) {
+            positions.push_back(Vector3(mesh.worldMatrix * Vector4(p, 1.0f)));
+        }
+
+        // 没有法线时用面积加权的面法线
+        std::vector<Vector3>& normals = geometry.meshNormals[m];
+        const bool hasNormals = mesh.normals.size() == mesh.positions.size();
+        normals.assign(positions.size(), Vector3(0.0f));
+        for (uint32_t v = 0; hasNormals && v < mesh.normals.size(); ++v) {
+            normals[v] = Vector3(normalMatrix * Vector4(mesh.normals[v], 0.0f));
+        }
+
+        geometry.positions.insert(geometry.positions.end(), positions.begin(), positions.end());
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const uint32_t ia = mesh.indices[i + 0];
+            const uint32_t ib = mesh.indices[i + 1];
+            const uint32_t ic = mesh.indices[i + 2];
+            const Vector3 n = glm::cross(positions[ib] - positions[ia], positions[ic] - positions[ia]);
+            const float length = glm::length(n);
+            geometry.faceNormals.push_back(length > 0.0f ? n / length : Vector3(0.0f, 1.0f, 0.0f));
+            geometry.triangleMesh.push_back(m);
+            geometry.indices.push_back(baseVertex + ia);
+            geometry.indices.push_back(baseVertex + ib);
+            geometry.indices.push_back(baseVertex + ic);
+            if (!hasNormals) {
+                normals[ia] += n;
+                normals[ib] += n;
+                normals[ic] += n;
+            }
+        }
+
+        for (Vector3& n : normals) {
+            const float length = glm::length(n);
+            n = length > 0.0f ? n / length : Vector3(0.0f, 1.0f, 0.0f);
+        }
+    }
+    return geometry;
+}
+
+/** 一个工作线程的追踪上下文 */
+struct PrtTraceContext {
+    const BakeBVH& bvh;
+    const PrtGeometry& geometry;
+    const std::vector<BakeMesh>& meshes;
+    const PrtBakeSettings& settings;
+
+    uint64_t rays = 0;
+
+    /**
+     * @brief 从 position 沿 direction 出发的漫反射路径
+     * @param throughput 逃逸时路径的吞吐量（albedo 连乘）
+     * @param escape 逃逸方向
+     * @param bounces 逃逸前的弹射次数
+     * @return 路径逃逸到远处时返回 true
+     */
+    bool trace(Vector3 position, Vector3 direction, BakeRandom& random,
+               Vector3& throughput, Vector3& escape, uint32_t& bounces) {
+        throughput = Vector3(1.0f);
+        for (bounces = 0;; ++bounces) {
+            ++rays;
+            BakeRay ray;
+            ray.origin = position;
+            ray.direction = direction;
+            BakeHit hit;
+            if (!bvh.intersect(ray, hit)) {
+                escape = direction;
+                return true;
+            }
+
+            const Vector3& normal = geometry.faceNormals[hit.triangle];
+            if (glm::dot(normal, direction) > 0.0f || bounces >= settings.maxBounces) {
+                return false;
+            }
+
+            throughput = throughput * meshes[geometry.triangleMesh[hit.triangle]].albedo;
+            position = position + direction * hit.t + normal * settings.rayBias;
+            direction = SampleCosineHemisphere(normal, random);
+        }
+    }
+
+    void bakeProbe(const Vector3& position, BakeRandom& random,
+                   float matrix[3][kPrtCoefficients][kPrtCoefficients]) {
+        std::fill(&matrix[0][0][0], &matrix[0][0][0] + 3 * kPrtCoefficients * kPrtCoefficients, 0.0f);
+        const uint32_t samples = std::max(settings.probeSamples, 1u);
+
+        float incoming[kPrtCoefficients];
+        float outgoing[kPrtCoefficients];
+        for (uint32_t s = 0; s < samples; ++s) {
+            const Vector3 direction = SampleUniformSphere(random);
+            Vector3 throughput;
+            Vector3 escape;
+            uint32_t bounces = 0;
+            if (!trace(position, direction, random, throughput, escape, bounces)
+                || (!settings.includeDirect && bounces == 0)) {
+                continue;
+            }
+
+            EvaluateSHBasis(direction, incoming);
+            EvaluateSHBasis(escape, outgoing);
+            for (uint32_t c = 0; c < 3; ++c) {
+                for (uint32_t i = 0; i < kPrtCoefficients; ++i) {
+                    const float weight = incoming[i] * throughput[c];
+                    for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                        matrix[c][i][j] += weight * outgoing[j];
+                    }
+                }
+            }
+        }
+
+        // 均匀球面采样的权重 4π / N
+        const float scale = 4.0f * kBakePi / static_cast<float>(samples);
+        for (float* m = &matrix[0][0][0]; m != &matrix[0][0][0] + 3 * kPrtCoefficients * kPrtCoefficients; ++m) {
+            *m *= scale;
+        }
+    }
+
+    void bakeVertex(const Vector3& position, const Vector3& normal, BakeRandom& random,
+                    float vector[3][kPrtCoefficients]) {
+        std::fill(&vector[0][0], &vector[0][0] + 3 * kPrtCoefficients, 0.0f);
+        const uint32_t samples = std::max(settings.vertexSamples, 1u);
+        const Vector3 origin = position + normal * settings.rayBias;
+
+        float outgoing[kPrtCoefficients];
+        for (uint32_t s = 0; s < samples; ++s) {
+            Vector3 throughput;
+            Vector3 escape;
+            uint32_t bounces = 0;
+            if (!trace(origin, SampleCosineHemisphere(normal, random), random, throughput, escape, bounces)
+                || (!settings.includeDirect && bounces == 0)) {
+                continue;
+            }
+
+            // 余弦加权采样: (1/π)∫ L cos dω 的估计就是逃逸方向的辐射度
+            EvaluateSHBasis(escape, outgoing);
+            for (uint32_t c = 0; c < 3; ++c) {
+                for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                    vector[c][j] += throughput[c] * outgoing[j];
+                }
+            }
+        }
+
+        const float scale = 1.0f / static_cast<float>(samples);
+        for (float* v = &vector[0][0]; v != &vector[0][0] + 3 * kPrtCoefficients; ++v) {
+            *v *= scale;
+        }
+    }
+};
+
+} // namespace
+
+PrtBakeResult PrtBaker::bake(const std::vector<BakeMesh>& meshes, const std::vector<Vector3>& probePositions) const {
+    const Clock::time_point bakeStart = Clock::now();
+    PrtBakeResult result;
+    PrtBakeStats& stats = result.stats;
+    stats.meshes = static_cast<uint32_t>(meshes.size());
+    stats.probes = static_cast<uint32_t>(probePositions.size());
+
+    // 1. 世界空间几何与 BVH
+    Clock::time_point phaseStart = Clock::now();
+    const PrtGeometry geometry = buildGeometry(meshes);
+    BakeBVH bvh;
+    bvh.build(geometry.positions, geometry.indices);
+    stats.triangles = static_cast<uint32_t>(geometry.faceNormals.size());
+    stats.bvhMs = elapsedMs(phaseStart);
+
+    // 2. 追踪
+    phaseStart = Clock::now();
+    struct Task {
+        uint32_t mesh;
+        uint32_t first;
+        uint32_t count;
+    };
+    std::vector<Task> tasks;
+    result.probes.resize(stats.probes);
+    for (uint32_t p = 0; p < stats.probes; ++p) {
+        tasks.push_back({kProbeTask, p, 1});
+    }
+    result.meshes.resize(meshes.size());
+    for (uint32_t m = 0; m < meshes.size(); ++m) {
+        if (!meshes[m].receiveLightmap) {
+            continue;
+        }
+        const uint32_t vertexCount = static_cast<uint32_t>(geometry.meshPositions[m].size());
+        result.meshes[m].resize(vertexCount);
+        stats.vertices += vertexCount;
+        for (uint32_t v = 0; v < vertexCount; v += kVerticesPerTask) {
+            tasks.push_back({m, v, std::min(kVerticesPerTask, vertexCount - v)});
+        }
+    }
+
+    // 每个探针/顶点写入自己的位置，不需要同步
+    std::atomic<uint32_t> nextTask{0};
+    std::atomic<uint64_t> totalRays{0};
+    auto worker = [&]() {
+        PrtTraceContext context{bvh, geometry, meshes, settings_};
+        float matrix[3][kPrtCoefficients][kPrtCoefficients];
+        float vector[3][kPrtCoefficients];
+        for (;;) {
+            const uint32_t taskIndex = nextTask.fetch_add(1, std::memory_order_relaxed);
+            if (taskIndex >= tasks.size()) {
+                break;
+            }
+            const Task& task = tasks[taskIndex];
+            if (task.mesh == kProbeTask) {
+                BakeRandom random(HashBakeSeed(settings_.seed, 0, task.first));
+                context.bakeProbe(probePositions[task.first], random, matrix);
+                result.probes.setProbe(task.first, matrix);
+                continue;
+            }
+
+            for (uint32_t v = task.first; v < task.first + task.count; ++v) {
+                BakeRandom random(HashBakeSeed(settings_.seed, task.mesh + 1, v));
+                context.bakeVertex(geometry.meshPositions[task.mesh][v], geometry.meshNormals[task.mesh][v],
+                                   random, vector);
+                result.meshes[task.mesh].setVertex(v, vector);
+            }
+        }
+        totalRays.fetch_add(context.rays, std::memory_order_relaxed);
+    };
+
+    const uint32_t threadCount = std::max(1u, std::min<uint32_t>(
+        settings_.threadCount > 0 ? settings_.threadCount : std::max(1u, std::thread::hardware_concurrency()),
+        static_cast<uint32_t>(tasks.size())));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    stats.threads = threadCount;
+    stats.rays = totalRays.load();
+    stats.traceMs = elapsedMs(phaseStart);
+
+    stats.totalMs = elapsedMs(bakeStart);
+    return result;
+}
+
+void PrtBakeResult::writeReport(FILE* out) const {
+    size_t vertexBytes = 0;
+    for (const PrtVertexTransfer& mesh : meshes) {
+        vertexBytes += mesh.getMemoryBytes();
+    }
+    std::fprintf(out, "PRT bake\n");
+    std::fprintf(out, "  meshes        %u, %u triangles\n", stats.meshes, stats.triangles);
+    std::fprintf(out, "  probes        %u (%zu bytes)\n", stats.probes, probes.getMemoryBytes());
+    std::fprintf(out, "  vertices      %u (%zu bytes)\n", stats.vertices, vertexBytes);
+    std::fprintf(out, "  rays          %llu on %u threads (%.2f Mrays/s)\n",
+                 static_cast<unsigned long long>(stats.rays), stats.threads, stats.megaRaysPerSecond());
+    std::fprintf(out, "  time (ms)     bvh %.1f, trace %.1f, total %.1f\n", stats.bvhMs, stats.traceMs, stats.totalMs);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file PrtBaker.h
+ * @brief 预计算辐射传输烘焙器 - 为探针和静态网格顶点烘焙 L2 球谐传输（PrtLighting.h）
+ *
+ * 与 LightmapBaker 共用 BakeMesh、BVH 和采样工具，同样多线程、结果与线程数无关:
+ * - 探针: 均匀球面方向发射 probeSamples 条路径。路径从探针出发，命中表面后按 albedo
+ *   衰减并余弦采样继续弹射（最多 maxBounces 次），逃逸到远处时在入射方向 ω 与逃逸方向 ω'
+ *   之间累加 Y_i(ω) * 吞吐量 * Y_j(ω')，得到 9x9 传输矩阵（每通道）
+ * - 顶点: 沿法线余弦采样 vertexSamples 条路径，逃逸时累加 吞吐量 * Y_j(ω')，
+ *   得到 9 维传输向量（含余弦、遮挡和弹射，与光照贴图同约定）
+ *
+ * includeDirect 为 false 时只累加至少弹射一次的路径: 太阳的直接光由实时光照计算时使用，
+ * 否则直接光会被计算两次
+ *
+ * 用法:
+ * @code
+ *
+ * PrtBaker baker;
+ * baker.setSettings(settings);
+ * PrtBakeResult result = baker.bake(meshes, probePositions);
+ * // result.probes: 探针传输矩阵；result.meshes[i]: 网格 i 的顶点传输向量
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "LightmapBaker.h"
+#include "../PrtLighting.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief PRT 烘焙配置
+ */
+struct PrtBakeSettings {
+    /** 每个探针的路径数 */
+    uint32_t probeSamples = 4096;
+
+    /** 每个顶点的路径数 */
+    uint32_t vertexSamples = 1024;
+
+    /** 漫反射弹射次数（0 只有遮挡） */
+    uint32_t maxBounces = 2;
+
+    /** 光线起点沿法线的偏移（米） */
+    float rayBias = 0.002f;
+
+    /** 包含未经弹射的直接光（遮挡后的远处光照） */
+    bool includeDirect = true;
+
+    /** 工作线程数（0 为硬件线程数） */
+    uint32_t threadCount = 0;
+
+    uint32_t seed = 1;
+};
+
+/**
+ * @brief PRT 烘焙统计
+ */
+struct PrtBakeStats {
+    uint32_t meshes = 0;
+    uint32_t triangles = 0;
+    uint32_t probes = 0;
+    uint32_t vertices = 0;
+
+    uint32_t threads = 0;
+    uint64_t rays = 0;
+
+    float bvhMs = 0.0f;
+    float traceMs = 0.0f;
+    float totalMs = 0.0f;
+
+    /** 每秒光线数（百万） */
+    float megaRaysPerSecond() const { return traceMs > 0.0f ? static_cast<float>(rays) / (traceMs * 1000.0f) : 0.0f; }
+};
+
+/**
+ * @brief PRT 烘焙结果
+ */
+struct PrtBakeResult {
+    PrtProbeTransfer probes;
+
+    /** 与输入网格一一对应，顶点顺序同 BakeMesh::positions（receiveLightmap 为 false 的网格为空） */
+    std::vector<PrtVertexTransfer> meshes;
+
+    PrtBakeStats stats;
+
+    void writeReport(FILE* out) const;
+};
+
+/**
+ * @brief CPU PRT 烘焙器
+ */
+class PrtBaker {
+public:
+    void setSettings(const PrtBakeSettings& settings) { settings_ = settings; }
+    const PrtBakeSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 烘焙（阻塞）
+     * @param meshes 静态几何（遮挡与弹射），receiveLightmap 的网格同时烘焙顶点传输
+     * @param probePositions 探针位置（世界空间）
+     */
+    PrtBakeResult bake(const std::vector<BakeMesh>& meshes, const std::vector<Vector3>& probePositions) const;
+
+private:
+    PrtBakeSettings settings_;
+};
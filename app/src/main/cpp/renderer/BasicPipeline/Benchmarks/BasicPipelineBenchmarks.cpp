@@ -0,0 +1,911 @@
+/**
+ * @file BasicPipelineBenchmarks.cpp
+ * @brief BasicPipeline CPU 热点路径的微基准测试
+ *
+ * 覆盖:
+ * - RenderQueue::sort（所有 SortMode）
+ * - FrustumCuller / Frustum::classifyAABB / CameraSnapshot SoA 平面
+ * - 屏幕投影与拾取射线: 逐点 vs SoA 批量
+ * - ResourcePool 分配/释放/查询
+ * - TempTexturePool
+ * - LightingData::getImportantLights
+ * - PRT 光照投影与探针/顶点重新计算（SIMD 内核）
+ * - 球谐: 逐方向 vs SoA 批量求值、立方体贴图投影、旋转
+ * - 光源聚合（LOD）与聚合前后的逐点着色开销
+ * - 区域光: 矩形 / 圆盘的 LTC 着色与漫反射形状因子
+ * - ShadowAtlas 分配
+ * - RenderQueueBuilder: 组件存储 vs GameObject 遍历
+ * - Profiler 区段开销
+ * - GpuProfiler 每帧记录与读取开销（模拟后端）
+ *
+ * 所有数据使用固定种子生成，结果可重复
+ */
+
+#include "BenchmarkHarness.h"
+
+#include "../RenderQueue.h"
+#include "../RenderableStorage.h"
+#include "../Frustum.h"
+#include "../CameraSnapshot.h"
+#include "../ScreenProjection.h"
+#include "../RenderHandle.h"
+#include "../LightingData.h"
+#include "../PrtLighting.h"
+#include "../SphericalHarmonics.h"
+#include "../LightAggregator.h"
+#include "../AreaLighting.h"
+#include "../Baking/LtcFitter.h"
+#include "../ShadowSettings.h"
+#include "../Profiler.h"
+#include "../GpuProfiler.h"
+
+#include <memory>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kSeed = 0x5EED1234u;
+
+// ============================================================================
+// 数据生成
+// ============================================================================
+
+Frustum makeBenchFrustum() {
+    // 位于原点、朝向 -Z 的 60 度透视相机
+    return Frustum::fromCamera(Vector3(0.0f), Vector3(0.0f, 0.0f, -1.0f),
+                               Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f),
+                               0.1f, 500.0f, glm::radians(60.0f), 16.0f / 9.0f);
+}
+
+std::vector<RenderObject> makeRenderObjects(size_t count) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+    std::uniform_int_distribution<uint64_t> material(0, 255);
+
+    std::vector<RenderObject> objects(count);
+    for (auto& obj : objects) {
+        obj.center = Vector3(pos(rng), pos(rng) * 0.1f, pos(rng));
+        obj.radius = 1.0f;
+        obj.materialID = material(rng);
+        obj.distanceToCamera = glm::length(obj.center);
+    }
+    return objects;
+}
+
+RenderableDesc makeDesc(std::mt19937& rng) {
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+    std::uniform_int_distribution<uint64_t> material(0, 255);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    RenderableDesc desc;
+    desc.center = Vector3(pos(rng), pos(rng) * 0.1f, pos(rng));
+    desc.radius = 1.0f;
+    desc.materialID = material(rng);
+    desc.queueID = unit(rng) < 0.1f ? RenderQueueId::Transparent : RenderQueueId::Opaque;
+    return desc;
+}
+
+/** 一个排序用例：每次迭代重新填充后排序 */
+bench::BenchmarkBody makeSortCase(size_t count, SortMode mode) {
+    auto source = std::make_shared<std::vector<RenderObject>>(makeRenderObjects(count));
+    auto queue = std::make_shared<RenderQueue>(RenderQueueId::Opaque, "Bench");
+    queue->setSortMode(mode);
+
+    return [source, queue] {
+        queue->clear();
+        queue->addObjects(*source);
+        queue->sort();
+        bench::doNotOptimize(queue->getObjects().data());
+    };
+}
+
+// ============================================================================
+// GameObject 遍历模拟
+//
+// 组件挂在堆上的 GameObject 上，通过 dynamic_cast 查找，
+// 对象以打乱的顺序存放在 shared_ptr 数组中，还原真实场景中的指针追逐。
+// ============================================================================
+
+struct SimComponent {
+    virtual ~SimComponent() = default;
+};
+
+struct SimTransform : SimComponent {
+    Matrix4 world = Matrix4(1.0f);
+};
+
+struct SimMeshRenderer : SimComponent {
+    RenderableDesc desc;
+};
+
+struct SimGameObject {
+    std::vector<std::unique_ptr<SimComponent>> components;
+
+    template<typename T>
+    T* getComponent() {
+        for (auto& c : components) {
+            if (auto* typed = dynamic_cast<T*>(c.get())) {
+                return typed;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// RenderQueue::sort
+// ============================================================================
+
+BENCHMARK_CASE("RenderQueue.refill", {1000, 10000, 100000}) {
+    auto source = std::make_shared<std::vector<RenderObject>>(makeRenderObjects(count));
+    auto queue = std::make_shared<RenderQueue>(RenderQueueId::Opaque, "Bench");
+    return [source, queue] {
+        queue->clear();
+        queue->addObjects(*source);
+        bench::doNotOptimize(queue->getObjects().data());
+    };
+}
+
+BENCHMARK_CASE("RenderQueue.sort/None", {1000, 10000, 100000}) {
+    return makeSortCase(count, SortMode::None);
+}
+
+BENCHMARK_CASE("RenderQueue.sort/FrontToBack", {1000, 10000, 100000}) {
+    return makeSortCase(count, SortMode::FrontToBack);
+}
+
+BENCHMARK_CASE("RenderQueue.sort/BackToFront", {1000, 10000, 100000}) {
+    return makeSortCase(count, SortMode::BackToFront);
+}
+
+BENCHMARK_CASE("RenderQueue.sort/ByMaterial", {1000, 10000, 100000}) {
+    return makeSortCase(count, SortMode::ByMaterial);
+}
+
+BENCHMARK_CASE("RenderQueue.sort/MaterialThenDistance", {1000, 10000, 100000}) {
+    return makeSortCase(count, SortMode::MaterialThenDistance);
+}
+
+// ============================================================================
+// 视锥剔除
+// ============================================================================
+
+namespace {
+
+struct BenchSphere {
+    Vector3 center;
+    float radius;
+
+    const Vector3& getCenter() const { return center; }
+    float getRadius() const { return radius; }
+};
+
+} // namespace
+
+BENCHMARK_CASE("FrustumCuller.cull", {1000, 10000, 100000}) {
+    auto objects = makeRenderObjects(count);
+    auto spheres = std::make_shared<std::vector<BenchSphere>>();
+    spheres->reserve(count);
+    for (const auto& obj : objects) {
+        spheres->push_back({obj.center, obj.radius});
+    }
+
+    auto culler = std::make_shared<FrustumCuller>(makeBenchFrustum());
+    auto visible = std::make_shared<std::vector<const BenchSphere*>>();
+
+    return [spheres, culler, visible] {
+        culler->cull(*spheres, *visible);
+        bench::doNotOptimize(visible->size());
+    };
+}
+
+BENCHMARK_CASE("Frustum.classifyAABB", {1000, 10000, 100000}) {
+    auto objects = makeRenderObjects(count);
+    auto boxes = std::make_shared<std::vector<std::pair<Vector3, Vector3>>>();
+    boxes->reserve(count);
+    for (const auto& obj : objects) {
+        boxes->emplace_back(obj.center - Vector3(obj.radius), obj.center + Vector3(obj.radius));
+    }
+
+    const Frustum frustum = makeBenchFrustum();
+
+    return [boxes, frustum] {
+        uint32_t inside = 0;
+        for (const auto& box : *boxes) {
+            inside += frustum.classifyAABB(box.first, box.second) != Frustum::IntersectionResult::Outside;
+        }
+        bench::doNotOptimize(inside);
+    };
+}
+
+BENCHMARK_CASE("CameraSnapshot.isSphereVisible", {1000, 10000, 100000}) {
+    auto objects = makeRenderObjects(count);
+    auto spheres = std::make_shared<std::vector<BenchSphere>>();
+    spheres->reserve(count);
+    for (const auto& obj : objects) {
+        spheres->push_back({obj.center, obj.radius});
+    }
+
+    auto snapshot = std::make_shared<CameraSnapshot>();
+    snapshot->frustum = makeBenchFrustum();
+    snapshot->frustumPlanes = FrustumPlanesSoA::fromFrustum(snapshot->frustum);
+
+    return [spheres, snapshot] {
+        uint32_t visible = 0;
+        for (const auto& sphere : *spheres) {
+            visible += snapshot->isSphereVisible(sphere.center, sphere.radius);
+        }
+        bench::doNotOptimize(visible);
+    };
+}
+
+// ============================================================================
+// 屏幕投影
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t kBenchScreenWidth = 1920;
+constexpr uint32_t kBenchScreenHeight = 1080;
+
+Matrix4 makeBenchViewProjection() {
+    const Matrix4 view = glm::lookAt(Vector3(0.0f, 20.0f, 0.0f), Vector3(0.0f, 0.0f, -100.0f),
+                                     Vector3(0.0f, 1.0f, 0.0f));
+    const Matrix4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    return projection * view;
+}
+
+/** SoA 点数组（x、y、z 连续存放） */
+struct BenchPointsSoA {
+    std::vector<float> x, y, z;
+
+    explicit BenchPointsSoA(size_t count) : x(count), y(count), z(count) {}
+    PointsSoA view() { return {x.data(), y.data(), z.data()}; }
+};
+
+} // namespace
+
+BENCHMARK_CASE("ScreenProjection.worldToScreen/Scalar", {10000}) {
+    auto objects = makeRenderObjects(count);
+    auto points = std::make_shared<std::vector<Vector3>>();
+    points->reserve(count);
+    for (const auto& obj : objects) {
+        points->push_back(obj.center);
+    }
+    auto screen = std::make_shared<std::vector<Vector3>>(count);
+    auto flags = std::make_shared<std::vector<uint8_t>>(count);
+    const Matrix4 viewProjection = makeBenchViewProjection();
+
+    return [points, screen, flags, viewProjection] {
+        for (size_t i = 0; i < points->size(); ++i) {
+            (*screen)[i] = WorldToScreenPoint(viewProjection, (*points)[i],
+                                              kBenchScreenWidth, kBenchScreenHeight, &(*flags)[i]);
+        }
+        bench::doNotOptimize(screen->data());
+    };
+}
+
+BENCHMARK_CASE("ScreenProjection.worldToScreen/Batch", {10000}) {
+    auto objects = makeRenderObjects(count);
+    auto points = std::make_shared<BenchPointsSoA>(count);
+    for (size_t i = 0; i < count; ++i) {
+        points->x[i] = objects[i].center.x;
+        points->y[i] = objects[i].center.y;
+        points->z[i] = objects[i].center.z;
+    }
+    auto screen = std::make_shared<BenchPointsSoA>(count);
+    auto flags = std::make_shared<std::vector<uint8_t>>(count);
+    const Matrix4 viewProjection = makeBenchViewProjection();
+
+    return [points, screen, flags, viewProjection, count] {
+        const uint32_t visible = WorldToScreenPoints(viewProjection, points->view(), static_cast<uint32_t>(count),
+                                                     kBenchScreenWidth, kBenchScreenHeight,
+                                                     screen->view(), flags->data());
+        bench::doNotOptimize(visible);
+    };
+}
+
+BENCHMARK_CASE("ScreenProjection.pointToRay/Scalar", {10000}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> px(0.0f, static_cast<float>(kBenchScreenWidth));
+    std::uniform_real_distribution<float> py(0.0f, static_cast<float>(kBenchScreenHeight));
+
+    auto points = std::make_shared<std::vector<Vector2>>(count);
+    for (auto& point : *points) {
+        point = Vector2(px(rng), py(rng));
+    }
+    auto rays = std::make_shared<std::vector<ScreenRay>>(count);
+    const Matrix4 invViewProjection = glm::inverse(makeBenchViewProjection());
+
+    return [points, rays, invViewProjection] {
+        for (size_t i = 0; i < points->size(); ++i) {
+            (*rays)[i] = ScreenPointToRay(invViewProjection, (*points)[i], kBenchScreenWidth, kBenchScreenHeight);
+        }
+        bench::doNotOptimize(rays->data());
+    };
+}
+
+BENCHMARK_CASE("ScreenProjection.pointToRay/Batch", {10000}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> px(0.0f, static_cast<float>(kBenchScreenWidth));
+    std::uniform_real_distribution<float> py(0.0f, static_cast<float>(kBenchScreenHeight));
+
+    auto points = std::make_shared<BenchPointsSoA>(count);
+    for (size_t i = 0; i < count; ++i) {
+        points->x[i] = px(rng);
+        points->y[i] = py(rng);
+    }
+    auto origins = std::make_shared<BenchPointsSoA>(count);
+    auto directions = std::make_shared<BenchPointsSoA>(count);
+    const Matrix4 invViewProjection = glm::inverse(makeBenchViewProjection());
+
+    return [points, origins, directions, invViewProjection, count] {
+        ScreenPointsToRays(invViewProjection, points->x.data(), points->y.data(), static_cast<uint32_t>(count),
+                           kBenchScreenWidth, kBenchScreenHeight, origins->view(), directions->view());
+        bench::doNotOptimize(directions->x.data());
+    };
+}
+
+// ============================================================================
+// 资源池
+// ============================================================================
+
+BENCHMARK_CASE("ResourcePool.allocateRelease", {64, 1024, 4096}) {
+    PoolConfig config;
+    config.initialCapacity = static_cast<uint32_t>(count);
+    config.maxCapacity = static_cast<uint32_t>(count);
+    auto pool = std::make_shared<ResourcePool<TextureResource>>(config);
+    auto indices = std::make_shared<std::vector<uint32_t>>(count);
+
+    return [pool, indices] {
+        for (auto& index : *indices) {
+            index = pool->Allocate().first;
+        }
+        for (uint32_t index : *indices) {
+            pool->Release(index);
+        }
+    };
+}
+
+BENCHMARK_CASE("ResourcePool.get", {64, 1024, 4096}) {
+    PoolConfig config;
+    config.initialCapacity = static_cast<uint32_t>(count);
+    config.maxCapacity = static_cast<uint32_t>(count);
+    auto pool = std::make_shared<ResourcePool<TextureResource>>(config);
+
+    // 随机顺序访问，模拟每帧按句柄解析资源
+    auto handles = std::make_shared<std::vector<std::pair<uint32_t, uint32_t>>>();
+    for (size_t i = 0; i < count; ++i) {
+        auto [index, slot] = pool->Allocate();
+        handles->emplace_back(index, slot->generation);
+    }
+    std::shuffle(handles->begin(), handles->end(), std::mt19937(kSeed));
+
+    return [pool, handles] {
+        uintptr_t sum = 0;
+        for (const auto& [index, generation] : *handles) {
+            sum += reinterpret_cast<uintptr_t>(pool->Get(index, generation));
+        }
+        bench::doNotOptimize(sum);
+    };
+}
+
+BENCHMARK_CASE("TempTexturePool.frame", {8, 32}) {
+    auto pool = std::make_shared<TempTexturePool>();
+    auto handles = std::make_shared<std::vector<TextureHandle>>(count);
+    const size_t perFrame = std::min<size_t>(count, TempTexturePool::PoolSize);
+
+    TextureDesc desc;
+    desc.width = 1024;
+    desc.height = 1024;
+
+    // 一帧: 分配 → 查询 → 释放一半 → 帧末重置
+    return [pool, handles, perFrame, desc] {
+        for (size_t i = 0; i < perFrame; ++i) {
+            (*handles)[i] = pool->Allocate(desc);
+        }
+        for (size_t i = 0; i < perFrame; ++i) {
+            bench::doNotOptimize(pool->Get((*handles)[i]));
+        }
+        for (size_t i = 0; i < perFrame; i += 2) {
+            pool->Release((*handles)[i]);
+        }
+        pool->Reset();
+    };
+}
+
+// ============================================================================
+// 光照
+// ============================================================================
+
+BENCHMARK_CASE("LightingData.getImportantLights", {16, 128, 1024}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    auto lighting = std::make_shared<LightingData>();
+    lighting->addLight(LightData::createDirectional(Vector3(-0.3f, -1.0f, -0.2f)));
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 p(pos(rng), pos(rng) * 0.1f, pos(rng));
+        if (i % 4 == 0) {
+            lighting->addLight(LightData::createSpot(p, Vector3(0.0f, -1.0f, 0.0f), 15.0f, 30.0f,
+                                                     5.0f + 20.0f * unit(rng)));
+        } else {
+            lighting->addLight(LightData::createPoint(p, 5.0f + 20.0f * unit(rng),
+                                                      Vector3(unit(rng), unit(rng), unit(rng))));
+        }
+    }
+
+    // 固定的 256 个查询点
+    auto queries = std::make_shared<std::vector<Vector3>>();
+    for (int i = 0; i < 256; ++i) {
+        queries->emplace_back(pos(rng), 0.0f, pos(rng));
+    }
+
+    return [lighting, queries] {
+        size_t total = 0;
+        for (const auto& q : *queries) {
+            total += lighting->getImportantLights(q, 4).size();
+        }
+        bench::doNotOptimize(total);
+    };
+}
+
+/** 随机的 PRT 光照（太阳 + 天空） */
+PrtLightingSH makeBenchPrtLighting() {
+    PrtLightingSH lighting;
+    lighting.addUniform(Vector3(0.3f, 0.4f, 0.6f));
+    lighting.addDirectional(glm::normalize(Vector3(0.3f, 1.0f, 0.2f)), Vector3(3.0f, 2.8f, 2.5f));
+    return lighting;
+}
+
+BENCHMARK_CASE("PrtLighting.project", {16, 128}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+
+    auto lighting = std::make_shared<LightingData>();
+    lighting->addLight(LightData::createDirectional(Vector3(-0.3f, -1.0f, -0.2f)));
+    for (size_t i = 0; i < count; ++i) {
+        lighting->addLight(LightData::createPoint(Vector3(pos(rng), pos(rng) * 0.1f, pos(rng)), 200.0f));
+    }
+    lighting->ambientColor = Vector3(0.3f, 0.4f, 0.6f);
+    lighting->ambientIntensity = 1.0f;
+
+    return [lighting] {
+        PrtLightingSH sh;
+        ProjectLightingToPrt(*lighting, PrtProjectionSettings(), sh);
+        bench::doNotOptimize(sh.coefficients[0][0]);
+    };
+}
+
+BENCHMARK_CASE("PrtLighting.relightProbes", {256, 4096}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> value(-0.5f, 0.5f);
+
+    auto transfer = std::make_shared<PrtProbeTransfer>();
+    transfer->resize(static_cast<uint32_t>(count));
+    float matrix[3][kPrtCoefficients][kPrtCoefficients];
+    for (uint32_t p = 0; p < count; ++p) {
+        for (float* m = &matrix[0][0][0]; m != &matrix[0][0][0] + 3 * kPrtCoefficients * kPrtCoefficients; ++m) {
+            *m = value(rng);
+        }
+        transfer->setProbe(p, matrix);
+    }
+    auto probes = std::make_shared<std::vector<LightingData::LightProbe>>(count);
+    const PrtLightingSH lighting = makeBenchPrtLighting();
+
+    return [transfer, probes, lighting] {
+        RelightPrtProbes(*transfer, lighting, probes->data());
+        bench::doNotOptimize(probes->data());
+    };
+}
+
+BENCHMARK_CASE("PrtLighting.relightVertices", {10000, 100000}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> value(-0.5f, 0.5f);
+
+    auto transfer = std::make_shared<PrtVertexTransfer>();
+    transfer->resize(static_cast<uint32_t>(count));
+    float vector[3][kPrtCoefficients];
+    for (uint32_t v = 0; v < count; ++v) {
+        for (float* t = &vector[0][0]; t != &vector[0][0] + 3 * kPrtCoefficients; ++t) {
+            *t = value(rng);
+        }
+        transfer->setVertex(v, vector);
+    }
+    auto out = std::make_shared<std::vector<Vector3>>(count);
+    const PrtLightingSH lighting = makeBenchPrtLighting();
+
+    return [transfer, out, lighting] {
+        RelightPrtVertices(*transfer, lighting, out->data());
+        bench::doNotOptimize(out->data());
+    };
+}
+
+// ============================================================================
+// 球谐
+// ============================================================================
+
+namespace {
+
+/** 随机单位方向（SoA） */
+std::shared_ptr<BenchPointsSoA> makeBenchDirections(size_t count) {
+    std::mt19937 rng(kSeed);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    auto directions = std::make_shared<BenchPointsSoA>(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 d = glm::normalize(Vector3(gauss(rng), gauss(rng), gauss(rng)));
+        directions->x[i] = d.x;
+        directions->y[i] = d.y;
+        directions->z[i] = d.z;
+    }
+    return directions;
+}
+
+SH9RGB makeBenchSH() {
+    SH9RGB sh;
+    AddSHUniform(sh, Vector3(0.3f, 0.4f, 0.6f));
+    AddSHCone(sh, glm::normalize(Vector3(0.3f, 1.0f, 0.2f)), 0.2f, Vector3(30.0f, 28.0f, 25.0f));
+    return sh;
+}
+
+} // namespace
+
+BENCHMARK_CASE("SphericalHarmonics.evaluate/Scalar", {10000}) {
+    auto directions = makeBenchDirections(count);
+    auto out = std::make_shared<std::vector<Vector3>>(count);
+    const SH9RGB sh = makeBenchSH();
+
+    return [directions, out, sh] {
+        for (size_t i = 0; i < out->size(); ++i) {
+            (*out)[i] = EvaluateSH(sh, Vector3(directions->x[i], directions->y[i], directions->z[i]));
+        }
+        bench::doNotOptimize(out->data());
+    };
+}
+
+BENCHMARK_CASE("SphericalHarmonics.evaluate/Batch", {10000}) {
+    auto directions = makeBenchDirections(count);
+    auto out = std::make_shared<std::vector<Vector3>>(count);
+    const SH9RGB sh = makeBenchSH();
+
+    return [directions, out, sh] {
+        EvaluateSHBatch(sh, directions->x.data(), directions->y.data(), directions->z.data(),
+                        static_cast<uint32_t>(out->size()), out->data());
+        bench::doNotOptimize(out->data());
+    };
+}
+
+// count 为立方体贴图边长（每面 count x count 纹素）
+BENCHMARK_CASE("SphericalHarmonics.projectCubemap", {32, 128}) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> value(0.0f, 2.0f);
+    auto texels = std::make_shared<std::vector<Vector3>>(6 * count * count);
+    for (Vector3& t : *texels) {
+        t = Vector3(value(rng), value(rng), value(rng));
+    }
+
+    return [texels, count] {
+        const Vector3* faces[6];
+        for (size_t f = 0; f < 6; ++f) {
+            faces[f] = texels->data() + f * count * count;
+        }
+        SH9RGB sh = ProjectCubemapToSH(faces, static_cast<uint32_t>(count));
+        bench::doNotOptimize(sh.c[0]);
+    };
+}
+
+// 每次迭代构造一个旋转并应用到 count 个探针
+BENCHMARK_CASE("SphericalHarmonics.rotate", {256, 4096}) {
+    auto probes = std::make_shared<std::vector<SH9RGB>>(count, makeBenchSH());
+    auto angle = std::make_shared<float>(0.0f);
+
+    return [probes, angle] {
+        *angle += 0.01f;
+        const SHRotation rotation(glm::rotate(Matrix4(1.0f), *angle, Vector3(0.0f, 1.0f, 0.0f)));
+        for (SH9RGB& sh : *probes) {
+            sh = rotation.apply(sh);
+        }
+        bench::doNotOptimize(probes->data());
+    };
+}
+
+// ============================================================================
+// 光源聚合
+// ============================================================================
+
+namespace {
+
+/** 城市夜景: count 个小点光源（窗户、路灯）散布在 2km 见方的区域 */
+std::shared_ptr<LightingData> makeBenchCityLighting(size_t count) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> ground(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> height(2.0f, 60.0f);
+    std::uniform_real_distribution<float> range(6.0f, 20.0f);
+    std::uniform_real_distribution<float> warm(0.6f, 1.0f);
+
+    auto lighting = std::make_shared<LightingData>();
+    lighting->addLight(LightData::createDirectional(Vector3(-0.3f, -1.0f, -0.2f), Vector3(0.2f, 0.25f, 0.4f)));
+    for (size_t i = 0; i < count; ++i) {
+        lighting->addLight(LightData::createPoint(Vector3(ground(rng), height(rng), ground(rng)), range(rng),
+                                                  Vector3(1.0f, warm(rng), 0.5f), 2.0f));
+    }
+    return lighting;
+}
+
+/** 街道高度的相机，远平面覆盖整个城市 */
+std::shared_ptr<CameraSnapshot> makeBenchCitySnapshot() {
+    CameraSnapshotParams params;
+    params.viewMatrix = glm::lookAt(Vector3(0.0f, 20.0f, 0.0f), Vector3(0.0f, 10.0f, -100.0f),
+                                    Vector3(0.0f, 1.0f, 0.0f));
+    params.projectionMatrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+    params.width = 1920;
+    params.height = 1080;
+    return std::make_shared<CameraSnapshot>(CameraSnapshot::build(params));
+}
+
+/** 可见区域内的着色点（法线朝上） */
+std::shared_ptr<std::vector<Vector3>> makeBenchShadingPoints(size_t count) {
+    std::mt19937 rng(kSeed + 1);
+    std::uniform_real_distribution<float> x(-400.0f, 400.0f);
+    std::uniform_real_distribution<float> z(-1000.0f, -20.0f);
+    auto points = std::make_shared<std::vector<Vector3>>(count);
+    for (Vector3& p : *points) {
+        p = Vector3(x(rng), 0.0f, z(rng));
+    }
+    return points;
+}
+
+} // namespace
+
+BENCHMARK_CASE("LightAggregator.aggregate", {1000, 10000}) {
+    auto lighting = makeBenchCityLighting(count);
+    auto snapshot = makeBenchCitySnapshot();
+    auto aggregator = std::make_shared<LightAggregator>();
+
+    return [lighting, snapshot, aggregator] {
+        aggregator->aggregate(*lighting, *snapshot);
+        bench::doNotOptimize(aggregator->getStats().clusters);
+    };
+}
+
+// count 为场景光源数，每次迭代着色 1024 个点（ns/item 为每个场景光源摊到的开销）
+BENCHMARK_CASE("LightAggregator.shade/AllLights", {1000, 10000}) {
+    auto lighting = makeBenchCityLighting(count);
+    auto points = makeBenchShadingPoints(1024);
+
+    return [lighting, points] {
+        Vector3 total(0.0f);
+        for (const Vector3& p : *points) {
+            total += lighting->calculateLightingAtPoint(p, Vector3(0.0f, 1.0f, 0.0f));
+        }
+        bench::doNotOptimize(total);
+    };
+}
+
+BENCHMARK_CASE("LightAggregator.shade/Aggregated", {1000, 10000}) {
+    auto lighting = makeBenchCityLighting(count);
+    auto aggregator = std::make_shared<LightAggregator>();
+    aggregator->aggregate(*lighting, *makeBenchCitySnapshot());
+    aggregator->applyTo(*lighting);
+    auto points = makeBenchShadingPoints(1024);
+
+    return [lighting, aggregator, points] {
+        Vector3 total(0.0f);
+        for (const Vector3& p : *points) {
+            const Vector3 normal(0.0f, 1.0f, 0.0f);
+            total += lighting->calculateLightingAtPoint(p, normal) + aggregator->evaluateRegionLighting(p, normal);
+        }
+        bench::doNotOptimize(total);
+    };
+}
+
+// ============================================================================
+// 区域光
+// ============================================================================
+
+namespace {
+
+/** 小尺寸拟合的 LTC 表（着色开销与表的内容无关） */
+std::shared_ptr<LtcTable> makeBenchLtcTable() {
+    LtcFitSettings settings;
+    settings.size = 8;
+    settings.sampleCount = 8;
+    auto table = std::make_shared<LtcTable>();
+    FitLtcTable(settings, *table);
+    return table;
+}
+
+/** 天花板上的面光源下方 count 个着色点（随机法线与视线） */
+struct AreaShadingPoints {
+    std::vector<Vector3> positions;
+    std::vector<Vector3> normals;
+    std::vector<Vector3> views;
+};
+
+std::shared_ptr<AreaShadingPoints> makeBenchAreaShadingPoints(size_t count) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> ground(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    auto points = std::make_shared<AreaShadingPoints>();
+    for (size_t i = 0; i < count; ++i) {
+        points->positions.emplace_back(ground(rng), 0.0f, ground(rng));
+        points->normals.push_back(glm::normalize(Vector3(unit(rng) * 0.5f, 1.0f, unit(rng) * 0.5f)));
+        points->views.push_back(glm::normalize(Vector3(unit(rng), 1.0f + unit(rng) * 0.5f, unit(rng))));
+    }
+    return points;
+}
+
+LightData makeBenchAreaLight(AreaLightShape shape) {
+    return shape == AreaLightShape::Rectangle
+        ? LightData::createRectArea(Vector3(0.0f, 3.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f),
+                                    2.0f, 1.0f, 20.0f, Vector3(1.0f, 0.9f, 0.8f), 10.0f)
+        : LightData::createDiskArea(Vector3(0.0f, 3.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f), 0.75f, 20.0f,
+                                    Vector3(1.0f, 0.9f, 0.8f), 10.0f);
+}
+
+bench::BenchmarkBody makeAreaShadeBench(AreaLightShape shape, size_t count) {
+    auto table = makeBenchLtcTable();
+    auto points = makeBenchAreaShadingPoints(count);
+    const LightData light = makeBenchAreaLight(shape);
+
+    return [table, points, light] {
+        Vector3 total(0.0f);
+        for (size_t i = 0; i < points->positions.size(); ++i) {
+            const AreaLightShading shading = EvaluateAreaLightLtc(light, *table, points->positions[i],
+                                                                  points->normals[i], points->views[i], 0.5f,
+                                                                  Vector3(0.04f));
+            total += shading.diffuse + shading.specular;
+        }
+        bench::doNotOptimize(total);
+    };
+}
+
+} // namespace
+
+BENCHMARK_CASE("AreaLighting.shade/Rect", {10000}) {
+    return makeAreaShadeBench(AreaLightShape::Rectangle, count);
+}
+
+BENCHMARK_CASE("AreaLighting.shade/Disk", {10000}) {
+    return makeAreaShadeBench(AreaLightShape::Disk, count);
+}
+
+// 光照贴图 / 探针约定的漫反射形状因子（不查表）
+BENCHMARK_CASE("AreaLighting.formFactor/Rect", {10000}) {
+    auto points = makeBenchAreaShadingPoints(count);
+    const LightData light = makeBenchAreaLight(AreaLightShape::Rectangle);
+
+    return [points, light] {
+        float total = 0.0f;
+        for (size_t i = 0; i < points->positions.size(); ++i) {
+            total += EvaluateAreaLightFormFactor(light, points->positions[i], points->normals[i]);
+        }
+        bench::doNotOptimize(total);
+    };
+}
+
+// ============================================================================
+// 阴影 Atlas
+// ============================================================================
+
+BENCHMARK_CASE("ShadowAtlas.allocate", {16, 64, 256}) {
+    auto atlas = std::make_shared<ShadowAtlas>();
+    atlas->width = 8192;
+    atlas->height = 8192;
+
+    std::mt19937 rng(kSeed);
+    const uint32_t sizes[] = {128, 256, 512, 1024};
+    auto requests = std::make_shared<std::vector<uint32_t>>();
+    for (size_t i = 0; i < count; ++i) {
+        requests->push_back(sizes[rng() % 4]);
+    }
+
+    return [atlas, requests] {
+        atlas->reset();
+        for (uint32_t size : *requests) {
+            bench::doNotOptimize(atlas->allocate(size, size));
+        }
+    };
+}
+
+// ============================================================================
+// 渲染队列构建: 组件存储 vs GameObject 遍历
+// ============================================================================
+
+BENCHMARK_CASE("RenderQueueBuilder.build/Storage", {10000, 100000}) {
+    auto storage = std::make_shared<RenderableStorage>();
+    storage->reserve(count);
+    std::mt19937 rng(kSeed);
+    for (size_t i = 0; i < count; ++i) {
+        storage->create(makeDesc(rng));
+    }
+
+    auto manager = std::make_shared<RenderQueueManager>();
+    const Frustum frustum = makeBenchFrustum();
+
+    return [storage, manager, frustum] {
+        manager->clear();
+        RenderQueueBuilder::build(*storage, Vector3(0.0f), *manager, &frustum);
+        bench::doNotOptimize(manager->getStats().totalObjects);
+    };
+}
+
+BENCHMARK_CASE("RenderQueueBuilder.build/GameObjectWalk", {10000, 100000}) {
+    auto objects = std::make_shared<std::vector<std::shared_ptr<SimGameObject>>>();
+    objects->reserve(count);
+    std::mt19937 rng(kSeed);
+    for (size_t i = 0; i < count; ++i) {
+        auto go = std::make_shared<SimGameObject>();
+        go->components.push_back(std::make_unique<SimTransform>());
+        auto renderer = std::make_unique<SimMeshRenderer>();
+        renderer->desc = makeDesc(rng);
+        go->components.push_back(std::move(renderer));
+        objects->push_back(std::move(go));
+    }
+    std::shuffle(objects->begin(), objects->end(), rng);
+
+    auto manager = std::make_shared<RenderQueueManager>();
+    const Frustum frustum = makeBenchFrustum();
+
+    return [objects, manager, frustum] {
+        manager->clear();
+        for (const auto& go : *objects) {
+            auto* renderer = go->getComponent<SimMeshRenderer>();
+            auto* transform = go->getComponent<SimTransform>();
+            if (!renderer || !transform) continue;
+
+            const auto& desc = renderer->desc;
+            if (!frustum.intersectsSphere(desc.center, desc.radius)) continue;
+
+            RenderObject obj;
+            obj.worldMatrix = transform->world;
+            obj.center = desc.center;
+            obj.radius = desc.radius;
+            obj.materialID = desc.materialID;
+            obj.queueID = desc.queueID;
+            obj.distanceToCamera = glm::length(desc.center);
+            manager->addObject(obj);
+        }
+        bench::doNotOptimize(manager->getStats().totalObjects);
+    };
+}
+
+// ============================================================================
+// Profiler
+// ============================================================================
+
+// 直接使用 ProfileScope，不受 PRISMA_ENABLE_PROFILER 影响
+// ns/item 即单个区段的开销（含帧结束时的汇总）
+BENCHMARK_CASE("Profiler.zone", {1000, 10000}) {
+    FrameProfiler::get().endFrame();
+
+    return [count] {
+        for (size_t i = 0; i < count; ++i) {
+            ProfileScope scope("Bench.zone");
+        }
+        FrameProfiler::get().endFrame();
+    };
+}
+
+// 每帧 count 个区段，包含查询重置、写入、延迟读取和合并到CPU时间线
+BENCHMARK_CASE("GpuProfiler.frame", {8, 64}) {
+    auto backend = std::make_shared<MockGpuTimestampBackend>(2);
+    auto profiler = std::make_shared<GpuProfiler>();
+    profiler->initialize(backend.get(), GpuProfiler::DefaultFramesInFlight, static_cast<uint32_t>(count));
+
+    return [backend, profiler, count] {
+        profiler->beginFrame(nullptr);
+        for (size_t i = 0; i < count; ++i) {
+            GpuProfileScope scope(profiler.get(), nullptr, "Bench.gpuZone");
+        }
+        profiler->endFrame(nullptr);
+        FrameProfiler::get().endFrame();
+    };
+}
+
+int main(int argc, char** argv) {
+    return bench::runMain(argc, argv);
+}
@@ -0,0 +1,346 @@
+/**
+ * @file BenchmarkHarness.h
+ * @brief 微基准测试框架 - 参数化对象数量、多次采样、JSON输出
+ *
+ * 用法:
+ * @code
+ *
+ * BENCHMARK_CASE("RenderQueue.sort/FrontToBack", {1000, 10000, 100000}) {
+ *     auto queue = makeQueue(count);      // 准备阶段（不计时）
+ *     return [=] { queue->sort(); };      // 返回被计时的函数体
+ * }
+ *
+ * int main(int argc, char** argv) {
+ *     return bench::runMain(argc, argv);
+ * }
+ *
+ * @endcode
+ *
+ * 命令行参数:
+ * - --filter <子串>     只运行名称包含该子串的用例
+ * - --counts <a,b,c>   覆盖所有用例的对象数量
+ * - --samples <N>      每个用例的采样次数（默认 15）
+ * - --min-time-ms <N>  每次采样的最短时间（默认 5ms）
+ * - --json <路径>       输出JSON结果（包含所有原始采样，便于长期追踪）
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// ============================================================================
+// 用例定义
+// ============================================================================
+
+/** 被计时的函数体（执行一次迭代） */
+using BenchmarkBody = std::function<void()>;
+
+/** 准备函数：根据对象数量构建数据，返回被计时的函数体 */
+using BenchmarkSetup = std::function<BenchmarkBody(size_t count)>;
+
+/**
+ * @brief 基准测试用例
+ */
+struct BenchmarkDef {
+    std::string name;
+    std::vector<size_t> counts;
+    BenchmarkSetup setup;
+};
+
+/**
+ * @brief 单个 (用例, 数量) 的结果
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t count = 0;
+    uint64_t iterationsPerSample = 0;
+
+    /** 每次采样的单次迭代耗时（纳秒） */
+    std::vector<double> samples;
+
+    double min = 0.0;
+    double median = 0.0;
+    double mean = 0.0;
+    double p99 = 0.0;
+};
+
+/**
+ * @brief 运行配置
+ */
+struct RunConfig {
+    std::string filter;
+    std::vector<size_t> countsOverride;
+    uint32_t samples = 15;
+    double minSampleTimeMs = 5.0;
+    std::string jsonPath;
+};
+
+/**
+ * @brief 全局用例注册表
+ */
+inline std::vector<BenchmarkDef>& registry() {
+    static std::vector<BenchmarkDef> defs;
+    return defs;
+}
+
+/**
+ * @brief 注册用例（静态初始化期间调用）
+ */
+struct Registrar {
+    Registrar(const char* name, std::vector<size_t> counts, BenchmarkSetup setup) {
+        registry().push_back({name, std::move(counts), std::move(setup)});
+    }
+};
+
+/**
+ * @brief 阻止编译器优化掉计算结果
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+// ============================================================================
+// 计时
+// ============================================================================
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+/**
+ * @brief 估算每次采样需要的迭代次数，使采样时间不低于 minTimeMs
+ */
+inline uint64_t calibrateIterations(const BenchmarkBody& body, double minTimeMs) {
+    uint64_t iterations = 1;
+    const double targetNs = minTimeMs * 1.0e6;
+
+    for (;;) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            body();
+        }
+        const double ns = elapsedNs(start, Clock::now());
+
+        if (ns >= targetNs || iterations >= (1ull << 30)) {
+            return iterations;
+        }
+
+        // 按比例放大，至少翻倍
+        const double scale = ns > 0.0 ? targetNs / ns : 2.0;
+        iterations = std::max(iterations * 2,
+                              static_cast<uint64_t>(static_cast<double>(iterations) * scale * 1.1));
+    }
+}
+
+inline double percentile(std::vector<double> sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    std::sort(sorted.begin(), sorted.end());
+    const double rank = p * static_cast<double>(sorted.size() - 1);
+    const size_t lo = static_cast<size_t>(rank);
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    const double t = rank - static_cast<double>(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * t;
+}
+
+/**
+ * @brief 根据 samples 计算 min / median / mean / p99
+ */
+inline void summarize(BenchmarkResult& result) {
+    if (result.samples.empty()) return;
+    double sum = 0.0;
+    for (double v : result.samples) sum += v;
+    result.mean = sum / static_cast<double>(result.samples.size());
+    result.min = *std::min_element(result.samples.begin(), result.samples.end());
+    result.median = percentile(result.samples, 0.5);
+    result.p99 = percentile(result.samples, 0.99);
+}
+
+inline BenchmarkResult runOne(const BenchmarkDef& def, size_t count, const RunConfig& config) {
+    BenchmarkResult result;
+    result.name = def.name;
+    result.count = count;
+
+    BenchmarkBody body = def.setup(count);
+
+    // 预热 + 校准
+    result.iterationsPerSample = calibrateIterations(body, config.minSampleTimeMs);
+
+    result.samples.reserve(config.samples);
+    for (uint32_t s = 0; s < config.samples; ++s) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < result.iterationsPerSample; ++i) {
+            body();
+        }
+        const double ns = elapsedNs(start, Clock::now());
+        result.samples.push_back(ns / static_cast<double>(result.iterationsPerSample));
+    }
+
+    summarize(result);
+    return result;
+}
+
+// ============================================================================
+// 输出
+// ============================================================================
+
+inline void printResult(const BenchmarkResult& r) {
+    const double perItem = r.count > 0 ? r.median / static_cast<double>(r.count) : 0.0;
+    std::printf("%-48s %10zu %14.1f %14.1f %14.1f %10.2f\n",
+                r.name.c_str(), r.count, r.median, r.min, r.p99, perItem);
+}
+
+inline std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+inline bool writeJson(const std::string& path, const std::vector<BenchmarkResult>& results,
+                      const RunConfig& config) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        std::fprintf(stderr, "无法写入 %s\n", path.c_str());
+        return false;
+    }
+
+    std::fprintf(f, "{\n  \"schema\": 1,\n  \"timestamp\": %lld,\n",
+                 static_cast<long long>(std::time(nullptr)));
+    std::fprintf(f, "  \"samplesPerCase\": %u,\n  \"unit\": \"ns/iter\",\n", config.samples);
+    std::fprintf(f, "  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::fprintf(f, "    {\"name\": \"%s\", \"count\": %zu, \"iterations\": %llu, "
+                        "\"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"p99\": %.3f, \"samples\": [",
+                     jsonEscape(r.name).c_str(), r.count,
+                     static_cast<unsigned long long>(r.iterationsPerSample),
+                     r.min, r.median, r.mean, r.p99);
+        for (size_t s = 0; s < r.samples.size(); ++s) {
+            std::fprintf(f, "%s%.3f", s ? ", " : "", r.samples[s]);
+        }
+        std::fprintf(f, "]}%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+    return true;
+}
+
+// ============================================================================
+// 入口
+// ============================================================================
+
+inline std::vector<size_t> parseCounts(const char* text) {
+    std::vector<size_t> counts;
+    const char* p = text;
+    while (*p) {
+        char* end = nullptr;
+        const unsigned long long v = std::strtoull(p, &end, 10);
+        if (end == p) break;
+        counts.push_back(static_cast<size_t>(v));
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return counts;
+}
+
+/**
+ * @brief 解析命令行
+ * @return 有未知参数时返回 false（runMain 打印用法并以非零退出码结束）
+ */
+inline bool parseArgs(int argc, char** argv, RunConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--filter") && hasValue) {
+            config.filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--counts") && hasValue) {
+            config.countsOverride = parseCounts(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--samples") && hasValue) {
+            config.samples = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--min-time-ms") && hasValue) {
+            config.minSampleTimeMs = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--json") && hasValue) {
+            config.jsonPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 运行已注册的用例
+ * @return 进程退出码
+ */
+inline int runMain(int argc, char** argv) {
+    RunConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        std::fprintf(stderr, "用法: %s [--filter 子串] [--counts a,b,c] [--samples N] [--min-time-ms N] [--json 路径]\n",
+                     argv[0]);
+        return 2;
+    }
+    std::vector<BenchmarkResult> results;
+
+    std::printf("%-48s %10s %14s %14s %14s %10s\n",
+                "benchmark", "count", "median(ns)", "min(ns)", "p99(ns)", "ns/item");
+
+    for (const auto& def : registry()) {
+        if (!config.filter.empty() && def.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+        const auto& counts = config.countsOverride.empty() ? def.counts : config.countsOverride;
+        for (size_t count : counts) {
+            results.push_back(runOne(def, count, config));
+            printResult(results.back());
+        }
+    }
+
+    if (!config.jsonPath.empty() && !writeJson(config.jsonPath, results, config)) {
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace bench
+
+// ============================================================================
+// 注册宏
+// ============================================================================
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * @brief 定义基准测试用例
+ *
+ * 函数体内可使用 count 参数，返回被计时的 bench::BenchmarkBody
+ */
+#define BENCHMARK_CASE(name, ...) \
+    static bench::BenchmarkBody BENCH_CONCAT(benchSetup_, __LINE__)(size_t count); \
+    static bench::Registrar BENCH_CONCAT(benchRegistrar_, __LINE__)( \
+        name, std::vector<size_t>__VA_ARGS__, BENCH_CONCAT(benchSetup_, __LINE__)); \
+    static bench::BenchmarkBody BENCH_CONCAT(benchSetup_, __LINE__)(size_t count)
@@ -0,0 +1,373 @@
+/**
+ * @file FrameBenchmarks.cpp
+ * @brief 完整帧的基准测试 - 合成场景 + 脚本相机 + 空后端
+ *
+ * 每次迭代沿相机路径前进一帧，执行完整的 CPU 帧流程
+ * 默认规模 1k / 10k / 100k，1M 可通过 --counts 指定
+ * 分屏用例比较两个相机逐个渲染与共享剔除的开销
+ * 次级相机用例比较小地图/监控/镜子逐帧渲染与按策略降频调度的开销
+ * shadowmask 用例比较 Mixed 太阳光的全部静态投射者实时阴影与烘焙 shadowmask（只渲染动态投射者）
+ * 阴影光源选择用例比较按下标与按重要性排名选择（含每帧打分和投射者计数的开销）
+ */
+
+#include "BenchmarkHarness.h"
+#include "NullFrameRunner.h"
+#include "SceneGenerator.h"
+
+#include <memory>
+
+namespace {
+
+constexpr uint32_t kSeed = 0x5EED1234u;
+
+/** 相机路径循环一次的帧数 */
+constexpr uint32_t kFramesPerLoop = 600;
+
+bench::BenchmarkBody makeFrameBenchmark(size_t count,
+                                        SceneDistribution distribution,
+                                        CameraPathType pathType) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = distribution;
+
+    const GeneratedScene scene = SceneGenerator::generate(config);
+    auto runner = std::make_shared<NullFrameRunner>(scene);
+    auto path = std::make_shared<CameraPath>(SceneGenerator::generateCameraPath(config, pathType));
+    auto frame = std::make_shared<uint32_t>(0);
+
+    return [runner, path, frame] {
+        const float t = static_cast<float>(*frame % kFramesPerLoop) / static_cast<float>(kFramesPerLoop);
+        ++*frame;
+        const NullFrameStats& stats = runner->renderFrame(path->sample(t));
+        bench::doNotOptimize(stats.drawCalls);
+    };
+}
+
+/**
+ * @brief 分屏: 主相机沿路径移动，第二个相机在其右后方并看向同一目标
+ */
+bench::BenchmarkBody makeSplitScreenBenchmark(size_t count, bool shared) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::Uniform;
+
+    const GeneratedScene scene = SceneGenerator::generate(config);
+    auto runner = std::make_shared<NullFrameRunner>(scene, 960, 1080);
+    auto path = std::make_shared<CameraPath>(SceneGenerator::generateCameraPath(config, CameraPathType::Orbit));
+    auto frame = std::make_shared<uint32_t>(0);
+
+    return [runner, path, frame, shared] {
+        const float t = static_cast<float>(*frame % kFramesPerLoop) / static_cast<float>(kFramesPerLoop);
+        ++*frame;
+
+        CameraKeyframe cameras[2];
+        cameras[0] = path->sample(t);
+        cameras[1] = cameras[0];
+        cameras[1].position += Vector3(20.0f, 5.0f, 20.0f);
+
+        NullCameraView views[2];
+        for (uint32_t i = 0; i < 2; ++i) {
+            views[i].viewMatrix = glm::lookAt(cameras[i].position, cameras[i].target, Vector3(0.0f, 1.0f, 0.0f));
+            views[i].projectionMatrix = glm::perspective(glm::radians(cameras[i].fieldOfView),
+                                                         960.0f / 1080.0f, 0.1f, 1000.0f);
+            views[i].depth = static_cast<int>(i);
+        }
+
+        if (shared) {
+            bench::doNotOptimize(runner->renderFrame(views, 2, 1.0f / 60.0f).drawCalls);
+        } else {
+            for (uint32_t i = 0; i < 2; ++i) {
+                bench::doNotOptimize(runner->renderFrame(views[i].viewMatrix, views[i].projectionMatrix,
+                                                         cameras[i].position, 1.0f / 60.0f).drawCalls);
+            }
+        }
+    };
+}
+
+/**
+ * @brief 主相机 + 三个次级相机（小地图、监控、镜子）
+ *
+ * scheduled 为 false 时次级相机每帧渲染；否则小地图每4帧、监控只在变化时、
+ * 镜子分4个条带分摊，每帧最多更新一个
+ */
+bench::BenchmarkBody makeSecondaryCameraBenchmark(size_t count, bool scheduled) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::CityGrid;
+
+    const GeneratedScene scene = SceneGenerator::generate(config);
+    auto runner = std::make_shared<NullFrameRunner>(scene);
+    auto path = std::make_shared<CameraPath>(SceneGenerator::generateCameraPath(config, CameraPathType::StreetLevel));
+    auto frame = std::make_shared<uint32_t>(0);
+
+    auto scheduler = std::make_shared<SecondaryCameraScheduler>();
+    const CameraUpdatePolicy everyFrame = CameraUpdatePolicy::EveryFrame;
+
+    SecondaryCameraDesc minimap;
+    minimap.name = "Minimap";
+    minimap.policy = scheduled ? CameraUpdatePolicy::Interval : everyFrame;
+    minimap.interval = 4;
+
+    SecondaryCameraDesc monitor;
+    monitor.name = "Monitor";
+    monitor.policy = scheduled ? CameraUpdatePolicy::OnChange : everyFrame;
+    monitor.maxStaleFrames = 30;
+
+    SecondaryCameraDesc mirror;
+    mirror.name = "Mirror";
+    mirror.policy = scheduled ? CameraUpdatePolicy::Amortized : everyFrame;
+    mirror.interval = 4;
+
+    auto handles = std::make_shared<std::vector<SecondaryCameraHandle>>();
+    handles->push_back(scheduler->addCamera(minimap));
+    handles->push_back(scheduler->addCamera(monitor));
+    handles->push_back(scheduler->addCamera(mirror));
+    runner->setSecondaryCameraScheduler(scheduler.get());
+
+    return [runner, path, frame, scheduler, handles] {
+        const float t = static_cast<float>(*frame % kFramesPerLoop) / static_cast<float>(kFramesPerLoop);
+        ++*frame;
+
+        const CameraKeyframe main = path->sample(t);
+        const Vector3 up(0.0f, 1.0f, 0.0f);
+        const Matrix4 mainProjection = glm::perspective(glm::radians(main.fieldOfView), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+        // 次级相机: 跟随主角的俯视小地图、固定的监控、主相机身后的镜子
+        Matrix4 secondaryView[3];
+        Matrix4 secondaryProjection[3];
+        secondaryView[0] = glm::lookAt(main.position + Vector3(0.0f, 150.0f, 0.01f), main.position, up);
+        secondaryProjection[0] = glm::perspective(glm::radians(40.0f), 1.0f, 1.0f, 400.0f);
+        secondaryView[1] = glm::lookAt(Vector3(50.0f, 30.0f, 50.0f), Vector3(0.0f), up);
+        secondaryProjection[1] = glm::perspective(glm::radians(70.0f), 4.0f / 3.0f, 0.5f, 300.0f);
+        secondaryView[2] = glm::lookAt(main.position, main.position - (main.target - main.position), up);
+        secondaryProjection[2] = glm::perspective(glm::radians(50.0f), 2.0f, 0.1f, 200.0f);
+
+        for (uint32_t i = 0; i < 3; ++i) {
+            scheduler->setView((*handles)[i], secondaryProjection[i] * secondaryView[i]);
+        }
+        const auto& updates = scheduler->schedule(*frame);
+
+        // 次级相机先渲染（depth -1），主相机最后
+        NullCameraView views[4];
+        uint32_t viewCount = 0;
+        for (const SecondaryCameraUpdate& update : updates) {
+            const uint32_t i = update.camera.GetIndex();
+            views[viewCount].viewMatrix = secondaryView[i];
+            views[viewCount].projectionMatrix = CropProjection(secondaryProjection[i], update.viewportRect);
+            views[viewCount].depth = -1;
+            ++viewCount;
+        }
+        views[viewCount].viewMatrix = glm::lookAt(main.position, main.target, up);
+        views[viewCount].projectionMatrix = mainProjection;
+        ++viewCount;
+
+        const NullFrameStats& stats = runner->renderFrame(views, viewCount, 1.0f / 60.0f);
+        for (uint32_t v = 0; v < updates.size(); ++v) {
+            scheduler->reportCost(updates[v].camera, runner->getViewCpuMs(v));
+        }
+        bench::doNotOptimize(stats.drawCalls);
+    };
+}
+
+/**
+ * @brief 立体: 两只眼（瞳距 64mm）沿同一路径移动
+ *
+ * singlePass 为 false 时逐眼完整渲染两次；否则合并剔除、排序一次，模拟单遍录制
+ * （没有真实的 multiview 通道，只衡量 CPU 端的节省）
+ */
+bench::BenchmarkBody makeStereoBenchmark(size_t count, bool singlePass) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::Uniform;
+
+    const GeneratedScene scene = SceneGenerator::generate(config);
+    auto runner = std::make_shared<NullFrameRunner>(scene, 1440, 1600);
+    auto path = std::make_shared<CameraPath>(SceneGenerator::generateCameraPath(config, CameraPathType::Orbit));
+    auto frame = std::make_shared<uint32_t>(0);
+
+    return [runner, path, frame, singlePass] {
+        const float t = static_cast<float>(*frame % kFramesPerLoop) / static_cast<float>(kFramesPerLoop);
+        ++*frame;
+
+        const CameraKeyframe camera = path->sample(t);
+        const Matrix4 centerView = glm::lookAt(camera.position, camera.target, Vector3(0.0f, 1.0f, 0.0f));
+
+        NullCameraView eyes[2];
+        for (uint32_t i = 0; i < 2; ++i) {
+            eyes[i].viewMatrix = MakeEyeViewMatrix(centerView, 0.064f, i);
+            eyes[i].projectionMatrix = glm::perspective(glm::radians(camera.fieldOfView),
+                                                        1440.0f / 1600.0f, 0.1f, 1000.0f);
+        }
+
+        if (singlePass) {
+            bench::doNotOptimize(runner->renderStereoFrame(eyes[0], eyes[1], 1.0f / 60.0f).drawCalls);
+        } else {
+            for (uint32_t i = 0; i < 2; ++i) {
+                const Vector3 eyePosition = Vector3(glm::inverse(eyes[i].viewMatrix)[3]);
+                bench::doNotOptimize(runner->renderFrame(eyes[i].viewMatrix, eyes[i].projectionMatrix,
+                                                         eyePosition, 1.0f / 60.0f).drawCalls);
+            }
+        }
+    };
+}
+
+/**
+ * @brief 静止画面（暂停、菜单）: 相机和场景都不变
+ *
+ * detect 为 false 时每帧完整渲染；否则空闲检测在收敛后跳过整帧
+ */
+bench::BenchmarkBody makeIdleBenchmark(size_t count, bool detect) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::CityGrid;
+
+    const GeneratedScene scene = SceneGenerator::generate(config);
+    auto runner = std::make_shared<NullFrameRunner>(scene);
+    auto detector = std::make_shared<IdleFrameDetector>();
+    if (detect) {
+        runner->setIdleFrameDetector(detector.get());
+    }
+
+    const CameraPath path = SceneGenerator::generateCameraPath(config, CameraPathType::StreetLevel);
+    const CameraKeyframe camera = path.sample(0.0f);
+
+    return [runner, detector, camera] {
+        bench::doNotOptimize(runner->renderFrame(camera, 1.0f / 60.0f).drawCalls);
+    };
+}
+
+/**
+ * @brief Mixed 太阳光: 实时阴影渲染全部投射者，或静态投射者的阴影来自烘焙 shadowmask
+ */
+bench::BenchmarkBody makeShadowmaskBenchmark(size_t count, bool shadowmask) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::CityGrid;
+
+    GeneratedScene scene = SceneGenerator::generate(config);
+    for (LightData& light : scene.lighting.directionalLights) {
+        light.lightMode = LightMode::Mixed;
+        light.shadowmaskChannel = 0;
+    }
+    auto runner = std::make_shared<NullFrameRunner>(scene);
+    ShadowSettings shadow = ShadowSettings::defaultSettings();
+    shadow.enableShadowmask = shadowmask;
+    runner->setShadowSettings(shadow);
+
+    auto path = std::make_shared<CameraPath>(SceneGenerator::generateCameraPath(config, CameraPathType::StreetLevel));
+    auto frame = std::make_shared<uint32_t>(0);
+
+    return [runner, path, frame] {
+        const float t = static_cast<float>(*frame % kFramesPerLoop) / static_cast<float>(kFramesPerLoop);
+        ++*frame;
+        bench::doNotOptimize(runner->renderFrame(path->sample(t)).shadowCasters);
+    };
+}
+
+/**
+ * @brief 大量投射阴影的局部光源: 阴影光源按下标或按重要性排名选择
+ */
+bench::BenchmarkBody makeShadowSelectionBenchmark(size_t count, bool ranked) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::CityGrid;
+    config.lightCount = 128;
+    config.shadowCasterFraction = 0.5f;
+
+    const GeneratedScene scene = SceneGenerator::generate(config);
+    auto runner = std::make_shared<NullFrameRunner>(scene);
+    auto selector = std::make_shared<ShadowLightSelector>();
+    if (ranked) {
+        runner->setShadowLightSelector(selector.get());
+    }
+
+    auto path = std::make_shared<CameraPath>(SceneGenerator::generateCameraPath(config, CameraPathType::StreetLevel));
+    auto frame = std::make_shared<uint32_t>(0);
+
+    return [runner, selector, path, frame] {
+        const float t = static_cast<float>(*frame % kFramesPerLoop) / static_cast<float>(kFramesPerLoop);
+        ++*frame;
+        bench::doNotOptimize(runner->renderFrame(path->sample(t)).shadowCasters);
+    };
+}
+
+} // namespace
+
+BENCHMARK_CASE("Frame/Uniform/Orbit", {1000, 10000, 100000}) {
+    return makeFrameBenchmark(count, SceneDistribution::Uniform, CameraPathType::Orbit);
+}
+
+BENCHMARK_CASE("Frame/Clustered/Flythrough", {1000, 10000, 100000}) {
+    return makeFrameBenchmark(count, SceneDistribution::Clustered, CameraPathType::Flythrough);
+}
+
+BENCHMARK_CASE("Frame/CityGrid/StreetLevel", {1000, 10000, 100000}) {
+    return makeFrameBenchmark(count, SceneDistribution::CityGrid, CameraPathType::StreetLevel);
+}
+
+BENCHMARK_CASE("Frame/SplitScreen/Separate", {10000, 100000}) {
+    return makeSplitScreenBenchmark(count, false);
+}
+
+BENCHMARK_CASE("Frame/SplitScreen/Shared", {10000, 100000}) {
+    return makeSplitScreenBenchmark(count, true);
+}
+
+BENCHMARK_CASE("Frame/Stereo/TwoPass", {10000, 100000}) {
+    return makeStereoBenchmark(count, false);
+}
+
+BENCHMARK_CASE("Frame/Stereo/SinglePassSimulated", {10000, 100000}) {
+    return makeStereoBenchmark(count, true);
+}
+
+BENCHMARK_CASE("Frame/Idle/Static", {10000, 100000}) {
+    return makeIdleBenchmark(count, false);
+}
+
+BENCHMARK_CASE("Frame/Idle/Detected", {10000, 100000}) {
+    return makeIdleBenchmark(count, true);
+}
+
+BENCHMARK_CASE("Frame/Shadowmask/Realtime", {10000, 100000}) {
+    return makeShadowmaskBenchmark(count, false);
+}
+
+BENCHMARK_CASE("Frame/Shadowmask/Baked", {10000, 100000}) {
+    return makeShadowmaskBenchmark(count, true);
+}
+
+BENCHMARK_CASE("Frame/ShadowSelection/ByIndex", {10000, 100000}) {
+    return makeShadowSelectionBenchmark(count, false);
+}
+
+BENCHMARK_CASE("Frame/ShadowSelection/Ranked", {10000, 100000}) {
+    return makeShadowSelectionBenchmark(count, true);
+}
+
+BENCHMARK_CASE("Frame/SecondaryCameras/EveryFrame", {10000, 100000}) {
+    return makeSecondaryCameraBenchmark(count, false);
+}
+
+BENCHMARK_CASE("Frame/SecondaryCameras/Scheduled", {10000, 100000}) {
+    return makeSecondaryCameraBenchmark(count, true);
+}
+
+BENCHMARK_CASE("SceneGenerator.generate", {1000, 10000, 100000}) {
+    SceneGenConfig config;
+    config.seed = kSeed;
+    config.objectCount = static_cast<uint32_t>(count);
+    config.distribution = SceneDistribution::CityGrid;
+
+    return [config] {
+        const GeneratedScene scene = SceneGenerator::generate(config);
+        bench::doNotOptimize(scene.renderables.size());
+    };
+}
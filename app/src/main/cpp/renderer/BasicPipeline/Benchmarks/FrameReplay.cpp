@@ -0,0 +1,347 @@
+/**
+ * @file FrameReplay.cpp
+ * @brief 帧捕获回放工具 - 在空后端上重复执行捕获的CPU帧流程
+ *
+ * 回放:
+ *   BasicPipelineReplay <capture.pfc> [--loops N] [--trace trace.json] [--stats stats.csv]
+ *                       [--json result.json] [--memory] [--alloc-budget N]
+ *                       [--overdraw prefix] [--overdraw-frame N] [--overdraw-scale S] [--overdraw-proxy box|sphere]
+ *
+ * 录制合成场景（用于生成示例捕获或对比回放结果）:
+ *   BasicPipelineReplay --record <capture.pfc> [--objects N] [--frames N] [--seed S]
+ *                       [--keyframe-interval N] [--moving-fraction F]
+ *
+ * 每轮回放从第一帧开始，打印每帧耗时的中位数、最小值和 p99
+ * --trace 对最后一轮回放捕获 Chrome Trace；--stats 导出最后一轮的每帧渲染统计
+ * --json 以基准测试相同的格式（schema 1）输出结果，每轮回放一个采样:
+ * - Replay/<捕获名>/Frame       每帧平均耗时
+ * - Replay/<捕获名>/<区段名>     各分析区段的平均耗时（需启用 PRISMA_ENABLE_PROFILER）
+ * 可直接交给 BasicPipelinePerfCompare 与基线比较
+ * --memory 结束时打印按子系统标记的内存统计；--alloc-budget 为每个标记设置每帧分配次数预算，
+ * 回放中出现每帧分配抖动时发出警告（需启用 PRISMA_ENABLE_MEMORY_TRACKING，关闭时拒绝这两个参数）
+ * --overdraw 在第一轮的第 N 帧（默认0）用 OverdrawAnalyzer 按实际提交顺序软件光栅化可见队列，
+ * 分辨率为捕获分辨率乘以 --overdraw-scale（默认0.25），输出 <prefix>.ppm 热度图、<prefix>.csv 每对象统计，
+ * 并打印浪费片段最多的对象
+ */
+
+#include "BenchmarkHarness.h"
+#include "NullFrameRunner.h"
+#include "SceneGenerator.h"
+#include "../FrameCapture.h"
+#include "../Profiler.h"
+#include "../MemoryTracker.h"
+#include "../OverdrawAnalyzer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ReplayConfig {
+    std::string capturePath;
+    bool record = false;
+
+    // 回放
+    uint32_t loops = 5;
+    std::string tracePath;
+    std::string statsPath;
+    std::string jsonPath;
+    bool memoryReport = false;
+    uint32_t frameAllocationBudget = 0;
+    std::string overdrawPrefix;
+    uint32_t overdrawFrame = 0;
+    float overdrawScale = 0.25f;
+    OverdrawProxy overdrawProxy = OverdrawProxy::Sphere;
+
+    // 录制
+    size_t objects = 10000;
+    uint32_t frames = 300;
+    uint64_t seed = 1;
+    uint32_t keyframeInterval = FrameCaptureWriter::DefaultKeyframeInterval;
+    float movingFraction = 0.02f;
+};
+
+bool parseArgs(int argc, char** argv, ReplayConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--record") && hasValue) {
+            config.record = true;
+            config.capturePath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--loops") && hasValue) {
+            config.loops = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--trace") && hasValue) {
+            config.tracePath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--stats") && hasValue) {
+            config.statsPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--json") && hasValue) {
+            config.jsonPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--memory")) {
+            config.memoryReport = true;
+        } else if (!std::strcmp(argv[i], "--alloc-budget") && hasValue) {
+            config.frameAllocationBudget = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--overdraw") && hasValue) {
+            config.overdrawPrefix = argv[++i];
+        } else if (!std::strcmp(argv[i], "--overdraw-frame") && hasValue) {
+            config.overdrawFrame = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--overdraw-scale") && hasValue) {
+            config.overdrawScale = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.01f, 1.0f);
+        } else if (!std::strcmp(argv[i], "--overdraw-proxy") && hasValue) {
+            config.overdrawProxy = !std::strcmp(argv[++i], "box") ? OverdrawProxy::Box : OverdrawProxy::Sphere;
+        } else if (!std::strcmp(argv[i], "--objects") && hasValue) {
+            config.objects = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--frames") && hasValue) {
+            config.frames = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--seed") && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--keyframe-interval") && hasValue) {
+            config.keyframeInterval = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--moving-fraction") && hasValue) {
+            config.movingFraction = static_cast<float>(std::atof(argv[++i]));
+        } else if (argv[i][0] != '-' && config.capturePath.empty()) {
+            config.capturePath = argv[i];
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (!PRISMA_ENABLE_MEMORY_TRACKING && (config.memoryReport || config.frameAllocationBudget > 0)) {
+        std::fprintf(stderr, "--memory / --alloc-budget 需要以 PRISMA_ENABLE_MEMORY_TRACKING=ON 构建\n");
+        return false;
+    }
+    return !config.capturePath.empty();
+}
+
+/** 捕获文件名（不含目录和扩展名） */
+std::string captureName(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    const size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+// ============================================================================
+// 录制
+// ============================================================================
+
+int record(const ReplayConfig& config) {
+    SceneGenConfig genConfig;
+    genConfig.seed = config.seed;
+    genConfig.objectCount = config.objects;
+    genConfig.distribution = SceneDistribution::Clustered;
+
+    const GeneratedScene scene = SceneGenerator::generate(genConfig);
+    const CameraPath path = SceneGenerator::generateCameraPath(genConfig, CameraPathType::Flythrough);
+
+    NullFrameRunner runner(scene);
+    FrameCaptureWriter writer;
+    if (!writer.open(config.capturePath, config.keyframeInterval)) {
+        std::fprintf(stderr, "无法写入 %s\n", config.capturePath.c_str());
+        return 1;
+    }
+    runner.setFrameCapture(&writer);
+
+    // 每帧移动一部分对象，产生增量
+    RenderableStorage& storage = runner.getStorage();
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    const size_t moving = static_cast<size_t>(static_cast<float>(scene.renderables.size()) * config.movingFraction);
+
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        const RenderableHandle* handles = storage.getHandles();
+        const RenderableBounds* bounds = storage.getBounds();
+        for (size_t i = 0; i < moving && storage.size() > 0; ++i) {
+            const uint32_t dense = static_cast<uint32_t>(rng() % storage.size());
+            const Vector3 center = bounds[dense].center + Vector3(offset(rng), 0.0f, offset(rng));
+            storage.setTransform(handles[dense], glm::translate(Matrix4(1.0f), center),
+                                 center, bounds[dense].radius);
+        }
+
+        const float t = static_cast<float>(frame) / static_cast<float>(config.frames);
+        runner.renderFrame(path.sample(t));
+    }
+
+    writer.close();
+    const auto& stats = writer.getStats();
+    std::printf("已录制 %llu 帧（%llu 关键帧），%llu 个对象记录，%.2f MB（%.1f KB/帧）\n",
+                static_cast<unsigned long long>(stats.frames),
+                static_cast<unsigned long long>(stats.keyframes),
+                static_cast<unsigned long long>(stats.renderablesWritten),
+                static_cast<double>(stats.bytesWritten) / (1024.0 * 1024.0),
+                static_cast<double>(stats.bytesWritten) / 1024.0 / static_cast<double>(std::max<uint64_t>(stats.frames, 1)));
+    return 0;
+}
+
+// ============================================================================
+// 回放
+// ============================================================================
+
+/**
+ * @brief 对回放帧的已排序队列做 overdraw 分析并写出结果
+ */
+bool analyzeOverdraw(const ReplayConfig& config, NullFrameRunner& runner, const CapturedFrame& frame) {
+    OverdrawConfig overdrawConfig;
+    overdrawConfig.width = std::max(1u, static_cast<uint32_t>(static_cast<float>(frame.screenWidth) * config.overdrawScale));
+    overdrawConfig.height = std::max(1u, static_cast<uint32_t>(static_cast<float>(frame.screenHeight) * config.overdrawScale));
+    overdrawConfig.proxy = config.overdrawProxy;
+
+    OverdrawAnalyzer analyzer(overdrawConfig);
+    const OverdrawResult& result = analyzer.analyze(runner.getQueueManager(),
+                                                    frame.camera.projectionMatrix * frame.camera.viewMatrix);
+
+    std::printf("\n帧 %llu ", static_cast<unsigned long long>(frame.frameNumber));
+    result.writeReport(stdout);
+    std::printf("\n");
+
+    const std::string heatmapPath = config.overdrawPrefix + ".ppm";
+    const std::string csvPath = config.overdrawPrefix + ".csv";
+    if (!result.writeHeatmap(heatmapPath) || !result.writeObjectsCsv(csvPath)) {
+        std::fprintf(stderr, "无法写入 %s / %s\n", heatmapPath.c_str(), csvPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+int replay(const ReplayConfig& config) {
+    FrameCaptureReader reader;
+    if (!reader.open(config.capturePath)) {
+        std::fprintf(stderr, "无法读取 %s: %s\n", config.capturePath.c_str(), reader.getError().c_str());
+        return 1;
+    }
+
+    NullFrameRunner runner{GeneratedScene()};
+    CapturedFrame frame;
+
+    if (config.frameAllocationBudget > 0) {
+        for (size_t tag = 0; tag < MemoryTracker::TagCount; ++tag) {
+            MemoryBudget budget;
+            budget.maxFrameAllocations = config.frameAllocationBudget;
+            MemoryTracker::get().setBudget(static_cast<MemoryTag>(tag), budget);
+        }
+    }
+
+    std::vector<double> frameMs;
+    uint32_t framesPerLoop = ~0u;   // 第一轮结束前未知
+
+    // 每个指标每轮一个采样（纳秒）
+    const std::string prefix = "Replay/" + captureName(config.capturePath) + "/";
+    std::map<std::string, std::vector<double>> metrics;
+
+    std::printf("%-6s %8s %12s %12s %12s %10s\n", "loop", "frames", "median(ms)", "min(ms)", "p99(ms)", "visible");
+
+    for (uint32_t loop = 0; loop < config.loops; ++loop) {
+        const bool lastLoop = loop + 1 == config.loops;
+        reader.rewind();
+        frameMs.clear();
+        uint64_t visible = 0;
+        uint32_t frameIndex = 0;
+        FrameProfiler::get().resetStats();
+
+        if (lastLoop) {
+            runner.getRenderStats().clearHistory();
+            if (!config.tracePath.empty()) {
+                FrameProfiler::get().beginCapture(framesPerLoop);
+            }
+        }
+
+        while (reader.readFrame(frame)) {
+            runner.applyCapture(frame);
+
+            const auto begin = std::chrono::steady_clock::now();
+            const NullFrameStats& stats = runner.renderFrame(frame.camera.viewMatrix, frame.camera.projectionMatrix,
+                                                             frame.camera.position, frame.deltaTime);
+            const auto end = std::chrono::steady_clock::now();
+
+            frameMs.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+            visible += stats.visibleObjects;
+
+            if (loop == 0 && frameIndex == config.overdrawFrame && !config.overdrawPrefix.empty()
+                && !analyzeOverdraw(config, runner, frame)) {
+                return 1;
+            }
+            ++frameIndex;
+        }
+
+        framesPerLoop = static_cast<uint32_t>(frameMs.size());
+
+        double totalMs = 0.0;
+        for (double ms : frameMs) totalMs += ms;
+        metrics[prefix + FrameProfiler::FrameZoneName].push_back(
+            frameMs.empty() ? 0.0 : totalMs * 1.0e6 / static_cast<double>(frameMs.size()));
+
+        for (const auto& zone : FrameProfiler::get().getZoneStats()) {
+            if (std::strcmp(zone.name, FrameProfiler::FrameZoneName) != 0) {
+                metrics[prefix + zone.name].push_back(zone.avgNs);
+            }
+        }
+
+        if (!reader.getError().empty()) {
+            std::fprintf(stderr, "捕获损坏: %s\n", reader.getError().c_str());
+            return 1;
+        }
+
+        std::printf("%-6u %8zu %12.3f %12.3f %12.3f %10llu\n",
+                    loop, frameMs.size(), bench::percentile(frameMs, 0.5), bench::percentile(frameMs, 0.0),
+                    bench::percentile(frameMs, 0.99),
+                    static_cast<unsigned long long>(frameMs.empty() ? 0 : visible / frameMs.size()));
+    }
+
+    if (config.memoryReport) {
+        std::printf("\n");
+        MemoryTracker::get().writeReport(stdout);
+    }
+    if (runner.getMissingCapturedFeatures() > 0) {
+        std::printf("注意: 捕获中有 %u 个 Feature 在回放端不存在\n", runner.getMissingCapturedFeatures());
+    }
+    if (!config.tracePath.empty() && !FrameProfiler::get().writeChromeTrace(config.tracePath)) {
+        std::fprintf(stderr, "无法写入 %s\n", config.tracePath.c_str());
+        return 1;
+    }
+    if (!config.statsPath.empty() && !runner.getRenderStats().writeCsv(config.statsPath)) {
+        std::fprintf(stderr, "无法写入 %s\n", config.statsPath.c_str());
+        return 1;
+    }
+
+    if (!config.jsonPath.empty()) {
+        std::vector<bench::BenchmarkResult> results;
+        for (auto& [name, samples] : metrics) {
+            bench::BenchmarkResult result;
+            result.name = name;
+            result.count = framesPerLoop;
+            result.iterationsPerSample = framesPerLoop;
+            result.samples = std::move(samples);
+            bench::summarize(result);
+            results.push_back(std::move(result));
+        }
+
+        bench::RunConfig runConfig;
+        runConfig.samples = config.loops;
+        if (!bench::writeJson(config.jsonPath, results, runConfig)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ReplayConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        std::fprintf(stderr,
+                     "用法: %s <capture.pfc> [--loops N] [--trace trace.json] [--stats stats.csv]\n"
+                     "         [--json result.json] [--memory] [--alloc-budget N]\n"
+                     "         [--overdraw prefix] [--overdraw-frame N] [--overdraw-scale S] [--overdraw-proxy box|sphere]\n"
+                     "      %s --record <capture.pfc> [--objects N] [--frames N] [--seed S]\n"
+                     "         [--keyframe-interval N] [--moving-fraction F]\n",
+                     argv[0], argv[0]);
+        return 2;
+    }
+    return config.record ? record(config) : replay(config);
+}
@@ -0,0 +1,211 @@
+/**
+ * @file LightmapBake.cpp
+ * @brief 光照贴图烘焙工具 - 在主机上用 LightmapBaker 烘焙合成场景
+ *
+ *   BasicPipelineLightmapBake [--out dir] [--prefix name] [--spp N] [--bounces N] [--texels N]
+ *                             [--atlas N] [--threads N] [--format bc6h|rgbm] [--boxes N] [--seed S]
+ *                             [--no-denoise] [--no-shadowmask] [--ao] [--prt]
+ *
+ * 场景: 地面 + 随机摆放的盒子，Mixed 太阳光（间接光 + shadowmask）、烘焙的聚光灯、
+ * Mixed 点光源（只烘焙间接光）。
+ * 输出 <out>/<prefix>_<图集编号>.ktx 与 <prefix>_<图集编号>_shadowmask.ktx 并打印烘焙统计；
+ * 用于验证烘焙器和衡量烘焙耗时。--prt 另外为 8x3x8 的探针网格和所有顶点烘焙 PRT 传输并打印统计；
+ * --ao 在 shadowmask 的 a 通道烘焙环境光遮蔽，另外为所有顶点烘焙 8 位遮蔽并打印统计
+ */
+
+#include "../Baking/AoBaker.h"
+#include "../Baking/LightmapBaker.h"
+#include "../Baking/PrtBaker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BakeToolConfig {
+    std::string outDirectory = ".";
+    std::string prefix = "lightmap";
+    uint32_t boxes = 12;
+    uint32_t seed = 1;
+    bool prt = false;
+    bool ao = false;
+    BakeSettings settings;
+};
+
+bool parseArgs(int argc, char** argv, BakeToolConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--out") && hasValue) {
+            config.outDirectory = argv[++i];
+        } else if (!std::strcmp(argv[i], "--prefix") && hasValue) {
+            config.prefix = argv[++i];
+        } else if (!std::strcmp(argv[i], "--spp") && hasValue) {
+            config.settings.samplesPerTexel = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--bounces") && hasValue) {
+            config.settings.maxBounces = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--texels") && hasValue) {
+            config.settings.texelsPerUnit = std::max(0.1f, static_cast<float>(std::atof(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--atlas") && hasValue) {
+            config.settings.packing.atlasSize = static_cast<uint32_t>(std::max(16, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--threads") && hasValue) {
+            config.settings.threadCount = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--format") && hasValue) {
+            config.settings.encoding = !std::strcmp(argv[++i], "rgbm") ? LightmapEncoding::RGBM8 : LightmapEncoding::BC6H;
+        } else if (!std::strcmp(argv[i], "--boxes") && hasValue) {
+            config.boxes = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--seed") && hasValue) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--no-denoise")) {
+            config.settings.denoise.enabled = false;
+        } else if (!std::strcmp(argv[i], "--no-shadowmask")) {
+            config.settings.shadowmask = false;
+        } else if (!std::strcmp(argv[i], "--ao")) {
+            config.ao = true;
+            config.settings.occlusion = true;
+        } else if (!std::strcmp(argv[i], "--prt")) {
+            config.prt = true;
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/** 单位立方体（每个面4个顶点，面法线） */
+BakeMesh makeBox(const Matrix4& world, const Vector3& albedo) {
+    static const Vector3 normals[6] = {
+        Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1),
+    };
+
+    BakeMesh mesh;
+    for (const Vector3& n : normals) {
+        // 面上的两个切线方向，u × v = n
+        const Vector3 u = std::fabs(n.y) > 0.5f ? Vector3(n.y, 0, 0) : Vector3(-n.z, 0, n.x);
+        const Vector3 v = glm::cross(n, u);
+        const uint32_t base = static_cast<uint32_t>(mesh.positions.size());
+        const Vector3 center = n * 0.5f;
+        mesh.positions.push_back(center - u * 0.5f - v * 0.5f);
+        mesh.positions.push_back(center + u * 0.5f - v * 0.5f);
+        mesh.positions.push_back(center + u * 0.5f + v * 0.5f);
+        mesh.positions.push_back(center - u * 0.5f + v * 0.5f);
+        for (int k = 0; k < 4; ++k) {
+            mesh.normals.push_back(n);
+        }
+        const uint32_t quad[6] = {0, 1, 2, 0, 2, 3};
+        for (uint32_t index : quad) {
+            mesh.indices.push_back(base + index);
+        }
+    }
+    mesh.worldMatrix = world;
+    mesh.albedo = albedo;
+    return mesh;
+}
+
+/** 地面（带第二套 UV） */
+BakeMesh makeGround(float size) {
+    BakeMesh mesh;
+    const float h = size * 0.5f;
+    mesh.positions = {Vector3(-h, 0, -h), Vector3(h, 0, -h), Vector3(h, 0, h), Vector3(-h, 0, h)};
+    mesh.normals.assign(4, Vector3(0, 1, 0));
+    mesh.lightmapUVs = {Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1)};
+    mesh.indices = {0, 2, 1, 0, 3, 2};
+    mesh.albedo = Vector3(0.6f);
+    return mesh;
+}
+
+BakeScene buildScene(const BakeToolConfig& config) {
+    BakeScene scene;
+    scene.meshes.push_back(makeGround(20.0f));
+
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<float> position(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 2.5f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> color(0.2f, 0.9f);
+    for (uint32_t i = 0; i < config.boxes; ++i) {
+        const Vector3 size(extent(rng), extent(rng), extent(rng));
+        Matrix4 world = glm::translate(Matrix4(1.0f), Vector3(position(rng), size.y * 0.5f, position(rng)));
+        world = glm::rotate(world, angle(rng), Vector3(0.0f, 1.0f, 0.0f));
+        world = glm::scale(world, size);
+        scene.meshes.push_back(makeBox(world, Vector3(color(rng), color(rng), color(rng))));
+    }
+
+    LightingData lighting;
+    LightData sun = LightData::createDirectional(Vector3(-0.4f, -1.0f, -0.3f), Vector3(1.0f, 0.95f, 0.85f), 2.0f);
+    sun.lightMode = LightMode::Mixed;
+    sun.castShadows = true;
+    lighting.addLight(sun);
+
+    LightData lamp = LightData::createPoint(Vector3(3.0f, 2.0f, 3.0f), 10.0f, Vector3(1.0f, 0.6f, 0.3f), 3.0f);
+    lamp.lightMode = LightMode::Mixed;
+    lighting.addLight(lamp);
+
+    LightData spot = LightData::createSpot(Vector3(-4.0f, 5.0f, -4.0f), Vector3(0.3f, -1.0f, 0.3f), 20.0f, 35.0f,
+                                           15.0f, Vector3(0.4f, 0.6f, 1.0f), 4.0f);
+    spot.lightMode = LightMode::Baked;
+    lighting.addLight(spot);
+
+    lighting.ambientColor = Vector3(0.5f, 0.6f, 0.8f);
+    lighting.ambientIntensity = 0.3f;
+    scene.addLights(lighting);
+    return scene;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BakeToolConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        std::fprintf(stderr,
+                     "用法: %s [--out dir] [--prefix name] [--spp N] [--bounces N] [--texels N]\n"
+                     "         [--atlas N] [--threads N] [--format bc6h|rgbm] [--boxes N] [--seed S] [--no-denoise]\n"
+                     "         [--no-shadowmask] [--ao] [--prt]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    const BakeScene scene = buildScene(config);
+    LightmapBaker baker;
+    baker.setSettings(config.settings);
+    const LightmapBakeResult result = baker.bake(scene);
+    result.writeReport(stdout);
+
+    if (!result.writeKtx(config.outDirectory.c_str(), config.prefix.c_str())) {
+        std::fprintf(stderr, "无法写入 %s/%s_*.ktx\n", config.outDirectory.c_str(), config.prefix.c_str());
+        return 1;
+    }
+
+    if (config.prt) {
+        std::vector<Vector3> probes;
+        for (int y = 0; y < 3; ++y) {
+            for (int z = 0; z < 8; ++z) {
+                for (int x = 0; x < 8; ++x) {
+                    probes.emplace_back(-8.75f + 2.5f * x, 0.5f + 2.0f * y, -8.75f + 2.5f * z);
+                }
+            }
+        }
+        PrtBakeSettings prtSettings;
+        prtSettings.threadCount = config.settings.threadCount;
+        prtSettings.seed = config.settings.seed;
+        PrtBaker prtBaker;
+        prtBaker.setSettings(prtSettings);
+        prtBaker.bake(scene.meshes, probes).writeReport(stdout);
+    }
+
+    if (config.ao) {
+        AoBakeSettings aoSettings;
+        aoSettings.maxDistance = config.settings.occlusionDistance;
+        aoSettings.threadCount = config.settings.threadCount;
+        aoSettings.seed = config.settings.seed;
+        AoBaker aoBaker;
+        aoBaker.setSettings(aoSettings);
+        aoBaker.bake(scene.meshes).writeReport(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file LtcFit.cpp
+ * @brief LTC 表拟合工具 - 生成区域光着色使用的 ltc_1.ktx / ltc_2.ktx
+ *
+ *   BasicPipelineLtcFit [--out dir] [--size N] [--samples N] [--iterations N] [--threads N] [--fresnel-f0 F]
+ *
+ * 默认参数即发布到 app/src/main/assets/textures/LTC/ 的表（64x64，每种采样 32x32）。
+ * 拟合后用 IntegrateAreaLightReference 对一组矩形/圆盘光源抽查 LTC 着色的误差并打印（电介质与金属各一组）
+ */
+
+#include "../Baking/LtcFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace {
+
+struct LtcToolConfig {
+    std::string outDirectory = ".";
+    LtcFitSettings settings;
+};
+
+bool parseArgs(int argc, char** argv, LtcToolConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--out") && hasValue) {
+            config.outDirectory = argv[++i];
+        } else if (!std::strcmp(argv[i], "--size") && hasValue) {
+            config.settings.size = static_cast<uint32_t>(std::max(2, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--samples") && hasValue) {
+            config.settings.sampleCount = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--iterations") && hasValue) {
+            config.settings.maxIterations = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--threads") && hasValue) {
+            config.settings.threadCount = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (!std::strcmp(argv[i], "--fresnel-f0") && hasValue) {
+            config.settings.fresnelF0 = std::min(std::max(static_cast<float>(std::atof(argv[++i])), 0.0f), 1.0f);
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/** 每个视角分段的光源数与参考积分的采样数 */
+constexpr uint32_t kReportLightCount = 1000;
+constexpr uint32_t kReportReferenceSamples = 64 * 64;
+
+struct ShadingError {
+    double specular = 0.0;
+    double diffuse = 0.0;
+};
+
+/** N·V 在 [minNdotV, maxNdotV] 内均匀分布时，随机光源上 LTC 相对参考积分的误差（Σ|差| / Σ参考） */
+ShadingError measureShadingError(const LtcTable& table, float roughness, float f0, float minNdotV, float maxNdotV) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> ndotv(minNdotV, maxNdotV);
+    auto randomDirection = [&]() { return glm::normalize(Vector3(uniform(rng), uniform(rng), uniform(rng))); };
+
+    const Vector3 normal(0.0f, 1.0f, 0.0f);
+    const Vector3 F0(f0);
+    double specularError = 0.0, specularReference = 0.0;
+    double diffuseError = 0.0, diffuseReference = 0.0;
+    for (uint32_t k = 0; k < kReportLightCount; ++k) {
+        const Vector3 position(uniform(rng) * 3.0f, 1.0f + uniform(rng), uniform(rng) * 3.0f);
+        const Vector3 facing = randomDirection();
+        const LightData light = k & 1
+            ? LightData::createDiskArea(position, facing, 0.5f + uniform(rng) * 0.4f, 50.0f)
+            : LightData::createRectArea(position, facing, randomDirection(), 1.0f + uniform(rng) * 0.8f,
+                                        1.0f + uniform(rng) * 0.8f, 50.0f);
+
+        const float cosTheta = ndotv(rng);
+        const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+        const float phi = uniform(rng) * 3.14159265f;
+        const Vector3 view(sinTheta * std::cos(phi), cosTheta, sinTheta * std::sin(phi));
+
+        const AreaLightShading ltc = EvaluateAreaLightLtc(light, table, Vector3(0.0f), normal, view, roughness, F0);
+        const AreaLightShading reference = IntegrateAreaLightReference(light, Vector3(0.0f), normal, view, roughness,
+                                                                       F0, kReportReferenceSamples);
+        specularError += std::fabs(ltc.specular.x - reference.specular.x);
+        specularReference += reference.specular.x;
+        diffuseError += std::fabs(ltc.diffuse.x - reference.diffuse.x);
+        diffuseReference += reference.diffuse.x;
+    }
+
+    ShadingError error;
+    error.specular = specularError / std::max(specularReference, 1e-9);
+    error.diffuse = diffuseError / std::max(diffuseReference, 1e-9);
+    return error;
+}
+
+/** 按视角分段报告: 视角 ≤ 45°、有效范围（N·V ≥ kLtcMinValidNdotV）、掠射视角（N·V 0.1 到 kLtcMinValidNdotV） */
+void reportShadingError(const LtcTable& table, float f0) {
+    const float roughnessValues[] = {0.25f, 0.5f, 0.75f, 1.0f};
+    for (float roughness : roughnessValues) {
+        const ShadingError frontal = measureShadingError(table, roughness, f0, std::cos(glm::radians(45.0f)), 1.0f);
+        const ShadingError valid = measureShadingError(table, roughness, f0, kLtcMinValidNdotV, 1.0f);
+        const ShadingError grazing = measureShadingError(table, roughness, f0, 0.1f, kLtcMinValidNdotV);
+        std::printf("  roughness %.2f: specular error %.1f%% (<= 45 deg), %.1f%% (N.V >= %.2f), %.1f%% (grazing), "
+                    "diffuse error %.1f%%\n",
+                    roughness, 100.0 * frontal.specular, 100.0 * valid.specular, kLtcMinValidNdotV,
+                    100.0 * grazing.specular, 100.0 * std::max(valid.diffuse, grazing.diffuse));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LtcToolConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    LtcTable table;
+    const LtcFitStats stats = FitLtcTable(config.settings, table);
+    stats.writeReport(stdout);
+
+    const std::string matrixPath = config.outDirectory + "/ltc_1.ktx";
+    const std::string amplitudePath = config.outDirectory + "/ltc_2.ktx";
+    if (!WriteLtcTableKtx(table, matrixPath.c_str(), amplitudePath.c_str())) {
+        std::fprintf(stderr, "无法写入 %s\n", matrixPath.c_str());
+        return 1;
+    }
+    std::printf("  output        %s, %s\n", matrixPath.c_str(), amplitudePath.c_str());
+
+    LtcTable loaded;
+    if (!ReadLtcTableKtx(matrixPath.c_str(), amplitudePath.c_str(), loaded)) {
+        std::fprintf(stderr, "无法读回 %s\n", matrixPath.c_str());
+        return 1;
+    }
+    for (float f0 : {0.04f, 1.0f}) {
+        std::printf("Shading error vs reference (rect + disk, F0 = %.2f)\n", f0);
+        reportShadingError(loaded, f0);
+    }
+    return 0;
+}
@@ -0,0 +1,637 @@
+/**
+ * @file NullFrameRunner.cpp
+ * @brief 空后端帧运行器实现
+ */
+
+#include "NullFrameRunner.h"
+#include "../Profiler.h"
+#include "../MemoryTracker.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+constexpr float kNearPlane = 0.1f;
+constexpr float kFarPlane = 1000.0f;
+
+} // namespace
+
+// ============================================================================
+// NullRenderContext
+// ============================================================================
+
+TextureHandle NullRenderContext::CreateTemporaryTexture(const TextureDesc& desc) {
+    const uint64_t bytes = EstimateTextureBytes(desc);
+    temporaryBytes_[nextHandle_] = bytes;
+    liveTemporaryBytes += bytes;
+    ++liveTemporaries;
+    ++liveTextures;
+    return TextureHandle(nextHandle_++);
+}
+
+void NullRenderContext::ReleaseTemporaryTexture(TextureHandle handle) {
+    if (handle.IsValid()) {
+        release(handle.GetIndex(), liveTextures);
+    }
+}
+
+BufferHandle NullRenderContext::CreateTemporaryBuffer(const BufferDesc& desc) {
+    temporaryBytes_[nextHandle_] = desc.size;
+    liveTemporaryBytes += desc.size;
+    ++liveTemporaries;
+    ++liveBuffers;
+    return BufferHandle(nextHandle_++);
+}
+
+void NullRenderContext::ReleaseTemporaryBuffer(BufferHandle handle) {
+    if (handle.IsValid()) {
+        release(handle.GetIndex(), liveBuffers);
+    }
+}
+
+void NullRenderContext::release(uint32_t index, uint32_t& counter) {
+    auto it = temporaryBytes_.find(index);
+    if (it == temporaryBytes_.end()) {
+        return;
+    }
+    liveTemporaryBytes -= it->second;
+    temporaryBytes_.erase(it);
+    --liveTemporaries;
+    --counter;
+}
+
+// ============================================================================
+// NullFrameRunner
+// ============================================================================
+
+NullFrameRunner::NullFrameRunner(const GeneratedScene& scene, uint32_t width, uint32_t height)
+    : lightingData_(scene.lighting)
+    , shadowSettings_(ShadowSettings::defaultSettings())
+    , renderingData_(RenderingData::create()) {
+    scene.fillStorage(storage_);
+
+    shadowAtlas_.width = 4096;
+    shadowAtlas_.height = 4096;
+
+    renderingData_.screenWidth = width;
+    renderingData_.screenHeight = height;
+    renderingData_.lightingData = &lightingData_;
+    renderingData_.shadowSettings = &shadowSettings_;
+
+    context_.setRenderTargetSize(width, height);
+}
+
+void NullFrameRunner::addFeature(std::unique_ptr<IRenderFeature> feature) {
+    if (!feature) {
+        return;
+    }
+    if (!feature->Initialize(context_)) {
+        feature->SetActive(false);
+    }
+    featureManager_.AddFeature(std::move(feature));
+}
+
+void NullFrameRunner::setGpuProfiler(GpuProfiler* profiler) {
+    gpuProfiler_ = profiler;
+    featureManager_.SetGpuProfiler(profiler);
+}
+
+const NullFrameStats& NullFrameRunner::renderFrame(const CameraKeyframe& camera, float deltaTime) {
+    const float aspect = renderingData_.screenHeight > 0
+        ? static_cast<float>(renderingData_.screenWidth) / static_cast<float>(renderingData_.screenHeight)
+        : 1.0f;
+
+    const Matrix4 view = glm::lookAt(camera.position, camera.target, Vector3(0.0f, 1.0f, 0.0f));
+    const Matrix4 projection = glm::perspective(glm::radians(camera.fieldOfView), aspect, kNearPlane, kFarPlane);
+    return renderFrame(view, projection, camera.position, deltaTime);
+}
+
+void NullFrameRunner::applyCapture(const CapturedFrame& frame) {
+    playback_.apply(frame, storage_);
+
+    if (frame.keyframe || frame.lightingChanged) {
+        lightingData_ = frame.lighting;
+    }
+    if (frame.keyframe || frame.shadowChanged) {
+        shadowSettings_ = frame.shadowSettings;
+    }
+    if (frame.keyframe || frame.featuresChanged) {
+        missingFeatures_ = CapturePlayback::applyFeatures(frame, featureManager_);
+    }
+
+    renderingData_.screenWidth = frame.screenWidth;
+    renderingData_.screenHeight = frame.screenHeight;
+    renderingData_.enableShadows = frame.enableShadows;
+    renderingData_.enablePostProcessing = frame.enablePostProcessing;
+    renderingData_.debugView = frame.debugView;
+    renderingData_.time = frame.time - frame.deltaTime;
+    context_.setRenderTargetSize(frame.screenWidth, frame.screenHeight);
+}
+
+const NullFrameStats& NullFrameRunner::renderCapturedFrame(const CapturedFrame& frame) {
+    applyCapture(frame);
+    return renderFrame(frame.camera.viewMatrix, frame.camera.projectionMatrix,
+                       frame.camera.position, frame.deltaTime);
+}
+
+const NullFrameStats& NullFrameRunner::renderFrame(const Matrix4& viewMatrix,
+                                                   const Matrix4& projectionMatrix,
+                                                   const Vector3& cameraPosition,
+                                                   float deltaTime) {
+    const auto frameStart = std::chrono::steady_clock::now();
+    auto elapsedMs = [&frameStart] {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    };
+
+    if (idleDetector_) {
+        IdleFrameInputs inputs;
+        inputs.viewMatrix = viewMatrix;
+        inputs.projectionMatrix = projectionMatrix;
+        inputs.storageVersion = storage_.getChangeVersion();
+        inputs.lighting = &lightingData_;
+        inputs.shadows = &shadowSettings_;
+        inputs.features = &featureManager_;
+        inputs.activeAnimations = activeAnimations_;
+        inputs.screenWidth = renderingData_.screenWidth;
+        inputs.screenHeight = renderingData_.screenHeight;
+        inputs.renderFlags = (renderingData_.enableShadows ? 1u : 0u)
+                           | (renderingData_.enablePostProcessing ? 2u : 0u)
+                           | (renderingData_.debugView ? 4u : 0u);
+
+        const IdleFrameAction action = idleDetector_->evaluate(inputs);
+        if (action != IdleFrameAction::Render) {
+            // 空闲帧: 不推进帧号，不执行任何渲染阶段
+            PRISMA_PROFILE_ZONE("IdleFrame");
+            stats_ = NullFrameStats();
+            stats_.totalObjects = static_cast<uint32_t>(storage_.size());
+            stats_.idleAction = action;
+            renderingData_.time += deltaTime;
+            idleDetector_->reportFrameCost(action, elapsedMs());
+            PRISMA_PROFILE_FRAME();
+            return stats_;
+        }
+    }
+
+    {
+        PRISMA_PROFILE_ZONE("Render");
+
+        void* cmd = beginFrame();
+        prepareRendering(viewMatrix, projectionMatrix, cameraPosition, deltaTime);
+        renderCamera(cmd, true);
+        stats_.visibleObjects = queueManager_.getStats().totalObjects;
+        endFrame(cmd);
+    }
+
+    if (idleDetector_) {
+        idleDetector_->reportFrameCost(IdleFrameAction::Render, elapsedMs());
+    }
+
+    PRISMA_PROFILE_FRAME();
+    PRISMA_MEMORY_FRAME();
+    return stats_;
+}
+
+const NullFrameStats& NullFrameRunner::renderFrame(const NullCameraView* views, uint32_t viewCount,
+                                                   float deltaTime) {
+    {
+        PRISMA_PROFILE_ZONE("Render");
+
+        void* cmd = beginFrame();
+        const uint32_t count = std::min(viewCount, MultiCameraCuller::MaxCameras);
+
+        // 按深度排序（与 Camera::getDepth 一致，小的先渲染），深度相同时保持传入顺序
+        uint32_t order[MultiCameraCuller::MaxCameras];
+        for (uint32_t i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order, order + count, [views](uint32_t a, uint32_t b) {
+            return views[a].depth < views[b].depth;
+        });
+
+        renderingData_.deltaTime = deltaTime;
+        renderingData_.time += deltaTime;
+
+        // 快照按传入下标保存，保证每个相机的上一帧矩阵来自同一个视图
+        if (viewSnapshots_.size() < count) {
+            viewSnapshots_.resize(count);
+        }
+        const CameraSnapshot* snapshots[MultiCameraCuller::MaxCameras];
+        {
+            PRISMA_PROFILE_ZONE("CameraSnapshot::build");
+            for (uint32_t n = 0; n < count; ++n) {
+                const NullCameraView& view = views[order[n]];
+                CameraSnapshot& snapshot = viewSnapshots_[order[n]];
+                snapshot = CameraSnapshot::build(makeSnapshotParams(view.viewMatrix, view.projectionMatrix), &snapshot);
+                snapshots[n] = &snapshot;
+            }
+        }
+
+        if (capture_ && count > 0) {
+            // 捕获格式只记录一个相机: 第一个渲染的相机
+            PRISMA_PROFILE_ZONE("FrameCapture");
+            setCameraData(*snapshots[0]);
+            capture_->writeFrame(renderingData_, storage_, &featureManager_);
+        }
+
+        multiCameraCuller_.cull(storage_, snapshots, count);
+        viewCpuMs_.assign(viewCount, 0.0f);
+
+        for (uint32_t n = 0; n < count; ++n) {
+            PRISMA_PROFILE_ZONE("RenderCamera");
+            const auto cameraStart = std::chrono::steady_clock::now();
+
+            setCameraData(*snapshots[n]);
+            cameraSnapshot_ = *snapshots[n];
+            renderingData_.cameraSnapshot = &cameraSnapshot_;
+
+            queueManager_.clear();
+            {
+                PRISMA_PROFILE_ZONE("MultiCameraCuller::buildQueues");
+                multiCameraCuller_.buildQueues(n, queueManager_);
+            }
+            {
+                PRISMA_PROFILE_ZONE("RenderQueueManager::sortAll");
+                queueManager_.sortAll();
+            }
+
+            const bool ownShadows = multiCameraCuller_.getShadowSource(n) == n;
+            if (!ownShadows) {
+                ++stats_.sharedShadowCameras;
+            }
+            renderCamera(cmd, ownShadows);
+            stats_.visibleObjects += queueManager_.getStats().totalObjects;
+
+            viewCpuMs_[order[n]] = std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - cameraStart).count();
+        }
+
+        stats_.cameras = count;
+        endFrame(cmd);
+    }
+
+    PRISMA_PROFILE_FRAME();
+    PRISMA_MEMORY_FRAME();
+    return stats_;
+}
+
+const NullFrameStats& NullFrameRunner::renderStereoFrame(const NullCameraView& left, const NullCameraView& right,
+                                                        float deltaTime) {
+    {
+        PRISMA_PROFILE_ZONE("Render");
+
+        void* cmd = beginFrame();
+        renderingData_.deltaTime = deltaTime;
+        renderingData_.time += deltaTime;
+
+        {
+            PRISMA_PROFILE_ZONE("StereoSnapshot::build");
+            stereoSnapshot_ = StereoSnapshot::build(makeSnapshotParams(left.viewMatrix, left.projectionMatrix),
+                                                    makeSnapshotParams(right.viewMatrix, right.projectionMatrix),
+                                                    &stereoSnapshot_);
+        }
+
+        // 单视图字段指向左眼（捕获格式只记录一个相机）
+        setCameraData(stereoSnapshot_.eyes[0]);
+        cameraSnapshot_ = stereoSnapshot_.eyes[0];
+        renderingData_.cameraSnapshot = &cameraSnapshot_;
+        renderingData_.stereoSnapshot = &stereoSnapshot_;
+        renderingData_.viewCount = StereoSnapshot::ViewCount;
+
+        if (capture_) {
+            PRISMA_PROFILE_ZONE("FrameCapture");
+            capture_->writeFrame(renderingData_, storage_, &featureManager_);
+        }
+
+        queueManager_.clear();
+        {
+            PRISMA_PROFILE_ZONE("RenderQueueBuilder::build");
+            RenderQueueBuilder::build(storage_, stereoSnapshot_, queueManager_);
+        }
+        {
+            PRISMA_PROFILE_ZONE("RenderQueueManager::sortAll");
+            queueManager_.sortAll();
+        }
+
+        // 阴影与视图无关，两眼共用；每个对象只录制一次（模拟 multiview 广播到两个视图）
+        renderCamera(cmd, true);
+        stats_.visibleObjects = queueManager_.getStats().totalObjects;
+        stats_.views = StereoSnapshot::ViewCount;
+        endFrame(cmd);
+    }
+
+    PRISMA_PROFILE_FRAME();
+    PRISMA_MEMORY_FRAME();
+    return stats_;
+}
+
+void* NullFrameRunner::beginFrame() {
+    frameStart_ = std::chrono::steady_clock::now();
+    stats_ = NullFrameStats();
+    renderingData_.stereoSnapshot = nullptr;
+    renderingData_.viewCount = 1;
+    context_.drawCalls = 0;
+    renderStats_.beginFrame(++frameNumber_);
+
+    void* cmd = context_.GetCommandBuffer();
+    if (gpuProfiler_) {
+        gpuProfiler_->beginFrame(cmd);
+    }
+
+    for (const auto& feature : featureManager_.GetAllFeatures()) {
+        feature->OnFrameBegin();
+    }
+    return cmd;
+}
+
+void NullFrameRunner::renderCamera(void* cmd, bool renderShadowMaps) {
+    auto executeFeatures = [this](RenderPassEvent evt) {
+        featureManager_.ExecuteFeatures(evt, context_, renderingData_);
+    };
+
+    executeFeatures(RenderPassEvent::BeforeRendering);
+
+    executeFeatures(RenderPassEvent::BeforeRenderingShadows);
+    if (renderShadowMaps) {
+        PRISMA_GPU_ZONE(gpuProfiler_, cmd, "ShadowPass");
+        renderShadows();
+    }
+    executeFeatures(RenderPassEvent::AfterRenderingShadows);
+
+    executeFeatures(RenderPassEvent::BeforeRenderingOpaques);
+    {
+        PRISMA_PROFILE_ZONE("RenderOpaques");
+        PRISMA_GPU_ZONE(gpuProfiler_, cmd, "OpaquePass");
+        renderQueue(queueManager_.getOpaqueQueue(), RenderStatsPass::Opaque, stats_.opaqueObjects);
+        renderQueue(queueManager_.getAlphaTestQueue(), RenderStatsPass::Opaque, stats_.alphaTestObjects);
+    }
+    executeFeatures(RenderPassEvent::AfterRenderingOpaques);
+
+    executeFeatures(RenderPassEvent::BeforeRenderingSkybox);
+    {
+        PRISMA_PROFILE_ZONE("RenderSkybox");
+        PRISMA_GPU_ZONE(gpuProfiler_, cmd, "SkyboxPass");
+        context_.DrawFullScreen(PipelineHandle());
+        renderStats_.trackPipelineBind(RenderStatsPass::Skybox, RenderQueueId::Background);
+        renderStats_.recordDraw(RenderStatsPass::Skybox, 1, 2);
+    }
+    executeFeatures(RenderPassEvent::AfterRenderingSkybox);
+
+    executeFeatures(RenderPassEvent::BeforeRenderingTransparents);
+    {
+        PRISMA_PROFILE_ZONE("RenderTransparents");
+        PRISMA_GPU_ZONE(gpuProfiler_, cmd, "TransparentPass");
+        renderQueue(queueManager_.getTransparentQueue(), RenderStatsPass::Transparent, stats_.transparentObjects);
+    }
+    executeFeatures(RenderPassEvent::AfterRenderingTransparents);
+
+    executeFeatures(RenderPassEvent::AfterRendering);
+}
+
+void NullFrameRunner::endFrame(void* cmd) {
+    for (const auto& feature : featureManager_.GetAllFeatures()) {
+        feature->OnFrameEnd();
+    }
+
+    if (gpuProfiler_) {
+        gpuProfiler_->endFrame(cmd);
+    }
+
+    stats_.totalObjects = static_cast<uint32_t>(storage_.size());
+    stats_.drawCalls = context_.drawCalls;
+
+    // Feature 通过上下文提交的绘制 = 总数 - 核心Pass已记录的数量
+    const uint32_t coreDraws = renderStats_.getCurrent().total().drawCalls;
+    for (uint32_t i = coreDraws; i < context_.drawCalls; ++i) {
+        renderStats_.recordDraw(RenderStatsPass::Features);
+    }
+
+    // 多相机时每个相机各测试一次
+    const uint32_t tested = stats_.totalObjects * stats_.cameras;
+    renderStats_.recordCulling(CullingStage::Frustum, tested, tested - stats_.visibleObjects);
+    renderStats_.setVisibleObjects(stats_.visibleObjects);
+    renderStats_.setTransientMemory(context_.liveTemporaryBytes, context_.liveTextures, context_.liveBuffers);
+
+    if (lateLatchPending_) {
+        // 提交前锁存最新输入
+        lateLatchPending_ = false;
+        CameraInputSample latest;
+        if (inputSampler_ && inputSampler_(latest)) {
+            lateLatch_->latch(latest);
+        } else {
+            lateLatch_->submitWithoutLatch();
+        }
+        const LateLatchFrameStats& latch = lateLatch_->getFrameStats();
+        renderStats_.recordInputLatency(latch.earlyLatencyMs, latch.submittedLatencyMs, latch.latched);
+    }
+
+    if (secondaryCameras_) {
+        const SecondaryCameraFrameStats& secondary = secondaryCameras_->getFrameStats();
+        renderStats_.recordSecondaryCameras(secondary.updates, secondary.deferred,
+                                            secondary.scheduledCostMs, secondary.maxStaleness);
+    }
+
+    // 每个可见对象上传一个世界矩阵
+    renderStats_.addUploadBytes(static_cast<uint64_t>(stats_.visibleObjects) * sizeof(Matrix4));
+    renderStats_.setCpuFrameMs(std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - frameStart_).count());
+    renderStats_.endFrame();
+}
+
+// ============================================================================
+// 渲染阶段
+// ============================================================================
+
+CameraSnapshotParams NullFrameRunner::makeSnapshotParams(const Matrix4& viewMatrix,
+                                                         const Matrix4& projectionMatrix) const {
+    CameraSnapshotParams params;
+    params.viewMatrix = viewMatrix;
+    params.projectionMatrix = projectionMatrix;
+    params.width = renderingData_.screenWidth;
+    params.height = renderingData_.screenHeight;
+    params.nearPlane = kNearPlane;
+    params.farPlane = kFarPlane;
+    params.frameNumber = frameNumber_;
+    return params;
+}
+
+void NullFrameRunner::setCameraData(const CameraSnapshot& snapshot) {
+    renderingData_.viewMatrix = snapshot.unjittered.view;
+    renderingData_.projectionMatrix = snapshot.unjittered.projection;
+    renderingData_.viewProjectionMatrix = snapshot.unjittered.viewProjection;
+    renderingData_.cameraPosition = snapshot.position;
+}
+
+void NullFrameRunner::prepareRendering(const Matrix4& viewMatrix, const Matrix4& projectionMatrix,
+                                       const Vector3& cameraPosition, float deltaTime) {
+    PRISMA_PROFILE_ZONE("PrepareRendering");
+
+    renderingData_.viewMatrix = viewMatrix;
+    renderingData_.projectionMatrix = projectionMatrix;
+    renderingData_.viewProjectionMatrix = projectionMatrix * viewMatrix;
+    renderingData_.cameraPosition = cameraPosition;
+    renderingData_.deltaTime = deltaTime;
+    renderingData_.time += deltaTime;
+
+    if (capture_) {
+        PRISMA_PROFILE_ZONE("FrameCapture");
+        capture_->writeFrame(renderingData_, storage_, &featureManager_);
+    }
+
+    {
+        PRISMA_PROFILE_ZONE("CameraSnapshot::build");
+        cameraSnapshot_ = CameraSnapshot::build(makeSnapshotParams(viewMatrix, projectionMatrix), &cameraSnapshot_);
+        renderingData_.cameraSnapshot = &cameraSnapshot_;
+    }
+
+    if (lateLatch_ && lateLatch_->isInitialized()) {
+        // 相机矩阵视为在此刻由输入采样得到
+        ApplyLateLatchCullingMargin(cameraSnapshot_, lateLatch_->getSettings());
+        lateLatch_->writeEarly(static_cast<uint32_t>(frameNumber_ % lateLatch_->getSlotCount()),
+                               cameraSnapshot_, GetLateLatchTimeNs());
+        lateLatchPending_ = true;
+    }
+
+    const LightingData* frameLighting = &lightingData_;
+    if (lightAggregator_) {
+        lightAggregator_->aggregate(lightingData_, cameraSnapshot_);
+        stats_.localLights = lightAggregator_->getStats().outputLights();
+        stats_.aggregatedLights = lightAggregator_->getStats().aggregatedLights;
+
+        aggregatedLighting_ = lightingData_;
+        lightAggregator_->applyTo(aggregatedLighting_);
+        frameLighting = &aggregatedLighting_;
+    }
+
+    if (shadowSelector_ && renderingData_.enableShadows) {
+        // 被合并的光源不再单独着色，只从聚合后的光源中选择
+        shadowLighting_ = frameLighting;
+        shadowSelector_->select(*shadowLighting_, cameraSnapshot_, shadowSettings_, storage_);
+        stats_.shadowLightChanges = shadowSelector_->getStats().enteredLights;
+        shadowSelectionPending_ = true;
+    }
+
+    queueManager_.clear();
+    {
+        PRISMA_PROFILE_ZONE("RenderQueueBuilder::build");
+        RenderQueueBuilder::build(storage_, cameraSnapshot_, queueManager_);
+    }
+    {
+        PRISMA_PROFILE_ZONE("RenderQueueManager::sortAll");
+        queueManager_.sortAll();
+    }
+}
+
+void NullFrameRunner::renderShadows() {
+    PRISMA_PROFILE_ZONE("RenderShadows");
+
+    shadowAtlas_.reset();
+
+    // 选择结果只属于 prepareRendering 的相机
+    const bool useSelection = shadowSelectionPending_;
+    shadowSelectionPending_ = false;
+
+    if (!renderingData_.enableShadows || !shadowSettings_.enableShadows) {
+        return;
+    }
+
+    const uint32_t cascadeResolution = static_cast<uint32_t>(shadowSettings_.cascadedSettings.resolution);
+    const uint32_t localResolution = cascadeResolution / 2;
+
+    auto renderLight = [&](LightType type, const LightData& light) {
+        ++stats_.shadowLights;
+
+        // 投射者剔除（使用 shadowmask 的光源只保留动态投射者）
+        stats_.shadowCasters += CullShadowCasters(storage_, light, shadowSettings_, renderingData_.cameraPosition,
+                                                  &shadowCasters_);
+        stats_.shadowmaskLights += shadowSettings_.usesShadowmask(light);
+
+        switch (type) {
+            // 定向光: 级联阴影
+            case LightType::Directional: {
+                uint32_t cascades = 1;
+                if (shadowSettings_.enableCascadedShadows) {
+                    const auto splits = shadowSettings_.cascadedSettings.calculateSplitDistances(
+                        kNearPlane, std::min(kFarPlane, shadowSettings_.getRealtimeShadowDistance(light)));
+                    cascades = static_cast<uint32_t>(splits.size()) - 1;
+                }
+
+                for (uint32_t c = 0; c < cascades; ++c) {
+                    if (shadowAtlas_.allocate(cascadeResolution, cascadeResolution).width > 0) {
+                        ++stats_.shadowAtlasRects;
+                    }
+                }
+                stats_.shadowCascades += cascades;
+                renderStats_.recordShadowMap(cascades);
+                break;
+            }
+
+            // 聚光灯: 单张阴影贴图
+            case LightType::Spot:
+                if (shadowAtlas_.allocate(localResolution, localResolution).width > 0) {
+                    ++stats_.shadowAtlasRects;
+                }
+                renderStats_.recordShadowMap();
+                break;
+
+            // 点光源: 立方体阴影的6个面
+            default:
+                for (uint32_t face = 0; face < 6; ++face) {
+                    if (shadowAtlas_.allocate(localResolution / 2, localResolution / 2).width > 0) {
+                        ++stats_.shadowAtlasRects;
+                    }
+                }
+                renderStats_.recordShadowMap(6);
+                break;
+        }
+    };
+
+    // 按重要性排名，atlas 空间不足时排名低的光源先放弃
+    if (useSelection) {
+        for (const ShadowLightSelection& selection : shadowSelector_->getSelection()) {
+            renderLight(selection.type, ShadowLightSelector::getLight(*shadowLighting_, selection));
+        }
+        return;
+    }
+
+    // 按下标: 定向光、聚光灯、点光源的前 maxShadowCastingLightsPerFrame 个
+    int shadowIndex = 0;
+    auto renderList = [&](LightType type, const LightDataList& lights) {
+        for (const auto& light : lights) {
+            if (!light.castShadows) continue;
+            if (!shadowSettings_.shouldRenderShadow(shadowIndex)) return false;
+            ++shadowIndex;
+            renderLight(type, light);
+        }
+        return true;
+    };
+    renderList(LightType::Directional, lightingData_.directionalLights)
+        && renderList(LightType::Spot, lightingData_.spotLights)
+        && renderList(LightType::Point, lightingData_.pointLights);
+}
+
+void NullFrameRunner::renderQueue(const RenderQueue* queue, RenderStatsPass pass, uint32_t& objectCount) {
+    if (!queue) {
+        return;
+    }
+
+    const auto& objects = queue->getObjects();
+    uint64_t lastMaterial = ~0ull;
+
+    for (const auto& obj : objects) {
+        if (obj.materialID != lastMaterial) {
+            ++stats_.materialChanges;
+            lastMaterial = obj.materialID;
+        }
+
+        // 管线按队列区分，材质描述符（set 1）按材质区分，对象描述符（set 2）每次绘制都变
+        renderStats_.trackPipelineBind(pass, obj.queueID);
+        renderStats_.trackDescriptorBind(pass, 1, obj.materialID);
+        renderStats_.trackDescriptorBind(pass, 2, reinterpret_cast<uintptr_t>(&obj));
+
+        context_.DrawProcedural(PipelineHandle(), 0);
+        renderStats_.recordDraw(pass);
+    }
+
+    objectCount += static_cast<uint32_t>(objects.size());
+}
@@ -0,0 +1,359 @@
+/**
+ * @file NullFrameRunner.h
+ * @brief 空后端帧运行器 - 在不依赖图形API的情况下执行完整的CPU帧流程
+ *
+ * 阶段顺序与 BasicRenderer::Render 一致:
+ * 1. PrepareRendering   - 相机矩阵、视锥体、队列构建与排序
+ * 2. RenderShadows      - 阴影光源选择、投射者剔除、级联分割、Atlas 分配
+ * 3. RenderOpaques      - 遍历不透明/AlphaTest 队列，统计绘制与状态切换
+ * 4. RenderSkybox
+ * 5. RenderTransparents - 遍历透明队列
+ * 各阶段前后按 RenderPassEvent 执行已注册的 Feature
+ *
+ * 所有绘制命令提交到 NullRenderContext，只做计数
+ * 绘制、绑定、阴影、临时内存、上传和剔除计数写入 RenderStatsCollector（见 RenderStats.h）
+ * 每个阶段和每个 Feature 都有分析区段，帧结束时打帧标记（见 Profiler.h）
+ * 帧结束时汇总按子系统标记的内存分配并检查预算（见 MemoryTracker.h）
+ * 设置 GpuProfiler（通常配合 MockGpuTimestampBackend）后同时记录GPU区段
+ * 设置 FrameCaptureWriter 后每帧在构建队列前写入捕获；applyCapture 用于回放捕获帧
+ * 多相机帧（分屏、画中画）一次遍历剔除所有相机，之后每个相机只做入队、排序和录制（见 MultiCameraCuller.h）
+ * 设置 SecondaryCameraScheduler 后，每帧的次级相机调度汇总写入 RenderStats
+ * 设置 LateLatchBuffer 后单相机帧的剔除带余量，提交前用采样函数返回的最新相机改写常量，输入延迟写入 RenderStats
+ * 设置 IdleFrameDetector 后单相机帧先做变化检测，画面不变时跳过整帧（见 IdleFrameDetector.h）
+ * 设置 LightAggregator 后单相机帧在构建快照后做光源 LOD 聚合，聚合结果写入统计（见 LightAggregator.h）
+ * 设置 ShadowLightSelector 后单相机帧的阴影光源按重要性排名选择（同时设置 LightAggregator 时从聚合后的光源中选择），
+ * 其他帧按下标（见 ShadowLightSelector.h）
+ * 立体帧用两眼的合并视锥体剔除一次、排序一次，并模拟单遍录制: 每个对象只计一次绘制（没有真实的 multiview 通道，见 StereoRendering.h）
+ */
+
+#pragma once
+
+#include "SceneGenerator.h"
+#include "../IRenderFeature.h"
+#include "../GpuProfiler.h"
+#include "../RenderStats.h"
+#include "../FrameCapture.h"
+#include "../Frustum.h"
+#include "../CameraSnapshot.h"
+#include "../MultiCameraCuller.h"
+#include "../SecondaryCameraScheduler.h"
+#include "../StereoRendering.h"
+#include "../LateLatch.h"
+#include "../IdleFrameDetector.h"
+#include "../LightAggregator.h"
+#include "../ShadowSettings.h"
+#include "../ShadowCasterCuller.h"
+#include "../ShadowLightSelector.h"
+#include "../RenderingData.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 空渲染上下文
+ *
+ * 实现 IRenderContext，不执行任何图形API调用
+ */
+class NullRenderContext : public IRenderContext {
+public:
+    void* GetCommandBuffer() override { return nullptr; }
+    void* GetAPIDevice() override { return nullptr; }
+
+    TextureHandle GetCameraColor() override { return TextureHandle(); }
+    TextureHandle GetCameraDepth() override { return TextureHandle(); }
+
+    TextureHandle CreateTemporaryTexture(const TextureDesc& desc) override;
+    void ReleaseTemporaryTexture(TextureHandle handle) override;
+    BufferHandle CreateTemporaryBuffer(const BufferDesc& desc) override;
+    void ReleaseTemporaryBuffer(BufferHandle handle) override;
+
+    void DrawFullScreen(PipelineHandle /*pipeline*/) override { ++drawCalls; }
+    void DrawProcedural(PipelineHandle /*pipeline*/, uint32_t /*vertexCount*/) override { ++drawCalls; }
+
+    void GetRenderTargetSize(uint32_t& width, uint32_t& height) override {
+        width = width_;
+        height = height_;
+    }
+
+    IResourceManager* GetResourceManager() override { return nullptr; }
+
+    void setRenderTargetSize(uint32_t width, uint32_t height) {
+        width_ = width;
+        height_ = height;
+    }
+
+    /** 本帧提交的绘制调用数 */
+    uint32_t drawCalls = 0;
+
+    /** 当前存活的临时资源数 */
+    uint32_t liveTemporaries = 0;
+
+    /** 当前存活的临时纹理/缓冲数及其估算字节数 */
+    uint32_t liveTextures = 0;
+    uint32_t liveBuffers = 0;
+    uint64_t liveTemporaryBytes = 0;
+
+private:
+    void release(uint32_t index, uint32_t& counter);
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t nextHandle_ = 0;
+
+    /** 句柄索引 -> 字节数 */
+    std::unordered_map<uint32_t, uint64_t> temporaryBytes_;
+};
+
+/**
+ * @brief 单帧统计
+ */
+struct NullFrameStats {
+    uint32_t totalObjects = 0;
+    uint32_t visibleObjects = 0;
+    uint32_t opaqueObjects = 0;
+    uint32_t alphaTestObjects = 0;
+    uint32_t transparentObjects = 0;
+
+    /** 相邻对象材质不同时计一次材质切换 */
+    uint32_t materialChanges = 0;
+
+    uint32_t drawCalls = 0;
+    uint32_t shadowLights = 0;
+    uint32_t shadowCascades = 0;
+    uint32_t shadowAtlasRects = 0;
+
+    /** 各阴影光源渲染的投射者数之和（见 ShadowCasterCuller.h） */
+    uint32_t shadowCasters = 0;
+
+    /** 静态阴影来自烘焙 shadowmask 的阴影光源数 */
+    uint32_t shadowmaskLights = 0;
+
+    /** 本帧渲染的相机数，以及复用其他相机阴影贴图的相机数 */
+    uint32_t cameras = 1;
+    uint32_t sharedShadowCameras = 0;
+
+    /** 每次绘制对应的视图数（模拟单遍立体帧为2） */
+    uint32_t views = 1;
+
+    /** 光源聚合后的局部光源数（真实 + 虚拟）与合并掉的光源数（仅设置 LightAggregator 时） */
+    uint32_t localLights = 0;
+    uint32_t aggregatedLights = 0;
+
+    /** 本帧新进入阴影光源选择的光源数（仅设置 ShadowLightSelector 时） */
+    uint32_t shadowLightChanges = 0;
+
+    /** 空闲检测的结果（非 Render 时本帧没有执行任何渲染阶段） */
+    IdleFrameAction idleAction = IdleFrameAction::Render;
+};
+
+/**
+ * @brief 多相机帧中的一个视图
+ */
+struct NullCameraView {
+    Matrix4 viewMatrix = Matrix4(1.0f);
+    Matrix4 projectionMatrix = Matrix4(1.0f);
+
+    /** 渲染顺序（同 Camera::getDepth，小的先渲染） */
+    int depth = 0;
+};
+
+/**
+ * @brief 空后端帧运行器
+ */
+class NullFrameRunner {
+public:
+    /**
+     * @param scene 生成的场景（对象写入内部组件存储）
+     * @param width 渲染目标宽度
+     * @param height 渲染目标高度
+     */
+    explicit NullFrameRunner(const GeneratedScene& scene,
+                             uint32_t width = 1920,
+                             uint32_t height = 1080);
+
+    /**
+     * @brief 添加 Feature（按 RenderPassEvent 和 order 执行）
+     */
+    void addFeature(std::unique_ptr<IRenderFeature> feature);
+
+    /**
+     * @brief 执行一帧
+     * @param camera 相机关键帧
+     * @param deltaTime 帧间隔（秒）
+     * @return 本帧统计
+     */
+    const NullFrameStats& renderFrame(const CameraKeyframe& camera, float deltaTime = 1.0f / 60.0f);
+
+    /**
+     * @brief 使用给定的相机矩阵执行一帧
+     */
+    const NullFrameStats& renderFrame(const Matrix4& viewMatrix,
+                                      const Matrix4& projectionMatrix,
+                                      const Vector3& cameraPosition,
+                                      float deltaTime);
+
+    /**
+     * @brief 执行一帧多相机渲染
+     *
+     * 所有相机共享一次场景遍历和剔除，阴影贴图按 MultiCameraSettings 在相近相机间共享。
+     * 统计中的可见对象数和各队列对象数为所有相机之和
+     *
+     * @param views 视图（按下标跟踪各自的上一帧矩阵），最多 MultiCameraCuller::MaxCameras 个
+     */
+    const NullFrameStats& renderFrame(const NullCameraView* views, uint32_t viewCount, float deltaTime);
+
+    /**
+     * @brief 执行一帧模拟的单遍立体渲染
+     *
+     * 两眼合并剔除、按中心眼排序一次，每个对象只录制一次绘制（depth 字段被忽略）。
+     * 这里假设后端用 multiview 通道把每次绘制广播到两眼，但并没有创建该通道
+     */
+    const NullFrameStats& renderStereoFrame(const NullCameraView& left, const NullCameraView& right,
+                                            float deltaTime);
+
+    /**
+     * @brief 应用捕获帧的输入（对象、光照、阴影、Feature、分辨率和开关）
+     *
+     * 之后调用 renderCapturedFrame 执行该帧
+     */
+    void applyCapture(const CapturedFrame& frame);
+
+    /**
+     * @brief 应用并执行一帧捕获
+     */
+    const NullFrameStats& renderCapturedFrame(const CapturedFrame& frame);
+
+    // ========================================================================
+    // 访问
+    // ========================================================================
+
+    RenderableStorage& getStorage() { return storage_; }
+    RenderQueueManager& getQueueManager() { return queueManager_; }
+    RenderFeatureManager& getFeatureManager() { return featureManager_; }
+    const RenderingData& getRenderingData() const { return renderingData_; }
+    const Frustum& getFrustum() const { return cameraSnapshot_.frustum; }
+    const CameraSnapshot& getCameraSnapshot() const { return cameraSnapshot_; }
+    const StereoSnapshot& getStereoSnapshot() const { return stereoSnapshot_; }
+    MultiCameraCuller& getMultiCameraCuller() { return multiCameraCuller_; }
+    const NullFrameStats& getStats() const { return stats_; }
+    const RenderStatsCollector& getRenderStats() const { return renderStats_; }
+    RenderStatsCollector& getRenderStats() { return renderStats_; }
+
+    void setShadowSettings(const ShadowSettings& settings) { shadowSettings_ = settings; }
+
+    /**
+     * @brief 设置 GPU 分析器（可为 nullptr，不转移所有权）
+     */
+    void setGpuProfiler(GpuProfiler* profiler);
+
+    /**
+     * @brief 设置帧捕获写入器（可为 nullptr，不转移所有权）
+     */
+    void setFrameCapture(FrameCaptureWriter* capture) { capture_ = capture; }
+
+    /**
+     * @brief 设置次级相机调度器（可为 nullptr，不转移所有权）
+     *
+     * 调用者在每帧渲染前调用 schedule()，把本帧的更新作为视图传给多相机 renderFrame
+     */
+    void setSecondaryCameraScheduler(const SecondaryCameraScheduler* scheduler) { secondaryCameras_ = scheduler; }
+
+    /**
+     * @brief 最新相机输入的采样函数，返回 false 表示没有新的输入
+     */
+    using CameraInputSampler = std::function<bool(CameraInputSample&)>;
+
+    /**
+     * @brief 设置后期锁存（可为 nullptr，不转移所有权；只作用于单相机帧）
+     *
+     * PrepareRendering 用带余量的视锥体剔除并写入本帧槽位，帧结束（提交）前调用 sampler 并锁存
+     */
+    void setLateLatch(LateLatchBuffer* lateLatch, CameraInputSampler sampler = nullptr) {
+        lateLatch_ = lateLatch;
+        inputSampler_ = std::move(sampler);
+    }
+
+    /**
+     * @brief 设置空闲帧检测器（可为 nullptr，不转移所有权；只作用于单相机帧）
+     *
+     * 每帧的 CPU 开销反馈给检测器，用于估算空闲帧节省的时间
+     */
+    void setIdleFrameDetector(IdleFrameDetector* detector) { idleDetector_ = detector; }
+
+    /**
+     * @brief 设置光源聚合器（可为 nullptr，不转移所有权；只作用于单相机帧）
+     */
+    void setLightAggregator(LightAggregator* aggregator) { lightAggregator_ = aggregator; }
+
+    /**
+     * @brief 设置阴影光源选择器（可为 nullptr，不转移所有权；只作用于单相机帧）
+     */
+    void setShadowLightSelector(ShadowLightSelector* selector) { shadowSelector_ = selector; }
+
+    /** 正在播放的动画数（传给空闲检测） */
+    void setActiveAnimations(uint32_t count) { activeAnimations_ = count; }
+
+    /** 最近一次多相机帧中视图 index（传入下标）的 CPU 耗时（毫秒），未渲染时为0 */
+    float getViewCpuMs(uint32_t index) const { return index < viewCpuMs_.size() ? viewCpuMs_[index] : 0.0f; }
+
+    /** applyCapture 中找不到同名 Feature 的数量（最近一次） */
+    uint32_t getMissingCapturedFeatures() const { return missingFeatures_; }
+
+private:
+    void* beginFrame();
+    void endFrame(void* cmd);
+
+    CameraSnapshotParams makeSnapshotParams(const Matrix4& viewMatrix, const Matrix4& projectionMatrix) const;
+    void setCameraData(const CameraSnapshot& snapshot);
+    void prepareRendering(const Matrix4& viewMatrix, const Matrix4& projectionMatrix,
+                          const Vector3& cameraPosition, float deltaTime);
+
+    /** 执行一个相机的所有 Pass（队列已构建并排序） */
+    void renderCamera(void* cmd, bool renderShadowMaps);
+    void renderShadows();
+    void renderQueue(const RenderQueue* queue, RenderStatsPass pass, uint32_t& objectCount);
+
+    RenderableStorage storage_;
+    LightingData lightingData_;
+    ShadowSettings shadowSettings_;
+    ShadowAtlas shadowAtlas_;
+    TaggedVector<uint32_t, MemoryTag::Shadows> shadowCasters_;
+    RenderQueueManager queueManager_;
+    RenderingData renderingData_;
+    CameraSnapshot cameraSnapshot_;
+    MultiCameraCuller multiCameraCuller_;
+    std::vector<CameraSnapshot> viewSnapshots_;
+    StereoSnapshot stereoSnapshot_;
+    std::vector<float> viewCpuMs_;
+    const SecondaryCameraScheduler* secondaryCameras_ = nullptr;
+    LateLatchBuffer* lateLatch_ = nullptr;
+    CameraInputSampler inputSampler_;
+    bool lateLatchPending_ = false;
+    IdleFrameDetector* idleDetector_ = nullptr;
+    LightAggregator* lightAggregator_ = nullptr;
+
+    /** 聚合后的光源列表（每帧由 lightingData_ 复制后替换局部光源） */
+    LightingData aggregatedLighting_;
+    ShadowLightSelector* shadowSelector_ = nullptr;
+
+    /** 本帧阴影光源选择使用的光源列表 */
+    const LightingData* shadowLighting_ = nullptr;
+    bool shadowSelectionPending_ = false;
+    uint32_t activeAnimations_ = 0;
+
+    NullRenderContext context_;
+    RenderFeatureManager featureManager_;
+    GpuProfiler* gpuProfiler_ = nullptr;
+    FrameCaptureWriter* capture_ = nullptr;
+    CapturePlayback playback_;
+    uint32_t missingFeatures_ = 0;
+
+    NullFrameStats stats_;
+    RenderStatsCollector renderStats_;
+    uint64_t frameNumber_ = 0;
+
+    /** beginFrame 的时刻（RenderStats 的 CPU 帧耗时） */
+    std::chrono::steady_clock::time_point frameStart_;
+};
@@ -0,0 +1,543 @@
+/**
+ * @file PerfCompare.cpp
+ * @brief 性能基线比较工具 - 用 Mann-Whitney U 检验判断回归
+ *
+ * 用法:
+ *   BasicPipelinePerfCompare <baseline.json> <current.json>
+ *       [--alpha 0.01] [--tolerance 0.05] [--tolerances perf_tolerances.txt]
+ *       [--report report.md] [--fail-on-missing]
+ *
+ * 输入为 BasicPipelineBenchmarks / BasicPipelineReplay 的 --json 输出（schema 1），
+ * 按 (name, count) 配对，对两组原始采样做单侧 Mann-Whitney U 检验:
+ * - 回归: p < alpha 且中位数变慢超过该指标的容差
+ * - 改进: p < alpha 且中位数变快超过容差
+ * - 其余视为噪声内
+ *
+ * 容差文件每行 "<模式> <相对容差>"，模式支持 '*' 通配，按顺序第一条匹配生效，
+ * '#' 开头为注释。没有匹配时使用 --tolerance
+ *
+ * 退出码: 0 无回归，1 有显著回归，2 参数或输入错误
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// ============================================================================
+// JSON（只支持基准结果需要的子集）
+// ============================================================================
+
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    const JsonValue* find(const char* key) const {
+        for (const auto& [k, v] : object) {
+            if (k == key) return &v;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : p_(text.c_str()), end_(p_ + text.size()) {}
+
+    bool parse(JsonValue& out) {
+        return parseValue(out) && (skipSpace(), p_ == end_);
+    }
+
+private:
+    void skipSpace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+    }
+
+    bool match(const char* literal) {
+        const size_t n = std::strlen(literal);
+        if (static_cast<size_t>(end_ - p_) < n || std::strncmp(p_, literal, n) != 0) return false;
+        p_ += n;
+        return true;
+    }
+
+    bool parseValue(JsonValue& v) {
+        skipSpace();
+        if (p_ >= end_) return false;
+
+        switch (*p_) {
+            case '{': return parseObject(v);
+            case '[': return parseArray(v);
+            case '"': v.type = JsonValue::Type::String; return parseString(v.string);
+            case 't': v.type = JsonValue::Type::Bool; v.boolean = true; return match("true");
+            case 'f': v.type = JsonValue::Type::Bool; v.boolean = false; return match("false");
+            case 'n': v.type = JsonValue::Type::Null; return match("null");
+            default: break;
+        }
+
+        char* numberEnd = nullptr;
+        v.type = JsonValue::Type::Number;
+        v.number = std::strtod(p_, &numberEnd);
+        if (numberEnd == p_) return false;
+        p_ = numberEnd;
+        return true;
+    }
+
+    bool parseString(std::string& s) {
+        ++p_;  // '"'
+        s.clear();
+        while (p_ < end_ && *p_ != '"') {
+            if (*p_ == '\\' && p_ + 1 < end_) {
+                ++p_;
+                switch (*p_) {
+                    case 'n': s += '\n'; break;
+                    case 't': s += '\t'; break;
+                    case 'u': s += '?'; p_ += std::min<std::ptrdiff_t>(4, end_ - p_ - 1); break;
+                    default: s += *p_; break;
+                }
+                ++p_;
+            } else {
+                s += *p_++;
+            }
+        }
+        if (p_ >= end_) return false;
+        ++p_;
+        return true;
+    }
+
+    bool parseArray(JsonValue& v) {
+        v.type = JsonValue::Type::Array;
+        ++p_;
+        skipSpace();
+        if (p_ < end_ && *p_ == ']') { ++p_; return true; }
+        for (;;) {
+            v.array.emplace_back();
+            if (!parseValue(v.array.back())) return false;
+            skipSpace();
+            if (p_ < end_ && *p_ == ',') { ++p_; continue; }
+            if (p_ < end_ && *p_ == ']') { ++p_; return true; }
+            return false;
+        }
+    }
+
+    bool parseObject(JsonValue& v) {
+        v.type = JsonValue::Type::Object;
+        ++p_;
+        skipSpace();
+        if (p_ < end_ && *p_ == '}') { ++p_; return true; }
+        for (;;) {
+            skipSpace();
+            std::string key;
+            if (p_ >= end_ || *p_ != '"' || !parseString(key)) return false;
+            skipSpace();
+            if (p_ >= end_ || *p_ != ':') return false;
+            ++p_;
+            v.object.emplace_back(std::move(key), JsonValue());
+            if (!parseValue(v.object.back().second)) return false;
+            skipSpace();
+            if (p_ < end_ && *p_ == ',') { ++p_; continue; }
+            if (p_ < end_ && *p_ == '}') { ++p_; return true; }
+            return false;
+        }
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+// ============================================================================
+// 结果
+// ============================================================================
+
+struct CaseResult {
+    std::string name;
+    size_t count = 0;
+    std::vector<double> samples;
+};
+
+using CaseKey = std::pair<std::string, size_t>;
+
+bool loadResults(const std::string& path, std::map<CaseKey, CaseResult>& out) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        std::fprintf(stderr, "无法读取 %s\n", path.c_str());
+        return false;
+    }
+    std::string text;
+    char chunk[65536];
+    size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        text.append(chunk, n);
+    }
+    std::fclose(f);
+
+    JsonValue root;
+    if (!JsonParser(text).parse(root) || root.type != JsonValue::Type::Object) {
+        std::fprintf(stderr, "%s 不是有效的JSON\n", path.c_str());
+        return false;
+    }
+    const JsonValue* schema = root.find("schema");
+    if (!schema || schema->number != 1.0) {
+        std::fprintf(stderr, "%s: 不支持的 schema\n", path.c_str());
+        return false;
+    }
+    const JsonValue* results = root.find("results");
+    if (!results || results->type != JsonValue::Type::Array) {
+        std::fprintf(stderr, "%s: 缺少 results\n", path.c_str());
+        return false;
+    }
+
+    for (const auto& r : results->array) {
+        const JsonValue* name = r.find("name");
+        const JsonValue* count = r.find("count");
+        const JsonValue* samples = r.find("samples");
+        if (!name || !count || !samples) continue;
+
+        CaseResult result;
+        result.name = name->string;
+        result.count = static_cast<size_t>(count->number);
+        for (const auto& s : samples->array) {
+            result.samples.push_back(s.number);
+        }
+        out[{result.name, result.count}] = std::move(result);
+    }
+    return true;
+}
+
+// ============================================================================
+// 统计
+// ============================================================================
+
+double median(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const size_t mid = v.size() / 2;
+    return v.size() % 2 ? v[mid] : 0.5 * (v[mid - 1] + v[mid]);
+}
+
+/**
+ * @brief 单侧 Mann-Whitney U 检验
+ *
+ * H1: current 的分布大于 baseline（变慢）
+ * 样本少且没有并列值时用精确分布，否则用带并列修正和连续性修正的正态近似
+ *
+ * @return p 值
+ */
+double mannWhitneyGreater(const std::vector<double>& baseline, const std::vector<double>& current) {
+    const size_t n1 = current.size();
+    const size_t n2 = baseline.size();
+    if (n1 == 0 || n2 == 0) {
+        return 1.0;
+    }
+
+    // 合并排序并计算平均秩
+    std::vector<std::pair<double, int>> all;
+    all.reserve(n1 + n2);
+    for (double v : current) all.emplace_back(v, 0);
+    for (double v : baseline) all.emplace_back(v, 1);
+    std::sort(all.begin(), all.end());
+
+    double rankSumCurrent = 0.0;
+    double tieTerm = 0.0;
+    for (size_t i = 0; i < all.size();) {
+        size_t j = i;
+        while (j < all.size() && all[j].first == all[i].first) ++j;
+        const double rank = 0.5 * static_cast<double>(i + 1 + j);
+        for (size_t k = i; k < j; ++k) {
+            if (all[k].second == 0) rankSumCurrent += rank;
+        }
+        const double t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    const double u = rankSumCurrent - static_cast<double>(n1 * (n1 + 1)) / 2.0;
+
+    // 精确分布：count[k] = 秩和对应 U = k 的排列数
+    if (tieTerm == 0.0 && n1 <= 20 && n2 <= 20) {
+        const size_t maxU = n1 * n2;
+        // dp[i][j][u]：i 个 current、j 个 baseline 时 U = u 的组合数，按 j 滚动
+        std::vector<std::vector<double>> prev(n1 + 1, std::vector<double>(maxU + 1, 0.0));
+        for (size_t i = 0; i <= n1; ++i) prev[i][0] = 1.0;
+        for (size_t j = 1; j <= n2; ++j) {
+            std::vector<std::vector<double>> cur(n1 + 1, std::vector<double>(maxU + 1, 0.0));
+            cur[0][0] = 1.0;
+            for (size_t i = 1; i <= n1; ++i) {
+                for (size_t k = 0; k <= i * j; ++k) {
+                    // 最大元素属于 current 时它比 j 个 baseline 都大，贡献 j
+                    double ways = prev[i][k];
+                    if (k >= j) ways += cur[i - 1][k - j];
+                    cur[i][k] = ways;
+                }
+            }
+            prev.swap(cur);
+        }
+        const std::vector<double>& dist = prev[n1];
+        double total = 0.0, tail = 0.0;
+        const size_t uInt = static_cast<size_t>(u + 0.5);
+        for (size_t k = 0; k <= maxU; ++k) {
+            total += dist[k];
+            if (k >= uInt) tail += dist[k];
+        }
+        return total > 0.0 ? tail / total : 1.0;
+    }
+
+    const double n = static_cast<double>(n1 + n2);
+    const double mean = static_cast<double>(n1 * n2) / 2.0;
+    const double variance = static_cast<double>(n1 * n2) / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    const double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// ============================================================================
+// 容差
+// ============================================================================
+
+struct ToleranceRule {
+    std::string pattern;
+    double tolerance;
+};
+
+bool globMatch(const char* pattern, const char* text) {
+    if (*pattern == '\0') return *text == '\0';
+    if (*pattern == '*') {
+        for (const char* t = text;; ++t) {
+            if (globMatch(pattern + 1, t)) return true;
+            if (*t == '\0') return false;
+        }
+    }
+    return *text != '\0' && *pattern == *text && globMatch(pattern + 1, text + 1);
+}
+
+bool loadTolerances(const std::string& path, std::vector<ToleranceRule>& rules) {
+    FILE* f = std::fopen(path.c_str(), "r");
+    if (!f) {
+        std::fprintf(stderr, "无法读取 %s\n", path.c_str());
+        return false;
+    }
+    char line[512];
+    while (std::fgets(line, sizeof(line), f)) {
+        char pattern[400];
+        double tolerance = 0.0;
+        if (line[0] == '#' || std::sscanf(line, "%399s %lf", pattern, &tolerance) != 2) {
+            continue;
+        }
+        rules.push_back({pattern, tolerance});
+    }
+    std::fclose(f);
+    return true;
+}
+
+double toleranceFor(const std::string& name, const std::vector<ToleranceRule>& rules, double fallback) {
+    for (const auto& rule : rules) {
+        if (globMatch(rule.pattern.c_str(), name.c_str())) {
+            return rule.tolerance;
+        }
+    }
+    return fallback;
+}
+
+// ============================================================================
+// 比较
+// ============================================================================
+
+enum class Verdict { Unchanged, Regression, Improvement, Missing, New };
+
+const char* verdictName(Verdict v) {
+    switch (v) {
+        case Verdict::Unchanged:   return "ok";
+        case Verdict::Regression:  return "REGRESSION";
+        case Verdict::Improvement: return "improved";
+        case Verdict::Missing:     return "missing";
+        case Verdict::New:         return "new";
+    }
+    return "?";
+}
+
+struct Comparison {
+    std::string name;
+    size_t count = 0;
+    double baselineMedian = 0.0;
+    double currentMedian = 0.0;
+    double change = 0.0;
+    double pSlower = 1.0;
+    double pFaster = 1.0;
+    double tolerance = 0.0;
+    Verdict verdict = Verdict::Unchanged;
+};
+
+struct CompareConfig {
+    std::string baselinePath;
+    std::string currentPath;
+    std::string tolerancePath;
+    std::string reportPath;
+    double alpha = 0.01;
+    double defaultTolerance = 0.05;
+    bool failOnMissing = false;
+};
+
+bool parseArgs(int argc, char** argv, CompareConfig& config) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--alpha") && hasValue) {
+            config.alpha = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--tolerance") && hasValue) {
+            config.defaultTolerance = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--tolerances") && hasValue) {
+            config.tolerancePath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--report") && hasValue) {
+            config.reportPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--fail-on-missing")) {
+            config.failOnMissing = true;
+        } else if (argv[i][0] != '-') {
+            positional.push_back(argv[i]);
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (positional.size() != 2) {
+        return false;
+    }
+    config.baselinePath = positional[0];
+    config.currentPath = positional[1];
+    return true;
+}
+
+void writeReport(FILE* f, const std::vector<Comparison>& comparisons, const CompareConfig& config,
+                 bool markdown) {
+    if (markdown) {
+        std::fprintf(f, "# 性能比较\n\n基线: `%s`  当前: `%s`  alpha = %.3g\n\n",
+                     config.baselinePath.c_str(), config.currentPath.c_str(), config.alpha);
+        std::fprintf(f, "| 结果 | 用例 | 数量 | 基线中位数 | 当前中位数 | 变化 | 容差 | p |\n");
+        std::fprintf(f, "|---|---|---:|---:|---:|---:|---:|---:|\n");
+    } else {
+        std::printf("%-11s %-48s %8s %14s %14s %9s %7s %9s\n",
+                    "result", "benchmark", "count", "base(ns)", "current(ns)", "change", "tol", "p");
+    }
+
+    for (const auto& c : comparisons) {
+        const double p = c.change >= 0.0 ? c.pSlower : c.pFaster;
+        if (markdown) {
+            std::fprintf(f, "| %s | %s | %zu | %.1f | %.1f | %+.1f%% | %.0f%% | %.2g |\n",
+                         verdictName(c.verdict), c.name.c_str(), c.count, c.baselineMedian,
+                         c.currentMedian, c.change * 100.0, c.tolerance * 100.0, p);
+        } else {
+            std::fprintf(f, "%-11s %-48s %8zu %14.1f %14.1f %+8.1f%% %6.0f%% %9.2g\n",
+                         verdictName(c.verdict), c.name.c_str(), c.count, c.baselineMedian,
+                         c.currentMedian, c.change * 100.0, c.tolerance * 100.0, p);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CompareConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        std::fprintf(stderr,
+                     "用法: %s <baseline.json> <current.json> [--alpha A] [--tolerance T]\n"
+                     "         [--tolerances file] [--report report.md] [--fail-on-missing]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::map<CaseKey, CaseResult> baseline, current;
+    std::vector<ToleranceRule> rules;
+    if (!loadResults(config.baselinePath, baseline) || !loadResults(config.currentPath, current)) {
+        return 2;
+    }
+    if (!config.tolerancePath.empty() && !loadTolerances(config.tolerancePath, rules)) {
+        return 2;
+    }
+
+    std::vector<Comparison> comparisons;
+    for (const auto& [key, base] : baseline) {
+        Comparison c;
+        c.name = key.first;
+        c.count = key.second;
+        c.tolerance = toleranceFor(c.name, rules, config.defaultTolerance);
+        c.baselineMedian = median(base.samples);
+
+        auto it = current.find(key);
+        if (it == current.end()) {
+            c.verdict = Verdict::Missing;
+            comparisons.push_back(c);
+            continue;
+        }
+
+        const CaseResult& cur = it->second;
+        c.currentMedian = median(cur.samples);
+        c.change = c.baselineMedian > 0.0 ? c.currentMedian / c.baselineMedian - 1.0 : 0.0;
+        c.pSlower = mannWhitneyGreater(base.samples, cur.samples);
+        c.pFaster = mannWhitneyGreater(cur.samples, base.samples);
+
+        if (c.pSlower < config.alpha && c.change > c.tolerance) {
+            c.verdict = Verdict::Regression;
+        } else if (c.pFaster < config.alpha && -c.change > c.tolerance) {
+            c.verdict = Verdict::Improvement;
+        }
+        comparisons.push_back(c);
+    }
+    for (const auto& [key, cur] : current) {
+        if (baseline.find(key) == baseline.end()) {
+            Comparison c;
+            c.name = key.first;
+            c.count = key.second;
+            c.currentMedian = median(cur.samples);
+            c.verdict = Verdict::New;
+            comparisons.push_back(c);
+        }
+    }
+
+    // 回归排在最前，其次按变化幅度
+    std::stable_sort(comparisons.begin(), comparisons.end(), [](const Comparison& a, const Comparison& b) {
+        const bool ra = a.verdict == Verdict::Regression;
+        const bool rb = b.verdict == Verdict::Regression;
+        if (ra != rb) return ra;
+        return a.change > b.change;
+    });
+
+    writeReport(stdout, comparisons, config, false);
+
+    uint32_t regressions = 0, improvements = 0, missing = 0;
+    for (const auto& c : comparisons) {
+        regressions += c.verdict == Verdict::Regression;
+        improvements += c.verdict == Verdict::Improvement;
+        missing += c.verdict == Verdict::Missing;
+    }
+    std::printf("\n%zu 个用例: %u 回归, %u 改进, %u 缺失\n",
+                comparisons.size(), regressions, improvements, missing);
+
+    if (!config.reportPath.empty()) {
+        FILE* f = std::fopen(config.reportPath.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "无法写入 %s\n", config.reportPath.c_str());
+            return 2;
+        }
+        writeReport(f, comparisons, config, true);
+        std::fclose(f);
+    }
+
+    if (regressions > 0 || (config.failOnMissing && missing > 0)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * @file SceneGenerator.cpp
+ * @brief 合成场景生成器实现
+ */
+
+#include "SceneGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr float kPi = 3.14159265359f;
+
+Vector3 catmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) {
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    return (p1 * 2.0f +
+            (p2 - p0) * t +
+            (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * t2 +
+            (p1 * 3.0f - p0 - p2 * 3.0f + p3) * t3) * 0.5f;
+}
+
+Matrix4 makeWorldMatrix(const Vector3& position, float scale) {
+    Matrix4 m(scale);
+    m[3] = Vector4(position, 1.0f);
+    return m;
+}
+
+/** 按城市网格把位置吸附到街区内 */
+Vector3 snapToBlock(float u, float v, float height, const SceneGenConfig& config) {
+    const float cell = config.blockSize + config.streetWidth;
+    const float x = std::floor(u / cell) * cell + config.streetWidth * 0.5f +
+                    std::fmod(std::fabs(u), config.blockSize);
+    const float z = std::floor(v / cell) * cell + config.streetWidth * 0.5f +
+                    std::fmod(std::fabs(v), config.blockSize);
+    return Vector3(x, height, z);
+}
+
+} // namespace
+
+// ============================================================================
+// 场景生成
+// ============================================================================
+
+GeneratedScene SceneGenerator::generate(const SceneGenConfig& config) {
+    GeneratedScene scene;
+    scene.config = config;
+    scene.renderables.reserve(config.objectCount);
+
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> world(-config.worldExtent, config.worldExtent);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    // 聚簇中心
+    std::vector<Vector3> clusters;
+    if (config.distribution == SceneDistribution::Clustered) {
+        const uint32_t clusterCount = std::max(config.clusterCount, 1u);
+        for (uint32_t i = 0; i < clusterCount; ++i) {
+            clusters.emplace_back(world(rng), 0.0f, world(rng));
+        }
+    }
+
+    for (uint32_t i = 0; i < config.objectCount; ++i) {
+        RenderableDesc desc;
+        const float radius = config.minRadius + (config.maxRadius - config.minRadius) * unit(rng);
+
+        switch (config.distribution) {
+            case SceneDistribution::Uniform:
+                desc.center = Vector3(world(rng), radius + unit(rng) * 20.0f, world(rng));
+                break;
+
+            case SceneDistribution::Clustered: {
+                const Vector3& c = clusters[rng() % clusters.size()];
+                desc.center = Vector3(c.x + gaussian(rng) * config.clusterRadius,
+                                      radius + std::fabs(gaussian(rng)) * 5.0f,
+                                      c.z + gaussian(rng) * config.clusterRadius);
+                break;
+            }
+
+            case SceneDistribution::CityGrid: {
+                // 高度偏向低层建筑，少量高楼
+                const float h = unit(rng);
+                const float height = radius + h * h * h * 120.0f;
+                desc.center = snapToBlock(world(rng), world(rng), height, config);
+                break;
+            }
+        }
+
+        desc.radius = radius;
+        desc.worldMatrix = makeWorldMatrix(desc.center, radius);
+        desc.materialID = config.materialCount > 0 ? (rng() % config.materialCount) : 0;
+        desc.name = "Synthetic";
+
+        const float q = unit(rng);
+        if (q < config.transparentFraction) {
+            desc.queueID = RenderQueueId::Transparent;
+            desc.depthState.depthWriteEnable = false;
+        } else if (q < config.transparentFraction + config.alphaTestFraction) {
+            desc.queueID = RenderQueueId::AlphaTest;
+        } else {
+            desc.queueID = RenderQueueId::Opaque;
+        }
+
+        desc.flags = RenderableFlags::Default;
+        if (unit(rng) < config.staticFraction) {
+            desc.flags |= RenderableFlags::Static;
+        }
+        if (desc.queueID == RenderQueueId::Transparent) {
+            desc.flags &= ~static_cast<uint32_t>(RenderableFlags::CastShadows);
+        }
+
+        scene.renderables.push_back(desc);
+    }
+
+    // 光源: 一个定向光 + 若干局部光源
+    scene.lighting.addLight(LightData::createDirectional(Vector3(-0.3f, -1.0f, -0.4f),
+                                                         Vector3(1.0f, 0.96f, 0.9f), 2.0f));
+    scene.lighting.directionalLights.back().castShadows = true;
+
+    for (uint32_t i = 0; i < config.lightCount; ++i) {
+        const Vector3 position(world(rng), 2.0f + unit(rng) * 10.0f, world(rng));
+        const Vector3 color(0.5f + 0.5f * unit(rng), 0.5f + 0.5f * unit(rng), 0.5f + 0.5f * unit(rng));
+        const float range = 5.0f + unit(rng) * 25.0f;
+        const float intensity = 0.5f + unit(rng) * 4.0f;
+
+        LightData light = unit(rng) < config.spotLightFraction
+            ? LightData::createSpot(position, Vector3(0.0f, -1.0f, 0.0f), 20.0f, 35.0f, range, color, intensity)
+            : LightData::createPoint(position, range, color, intensity);
+        light.castShadows = unit(rng) < config.shadowCasterFraction;
+        scene.lighting.addLight(light);
+    }
+
+    return scene;
+}
+
+void GeneratedScene::fillStorage(RenderableStorage& storage) const {
+    storage.clear();
+    storage.reserve(renderables.size());
+    for (const auto& desc : renderables) {
+        storage.create(desc);
+    }
+}
+
+std::vector<RenderObject> GeneratedScene::makeRenderObjects(const Vector3& cameraPosition) const {
+    std::vector<RenderObject> objects;
+    objects.reserve(renderables.size());
+
+    for (const auto& desc : renderables) {
+        RenderObject obj;
+        obj.name = desc.name;
+        obj.worldMatrix = desc.worldMatrix;
+        obj.center = desc.center;
+        obj.radius = desc.radius;
+        obj.material = desc.material;
+        obj.materialID = desc.materialID;
+        obj.geometryHandle = desc.geometryHandle;
+        obj.subMeshIndex = desc.subMeshIndex;
+        obj.queueID = desc.queueID;
+        obj.depthState = desc.depthState;
+        obj.stencilState = desc.stencilState;
+        obj.distanceToCamera = glm::length(desc.center - cameraPosition);
+        objects.push_back(obj);
+    }
+    return objects;
+}
+
+// ============================================================================
+// 相机路径
+// ============================================================================
+
+CameraPath SceneGenerator::generateCameraPath(const SceneGenConfig& config,
+                                              CameraPathType type,
+                                              uint32_t keyframeCount) {
+    CameraPath path;
+    path.loop = true;
+
+    // 路径使用独立的随机流，不影响场景内容
+    std::mt19937 rng(config.seed ^ 0x9E3779B9u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const uint32_t count = std::max(keyframeCount, 4u);
+    const float extent = config.worldExtent;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(count);
+        CameraKeyframe key;
+
+        switch (type) {
+            case CameraPathType::Orbit: {
+                const float angle = t * 2.0f * kPi;
+                key.position = Vector3(std::cos(angle) * extent * 0.8f,
+                                       extent * 0.25f,
+                                       std::sin(angle) * extent * 0.8f);
+                key.target = Vector3(0.0f);
+                break;
+            }
+
+            case CameraPathType::Flythrough:
+                key.position = Vector3((unit(rng) * 2.0f - 1.0f) * extent * 0.7f,
+                                       5.0f + unit(rng) * 40.0f,
+                                       (unit(rng) * 2.0f - 1.0f) * extent * 0.7f);
+                key.target = Vector3((unit(rng) * 2.0f - 1.0f) * extent * 0.5f,
+                                     0.0f,
+                                     (unit(rng) * 2.0f - 1.0f) * extent * 0.5f);
+                break;
+
+            case CameraPathType::StreetLevel: {
+                // 沿街道中线走矩形回路，视线沿行进方向
+                const float cell = config.blockSize + config.streetWidth;
+                const float half = std::floor(extent * 0.5f / cell) * cell;
+                const float s = t * 4.0f;
+                const int side = static_cast<int>(s);
+                const float f = s - static_cast<float>(side);
+                const float a = -half + 2.0f * half * f;
+                const Vector3 corners[4] = {
+                    Vector3(a, 1.8f, -half), Vector3(half, 1.8f, a),
+                    Vector3(-a, 1.8f, half), Vector3(-half, 1.8f, -a)};
+                const Vector3 dirs[4] = {
+                    Vector3(1, 0, 0), Vector3(0, 0, 1), Vector3(-1, 0, 0), Vector3(0, 0, -1)};
+                key.position = corners[side & 3];
+                key.target = key.position + dirs[side & 3] * 10.0f;
+                key.fieldOfView = 70.0f;
+                break;
+            }
+        }
+
+        path.keyframes.push_back(key);
+    }
+
+    return path;
+}
+
+CameraKeyframe CameraPath::sample(float t) const {
+    if (keyframes.empty()) {
+        return CameraKeyframe{};
+    }
+    if (keyframes.size() == 1) {
+        return keyframes[0];
+    }
+
+    const int n = static_cast<int>(keyframes.size());
+    const int segments = loop ? n : n - 1;
+
+    t = loop ? t - std::floor(t) : std::clamp(t, 0.0f, 1.0f);
+    const float s = t * static_cast<float>(segments);
+    const int i = std::min(static_cast<int>(s), segments - 1);
+    const float f = s - static_cast<float>(i);
+
+    auto at = [&](int k) -> const CameraKeyframe& {
+        if (loop) {
+            return keyframes[((k % n) + n) % n];
+        }
+        return keyframes[std::clamp(k, 0, n - 1)];
+    };
+
+    const CameraKeyframe& k0 = at(i - 1);
+    const CameraKeyframe& k1 = at(i);
+    const CameraKeyframe& k2 = at(i + 1);
+    const CameraKeyframe& k3 = at(i + 2);
+
+    CameraKeyframe result;
+    result.position = catmullRom(k0.position, k1.position, k2.position, k3.position, f);
+    result.target = catmullRom(k0.target, k1.target, k2.target, k3.target, f);
+    result.fieldOfView = k1.fieldOfView + (k2.fieldOfView - k1.fieldOfView) * f;
+    return result;
+}
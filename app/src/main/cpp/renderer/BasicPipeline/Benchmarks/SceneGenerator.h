@@ -0,0 +1,183 @@
+/**
+ * @file SceneGenerator.h
+ * @brief 合成场景生成器 - 可复现的、规模可控的基准测试场景
+ *
+ * 功能:
+ * - 固定种子，相同配置生成完全相同的场景
+ * - 对象数量 1k - 1M
+ * - 空间分布: 均匀 / 聚簇 / 城市网格
+ * - 材质多样性、透明比例、光源数量可配置
+ * - 生成脚本化的相机路径（环绕 / 飞越 / 街道）
+ */
+
+#pragma once
+
+#include "../RenderQueue.h"
+#include "../RenderableStorage.h"
+#include "../LightingData.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 空间分布
+ */
+enum class SceneDistribution {
+    /** 在世界范围内均匀分布 */
+    Uniform,
+
+    /** 围绕若干簇中心高斯分布（森林、人群） */
+    Clustered,
+
+    /** 沿街区网格排列，高度随机（城市） */
+    CityGrid
+};
+
+/**
+ * @brief 场景生成配置
+ */
+struct SceneGenConfig {
+    /** 随机种子 */
+    uint32_t seed = 1;
+
+    /** 对象数量 */
+    uint32_t objectCount = 10000;
+
+    /** 空间分布 */
+    SceneDistribution distribution = SceneDistribution::Uniform;
+
+    /** 世界范围（半边长，世界单位） */
+    float worldExtent = 500.0f;
+
+    /** 对象包围球半径范围 */
+    float minRadius = 0.5f;
+    float maxRadius = 4.0f;
+
+    // ========================================================================
+    // 聚簇分布
+    // ========================================================================
+
+    uint32_t clusterCount = 32;
+    float clusterRadius = 25.0f;
+
+    // ========================================================================
+    // 城市网格
+    // ========================================================================
+
+    /** 街区边长 */
+    float blockSize = 40.0f;
+
+    /** 街道宽度 */
+    float streetWidth = 12.0f;
+
+    // ========================================================================
+    // 材质与队列
+    // ========================================================================
+
+    /** 不同材质的数量 */
+    uint32_t materialCount = 64;
+
+    /** 透明对象比例 (0-1) */
+    float transparentFraction = 0.1f;
+
+    /** Alpha Test 对象比例 (0-1) */
+    float alphaTestFraction = 0.05f;
+
+    /** 静态对象比例 (0-1) */
+    float staticFraction = 0.8f;
+
+    // ========================================================================
+    // 光源
+    // ========================================================================
+
+    /** 点光源/聚光灯数量（另外固定有一个定向光） */
+    uint32_t lightCount = 16;
+
+    /** 聚光灯占比 (0-1) */
+    float spotLightFraction = 0.25f;
+
+    /** 投射阴影的光源比例 (0-1) */
+    float shadowCasterFraction = 0.25f;
+};
+
+/**
+ * @brief 相机路径类型
+ */
+enum class CameraPathType {
+    /** 围绕场景中心环绕 */
+    Orbit,
+
+    /** 穿过随机路点的平滑飞行 */
+    Flythrough,
+
+    /** 沿城市街道的行人视角 */
+    StreetLevel
+};
+
+/**
+ * @brief 相机关键帧
+ */
+struct CameraKeyframe {
+    Vector3 position;
+    Vector3 target;
+    float fieldOfView = 60.0f;
+};
+
+/**
+ * @brief 脚本化相机路径
+ *
+ * 关键帧之间使用 Catmull-Rom 插值
+ */
+struct CameraPath {
+    std::vector<CameraKeyframe> keyframes;
+    bool loop = true;
+
+    /**
+     * @brief 按归一化时间采样
+     * @param t 0-1
+     */
+    CameraKeyframe sample(float t) const;
+};
+
+/**
+ * @brief 生成的场景
+ */
+struct GeneratedScene {
+    SceneGenConfig config;
+
+    /** 与 RenderableStorage 内容一一对应的描述 */
+    std::vector<RenderableDesc> renderables;
+
+    /** 光源 */
+    LightingData lighting;
+
+    /**
+     * @brief 把所有对象写入组件存储
+     */
+    void fillStorage(RenderableStorage& storage) const;
+
+    /**
+     * @brief 转换为 RenderObject 列表（距离相对于给定位置）
+     */
+    std::vector<RenderObject> makeRenderObjects(const Vector3& cameraPosition) const;
+};
+
+/**
+ * @brief 合成场景生成器
+ */
+class SceneGenerator {
+public:
+    /**
+     * @brief 生成场景
+     */
+    static GeneratedScene generate(const SceneGenConfig& config);
+
+    /**
+     * @brief 生成相机路径
+     * @param config 场景配置（决定路径覆盖范围）
+     * @param type 路径类型
+     * @param keyframeCount 关键帧数量
+     */
+    static CameraPath generateCameraPath(const SceneGenConfig& config,
+                                         CameraPathType type,
+                                         uint32_t keyframeCount = 16);
+};
@@ -0,0 +1,170 @@
+/**
+ * @file TestHarness.h
+ * @brief 单元测试框架 - 用例注册、断言与失败计数（与 BenchmarkHarness.h 同样只有头文件）
+ *
+ * 用法:
+ * @code
+ *
+ * TEST_CASE("ScreenProjection.batchMatchesScalar") {
+ *     CHECK(flags[i] == expectedFlags);
+ *     CHECK_NEAR(batch.x[i], scalar.x, 1e-4f);
+ * }
+ *
+ * int main(int argc, char** argv) {
+ *     return test::runMain(argc, argv);
+ * }
+ *
+ * @endcode
+ *
+ * 失败的断言打印 文件:行 与表达式，用例继续执行（一个用例可以报告多处失败）。
+ * 有失败时进程以 1 退出，ctest 据此判定
+ *
+ * 命令行参数:
+ * - --filter <子串>  只运行名称包含该子串的用例
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test {
+
+// ============================================================================
+// 用例定义
+// ============================================================================
+
+/**
+ * @brief 测试用例
+ */
+struct TestDef {
+    std::string name;
+    std::function<void()> body;
+};
+
+/**
+ * @brief 全局用例注册表
+ */
+inline std::vector<TestDef>& registry() {
+    static std::vector<TestDef> defs;
+    return defs;
+}
+
+/**
+ * @brief 注册用例（静态初始化期间调用）
+ */
+struct Registrar {
+    Registrar(const char* name, std::function<void()> body) {
+        registry().push_back({name, std::move(body)});
+    }
+};
+
+// ============================================================================
+// 断言
+// ============================================================================
+
+/**
+ * @brief 当前用例的失败数
+ */
+inline uint32_t& currentFailures() {
+    static uint32_t failures = 0;
+    return failures;
+}
+
+/** 同一用例最多打印的失败数（循环中的断言失败时避免刷屏） */
+constexpr uint32_t kMaxReportedFailures = 10;
+
+inline void reportFailure(const char* file, int line, const char* expression) {
+    if (++currentFailures() <= kMaxReportedFailures) {
+        std::fprintf(stderr, "  %s:%d: 失败: %s\n", file, line, expression);
+    }
+}
+
+inline bool checkNear(double actual, double expected, double tolerance, const char* file, int line,
+                      const char* expression) {
+    // NaN 与任何值比较都不成立，会被判为失败
+    if (std::fabs(actual - expected) <= tolerance) {
+        return true;
+    }
+    if (++currentFailures() <= kMaxReportedFailures) {
+        std::fprintf(stderr, "  %s:%d: 失败: %s (实际 %.9g, 期望 %.9g, 容差 %.3g)\n",
+                     file, line, expression, actual, expected, tolerance);
+    }
+    return false;
+}
+
+// ============================================================================
+// 入口
+// ============================================================================
+
+/**
+ * @brief 运行已注册的用例
+ * @return 进程退出码（有失败为 1，参数错误为 2）
+ */
+inline int runMain(int argc, char** argv) {
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            std::fprintf(stderr, "用法: %s [--filter 子串]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    uint32_t run = 0;
+    uint32_t failed = 0;
+    for (const auto& def : registry()) {
+        if (!filter.empty() && def.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        currentFailures() = 0;
+        def.body();
+        ++run;
+        if (currentFailures() > 0) {
+            ++failed;
+            std::printf("[失败] %s (%u 处)\n", def.name.c_str(), currentFailures());
+        } else {
+            std::printf("[通过] %s\n", def.name.c_str());
+        }
+    }
+
+    std::printf("%u 个用例, %u 个失败\n", run, failed);
+    return failed > 0 ? 1 : 0;
+}
+
+} // namespace test
+
+// ============================================================================
+// 注册与断言宏
+// ============================================================================
+
+#define TEST_CONCAT_IMPL(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_IMPL(a, b)
+
+/**
+ * @brief 定义测试用例
+ */
+#define TEST_CASE(name) \
+    static void TEST_CONCAT(testBody_, __LINE__)(); \
+    static test::Registrar TEST_CONCAT(testRegistrar_, __LINE__)(name, TEST_CONCAT(testBody_, __LINE__)); \
+    static void TEST_CONCAT(testBody_, __LINE__)()
+
+/**
+ * @brief 条件不成立时记录失败（用例继续执行），结果可用于提前返回
+ */
+#define CHECK(condition) \
+    ((condition) ? true : (test::reportFailure(__FILE__, __LINE__, #condition), false))
+
+/**
+ * @brief |actual - expected| <= tolerance，否则记录失败
+ */
+#define CHECK_NEAR(actual, expected, tolerance) \
+    test::checkNear(static_cast<double>(actual), static_cast<double>(expected), static_cast<double>(tolerance), \
+                    __FILE__, __LINE__, #actual " ≈ " #expected)
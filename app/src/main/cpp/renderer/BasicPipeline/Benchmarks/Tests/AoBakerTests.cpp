@@ -0,0 +1,120 @@
+/**
+ * @file AoBakerTests.cpp
+ * @brief 环境光遮蔽烘焙: 开阔平面无遮蔽，封闭盒子内部全遮蔽，结果与线程数无关
+ */
+
+#include "../TestHarness.h"
+
+#include "../../Baking/AoBaker.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/** 边长 size 的水平网格（cells x cells 个格子，法线 +y） */
+BakeMesh makeGrid(float size, float height, uint32_t cells) {
+    BakeMesh mesh;
+    for (uint32_t z = 0; z <= cells; ++z) {
+        for (uint32_t x = 0; x <= cells; ++x) {
+            mesh.positions.push_back(Vector3((static_cast<float>(x) / cells - 0.5f) * size, height,
+                                             (static_cast<float>(z) / cells - 0.5f) * size));
+            mesh.normals.push_back(Vector3(0.0f, 1.0f, 0.0f));
+        }
+    }
+    for (uint32_t z = 0; z < cells; ++z) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            const uint32_t i = z * (cells + 1) + x;
+            for (uint32_t index : {i, i + cells + 2, i + 1, i, i + cells + 1, i + cells + 2}) {
+                mesh.indices.push_back(index);
+            }
+        }
+    }
+    return mesh;
+}
+
+/** 以原点为中心、半边长 halfSize 的封闭立方体（法线朝外） */
+BakeMesh makeBox(float halfSize) {
+    BakeMesh mesh;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (float sign : {-1.0f, 1.0f}) {
+            Vector3 n(0.0f);
+            n[axis] = sign;
+            const Vector3 u = std::fabs(n.y) > 0.5f ? Vector3(n.y, 0, 0) : Vector3(-n.z, 0, n.x);
+            const Vector3 v = glm::cross(n, u);
+            const uint32_t base = static_cast<uint32_t>(mesh.positions.size());
+            for (const Vector2 corner : {Vector2(-1, -1), Vector2(1, -1), Vector2(1, 1), Vector2(-1, 1)}) {
+                mesh.positions.push_back((n + u * corner.x + v * corner.y) * halfSize);
+                mesh.normals.push_back(n);
+            }
+            for (uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u}) {
+                mesh.indices.push_back(base + index);
+            }
+        }
+    }
+    return mesh;
+}
+
+AoBakeSettings makeSettings(uint32_t threads) {
+    AoBakeSettings settings;
+    settings.samples = 128;
+    settings.maxDistance = 2.0f;
+    settings.distanceFalloff = false;
+    settings.threadCount = threads;
+    return settings;
+}
+
+} // namespace
+
+TEST_CASE("AoBaker.openPlaneUnoccluded") {
+    AoBaker baker;
+    baker.setSettings(makeSettings(1));
+    const AoBakeResult result = baker.bake({makeGrid(10.0f, 0.0f, 4)});
+    if (!CHECK(result.meshes.size() == 1 && result.meshes[0].size() == 25)) {
+        return;
+    }
+    for (uint8_t occlusion : result.meshes[0]) {
+        CHECK(occlusion == 255);
+    }
+    CHECK_NEAR(result.stats.meanOcclusion, 1.0f, 1e-6f);
+}
+
+TEST_CASE("AoBaker.insideClosedBoxOccluded") {
+    // 1m 盒子里的小四边形: 所有光线都在 maxDistance 内命中盒壁
+    const std::vector<BakeMesh> meshes = {makeGrid(0.2f, 0.0f, 1), makeBox(0.5f)};
+
+    AoBaker baker;
+    baker.setSettings(makeSettings(1));
+    const AoBakeResult result = baker.bake(meshes);
+    if (!CHECK(result.meshes.size() == 2 && result.meshes[0].size() == 4)) {
+        return;
+    }
+    for (uint8_t occlusion : result.meshes[0]) {
+        CHECK(occlusion <= 2);
+    }
+
+    // 只被自身遮挡时盒子不参与，四边形无遮蔽
+    AoBakeSettings isolated = makeSettings(1);
+    isolated.includeNeighbours = false;
+    baker.setSettings(isolated);
+    const AoBakeResult alone = baker.bake(meshes);
+    for (uint8_t occlusion : alone.meshes[0]) {
+        CHECK(occlusion == 255);
+    }
+}
+
+TEST_CASE("AoBaker.independentOfThreadCount") {
+    // 地面上的盒子: 靠近盒子的地面部分遮蔽（顶点数跨多个工作项）
+    const std::vector<BakeMesh> meshes = {makeGrid(4.0f, -0.5f, 24), makeBox(0.5f)};
+
+    AoBaker baker;
+    baker.setSettings(makeSettings(1));
+    const AoBakeResult single = baker.bake(meshes);
+    baker.setSettings(makeSettings(4));
+    const AoBakeResult multi = baker.bake(meshes);
+
+    CHECK(single.stats.threads == 1);
+    CHECK(single.meshes == multi.meshes);
+    CHECK(single.stats.rays == multi.stats.rays);
+    CHECK(single.stats.meanOcclusion > 0.0f && single.stats.meanOcclusion < 1.0f);
+}
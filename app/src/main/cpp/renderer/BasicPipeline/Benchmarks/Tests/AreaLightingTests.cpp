@@ -0,0 +1,153 @@
+/**
+ * @file AreaLightingTests.cpp
+ * @brief 区域光: 发布的 LTC 表着色与参考积分（IntegrateAreaLightReference）的误差上限
+ *
+ * 场景同 BasicPipelineLtcFit 的抽查: 原点处法线 +y 的着色点，周围随机朝向的矩形 / 圆盘光源。
+ * 误差为 Σ|LTC - 参考| / Σ参考，按粗糙度与视角分段检查（有效范围见 kLtcMinValidNdotV，
+ * 各分段的实测值见 AreaLighting.h）
+ */
+
+#include "../TestHarness.h"
+
+#include "../../AreaLighting.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace {
+
+constexpr uint32_t kSeed = 42;
+constexpr uint32_t kLightCount = 400;
+constexpr uint32_t kReferenceSamples = 128 * 128;
+
+/**
+ * 每个粗糙度的误差上限: 视角 ≤ 45°、有效范围、掠射视角（N·V 0.1 到 kLtcMinValidNdotV）。
+ * 取本测试的实测值（种子 42）加约 30% 余量，防止重新拟合后退化
+ */
+struct ErrorBounds {
+    float roughness;
+    float frontal;
+    float valid;
+    float grazing;
+};
+
+/** F0 = 0.04，实测 视角 ≤ 45° 1.3/3.6/4.5/4.0%，有效范围 1.7/9.7/8.8/7.2%，掠射 26/36/25/20% */
+const ErrorBounds kDielectricBounds[] = {
+    {0.25f, 0.03f, 0.03f, 0.35f},
+    {0.5f, 0.05f, 0.13f, 0.47f},
+    {0.75f, 0.06f, 0.12f, 0.33f},
+    {1.0f, 0.06f, 0.10f, 0.26f},
+};
+
+/** F0 = 1，实测 视角 ≤ 45° 1.5/4.8/3.4/2.3%，有效范围 3.3/9.1/6.9/4.5%，掠射 25/39/33/22% */
+const ErrorBounds kMetalBounds[] = {
+    {0.25f, 0.03f, 0.05f, 0.33f},
+    {0.5f, 0.07f, 0.12f, 0.51f},
+    {0.75f, 0.05f, 0.09f, 0.44f},
+    {1.0f, 0.04f, 0.06f, 0.29f},
+};
+
+/** 发布的表（assets/textures/LTC/，路径由 CMake 传入） */
+const LtcTable& publishedTable() {
+    static const LtcTable table = [] {
+        LtcTable loaded;
+        const std::string directory = BASIC_PIPELINE_LTC_DIR;
+        ReadLtcTableKtx((directory + "/ltc_1.ktx").c_str(), (directory + "/ltc_2.ktx").c_str(), loaded);
+        return loaded;
+    }();
+    return table;
+}
+
+struct ShadingError {
+    float specular = 0.0f;
+    float diffuse = 0.0f;
+};
+
+/** N·V 在 [minNdotV, maxNdotV] 内均匀分布的视线下，LTC 相对参考积分的误差 */
+ShadingError measureError(const LtcTable& table, float roughness, float f0, float minNdotV, float maxNdotV) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> ndotv(minNdotV, maxNdotV);
+    auto randomDirection = [&]() { return glm::normalize(Vector3(uniform(rng), uniform(rng), uniform(rng))); };
+
+    const Vector3 normal(0.0f, 1.0f, 0.0f);
+    const Vector3 F0(f0);
+    double specularError = 0.0, specularReference = 0.0;
+    double diffuseError = 0.0, diffuseReference = 0.0;
+    for (uint32_t k = 0; k < kLightCount; ++k) {
+        const Vector3 position(uniform(rng) * 3.0f, 1.0f + uniform(rng), uniform(rng) * 3.0f);
+        const Vector3 facing = randomDirection();
+        const LightData light = k & 1
+            ? LightData::createDiskArea(position, facing, 0.5f + uniform(rng) * 0.4f, 50.0f)
+            : LightData::createRectArea(position, facing, randomDirection(), 1.0f + uniform(rng) * 0.8f,
+                                        1.0f + uniform(rng) * 0.8f, 50.0f);
+
+        const float cosTheta = ndotv(rng);
+        const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+        const float phi = uniform(rng) * 3.14159265f;
+        const Vector3 view(sinTheta * std::cos(phi), cosTheta, sinTheta * std::sin(phi));
+
+        const AreaLightShading ltc = EvaluateAreaLightLtc(light, table, Vector3(0.0f), normal, view, roughness, F0);
+        const AreaLightShading reference =
+            IntegrateAreaLightReference(light, Vector3(0.0f), normal, view, roughness, F0, kReferenceSamples);
+        specularError += std::fabs(ltc.specular.x - reference.specular.x);
+        specularReference += reference.specular.x;
+        diffuseError += std::fabs(ltc.diffuse.x - reference.diffuse.x);
+        diffuseReference += reference.diffuse.x;
+    }
+
+    ShadingError error;
+    error.specular = static_cast<float>(specularError / std::max(specularReference, 1e-9));
+    error.diffuse = static_cast<float>(diffuseError / std::max(diffuseReference, 1e-9));
+    return error;
+}
+
+} // namespace
+
+TEST_CASE("AreaLighting.publishedTableLoads") {
+    const LtcTable& table = publishedTable();
+    CHECK(table.isValid());
+    CHECK(table.size == kLtcTableSize);
+}
+
+TEST_CASE("AreaLighting.ltcErrorWithinValidRange") {
+    const LtcTable& table = publishedTable();
+    if (!CHECK(table.isValid())) {
+        return;
+    }
+
+    // 漫反射不经过拟合，与 F0 无关
+    for (const ErrorBounds& bounds : kDielectricBounds) {
+        const ShadingError frontal = measureError(table, bounds.roughness, 0.04f, std::cos(glm::radians(45.0f)), 1.0f);
+        CHECK_NEAR(frontal.specular, 0.0f, bounds.frontal);
+        const ShadingError valid = measureError(table, bounds.roughness, 0.04f, kLtcMinValidNdotV, 1.0f);
+        CHECK_NEAR(valid.specular, 0.0f, bounds.valid);
+        CHECK_NEAR(valid.diffuse, 0.0f, 0.01f);
+    }
+    for (const ErrorBounds& bounds : kMetalBounds) {
+        const ShadingError frontal = measureError(table, bounds.roughness, 1.0f, std::cos(glm::radians(45.0f)), 1.0f);
+        CHECK_NEAR(frontal.specular, 0.0f, bounds.frontal);
+        const ShadingError valid = measureError(table, bounds.roughness, 1.0f, kLtcMinValidNdotV, 1.0f);
+        CHECK_NEAR(valid.specular, 0.0f, bounds.valid);
+    }
+}
+
+TEST_CASE("AreaLighting.ltcGrazingErrorBounded") {
+    const LtcTable& table = publishedTable();
+    if (!CHECK(table.isValid())) {
+        return;
+    }
+
+    // 有效范围之外误差随视角增大（LTC 无法表示地平线附近的遮蔽衰减），只防止进一步退化
+    for (const ErrorBounds& bounds : kDielectricBounds) {
+        const ShadingError grazing = measureError(table, bounds.roughness, 0.04f, 0.1f, kLtcMinValidNdotV);
+        CHECK_NEAR(grazing.specular, 0.0f, bounds.grazing);
+        CHECK_NEAR(grazing.diffuse, 0.0f, 0.01f);
+    }
+    for (const ErrorBounds& bounds : kMetalBounds) {
+        const ShadingError grazing = measureError(table, bounds.roughness, 1.0f, 0.1f, kLtcMinValidNdotV);
+        CHECK_NEAR(grazing.specular, 0.0f, bounds.grazing);
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file GpuProfilerTests.cpp
+ * @brief GPU时间戳分析: 时间戳在有效位宽处回绕时，帧与区段耗时仍然正确
+ */
+
+#include "../TestHarness.h"
+
+#include "../../GpuProfiler.h"
+
+#include <cstdint>
+
+namespace {
+
+constexpr uint64_t kTicksPerWrite = 1000;
+constexpr uint32_t kFrameCount = 12;
+
+/**
+ * 每帧一个区段（4 次写入: 帧开始、区段开始、区段结束、帧结束），
+ * 时钟从回绕点之前 startBeforeWrap 个 tick 开始，检查每个读取到的帧
+ */
+void checkAcrossWrap(uint32_t validBits, uint64_t startBeforeWrap) {
+    MockGpuTimestampBackend backend(2, kTicksPerWrite, 1.0);
+    backend.setTimestampValidBits(validBits);
+    const uint64_t wrap = validBits < 64 ? (1ull << validBits) : 0;
+    backend.setClock(wrap - startBeforeWrap);
+
+    GpuProfiler profiler;
+    profiler.setMergeIntoCpuProfiler(false);
+    if (!CHECK(profiler.initialize(&backend))) {
+        return;
+    }
+
+    uint64_t lastFrame = 0;
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+        profiler.beginFrame(nullptr);
+        profiler.endZone(nullptr, profiler.beginZone(nullptr, "Zone"));
+        profiler.endFrame(nullptr);
+
+        const GpuFrameResult& result = profiler.getLatestResult();
+        if (result.frameNumber == lastFrame) {
+            continue;
+        }
+        lastFrame = result.frameNumber;
+        CHECK_NEAR(result.frameNs, 3.0 * kTicksPerWrite, 1e-9);
+        if (CHECK(result.zones.size() == 1)) {
+            CHECK_NEAR(result.zones[0].beginNs, 1.0 * kTicksPerWrite, 1e-9);
+            CHECK_NEAR(result.zones[0].durationNs, 1.0 * kTicksPerWrite, 1e-9);
+        }
+    }
+    CHECK(profiler.getStats().framesResolved >= kFrameCount - 3);
+}
+
+} // namespace
+
+TEST_CASE("GpuProfiler.timestampWrapWithValidBits") {
+    // 32 位有效位: 回绕分别落在区段内部与帧开始之间（前几帧覆盖所有相位）
+    checkAcrossWrap(32, 5500);
+    checkAcrossWrap(36, 2500);
+}
+
+TEST_CASE("GpuProfiler.timestampWrapFullWidth") {
+    checkAcrossWrap(64, 2500);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file IdleFrameDetectorTests.cpp
+ * @brief 空闲帧检测: 静止后进入空闲，光照探针与阴影设置的变化会恢复渲染
+ */
+
+#include "../TestHarness.h"
+
+#include "../../IdleFrameDetector.h"
+#include "../../LightingData.h"
+#include "../../ShadowSettings.h"
+
+namespace {
+
+struct IdleScene {
+    LightingData lighting;
+    ShadowSettings shadows;
+    IdleFrameDetector detector;
+
+    IdleScene() {
+        LightingData::LightProbe probe;
+        probe.position = Vector3(0.0f, 1.0f, 0.0f);
+        for (Vector3& coefficient : probe.sphericalHarmonics) {
+            coefficient = Vector3(0.1f);
+        }
+        lighting.lightProbes.push_back(probe);
+    }
+
+    IdleFrameAction evaluate() {
+        IdleFrameInputs inputs;
+        inputs.lighting = &lighting;
+        inputs.shadows = &shadows;
+        inputs.screenWidth = 1920;
+        inputs.screenHeight = 1080;
+        return detector.evaluate(inputs);
+    }
+
+    /** 连续评估直到进入空闲，返回是否在限定帧数内进入 */
+    bool settle() {
+        for (uint32_t frame = 0; frame < 16; ++frame) {
+            if (evaluate() != IdleFrameAction::Render) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+TEST_CASE("IdleFrameDetector.settlesWhenStatic") {
+    IdleScene scene;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+    CHECK(scene.settle());
+    CHECK(scene.evaluate() != IdleFrameAction::Render);
+}
+
+TEST_CASE("IdleFrameDetector.probeCoefficientChangeRenders") {
+    IdleScene scene;
+    CHECK(scene.settle());
+
+    // 探针数量不变，只有球谐系数变化（例如重新烘焙或天空光改变）
+    scene.lighting.lightProbes[0].sphericalHarmonics[4].y += 0.05f;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+    CHECK(scene.settle());
+
+    scene.lighting.lightProbes[0].position.x += 1.0f;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+}
+
+TEST_CASE("IdleFrameDetector.shadowSettingsChangeRenders") {
+    IdleScene scene;
+    CHECK(scene.settle());
+
+    scene.shadows.shadowDistance *= 0.5f;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+    CHECK(scene.settle());
+
+    scene.shadows.filterSettings.filterType = ShadowFilterSettings::FilterType::PCSS;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+    CHECK(scene.settle());
+
+    scene.shadows.cascadedSettings.cascadeCount = 2;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+    CHECK(scene.settle());
+
+    scene.shadows.enableShadowmask = true;
+    CHECK(scene.evaluate() == IdleFrameAction::Render);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file LateLatchTests.cpp
+ * @brief 后期锁存: 在余量内旋转/平移的锁存相机看到的点不会被扩大后的剔除视锥剔除
+ */
+
+#include "../TestHarness.h"
+
+#include "../../LateLatch.h"
+
+#include <random>
+
+namespace {
+
+constexpr uint32_t kSeed = 42;
+constexpr float kFieldOfView = 60.0f;
+constexpr float kAspect = 16.0f / 9.0f;
+constexpr float kNear = 0.1f;
+constexpr float kFar = 500.0f;
+
+/** 采样点向锁存视锥内收缩的比例，避免边界上的浮点误差 */
+constexpr float kInset = 1.0f - 1e-4f;
+
+CameraSnapshot makeCulledSnapshot(const Matrix4& cameraToWorld, const LateLatchSettings& settings) {
+    CameraSnapshotParams params;
+    params.viewMatrix = glm::inverse(cameraToWorld);
+    params.projectionMatrix = glm::perspective(glm::radians(kFieldOfView), kAspect, kNear, kFar);
+    params.width = 1920;
+    params.height = 1080;
+    CameraSnapshot snapshot = CameraSnapshot::build(params);
+    ApplyLateLatchCullingMargin(snapshot, settings);
+    return snapshot;
+}
+
+/**
+ * 锁存相机的视锥内采样（含8个角点），返回剔除视锥外的点数
+ * @param latchedToWorld 锁存相机的相机到世界矩阵
+ */
+uint32_t countCulled(const CameraSnapshot& culled, const Matrix4& latchedToWorld, std::mt19937& rng) {
+    const float tanY = std::tan(glm::radians(kFieldOfView) * 0.5f);
+    const float tanX = tanY * kAspect;
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(kNear, kFar);
+
+    auto culledCount = [&](float sx, float sy, float d) {
+        d = kNear + (d - kNear) * kInset + kNear * (1.0f - kInset);
+        const Vector4 local(sx * kInset * tanX * d, sy * kInset * tanY * d, -d, 1.0f);
+        const Vector3 world = Vector3(latchedToWorld * local);
+        const bool planes = culled.frustumPlanes.intersectsSphere(world, 0.0f);
+        return (culled.frustum.containsPoint(world) && planes) ? 0u : 1u;
+    };
+
+    uint32_t culledPoints = 0;
+    for (float sx : {-1.0f, 1.0f}) {
+        for (float sy : {-1.0f, 1.0f}) {
+            for (float d : {kNear, kFar}) {
+                culledPoints += culledCount(sx, sy, d);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < 20000; ++i) {
+        // 一半样本贴在视锥侧面上（最容易被剔除）
+        float sx = unit(rng);
+        float sy = unit(rng);
+        if (i % 2 == 0) {
+            (i % 4 == 0 ? sx : sy) = sx < 0.0f ? -1.0f : 1.0f;
+        }
+        culledPoints += culledCount(sx, sy, depth(rng));
+    }
+    return culledPoints;
+}
+
+Matrix4 makeCameraToWorld() {
+    return glm::inverse(glm::lookAt(Vector3(3.0f, 2.0f, 10.0f), Vector3(0.0f, 0.0f, -50.0f),
+                                    Vector3(0.0f, 1.0f, 0.0f)));
+}
+
+} // namespace
+
+TEST_CASE("LateLatch.cullingMargin/RotationWithinMargin") {
+    LateLatchSettings settings;
+    settings.cullingMarginDegrees = 2.0f;
+    settings.cullingMarginDistance = 0.0f;
+
+    const Matrix4 cameraToWorld = makeCameraToWorld();
+    const CameraSnapshot culled = makeCulledSnapshot(cameraToWorld, settings);
+    std::mt19937 rng(kSeed);
+
+    // 相机空间的旋转轴: 偏航、俯仰、滚转与斜向
+    const Vector3 axes[] = {
+        Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f),
+        Vector3(1.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f),
+        Vector3(0.0f, 0.0f, 1.0f),
+        glm::normalize(Vector3(1.0f, 1.0f, 0.0f)), glm::normalize(Vector3(1.0f, -1.0f, 0.5f)),
+    };
+    for (const Vector3& axis : axes) {
+        const Matrix4 latched = glm::rotate(cameraToWorld, glm::radians(1.9f), axis);
+        CHECK(countCulled(culled, latched, rng) == 0);
+    }
+
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (uint32_t i = 0; i < 20; ++i) {
+        const Vector3 axis = glm::normalize(Vector3(unit(rng), unit(rng), unit(rng)));
+        const Matrix4 latched = glm::rotate(cameraToWorld, glm::radians(1.99f), axis);
+        CHECK(countCulled(culled, latched, rng) == 0);
+    }
+}
+
+TEST_CASE("LateLatch.cullingMargin/RotationAndTranslation") {
+    LateLatchSettings settings;
+    settings.cullingMarginDegrees = 2.0f;
+    settings.cullingMarginDistance = 0.1f;
+
+    const Matrix4 cameraToWorld = makeCameraToWorld();
+    const CameraSnapshot culled = makeCulledSnapshot(cameraToWorld, settings);
+    std::mt19937 rng(kSeed + 1);
+
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (uint32_t i = 0; i < 20; ++i) {
+        const Vector3 axis = glm::normalize(Vector3(unit(rng), unit(rng), unit(rng)));
+        const Vector3 offset = glm::normalize(Vector3(unit(rng), unit(rng), unit(rng))) * 0.099f;
+        const Matrix4 moved = glm::translate(Matrix4(1.0f), offset) * cameraToWorld;
+        const Matrix4 latched = glm::rotate(moved, glm::radians(1.9f), axis);
+        CHECK(countCulled(culled, latched, rng) == 0);
+    }
+}
+
+TEST_CASE("LateLatch.cullingMargin/NoMarginMatchesCamera") {
+    LateLatchSettings settings;
+    settings.cullingMarginDegrees = 0.0f;
+    settings.cullingMarginDistance = 0.0f;
+
+    const Matrix4 cameraToWorld = makeCameraToWorld();
+    const CameraSnapshot culled = makeCulledSnapshot(cameraToWorld, settings);
+    std::mt19937 rng(kSeed + 2);
+
+    // 不扩大时相机自身视锥内的点都可见，旋转超出视锥的点被剔除
+    CHECK(countCulled(culled, cameraToWorld, rng) == 0);
+    CHECK(countCulled(culled, glm::rotate(cameraToWorld, glm::radians(1.0f), Vector3(0.0f, 1.0f, 0.0f)), rng) > 0);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file MultiCameraCullerTests.cpp
+ * @brief 多相机剔除: 阴影贴图共享只发生在位姿和投影都足够接近的相机之间
+ */
+
+#include "../TestHarness.h"
+
+#include "../../MultiCameraCuller.h"
+#include "../../RenderableStorage.h"
+
+namespace {
+
+CameraSnapshot makeCamera() {
+    CameraSnapshot camera;
+    camera.position = Vector3(0.0f, 2.0f, 0.0f);
+    camera.forward = Vector3(0.0f, 0.0f, -1.0f);
+    camera.fieldOfView = 60.0f;
+    camera.nearPlane = 0.1f;
+    camera.farPlane = 500.0f;
+    camera.width = 1920;
+    camera.height = 1080;
+    return camera;
+}
+
+/** 两个相机剔除一次，返回第二个相机的阴影来源 */
+uint32_t shadowSourceOfSecond(const CameraSnapshot& first, const CameraSnapshot& second) {
+    RenderableStorage storage;
+    const CameraSnapshot* cameras[] = {&first, &second};
+    MultiCameraCuller culler;
+    culler.cull(storage, cameras, 2);
+    return culler.getShadowSource(1);
+}
+
+} // namespace
+
+TEST_CASE("MultiCameraCuller.shadowSharing/SameView") {
+    const CameraSnapshot a = makeCamera();
+    CameraSnapshot b = makeCamera();
+    b.position.x += 0.064f;   // 立体两眼
+    CHECK(shadowSourceOfSecond(a, b) == 0);
+}
+
+TEST_CASE("MultiCameraCuller.shadowSharing/DifferentProjection") {
+    const CameraSnapshot a = makeCamera();
+
+    CameraSnapshot zoomed = makeCamera();
+    zoomed.fieldOfView = 20.0f;
+    CHECK(shadowSourceOfSecond(a, zoomed) == 1);
+
+    CameraSnapshot shortRange = makeCamera();
+    shortRange.farPlane = 50.0f;
+    CHECK(shadowSourceOfSecond(a, shortRange) == 1);
+
+    CameraSnapshot nearer = makeCamera();
+    nearer.nearPlane = 0.01f;
+    CHECK(shadowSourceOfSecond(a, nearer) == 1);
+
+    CameraSnapshot portrait = makeCamera();
+    portrait.width = 1080;
+    portrait.height = 1920;
+    CHECK(shadowSourceOfSecond(a, portrait) == 1);
+}
+
+TEST_CASE("MultiCameraCuller.shadowSharing/DifferentPose") {
+    const CameraSnapshot a = makeCamera();
+
+    CameraSnapshot moved = makeCamera();
+    moved.position.z += 5.0f;
+    CHECK(shadowSourceOfSecond(a, moved) == 1);
+
+    CameraSnapshot turned = makeCamera();
+    turned.forward = Vector3(1.0f, 0.0f, 0.0f);
+    CHECK(shadowSourceOfSecond(a, turned) == 1);
+}
@@ -0,0 +1,234 @@
+/**
+ * @file ScreenProjectionTests.cpp
+ * @brief 屏幕投影: SoA 批量（SSE2/NEON + 标量尾部）与单点版本的一致性
+ *
+ * 数量覆盖 0、不足一组、整组和带尾部的情况；点集包含相机后方、屏幕外和深度裁剪的点，
+ * 并测试未对齐的起始地址与输入输出共用数组
+ */
+
+#include "../TestHarness.h"
+
+#include "../../ScreenProjection.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kSeed = 42;
+constexpr uint32_t kScreenWidth = 1920;
+constexpr uint32_t kScreenHeight = 1080;
+
+/** 每种数量都测试: 空、单点、不足4个、整组、整组+尾部、较大的数组 */
+const uint32_t kCounts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 1003};
+
+/**
+ * 批量与单点的运算顺序相同；允许 FMA 合并带来的末位差异，
+ * 相机平面附近（w 接近 0）的点坐标很大，按相对误差比较
+ */
+constexpr float kRelativeTolerance = 1e-5f;
+
+float tolerance(float expected) {
+    return kRelativeTolerance * std::max(1.0f, std::fabs(expected));
+}
+
+Matrix4 makeViewProjection() {
+    const Matrix4 view = glm::lookAt(Vector3(0.0f, 20.0f, 0.0f), Vector3(0.0f, 0.0f, -100.0f),
+                                     Vector3(0.0f, 1.0f, 0.0f));
+    const Matrix4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    return projection * view;
+}
+
+/** SoA 点数组，前面留一个元素用于测试未对齐的起始地址 */
+struct TestPoints {
+    std::vector<float> x, y, z;
+
+    explicit TestPoints(uint32_t count) : x(count + 1), y(count + 1), z(count + 1) {}
+    PointsSoA view(uint32_t offset) { return {x.data() + offset, y.data() + offset, z.data() + offset}; }
+    Vector3 at(uint32_t offset, uint32_t i) const { return Vector3(x[offset + i], y[offset + i], z[offset + i]); }
+};
+
+/** 相机周围的世界空间点: 约一半在视锥内，其余在相机后方、屏幕外或远平面之外 */
+TestPoints makeWorldPoints(uint32_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> px(-400.0f, 400.0f);
+    std::uniform_real_distribution<float> py(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> pz(-700.0f, 150.0f);
+
+    TestPoints points(count);
+    for (uint32_t i = 0; i < count + 1; ++i) {
+        points.x[i] = px(rng);
+        points.y[i] = py(rng);
+        points.z[i] = pz(rng);
+    }
+    return points;
+}
+
+/** 屏幕空间点: 包含视口外的像素坐标，深度覆盖 [0, 1] */
+TestPoints makeScreenPoints(uint32_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> px(-200.0f, static_cast<float>(kScreenWidth) + 200.0f);
+    std::uniform_real_distribution<float> py(-200.0f, static_cast<float>(kScreenHeight) + 200.0f);
+    std::uniform_real_distribution<float> pz(0.0f, 1.0f);
+
+    TestPoints points(count);
+    for (uint32_t i = 0; i < count + 1; ++i) {
+        points.x[i] = px(rng);
+        points.y[i] = py(rng);
+        points.z[i] = pz(rng);
+    }
+    return points;
+}
+
+void checkVectorNear(const Vector3& actual, const Vector3& expected) {
+    CHECK_NEAR(actual.x, expected.x, tolerance(expected.x));
+    CHECK_NEAR(actual.y, expected.y, tolerance(expected.y));
+    CHECK_NEAR(actual.z, expected.z, tolerance(expected.z));
+}
+
+} // namespace
+
+TEST_CASE("ScreenProjection.worldToScreen/BatchMatchesScalar") {
+    std::mt19937 rng(kSeed);
+    const Matrix4 viewProjection = makeViewProjection();
+
+    uint32_t behindTotal = 0;
+    for (uint32_t count : kCounts) {
+        for (uint32_t offset = 0; offset < 2; ++offset) {
+            TestPoints world = makeWorldPoints(count, rng);
+            TestPoints screen(count);
+            std::vector<uint8_t> flags(count + 1, 0xFF);
+
+            const uint32_t visible = WorldToScreenPoints(viewProjection, world.view(offset), count,
+                                                         kScreenWidth, kScreenHeight,
+                                                         screen.view(offset), flags.data() + offset);
+
+            uint32_t expectedVisible = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint8_t expectedFlags = 0;
+                const Vector3 expected = WorldToScreenPoint(viewProjection, world.at(offset, i),
+                                                            kScreenWidth, kScreenHeight, &expectedFlags);
+                CHECK(flags[offset + i] == expectedFlags);
+                checkVectorNear(screen.at(offset, i), expected);
+
+                expectedVisible += expectedFlags == ScreenPointFlags::None ? 1 : 0;
+                behindTotal += (expectedFlags & ScreenPointFlags::BehindCamera) ? 1 : 0;
+            }
+            CHECK(visible == expectedVisible);
+        }
+    }
+    // 点集必须真的覆盖相机后方的情况
+    CHECK(behindTotal > 0);
+}
+
+TEST_CASE("ScreenProjection.worldToScreen/InPlace") {
+    std::mt19937 rng(kSeed + 1);
+    const Matrix4 viewProjection = makeViewProjection();
+
+    for (uint32_t count : kCounts) {
+        TestPoints points = makeWorldPoints(count, rng);
+        const TestPoints original = points;
+        std::vector<uint8_t> flags(count + 1);
+
+        WorldToScreenPoints(viewProjection, points.view(1), count, kScreenWidth, kScreenHeight,
+                            points.view(1), flags.data() + 1);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            uint8_t expectedFlags = 0;
+            const Vector3 expected = WorldToScreenPoint(viewProjection, original.at(1, i),
+                                                        kScreenWidth, kScreenHeight, &expectedFlags);
+            CHECK(flags[1 + i] == expectedFlags);
+            checkVectorNear(points.at(1, i), expected);
+        }
+    }
+}
+
+TEST_CASE("ScreenProjection.worldToScreen/NullFlags") {
+    std::mt19937 rng(kSeed + 2);
+    const Matrix4 viewProjection = makeViewProjection();
+
+    for (uint32_t count : kCounts) {
+        TestPoints world = makeWorldPoints(count, rng);
+        TestPoints screen(count);
+        std::vector<uint8_t> flags(count + 1);
+
+        const uint32_t withFlags = WorldToScreenPoints(viewProjection, world.view(0), count,
+                                                       kScreenWidth, kScreenHeight, screen.view(0), flags.data());
+        const uint32_t withoutFlags = WorldToScreenPoints(viewProjection, world.view(0), count,
+                                                          kScreenWidth, kScreenHeight, screen.view(0), nullptr);
+        CHECK(withFlags == withoutFlags);
+    }
+}
+
+TEST_CASE("ScreenProjection.screenToWorld/BatchMatchesScalar") {
+    std::mt19937 rng(kSeed + 3);
+    const Matrix4 invViewProjection = glm::inverse(makeViewProjection());
+
+    for (uint32_t count : kCounts) {
+        for (uint32_t offset = 0; offset < 2; ++offset) {
+            TestPoints screen = makeScreenPoints(count, rng);
+            TestPoints world(count);
+
+            ScreenToWorldPoints(invViewProjection, screen.view(offset), count, kScreenWidth, kScreenHeight,
+                                world.view(offset));
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const Vector3 expected = ScreenToWorldPoint(
+                    invViewProjection, Vector2(screen.x[offset + i], screen.y[offset + i]), screen.z[offset + i],
+                    kScreenWidth, kScreenHeight);
+                checkVectorNear(world.at(offset, i), expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("ScreenProjection.screenToWorld/RoundTrip") {
+    std::mt19937 rng(kSeed + 4);
+    const Matrix4 viewProjection = makeViewProjection();
+    const Matrix4 invViewProjection = glm::inverse(viewProjection);
+
+    const uint32_t count = 1003;
+    TestPoints world = makeWorldPoints(count, rng);
+    TestPoints screen(count);
+    TestPoints roundTrip(count);
+    std::vector<uint8_t> flags(count + 1);
+
+    WorldToScreenPoints(viewProjection, world.view(0), count, kScreenWidth, kScreenHeight,
+                        screen.view(0), flags.data());
+    ScreenToWorldPoints(invViewProjection, screen.view(0), count, kScreenWidth, kScreenHeight, roundTrip.view(0));
+
+    // 只有可见点能往返（深度精度随距离下降，按米比较）
+    for (uint32_t i = 0; i < count; ++i) {
+        if (flags[i] != ScreenPointFlags::None) {
+            continue;
+        }
+        const Vector3 expected = world.at(0, i);
+        const float meters = 0.05f + 1e-3f * glm::length(expected - Vector3(0.0f, 20.0f, 0.0f));
+        CHECK_NEAR(roundTrip.x[i], expected.x, meters);
+        CHECK_NEAR(roundTrip.y[i], expected.y, meters);
+        CHECK_NEAR(roundTrip.z[i], expected.z, meters);
+    }
+}
+
+TEST_CASE("ScreenProjection.pointToRay/BatchMatchesScalar") {
+    std::mt19937 rng(kSeed + 5);
+    const Matrix4 invViewProjection = glm::inverse(makeViewProjection());
+
+    for (uint32_t count : kCounts) {
+        for (uint32_t offset = 0; offset < 2; ++offset) {
+            TestPoints screen = makeScreenPoints(count, rng);
+            TestPoints origins(count);
+            TestPoints directions(count);
+
+            ScreenPointsToRays(invViewProjection, screen.x.data() + offset, screen.y.data() + offset, count,
+                               kScreenWidth, kScreenHeight, origins.view(offset), directions.view(offset));
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const ScreenRay expected = ScreenPointToRay(
+                    invViewProjection, Vector2(screen.x[offset + i], screen.y[offset + i]),
+                    kScreenWidth, kScreenHeight);
+                checkVectorNear(origins.at(offset, i), expected.origin);
+                checkVectorNear(directions.at(offset, i), expected.direction);
+                CHECK_NEAR(glm::length(directions.at(offset, i)), 1.0f, 1e-5f);
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file ShadowLightSelectorTests.cpp
+ * @brief 阴影光源选择: 滞后状态跟随光源标识（列表重排不转移），聚合后只选择仍单独着色的光源
+ */
+
+#include "../TestHarness.h"
+
+#include "../../CameraSnapshot.h"
+#include "../../LightAggregator.h"
+#include "../../RenderableStorage.h"
+#include "../../ShadowLightSelector.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kSeed = 42;
+
+CameraSnapshot makeSnapshot() {
+    CameraSnapshotParams params;
+    params.viewMatrix = glm::lookAt(Vector3(0.0f, 2.0f, 0.0f), Vector3(0.0f, 2.0f, -1.0f), Vector3(0.0f, 1.0f, 0.0f));
+    params.projectionMatrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    params.width = 1920;
+    params.height = 1080;
+    return CameraSnapshot::build(params);
+}
+
+/** 相机前方 [-60, 60] × [-150, 0] 的投射者网格 */
+void fillCasters(RenderableStorage& storage) {
+    for (int x = -60; x <= 60; x += 4) {
+        for (int z = -150; z <= 0; z += 4) {
+            RenderableDesc desc;
+            desc.center = Vector3(static_cast<float>(x), 0.5f, static_cast<float>(z));
+            desc.worldMatrix = glm::translate(Matrix4(1.0f), desc.center);
+            desc.radius = 1.0f;
+            storage.create(desc);
+        }
+    }
+}
+
+LightData makeShadowPoint(const Vector3& position, float range, float intensity) {
+    LightData light = LightData::createPoint(position, range, Vector3(1.0f), intensity);
+    light.castShadows = true;
+    return light;
+}
+
+uint32_t selectedId(const ShadowLightSelector& selector, const LightingData& lighting) {
+    return selector.getSelection().empty() ? 0 : ShadowLightSelector::getLight(lighting, selector.getSelection()[0]).id;
+}
+
+} // namespace
+
+TEST_CASE("ShadowLightSelector.hysteresisFollowsLightId") {
+    RenderableStorage storage;
+    fillCasters(storage);
+    const CameraSnapshot camera = makeSnapshot();
+
+    LightingData lighting;
+    lighting.addLight(makeShadowPoint(Vector3(-3.0f, 2.0f, -15.0f), 10.0f, 1.0f));
+    lighting.addLight(makeShadowPoint(Vector3(3.0f, 2.0f, -15.0f), 10.0f, 0.9f));
+    const uint32_t first = lighting.pointLights[0].id;
+    const uint32_t second = lighting.pointLights[1].id;
+    if (!CHECK(first != 0 && second != 0 && first != second)) {
+        return;
+    }
+
+    ShadowSettings shadows;
+    shadows.maxShadowCastingLightsPerFrame = 1;
+
+    ShadowLightSelectionSettings settings;
+    settings.hysteresis = 0.25f;
+    settings.minHoldFrames = 0;
+    ShadowLightSelector selector;
+    selector.setSettings(settings);
+
+    selector.select(lighting, camera, shadows, storage);
+    CHECK(selectedId(selector, lighting) == first);
+
+    // 列表重排，另一个光源略亮（在滞后范围内）: 仍选原来的光源，不记为切换
+    std::swap(lighting.pointLights[0], lighting.pointLights[1]);
+    lighting.pointLights[0].intensity = 1.1f;
+    selector.select(lighting, camera, shadows, storage);
+    CHECK(selectedId(selector, lighting) == first);
+    CHECK(selector.getStats().enteredLights == 0);
+    CHECK(selector.getStats().leftLights == 0);
+
+    // 超出滞后范围后切换
+    lighting.pointLights[0].intensity = 2.0f;
+    selector.select(lighting, camera, shadows, storage);
+    CHECK(selectedId(selector, lighting) == second);
+    CHECK(selector.getStats().enteredLights == 1);
+}
+
+TEST_CASE("ShadowLightSelector.skipsAggregatedLights") {
+    RenderableStorage storage;
+    fillCasters(storage);
+    const CameraSnapshot camera = makeSnapshot();
+
+    // 近处一个亮光源，远处大量暗光源（大部分被合并）
+    LightingData lighting;
+    lighting.addLight(makeShadowPoint(Vector3(0.0f, 3.0f, -12.0f), 15.0f, 4.0f));
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> x(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> z(-140.0f, -60.0f);
+    for (uint32_t i = 0; i < 200; ++i) {
+        lighting.addLight(makeShadowPoint(Vector3(x(rng), 3.0f, z(rng)), 6.0f, 1.0f));
+    }
+
+    LightAggregationSettings aggregation;
+    aggregation.maxRealLights = 4;
+    LightAggregator aggregator;
+    aggregator.setSettings(aggregation);
+    aggregator.aggregate(lighting, camera);
+    if (!CHECK(aggregator.getStats().aggregatedLights > 0)) {
+        return;
+    }
+
+    LightingData frameLighting = lighting;
+    aggregator.applyTo(frameLighting);
+
+    ShadowSettings shadows;
+    shadows.shadowDistance = 200.0f;
+    shadows.maxShadowCastingLightsPerFrame = 8;
+
+    ShadowLightSelectionSettings settings;
+    settings.maxCasterQueries = 0;
+    ShadowLightSelector selector;
+    selector.setSettings(settings);
+
+    // 从原始列表选择会给已合并的光源分配阴影贴图（确认场景覆盖了这种情况）
+    auto isReal = [&](uint32_t id) {
+        const LightDataList& real = aggregator.getRealPointLights();
+        return std::any_of(real.begin(), real.end(), [id](const LightData& l) { return l.id == id; });
+    };
+    selector.select(lighting, camera, shadows, storage);
+    uint32_t mergedSelections = 0;
+    for (const ShadowLightSelection& selection : selector.getSelection()) {
+        mergedSelections += isReal(ShadowLightSelector::getLight(lighting, selection).id) ? 0 : 1;
+    }
+    CHECK(mergedSelections > 0);
+
+    // 从聚合后的列表选择: 只有保留的真实光源，虚拟光源不投射阴影
+    selector.reset();
+    selector.select(frameLighting, camera, shadows, storage);
+    CHECK(!selector.getSelection().empty());
+    for (const ShadowLightSelection& selection : selector.getSelection()) {
+        const LightData& light = ShadowLightSelector::getLight(frameLighting, selection);
+        CHECK(light.id != 0);
+        CHECK(isReal(light.id));
+    }
+}
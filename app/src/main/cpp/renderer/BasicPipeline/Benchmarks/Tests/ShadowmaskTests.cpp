@@ -0,0 +1,158 @@
+/**
+ * @file ShadowmaskTests.cpp
+ * @brief Shadowmask: 启用后静态投射者不进实时阴影贴图，静态接收者的阴影来自烘焙的 shadowmask
+ *
+ * 烘焙地面 + 静态盒子 + Mixed 太阳光，读取地面上盒子影子内外的 shadowmask，
+ * 按 ShadowSettings::combineShadowmask（PBRCommon.hlsl 的 CombineShadowmask）与实时阴影合并
+ */
+
+#include "../TestHarness.h"
+
+#include "../../Baking/LightmapBaker.h"
+#include "../../RenderableStorage.h"
+#include "../../ShadowSettings.h"
+
+namespace {
+
+/** 10m 地面，只有它接收光照贴图 */
+BakeMesh makeGround() {
+    BakeMesh mesh;
+    mesh.positions = {Vector3(-5, 0, -5), Vector3(5, 0, -5), Vector3(5, 0, 5), Vector3(-5, 0, 5)};
+    mesh.normals.assign(4, Vector3(0, 1, 0));
+    mesh.lightmapUVs = {Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1)};
+    mesh.indices = {0, 2, 1, 0, 3, 2};
+    return mesh;
+}
+
+/** 地面上 2m 的立方体（只遮挡，不分配光照贴图） */
+BakeMesh makeBox() {
+    BakeMesh mesh;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (float sign : {-1.0f, 1.0f}) {
+            Vector3 n(0.0f);
+            n[axis] = sign;
+            const Vector3 u = std::fabs(n.y) > 0.5f ? Vector3(n.y, 0, 0) : Vector3(-n.z, 0, n.x);
+            const Vector3 v = glm::cross(n, u);
+            const uint32_t base = static_cast<uint32_t>(mesh.positions.size());
+            for (const Vector2 corner : {Vector2(-1, -1), Vector2(1, -1), Vector2(1, 1), Vector2(-1, 1)}) {
+                mesh.positions.push_back(n + u * corner.x + v * corner.y + Vector3(0, 1, 0));
+                mesh.normals.push_back(n);
+            }
+            for (uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u}) {
+                mesh.indices.push_back(base + index);
+            }
+        }
+    }
+    mesh.receiveLightmap = false;
+    return mesh;
+}
+
+/** 地面上一点的 shadowmask 通道值（在布局三角形中插值出图集 UV，取最近纹素） */
+float sampleGroundShadowmask(const LightmapBakeResult& result, const BakeMesh& ground, const Vector3& point,
+                             int32_t channel) {
+    const LightmapMeshLayout& layout = result.meshes[0];
+    const BakedLightmap& lightmap = result.lightmaps[layout.atlasIndex];
+    for (size_t i = 0; i + 2 < layout.indices.size(); i += 3) {
+        const uint32_t v[3] = {layout.indices[i], layout.indices[i + 1], layout.indices[i + 2]};
+        const Vector2 p[3] = {
+            Vector2(ground.positions[layout.vertexRemap[v[0]]].x, ground.positions[layout.vertexRemap[v[0]]].z),
+            Vector2(ground.positions[layout.vertexRemap[v[1]]].x, ground.positions[layout.vertexRemap[v[1]]].z),
+            Vector2(ground.positions[layout.vertexRemap[v[2]]].x, ground.positions[layout.vertexRemap[v[2]]].z),
+        };
+        const Vector2 q(point.x, point.z);
+        const float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+        const float w1 = ((q.x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (q.y - p[0].y)) / area;
+        const float w2 = ((p[1].x - p[0].x) * (q.y - p[0].y) - (q.x - p[0].x) * (p[1].y - p[0].y)) / area;
+        const float w0 = 1.0f - w1 - w2;
+        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+            continue;
+        }
+        const Vector2 uv = layout.uvs[v[0]] * w0 + layout.uvs[v[1]] * w1 + layout.uvs[v[2]] * w2;
+        const uint32_t x = std::min(static_cast<uint32_t>(uv.x * lightmap.width), lightmap.width - 1);
+        const uint32_t y = std::min(static_cast<uint32_t>(uv.y * lightmap.height), lightmap.height - 1);
+        return lightmap.shadowmask[y * lightmap.width + x][channel];
+    }
+    return -1.0f;
+}
+
+} // namespace
+
+TEST_CASE("Shadowmask.staticCasterShadowsStaticReceiver") {
+    LightData sun = LightData::createDirectional(glm::normalize(Vector3(1.0f, -1.0f, 0.0f)), Vector3(1.0f), 2.0f);
+    sun.lightMode = LightMode::Mixed;
+    sun.castShadows = true;
+
+    BakeScene scene;
+    scene.meshes.push_back(makeGround());
+    scene.meshes.push_back(makeBox());
+    scene.lights.push_back(sun);
+
+    BakeSettings settings;
+    settings.texelsPerUnit = 4.0f;
+    settings.samplesPerTexel = 64;
+    settings.maxBounces = 0;
+    settings.lightSize = 0.0f;
+    settings.denoise.enabled = false;
+    settings.shadowmask = true;
+
+    LightmapBaker baker;
+    baker.setSettings(settings);
+    const LightmapBakeResult result = baker.bake(scene);
+    if (!CHECK(result.shadowmaskChannels.size() == 1 && result.shadowmaskChannels[0] >= 0)) {
+        return;
+    }
+    sun.shadowmaskChannel = result.shadowmaskChannels[0];
+    if (!CHECK(!result.lightmaps.empty() && !result.lightmaps[0].shadowmask.empty())) {
+        return;
+    }
+
+    ShadowSettings shadows;
+    shadows.enableShadowmask = true;
+    shadows.shadowDistance = 50.0f;
+    shadows.shadowmaskShadowDistance = 20.0f;
+    CHECK(shadows.usesShadowmask(sun));
+
+    // 静态盒子不进实时阴影贴图: 它在地面上的实时阴影衰减为 1
+    const uint32_t staticCaster = RenderableFlags::Static | RenderableFlags::CastShadows;
+    CHECK(!shadows.isRealtimeShadowCaster(sun, staticCaster));
+    const float realtimeShadow = 1.0f;
+
+    // 光线沿 +x 向下 45°，盒子的影子落在 x ∈ [1, 3]
+    const float shadowed = sampleGroundShadowmask(result, scene.meshes[0], Vector3(2.0f, 0.0f, 0.0f),
+                                                  sun.shadowmaskChannel);
+    const float lit = sampleGroundShadowmask(result, scene.meshes[0], Vector3(-3.0f, 0.0f, 0.0f),
+                                             sun.shadowmaskChannel);
+    CHECK(shadowed >= 0.0f && shadowed < 0.1f);
+    CHECK(lit > 0.9f);
+
+    // 实时阴影距离内外，静态接收者都保留静态投射者的阴影
+    for (float distance : {2.0f, 15.0f, 19.5f, 40.0f}) {
+        CHECK(shadows.combineShadowmask(sun, realtimeShadow, shadowed, distance) < 0.1f);
+        CHECK(shadows.combineShadowmask(sun, realtimeShadow, lit, distance) > 0.9f);
+    }
+}
+
+TEST_CASE("Shadowmask.combineWithRealtime") {
+    LightData sun = LightData::createDirectional(Vector3(0.0f, -1.0f, 0.0f), Vector3(1.0f), 1.0f);
+    sun.lightMode = LightMode::Mixed;
+    sun.shadowmaskChannel = 0;
+
+    ShadowSettings shadows;
+    shadows.enableShadowmask = true;
+    shadows.shadowDistance = 50.0f;
+    shadows.shadowmaskShadowDistance = 20.0f;
+    shadows.shadowFadeDistance = 4.0f;
+
+    // 动态投射者的实时阴影在实时阴影距离内有效，末端淡出，之外只剩 shadowmask
+    CHECK_NEAR(shadows.combineShadowmask(sun, 0.0f, 1.0f, 5.0f), 0.0f, 1e-6f);
+    CHECK_NEAR(shadows.combineShadowmask(sun, 0.0f, 1.0f, 18.0f), 0.5f, 1e-5f);
+    CHECK_NEAR(shadows.combineShadowmask(sun, 0.0f, 1.0f, 25.0f), 1.0f, 1e-6f);
+    CHECK_NEAR(shadows.combineShadowmask(sun, 0.0f, 0.3f, 25.0f), 0.3f, 1e-6f);
+
+    // 两者都有阴影时取较小值，不相乘
+    CHECK_NEAR(shadows.combineShadowmask(sun, 0.4f, 0.6f, 5.0f), 0.4f, 1e-6f);
+
+    // 不使用 shadowmask 的光源只有实时阴影
+    shadows.enableShadowmask = false;
+    CHECK_NEAR(shadows.combineShadowmask(sun, 0.25f, 0.0f, 5.0f), 0.25f, 1e-6f);
+}
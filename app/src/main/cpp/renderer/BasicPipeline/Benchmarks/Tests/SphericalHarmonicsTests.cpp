@@ -0,0 +1,320 @@
+/**
+ * @file SphericalHarmonicsTests.cpp
+ * @brief 球谐: 投影与数值积分一致、旋转不变性、批量求值与单方向求值一致
+ *
+ * 参考积分在经纬度网格上用中点法（double）计算 c_i = ∫ f Y_i dω
+ */
+
+#include "../TestHarness.h"
+
+#include "../../SphericalHarmonics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kSeed = 42;
+constexpr double kPi = 3.14159265358979323846;
+
+using SphereFunction = std::function<double(const Vector3&)>;
+
+/** 参考投影: 经纬度网格中点法 */
+std::vector<double> projectByQuadrature(const SphereFunction& f, uint32_t thetaSteps = 512) {
+    const uint32_t phiSteps = thetaSteps * 2;
+    const double dTheta = kPi / thetaSteps;
+    const double dPhi = 2.0 * kPi / phiSteps;
+
+    std::vector<double> coefficients(kSHMaxCoefficients, 0.0);
+    float basis[kSHMaxCoefficients];
+    for (uint32_t t = 0; t < thetaSteps; ++t) {
+        const double theta = (t + 0.5) * dTheta;
+        const double weight = std::sin(theta) * dTheta * dPhi;
+        for (uint32_t p = 0; p < phiSteps; ++p) {
+            const double phi = (p + 0.5) * dPhi;
+            const Vector3 direction(static_cast<float>(std::sin(theta) * std::cos(phi)),
+                                    static_cast<float>(std::sin(theta) * std::sin(phi)),
+                                    static_cast<float>(std::cos(theta)));
+            const double value = f(direction) * weight;
+            EvaluateSHBasis(direction, basis);
+            for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+                coefficients[i] += value * basis[i];
+            }
+        }
+    }
+    return coefficients;
+}
+
+/** 平滑的测试函数（含所有 L2 分量和更高频的部分） */
+double smoothFunction(const Vector3& d) {
+    return 1.0 + 0.5 * d.x - 0.3 * d.y + 0.8 * d.z + 0.6 * d.x * d.y + std::pow(std::max(0.0f, d.z), 3.0f);
+}
+
+Vector3 randomDirection(std::mt19937& rng) {
+    std::normal_distribution<float> normal;
+    for (;;) {
+        const Vector3 v(normal(rng), normal(rng), normal(rng));
+        const float length = glm::length(v);
+        if (length > 1e-3f) {
+            return v / length;
+        }
+    }
+}
+
+Matrix4 randomRotation(std::mt19937& rng) {
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    return glm::rotate(Matrix4(1.0f), angle(rng), randomDirection(rng));
+}
+
+SH9 randomSH9(std::mt19937& rng) {
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    SH9 sh;
+    for (float& c : sh.c) {
+        c = value(rng);
+    }
+    return sh;
+}
+
+} // namespace
+
+// ============================================================================
+// 投影
+// ============================================================================
+
+TEST_CASE("SphericalHarmonics.project/CubemapMatchesQuadrature") {
+    const std::vector<double> reference = projectByQuadrature(smoothFunction);
+
+    const uint32_t size = 64;
+    std::vector<Vector3> faceData[6];
+    const Vector3* faces[6];
+    for (uint32_t face = 0; face < 6; ++face) {
+        faceData[face].resize(size * size);
+        for (uint32_t y = 0; y < size; ++y) {
+            for (uint32_t x = 0; x < size; ++x) {
+                const float value = static_cast<float>(smoothFunction(GetCubemapTexelDirection(face, x, y, size)));
+                faceData[face][y * size + x] = Vector3(value, 2.0f * value, -value);
+            }
+        }
+        faces[face] = faceData[face].data();
+    }
+
+    const SH9RGB projected = ProjectCubemapToSH(faces, size);
+    for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+        CHECK_NEAR(projected.c[i].x, reference[i], 2e-3);
+        CHECK_NEAR(projected.c[i].y, 2.0 * reference[i], 4e-3);
+        CHECK_NEAR(projected.c[i].z, -reference[i], 2e-3);
+    }
+}
+
+TEST_CASE("SphericalHarmonics.project/ConeMatchesQuadrature") {
+    const Vector3 axis = glm::normalize(Vector3(0.3f, -0.5f, 0.8f));
+    for (float halfAngleDegrees : {5.0f, 30.0f, 90.0f, 150.0f}) {
+        const float halfAngle = halfAngleDegrees * static_cast<float>(kPi) / 180.0f;
+        const double cosHalf = std::cos(halfAngle);
+        const std::vector<double> reference = projectByQuadrature(
+            [&](const Vector3& d) { return glm::dot(d, axis) >= cosHalf ? 1.0 : 0.0; }, 1024);
+
+        SH9 cone;
+        AddSHCone(cone, axis, halfAngle, 1.0f);
+        // 指示函数的数值积分只在边界上有误差，容差按球冠周长放宽
+        const double tolerance = 2e-3 + 2e-3 * std::sin(halfAngle);
+        for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+            CHECK_NEAR(cone.c[i], reference[i], tolerance);
+        }
+    }
+}
+
+TEST_CASE("SphericalHarmonics.project/UniformAndDirectional") {
+    // 常数 1 只有 c0 = √(4π)
+    const std::vector<double> reference = projectByQuadrature([](const Vector3&) { return 1.0; });
+    SH9 uniform;
+    AddSHUniform(uniform, 1.0f);
+    for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+        CHECK_NEAR(uniform.c[i], reference[i], 1e-4);
+    }
+
+    // δ 光源的系数就是基函数值
+    std::mt19937 rng(kSeed);
+    const Vector3 direction = randomDirection(rng);
+    SH9 delta;
+    AddSHDirectional(delta, direction, 2.5f);
+    float basis[kSHMaxCoefficients];
+    EvaluateSHBasis(direction, basis);
+    for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+        CHECK_NEAR(delta.c[i], 2.5f * basis[i], 1e-6f);
+    }
+}
+
+TEST_CASE("SphericalHarmonics.project/BasisIsOrthonormal") {
+    for (uint32_t j = 0; j < kSHMaxCoefficients; ++j) {
+        const std::vector<double> projected = projectByQuadrature([j](const Vector3& d) {
+            float basis[kSHMaxCoefficients];
+            EvaluateSHBasis(d, basis);
+            return static_cast<double>(basis[j]);
+        }, 256);
+        for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+            CHECK_NEAR(projected[i], i == j ? 1.0 : 0.0, 1e-4);
+        }
+    }
+}
+
+TEST_CASE("SphericalHarmonics.convolve/LambertUniform") {
+    // 均匀辐射度 L 的辐照度处处为 πL
+    SH9 radiance;
+    AddSHUniform(radiance, 1.5f);
+    const SH9 irradiance = ConvolveSHLambert(radiance);
+    std::mt19937 rng(kSeed);
+    for (uint32_t i = 0; i < 16; ++i) {
+        CHECK_NEAR(EvaluateSH(irradiance, randomDirection(rng)), kPi * 1.5, 1e-4);
+    }
+}
+
+// ============================================================================
+// 旋转
+// ============================================================================
+
+TEST_CASE("SphericalHarmonics.rotate/EvaluationInvariance") {
+    std::mt19937 rng(kSeed);
+    for (uint32_t trial = 0; trial < 20; ++trial) {
+        const Matrix4 rotation = randomRotation(rng);
+        const SHRotation shRotation(rotation);
+        const SH9 sh = randomSH9(rng);
+        const SH9 rotated = shRotation.apply(sh);
+        const SH4 rotatedL1 = shRotation.apply(SH4{});
+
+        // g(Rω) = f(ω)
+        for (uint32_t i = 0; i < 16; ++i) {
+            const Vector3 direction = randomDirection(rng);
+            const Vector3 rotatedDirection = Vector3(rotation * Vector4(direction, 0.0f));
+            CHECK_NEAR(EvaluateSH(rotated, rotatedDirection), EvaluateSH(sh, direction), 1e-4f);
+        }
+
+        // 每个频带的能量不变
+        const float band0 = sh.c[0] * sh.c[0];
+        float band1 = 0.0f, rotatedBand1 = 0.0f, band2 = 0.0f, rotatedBand2 = 0.0f;
+        for (uint32_t i = 1; i < 4; ++i) {
+            band1 += sh.c[i] * sh.c[i];
+            rotatedBand1 += rotated.c[i] * rotated.c[i];
+        }
+        for (uint32_t i = 4; i < 9; ++i) {
+            band2 += sh.c[i] * sh.c[i];
+            rotatedBand2 += rotated.c[i] * rotated.c[i];
+        }
+        CHECK_NEAR(rotated.c[0] * rotated.c[0], band0, 1e-5f);
+        CHECK_NEAR(rotatedBand1, band1, 1e-4f);
+        CHECK_NEAR(rotatedBand2, band2, 1e-4f);
+        for (float c : rotatedL1.c) {
+            CHECK_NEAR(c, 0.0f, 1e-6f);
+        }
+    }
+}
+
+TEST_CASE("SphericalHarmonics.rotate/MatchesProjectionOfRotatedFunction") {
+    std::mt19937 rng(kSeed + 1);
+    for (uint32_t trial = 0; trial < 10; ++trial) {
+        const Matrix4 rotation = randomRotation(rng);
+        const SHRotation shRotation(rotation);
+        const Vector3 axis = randomDirection(rng);
+        const Vector3 rotatedAxis = Vector3(rotation * Vector4(axis, 0.0f));
+
+        SH9RGB cone;
+        AddSHCone(cone, axis, 0.6f, Vector3(1.0f, 0.5f, 0.25f));
+        SH9RGB rotatedCone;
+        AddSHCone(rotatedCone, rotatedAxis, 0.6f, Vector3(1.0f, 0.5f, 0.25f));
+
+        const SH9RGB rotated = shRotation.apply(cone);
+        for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+            CHECK_NEAR(rotated.c[i].x, rotatedCone.c[i].x, 1e-4f);
+            CHECK_NEAR(rotated.c[i].y, rotatedCone.c[i].y, 1e-4f);
+            CHECK_NEAR(rotated.c[i].z, rotatedCone.c[i].z, 1e-4f);
+        }
+    }
+}
+
+TEST_CASE("SphericalHarmonics.rotate/IdentityAndInverse") {
+    std::mt19937 rng(kSeed + 2);
+    const SH9 sh = randomSH9(rng);
+
+    const SH9 same = SHRotation(Matrix4(1.0f)).apply(sh);
+    for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+        CHECK_NEAR(same.c[i], sh.c[i], 1e-6f);
+    }
+
+    const Matrix4 rotation = randomRotation(rng);
+    const SH9 roundTrip = SHRotation(glm::transpose(rotation)).apply(SHRotation(rotation).apply(sh));
+    for (uint32_t i = 0; i < kSHMaxCoefficients; ++i) {
+        CHECK_NEAR(roundTrip.c[i], sh.c[i], 1e-5f);
+    }
+}
+
+// ============================================================================
+// 批量求值
+// ============================================================================
+
+namespace {
+
+template <typename SH>
+void checkBatchMatchesScalar(const SH& sh, std::mt19937& rng) {
+    for (uint32_t count : {0u, 1u, 2u, 3u, 4u, 5u, 7u, 8u, 9u, 1003u}) {
+        // 前面多一个元素，测试未对齐的起始地址
+        std::vector<float> x(count + 1), y(count + 1), z(count + 1);
+        for (uint32_t i = 0; i < count + 1; ++i) {
+            const Vector3 d = randomDirection(rng);
+            x[i] = d.x;
+            y[i] = d.y;
+            z[i] = d.z;
+        }
+        for (uint32_t offset = 0; offset < 2; ++offset) {
+            std::vector<typename SH::Value> out(count + 1, typename SH::Value(12345.0f));
+            EvaluateSHBatch(sh, x.data() + offset, y.data() + offset, z.data() + offset, count, out.data() + offset);
+            for (uint32_t i = 0; i < count; ++i) {
+                const Vector3 d(x[offset + i], y[offset + i], z[offset + i]);
+                const typename SH::Value expected = EvaluateSH(sh, d);
+                const typename SH::Value actual = out[offset + i];
+                if constexpr (std::is_same_v<typename SH::Value, float>) {
+                    CHECK_NEAR(actual, expected, 1e-5f);
+                } else {
+                    CHECK_NEAR(actual.x, expected.x, 1e-5f);
+                    CHECK_NEAR(actual.y, expected.y, 1e-5f);
+                    CHECK_NEAR(actual.z, expected.z, 1e-5f);
+                }
+            }
+            // 不写出 count 之外
+            if (offset == 1) {
+                if constexpr (std::is_same_v<typename SH::Value, float>) {
+                    CHECK(out[0] == 12345.0f);
+                } else {
+                    CHECK(out[0].x == 12345.0f);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("SphericalHarmonics.evaluate/BatchMatchesScalar") {
+    std::mt19937 rng(kSeed + 3);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+    SH4 sh4;
+    SH9 sh9 = randomSH9(rng);
+    SH4RGB sh4rgb;
+    SH9RGB sh9rgb;
+    for (uint32_t i = 0; i < 9; ++i) {
+        if (i < 4) {
+            sh4.c[i] = value(rng);
+            sh4rgb.c[i] = Vector3(value(rng), value(rng), value(rng));
+        }
+        sh9rgb.c[i] = Vector3(value(rng), value(rng), value(rng));
+    }
+
+    checkBatchMatchesScalar(sh4, rng);
+    checkBatchMatchesScalar(sh9, rng);
+    checkBatchMatchesScalar(sh4rgb, rng);
+    checkBatchMatchesScalar(sh9rgb, rng);
+}
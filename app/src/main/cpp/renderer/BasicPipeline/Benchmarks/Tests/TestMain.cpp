@@ -0,0 +1,10 @@
+/**
+ * @file TestMain.cpp
+ * @brief BasicPipeline CPU 单元测试入口（用例由同目录的 *Tests.cpp 注册）
+ */
+
+#include "../TestHarness.h"
+
+int main(int argc, char** argv) {
+    return test::runMain(argc, argv);
+}
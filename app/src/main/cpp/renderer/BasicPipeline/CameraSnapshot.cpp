@@ -0,0 +1,97 @@
+/**
+ * @file CameraSnapshot.cpp
+ * @brief 每帧相机快照实现
+ */
+
+#include "CameraSnapshot.h"
+
+#include <cfloat>
+
+// ============================================================================
+// FrustumPlanesSoA
+// ============================================================================
+
+FrustumPlanesSoA FrustumPlanesSoA::fromFrustum(const Frustum& frustum) {
+    const Plane* planes[PlaneCount] = {
+        &frustum.left, &frustum.right, &frustum.bottom, &frustum.top, &frustum.near, &frustum.far,
+    };
+
+    FrustumPlanesSoA soa;
+    for (uint32_t i = 0; i < PaddedCount; ++i) {
+        if (i < PlaneCount) {
+            soa.nx[i] = planes[i]->a;
+            soa.ny[i] = planes[i]->b;
+            soa.nz[i] = planes[i]->c;
+            soa.d[i] = planes[i]->d;
+        } else {
+            // 补齐平面: 距离恒为 FLT_MAX，永远不会剔除
+            soa.nx[i] = 0.0f;
+            soa.ny[i] = 0.0f;
+            soa.nz[i] = 0.0f;
+            soa.d[i] = FLT_MAX;
+        }
+    }
+    return soa;
+}
+
+// ============================================================================
+// CameraMatrices
+// ============================================================================
+
+CameraMatrices CameraMatrices::make(const Matrix4& view, const Matrix4& projection) {
+    CameraMatrices m;
+    m.view = view;
+    m.projection = projection;
+    m.viewProjection = projection * view;
+    m.invView = glm::inverse(view);
+    m.invProjection = glm::inverse(projection);
+    m.invViewProjection = m.invView * m.invProjection;
+    return m;
+}
+
+// ============================================================================
+// CameraSnapshot
+// ============================================================================
+
+CameraSnapshot CameraSnapshot::build(const CameraSnapshotParams& params, const CameraSnapshot* previous) {
+    CameraSnapshot snapshot;
+    snapshot.frameNumber = params.frameNumber;
+    snapshot.fieldOfView = params.fieldOfView;
+    snapshot.nearPlane = params.nearPlane;
+    snapshot.farPlane = params.farPlane;
+    snapshot.width = params.width > 0 ? params.width : 1;
+    snapshot.height = params.height > 0 ? params.height : 1;
+
+    snapshot.unjittered = CameraMatrices::make(params.viewMatrix, params.projectionMatrix);
+
+    // 抖动: 在裁剪空间平移 jitterNdc * w，透视和正交投影都适用
+    snapshot.jitter = params.jitter;
+    snapshot.jitterNdc = Vector2(2.0f * params.jitter.x / static_cast<float>(snapshot.width),
+                                 2.0f * params.jitter.y / static_cast<float>(snapshot.height));
+    if (params.jitter.x != 0.0f || params.jitter.y != 0.0f) {
+        const Matrix4 offset = glm::translate(Matrix4(1.0f), Vector3(snapshot.jitterNdc, 0.0f));
+        snapshot.jittered = CameraMatrices::make(params.viewMatrix, offset * params.projectionMatrix);
+    } else {
+        snapshot.jittered = snapshot.unjittered;
+    }
+
+    // 相机基向量取自逆视图矩阵（相机看向 -Z）
+    const Matrix4& invView = snapshot.unjittered.invView;
+    snapshot.position = Vector3(invView[3]);
+    snapshot.right = glm::normalize(Vector3(invView[0]));
+    snapshot.up = glm::normalize(Vector3(invView[1]));
+    snapshot.forward = -glm::normalize(Vector3(invView[2]));
+
+    if (previous && previous->frameNumber + 1 == params.frameNumber) {
+        snapshot.previous = previous->unjittered;
+        snapshot.previousJitter = previous->jitter;
+        snapshot.hasPrevious = true;
+    } else {
+        // 第一帧或跳帧（相机切换、暂停后恢复）: 不做重投影
+        snapshot.previous = snapshot.unjittered;
+    }
+
+    snapshot.frustum = Frustum::fromMatrix(snapshot.unjittered.viewProjection);
+    snapshot.frustumPlanes = FrustumPlanesSoA::fromFrustum(snapshot.frustum);
+    return snapshot;
+}
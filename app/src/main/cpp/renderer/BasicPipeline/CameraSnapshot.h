@@ -0,0 +1,166 @@
+/**
+ * @file CameraSnapshot.h
+ * @brief 每帧相机快照 - 不可变的相机矩阵与视锥体，供工作线程无锁读取
+ *
+ * Camera 的矩阵缓存是 mutable 的惰性字段，多个剔除任务同时调用
+ * getViewProjectionMatrix() / getFrustum() 会产生数据竞争，且 getFrustum() 每次都重新提取平面
+ *
+ * CameraSnapshot 在每帧开始时由主线程构建一次，之后只读:
+ * - 视图、投影、视图-投影及其逆矩阵
+ * - 抖动（TAA）与未抖动两套矩阵：光栅化使用抖动矩阵，剔除/运动矢量使用未抖动矩阵
+ * - 上一帧的未抖动矩阵（运动矢量、重投影）
+ * - 视锥体平面（AoS 的 Frustum 和 SoA 布局的 FrustumPlanesSoA）
+ *
+ * 用法:
+ * @code
+ *
+ * // 主线程，每帧一次
+ * snapshot_ = CameraSnapshot::build(params, &snapshot_);
+ * renderingData_.cameraSnapshot = &snapshot_;
+ *
+ * // 任意线程
+ * if (renderingData.cameraSnapshot->isSphereVisible(center, radius)) { ... }
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "Frustum.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+
+// ============================================================================
+// SoA 视锥平面
+// ============================================================================
+
+/**
+ * @brief 视锥平面的 SoA 布局
+ *
+ * 6个平面补齐到8个（补齐平面恒通过），每个分量连续存放并按32字节对齐，
+ * 可以直接按 4/8 宽度加载到 SIMD 寄存器
+ *
+ * 平面顺序: left, right, bottom, top, near, far
+ */
+struct alignas(32) FrustumPlanesSoA {
+    static constexpr uint32_t PlaneCount = 6;
+    static constexpr uint32_t PaddedCount = 8;
+
+    alignas(32) float nx[PaddedCount];
+    alignas(32) float ny[PaddedCount];
+    alignas(32) float nz[PaddedCount];
+    alignas(32) float d[PaddedCount];
+
+    static FrustumPlanesSoA fromFrustum(const Frustum& frustum);
+
+    /**
+     * @brief 球体与视锥体是否相交（与 Frustum::intersectsSphere 等价）
+     */
+    bool intersectsSphere(const Vector3& center, float radius) const {
+        // 无分支，固定8次迭代，编译器可自动向量化
+        bool outside = false;
+        for (uint32_t i = 0; i < PaddedCount; ++i) {
+            const float distance = nx[i] * center.x + ny[i] * center.y + nz[i] * center.z + d[i];
+            outside |= distance < -radius;
+        }
+        return !outside;
+    }
+};
+
+// ============================================================================
+// 相机快照
+// ============================================================================
+
+/**
+ * @brief 一组相机矩阵及其逆矩阵
+ */
+struct CameraMatrices {
+    Matrix4 view = Matrix4(1.0f);
+    Matrix4 projection = Matrix4(1.0f);
+    Matrix4 viewProjection = Matrix4(1.0f);
+    Matrix4 invView = Matrix4(1.0f);
+    Matrix4 invProjection = Matrix4(1.0f);
+    Matrix4 invViewProjection = Matrix4(1.0f);
+
+    static CameraMatrices make(const Matrix4& view, const Matrix4& projection);
+};
+
+/**
+ * @brief 构建快照的输入
+ */
+struct CameraSnapshotParams {
+    Matrix4 viewMatrix = Matrix4(1.0f);
+
+    /** 未抖动的投影矩阵 */
+    Matrix4 projectionMatrix = Matrix4(1.0f);
+
+    /** 渲染目标尺寸（像素，用于把抖动换算到NDC） */
+    uint32_t width = 1;
+    uint32_t height = 1;
+
+    /** 子像素抖动（像素，通常在 [-0.5, 0.5]），为0时抖动矩阵与未抖动矩阵相同 */
+    Vector2 jitter = Vector2(0.0f);
+
+    /** 以下仅用于记录（来自 Camera 组件，没有相机时为0） */
+    float fieldOfView = 0.0f;
+    float nearPlane = 0.0f;
+    float farPlane = 0.0f;
+
+    /** 与上一帧快照的帧号连续时才记录上一帧矩阵 */
+    uint64_t frameNumber = 0;
+};
+
+/**
+ * @brief 不可变的每帧相机快照
+ *
+ * 构建后不再修改，多个线程可以同时读取
+ */
+struct CameraSnapshot {
+    uint64_t frameNumber = 0;
+
+    // 相机空间基
+    Vector3 position = Vector3(0.0f);
+    Vector3 forward = Vector3(0.0f, 0.0f, -1.0f);
+    Vector3 up = Vector3(0.0f, 1.0f, 0.0f);
+    Vector3 right = Vector3(1.0f, 0.0f, 0.0f);
+
+    float fieldOfView = 0.0f;
+    float nearPlane = 0.0f;
+    float farPlane = 0.0f;
+
+    uint32_t width = 1;
+    uint32_t height = 1;
+
+    /** 子像素抖动（像素）及其NDC偏移 */
+    Vector2 jitter = Vector2(0.0f);
+    Vector2 jitterNdc = Vector2(0.0f);
+
+    /** 光栅化使用（含抖动） */
+    CameraMatrices jittered;
+
+    /** 剔除、LOD、运动矢量使用（不含抖动） */
+    CameraMatrices unjittered;
+
+    /** 上一帧的未抖动矩阵（第一帧与当前帧相同） */
+    CameraMatrices previous;
+    Vector2 previousJitter = Vector2(0.0f);
+    bool hasPrevious = false;
+
+    /** 由未抖动的视图-投影矩阵提取 */
+    Frustum frustum;
+    FrustumPlanesSoA frustumPlanes;
+
+    /**
+     * @brief 构建快照
+     * @param previous 上一帧的快照（可为 nullptr；可以与返回值是同一个对象）
+     *                 帧号不连续时（相机切换、暂停后恢复）视为没有上一帧
+     */
+    static CameraSnapshot build(const CameraSnapshotParams& params, const CameraSnapshot* previous = nullptr);
+
+    /**
+     * @brief 球体是否可见（SoA 平面）
+     */
+    bool isSphereVisible(const Vector3& center, float radius) const {
+        return frustumPlanes.intersectsSphere(center, radius);
+    }
+};
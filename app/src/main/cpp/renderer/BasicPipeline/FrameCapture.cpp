@@ -0,0 +1,884 @@
+/**
+ * @file FrameCapture.cpp
+ * @brief 帧捕获与回放实现
+ */
+
+#include "FrameCapture.h"
+#include "Camera.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+constexpr char kFileMagic[4] = {'P', 'F', 'C', 'P'};
+constexpr uint32_t kFrameTag = 0x4D524650;  // "PFRM"
+constexpr uint32_t kVersion = 4;
+
+/** 仍可读取的最低版本（版本 1 没有 shadowmask 字段，版本 2 以前没有区域光，版本 3 以前没有光源标识，读取时取默认值） */
+constexpr uint32_t kMinVersion = 1;
+
+/** FrameHeader::flags */
+namespace FrameFlags {
+    enum : uint32_t {
+        Keyframe = 1 << 0,
+        Lighting = 1 << 1,
+        Shadow = 1 << 2,
+        Features = 1 << 3,
+        Palette = 1 << 4
+    };
+}
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t keyframeInterval;
+    uint32_t reserved;
+};
+
+struct FrameHeader {
+    uint32_t tag;
+    uint32_t payloadSize;
+    uint64_t frameNumber;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<CapturedRenderable>, "CapturedRenderable is written as raw bytes");
+static_assert(sizeof(CapturedRenderable) == 96, "CapturedRenderable must not contain padding");
+
+// ============================================================================
+// 字节流
+// ============================================================================
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    template<typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        putBytes(&value, sizeof(T));
+    }
+
+    void putBytes(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        out_.insert(out_.end(), p, p + size);
+    }
+
+    void putBool(bool value) { put<uint8_t>(value ? 1 : 0); }
+
+    void putString(const std::string& s) {
+        put<uint32_t>(static_cast<uint32_t>(s.size()));
+        putBytes(s.data(), s.size());
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+};
+
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    template<typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return getBytes(&value, sizeof(T));
+    }
+
+    bool getBytes(void* out, size_t size) {
+        if (size > size_ - offset_) {
+            return false;
+        }
+        std::memcpy(out, data_ + offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+    bool getBool(bool& value) {
+        uint8_t v = 0;
+        if (!get(v)) return false;
+        value = v != 0;
+        return true;
+    }
+
+    bool getString(std::string& s) {
+        uint32_t length = 0;
+        if (!get(length) || length > size_ - offset_) return false;
+        s.assign(reinterpret_cast<const char*>(data_ + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+    /** 读取数组长度并检查剩余字节是否足够 */
+    bool getCount(uint32_t& count, size_t elementSize) {
+        if (!get(count)) return false;
+        return static_cast<uint64_t>(count) * elementSize <= size_ - offset_;
+    }
+
+    bool atEnd() const { return offset_ == size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
+// ============================================================================
+// 区块序列化（逐字段写入，结果与结构体填充字节无关）
+// ============================================================================
+
+void writeLight(ByteWriter& w, const LightData& l) {
+    w.put(static_cast<uint32_t>(l.type));
+    w.put(l.color);
+    w.put(l.intensity);
+    w.put(l.range);
+    w.put(l.direction);
+    w.put(l.position);
+    w.put(static_cast<uint32_t>(l.attenuation));
+    w.put(l.innerAngle);
+    w.put(l.outerAngle);
+    w.putBool(l.castShadows);
+    w.put(l.shadowStrength);
+    w.put(l.shadowBias);
+    w.put(l.shadowNearPlane);
+    w.put(static_cast<uint32_t>(l.lightMode));
+    w.putBool(l.affectLightmappedSurfaces);
+    w.put(l.shadowmaskChannel);
+    w.put(static_cast<uint32_t>(l.areaShape));
+    w.put(l.areaSize);
+    w.put(l.areaTangent);
+    w.putBool(l.areaTwoSided);
+    w.put(l.id);
+}
+
+bool readLight(ByteReader& r, LightData& l, uint32_t version) {
+    uint32_t type = 0, attenuation = 0, mode = 0, shape = 0;
+    bool ok = r.get(type) && r.get(l.color) && r.get(l.intensity) && r.get(l.range)
+           && r.get(l.direction) && r.get(l.position) && r.get(attenuation)
+           && r.get(l.innerAngle) && r.get(l.outerAngle) && r.getBool(l.castShadows)
+           && r.get(l.shadowStrength) && r.get(l.shadowBias) && r.get(l.shadowNearPlane)
+           && r.get(mode) && r.getBool(l.affectLightmappedSurfaces);
+    l.shadowmaskChannel = -1;
+    if (version >= 2) {
+        ok = ok && r.get(l.shadowmaskChannel);
+    }
+    if (version >= 3) {
+        ok = ok && r.get(shape) && r.get(l.areaSize) && r.get(l.areaTangent) && r.getBool(l.areaTwoSided);
+    }
+    l.id = 0;
+    if (version >= 4) {
+        ok = ok && r.get(l.id);
+    }
+    l.type = static_cast<LightType>(type);
+    l.areaShape = static_cast<AreaLightShape>(shape);
+    l.attenuation = static_cast<LightData::Attenuation>(attenuation);
+    l.lightMode = static_cast<LightMode>(mode);
+    return ok;
+}
+
+constexpr size_t kMinLightBytes = 4 * 4 + 12 * 3 + 4 * 5 + 2;
+
+void writeLightList(ByteWriter& w, const LightDataList& lights) {
+    w.put<uint32_t>(static_cast<uint32_t>(lights.size()));
+    for (const auto& l : lights) {
+        writeLight(w, l);
+    }
+}
+
+bool readLightList(ByteReader& r, LightDataList& lights, uint32_t version) {
+    uint32_t count = 0;
+    if (!r.getCount(count, kMinLightBytes)) return false;
+    lights.resize(count);
+    for (auto& l : lights) {
+        if (!readLight(r, l, version)) return false;
+    }
+    return true;
+}
+
+void writeLighting(ByteWriter& w, const LightingData& d) {
+    writeLightList(w, d.directionalLights);
+    writeLightList(w, d.pointLights);
+    writeLightList(w, d.spotLights);
+    writeLightList(w, d.areaLights);
+    w.put(d.ambientColor);
+    w.put(d.ambientIntensity);
+    w.putBool(d.enableGI);
+    w.put<uint32_t>(static_cast<uint32_t>(d.lightProbes.size()));
+    for (const auto& probe : d.lightProbes) {
+        w.put(probe.position);
+        w.putBytes(probe.sphericalHarmonics, sizeof(probe.sphericalHarmonics));
+    }
+    w.put(d.maxLightsPerFrame);
+    w.put(d.maxLightRange);
+}
+
+bool readLighting(ByteReader& r, LightingData& d, uint32_t version) {
+    if (!readLightList(r, d.directionalLights, version) || !readLightList(r, d.pointLights, version)
+        || !readLightList(r, d.spotLights, version)) {
+        return false;
+    }
+    d.areaLights.clear();
+    if (version >= 3 && !readLightList(r, d.areaLights, version)) {
+        return false;
+    }
+    uint32_t probeCount = 0;
+    if (!r.get(d.ambientColor) || !r.get(d.ambientIntensity) || !r.getBool(d.enableGI)
+        || !r.getCount(probeCount, sizeof(LightingData::LightProbe))) {
+        return false;
+    }
+    d.lightProbes.resize(probeCount);
+    for (auto& probe : d.lightProbes) {
+        if (!r.get(probe.position) || !r.getBytes(probe.sphericalHarmonics, sizeof(probe.sphericalHarmonics))) {
+            return false;
+        }
+    }
+    d.ambientLightmap = nullptr;
+    return r.get(d.maxLightsPerFrame) && r.get(d.maxLightRange);
+}
+
+void writeShadow(ByteWriter& w, const ShadowSettings& s) {
+    w.putBool(s.enableShadows);
+    w.put(static_cast<uint32_t>(s.defaultShadowType));
+    w.put(s.maxShadowMaps);
+    w.put(s.shadowMapArraySize);
+    w.put(s.shadowDistance);
+    w.put(s.shadowFadeDistance);
+    w.putBool(s.enableCascadedShadows);
+
+    const CascadedShadowSettings& c = s.cascadedSettings;
+    w.put(c.cascadeCount);
+    w.put(static_cast<uint32_t>(c.splitScheme));
+    w.put<uint32_t>(static_cast<uint32_t>(c.manualSplits.size()));
+    w.putBytes(c.manualSplits.data(), c.manualSplits.size() * sizeof(float));
+    w.put(static_cast<uint32_t>(c.resolution));
+    w.put(c.transitionSize);
+    w.putBool(c.enableCascadeBlending);
+
+    w.put(static_cast<uint32_t>(s.filterSettings.filterType));
+    w.put(s.filterSettings.sampleRadius);
+    w.put(s.filterSettings.sampleCount);
+
+    w.put(s.maxShadowCastingLightsPerFrame);
+    w.putBool(s.enableShadowCulling);
+    w.putBool(s.enableDepthPrepassForShadows);
+    w.putBool(s.useBidirectionalDepthBias);
+    w.put(s.depthBiasScale);
+    w.put(s.normalBiasScale);
+
+    w.putBool(s.enableShadowmask);
+    w.put(s.shadowmaskShadowDistance);
+}
+
+bool readShadow(ByteReader& r, ShadowSettings& s, uint32_t version) {
+    uint32_t shadowType = 0, splitScheme = 0, splitCount = 0, resolution = 0, filterType = 0;
+    CascadedShadowSettings& c = s.cascadedSettings;
+
+    if (!r.getBool(s.enableShadows) || !r.get(shadowType) || !r.get(s.maxShadowMaps)
+        || !r.get(s.shadowMapArraySize) || !r.get(s.shadowDistance) || !r.get(s.shadowFadeDistance)
+        || !r.getBool(s.enableCascadedShadows) || !r.get(c.cascadeCount) || !r.get(splitScheme)
+        || !r.getCount(splitCount, sizeof(float))) {
+        return false;
+    }
+    c.manualSplits.resize(splitCount);
+    if (!r.getBytes(c.manualSplits.data(), splitCount * sizeof(float))
+        || !r.get(resolution) || !r.get(c.transitionSize) || !r.getBool(c.enableCascadeBlending)
+        || !r.get(filterType) || !r.get(s.filterSettings.sampleRadius) || !r.get(s.filterSettings.sampleCount)
+        || !r.get(s.maxShadowCastingLightsPerFrame) || !r.getBool(s.enableShadowCulling)
+        || !r.getBool(s.enableDepthPrepassForShadows) || !r.getBool(s.useBidirectionalDepthBias)
+        || !r.get(s.depthBiasScale) || !r.get(s.normalBiasScale)) {
+        return false;
+    }
+
+    const ShadowSettings defaults;
+    s.enableShadowmask = defaults.enableShadowmask;
+    s.shadowmaskShadowDistance = defaults.shadowmaskShadowDistance;
+    if (version >= 2 && (!r.getBool(s.enableShadowmask) || !r.get(s.shadowmaskShadowDistance))) {
+        return false;
+    }
+
+    s.defaultShadowType = static_cast<ShadowType>(shadowType);
+    c.splitScheme = static_cast<CascadedShadowSettings::SplitScheme>(splitScheme);
+    c.resolution = static_cast<ShadowResolution>(resolution);
+    s.filterSettings.filterType = static_cast<ShadowFilterSettings::FilterType>(filterType);
+    return true;
+}
+
+void writeFeatures(ByteWriter& w, const RenderFeatureManager* manager) {
+    if (!manager) {
+        w.put<uint32_t>(0);
+        return;
+    }
+    const auto& features = manager->GetAllFeatures();
+    w.put<uint32_t>(static_cast<uint32_t>(features.size()));
+    for (const auto& f : features) {
+        w.putString(f->GetName());
+        w.put(static_cast<uint32_t>(f->GetPassEvent()));
+        w.put<int32_t>(f->GetOrder());
+        w.putBool(f->IsActive());
+    }
+}
+
+bool readFeatures(ByteReader& r, std::vector<CapturedFeature>& features) {
+    uint32_t count = 0;
+    if (!r.getCount(count, 4 + 4 + 4 + 1)) return false;
+    features.resize(count);
+    for (auto& f : features) {
+        uint32_t evt = 0;
+        if (!r.getString(f.name) || !r.get(evt) || !r.get(f.order) || !r.getBool(f.active)) {
+            return false;
+        }
+        f.passEvent = static_cast<RenderPassEvent>(evt);
+    }
+    return true;
+}
+
+void packFace(ByteWriter& w, const StencilFaceState& f) {
+    w.put(static_cast<uint32_t>(f.compareFunc));
+    w.put(f.reference);
+    w.put(f.compareMask);
+    w.put(f.writeMask);
+    w.put(static_cast<uint32_t>(f.failOp));
+    w.put(static_cast<uint32_t>(f.depthFailOp));
+    w.put(static_cast<uint32_t>(f.passOp));
+}
+
+bool unpackFace(ByteReader& r, StencilFaceState& f) {
+    uint32_t func = 0, fail = 0, depthFail = 0, pass = 0;
+    if (!r.get(func) || !r.get(f.reference) || !r.get(f.compareMask) || !r.get(f.writeMask)
+        || !r.get(fail) || !r.get(depthFail) || !r.get(pass)) {
+        return false;
+    }
+    f.compareFunc = static_cast<StencilCompareFunc>(func);
+    f.failOp = static_cast<StencilOp>(fail);
+    f.depthFailOp = static_cast<StencilOp>(depthFail);
+    f.passOp = static_cast<StencilOp>(pass);
+    return true;
+}
+
+/** 每个调色板条目的打包大小 */
+constexpr size_t kPackedStateBytes = 1 + 1 + 4 + 1 + 4 + 4 + 1 + 28 * 2;
+
+void packState(std::vector<uint8_t>& out, const DepthState& d, const StencilState& s) {
+    ByteWriter w(out);
+    w.putBool(d.depthTestEnable);
+    w.putBool(d.depthWriteEnable);
+    w.put(static_cast<uint32_t>(d.depthCompareFunc));
+    w.putBool(d.depthBoundsTestEnable);
+    w.put(d.minDepthBounds);
+    w.put(d.maxDepthBounds);
+    w.putBool(s.enable);
+    packFace(w, s.front);
+    packFace(w, s.back);
+}
+
+bool unpackState(ByteReader& r, CapturedRenderState& state) {
+    DepthState& d = state.depthState;
+    uint32_t func = 0;
+    if (!r.getBool(d.depthTestEnable) || !r.getBool(d.depthWriteEnable) || !r.get(func)
+        || !r.getBool(d.depthBoundsTestEnable) || !r.get(d.minDepthBounds) || !r.get(d.maxDepthBounds)
+        || !r.getBool(state.stencilState.enable)
+        || !unpackFace(r, state.stencilState.front) || !unpackFace(r, state.stencilState.back)) {
+        return false;
+    }
+    d.depthCompareFunc = static_cast<DepthCompareFunc>(func);
+    return true;
+}
+
+bool sameState(const RenderableColdData& cold, const CapturedRenderState& state) {
+    static thread_local std::vector<uint8_t> a, b;
+    a.clear();
+    b.clear();
+    packState(a, cold.depthState, cold.stencilState);
+    packState(b, state.depthState, state.stencilState);
+    return a == b;
+}
+
+bool sameRenderable(const CapturedRenderable& a, const CapturedRenderable& b) {
+    return std::memcmp(&a, &b, sizeof(CapturedRenderable)) == 0;
+}
+
+} // namespace
+
+// ============================================================================
+// CapturedRenderable / CapturedFrame
+// ============================================================================
+
+Matrix4 CapturedRenderable::getWorldMatrix() const {
+    Matrix4 m(1.0f);
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            m[col][row] = affine[row * 4 + col];
+        }
+    }
+    return m;
+}
+
+void CapturedRenderable::setWorldMatrix(const Matrix4& m) {
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            affine[row * 4 + col] = m[col][row];
+        }
+    }
+}
+
+RenderingData CapturedFrame::toRenderingData() {
+    RenderingData data = RenderingData::create();
+    data.viewMatrix = camera.viewMatrix;
+    data.projectionMatrix = camera.projectionMatrix;
+    data.viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
+    data.cameraPosition = camera.position;
+    data.time = time;
+    data.deltaTime = deltaTime;
+    data.lightingData = &lighting;
+    data.shadowSettings = &shadowSettings;
+    data.screenWidth = screenWidth;
+    data.screenHeight = screenHeight;
+    data.enableShadows = enableShadows;
+    data.enablePostProcessing = enablePostProcessing;
+    data.debugView = debugView;
+    return data;
+}
+
+// ============================================================================
+// FrameCaptureWriter
+// ============================================================================
+
+bool FrameCaptureWriter::open(const std::string& path, uint32_t keyframeInterval) {
+    close();
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+
+    keyframeInterval_ = keyframeInterval;
+    forceKeyframe_ = true;
+    frameNumber_ = 0;
+    lastLighting_.clear();
+    lastShadow_.clear();
+    lastFeatures_.clear();
+    lastRenderables_.clear();
+    paletteIndex_.clear();
+    palette_.clear();
+    paletteWritten_ = 0;
+    stats_ = Stats();
+
+    FileHeader header{};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kVersion;
+    header.keyframeInterval = keyframeInterval;
+    std::fwrite(&header, sizeof(header), 1, file_);
+    stats_.bytesWritten += sizeof(header);
+    return true;
+}
+
+void FrameCaptureWriter::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+uint32_t FrameCaptureWriter::internState(const DepthState& depth, const StencilState& stencil) {
+    scratch_.clear();
+    packState(scratch_, depth, stencil);
+    std::string key(scratch_.begin(), scratch_.end());
+
+    auto it = paletteIndex_.find(key);
+    if (it != paletteIndex_.end()) {
+        return it->second;
+    }
+    const uint32_t index = static_cast<uint32_t>(palette_.size());
+    paletteIndex_.emplace(key, index);
+    palette_.push_back(std::move(key));
+    return index;
+}
+
+bool FrameCaptureWriter::writeFrame(const RenderingData& renderingData,
+                                    const RenderableStorage& storage,
+                                    const RenderFeatureManager* features) {
+    if (!file_) {
+        return false;
+    }
+
+    const bool keyframe = forceKeyframe_
+        || (keyframeInterval_ > 0 && frameNumber_ % keyframeInterval_ == 0);
+    forceKeyframe_ = false;
+
+    // ------------------------------------------------------------------
+    // 对象列表：与上一帧比较得到增量
+    // ------------------------------------------------------------------
+
+    const size_t count = storage.size();
+    const RenderableBounds* bounds = storage.getBounds();
+    const Matrix4* matrices = storage.getWorldMatrices();
+    const RenderableMaterial* materials = storage.getMaterials();
+    const RenderableGeometry* geometry = storage.getGeometry();
+    const uint32_t* queueIDs = storage.getQueueIDs();
+    const uint32_t* flags = storage.getFlags();
+    const RenderableColdData* cold = storage.getColdData();
+    const RenderableHandle* handles = storage.getHandles();
+
+    current_.clear();
+    current_.reserve(count);
+    changed_.clear();
+    removed_.clear();
+
+    for (size_t i = 0; i < count; ++i) {
+        CapturedRenderable r;
+        r.id = static_cast<uint64_t>(handles[i]);
+        r.setWorldMatrix(matrices[i]);
+        r.center = bounds[i].center;
+        r.radius = bounds[i].radius;
+        r.materialID = materials[i].materialID;
+        r.queueID = queueIDs[i];
+        r.flags = flags[i];
+        r.subMeshIndex = geometry[i].subMeshIndex;
+        r.stateIndex = internState(cold[i].depthState, cold[i].stencilState);
+
+        if (!keyframe) {
+            auto it = lastRenderables_.find(r.id);
+            if (it == lastRenderables_.end() || !sameRenderable(it->second, r)) {
+                changed_.push_back(r);
+            }
+        } else {
+            changed_.push_back(r);
+        }
+        current_.emplace(r.id, r);
+    }
+
+    if (!keyframe) {
+        for (const auto& [id, r] : lastRenderables_) {
+            if (current_.find(id) == current_.end()) {
+                removed_.push_back(id);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // 光照/阴影/Feature：序列化后与上一帧的字节比较
+    // ------------------------------------------------------------------
+
+    uint32_t frameFlags = keyframe ? static_cast<uint32_t>(FrameFlags::Keyframe) : 0u;
+
+    auto serializeBlock = [&](std::vector<uint8_t>& last, uint32_t flag, auto&& writeBlock) {
+        scratch_.clear();
+        ByteWriter w(scratch_);
+        writeBlock(w);
+        if (keyframe || scratch_ != last) {
+            frameFlags |= flag;
+            last.swap(scratch_);
+        }
+    };
+
+    static const LightingData emptyLighting;
+    static const ShadowSettings defaultShadow = ShadowSettings::defaultSettings();
+    const LightingData& lighting = renderingData.lightingData ? *renderingData.lightingData : emptyLighting;
+    const ShadowSettings& shadow = renderingData.shadowSettings ? *renderingData.shadowSettings : defaultShadow;
+
+    serializeBlock(lastLighting_, FrameFlags::Lighting, [&](ByteWriter& w) { writeLighting(w, lighting); });
+    serializeBlock(lastShadow_, FrameFlags::Shadow, [&](ByteWriter& w) { writeShadow(w, shadow); });
+    serializeBlock(lastFeatures_, FrameFlags::Features, [&](ByteWriter& w) { writeFeatures(w, features); });
+
+    const uint32_t paletteFirst = keyframe ? 0 : paletteWritten_;
+    if (paletteFirst < palette_.size()) {
+        frameFlags |= FrameFlags::Palette;
+    }
+
+    // ------------------------------------------------------------------
+    // 组装负载
+    // ------------------------------------------------------------------
+
+    buffer_.clear();
+    buffer_.resize(sizeof(FrameHeader));
+    ByteWriter w(buffer_);
+
+    // 相机与 RenderingData
+    CapturedCamera camera;
+    camera.viewMatrix = renderingData.viewMatrix;
+    camera.projectionMatrix = renderingData.projectionMatrix;
+    camera.position = renderingData.cameraPosition;
+    if (renderingData.camera) {
+        camera.fieldOfView = renderingData.camera->getFieldOfView();
+        camera.nearPlane = renderingData.camera->getNearPlane();
+        camera.farPlane = renderingData.camera->getFarPlane();
+    }
+    w.put(camera.viewMatrix);
+    w.put(camera.projectionMatrix);
+    w.put(camera.position);
+    w.put(camera.fieldOfView);
+    w.put(camera.nearPlane);
+    w.put(camera.farPlane);
+    w.put(renderingData.time);
+    w.put(renderingData.deltaTime);
+    w.put(renderingData.screenWidth);
+    w.put(renderingData.screenHeight);
+    w.putBool(renderingData.enableShadows);
+    w.putBool(renderingData.enablePostProcessing);
+    w.putBool(renderingData.debugView);
+
+    if (frameFlags & FrameFlags::Lighting) w.putBytes(lastLighting_.data(), lastLighting_.size());
+    if (frameFlags & FrameFlags::Shadow) w.putBytes(lastShadow_.data(), lastShadow_.size());
+    if (frameFlags & FrameFlags::Features) w.putBytes(lastFeatures_.data(), lastFeatures_.size());
+
+    if (frameFlags & FrameFlags::Palette) {
+        w.put<uint32_t>(paletteFirst);
+        w.put<uint32_t>(static_cast<uint32_t>(palette_.size()) - paletteFirst);
+        for (size_t i = paletteFirst; i < palette_.size(); ++i) {
+            w.putBytes(palette_[i].data(), palette_[i].size());
+        }
+        paletteWritten_ = static_cast<uint32_t>(palette_.size());
+    }
+
+    if (!keyframe) {
+        w.put<uint32_t>(static_cast<uint32_t>(removed_.size()));
+        w.putBytes(removed_.data(), removed_.size() * sizeof(uint64_t));
+    }
+    w.put<uint32_t>(static_cast<uint32_t>(changed_.size()));
+    w.putBytes(changed_.data(), changed_.size() * sizeof(CapturedRenderable));
+
+    FrameHeader header{};
+    header.tag = kFrameTag;
+    header.payloadSize = static_cast<uint32_t>(buffer_.size() - sizeof(FrameHeader));
+    header.frameNumber = frameNumber_;
+    header.flags = frameFlags;
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+
+    const bool ok = std::fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size();
+    std::fflush(file_);
+
+    lastRenderables_.swap(current_);
+    ++frameNumber_;
+
+    ++stats_.frames;
+    stats_.keyframes += keyframe ? 1 : 0;
+    stats_.bytesWritten += buffer_.size();
+    stats_.renderablesWritten += changed_.size();
+    return ok;
+}
+
+// ============================================================================
+// FrameCaptureReader
+// ============================================================================
+
+bool FrameCaptureReader::open(const std::string& path) {
+    close();
+    error_.clear();
+
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) {
+        return fail("cannot open file");
+    }
+
+    FileHeader header{};
+    if (std::fread(&header, sizeof(header), 1, file_) != 1
+        || std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0) {
+        close();
+        return fail("not a frame capture");
+    }
+    if (header.version < kMinVersion || header.version > kVersion) {
+        close();
+        return fail("unsupported capture version");
+    }
+
+    version_ = header.version;
+    keyframeInterval_ = header.keyframeInterval;
+    dataStart_ = std::ftell(file_);
+    haveKeyframe_ = false;
+    return true;
+}
+
+void FrameCaptureReader::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void FrameCaptureReader::rewind() {
+    if (file_) {
+        std::fseek(file_, dataStart_, SEEK_SET);
+        haveKeyframe_ = false;
+    }
+}
+
+bool FrameCaptureReader::fail(const char* message) {
+    error_ = message;
+    return false;
+}
+
+bool FrameCaptureReader::readFrame(CapturedFrame& frame) {
+    if (!file_) {
+        return false;
+    }
+
+    FrameHeader header{};
+    for (;;) {
+        // 文件末尾（包括录制中断时被截断的最后一帧）
+        if (std::fread(&header, sizeof(header), 1, file_) != 1) {
+            return false;
+        }
+        if (header.tag != kFrameTag) {
+            return fail("corrupt frame header");
+        }
+        buffer_.resize(header.payloadSize);
+        if (std::fread(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+            return false;
+        }
+
+        // 从中途开始读取时跳过第一个关键帧之前的增量帧
+        if ((header.flags & FrameFlags::Keyframe) || haveKeyframe_) {
+            break;
+        }
+    }
+
+    ByteReader r(buffer_.data(), buffer_.size());
+
+    frame.frameNumber = header.frameNumber;
+    frame.keyframe = (header.flags & FrameFlags::Keyframe) != 0;
+    frame.lightingChanged = (header.flags & FrameFlags::Lighting) != 0;
+    frame.shadowChanged = (header.flags & FrameFlags::Shadow) != 0;
+    frame.featuresChanged = (header.flags & FrameFlags::Features) != 0;
+
+    CapturedCamera& cam = frame.camera;
+    if (!r.get(cam.viewMatrix) || !r.get(cam.projectionMatrix) || !r.get(cam.position)
+        || !r.get(cam.fieldOfView) || !r.get(cam.nearPlane) || !r.get(cam.farPlane)
+        || !r.get(frame.time) || !r.get(frame.deltaTime)
+        || !r.get(frame.screenWidth) || !r.get(frame.screenHeight)
+        || !r.getBool(frame.enableShadows) || !r.getBool(frame.enablePostProcessing)
+        || !r.getBool(frame.debugView)) {
+        return fail("truncated camera block");
+    }
+
+    if (frame.lightingChanged && !readLighting(r, lighting_, version_)) {
+        return fail("truncated lighting block");
+    }
+    if (frame.shadowChanged && !readShadow(r, shadowSettings_, version_)) {
+        return fail("truncated shadow block");
+    }
+    if (frame.featuresChanged && !readFeatures(r, features_)) {
+        return fail("truncated feature block");
+    }
+
+    if (header.flags & FrameFlags::Palette) {
+        uint32_t first = 0, count = 0;
+        if (!r.get(first) || first > palette_.size() || !r.getCount(count, kPackedStateBytes)) {
+            return fail("corrupt state palette");
+        }
+        palette_.resize(first + count);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!unpackState(r, palette_[first + i])) {
+                return fail("corrupt state palette");
+            }
+        }
+    }
+
+    frame.removed.clear();
+    if (!frame.keyframe) {
+        uint32_t removedCount = 0;
+        if (!r.getCount(removedCount, sizeof(uint64_t))) {
+            return fail("truncated renderable block");
+        }
+        frame.removed.resize(removedCount);
+        r.getBytes(frame.removed.data(), removedCount * sizeof(uint64_t));
+    }
+
+    uint32_t renderableCount = 0;
+    if (!r.getCount(renderableCount, sizeof(CapturedRenderable))) {
+        return fail("truncated renderable block");
+    }
+    frame.renderables.resize(renderableCount);
+    r.getBytes(frame.renderables.data(), renderableCount * sizeof(CapturedRenderable));
+
+    for (const auto& rend : frame.renderables) {
+        if (rend.stateIndex >= palette_.size()) {
+            return fail("renderable references missing render state");
+        }
+    }
+
+    frame.lighting = lighting_;
+    frame.shadowSettings = shadowSettings_;
+    frame.features = features_;
+    frame.statePalette = palette_;
+
+    haveKeyframe_ = true;
+    return true;
+}
+
+// ============================================================================
+// CapturePlayback
+// ============================================================================
+
+RenderableDesc CapturePlayback::toDesc(const CapturedRenderable& r, const CapturedFrame& frame) {
+    RenderableDesc desc;
+    desc.name = "Captured";
+    desc.worldMatrix = r.getWorldMatrix();
+    desc.center = r.center;
+    desc.radius = r.radius;
+    desc.materialID = r.materialID;
+    desc.subMeshIndex = r.subMeshIndex;
+    desc.queueID = r.queueID;
+    desc.flags = r.flags;
+
+    const CapturedRenderState& state = frame.statePalette[r.stateIndex];
+    desc.depthState = state.depthState;
+    desc.stencilState = state.stencilState;
+    return desc;
+}
+
+void CapturePlayback::apply(const CapturedFrame& frame, RenderableStorage& storage) {
+    if (frame.keyframe) {
+        storage.clear();
+        handles_.clear();
+        storage.reserve(frame.renderables.size());
+    }
+
+    for (uint64_t id : frame.removed) {
+        auto it = handles_.find(id);
+        if (it != handles_.end()) {
+            storage.destroy(it->second);
+            handles_.erase(it);
+        }
+    }
+
+    for (const auto& r : frame.renderables) {
+        auto it = handles_.find(r.id);
+        if (it == handles_.end()) {
+            handles_.emplace(r.id, storage.create(toDesc(r, frame)));
+            continue;
+        }
+
+        // 深度/模板状态存放在冷数据中，没有单独的修改接口，变化时重建
+        const RenderableHandle handle = it->second;
+        const uint32_t dense = storage.getDenseIndex(handle);
+        if (!sameState(storage.getColdData()[dense], frame.statePalette[r.stateIndex])) {
+            storage.destroy(handle);
+            it->second = storage.create(toDesc(r, frame));
+            continue;
+        }
+
+        storage.setTransform(handle, r.getWorldMatrix(), r.center, r.radius);
+        storage.setMaterial(handle, nullptr, r.materialID);
+        storage.setGeometry(handle, nullptr, r.subMeshIndex);
+        storage.setQueueID(handle, r.queueID);
+        storage.setFlags(handle, r.flags);
+    }
+}
+
+uint32_t CapturePlayback::applyFeatures(const CapturedFrame& frame, RenderFeatureManager& manager) {
+    uint32_t missing = 0;
+    for (const auto& captured : frame.features) {
+        IRenderFeature* feature = manager.GetFeature(captured.name.c_str());
+        if (!feature) {
+            ++missing;
+            continue;
+        }
+        feature->SetActive(captured.active);
+        feature->SetPassEvent(captured.passEvent);
+        feature->SetOrder(captured.order);
+    }
+    return missing;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file FrameCapture.h
+ * @brief 帧捕获与回放 - 序列化 BasicRenderer::Render 的全部输入
+ *
+ * 捕获内容:
+ * - RenderingData（相机矩阵、时间、分辨率、开关）及相机参数
+ * - LightingData、ShadowSettings
+ * - 完整的可渲染对象列表（RenderableStorage）
+ * - Feature 配置（名称、插入点、顺序、激活状态）
+ *
+ * 文件格式（小端，流式追加）:
+ *
+ *   FileHeader
+ *   FrameHeader | Camera | [Lighting] | [Shadow] | [Features] | [StatePalette] | Renderables
+ *   FrameHeader | ...
+ *
+ * - 每 keyframeInterval 帧写一个关键帧：包含所有区块和完整对象列表
+ * - 其余为增量帧：光照/阴影/Feature 只在变化时写入，对象只写新增/修改/删除
+ * - 深度/模板状态去重为调色板，对象只保存索引
+ * - 世界矩阵只保存前3行（仿射变换）
+ *
+ * 任何关键帧都可以作为回放起点，捕获可以边录边写（崩溃时已写入的帧仍然可读）
+ * 读取端兼容旧版本文件（版本 1 没有 shadowmask 字段、版本 2 以前没有区域光、版本 3 以前没有光源标识，读出默认值）
+ *
+ * 指针类数据（GameObject、Material、几何体句柄、名称）不序列化，回放时为空
+ */
+
+#pragma once
+
+#include "RenderingData.h"
+#include "LightingData.h"
+#include "ShadowSettings.h"
+#include "RenderableStorage.h"
+#include "IRenderFeature.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// 捕获数据
+// ============================================================================
+
+/**
+ * @brief 相机状态
+ */
+struct CapturedCamera {
+    Matrix4 viewMatrix = Matrix4(1.0f);
+    Matrix4 projectionMatrix = Matrix4(1.0f);
+    Vector3 position = Vector3(0.0f);
+
+    /** 来自 Camera 组件（没有相机时为0） */
+    float fieldOfView = 0.0f;
+    float nearPlane = 0.0f;
+    float farPlane = 0.0f;
+};
+
+/**
+ * @brief 单个可渲染对象
+ */
+struct CapturedRenderable {
+    /** RenderableHandle 的 64 位值（跨帧稳定） */
+    uint64_t id = 0;
+
+    /** 世界矩阵前3行（行主序） */
+    float affine[12] = {};
+
+    Vector3 center = Vector3(0.0f);
+    float radius = 0.0f;
+
+    uint64_t materialID = 0;
+    uint32_t queueID = 0;
+    uint32_t flags = 0;
+    int32_t subMeshIndex = -1;
+
+    /** 渲染状态调色板索引 */
+    uint32_t stateIndex = 0;
+
+    Matrix4 getWorldMatrix() const;
+    void setWorldMatrix(const Matrix4& m);
+};
+
+/**
+ * @brief 深度 + 模板状态（调色板条目）
+ */
+struct CapturedRenderState {
+    DepthState depthState;
+    StencilState stencilState;
+};
+
+/**
+ * @brief Feature 配置
+ */
+struct CapturedFeature {
+    std::string name;
+    RenderPassEvent passEvent = RenderPassEvent::AfterRenderingOpaques;
+    int32_t order = 0;
+    bool active = true;
+};
+
+/**
+ * @brief 一帧的捕获数据
+ *
+ * 读取时光照、阴影、Feature 和调色板总是完整的（增量帧沿用之前的值）
+ */
+struct CapturedFrame {
+    uint64_t frameNumber = 0;
+    bool keyframe = false;
+
+    // RenderingData
+    CapturedCamera camera;
+    float time = 0.0f;
+    float deltaTime = 0.0f;
+    uint32_t screenWidth = 0;
+    uint32_t screenHeight = 0;
+    bool enableShadows = true;
+    bool enablePostProcessing = true;
+    bool debugView = false;
+
+    LightingData lighting;
+    ShadowSettings shadowSettings;
+    std::vector<CapturedFeature> features;
+    std::vector<CapturedRenderState> statePalette;
+
+    /** 关键帧: 完整列表；增量帧: 新增或修改的对象 */
+    std::vector<CapturedRenderable> renderables;
+
+    /** 增量帧: 删除的对象 id */
+    std::vector<uint64_t> removed;
+
+    /** 本帧哪些区块发生了变化 */
+    bool lightingChanged = false;
+    bool shadowChanged = false;
+    bool featuresChanged = false;
+
+    /**
+     * @brief 还原 RenderingData（lightingData/shadowSettings 指向本帧数据）
+     */
+    RenderingData toRenderingData();
+};
+
+// ============================================================================
+// 写入
+// ============================================================================
+
+/**
+ * @brief 帧捕获写入器
+ */
+class FrameCaptureWriter {
+public:
+    static constexpr uint32_t DefaultKeyframeInterval = 60;
+
+    FrameCaptureWriter() = default;
+    ~FrameCaptureWriter() { close(); }
+
+    FrameCaptureWriter(const FrameCaptureWriter&) = delete;
+    FrameCaptureWriter& operator=(const FrameCaptureWriter&) = delete;
+
+    /**
+     * @brief 打开捕获文件
+     * @param keyframeInterval 关键帧间隔（帧），0 表示只有第一帧是关键帧
+     */
+    bool open(const std::string& path, uint32_t keyframeInterval = DefaultKeyframeInterval);
+
+    void close();
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    /**
+     * @brief 写入一帧
+     *
+     * lightingData / shadowSettings 从 renderingData 的指针读取（可为空）
+     *
+     * @param features Feature 管理器（可为 nullptr）
+     */
+    bool writeFrame(const RenderingData& renderingData,
+                    const RenderableStorage& storage,
+                    const RenderFeatureManager* features = nullptr);
+
+    /**
+     * @brief 下一帧强制写关键帧
+     */
+    void requestKeyframe() { forceKeyframe_ = true; }
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t keyframes = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t renderablesWritten = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+
+private:
+    uint32_t internState(const DepthState& depth, const StencilState& stencil);
+
+    FILE* file_ = nullptr;
+    uint32_t keyframeInterval_ = DefaultKeyframeInterval;
+    bool forceKeyframe_ = true;
+    uint64_t frameNumber_ = 0;
+
+    // 上一帧写出的状态，用于增量比较
+    std::vector<uint8_t> lastLighting_;
+    std::vector<uint8_t> lastShadow_;
+    std::vector<uint8_t> lastFeatures_;
+    std::unordered_map<uint64_t, CapturedRenderable> lastRenderables_;
+
+    /** 渲染状态调色板（按字段打包后的字节作为键） */
+    std::unordered_map<std::string, uint32_t> paletteIndex_;
+    std::vector<std::string> palette_;
+    uint32_t paletteWritten_ = 0;
+
+    // 复用的缓冲
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t> scratch_;
+    std::vector<CapturedRenderable> changed_;
+    std::vector<uint64_t> removed_;
+    std::unordered_map<uint64_t, CapturedRenderable> current_;
+
+    Stats stats_;
+};
+
+// ============================================================================
+// 读取
+// ============================================================================
+
+/**
+ * @brief 帧捕获读取器
+ */
+class FrameCaptureReader {
+public:
+    FrameCaptureReader() = default;
+    ~FrameCaptureReader() { close(); }
+
+    FrameCaptureReader(const FrameCaptureReader&) = delete;
+    FrameCaptureReader& operator=(const FrameCaptureReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    /**
+     * @brief 读取下一帧
+     * @return false 如果到达文件末尾或数据损坏
+     */
+    bool readFrame(CapturedFrame& frame);
+
+    /**
+     * @brief 回到第一帧
+     */
+    void rewind();
+
+    uint32_t getVersion() const { return version_; }
+    uint32_t getKeyframeInterval() const { return keyframeInterval_; }
+
+    /** 数据损坏或版本不符时的错误描述 */
+    const std::string& getError() const { return error_; }
+
+private:
+    bool fail(const char* message);
+
+    FILE* file_ = nullptr;
+    long dataStart_ = 0;
+    uint32_t version_ = 0;
+    uint32_t keyframeInterval_ = 0;
+    std::vector<uint8_t> buffer_;
+    std::string error_;
+
+    // 增量帧沿用的状态
+    bool haveKeyframe_ = false;
+    LightingData lighting_;
+    ShadowSettings shadowSettings_;
+    std::vector<CapturedFeature> features_;
+    std::vector<CapturedRenderState> palette_;
+};
+
+// ============================================================================
+// 回放
+// ============================================================================
+
+/**
+ * @brief 把捕获帧同步到 RenderableStorage
+ *
+ * 关键帧清空并重建存储，增量帧只创建/更新/销毁变化的对象
+ */
+class CapturePlayback {
+public:
+    void apply(const CapturedFrame& frame, RenderableStorage& storage);
+
+    /**
+     * @brief 把 Feature 配置应用到同名 Feature
+     * @return 捕获中存在但管理器中找不到的 Feature 数
+     */
+    static uint32_t applyFeatures(const CapturedFrame& frame, RenderFeatureManager& manager);
+
+    void reset() { handles_.clear(); }
+
+private:
+    static RenderableDesc toDesc(const CapturedRenderable& r, const CapturedFrame& frame);
+
+    std::unordered_map<uint64_t, RenderableHandle> handles_;
+};
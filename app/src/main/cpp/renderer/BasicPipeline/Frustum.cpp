@@ -0,0 +1,249 @@
+/**
+ * @file Frustum.cpp
+ * @brief 视锥体与视锥剔除器实现
+ */
+
+#include "Frustum.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// 构造方法
+// ============================================================================
+
+Frustum Frustum::fromMatrix(const Matrix4& viewProjectionMatrix, bool zeroToOneDepth) {
+    const Matrix4& m = viewProjectionMatrix;
+
+    // GLM 为列主序: 第 i 行第 j 列 = m[j][i]
+    auto row = [&m](int i) {
+        return Vector4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    };
+
+    const Vector4 r0 = row(0);
+    const Vector4 r1 = row(1);
+    const Vector4 r2 = row(2);
+    const Vector4 r3 = row(3);
+
+    auto makePlane = [](const Vector4& v) {
+        Plane p(v.x, v.y, v.z, v.w);
+        p.normalize();
+        return p;
+    };
+
+    Frustum frustum;
+    frustum.left = makePlane(r3 + r0);
+    frustum.right = makePlane(r3 - r0);
+    frustum.bottom = makePlane(r3 + r1);
+    frustum.top = makePlane(r3 - r1);
+    frustum.near = makePlane(zeroToOneDepth ? r2 : r3 + r2);
+    frustum.far = makePlane(r3 - r2);
+
+    // 通过逆矩阵反投影NDC立方体的8个角点
+    const Matrix4 inv = glm::inverse(viewProjectionMatrix);
+    auto unproject = [&inv](float x, float y, float z) {
+        Vector4 p = inv * Vector4(x, y, z, 1.0f);
+        return Vector3(p.x, p.y, p.z) / p.w;
+    };
+
+    const float nearZ = zeroToOneDepth ? 0.0f : -1.0f;
+    frustum.nearCorners[0] = unproject(-1.0f,  1.0f, nearZ);
+    frustum.nearCorners[1] = unproject( 1.0f,  1.0f, nearZ);
+    frustum.nearCorners[2] = unproject(-1.0f, -1.0f, nearZ);
+    frustum.nearCorners[3] = unproject( 1.0f, -1.0f, nearZ);
+    frustum.farCorners[0] = unproject(-1.0f,  1.0f, 1.0f);
+    frustum.farCorners[1] = unproject( 1.0f,  1.0f, 1.0f);
+    frustum.farCorners[2] = unproject(-1.0f, -1.0f, 1.0f);
+    frustum.farCorners[3] = unproject( 1.0f, -1.0f, 1.0f);
+
+    return frustum;
+}
+
+Frustum Frustum::fromCamera(const Vector3& position,
+                            const Vector3& forward,
+                            const Vector3& up,
+                            const Vector3& right,
+                            float nearDist,
+                            float farDist,
+                            float fov,
+                            float aspect) {
+    Frustum frustum;
+
+    const float tanHalf = std::tan(fov * 0.5f);
+    const float nearH = nearDist * tanHalf;
+    const float nearW = nearH * aspect;
+    const float farH = farDist * tanHalf;
+    const float farW = farH * aspect;
+
+    const Vector3 nearCenter = position + forward * nearDist;
+    const Vector3 farCenter = position + forward * farDist;
+
+    frustum.nearCorners[0] = nearCenter + up * nearH - right * nearW;
+    frustum.nearCorners[1] = nearCenter + up * nearH + right * nearW;
+    frustum.nearCorners[2] = nearCenter - up * nearH - right * nearW;
+    frustum.nearCorners[3] = nearCenter - up * nearH + right * nearW;
+    frustum.farCorners[0] = farCenter + up * farH - right * farW;
+    frustum.farCorners[1] = farCenter + up * farH + right * farW;
+    frustum.farCorners[2] = farCenter - up * farH - right * farW;
+    frustum.farCorners[3] = farCenter - up * farH + right * farW;
+
+    // 法向量指向视锥体内部
+    frustum.near = Plane::fromPointNormal(nearCenter, forward);
+    frustum.far = Plane::fromPointNormal(farCenter, -forward);
+
+    // 远平面角点顺序: 0=左上, 1=右上, 2=左下, 3=右下
+    const Vector3* fc = frustum.farCorners;
+    const Vector3 leftNormal = glm::normalize(glm::cross(fc[2] - position, fc[0] - position));
+    const Vector3 rightNormal = glm::normalize(glm::cross(fc[1] - position, fc[3] - position));
+    const Vector3 topNormal = glm::normalize(glm::cross(fc[0] - position, fc[1] - position));
+    const Vector3 bottomNormal = glm::normalize(glm::cross(fc[3] - position, fc[2] - position));
+
+    frustum.left = Plane::fromPointNormal(position, leftNormal);
+    frustum.right = Plane::fromPointNormal(position, rightNormal);
+    frustum.top = Plane::fromPointNormal(position, topNormal);
+    frustum.bottom = Plane::fromPointNormal(position, bottomNormal);
+
+    return frustum;
+}
+
+// ============================================================================
+// 包含测试
+// ============================================================================
+
+bool Frustum::containsPoint(const Vector3& point) const {
+    const Plane* planes[6] = {&left, &right, &top, &bottom, &near, &far};
+    for (const Plane* plane : planes) {
+        if (plane->distanceToPoint(point) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersectsSphere(const Vector3& center, float radius) const {
+    const Plane* planes[6] = {&left, &right, &top, &bottom, &near, &far};
+    for (const Plane* plane : planes) {
+        if (plane->distanceToPoint(center) < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersectsAABB(const Vector3& min, const Vector3& max) const {
+    const Plane* planes[6] = {&left, &right, &top, &bottom, &near, &far};
+    for (const Plane* plane : planes) {
+        // "最正"顶点（沿法向量最远的顶点）
+        const Vector3 positive(plane->a >= 0.0f ? max.x : min.x,
+                               plane->b >= 0.0f ? max.y : min.y,
+                               plane->c >= 0.0f ? max.z : min.z);
+        if (plane->distanceToPoint(positive) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersectsOBB(const Vector3& center,
+                            const Vector3& halfExtents,
+                            const Matrix4& rotation) const {
+    const Vector3 axisX(rotation[0][0], rotation[0][1], rotation[0][2]);
+    const Vector3 axisY(rotation[1][0], rotation[1][1], rotation[1][2]);
+    const Vector3 axisZ(rotation[2][0], rotation[2][1], rotation[2][2]);
+
+    const Plane* planes[6] = {&left, &right, &top, &bottom, &near, &far};
+    for (const Plane* plane : planes) {
+        const Vector3 n = plane->getNormal();
+
+        // OBB 在平面法向量上的投影半径
+        const float r = halfExtents.x * std::fabs(glm::dot(n, axisX)) +
+                        halfExtents.y * std::fabs(glm::dot(n, axisY)) +
+                        halfExtents.z * std::fabs(glm::dot(n, axisZ));
+
+        if (plane->distanceToPoint(center) < -r) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// 分类测试
+// ============================================================================
+
+Frustum::IntersectionResult Frustum::classifySphere(const Vector3& center, float radius) const {
+    const Plane* planes[6] = {&left, &right, &top, &bottom, &near, &far};
+    IntersectionResult result = IntersectionResult::Inside;
+
+    for (const Plane* plane : planes) {
+        const float distance = plane->distanceToPoint(center);
+        if (distance < -radius) {
+            return IntersectionResult::Outside;
+        }
+        if (distance < radius) {
+            result = IntersectionResult::Intersect;
+        }
+    }
+    return result;
+}
+
+Frustum::IntersectionResult Frustum::classifyAABB(const Vector3& min, const Vector3& max) const {
+    const Plane* planes[6] = {&left, &right, &top, &bottom, &near, &far};
+    IntersectionResult result = IntersectionResult::Inside;
+
+    for (const Plane* plane : planes) {
+        const Vector3 positive(plane->a >= 0.0f ? max.x : min.x,
+                               plane->b >= 0.0f ? max.y : min.y,
+                               plane->c >= 0.0f ? max.z : min.z);
+        if (plane->distanceToPoint(positive) < 0.0f) {
+            return IntersectionResult::Outside;
+        }
+
+        // "最负"顶点在外侧时为相交
+        const Vector3 negative(plane->a >= 0.0f ? min.x : max.x,
+                               plane->b >= 0.0f ? min.y : max.y,
+                               plane->c >= 0.0f ? min.z : max.z);
+        if (plane->distanceToPoint(negative) < 0.0f) {
+            result = IntersectionResult::Intersect;
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// 调试和可视化
+// ============================================================================
+
+Vector3 Frustum::getCenter() const {
+    Vector3 sum(0.0f);
+    for (int i = 0; i < 4; ++i) {
+        sum += nearCorners[i];
+        sum += farCorners[i];
+    }
+    return sum / 8.0f;
+}
+
+float Frustum::getBoundingRadius() const {
+    const Vector3 center = getCenter();
+    float radius = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        radius = std::max(radius, glm::length(nearCorners[i] - center));
+        radius = std::max(radius, glm::length(farCorners[i] - center));
+    }
+    return radius;
+}
+
+// ============================================================================
+// 视锥剔除器实现
+// ============================================================================
+
+FrustumCuller::FrustumCuller(const Frustum& frustum)
+    : frustum_(frustum) {}
+
+void FrustumCuller::setFrustum(const Frustum& frustum) {
+    frustum_ = frustum;
+}
+
+bool FrustumCuller::isVisible(const Vector3& center, float radius) const {
+    return frustum_.intersectsSphere(center, radius);
+}
@@ -0,0 +1,295 @@
+/**
+ * @file GpuProfiler.cpp
+ * @brief GPU时间戳分析器实现
+ */
+
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <string>
+
+// ============================================================================
+// 初始化
+// ============================================================================
+
+bool GpuProfiler::initialize(IGpuTimestampBackend* backend,
+                             uint32_t framesInFlight,
+                             uint32_t maxZonesPerFrame) {
+    cleanup();
+
+    if (!backend || framesInFlight == 0 || maxZonesPerFrame == 0) {
+        return false;
+    }
+
+    framesInFlight_ = framesInFlight;
+    maxZones_ = maxZonesPerFrame;
+    const uint32_t validBits = backend->getTimestampValidBits();
+    timestampMask_ = validBits > 0 && validBits < 64 ? (1ull << validBits) - 1 : ~0ull;
+
+    if (!backend->createQueryPools(framesInFlight_, queriesPerSlot())) {
+        return false;
+    }
+    backend_ = backend;
+
+    slots_.assign(framesInFlight_, FrameSlot());
+    for (auto& slot : slots_) {
+        slot.names.reserve(maxZones_);
+        slot.depths.reserve(maxZones_);
+        slot.ended.reserve(maxZones_);
+    }
+    readback_.resize(queriesPerSlot());
+    openZones_.reserve(16);
+
+    frameNumber_ = 0;
+    inFrame_ = false;
+    latest_ = GpuFrameResult();
+    stats_ = Stats();
+    return true;
+}
+
+void GpuProfiler::cleanup() {
+    if (backend_) {
+        backend_->destroyQueryPools();
+        backend_ = nullptr;
+    }
+    slots_.clear();
+    openZones_.clear();
+}
+
+// ============================================================================
+// 帧与区段
+// ============================================================================
+
+void GpuProfiler::beginFrame(void* commandBuffer) {
+    if (!backend_) {
+        return;
+    }
+    if (inFrame_) {
+        endFrame(commandBuffer);
+    }
+
+    ++frameNumber_;
+    collectResults();
+
+    currentSlot_ = static_cast<uint32_t>(frameNumber_ % framesInFlight_);
+    FrameSlot& slot = slots_[currentSlot_];
+
+    // 槽位即将被复用，旧结果仍未就绪只能丢弃
+    if (slot.pending) {
+        ++stats_.framesDropped;
+        slot.pending = false;
+    }
+
+    slot.frameNumber = frameNumber_;
+    slot.cpuBeginTick = profilerTimestamp();
+    slot.names.clear();
+    slot.depths.clear();
+    slot.ended.clear();
+    openZones_.clear();
+
+    backend_->resetQueries(commandBuffer, currentSlot_, 0, queriesPerSlot());
+    backend_->writeTimestamp(commandBuffer, currentSlot_, 0);
+    inFrame_ = true;
+}
+
+void GpuProfiler::endFrame(void* commandBuffer) {
+    if (!backend_ || !inFrame_) {
+        return;
+    }
+
+    // 关闭所有未结束的区段，保证查询都被写入
+    while (!openZones_.empty()) {
+        endZone(commandBuffer, openZones_.back());
+    }
+
+    backend_->writeTimestamp(commandBuffer, currentSlot_, 1);
+    slots_[currentSlot_].pending = true;
+    inFrame_ = false;
+}
+
+uint32_t GpuProfiler::beginZone(void* commandBuffer, const char* name) {
+    if (!backend_ || !inFrame_) {
+        return InvalidZone;
+    }
+
+    FrameSlot& slot = slots_[currentSlot_];
+    if (slot.names.size() >= maxZones_) {
+        ++stats_.zonesOverflowed;
+        return InvalidZone;
+    }
+
+    const uint32_t zone = static_cast<uint32_t>(slot.names.size());
+    slot.names.push_back(name);
+    slot.depths.push_back(static_cast<uint32_t>(openZones_.size()));
+    slot.ended.push_back(0);
+    openZones_.push_back(zone);
+
+    backend_->writeTimestamp(commandBuffer, currentSlot_, FrameQueries + zone * 2);
+    return zone;
+}
+
+void GpuProfiler::endZone(void* commandBuffer, uint32_t zone) {
+    if (!backend_ || !inFrame_ || zone == InvalidZone) {
+        return;
+    }
+
+    FrameSlot& slot = slots_[currentSlot_];
+    if (zone >= slot.names.size() || slot.ended[zone]) {
+        return;
+    }
+
+    backend_->writeTimestamp(commandBuffer, currentSlot_, FrameQueries + zone * 2 + 1);
+    slot.ended[zone] = 1;
+
+    auto it = std::find(openZones_.begin(), openZones_.end(), zone);
+    if (it != openZones_.end()) {
+        openZones_.erase(it);
+    }
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+
+void GpuProfiler::collectResults() {
+    // 按帧号从旧到新读取，保证 latest_ 单调前进
+    for (uint32_t age = framesInFlight_; age > 0; --age) {
+        if (frameNumber_ <= age) {
+            continue;
+        }
+        const uint64_t frame = frameNumber_ - age;
+        FrameSlot& slot = slots_[frame % framesInFlight_];
+        if (slot.pending && slot.frameNumber == frame && tryResolve(slot)) {
+            slot.pending = false;
+        }
+    }
+}
+
+bool GpuProfiler::tryResolve(FrameSlot& slot) {
+    const uint32_t slotIndex = static_cast<uint32_t>(slot.frameNumber % framesInFlight_);
+    const uint32_t queryCount = FrameQueries + static_cast<uint32_t>(slot.names.size()) * 2;
+
+    if (!backend_->readResults(slotIndex, 0, queryCount, readback_.data())) {
+        return false;
+    }
+
+    const double period = backend_->getTimestampPeriodNs();
+    const uint64_t frameBegin = readback_[0];
+
+    GpuFrameResult result;
+    result.frameNumber = slot.frameNumber;
+    result.latencyFrames = static_cast<uint32_t>(frameNumber_ - slot.frameNumber);
+    result.frameNs = static_cast<double>(ticksBetween(frameBegin, readback_[1])) * period;
+    result.zones.reserve(slot.names.size());
+
+    for (size_t i = 0; i < slot.names.size(); ++i) {
+        const uint64_t begin = readback_[FrameQueries + i * 2];
+        const uint64_t end = readback_[FrameQueries + i * 2 + 1];
+
+        GpuZoneResult zone;
+        zone.name = slot.names[i];
+        zone.depth = slot.depths[i];
+        zone.beginNs = static_cast<double>(ticksBetween(frameBegin, begin)) * period;
+        zone.durationNs = static_cast<double>(ticksBetween(begin, end)) * period;
+        result.zones.push_back(zone);
+    }
+
+    if (mergeIntoCpu_) {
+        mergeIntoCpuTimeline(slot, result);
+    }
+
+    latest_ = std::move(result);
+    ++stats_.framesResolved;
+    return true;
+}
+
+void GpuProfiler::mergeIntoCpuTimeline(const FrameSlot& slot, const GpuFrameResult& result) {
+    FrameProfiler& profiler = FrameProfiler::get();
+    if (!cpuTrack_) {
+        cpuTrack_ = profiler.createTrack("GPU");
+    }
+
+    // GPU 帧开始对齐到 CPU 端 beginFrame 的时刻（不包含提交延迟）
+    const uint64_t origin = slot.cpuBeginTick;
+
+    cpuTrack_->push(cpuZoneName(FrameProfiler::FrameZoneName),
+                    origin, origin + profiler.nsToTicks(result.frameNs));
+
+    for (const auto& zone : result.zones) {
+        const uint64_t begin = origin + profiler.nsToTicks(zone.beginNs);
+        cpuTrack_->push(cpuZoneName(zone.name),
+                        begin, begin + profiler.nsToTicks(zone.durationNs));
+    }
+}
+
+const char* GpuProfiler::cpuZoneName(const char* name) {
+    auto it = cpuNames_.find(name);
+    if (it != cpuNames_.end()) {
+        return it->second;
+    }
+    const char* interned = FrameProfiler::get().internName(std::string("GPU:") + name);
+    cpuNames_.emplace(name, interned);
+    return interned;
+}
+
+// ============================================================================
+// MockGpuTimestampBackend
+// ============================================================================
+
+bool MockGpuTimestampBackend::createQueryPools(uint32_t slotCount, uint32_t queriesPerSlot) {
+    pools_.assign(slotCount, Pool());
+    for (auto& pool : pools_) {
+        pool.values.assign(queriesPerSlot, 0);
+        pool.written.assign(queriesPerSlot, 0);
+    }
+    frameCounter_ = 0;
+    return true;
+}
+
+void MockGpuTimestampBackend::destroyQueryPools() {
+    pools_.clear();
+}
+
+void MockGpuTimestampBackend::resetQueries(void* /*commandBuffer*/, uint32_t slot,
+                                           uint32_t firstQuery, uint32_t queryCount) {
+    if (slot >= pools_.size()) {
+        return;
+    }
+    Pool& pool = pools_[slot];
+    const uint32_t end = std::min<uint32_t>(firstQuery + queryCount, static_cast<uint32_t>(pool.written.size()));
+    std::fill(pool.written.begin() + firstQuery, pool.written.begin() + end, 0);
+    pool.resetFrame = ++frameCounter_;
+}
+
+void MockGpuTimestampBackend::writeTimestamp(void* /*commandBuffer*/, uint32_t slot, uint32_t query) {
+    if (slot >= pools_.size() || query >= pools_[slot].values.size()) {
+        return;
+    }
+    clock_ += ticksPerWrite_;
+    pools_[slot].values[query] = validBits_ < 64 ? clock_ & ((1ull << validBits_) - 1) : clock_;
+    pools_[slot].written[query] = 1;
+}
+
+bool MockGpuTimestampBackend::readResults(uint32_t slot, uint32_t firstQuery,
+                                          uint32_t queryCount, uint64_t* results) {
+    if (slot >= pools_.size()) {
+        return false;
+    }
+    const Pool& pool = pools_[slot];
+
+    // 该槽位之后又开始了 latencyFrames 帧，才视为GPU已执行完毕
+    if (frameCounter_ - pool.resetFrame < latencyFrames_) {
+        ++notReadyCount_;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        const uint32_t q = firstQuery + i;
+        if (q >= pool.values.size() || !pool.written[q]) {
+            ++notReadyCount_;
+            return false;
+        }
+        results[i] = pool.values[q];
+    }
+    return true;
+}
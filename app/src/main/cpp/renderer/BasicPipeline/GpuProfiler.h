@@ -0,0 +1,367 @@
+/**
+ * @file GpuProfiler.h
+ * @brief GPU时间戳分析 - 按Pass/Feature统计GPU耗时
+ *
+ * 设计:
+ * - 每个飞行帧（frame in flight）一组时间戳查询，互不覆盖
+ * - 区段开始/结束各写一个时间戳，支持嵌套
+ * - 结果在若干帧后非阻塞读取（未就绪则继续等待，槽位被复用前仍未就绪则丢弃）
+ * - 读取到的区段以 "GPU:" 前缀合并到 CPU 分析器的 "GPU" 时间线和统计中
+ *
+ * 查询的创建、写入和读取通过 IGpuTimestampBackend 完成:
+ * - 图形 API 的后端（如 VkQueryPool + vkCmdWriteTimestamp）由引擎实现，本目录不包含
+ * - MockGpuTimestampBackend: 无GPU的模拟实现，可配置读取延迟与时间戳有效位数
+ *
+ * 时间戳只有低 getTimestampValidBits() 位有效（Vulkan 的 timestampValidBits），
+ * 区间按该宽度取模计算，跨越回绕的区段仍得到正确耗时
+ *
+ * 用法:
+ * @code
+ *
+ * gpuProfiler.beginFrame(cmd);
+ * {
+ *     PRISMA_GPU_ZONE(&gpuProfiler, cmd, "OpaquePass");
+ *     opaquePass->record(cmd);
+ * }
+ * gpuProfiler.endFrame(cmd);
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "Profiler.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// 后端接口
+// ============================================================================
+
+/**
+ * @brief 时间戳查询后端
+ *
+ * 每个飞行帧对应一个查询池（slot）
+ */
+class IGpuTimestampBackend {
+public:
+    virtual ~IGpuTimestampBackend() = default;
+
+    /**
+     * @brief 创建查询池
+     * @param slotCount 飞行帧数量
+     * @param queriesPerSlot 每个查询池的查询数
+     */
+    virtual bool createQueryPools(uint32_t slotCount, uint32_t queriesPerSlot) = 0;
+
+    /**
+     * @brief 销毁所有查询池
+     */
+    virtual void destroyQueryPools() = 0;
+
+    /**
+     * @brief 在命令缓冲区中重置查询（复用前必须调用）
+     */
+    virtual void resetQueries(void* commandBuffer, uint32_t slot, uint32_t firstQuery, uint32_t queryCount) = 0;
+
+    /**
+     * @brief 在命令缓冲区中写入时间戳
+     */
+    virtual void writeTimestamp(void* commandBuffer, uint32_t slot, uint32_t query) = 0;
+
+    /**
+     * @brief 非阻塞读取查询结果
+     * @param results 输出，长度至少为 queryCount
+     * @return false 如果结果尚未就绪
+     */
+    virtual bool readResults(uint32_t slot, uint32_t firstQuery, uint32_t queryCount, uint64_t* results) = 0;
+
+    /**
+     * @brief 每个时间戳 tick 对应的纳秒数
+     */
+    virtual double getTimestampPeriodNs() const = 0;
+
+    /**
+     * @brief 时间戳的有效位数（1-64，Vulkan 为队列族的 timestampValidBits），更高位不保证为 0
+     */
+    virtual uint32_t getTimestampValidBits() const { return 64; }
+};
+
+// ============================================================================
+// 结果
+// ============================================================================
+
+/**
+ * @brief 单个GPU区段的结果
+ */
+struct GpuZoneResult {
+    const char* name = nullptr;
+
+    /** 嵌套深度（0 = 顶层） */
+    uint32_t depth = 0;
+
+    /** 相对于帧开始的偏移（纳秒） */
+    double beginNs = 0.0;
+
+    /** GPU耗时（纳秒） */
+    double durationNs = 0.0;
+};
+
+/**
+ * @brief 单帧GPU结果
+ */
+struct GpuFrameResult {
+    /** 产生这些结果的帧号 */
+    uint64_t frameNumber = 0;
+
+    /** 从写入到读取经过的帧数 */
+    uint32_t latencyFrames = 0;
+
+    /** 帧开始到帧结束时间戳之间的GPU耗时（纳秒） */
+    double frameNs = 0.0;
+
+    std::vector<GpuZoneResult> zones;
+};
+
+// ============================================================================
+// GPU分析器
+// ============================================================================
+
+/**
+ * @brief GPU时间戳分析器
+ *
+ * 所有方法须在录制命令的同一线程调用
+ */
+class GpuProfiler {
+public:
+    static constexpr uint32_t DefaultFramesInFlight = 3;
+    static constexpr uint32_t DefaultMaxZonesPerFrame = 128;
+    static constexpr uint32_t InvalidZone = ~0u;
+
+    GpuProfiler() = default;
+    ~GpuProfiler() { cleanup(); }
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /**
+     * @brief 初始化
+     * @param backend 查询后端（不转移所有权）
+     * @param framesInFlight 飞行帧数量（查询池数量）
+     * @param maxZonesPerFrame 每帧最多区段数
+     */
+    bool initialize(IGpuTimestampBackend* backend,
+                    uint32_t framesInFlight = DefaultFramesInFlight,
+                    uint32_t maxZonesPerFrame = DefaultMaxZonesPerFrame);
+
+    void cleanup();
+
+    bool isInitialized() const { return backend_ != nullptr; }
+
+    // ========================================================================
+    // 帧与区段
+    // ========================================================================
+
+    /**
+     * @brief 帧开始：读取已完成的旧帧，重置本帧查询并写入帧开始时间戳
+     */
+    void beginFrame(void* commandBuffer);
+
+    /**
+     * @brief 帧结束：关闭未结束的区段并写入帧结束时间戳
+     */
+    void endFrame(void* commandBuffer);
+
+    /**
+     * @brief 开始区段
+     * @param name 静态字符串
+     * @return 区段索引，超出容量时返回 InvalidZone
+     */
+    uint32_t beginZone(void* commandBuffer, const char* name);
+
+    /**
+     * @brief 结束区段
+     */
+    void endZone(void* commandBuffer, uint32_t zone);
+
+    // ========================================================================
+    // 结果
+    // ========================================================================
+
+    /**
+     * @brief 最近读取到的一帧结果
+     */
+    const GpuFrameResult& getLatestResult() const { return latest_; }
+
+    struct Stats {
+        /** 已读取的帧数 */
+        uint64_t framesResolved = 0;
+
+        /** 槽位复用前仍未就绪而丢弃的帧数 */
+        uint64_t framesDropped = 0;
+
+        /** 因超过 maxZonesPerFrame 而未记录的区段数 */
+        uint64_t zonesOverflowed = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+
+    uint64_t getFrameNumber() const { return frameNumber_; }
+
+    /**
+     * @brief 是否把结果合并到 CPU 分析器（默认开启）
+     */
+    void setMergeIntoCpuProfiler(bool merge) { mergeIntoCpu_ = merge; }
+
+private:
+    /** 查询布局: [0] 帧开始, [1] 帧结束, [2 + 2i] / [3 + 2i] 区段 i 的开始/结束 */
+    static constexpr uint32_t FrameQueries = 2;
+
+    struct FrameSlot {
+        uint64_t frameNumber = 0;
+        uint64_t cpuBeginTick = 0;
+        bool pending = false;
+
+        std::vector<const char*> names;
+        std::vector<uint32_t> depths;
+        std::vector<uint8_t> ended;
+    };
+
+    void collectResults();
+    bool tryResolve(FrameSlot& slot);
+    void mergeIntoCpuTimeline(const FrameSlot& slot, const GpuFrameResult& result);
+
+    /** begin 到 end 的 tick 数（按有效位宽取模） */
+    uint64_t ticksBetween(uint64_t begin, uint64_t end) const {
+        return ((end & timestampMask_) - (begin & timestampMask_)) & timestampMask_;
+    }
+    const char* cpuZoneName(const char* name);
+    uint32_t queriesPerSlot() const { return FrameQueries + maxZones_ * 2; }
+
+    IGpuTimestampBackend* backend_ = nullptr;
+    uint32_t framesInFlight_ = 0;
+    uint32_t maxZones_ = 0;
+    uint64_t timestampMask_ = ~0ull;
+
+    std::vector<FrameSlot> slots_;
+    uint32_t currentSlot_ = 0;
+    uint64_t frameNumber_ = 0;
+    bool inFrame_ = false;
+
+    /** 当前打开的区段（嵌套栈） */
+    std::vector<uint32_t> openZones_;
+
+    std::vector<uint64_t> readback_;
+    GpuFrameResult latest_;
+    Stats stats_;
+
+    bool mergeIntoCpu_ = true;
+    ProfileThreadBuffer* cpuTrack_ = nullptr;
+
+    /** 区段名 -> "GPU:" 前缀名（已驻留） */
+    std::unordered_map<const char*, const char*> cpuNames_;
+};
+
+/**
+ * @brief 作用域GPU区段（profiler 为空时不做任何事）
+ */
+class GpuProfileScope {
+public:
+    GpuProfileScope(GpuProfiler* profiler, void* commandBuffer, const char* name)
+        : profiler_(profiler && profiler->isInitialized() ? profiler : nullptr)
+        , commandBuffer_(commandBuffer) {
+        if (profiler_) {
+            zone_ = profiler_->beginZone(commandBuffer_, name);
+        }
+    }
+
+    ~GpuProfileScope() {
+        if (profiler_) {
+            profiler_->endZone(commandBuffer_, zone_);
+        }
+    }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    GpuProfiler* profiler_;
+    void* commandBuffer_;
+    uint32_t zone_ = GpuProfiler::InvalidZone;
+};
+
+// ============================================================================
+// 模拟后端
+// ============================================================================
+
+/**
+ * @brief 无GPU的模拟后端
+ *
+ * - 每次 resetQueries 视为该槽位开始新的一帧
+ * - 结果在写入后经过 latencyFrames 帧才可读取，模拟GPU执行延迟
+ * - 时间戳为单调递增的模拟时钟，每次写入前进 ticksPerWrite，只保留低 timestampValidBits 位
+ */
+class MockGpuTimestampBackend : public IGpuTimestampBackend {
+public:
+    explicit MockGpuTimestampBackend(uint32_t latencyFrames = 2,
+                                     uint64_t ticksPerWrite = 1000,
+                                     double periodNs = 1.0)
+        : latencyFrames_(latencyFrames), ticksPerWrite_(ticksPerWrite), periodNs_(periodNs) {}
+
+    bool createQueryPools(uint32_t slotCount, uint32_t queriesPerSlot) override;
+    void destroyQueryPools() override;
+    void resetQueries(void* commandBuffer, uint32_t slot, uint32_t firstQuery, uint32_t queryCount) override;
+    void writeTimestamp(void* commandBuffer, uint32_t slot, uint32_t query) override;
+    bool readResults(uint32_t slot, uint32_t firstQuery, uint32_t queryCount, uint64_t* results) override;
+    double getTimestampPeriodNs() const override { return periodNs_; }
+    uint32_t getTimestampValidBits() const override { return validBits_; }
+
+    /** 设置时间戳有效位数（1-64，在 GpuProfiler::initialize 之前设置） */
+    void setTimestampValidBits(uint32_t bits) { validBits_ = bits < 1 ? 1 : (bits > 64 ? 64 : bits); }
+
+    /** 设置模拟时钟（例如放在回绕点之前） */
+    void setClock(uint64_t ticks) { clock_ = ticks; }
+
+    /** 设置读取延迟（帧） */
+    void setLatencyFrames(uint32_t frames) { latencyFrames_ = frames; }
+
+    /** 设置下一次写入前进的 tick 数（模拟某个区段的耗时） */
+    void setTicksPerWrite(uint64_t ticks) { ticksPerWrite_ = ticks; }
+
+    /** 已执行的 readResults 调用中返回未就绪的次数 */
+    uint64_t getNotReadyCount() const { return notReadyCount_; }
+
+private:
+    struct Pool {
+        std::vector<uint64_t> values;
+        std::vector<uint8_t> written;
+        uint64_t resetFrame = 0;
+    };
+
+    std::vector<Pool> pools_;
+    uint64_t frameCounter_ = 0;
+    uint64_t clock_ = 0;
+    uint64_t notReadyCount_ = 0;
+
+    uint32_t latencyFrames_;
+    uint64_t ticksPerWrite_;
+    double periodNs_;
+    uint32_t validBits_ = 64;
+};
+
+// ============================================================================
+// 宏
+// ============================================================================
+
+#if defined(PRISMA_ENABLE_PROFILER) && PRISMA_ENABLE_PROFILER
+
+/** 当前作用域的GPU计时 */
+#define PRISMA_GPU_ZONE(profiler, commandBuffer, name) \
+    GpuProfileScope PRISMA_PROFILE_CONCAT(gpuProfileScope_, __LINE__)(profiler, commandBuffer, name)
+
+#else
+
+/** 关闭时仍引用参数，避免只用于计时的命令缓冲区产生未使用警告 */
+#define PRISMA_GPU_ZONE(profiler, commandBuffer, name) ((void)(profiler), (void)(commandBuffer))
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file IRenderFeature.cpp
+ * @brief 渲染特性管理器实现
+ */
+
+#include "IRenderFeature.h"
+#include "Profiler.h"
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+void RenderFeatureManager::AddFeature(std::unique_ptr<IRenderFeature> feature) {
+    if (!feature) {
+        return;
+    }
+    features_.push_back(std::move(feature));
+
+    // 同一Event下按order执行，order相同时保持添加顺序
+    std::stable_sort(features_.begin(), features_.end(),
+                     [](const auto& a, const auto& b) { return a->GetOrder() < b->GetOrder(); });
+}
+
+void RenderFeatureManager::RemoveFeature(const char* name) {
+    features_.erase(std::remove_if(features_.begin(), features_.end(),
+                                   [name](const auto& f) { return std::strcmp(f->GetName(), name) == 0; }),
+                    features_.end());
+}
+
+IRenderFeature* RenderFeatureManager::GetFeature(const char* name) {
+    for (const auto& feature : features_) {
+        if (std::strcmp(feature->GetName(), name) == 0) {
+            return feature.get();
+        }
+    }
+    return nullptr;
+}
+
+void RenderFeatureManager::InitializeAll(IRenderContext& context) {
+    for (const auto& feature : features_) {
+        if (!feature->Initialize(context)) {
+            feature->SetActive(false);
+        }
+    }
+}
+
+void RenderFeatureManager::CleanupAll() {
+    for (const auto& feature : features_) {
+        feature->Cleanup();
+    }
+}
+
+void RenderFeatureManager::ExecuteFeatures(RenderPassEvent evt,
+                                           IRenderContext& context,
+                                           const RenderingData& renderingData) {
+    for (const auto& feature : features_) {
+        if (!feature->IsActive() || feature->GetPassEvent() != evt) {
+            continue;
+        }
+        PRISMA_PROFILE_ZONE(feature->GetName());
+        PRISMA_GPU_ZONE(gpuProfiler_, context.GetCommandBuffer(), feature->GetName());
+        feature->Execute(context, renderingData);
+    }
+}
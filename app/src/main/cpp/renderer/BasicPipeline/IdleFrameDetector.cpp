@@ -0,0 +1,252 @@
+/**
+ * @file IdleFrameDetector.cpp
+ * @brief 空闲帧检测实现
+ */
+
+#include "IdleFrameDetector.h"
+#include "IRenderFeature.h"
+#include "LightingData.h"
+#include "ShadowSettings.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr const char* IdleFrameActionNames[] = {
+    "Render",
+    "Represent",
+    "Skip",
+};
+
+/** 渲染开销滑动平均的权重 */
+constexpr float kCostSmoothing = 0.1f;
+
+/**
+ * @brief FNV-1a 哈希（逐字段写入，避免结构体填充字节）
+ */
+class FieldHasher {
+public:
+    template<typename T>
+    void add(const T& value) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (unsigned char b : bytes) {
+            hash_ = (hash_ ^ b) * 1099511628211ull;
+        }
+    }
+
+    void add(const Vector3& v) {
+        add(v.x);
+        add(v.y);
+        add(v.z);
+    }
+
+    uint64_t get() const { return hash_; }
+
+private:
+    uint64_t hash_ = 14695981039346656037ull;
+};
+
+void hashLights(FieldHasher& hasher, const LightDataList& lights) {
+    hasher.add(static_cast<uint32_t>(lights.size()));
+    for (const LightData& light : lights) {
+        hasher.add(static_cast<uint32_t>(light.type));
+        hasher.add(light.color);
+        hasher.add(light.intensity);
+        hasher.add(light.range);
+        hasher.add(light.direction);
+        hasher.add(light.position);
+        hasher.add(static_cast<uint32_t>(light.attenuation));
+        hasher.add(light.innerAngle);
+        hasher.add(light.outerAngle);
+        hasher.add(light.castShadows);
+        hasher.add(light.shadowStrength);
+        hasher.add(light.shadowBias);
+        hasher.add(light.shadowNearPlane);
+        hasher.add(static_cast<uint32_t>(light.lightMode));
+        hasher.add(light.affectLightmappedSurfaces);
+        hasher.add(light.shadowmaskChannel);
+        hasher.add(static_cast<uint32_t>(light.areaShape));
+        hasher.add(light.areaSize);
+        hasher.add(light.areaTangent);
+        hasher.add(light.areaTwoSided);
+    }
+}
+
+uint64_t hashLighting(const LightingData* lighting) {
+    FieldHasher hasher;
+    if (!lighting) {
+        return hasher.get();
+    }
+    hashLights(hasher, lighting->directionalLights);
+    hashLights(hasher, lighting->pointLights);
+    hashLights(hasher, lighting->spotLights);
+    hashLights(hasher, lighting->areaLights);
+    hasher.add(lighting->ambientColor);
+    hasher.add(lighting->ambientIntensity);
+    hasher.add(lighting->ambientLightmap);
+    hasher.add(lighting->enableGI);
+    hasher.add(static_cast<uint32_t>(lighting->lightProbes.size()));
+    for (const LightingData::LightProbe& probe : lighting->lightProbes) {
+        hasher.add(probe.position);
+        for (const Vector3& coefficient : probe.sphericalHarmonics) {
+            hasher.add(coefficient);
+        }
+    }
+    return hasher.get();
+}
+
+uint64_t hashShadows(const ShadowSettings* shadows) {
+    FieldHasher hasher;
+    if (!shadows) {
+        return hasher.get();
+    }
+    hasher.add(shadows->enableShadows);
+    hasher.add(static_cast<uint32_t>(shadows->defaultShadowType));
+    hasher.add(shadows->maxShadowMaps);
+    hasher.add(shadows->shadowMapArraySize);
+    hasher.add(shadows->shadowDistance);
+    hasher.add(shadows->shadowFadeDistance);
+    hasher.add(shadows->enableShadowmask);
+    hasher.add(shadows->shadowmaskShadowDistance);
+    hasher.add(shadows->enableCascadedShadows);
+
+    const CascadedShadowSettings& cascades = shadows->cascadedSettings;
+    hasher.add(cascades.cascadeCount);
+    hasher.add(static_cast<uint32_t>(cascades.splitScheme));
+    hasher.add(static_cast<uint32_t>(cascades.manualSplits.size()));
+    for (float split : cascades.manualSplits) {
+        hasher.add(split);
+    }
+    hasher.add(static_cast<uint32_t>(cascades.resolution));
+    hasher.add(cascades.transitionSize);
+    hasher.add(cascades.enableCascadeBlending);
+
+    hasher.add(static_cast<uint32_t>(shadows->filterSettings.filterType));
+    hasher.add(shadows->filterSettings.sampleRadius);
+    hasher.add(shadows->filterSettings.sampleCount);
+
+    hasher.add(shadows->maxShadowCastingLightsPerFrame);
+    hasher.add(shadows->enableShadowCulling);
+    hasher.add(shadows->enableDepthPrepassForShadows);
+    hasher.add(shadows->useBidirectionalDepthBias);
+    hasher.add(shadows->depthBiasScale);
+    hasher.add(shadows->normalBiasScale);
+    return hasher.get();
+}
+
+bool matricesDiffer(const Matrix4& a, const Matrix4& b, float threshold) {
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            if (std::fabs(a[col][row] - b[col][row]) > threshold) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+const char* GetIdleFrameActionName(IdleFrameAction action) {
+    const size_t index = static_cast<size_t>(action);
+    return index < sizeof(IdleFrameActionNames) / sizeof(IdleFrameActionNames[0])
+        ? IdleFrameActionNames[index] : "Unknown";
+}
+
+IdleFrameAction IdleFrameDetector::evaluate(const IdleFrameInputs& inputs) {
+    // Feature: 激活集合、动画与时间累积
+    FieldHasher featureHasher;
+    bool featureAnimating = false;
+    uint32_t temporalFrames = 0;
+    if (inputs.features) {
+        for (const auto& feature : inputs.features->GetAllFeatures()) {
+            featureHasher.add(feature.get());
+            featureHasher.add(feature->IsActive());
+            if (!feature->IsActive()) {
+                continue;
+            }
+            featureAnimating |= feature->IsAnimating();
+            temporalFrames = std::max(temporalFrames, feature->GetTemporalSettleFrames());
+        }
+    }
+    const uint64_t featureHash = featureHasher.get();
+    const uint64_t lightingHash = hashLighting(inputs.lighting);
+    const uint64_t shadowHash = hashShadows(inputs.shadows);
+
+    const bool changed = !settings_.enabled || dirty_ || !haveLast_ ||
+        inputs.activeAnimations > 0 || featureAnimating ||
+        inputs.storageVersion != last_.storageVersion ||
+        inputs.screenWidth != last_.screenWidth ||
+        inputs.screenHeight != last_.screenHeight ||
+        inputs.renderFlags != last_.renderFlags ||
+        lightingHash != lastLightingHash_ ||
+        shadowHash != lastShadowHash_ ||
+        featureHash != lastFeatureHash_ ||
+        matricesDiffer(inputs.viewMatrix, last_.viewMatrix, settings_.cameraThreshold) ||
+        matricesDiffer(inputs.projectionMatrix, last_.projectionMatrix, settings_.cameraThreshold);
+
+    framesSinceChange_ = changed ? 0 : framesSinceChange_ + 1;
+    temporalSettleFrames_ = temporalFrames;
+
+    // 变化后继续渲染，直到交换链图像和时间累积历史都得到静止画面
+    if (changed || framesSinceChange_ < settings_.settleFrames + temporalFrames) {
+        haveLast_ = true;
+        last_ = inputs;
+        lastLightingHash_ = lightingHash;
+        lastShadowHash_ = shadowHash;
+        lastFeatureHash_ = featureHash;
+        dirty_ = false;
+        idlePhase_ = 0;
+
+        ++stats_.renderedFrames;
+        stats_.consecutiveIdleFrames = 0;
+        lastAction_ = IdleFrameAction::Render;
+        return lastAction_;
+    }
+
+    ++stats_.consecutiveIdleFrames;
+    if (settings_.presentMode == IdlePresentMode::ReducedRate) {
+        const uint32_t interval = std::max(settings_.idlePresentInterval, 1u);
+        idlePhase_ = (idlePhase_ + 1) % interval;
+        lastAction_ = idlePhase_ == 0 ? IdleFrameAction::Represent : IdleFrameAction::Skip;
+    } else {
+        lastAction_ = IdleFrameAction::Represent;
+    }
+
+    if (lastAction_ == IdleFrameAction::Represent) {
+        ++stats_.representedFrames;
+    } else {
+        ++stats_.skippedFrames;
+    }
+    return lastAction_;
+}
+
+void IdleFrameDetector::reportFrameCost(IdleFrameAction action, float ms) {
+    if (action == IdleFrameAction::Render) {
+        stats_.averageRenderMs = stats_.averageRenderMs > 0.0f
+            ? stats_.averageRenderMs + (ms - stats_.averageRenderMs) * kCostSmoothing
+            : ms;
+        return;
+    }
+    stats_.savedMs += std::max(stats_.averageRenderMs - ms, 0.0f);
+}
+
+void IdleFrameDetector::writeReport(FILE* out) const {
+    const uint64_t total = stats_.renderedFrames + stats_.idleFrames();
+    const double idlePercent = total > 0
+        ? 100.0 * static_cast<double>(stats_.idleFrames()) / static_cast<double>(total) : 0.0;
+
+    std::fprintf(out, "Idle frames: %llu / %llu (%.1f%%), represented %llu, skipped %llu\n",
+                 static_cast<unsigned long long>(stats_.idleFrames()),
+                 static_cast<unsigned long long>(total), idlePercent,
+                 static_cast<unsigned long long>(stats_.representedFrames),
+                 static_cast<unsigned long long>(stats_.skippedFrames));
+    std::fprintf(out, "Average render: %.3f ms, estimated CPU time saved: %.1f ms\n",
+                 stats_.averageRenderMs, stats_.savedMs);
+    if (temporalSettleFrames_ > 0) {
+        std::fprintf(out, "Temporal settle frames: %u\n", temporalSettleFrames_);
+    }
+}
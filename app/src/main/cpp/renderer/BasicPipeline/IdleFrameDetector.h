@@ -0,0 +1,187 @@
+/**
+ * @file IdleFrameDetector.h
+ * @brief 空闲帧检测 - 画面不变时跳过整帧 CPU/GPU 工作以节省电量
+ *
+ * 菜单、暂停和静止场景中每个 vsync 仍然完整执行剔除、排序、阴影和所有 Pass，
+ * 在手机上白白耗电。IdleFrameDetector 在每帧开始前比较上一次渲染时的输入:
+ * - 相机（未抖动的视图、投影矩阵，抖动每帧变化但不改变收敛后的画面）
+ * - 可渲染组件存储的修改版本（RenderableStorage::getChangeVersion）
+ * - 光照（逐字段哈希，含光照探针的球谐系数）与阴影设置、渲染目标尺寸和渲染开关
+ * - 正在播放的动画数（由调用者提供）
+ * - Feature: 激活集合的变化、IRenderFeature::IsAnimating()
+ *
+ * 发生变化后至少再渲染 settleFrames 帧；带时间累积的 Feature（TAA 等）通过
+ * IRenderFeature::GetTemporalSettleFrames() 要求更多帧，使历史缓冲在静止画面上收敛，
+ * 之后才进入空闲。空闲帧不构建快照、不剔除、不录制命令:
+ * - Represent: 重新呈现保留的最后一帧（复制到新的交换链图像）
+ * - Skip:      不呈现，只每 idlePresentInterval 个 vsync 呈现一次（降低呈现频率）
+ *
+ * 空闲帧不推进帧号，TAA 的抖动序列和上一帧矩阵在恢复渲染时保持连续
+ *
+ * 用法:
+ * @code
+ *
+ * IdleFrameInputs inputs;
+ * inputs.viewMatrix = ...;
+ * inputs.storageVersion = storage.getChangeVersion();
+ * ...
+ * switch (idle.evaluate(inputs)) {
+ *     case IdleFrameAction::Render:    render(); idle.reportFrameCost(IdleFrameAction::Render, ms); break;
+ *     case IdleFrameAction::Represent: presentLastImage(); break;
+ *     case IdleFrameAction::Skip:      break;
+ * }
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "../../MathTypes.h"
+#include <cstdint>
+#include <cstdio>
+
+struct LightingData;
+struct ShadowSettings;
+class RenderFeatureManager;
+
+/**
+ * @brief 本帧的处理方式
+ */
+enum class IdleFrameAction : uint32_t {
+    /** 完整渲染 */
+    Render,
+    /** 空闲: 重新呈现最后一帧 */
+    Represent,
+    /** 空闲: 不渲染也不呈现 */
+    Skip
+};
+
+const char* GetIdleFrameActionName(IdleFrameAction action);
+
+/**
+ * @brief 空闲时的呈现方式
+ */
+enum class IdlePresentMode : uint32_t {
+    /** 每个 vsync 重新呈现最后一帧（保持交换链节奏，适合不能改变呈现频率的平台） */
+    Represent,
+    /** 降低呈现频率: 每 idlePresentInterval 帧重新呈现一次，其余帧跳过 */
+    ReducedRate
+};
+
+/**
+ * @brief 空闲检测配置
+ */
+struct IdleFrameSettings {
+    bool enabled = true;
+
+    IdlePresentMode presentMode = IdlePresentMode::ReducedRate;
+
+    /** ReducedRate: 每 N 帧呈现一次（60Hz 下4表示15Hz） */
+    uint32_t idlePresentInterval = 4;
+
+    /** 变化后至少再完整渲染的帧数（交换链的多个图像都需要得到新画面） */
+    uint32_t settleFrames = 2;
+
+    /** 视图、投影矩阵任一元素变化超过该值时视为相机改变 */
+    float cameraThreshold = 1e-5f;
+};
+
+/**
+ * @brief 每帧的检测输入
+ */
+struct IdleFrameInputs {
+    /** 未抖动的相机矩阵 */
+    Matrix4 viewMatrix = Matrix4(1.0f);
+    Matrix4 projectionMatrix = Matrix4(1.0f);
+
+    /** RenderableStorage::getChangeVersion() */
+    uint64_t storageVersion = 0;
+
+    const LightingData* lighting = nullptr;
+    const ShadowSettings* shadows = nullptr;
+    const RenderFeatureManager* features = nullptr;
+
+    /** 正在播放的动画数（骨骼、材质、UI 动画等） */
+    uint32_t activeAnimations = 0;
+
+    uint32_t screenWidth = 0;
+    uint32_t screenHeight = 0;
+
+    /** RenderingData 的开关（阴影、后处理、调试视图）按位组合 */
+    uint32_t renderFlags = 0;
+};
+
+/**
+ * @brief 累计统计
+ */
+struct IdleFrameStats {
+    uint64_t renderedFrames = 0;
+    uint64_t representedFrames = 0;
+    uint64_t skippedFrames = 0;
+
+    /** 当前连续空闲帧数 */
+    uint32_t consecutiveIdleFrames = 0;
+
+    /** 完整渲染一帧的平均 CPU 开销（毫秒，指数滑动平均） */
+    float averageRenderMs = 0.0f;
+
+    /** 估算节省的 CPU 时间（毫秒）: Σ(平均渲染开销 - 空闲帧实际开销) */
+    double savedMs = 0.0;
+
+    uint64_t idleFrames() const { return representedFrames + skippedFrames; }
+};
+
+/**
+ * @brief 空闲帧检测器
+ */
+class IdleFrameDetector {
+public:
+    void setSettings(const IdleFrameSettings& settings) { settings_ = settings; }
+    const IdleFrameSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 决定本帧的处理方式
+     *
+     * 返回 Render 时调用者必须完整渲染本帧
+     */
+    IdleFrameAction evaluate(const IdleFrameInputs& inputs);
+
+    /**
+     * @brief 强制下一帧渲染（检测不到的变化: 资源流送完成、着色器热重载、设置修改等）
+     */
+    void markDirty() { dirty_ = true; }
+
+    /**
+     * @brief 反馈本帧的 CPU 开销（毫秒），用于估算节省的时间
+     */
+    void reportFrameCost(IdleFrameAction action, float ms);
+
+    const IdleFrameStats& getStats() const { return stats_; }
+    void resetStats() { stats_ = IdleFrameStats(); }
+
+    /** 最近一次 evaluate 的结果 */
+    IdleFrameAction getLastAction() const { return lastAction_; }
+
+    /** 距离最近一次变化的帧数 */
+    uint32_t getFramesSinceChange() const { return framesSinceChange_; }
+
+    void writeReport(FILE* out) const;
+
+private:
+    IdleFrameSettings settings_;
+
+    // 最近一次渲染时的输入
+    bool haveLast_ = false;
+    IdleFrameInputs last_;
+    uint64_t lastLightingHash_ = 0;
+    uint64_t lastShadowHash_ = 0;
+    uint64_t lastFeatureHash_ = 0;
+
+    bool dirty_ = true;
+    uint32_t framesSinceChange_ = 0;
+    uint32_t temporalSettleFrames_ = 0;
+    uint32_t idlePhase_ = 0;
+
+    IdleFrameAction lastAction_ = IdleFrameAction::Render;
+    IdleFrameStats stats_;
+};
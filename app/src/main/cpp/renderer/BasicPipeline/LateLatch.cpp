@@ -0,0 +1,234 @@
+/**
+ * @file LateLatch.cpp
+ * @brief 相机矩阵后期锁存实现
+ */
+
+#include "LateLatch.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/** 透视投影半角 tan 的上限（约 89 度），避免扩大后发散 */
+constexpr float kMaxHalfTangent = 57.29f;
+
+/** 视野变宽超过该比例时视为超出余量 */
+constexpr float kProjectionTolerance = 1e-4f;
+
+float nsToMs(uint64_t ns) {
+    return static_cast<float>(static_cast<double>(ns) * 1e-6);
+}
+
+/** 两个视图矩阵旋转部分之间的夹角（度） */
+float rotationBetween(const Matrix4& a, const Matrix4& b) {
+    // trace(Ra * Rb^T) = Σ Ra_ij * Rb_ij
+    float trace = 0.0f;
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            trace += a[col][row] * b[col][row];
+        }
+    }
+    const float cosAngle = std::clamp((trace - 1.0f) * 0.5f, -1.0f, 1.0f);
+    return std::acos(cosAngle) * 180.0f / kPi;
+}
+
+} // namespace
+
+uint64_t GetLateLatchTimeNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void ApplyLateLatchCullingMargin(CameraSnapshot& snapshot, const LateLatchSettings& settings) {
+    const Matrix4& projection = snapshot.unjittered.projection;
+
+    // 透视投影的 w 来自 z（第3列第4行非0）
+    Matrix4 widen(1.0f);
+    float nearScale = 0.0f;
+    float farScale = 0.0f;
+    if (projection[2][3] != 0.0f && projection[0][0] > 0.0f && projection[1][1] > 0.0f &&
+        settings.cullingMarginDegrees > 0.0f) {
+        const float margin = std::min(settings.cullingMarginDegrees, 89.0f) * kPi / 180.0f;
+        const float tanX = 1.0f / projection[0][0];
+        const float tanY = 1.0f / projection[1][1];
+
+        // 锁存相机相对剔除相机旋转 θ <= margin。视锥内的点 v（深度 1，|v| <= diagonal）
+        // 旋转后移动 |Rv - v| <= 2sin(θ/2)|v|，横向坐标最多增加、深度最多减少这么多，
+        // 因此半角 tan 扩大到 (tan + chord) / (1 - chord)。只加 θ 不够: 视锥角上的点在滚转或
+        // 斜向旋转时横向移动得更多
+        const float diagonal = std::sqrt(1.0f + tanX * tanX + tanY * tanY);
+        const float chord = std::min(2.0f * std::sin(margin * 0.5f) * diagonal, 0.99f);
+        const float widenedX = std::min((tanX + chord) / (1.0f - chord), kMaxHalfTangent);
+        const float widenedY = std::min((tanY + chord) / (1.0f - chord), kMaxHalfTangent);
+        widen[0][0] = tanX / widenedX;
+        widen[1][1] = tanY / widenedY;
+
+        // 深度 d、横向偏移 l 的点旋转后深度在 [d·cosθ - |l|·sinθ, d + |l|·sinθ] 内，
+        // |l| <= d·sqrt(tanX² + tanY²)，近远平面按此向外平移（乘以各自的距离）
+        const float lateral = std::sqrt(tanX * tanX + tanY * tanY);
+        nearScale = 1.0f - std::cos(margin) + lateral * std::sin(margin);
+        farScale = lateral * std::sin(margin);
+    }
+
+    Frustum frustum = Frustum::fromMatrix(widen * snapshot.unjittered.viewProjection);
+
+    // 近远平面距离取自矩阵本身，与 snapshot.nearPlane / farPlane 是否填写无关
+    const float nearDistance = -frustum.near.distanceToPoint(snapshot.position);
+    const float farDistance = frustum.far.distanceToPoint(snapshot.position);
+    if (nearDistance > 0.0f) {
+        frustum.near.d += nearDistance * nearScale;
+    }
+    if (farDistance > 0.0f && std::isfinite(farDistance)) {
+        frustum.far.d += farDistance * farScale;
+    }
+    if (settings.cullingMarginDistance > 0.0f) {
+        Plane* planes[] = {
+            &frustum.left, &frustum.right, &frustum.bottom, &frustum.top, &frustum.near, &frustum.far,
+        };
+        for (Plane* plane : planes) {
+            plane->d += settings.cullingMarginDistance;
+        }
+    }
+
+    snapshot.frustum = frustum;
+    snapshot.frustumPlanes = FrustumPlanesSoA::fromFrustum(frustum);
+}
+
+// ============================================================================
+// 槽位
+// ============================================================================
+
+bool LateLatchBuffer::initialize(void* mappedMemory, size_t size, uint32_t slotCount, uint32_t offsetAlignment) {
+    slotCount_ = 0;
+    memory_ = nullptr;
+    ownedMemory_.clear();
+    if (slotCount == 0) {
+        return false;
+    }
+
+    const size_t alignment = std::max<size_t>(offsetAlignment, 16);
+    const size_t stride = (sizeof(LateLatchCameraConstants) + alignment - 1) / alignment * alignment;
+
+    if (mappedMemory) {
+        if (size < stride * slotCount) {
+            return false;
+        }
+        memory_ = static_cast<uint8_t*>(mappedMemory);
+    } else {
+        ownedMemory_.resize(stride * slotCount);
+        memory_ = ownedMemory_.data();
+    }
+
+    slotCount_ = slotCount;
+    slotStride_ = stride;
+    for (uint32_t i = 0; i < slotCount_; ++i) {
+        *slotPointer(i) = LateLatchCameraConstants();
+    }
+    return true;
+}
+
+LateLatchCameraConstants* LateLatchBuffer::slotPointer(uint32_t slot) const {
+    return reinterpret_cast<LateLatchCameraConstants*>(memory_ + getSlotOffset(slot));
+}
+
+const LateLatchCameraConstants& LateLatchBuffer::getConstants(uint32_t slot) const {
+    return *slotPointer(slot);
+}
+
+// ============================================================================
+// 写入与锁存
+// ============================================================================
+
+void LateLatchBuffer::writeEarly(uint32_t slot, const CameraSnapshot& snapshot, uint64_t sampleTimeNs) {
+    if (!isInitialized()) {
+        return;
+    }
+
+    LateLatchCameraConstants constants;
+    constants.viewProjection = snapshot.jittered.viewProjection;
+    constants.view = snapshot.jittered.view;
+    constants.projection = snapshot.jittered.projection;
+    constants.previousViewProjection = snapshot.previous.viewProjection;
+    constants.cameraPosition = Vector4(snapshot.position, 1.0f);
+    *slotPointer(slot) = constants;
+
+    currentSlot_ = slot;
+    culledView_ = snapshot.unjittered.view;
+    culledProjection_ = snapshot.unjittered.projection;
+    culledPosition_ = snapshot.position;
+    jitterNdc_ = snapshot.jitterNdc;
+    earlySampleTimeNs_ = sampleTimeNs;
+    pending_ = true;
+}
+
+bool LateLatchBuffer::latch(const CameraInputSample& latest, uint64_t submitTimeNs) {
+    if (!pending_) {
+        return false;
+    }
+    PRISMA_PROFILE_ZONE("LateLatch::latch");
+
+    frameStats_ = LateLatchFrameStats();
+
+    // 比剔除相机更旧的采样没有意义
+    if (latest.sampleTimeNs <= earlySampleTimeNs_) {
+        finishFrame(submitTimeNs, earlySampleTimeNs_);
+        return false;
+    }
+
+    const Vector3 position = Vector3(glm::inverse(latest.viewMatrix)[3]);
+    frameStats_.translation = glm::length(position - culledPosition_);
+    frameStats_.rotationDegrees = rotationBetween(latest.viewMatrix, culledView_);
+
+    const bool widerView =
+        latest.projectionMatrix[0][0] < culledProjection_[0][0] * (1.0f - kProjectionTolerance) ||
+        latest.projectionMatrix[1][1] < culledProjection_[1][1] * (1.0f - kProjectionTolerance);
+
+    if (widerView ||
+        frameStats_.translation > settings_.cullingMarginDistance ||
+        frameStats_.rotationDegrees > settings_.cullingMarginDegrees) {
+        // 剔除结果不能覆盖新相机，保留剔除相机
+        frameStats_.rejected = true;
+        finishFrame(submitTimeNs, earlySampleTimeNs_);
+        return false;
+    }
+
+    LateLatchCameraConstants& constants = *slotPointer(currentSlot_);
+    const Matrix4 jitter = glm::translate(Matrix4(1.0f), Vector3(jitterNdc_, 0.0f));
+    constants.view = latest.viewMatrix;
+    constants.projection = jitter * latest.projectionMatrix;
+    constants.viewProjection = constants.projection * constants.view;
+    constants.cameraPosition = Vector4(position, 1.0f);
+
+    frameStats_.latched = true;
+    finishFrame(submitTimeNs, latest.sampleTimeNs);
+    return true;
+}
+
+void LateLatchBuffer::submitWithoutLatch(uint64_t submitTimeNs) {
+    if (!pending_) {
+        return;
+    }
+    frameStats_ = LateLatchFrameStats();
+    finishFrame(submitTimeNs, earlySampleTimeNs_);
+}
+
+void LateLatchBuffer::finishFrame(uint64_t submitTimeNs, uint64_t usedSampleTimeNs) {
+    pending_ = false;
+
+    frameStats_.earlyLatencyMs = submitTimeNs > earlySampleTimeNs_ ? nsToMs(submitTimeNs - earlySampleTimeNs_) : 0.0f;
+    frameStats_.submittedLatencyMs = submitTimeNs > usedSampleTimeNs ? nsToMs(submitTimeNs - usedSampleTimeNs) : 0.0f;
+
+    // 累计平均
+    ++stats_.frames;
+    stats_.latched += frameStats_.latched;
+    stats_.rejected += frameStats_.rejected;
+    const float weight = 1.0f / static_cast<float>(stats_.frames);
+    stats_.averageEarlyLatencyMs += (frameStats_.earlyLatencyMs - stats_.averageEarlyLatencyMs) * weight;
+    stats_.averageSubmittedLatencyMs += (frameStats_.submittedLatencyMs - stats_.averageSubmittedLatencyMs) * weight;
+    stats_.maxSubmittedLatencyMs = std::max(stats_.maxSubmittedLatencyMs, frameStats_.submittedLatencyMs);
+}
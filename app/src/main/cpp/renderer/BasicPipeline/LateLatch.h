@@ -0,0 +1,219 @@
+/**
+ * @file LateLatch.h
+ * @brief 相机矩阵后期锁存（Late Latch）- 在提交前用最新输入改写相机常量，降低输入延迟
+ *
+ * 相机矩阵在 PrepareRendering 中写入 RenderingData，之后还要经过剔除、排序、命令录制，
+ * GPU 真正读取时输入已经过时一到两帧，触摸拖动相机会感觉“跟手慢”
+ *
+ * 后期锁存的做法:
+ * 1. 相机常量放在持久映射（HOST_VISIBLE | HOST_COHERENT）缓冲中，每个飞行帧一个槽位，
+ *    着色器通过动态偏移读取本帧槽位
+ * 2. PrepareRendering 用当时的相机写入槽位（writeEarly），剔除视锥体按 LateLatchSettings 的
+ *    角度和位移余量保守扩大（ApplyLateLatchCullingMargin）
+ * 3. 命令录制完成、vkQueueSubmit 之前重新采样输入，用最新相机改写槽位（latch）。
+ *    最新相机与剔除相机的差异超过余量时放弃改写，保证不会有对象因剔除过紧而缺失
+ *
+ * 命令缓冲只引用槽位偏移，不包含矩阵本身，因此改写不需要重新录制
+ * 主机写入在 vkQueueSubmit 时对 GPU 可见（HOST_COHERENT；非一致内存需要调用者 flush）
+ *
+ * 统计: 每帧记录“输入采样 → 提交”的延迟，分别给出不锁存（PrepareRendering 采样）与
+ * 实际使用的相机的延迟，写入 LateLatchStats 和 RenderStats
+ *
+ * 用法:
+ * @code
+ *
+ * // 初始化: mapped 为持久映射的指针
+ * lateLatch.initialize(mapped, bufferSize, framesInFlight, minUniformBufferOffsetAlignment);
+ *
+ * // PrepareRendering
+ * snapshot = CameraSnapshot::build(params, &snapshot);
+ * ApplyLateLatchCullingMargin(snapshot, lateLatch.getSettings());
+ * lateLatch.writeEarly(frameSlot, snapshot, inputSampleTimeNs);
+ *
+ * // 录制命令时绑定 lateLatch.getSlotOffset(frameSlot) 作为相机常量的动态偏移
+ * ...
+ *
+ * // vkQueueSubmit 之前
+ * lateLatch.latch(sampleLatestCameraInput());
+ * vkQueueSubmit(...);
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "CameraSnapshot.h"
+#include "../../MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 单调时钟（纳秒），输入采样和提交时间都使用它
+ */
+uint64_t GetLateLatchTimeNs();
+
+/**
+ * @brief 后期锁存配置
+ */
+struct LateLatchSettings {
+    /** 剔除视锥体每个方向扩大的角度（度），覆盖锁存前后相机的旋转 */
+    float cullingMarginDegrees = 2.0f;
+
+    /** 剔除平面向外平移的距离（米），覆盖锁存前后相机的位移 */
+    float cullingMarginDistance = 0.1f;
+};
+
+/**
+ * @brief 着色器读取的相机常量（std140）
+ */
+struct LateLatchCameraConstants {
+    /** 光栅化使用（含本帧抖动） */
+    Matrix4 viewProjection = Matrix4(1.0f);
+    Matrix4 view = Matrix4(1.0f);
+    Matrix4 projection = Matrix4(1.0f);
+
+    /** 上一帧的未抖动视图-投影矩阵（运动矢量） */
+    Matrix4 previousViewProjection = Matrix4(1.0f);
+
+    /** xyz: 相机位置，w 未使用 */
+    Vector4 cameraPosition = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+};
+
+/**
+ * @brief 一次输入采样得到的相机
+ */
+struct CameraInputSample {
+    Matrix4 viewMatrix = Matrix4(1.0f);
+
+    /** 未抖动的投影矩阵（抖动沿用本帧快照） */
+    Matrix4 projectionMatrix = Matrix4(1.0f);
+
+    /** 产生该相机的输入事件的采样时间（GetLateLatchTimeNs） */
+    uint64_t sampleTimeNs = 0;
+};
+
+/**
+ * @brief 单帧锁存结果
+ */
+struct LateLatchFrameStats {
+    /** 用最新相机改写了常量 */
+    bool latched = false;
+
+    /** 有更新的输入，但超出剔除余量而放弃 */
+    bool rejected = false;
+
+    /** 剔除相机（writeEarly）的输入采样到提交的延迟（毫秒） */
+    float earlyLatencyMs = 0.0f;
+
+    /** GPU 实际使用的相机的输入采样到提交的延迟（毫秒） */
+    float submittedLatencyMs = 0.0f;
+
+    /** 最新相机相对剔除相机的位移（米）和旋转（度） */
+    float translation = 0.0f;
+    float rotationDegrees = 0.0f;
+};
+
+/**
+ * @brief 累计统计
+ */
+struct LateLatchStats {
+    uint64_t frames = 0;
+    uint64_t latched = 0;
+    uint64_t rejected = 0;
+
+    float averageEarlyLatencyMs = 0.0f;
+    float averageSubmittedLatencyMs = 0.0f;
+    float maxSubmittedLatencyMs = 0.0f;
+};
+
+/**
+ * @brief 按后期锁存余量扩大快照的剔除视锥体
+ *
+ * 透视投影按旋转 cullingMarginDegrees（任意轴，含滚转）的上界扩大: 水平、垂直半角覆盖视锥角上点的移动，
+ * 近远平面按 距离·tan(半角)·sin(余量) 向外平移；所有平面再向外平移 cullingMarginDistance。
+ * 锁存视锥内的点不会被扩大后的视锥剔除。正交投影只做平移。
+ * 只修改 frustum / frustumPlanes，矩阵不变。应在快照发布给工作线程之前调用
+ */
+void ApplyLateLatchCullingMargin(CameraSnapshot& snapshot, const LateLatchSettings& settings);
+
+/**
+ * @brief 持久映射的相机常量环形缓冲与后期锁存
+ *
+ * 只在主线程（渲染提交线程）使用
+ */
+class LateLatchBuffer {
+public:
+    void setSettings(const LateLatchSettings& settings) { settings_ = settings; }
+    const LateLatchSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 初始化槽位
+     *
+     * @param mappedMemory 持久映射的缓冲（为 nullptr 时使用内部内存，例如空后端）
+     * @param size 缓冲字节数（mappedMemory 为 nullptr 时忽略）
+     * @param slotCount 槽位数（通常等于飞行帧数）
+     * @param offsetAlignment 动态偏移对齐（minUniformBufferOffsetAlignment）
+     * @return 缓冲容纳不下 slotCount 个槽位时返回 false
+     */
+    bool initialize(void* mappedMemory, size_t size, uint32_t slotCount, uint32_t offsetAlignment = 256);
+
+    bool isInitialized() const { return slotCount_ > 0; }
+    uint32_t getSlotCount() const { return slotCount_; }
+    size_t getSlotStride() const { return slotStride_; }
+
+    /** 槽位在缓冲中的字节偏移（绑定时的动态偏移） */
+    size_t getSlotOffset(uint32_t slot) const { return static_cast<size_t>(slot % slotCount_) * slotStride_; }
+
+    /** 槽位当前内容 */
+    const LateLatchCameraConstants& getConstants(uint32_t slot) const;
+
+    /**
+     * @brief 用剔除相机写入槽位（PrepareRendering）
+     *
+     * @param slot 本帧槽位（通常为帧号 % 槽位数）
+     * @param snapshot 本帧快照（抖动与上一帧矩阵在锁存时沿用）
+     * @param sampleTimeNs 产生该相机的输入采样时间
+     */
+    void writeEarly(uint32_t slot, const CameraSnapshot& snapshot, uint64_t sampleTimeNs);
+
+    /**
+     * @brief 提交前用最新相机改写本帧槽位
+     *
+     * 最新相机相对剔除相机的旋转或位移超出余量、或视野变宽时放弃改写
+     * @return 是否改写
+     */
+    bool latch(const CameraInputSample& latest, uint64_t submitTimeNs = GetLateLatchTimeNs());
+
+    /**
+     * @brief 没有更新的输入时直接提交（只记录延迟）
+     */
+    void submitWithoutLatch(uint64_t submitTimeNs = GetLateLatchTimeNs());
+
+    const LateLatchFrameStats& getFrameStats() const { return frameStats_; }
+    const LateLatchStats& getStats() const { return stats_; }
+    void resetStats() { stats_ = LateLatchStats(); }
+
+private:
+    LateLatchCameraConstants* slotPointer(uint32_t slot) const;
+    void finishFrame(uint64_t submitTimeNs, uint64_t usedSampleTimeNs);
+
+    LateLatchSettings settings_;
+
+    uint8_t* memory_ = nullptr;
+    std::vector<uint8_t> ownedMemory_;
+    uint32_t slotCount_ = 0;
+    size_t slotStride_ = 0;
+
+    // 本帧剔除相机（writeEarly 写入）
+    uint32_t currentSlot_ = 0;
+    Matrix4 culledView_ = Matrix4(1.0f);
+    Matrix4 culledProjection_ = Matrix4(1.0f);
+    Vector3 culledPosition_ = Vector3(0.0f);
+    Vector2 jitterNdc_ = Vector2(0.0f);
+    uint64_t earlySampleTimeNs_ = 0;
+    bool pending_ = false;
+
+    LateLatchFrameStats frameStats_;
+    LateLatchStats stats_;
+};
@@ -0,0 +1,372 @@
+/**
+ * @file LightAggregator.cpp
+ * @brief 光源 LOD 聚合实现
+ */
+
+#include "LightAggregator.h"
+#include "CameraSnapshot.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/** 聚类 LOD 级别上限（打包时占 4 位） */
+constexpr uint32_t kMaxClusterLevel = 15;
+
+/** 每轴网格坐标的位数（有符号，偏移后打包） */
+constexpr uint32_t kCoordinateBits = 20;
+constexpr int64_t kCoordinateBias = int64_t(1) << (kCoordinateBits - 1);
+constexpr uint64_t kCoordinateMask = (uint64_t(1) << kCoordinateBits) - 1;
+
+/** 颜色亮度（Rec.709） */
+float luminance(const Vector3& color) {
+    return color.x * 0.2126f + color.y * 0.7152f + color.z * 0.0722f;
+}
+
+/**
+ * @brief 屏幕重要性: 亮度 × 影响球在屏幕上的半径占屏幕高度的比例（相机在球内时为 1）
+ * @param projectionScale 投影矩阵的 [1][1]（cot(fov / 2)）
+ */
+float screenImportance(const LightData& light, const Vector3& cameraPosition, float projectionScale) {
+    const float brightness = luminance(light.color) * light.intensity;
+    const float distance = glm::length(light.position - cameraPosition);
+    if (distance <= light.range) {
+        return brightness;
+    }
+    const float tangent = std::sqrt(distance * distance - light.range * light.range);
+    return brightness * std::min(0.5f * projectionScale * light.range / tangent, 1.0f);
+}
+
+/**
+ * @brief 衰减在影响球内的积分 / range³（InverseSquare: 4π(1 - π/4)，Linear: π/3）
+ */
+float attenuationVolume(const LightData& light) {
+    return light.attenuation == LightData::Attenuation::InverseSquare ? 2.6967466f : 1.0471976f;
+}
+
+/** 盒子体积（任一边为负时为 0） */
+float volume(const Vector3& extent) {
+    return std::max(extent.x, 0.0f) * std::max(extent.y, 0.0f) * std::max(extent.z, 0.0f);
+}
+
+/** 聚光灯锥体占全向的比例 */
+float coneFraction(const LightData& light) {
+    if (light.type != LightType::Spot) {
+        return 1.0f;
+    }
+    return 0.5f * (1.0f - std::cos(glm::radians(light.outerAngle)));
+}
+
+uint64_t packCoordinates(int64_t x, int64_t y, int64_t z) {
+    auto pack = [](int64_t v) {
+        return static_cast<uint64_t>(std::clamp(v + kCoordinateBias, int64_t(0), int64_t(kCoordinateMask)));
+    };
+    return (pack(x) << (2 * kCoordinateBits)) | (pack(y) << kCoordinateBits) | pack(z);
+}
+
+int64_t cellCoordinate(float value, float cellSize) {
+    return static_cast<int64_t>(std::floor(value / cellSize));
+}
+
+/** 到相机的距离对应的 LOD 级别: clusterLodDistance 以内为 0，之后距离每翻一倍升一级 */
+int lodLevel(const LightAggregationSettings& settings, float distance) {
+    const float lodDistance = std::max(settings.clusterLodDistance, 0.001f);
+    if (distance < lodDistance) {
+        return 0;
+    }
+    const int maxLevel = static_cast<int>(std::min(settings.maxClusterLevel, kMaxClusterLevel));
+    return std::min(static_cast<int>(std::floor(std::log2(distance / lodDistance))) + 1, maxLevel);
+}
+
+/** LOD 级别与网格坐标打包为 key */
+uint64_t packCell(int level, int64_t x, int64_t y, int64_t z) {
+    return (static_cast<uint64_t>(level) << (3 * kCoordinateBits)) | packCoordinates(x, y, z);
+}
+
+} // namespace
+
+// ============================================================================
+// LightAggregationStats
+// ============================================================================
+
+void LightAggregationStats::writeReport(FILE* out) const {
+    std::fprintf(out, "Local lights: %u in, %u culled, %u real, %u aggregated\n",
+                 inputLights, culledLights, realLights, aggregatedLights);
+    std::fprintf(out, "Clusters: %u, virtual lights %u, projected to regions %u (%u regions, %u dropped)\n",
+                 clusters, virtualLights, regionClusters, regions, droppedRegions);
+}
+
+// ============================================================================
+// LightAggregator
+// ============================================================================
+
+void LightAggregator::aggregate(const LightingData& lighting, const CameraSnapshot& camera) {
+    PRISMA_PROFILE_ZONE("LightAggregator::aggregate");
+
+    stats_ = LightAggregationStats();
+    realPointLights_.clear();
+    realSpotLights_.clear();
+    virtualLights_.clear();
+    regions_.clear();
+    candidates_.clear();
+    clusters_.clear();
+
+    stats_.inputLights = static_cast<uint32_t>(lighting.pointLights.size() + lighting.spotLights.size());
+
+    if (!settings_.enabled) {
+        realPointLights_.assign(lighting.pointLights.begin(), lighting.pointLights.end());
+        realSpotLights_.assign(lighting.spotLights.begin(), lighting.spotLights.end());
+        stats_.realLights = stats_.inputLights;
+        return;
+    }
+
+    cameraPosition_ = camera.position;
+    const Vector3& cameraPosition = cameraPosition_;
+    const float projectionScale = camera.unjittered.projection[1][1];
+
+    auto gather = [&](const LightDataList& lights) {
+        for (const LightData& light : lights) {
+            if (!camera.isSphereVisible(light.position, light.range)) {
+                ++stats_.culledLights;
+                continue;
+            }
+            candidates_.push_back({screenImportance(light, cameraPosition, projectionScale), &light, 0});
+        }
+    };
+    gather(lighting.pointLights);
+    gather(lighting.spotLights);
+
+    // 重要性相同时按原始顺序（点光源在前），结果与容器地址无关
+    std::stable_sort(candidates_.begin(), candidates_.end(),
+                     [](const Candidate& a, const Candidate& b) { return a.importance > b.importance; });
+
+    const uint32_t maxReal = settings_.maxRealLights > 0 ? settings_.maxRealLights : lighting.maxLightsPerFrame;
+    uint32_t realCount = 0;
+    while (realCount < candidates_.size() && realCount < maxReal
+           && candidates_[realCount].importance >= settings_.importanceThreshold) {
+        const LightData& light = *candidates_[realCount].light;
+        (light.type == LightType::Spot ? realSpotLights_ : realPointLights_).push_back(light);
+        ++realCount;
+    }
+    stats_.realLights = realCount;
+
+    candidates_.erase(candidates_.begin(), candidates_.begin() + realCount);
+    stats_.aggregatedLights = static_cast<uint32_t>(candidates_.size());
+    if (candidates_.empty()) {
+        return;
+    }
+
+    buildClusters(cameraPosition, projectionScale);
+
+    std::stable_sort(clusters_.begin(), clusters_.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.importance > b.importance; });
+
+    const uint32_t virtualCount = std::min(settings_.maxVirtualLights, static_cast<uint32_t>(clusters_.size()));
+    for (uint32_t i = 0; i < virtualCount; ++i) {
+        virtualLights_.push_back(clusters_[i].light);
+    }
+    stats_.virtualLights = virtualCount;
+
+    if (settings_.projectToRegions) {
+        buildRegions(virtualCount);
+    }
+}
+
+void LightAggregator::buildClusters(const Vector3& cameraPosition, float projectionScale) {
+    PRISMA_PROFILE_ZONE("LightAggregator::buildClusters");
+
+    for (Candidate& candidate : candidates_) {
+        const Vector3& position = candidate.light->position;
+        const int level = lodLevel(settings_, glm::length(position - cameraPosition));
+        const float cellSize = std::ldexp(settings_.clusterCellSize, level);
+        candidate.cell = packCell(level, cellCoordinate(position.x, cellSize), cellCoordinate(position.y, cellSize),
+                                  cellCoordinate(position.z, cellSize));
+    }
+
+    std::stable_sort(candidates_.begin(), candidates_.end(),
+                     [](const Candidate& a, const Candidate& b) { return a.cell < b.cell; });
+
+    for (size_t begin = 0; begin < candidates_.size();) {
+        size_t end = begin + 1;
+        while (end < candidates_.size() && candidates_[end].cell == candidates_[begin].cell) {
+            ++end;
+        }
+
+        // 通量加权的中心
+        Vector3 weightedPosition(0.0f);
+        Vector3 meanPosition(0.0f);
+        float weightSum = 0.0f;
+        for (size_t i = begin; i < end; ++i) {
+            const LightData& light = *candidates_[i].light;
+            const float weight = luminance(light.color) * light.intensity * coneFraction(light);
+            weightedPosition += light.position * weight;
+            meanPosition += light.position;
+            weightSum += weight;
+        }
+        const Vector3 center = weightSum > 0.0f
+            ? weightedPosition / weightSum
+            : meanPosition / static_cast<float>(end - begin);
+
+        // 影响球覆盖所有成员；影响体积内的总光照（衰减的体积积分 × 强度）保持不变
+        Cluster cluster;
+        cluster.energy = Vector3(0.0f);
+        cluster.lower = Vector3(std::numeric_limits<float>::max());
+        cluster.upper = Vector3(std::numeric_limits<float>::lowest());
+        float range = 0.0f;
+        for (size_t i = begin; i < end; ++i) {
+            const LightData& light = *candidates_[i].light;
+            range = std::max(range, glm::length(light.position - center) + light.range);
+            cluster.energy += light.color * (light.intensity * coneFraction(light) * attenuationVolume(light)
+                                             * light.range * light.range * light.range);
+            cluster.lower = glm::min(cluster.lower, light.position - Vector3(light.range));
+            cluster.upper = glm::max(cluster.upper, light.position + Vector3(light.range));
+        }
+        begin = end;
+
+        cluster.light = LightData::createPoint(center, range);
+        const Vector3 radiant = cluster.energy
+                              / std::max(attenuationVolume(cluster.light) * range * range * range, 0.0001f);
+        const float intensity = std::max(radiant.x, std::max(radiant.y, radiant.z));
+        if (intensity <= 0.0f) {
+            continue;
+        }
+        cluster.light.color = radiant / intensity;
+        cluster.light.intensity = intensity;
+        cluster.importance = screenImportance(cluster.light, cameraPosition, projectionScale);
+        clusters_.push_back(cluster);
+    }
+
+    stats_.clusters = static_cast<uint32_t>(clusters_.size());
+}
+
+void LightAggregator::buildRegions(uint32_t firstCluster) {
+    PRISMA_PROFILE_ZONE("LightAggregator::buildRegions");
+
+    // 每个聚类登记到与其成员影响范围（包围盒）相交的区域。区域与聚类单元一样按到相机的距离分级，
+    // 包围盒跨越的每个级别都登记一次，查询时只用查询点所在级别的区域
+    regionEntries_.clear();
+    for (uint32_t k = firstCluster; k < clusters_.size(); ++k) {
+        const Cluster& cluster = clusters_[k];
+        const Vector3 closest = glm::clamp(cameraPosition_, cluster.lower, cluster.upper);
+        const Vector3 farthest = glm::max(glm::abs(cluster.lower - cameraPosition_),
+                                          glm::abs(cluster.upper - cameraPosition_));
+        const int firstLevel = lodLevel(settings_, glm::length(closest - cameraPosition_));
+        const int lastLevel = lodLevel(settings_, glm::length(farthest));
+
+        for (int level = firstLevel; level <= lastLevel; ++level) {
+            const float size = getRegionSize(level);
+            for (int64_t x = cellCoordinate(cluster.lower.x, size); x <= cellCoordinate(cluster.upper.x, size); ++x) {
+                for (int64_t y = cellCoordinate(cluster.lower.y, size); y <= cellCoordinate(cluster.upper.y, size); ++y) {
+                    for (int64_t z = cellCoordinate(cluster.lower.z, size); z <= cellCoordinate(cluster.upper.z, size);
+                         ++z) {
+                        regionEntries_.push_back({packCell(level, x, y, z), k});
+                    }
+                }
+            }
+        }
+    }
+    stats_.regionClusters = static_cast<uint32_t>(clusters_.size()) - firstCluster;
+
+    std::stable_sort(regionEntries_.begin(), regionEntries_.end(),
+                     [](const RegionEntry& a, const RegionEntry& b) { return a.key < b.key; });
+
+    for (size_t begin = 0; begin < regionEntries_.size();) {
+        size_t end = begin + 1;
+        while (end < regionEntries_.size() && regionEntries_[end].key == regionEntries_[begin].key) {
+            ++end;
+        }
+        if (regions_.size() >= settings_.maxRegions) {
+            ++stats_.droppedRegions;
+            begin = end;
+            continue;
+        }
+
+        const uint64_t key = regionEntries_[begin].key;
+        auto unpack = [key](uint32_t shift) {
+            return static_cast<float>(static_cast<int64_t>((key >> shift) & kCoordinateMask) - kCoordinateBias);
+        };
+        const float size = getRegionSize(static_cast<int>(key >> (3 * kCoordinateBits)));
+        const Vector3 boxMin = Vector3(unpack(2 * kCoordinateBits), unpack(kCoordinateBits), unpack(0)) * size;
+
+        LightRegionSH region;
+        region.key = key;
+        region.center = boxMin + Vector3(0.5f * size);
+
+        // 聚类的光照按成员包围盒内的体积密度计算，区域取各聚类与区域交集内光照的体积平均。
+        // 归一化体积取所有交集的包围盒而非整个区域: 接收者通常就在光源附近（城市的光源只占
+        // 很薄的一层），按整个区域平均会被空旷的部分稀释
+        Vector3 boundsMin(std::numeric_limits<float>::max());
+        Vector3 boundsMax(std::numeric_limits<float>::lowest());
+        for (size_t i = begin; i < end; ++i) {
+            const Cluster& cluster = clusters_[regionEntries_[i].cluster];
+            boundsMin = glm::min(boundsMin, glm::max(cluster.lower, boxMin));
+            boundsMax = glm::max(boundsMax, glm::min(cluster.upper, boxMin + Vector3(size)));
+        }
+        const float boundsVolume = std::max(volume(boundsMax - boundsMin), 0.0001f);
+
+        // 方向取交集中心指向聚类中心: 光源偏在交集一侧时带方向性，位于中部时过渡为
+        // 均匀环境光（余弦 max(n·l, 0) 对所有法线的平均为 1/4）
+        SH9RGB radiance;
+        for (size_t i = begin; i < end; ++i) {
+            const Cluster& cluster = clusters_[regionEntries_[i].cluster];
+            const Vector3 overlapMin = glm::max(cluster.lower, boxMin);
+            const Vector3 overlapMax = glm::min(cluster.upper, boxMin + Vector3(size));
+            const float overlap = volume(overlapMax - overlapMin);
+            const Vector3 irradiance = cluster.energy
+                                     * (overlap / (std::max(volume(cluster.upper - cluster.lower), 0.0001f) * boundsVolume));
+
+            const Vector3 toLight = cluster.light.position - (overlapMin + overlapMax) * 0.5f;
+            const float distance = glm::length(toLight);
+            const float directional = std::min(distance / std::max(0.5f * glm::length(overlapMax - overlapMin), 0.0001f),
+                                               1.0f);
+            if (directional > 0.0f) {
+                AddSHDirectional(radiance, toLight / distance, irradiance * (kPi * directional));
+            }
+            if (directional < 1.0f) {
+                AddSHUniform(radiance, irradiance * (0.25f * (1.0f - directional)));
+            }
+        }
+        ApplySHWindow(radiance, SHWindow::Hann);
+        region.lighting = ConvolveSHLambert(radiance) * (1.0f / kPi);
+        regions_.push_back(region);
+        begin = end;
+    }
+    stats_.regions = static_cast<uint32_t>(regions_.size());
+}
+
+float LightAggregator::getRegionSize(int level) const {
+    return std::ldexp(std::max(settings_.shRegionSize, 0.001f), level);
+}
+
+void LightAggregator::applyTo(LightingData& out) const {
+    out.pointLights.assign(realPointLights_.begin(), realPointLights_.end());
+    out.pointLights.insert(out.pointLights.end(), virtualLights_.begin(), virtualLights_.end());
+    out.spotLights.assign(realSpotLights_.begin(), realSpotLights_.end());
+}
+
+uint64_t LightAggregator::getRegionKey(const Vector3& position) const {
+    const int level = lodLevel(settings_, glm::length(position - cameraPosition_));
+    const float size = getRegionSize(level);
+    return packCell(level, cellCoordinate(position.x, size), cellCoordinate(position.y, size),
+                    cellCoordinate(position.z, size));
+}
+
+const LightRegionSH* LightAggregator::findRegion(const Vector3& position) const {
+    const uint64_t key = getRegionKey(position);
+    auto it = std::lower_bound(regions_.begin(), regions_.end(), key,
+                               [](const LightRegionSH& region, uint64_t k) { return region.key < k; });
+    return it != regions_.end() && it->key == key ? &*it : nullptr;
+}
+
+Vector3 LightAggregator::evaluateRegionLighting(const Vector3& position, const Vector3& normal) const {
+    const LightRegionSH* region = findRegion(position);
+    if (!region) {
+        return Vector3(0.0f);
+    }
+    return glm::max(EvaluateSH(region->lighting, normal), Vector3(0.0f));
+}
@@ -0,0 +1,215 @@
+/**
+ * @file LightAggregator.h
+ * @brief 光源 LOD - 远处不重要的局部光源聚类合并为虚拟光源或区域 SH
+ *
+ * 城市窗户、路灯这类场景有成百上千个小点光源，远超 LightingData::maxLightsPerFrame，
+ * 而其中大多数离相机很远、单独看几乎不可见。LightAggregator 每帧:
+ * 1. 剔除影响球不在视锥体内的点光源和聚光灯
+ * 2. 按屏幕重要性（亮度 × 影响球在屏幕上的半径占屏幕高度的比例）排序，
+ *    超过阈值的前 maxRealLights 个保留为真实光源
+ * 3. 其余光源按空间网格聚类，网格单元随到相机的距离倍增（越远聚得越粗）
+ * 4. 每个聚类合并为一个点光源（通量加权的中心，保持影响体积内的总光照 Σ I r³ 不变），
+ *    最重要的 maxVirtualLights 个聚类作为虚拟光源进入光源列表
+ * 5. 剩余聚类以成员影响范围内的平均光照投影到相交区域的 L2 SH（区域网格同样随距离倍增），
+ *    着色时每个点一次 SH 求值
+ *
+ * 远处光源的着色开销因此近似为常数: 真实光源 + 虚拟光源数有上限，其余只是一张区域 SH 表。
+ * 合并后的光源不投射实时阴影；保留的真实光源保持 LightData::id，阴影光源从 applyTo 的结果中选择
+ * （见 ShadowLightSelector.h）
+ *
+ * 约定:
+ * - 区域 SH 已做 Lambert 卷积并除以 π，EvaluateSH(region.lighting, normal) 直接得到
+ *   与光照贴图 / LightingData::calculateLightingAtPoint 同约定的光照值
+ * - 聚光灯合并时按锥体立体角比例 (1 - cos(outer)) / 2 折算为全向通量
+ *
+ * 用法:
+ * @code
+ *
+ * LightAggregator aggregator;
+ * aggregator.setSettings(settings);
+ *
+ * // 每帧，相机快照构建之后
+ * aggregator.aggregate(lightingData, cameraSnapshot);
+ * aggregator.applyTo(frameLighting);          // 点光源/聚光灯替换为真实 + 虚拟光源
+ * Vector3 far = aggregator.evaluateRegionLighting(position, normal);
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "LightingData.h"
+#include "MemoryTracker.h"
+#include "SphericalHarmonics.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+#include <cstdio>
+
+struct CameraSnapshot;
+
+/**
+ * @brief 光源聚合配置
+ */
+struct LightAggregationSettings {
+    bool enabled = true;
+
+    /** 保留为真实光源的最低屏幕重要性（亮度 × 屏幕高度比例） */
+    float importanceThreshold = 0.05f;
+
+    /** 真实光源上限（0 使用 LightingData::maxLightsPerFrame） */
+    uint32_t maxRealLights = 0;
+
+    /** clusterLodDistance 以内的聚类单元边长（米） */
+    float clusterCellSize = 16.0f;
+
+    /** 超过该距离后，每翻一倍聚类单元边长也翻一倍（米） */
+    float clusterLodDistance = 64.0f;
+
+    /** 聚类单元最多翻倍的次数（限制合并光源的影响范围和登记的区域数） */
+    uint32_t maxClusterLevel = 3;
+
+    /** 作为虚拟光源输出的聚类上限（其余投影到区域 SH） */
+    uint32_t maxVirtualLights = 8;
+
+    /** 超出虚拟光源上限的聚类投影到区域 SH；false 时直接丢弃 */
+    bool projectToRegions = true;
+
+    /** clusterLodDistance 以内的区域边长（米），更远处与聚类单元同样倍增 */
+    float shRegionSize = 64.0f;
+
+    /** 区域数上限（超出的区域丢弃并计入统计） */
+    uint32_t maxRegions = 256;
+};
+
+/**
+ * @brief 一个光照区域（区域 SH）
+ */
+struct LightRegionSH {
+    /** 打包的 LOD 级别与网格坐标（见 LightAggregator::getRegionKey） */
+    uint64_t key = 0;
+
+    Vector3 center = Vector3(0.0f);
+
+    /** 光照贴图约定的余弦卷积 SH */
+    SH9RGB lighting;
+};
+
+/**
+ * @brief 每帧聚合统计
+ */
+struct LightAggregationStats {
+    /** 输入的点光源 + 聚光灯 */
+    uint32_t inputLights = 0;
+
+    /** 影响球在视锥体外而剔除 */
+    uint32_t culledLights = 0;
+
+    uint32_t realLights = 0;
+
+    /** 参与聚类的光源 */
+    uint32_t aggregatedLights = 0;
+
+    uint32_t clusters = 0;
+    uint32_t virtualLights = 0;
+
+    /** 投影到区域 SH 的聚类 */
+    uint32_t regionClusters = 0;
+    uint32_t regions = 0;
+    uint32_t droppedRegions = 0;
+
+    /** 聚合后的局部光源数（真实 + 虚拟） */
+    uint32_t outputLights() const { return realLights + virtualLights; }
+
+    void writeReport(FILE* out) const;
+};
+
+/**
+ * @brief 光源 LOD 聚合器
+ */
+class LightAggregator {
+public:
+    void setSettings(const LightAggregationSettings& settings) { settings_ = settings; }
+    const LightAggregationSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 聚合本帧的点光源和聚光灯
+     * @param camera 未抖动矩阵用于剔除和屏幕重要性
+     */
+    void aggregate(const LightingData& lighting, const CameraSnapshot& camera);
+
+    /** 保留的真实点光源 / 聚光灯 */
+    const LightDataList& getRealPointLights() const { return realPointLights_; }
+    const LightDataList& getRealSpotLights() const { return realSpotLights_; }
+
+    /** 虚拟光源（点光源） */
+    const LightDataList& getVirtualLights() const { return virtualLights_; }
+
+    /** 区域，按 key 升序 */
+    const TaggedVector<LightRegionSH, MemoryTag::Lighting>& getRegions() const { return regions_; }
+
+    /**
+     * @brief 用聚合结果替换 out 的点光源和聚光灯（定向光、环境光和配置不变）
+     */
+    void applyTo(LightingData& out) const;
+
+    /**
+     * @brief position 所在区域的光照（没有区域时为 0）
+     */
+    Vector3 evaluateRegionLighting(const Vector3& position, const Vector3& normal) const;
+
+    /** position 所在区域（没有时为 nullptr） */
+    const LightRegionSH* findRegion(const Vector3& position) const;
+
+    /** position 所在区域的 key（级别由到最近一次 aggregate 的相机的距离决定） */
+    uint64_t getRegionKey(const Vector3& position) const;
+
+    /** LOD 级别 level 的区域边长 */
+    float getRegionSize(int level) const;
+
+    const LightAggregationStats& getStats() const { return stats_; }
+
+private:
+    struct Candidate {
+        float importance;
+        const LightData* light;
+
+        /** 聚类单元（打包的 LOD 级别与网格坐标） */
+        uint64_t cell;
+    };
+
+    /** 合并后的聚类 */
+    struct Cluster {
+        LightData light;
+        float importance;
+
+        /** 成员影响球的包围盒 */
+        Vector3 lower;
+        Vector3 upper;
+
+        /** 成员衰减的体积积分 × 强度之和（每通道） */
+        Vector3 energy;
+    };
+
+    /** 聚类影响到的区域 */
+    struct RegionEntry {
+        uint64_t key;
+        uint32_t cluster;
+    };
+
+    void buildClusters(const Vector3& cameraPosition, float projectionScale);
+    void buildRegions(uint32_t firstCluster);
+
+    LightAggregationSettings settings_;
+    LightAggregationStats stats_;
+    Vector3 cameraPosition_ = Vector3(0.0f);
+
+    LightDataList realPointLights_;
+    LightDataList realSpotLights_;
+    LightDataList virtualLights_;
+    TaggedVector<LightRegionSH, MemoryTag::Lighting> regions_;
+
+    /** 每帧复用的临时数组 */
+    TaggedVector<Candidate, MemoryTag::Lighting> candidates_;
+    TaggedVector<Cluster, MemoryTag::Lighting> clusters_;
+    TaggedVector<RegionEntry, MemoryTag::Lighting> regionEntries_;
+};
@@ -0,0 +1,119 @@
+/**
+ * @file LightingData.cpp
+ * @brief 光照数据实现
+ */
+
+#include "LightingData.h"
+#include "AreaLighting.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/** 颜色亮度（Rec.709） */
+float luminance(const Vector3& color) {
+    return color.x * 0.2126f + color.y * 0.7152f + color.z * 0.0722f;
+}
+
+/** 计算光源对某一点的重要性（亮度 × 衰减） */
+float lightImportance(const LightData& light, const Vector3& position) {
+    const float brightness = luminance(light.color) * light.intensity;
+    if (light.type == LightType::Directional) {
+        return brightness;
+    }
+    if (light.type == LightType::Area) {
+        // 辐射亮度 × 发光面对该点的投影立体角 / π（不考虑接收面法线，最大为 1）
+        const Vector3 offset = position - light.position;
+        const float distance2 = std::max(glm::dot(offset, offset), 1e-8f);
+        const float cosLight = std::fabs(glm::dot(light.direction, offset)) / std::sqrt(distance2);
+        const float area = light.areaSize.x * light.areaSize.y
+                         * (light.areaShape == AreaLightShape::Disk ? 0.25f * 3.14159265f : 1.0f);
+        return brightness * std::min(area * cosLight / (3.14159265f * distance2), 1.0f)
+             * GetAreaLightWindow(light, position);
+    }
+    const float distance = glm::length(light.position - position);
+    return brightness * light.calculateAttenuation(distance);
+}
+
+} // namespace
+
+TaggedVector<const LightData*, MemoryTag::Lighting> LightingData::getImportantLights(const Vector3& position,
+                                                                                     uint32_t maxCount) const {
+    struct Candidate {
+        float score;
+        const LightData* light;
+    };
+
+    TaggedVector<Candidate, MemoryTag::Lighting> candidates;
+    candidates.reserve(directionalLights.size() + pointLights.size() + spotLights.size() + areaLights.size());
+
+    auto gather = [&](const LightDataList& lights) {
+        for (const auto& light : lights) {
+            const float score = lightImportance(light, position);
+            if (score > 0.0f) {
+                candidates.push_back({score, &light});
+            }
+        }
+    };
+    gather(directionalLights);
+    gather(pointLights);
+    gather(spotLights);
+    gather(areaLights);
+
+    // 只需要前 maxCount 个，部分排序即可
+    const size_t count = std::min<size_t>(maxCount, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+
+    TaggedVector<const LightData*, MemoryTag::Lighting> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(candidates[i].light);
+    }
+    return result;
+}
+
+Vector3 LightingData::calculateLightingAtPoint(const Vector3& position,
+                                               const Vector3& normal) const {
+    Vector3 total = ambientColor * ambientIntensity;
+
+    for (const auto& light : directionalLights) {
+        const float NdotL = std::max(glm::dot(normal, -light.direction), 0.0f);
+        total += light.color * (light.intensity * NdotL);
+    }
+
+    auto accumulateLocal = [&](const LightData& light, float coneFactor) {
+        const Vector3 toLight = light.position - position;
+        const float distance = glm::length(toLight);
+        if (distance <= 0.0001f || distance >= light.range) {
+            return;
+        }
+        const Vector3 L = toLight / distance;
+        const float NdotL = std::max(glm::dot(normal, L), 0.0f);
+        total += light.color * (light.intensity * NdotL * coneFactor *
+                                light.calculateAttenuation(distance));
+    };
+
+    for (const auto& light : pointLights) {
+        accumulateLocal(light, 1.0f);
+    }
+
+    for (const auto& light : spotLights) {
+        const Vector3 toPoint = glm::normalize(position - light.position);
+        const float cosAngle = glm::dot(toPoint, light.direction);
+        const float cosOuter = std::cos(glm::radians(light.outerAngle));
+        const float cosInner = std::cos(glm::radians(light.innerAngle));
+        const float cone = std::clamp((cosAngle - cosOuter) / std::max(cosInner - cosOuter, 0.0001f),
+                                      0.0f, 1.0f);
+        if (cone > 0.0f) {
+            accumulateLocal(light, cone);
+        }
+    }
+
+    for (const auto& light : areaLights) {
+        total += light.color * (light.intensity * EvaluateAreaLightFormFactor(light, position, normal));
+    }
+
+    return total;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file MemoryTracker.cpp
+ * @brief 内存跟踪实现
+ */
+
+#include "MemoryTracker.h"
+
+namespace {
+
+constexpr const char* MemoryTagNames[] = {
+    "Queue",
+    "Culling",
+    "Lighting",
+    "Shadows",
+    "Features",
+    "Pools",
+    "Scene",
+};
+
+static_assert(sizeof(MemoryTagNames) / sizeof(MemoryTagNames[0]) == MemoryTracker::TagCount,
+              "MemoryTagNames 与 MemoryTag 不一致");
+
+} // namespace
+
+const char* GetMemoryTagName(MemoryTag tag) {
+    const size_t index = static_cast<size_t>(tag);
+    return index < MemoryTracker::TagCount ? MemoryTagNames[index] : "Unknown";
+}
+
+// ============================================================================
+// MemoryTracker
+// ============================================================================
+
+MemoryTracker& MemoryTracker::get() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+void MemoryTracker::endFrame() {
+    // 回调在锁外调用（回调中可以查询统计）
+    MemoryBudgetWarning warnings[TagCount];
+    size_t warningCount = 0;
+    WarningCallback callback;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < TagCount; ++i) {
+        Counters& c = counters_[i];
+        FrameRecord& record = lastFrame_[i];
+
+        record.allocations = c.frameAllocations.exchange(0, std::memory_order_relaxed);
+        record.bytes = c.frameBytes.exchange(0, std::memory_order_relaxed);
+
+        const MemoryBudget& budget = budgets_[i];
+        const uint64_t current = c.currentBytes.load(std::memory_order_relaxed);
+        const bool bytesExceeded = budget.maxBytes > 0 && current > budget.maxBytes;
+        const bool allocationsExceeded = budget.maxFrameAllocations > 0
+            && record.allocations > budget.maxFrameAllocations;
+
+        // 边沿触发：只在刚超出时报告
+        if ((bytesExceeded || allocationsExceeded) && !record.overBudget) {
+            MemoryBudgetWarning warning;
+            warning.tag = static_cast<MemoryTag>(i);
+            warning.frameNumber = frameNumber_;
+            warning.bytesExceeded = bytesExceeded;
+            warning.value = bytesExceeded ? current : record.allocations;
+            warning.budget = bytesExceeded ? budget.maxBytes : budget.maxFrameAllocations;
+            warnings[warningCount++] = warning;
+        }
+        record.overBudget = bytesExceeded || allocationsExceeded;
+    }
+
+    ++frameNumber_;
+    warningCount_ += warningCount;
+    callback = warningCallback_;
+    lock.unlock();
+
+    for (size_t i = 0; i < warningCount; ++i) {
+        if (callback) {
+            callback(warnings[i]);
+        } else {
+            printWarning(warnings[i]);
+        }
+    }
+}
+
+void MemoryTracker::printWarning(const MemoryBudgetWarning& warning) {
+    if (warning.bytesExceeded) {
+        std::fprintf(stderr, "[MemoryTracker] 帧 %llu: %s 占用 %.2f MB 超出预算 %.2f MB\n",
+                     static_cast<unsigned long long>(warning.frameNumber),
+                     GetMemoryTagName(warning.tag),
+                     static_cast<double>(warning.value) / (1024.0 * 1024.0),
+                     static_cast<double>(warning.budget) / (1024.0 * 1024.0));
+    } else {
+        std::fprintf(stderr, "[MemoryTracker] 帧 %llu: %s 本帧分配 %llu 次，超出预算 %llu 次\n",
+                     static_cast<unsigned long long>(warning.frameNumber),
+                     GetMemoryTagName(warning.tag),
+                     static_cast<unsigned long long>(warning.value),
+                     static_cast<unsigned long long>(warning.budget));
+    }
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, const MemoryBudget& budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budgets_[static_cast<size_t>(tag)] = budget;
+    lastFrame_[static_cast<size_t>(tag)].overBudget = false;
+}
+
+MemoryBudget MemoryTracker::getBudget(MemoryTag tag) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budgets_[static_cast<size_t>(tag)];
+}
+
+void MemoryTracker::setWarningCallback(WarningCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    warningCallback_ = std::move(callback);
+}
+
+MemoryTagStats MemoryTracker::getStats(MemoryTag tag) const {
+    const size_t index = static_cast<size_t>(tag);
+    const Counters& c = counters_[index];
+
+    MemoryTagStats stats;
+    stats.currentBytes = c.currentBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+    stats.totalAllocations = c.totalAllocations.load(std::memory_order_relaxed);
+    stats.liveAllocations = c.liveAllocations.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.frameAllocations = lastFrame_[index].allocations;
+    stats.frameBytes = lastFrame_[index].bytes;
+    stats.overBudget = lastFrame_[index].overBudget;
+    return stats;
+}
+
+uint64_t MemoryTracker::getTotalBytes() const {
+    uint64_t total = 0;
+    for (const Counters& c : counters_) {
+        total += c.currentBytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void MemoryTracker::resetPeaks() {
+    for (Counters& c : counters_) {
+        c.peakBytes.store(c.currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void MemoryTracker::writeReport(FILE* out) const {
+    std::fprintf(out, "%-10s %12s %12s %10s %12s %12s %14s %s\n",
+                 "tag", "current(KB)", "peak(KB)", "live", "allocs", "frameAllocs", "frameBytes(KB)", "budget");
+
+    for (size_t i = 0; i < TagCount; ++i) {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = getStats(tag);
+        const MemoryBudget budget = getBudget(tag);
+
+        std::fprintf(out, "%-10s %12.1f %12.1f %10llu %12llu %12u %14.1f %s\n",
+                     GetMemoryTagName(tag),
+                     static_cast<double>(stats.currentBytes) / 1024.0,
+                     static_cast<double>(stats.peakBytes) / 1024.0,
+                     static_cast<unsigned long long>(stats.liveAllocations),
+                     static_cast<unsigned long long>(stats.totalAllocations),
+                     stats.frameAllocations,
+                     static_cast<double>(stats.frameBytes) / 1024.0,
+                     stats.overBudget ? "OVER" : (budget.maxBytes || budget.maxFrameAllocations ? "ok" : "-"));
+    }
+}
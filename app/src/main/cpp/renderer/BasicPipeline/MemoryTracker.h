@@ -0,0 +1,309 @@
+/**
+ * @file MemoryTracker.h
+ * @brief 按子系统标记的内存跟踪与每帧分配预算
+ *
+ * 设计:
+ * - BasicPipeline 中的容器使用 TaggedAllocator（TaggedVector），每次分配归属一个 MemoryTag
+ * - 每个标记统计当前占用、峰值、累计分配次数以及本帧分配次数/字节数
+ * - 计数器为 relaxed 原子量，工作线程分配时不加锁
+ * - 帧结束时（PRISMA_MEMORY_FRAME）汇总本帧分配并检查预算，超出时发出警告
+ *
+ * PRISMA_ENABLE_MEMORY_TRACKING 默认在非 NDEBUG 构建中开启（主机基准构建由同名 CMake 选项控制，默认开启）
+ * 关闭时 TaggedAllocator 直接转发到 operator new/delete，类型不变，不产生额外代码
+ *
+ * 用法:
+ * @code
+ *
+ * TaggedVector<RenderObject, MemoryTag::Queue> objects_;
+ *
+ * MemoryTracker::get().setBudget(MemoryTag::Queue, {4 * 1024 * 1024, 16});
+ *
+ * // 每帧结束
+ * PRISMA_MEMORY_FRAME();
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifndef PRISMA_ENABLE_MEMORY_TRACKING
+    #if defined(NDEBUG)
+        #define PRISMA_ENABLE_MEMORY_TRACKING 0
+    #else
+        #define PRISMA_ENABLE_MEMORY_TRACKING 1
+    #endif
+#endif
+
+// ============================================================================
+// 标记
+// ============================================================================
+
+/**
+ * @brief 内存归属的子系统
+ */
+enum class MemoryTag : uint8_t {
+    Queue,       ///< 渲染队列
+    Culling,     ///< 剔除中间结果
+    Lighting,    ///< 光源列表、光照探针
+    Shadows,     ///< 阴影矩阵、图集分配
+    Features,    ///< Feature 列表及其临时资源
+    Pools,       ///< 资源池
+    Scene,       ///< 可渲染组件存储
+    Count
+};
+
+/**
+ * @brief 获取标记名称
+ */
+const char* GetMemoryTagName(MemoryTag tag);
+
+// ============================================================================
+// 统计与预算
+// ============================================================================
+
+/**
+ * @brief 单个标记的预算（0 表示不限制）
+ */
+struct MemoryBudget {
+    /** 当前占用上限（字节） */
+    uint64_t maxBytes = 0;
+
+    /** 每帧分配次数上限（稳定帧应为0，用于发现每帧抖动） */
+    uint32_t maxFrameAllocations = 0;
+};
+
+/**
+ * @brief 单个标记的统计快照
+ */
+struct MemoryTagStats {
+    uint64_t currentBytes = 0;
+    uint64_t peakBytes = 0;
+    uint64_t totalAllocations = 0;
+    uint64_t liveAllocations = 0;
+
+    /** 上一帧的分配次数和字节数 */
+    uint32_t frameAllocations = 0;
+    uint64_t frameBytes = 0;
+
+    /** 上一帧是否超出预算 */
+    bool overBudget = false;
+};
+
+/**
+ * @brief 预算警告
+ */
+struct MemoryBudgetWarning {
+    MemoryTag tag = MemoryTag::Count;
+    uint64_t frameNumber = 0;
+
+    /** 超出的是占用预算（否则为每帧分配次数预算） */
+    bool bytesExceeded = false;
+
+    uint64_t value = 0;
+    uint64_t budget = 0;
+};
+
+// ============================================================================
+// 跟踪器
+// ============================================================================
+
+/**
+ * @brief 全局内存跟踪器
+ *
+ * 警告是边沿触发的：某个标记从预算内变为超出时报告一次，回到预算内后才会再次报告
+ * 未设置回调时警告写到 stderr
+ */
+class MemoryTracker {
+public:
+    static constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+
+    using WarningCallback = std::function<void(const MemoryBudgetWarning&)>;
+
+    static MemoryTracker& get();
+
+    // ========================================================================
+    // 分配（由 TaggedAllocator 调用）
+    // ========================================================================
+
+    void onAllocate(MemoryTag tag, size_t bytes) noexcept {
+        Counters& c = counters_[static_cast<size_t>(tag)];
+        const uint64_t current = c.currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        c.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        c.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        c.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+        c.frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        uint64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+        while (current > peak
+               && !c.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+    }
+
+    void onFree(MemoryTag tag, size_t bytes) noexcept {
+        Counters& c = counters_[static_cast<size_t>(tag)];
+        c.currentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        c.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // ========================================================================
+    // 帧
+    // ========================================================================
+
+    /**
+     * @brief 帧结束：记录本帧分配、检查预算、开始新的一帧
+     */
+    void endFrame();
+
+    uint64_t getFrameNumber() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frameNumber_;
+    }
+
+    // ========================================================================
+    // 预算
+    // ========================================================================
+
+    void setBudget(MemoryTag tag, const MemoryBudget& budget);
+    MemoryBudget getBudget(MemoryTag tag) const;
+
+    void setWarningCallback(WarningCallback callback);
+
+    /** 累计发出的警告数 */
+    uint64_t getWarningCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return warningCount_;
+    }
+
+    // ========================================================================
+    // 查询
+    // ========================================================================
+
+    MemoryTagStats getStats(MemoryTag tag) const;
+
+    /** 所有标记的当前占用之和 */
+    uint64_t getTotalBytes() const;
+
+    /**
+     * @brief 清零峰值（当前占用不变）
+     */
+    void resetPeaks();
+
+    /**
+     * @brief 打印每个标记的统计表
+     */
+    void writeReport(FILE* out) const;
+
+private:
+    MemoryTracker() = default;
+
+    struct Counters {
+        std::atomic<uint64_t> currentBytes{0};
+        std::atomic<uint64_t> peakBytes{0};
+        std::atomic<uint64_t> totalAllocations{0};
+        std::atomic<uint64_t> liveAllocations{0};
+        std::atomic<uint32_t> frameAllocations{0};
+        std::atomic<uint64_t> frameBytes{0};
+    };
+
+    struct FrameRecord {
+        uint32_t allocations = 0;
+        uint64_t bytes = 0;
+        bool overBudget = false;
+    };
+
+    static void printWarning(const MemoryBudgetWarning& warning);
+
+    Counters counters_[TagCount];
+
+    // 以下只在帧结束和设置时访问
+    mutable std::mutex mutex_;
+    MemoryBudget budgets_[TagCount];
+    FrameRecord lastFrame_[TagCount];
+    WarningCallback warningCallback_;
+    uint64_t frameNumber_ = 0;
+    uint64_t warningCount_ = 0;
+};
+
+// ============================================================================
+// 分配器
+// ============================================================================
+
+/**
+ * @brief 标准库兼容的标记分配器（无状态）
+ */
+template<typename T, MemoryTag Tag>
+class TaggedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() noexcept = default;
+
+    template<typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        T* p;
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            p = static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+        } else {
+            p = static_cast<T*>(::operator new(bytes));
+        }
+#if PRISMA_ENABLE_MEMORY_TRACKING
+        MemoryTracker::get().onAllocate(Tag, bytes);
+#endif
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+#if PRISMA_ENABLE_MEMORY_TRACKING
+        MemoryTracker::get().onFree(Tag, n * sizeof(T));
+#endif
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const TaggedAllocator<U, Tag>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const TaggedAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+/**
+ * @brief 按标记计入内存的 vector
+ */
+template<typename T, MemoryTag Tag>
+using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+// ============================================================================
+// 宏
+// ============================================================================
+
+#if PRISMA_ENABLE_MEMORY_TRACKING
+
+/** 帧结束：汇总本帧分配并检查预算 */
+#define PRISMA_MEMORY_FRAME() MemoryTracker::get().endFrame()
+
+#else
+
+#define PRISMA_MEMORY_FRAME() ((void)0)
+
+#endif
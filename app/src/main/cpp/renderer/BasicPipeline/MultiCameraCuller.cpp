@@ -0,0 +1,132 @@
+/**
+ * @file MultiCameraCuller.cpp
+ * @brief 多相机共享剔除实现
+ */
+
+#include "MultiCameraCuller.h"
+#include "RenderableStorage.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/** |a - b| 相对于较大值的比例 */
+float relativeDifference(float a, float b) {
+    const float scale = std::max(std::fabs(a), std::fabs(b));
+    return scale > 0.0f ? std::fabs(a - b) / scale : 0.0f;
+}
+
+float aspectRatio(const CameraSnapshot& camera) {
+    return static_cast<float>(camera.width) / static_cast<float>(std::max(camera.height, 1u));
+}
+
+} // namespace
+
+void MultiCameraCuller::cull(const RenderableStorage& storage, const CameraSnapshot* const* cameras,
+                             uint32_t cameraCount) {
+    PRISMA_PROFILE_ZONE("MultiCameraCuller::cull");
+
+    cameraCount_ = std::min(cameraCount, MaxCameras);
+    for (uint32_t c = 0; c < cameraCount_; ++c) {
+        cameras_[c] = cameras[c];
+        viewStats_[c] = MultiCameraViewStats();
+    }
+
+    objects_.clear();
+    cameraMasks_.clear();
+    testedCount_ = 0;
+
+    const uint32_t count = static_cast<uint32_t>(storage.size());
+    const RenderableBounds* bounds = storage.getBounds();
+    const uint32_t* flags = storage.getFlags();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!(flags[i] & RenderableFlags::Visible)) {
+            continue;
+        }
+        ++testedCount_;
+
+        const Vector3& center = bounds[i].center;
+        const float radius = bounds[i].radius;
+
+        uint32_t mask = 0;
+        for (uint32_t c = 0; c < cameraCount_; ++c) {
+            mask |= static_cast<uint32_t>(cameras_[c]->frustumPlanes.intersectsSphere(center, radius)) << c;
+        }
+        if (mask == 0) {
+            continue;
+        }
+
+        // 冷数据只读一次；距离按相机在 buildQueues 中计算
+        objects_.push_back(storage.makeRenderObject(i, center));
+        cameraMasks_.push_back(mask);
+    }
+
+    for (uint32_t c = 0; c < cameraCount_; ++c) {
+        const uint32_t bit = 1u << c;
+        uint32_t visible = 0;
+        for (uint32_t mask : cameraMasks_) {
+            visible += (mask & bit) != 0;
+        }
+        viewStats_[c].visibleObjects = visible;
+    }
+
+    assignShadowSources();
+}
+
+void MultiCameraCuller::buildQueues(uint32_t camera, RenderQueueManager& queueManager) const {
+    if (camera >= cameraCount_) {
+        return;
+    }
+
+    const uint32_t bit = 1u << camera;
+    const Vector3 cameraPosition = cameras_[camera]->position;
+    const uint32_t count = static_cast<uint32_t>(objects_.size());
+
+    for (uint32_t k = 0; k < count; ++k) {
+        if (!(cameraMasks_[k] & bit)) {
+            continue;
+        }
+
+        RenderObject obj = objects_[k];
+        const Vector3 delta = obj.center - cameraPosition;
+        obj.distanceToCamera = std::sqrt(glm::dot(delta, delta));
+        queueManager.addObject(obj);
+    }
+}
+
+void MultiCameraCuller::assignShadowSources() {
+    const float maxDistance2 = settings_.shadowShareDistance * settings_.shadowShareDistance;
+    const float minCosAngle = std::cos(glm::radians(settings_.shadowShareAngle));
+
+    for (uint32_t c = 0; c < cameraCount_; ++c) {
+        viewStats_[c].shadowSource = c;
+        if (settings_.shadowShareDistance <= 0.0f) {
+            continue;
+        }
+
+        // 找到最早的、自己渲染阴影且足够接近的相机
+        for (uint32_t s = 0; s < c; ++s) {
+            if (viewStats_[s].shadowSource != s) {
+                continue;
+            }
+
+            const CameraSnapshot& a = *cameras_[c];
+            const CameraSnapshot& b = *cameras_[s];
+            const Vector3 delta = a.position - b.position;
+            const bool samePose = glm::dot(delta, delta) <= maxDistance2 &&
+                                  glm::dot(a.forward, b.forward) >= minCosAngle;
+            const bool sameProjection =
+                std::fabs(a.fieldOfView - b.fieldOfView) <= settings_.shadowShareFovTolerance &&
+                relativeDifference(a.nearPlane, b.nearPlane) <= settings_.shadowShareRangeTolerance &&
+                relativeDifference(a.farPlane, b.farPlane) <= settings_.shadowShareRangeTolerance &&
+                relativeDifference(aspectRatio(a), aspectRatio(b)) <= settings_.shadowShareRangeTolerance;
+            if (samePose && sameProjection) {
+                viewStats_[c].shadowSource = s;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file MultiCameraCuller.h
+ * @brief 多相机共享剔除 - 一次遍历场景，同时对所有相机做视锥剔除
+ *
+ * 分屏、画中画等多相机场景下，逐相机调用 RenderQueueBuilder::build 会把组件遍历、
+ * 包围球读取和冷数据（材质、几何体、世界矩阵）的读取重复 N 次
+ *
+ * MultiCameraCuller 把每帧工作拆成两部分:
+ * 1. cull(): 一次遍历组件存储，每个包围球对所有相机的 SoA 视锥平面测试，
+ *    得到相机可见性位掩码；至少对一个相机可见的对象只构建一次 RenderObject（共享缓存）
+ * 2. buildQueues(): 每个相机只从共享缓存中按位掩码挑出对象，
+ *    计算该相机的距离（排序键）并加入队列
+ *
+ * 每个相机的额外开销只剩排序键计算、入队、排序和命令录制。
+ * cull() 之后缓存只读，多个相机的 buildQueues() 可以并行执行
+ *
+ * 阴影共享:
+ * 位置、朝向和投影（视场角、近远平面、宽高比）足够接近的相机
+ * （例如立体渲染的两只眼、同一角色的画中画）复用同一组阴影贴图，见 getShadowSource()
+ */
+
+#pragma once
+
+#include "RenderQueue.h"
+#include "CameraSnapshot.h"
+#include "MemoryTracker.h"
+#include <cstdint>
+
+class RenderableStorage;
+
+/**
+ * @brief 多相机剔除配置
+ */
+struct MultiCameraSettings {
+    /** 相机位置距离不超过该值（米）时可以共享阴影贴图，为0时禁用共享 */
+    float shadowShareDistance = 1.0f;
+
+    /** 相机朝向夹角不超过该值（度）时可以共享阴影贴图 */
+    float shadowShareAngle = 10.0f;
+
+    /** 视场角之差不超过该值（度）时可以共享阴影贴图（级联按相机视锥拟合，视场角不同时覆盖范围不同） */
+    float shadowShareFovTolerance = 1.0f;
+
+    /** 近/远平面和宽高比的相对差不超过该值时可以共享阴影贴图（级联划分取决于近远平面） */
+    float shadowShareRangeTolerance = 0.05f;
+};
+
+/**
+ * @brief 单个相机的剔除统计
+ */
+struct MultiCameraViewStats {
+    uint32_t visibleObjects = 0;
+
+    /** 复用阴影贴图的来源相机（等于自身下标时表示自己渲染阴影） */
+    uint32_t shadowSource = 0;
+};
+
+/**
+ * @brief 多相机共享剔除
+ */
+class MultiCameraCuller {
+public:
+    /** 位掩码宽度决定的最大相机数 */
+    static constexpr uint32_t MaxCameras = 32;
+
+    void setSettings(const MultiCameraSettings& settings) { settings_ = settings; }
+    const MultiCameraSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 一次遍历组件存储，对所有相机剔除并构建共享缓存
+     *
+     * @param cameras 相机快照（按渲染顺序），超过 MaxCameras 的部分被忽略
+     *                快照在 buildQueues() 完成前必须保持有效
+     */
+    void cull(const RenderableStorage& storage, const CameraSnapshot* const* cameras, uint32_t cameraCount);
+
+    /**
+     * @brief 把对相机 camera 可见的对象加入队列（不清空、不排序）
+     *
+     * 只读共享缓存，不同相机可以在不同线程上同时调用
+     */
+    void buildQueues(uint32_t camera, RenderQueueManager& queueManager) const;
+
+    uint32_t getCameraCount() const { return cameraCount_; }
+
+    /** 至少对一个相机可见的对象数 */
+    uint32_t getUniqueVisibleCount() const { return static_cast<uint32_t>(objects_.size()); }
+
+    /** 参与剔除的对象数（带 Visible 标志） */
+    uint32_t getTestedCount() const { return testedCount_; }
+
+    const MultiCameraViewStats& getViewStats(uint32_t camera) const { return viewStats_[camera]; }
+
+    /**
+     * @brief 相机 camera 应复用哪个相机的阴影贴图
+     *
+     * 返回值不大于 camera；等于 camera 时该相机需要自己渲染阴影
+     */
+    uint32_t getShadowSource(uint32_t camera) const { return viewStats_[camera].shadowSource; }
+
+    /** 共享的每对象缓存（distanceToCamera 未填写） */
+    const TaggedVector<RenderObject, MemoryTag::Culling>& getObjects() const { return objects_; }
+
+    /** 与 getObjects() 一一对应的相机可见性位掩码 */
+    const TaggedVector<uint32_t, MemoryTag::Culling>& getCameraMasks() const { return cameraMasks_; }
+
+private:
+    void assignShadowSources();
+
+    MultiCameraSettings settings_;
+
+    const CameraSnapshot* cameras_[MaxCameras] = {};
+    uint32_t cameraCount_ = 0;
+    MultiCameraViewStats viewStats_[MaxCameras];
+    uint32_t testedCount_ = 0;
+
+    TaggedVector<RenderObject, MemoryTag::Culling> objects_;
+    TaggedVector<uint32_t, MemoryTag::Culling> cameraMasks_;
+};
@@ -0,0 +1,510 @@
+/**
+ * @file OverdrawAnalyzer.cpp
+ * @brief CPU overdraw 分析实现
+ */
+
+#include "OverdrawAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+#if defined(GLM_FORCE_DEPTH_ZERO_TO_ONE)
+constexpr bool DepthZeroToOne = true;
+#else
+constexpr bool DepthZeroToOne = false;
+#endif
+
+/** 到近平面的有符号距离（>= 0 在视锥内侧） */
+inline float nearDistance(const Vector4& v) {
+    return DepthZeroToOne ? v.z : v.z + v.w;
+}
+
+bool depthTest(DepthCompareFunc func, float fragment, float stored) {
+    switch (func) {
+        case DepthCompareFunc::Never:        return false;
+        case DepthCompareFunc::Less:         return fragment < stored;
+        case DepthCompareFunc::Equal:        return fragment == stored;
+        case DepthCompareFunc::LessEqual:    return fragment <= stored;
+        case DepthCompareFunc::Greater:      return fragment > stored;
+        case DepthCompareFunc::NotEqual:     return fragment != stored;
+        case DepthCompareFunc::GreaterEqual: return fragment >= stored;
+        case DepthCompareFunc::Always:
+        default:                             return true;
+    }
+}
+
+/** 边是否为左上边（屏幕空间y向下、三角形顺时针） */
+inline bool isTopLeft(const Vector2& a, const Vector2& b) {
+    const Vector2 edge = b - a;
+    return (edge.y == 0.0f && edge.x > 0.0f) || edge.y < 0.0f;
+}
+
+inline float edgeFunction(const Vector2& a, const Vector2& b, float px, float py) {
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+} // namespace
+
+// ============================================================================
+// OverdrawAnalyzer
+// ============================================================================
+
+OverdrawAnalyzer::OverdrawAnalyzer(const OverdrawConfig& config) {
+    buildSphere(sphere_);
+    buildBox(box_);
+    setConfig(config);
+}
+
+void OverdrawAnalyzer::setConfig(const OverdrawConfig& config) {
+    config_ = config;
+    config_.width = std::max(config_.width, 1u);
+    config_.height = std::max(config_.height, 1u);
+}
+
+const OverdrawResult& OverdrawAnalyzer::analyze(const RenderQueueManager& queues, const Matrix4& viewProjection) {
+    begin(viewProjection);
+    for (const auto& queue : queues.getQueues()) {
+        drawQueue(*queue);
+    }
+    return end();
+}
+
+void OverdrawAnalyzer::begin(const Matrix4& viewProjection) {
+    viewProjection_ = viewProjection;
+
+    const size_t pixels = static_cast<size_t>(config_.width) * config_.height;
+    depth_.assign(pixels, config_.clearDepth);
+    owner_.assign(pixels, 0);
+
+    result_.width = config_.width;
+    result_.height = config_.height;
+    result_.shadeCount.assign(pixels, 0);
+    result_.objects.clear();
+    result_.queues.clear();
+    objectQueues_.clear();
+    blendedFragments_ = 0;
+    currentQueue_ = ~0u;
+}
+
+void OverdrawAnalyzer::drawQueue(const RenderQueue& queue) {
+    OverdrawQueueStats stats;
+    stats.name = queue.getName();
+    stats.queueID = queue.getQueueID();
+    currentQueue_ = static_cast<uint32_t>(result_.queues.size());
+    result_.queues.push_back(stats);
+
+    for (const RenderObject& object : queue.getObjects()) {
+        drawObject(object);
+    }
+    currentQueue_ = ~0u;
+}
+
+void OverdrawAnalyzer::drawObject(const RenderObject& object) {
+    const uint32_t index = static_cast<uint32_t>(result_.objects.size());
+
+    OverdrawObjectStats stats;
+    stats.drawIndex = index;
+    stats.name = object.name;
+    stats.queueID = object.queueID;
+    stats.materialID = object.materialID;
+    stats.center = object.center;
+    stats.distanceToCamera = object.distanceToCamera;
+    stats.writesDepth = object.depthState.depthWriteEnable;
+    result_.objects.push_back(stats);
+    objectQueues_.push_back(currentQueue_);
+
+    const OverdrawMesh* mesh = config_.meshProvider ? config_.meshProvider(object) : nullptr;
+    Matrix4 world;
+    if (mesh) {
+        world = object.worldMatrix;
+    } else if (config_.proxy == OverdrawProxy::Box) {
+        mesh = &box_;
+        world = object.worldMatrix;
+    } else {
+        mesh = &sphere_;
+        world = glm::scale(glm::translate(Matrix4(1.0f), object.center), Vector3(object.radius));
+    }
+
+    drawMesh(*mesh, viewProjection_ * world, object.depthState, index);
+
+    const OverdrawObjectStats& drawn = result_.objects[index];
+    if (currentQueue_ != ~0u) {
+        OverdrawQueueStats& queue = result_.queues[currentQueue_];
+        queue.objects++;
+        queue.rasterized += drawn.rasterized;
+        queue.shaded += drawn.shaded;
+    }
+    if (!drawn.writesDepth) {
+        blendedFragments_ += drawn.shaded;
+    }
+}
+
+const OverdrawResult& OverdrawAnalyzer::end() {
+    // 最终可见像素
+    for (uint32_t owner : owner_) {
+        if (owner != 0) {
+            result_.objects[owner - 1].visible++;
+        }
+    }
+
+    result_.coveredPixels = 0;
+    result_.rasterizedFragments = 0;
+    result_.shadedFragments = 0;
+    result_.wastedFragments = 0;
+    result_.maxShadeCount = 0;
+    std::fill(std::begin(result_.histogram), std::end(result_.histogram), 0);
+
+    uint64_t opaquePixels = 0;
+    for (size_t i = 0; i < result_.shadeCount.size(); ++i) {
+        const uint32_t count = result_.shadeCount[i];
+        result_.coveredPixels += count > 0 ? 1 : 0;
+        opaquePixels += owner_[i] != 0 ? 1 : 0;
+        result_.maxShadeCount = std::max(result_.maxShadeCount, count);
+        result_.histogram[std::min(count, OverdrawResult::HistogramBuckets - 1)]++;
+    }
+
+    for (auto& object : result_.objects) {
+        object.wasted = object.writesDepth ? object.shaded - object.visible : 0;
+        result_.rasterizedFragments += object.rasterized;
+        result_.shadedFragments += object.shaded;
+        result_.wastedFragments += object.wasted;
+    }
+    result_.idealShadedFragments = opaquePixels + blendedFragments_;
+
+    for (size_t i = 0; i < result_.objects.size(); ++i) {
+        if (objectQueues_[i] != ~0u) {
+            result_.queues[objectQueues_[i]].wasted += result_.objects[i].wasted;
+        }
+    }
+    return result_;
+}
+
+// ============================================================================
+// 光栅化
+// ============================================================================
+
+void OverdrawAnalyzer::drawMesh(const OverdrawMesh& mesh, const Matrix4& worldViewProjection,
+                                const DepthState& depthState, uint32_t owner) {
+    const size_t triangleCount = mesh.indices.size() / 3;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        Vector4 v[3];
+        for (int k = 0; k < 3; ++k) {
+            v[k] = worldViewProjection * Vector4(mesh.positions[mesh.indices[t * 3 + k]], 1.0f);
+        }
+
+        // 整个三角形在某个侧平面外侧时直接跳过
+        if ((v[0].x > v[0].w && v[1].x > v[1].w && v[2].x > v[2].w)
+            || (v[0].x < -v[0].w && v[1].x < -v[1].w && v[2].x < -v[2].w)
+            || (v[0].y > v[0].w && v[1].y > v[1].w && v[2].y > v[2].w)
+            || (v[0].y < -v[0].w && v[1].y < -v[1].w && v[2].y < -v[2].w)
+            || (v[0].z > v[0].w && v[1].z > v[1].w && v[2].z > v[2].w)) {
+            continue;
+        }
+
+        const float d0 = nearDistance(v[0]);
+        const float d1 = nearDistance(v[1]);
+        const float d2 = nearDistance(v[2]);
+        if (d0 >= 0.0f && d1 >= 0.0f && d2 >= 0.0f) {
+            rasterizeClipped(v, 3, depthState, owner);
+            continue;
+        }
+        if (d0 < 0.0f && d1 < 0.0f && d2 < 0.0f) {
+            continue;
+        }
+
+        // 近平面裁剪（Sutherland-Hodgman，最多产生4个顶点）
+        Vector4 clipped[4];
+        uint32_t count = 0;
+        const float d[3] = {d0, d1, d2};
+        for (int k = 0; k < 3; ++k) {
+            const int next = (k + 1) % 3;
+            if (d[k] >= 0.0f) {
+                clipped[count++] = v[k];
+            }
+            if ((d[k] >= 0.0f) != (d[next] >= 0.0f)) {
+                const float t = d[k] / (d[k] - d[next]);
+                clipped[count++] = v[k] + (v[next] - v[k]) * t;
+            }
+        }
+        rasterizeClipped(clipped, count, depthState, owner);
+    }
+}
+
+void OverdrawAnalyzer::rasterizeClipped(const Vector4* v, uint32_t count,
+                                        const DepthState& depthState, uint32_t owner) {
+    const float width = static_cast<float>(config_.width);
+    const float height = static_cast<float>(config_.height);
+
+    Vector3 screen[4];
+    for (uint32_t i = 0; i < count; ++i) {
+        const float invW = 1.0f / v[i].w;
+        const float ndcZ = v[i].z * invW;
+        screen[i].x = (v[i].x * invW * 0.5f + 0.5f) * width;
+        screen[i].y = (0.5f - v[i].y * invW * 0.5f) * height;
+        screen[i].z = DepthZeroToOne ? ndcZ : ndcZ * 0.5f + 0.5f;
+    }
+
+    for (uint32_t i = 1; i + 1 < count; ++i) {
+        rasterizeTriangle(screen[0], screen[i], screen[i + 1], depthState, owner);
+    }
+}
+
+void OverdrawAnalyzer::rasterizeTriangle(const Vector3& a, const Vector3& b, const Vector3& c,
+                                         const DepthState& depthState, uint32_t owner) {
+    // 屏幕空间y向下，逆时针正面在这里为负面积
+    const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (area >= 0.0f) {
+        return;
+    }
+
+    // 交换为顺时针（正面积），便于统一边函数符号
+    const Vector2 p0(a.x, a.y);
+    const Vector2 p1(c.x, c.y);
+    const Vector2 p2(b.x, b.y);
+    const float z0 = a.z;
+    const float z1 = c.z;
+    const float z2 = b.z;
+    const float invArea = -1.0f / area;
+
+    const int minX = std::max(0, static_cast<int>(std::floor(std::min({p0.x, p1.x, p2.x}))));
+    const int maxX = std::min(static_cast<int>(config_.width) - 1,
+                              static_cast<int>(std::ceil(std::max({p0.x, p1.x, p2.x}))));
+    const int minY = std::max(0, static_cast<int>(std::floor(std::min({p0.y, p1.y, p2.y}))));
+    const int maxY = std::min(static_cast<int>(config_.height) - 1,
+                              static_cast<int>(std::ceil(std::max({p0.y, p1.y, p2.y}))));
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+
+    // 左上规则：相邻三角形共享边上的像素只属于其中一个
+    const bool topLeft0 = isTopLeft(p1, p2);
+    const bool topLeft1 = isTopLeft(p2, p0);
+    const bool topLeft2 = isTopLeft(p0, p1);
+
+    OverdrawObjectStats& stats = result_.objects[owner];
+    const bool testDepth = depthState.depthTestEnable;
+    const bool writeDepth = depthState.depthWriteEnable;
+    const DepthCompareFunc compare = depthState.depthCompareFunc;
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const size_t row = static_cast<size_t>(y) * config_.width;
+
+        for (int x = minX; x <= maxX; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+
+            const float w0 = edgeFunction(p1, p2, px, py);
+            const float w1 = edgeFunction(p2, p0, px, py);
+            const float w2 = edgeFunction(p0, p1, px, py);
+            if ((w0 < 0.0f || (w0 == 0.0f && !topLeft0))
+                || (w1 < 0.0f || (w1 == 0.0f && !topLeft1))
+                || (w2 < 0.0f || (w2 == 0.0f && !topLeft2))) {
+                continue;
+            }
+
+            stats.rasterized++;
+
+            // 屏幕空间线性插值 NDC 深度
+            const float z = (w0 * z0 + w1 * z1 + w2 * z2) * invArea;
+            const size_t pixel = row + static_cast<size_t>(x);
+            if (testDepth && !depthTest(compare, z, depth_[pixel])) {
+                continue;
+            }
+
+            stats.shaded++;
+            if (result_.shadeCount[pixel] < UINT16_MAX) {
+                result_.shadeCount[pixel]++;
+            }
+            if (writeDepth) {
+                depth_[pixel] = z;
+                owner_[pixel] = owner + 1;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// 代理几何体
+// ============================================================================
+
+void OverdrawAnalyzer::buildSphere(OverdrawMesh& mesh) {
+    constexpr uint32_t Stacks = 8;
+    constexpr uint32_t Slices = 12;
+    constexpr float Pi = 3.14159265358979f;
+
+    // 放大使多边形外切于球体，轮廓不小于真实包围球
+    const float scale = 1.0f / (std::cos(Pi / Stacks) * std::cos(Pi / Slices));
+
+    mesh.positions.clear();
+    mesh.indices.clear();
+    for (uint32_t i = 0; i <= Stacks; ++i) {
+        const float phi = Pi * static_cast<float>(i) / Stacks;
+        for (uint32_t j = 0; j < Slices; ++j) {
+            const float theta = 2.0f * Pi * static_cast<float>(j) / Slices;
+            mesh.positions.push_back(scale * Vector3(std::sin(phi) * std::cos(theta),
+                                                     std::cos(phi),
+                                                     std::sin(phi) * std::sin(theta)));
+        }
+    }
+
+    for (uint32_t i = 0; i < Stacks; ++i) {
+        for (uint32_t j = 0; j < Slices; ++j) {
+            const uint32_t a = i * Slices + j;
+            const uint32_t b = i * Slices + (j + 1) % Slices;
+            const uint32_t c = a + Slices;
+            const uint32_t d = b + Slices;
+            // 从外部看逆时针
+            if (i != 0) {
+                mesh.indices.insert(mesh.indices.end(), {a, b, c});
+            }
+            if (i + 1 != Stacks) {
+                mesh.indices.insert(mesh.indices.end(), {b, d, c});
+            }
+        }
+    }
+}
+
+void OverdrawAnalyzer::buildBox(OverdrawMesh& mesh) {
+    mesh.positions = {
+        {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1},
+        {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1},
+    };
+    mesh.indices = {
+        4, 5, 6, 4, 6, 7,   // +Z
+        1, 0, 3, 1, 3, 2,   // -Z
+        5, 1, 2, 5, 2, 6,   // +X
+        0, 4, 7, 0, 7, 3,   // -X
+        7, 6, 2, 7, 2, 3,   // +Y
+        0, 1, 5, 0, 5, 4,   // -Y
+    };
+}
+
+// ============================================================================
+// OverdrawResult
+// ============================================================================
+
+std::vector<uint32_t> OverdrawResult::getWorstObjects(uint32_t maxCount) const {
+    std::vector<uint32_t> order(objects.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+
+    const size_t count = std::min<size_t>(maxCount, order.size());
+    std::partial_sort(order.begin(), order.begin() + count, order.end(),
+                      [this](uint32_t a, uint32_t b) { return objects[a].wasted > objects[b].wasted; });
+    order.resize(count);
+    return order;
+}
+
+bool OverdrawResult::writeHeatmap(const std::string& path, uint32_t saturateAt) const {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+
+    struct Stop {
+        float value;
+        float r, g, b;
+    };
+    const Stop stops[] = {
+        {0.0f, 0, 0, 0},
+        {1.0f, 0, 0, 255},
+        {2.0f, 0, 255, 255},
+        {3.0f, 0, 255, 0},
+        {4.0f, 255, 255, 0},
+        {6.0f, 255, 0, 0},
+        {static_cast<float>(std::max(saturateAt, 7u)), 255, 255, 255},
+    };
+    constexpr size_t StopCount = sizeof(stops) / sizeof(stops[0]);
+
+    std::fprintf(f, "P6\n%u %u\n255\n", width, height);
+    std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const float value = std::min(static_cast<float>(shadeCount[static_cast<size_t>(y) * width + x]),
+                                         stops[StopCount - 1].value);
+            size_t s = 1;
+            while (s < StopCount - 1 && value > stops[s].value) {
+                ++s;
+            }
+            const Stop& lo = stops[s - 1];
+            const Stop& hi = stops[s];
+            const float t = std::clamp((value - lo.value) / (hi.value - lo.value), 0.0f, 1.0f);
+            row[x * 3 + 0] = static_cast<uint8_t>(lo.r + (hi.r - lo.r) * t);
+            row[x * 3 + 1] = static_cast<uint8_t>(lo.g + (hi.g - lo.g) * t);
+            row[x * 3 + 2] = static_cast<uint8_t>(lo.b + (hi.b - lo.b) * t);
+        }
+        std::fwrite(row.data(), 1, row.size(), f);
+    }
+
+    const bool ok = std::ferror(f) == 0;
+    std::fclose(f);
+    return ok;
+}
+
+bool OverdrawResult::writeObjectsCsv(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+
+    std::fprintf(f, "drawIndex,name,queueID,materialID,distance,writesDepth,rasterized,shaded,visible,wasted\n");
+    for (const auto& o : objects) {
+        std::fprintf(f, "%u,%s,%u,%llu,%.3f,%d,%u,%u,%u,%u\n",
+                     o.drawIndex, o.name ? o.name : "", o.queueID,
+                     static_cast<unsigned long long>(o.materialID), o.distanceToCamera,
+                     o.writesDepth ? 1 : 0, o.rasterized, o.shaded, o.visible, o.wasted);
+    }
+
+    const bool ok = std::ferror(f) == 0;
+    std::fclose(f);
+    return ok;
+}
+
+void OverdrawResult::writeReport(FILE* out, uint32_t worstCount) const {
+    const double pixels = static_cast<double>(width) * height;
+    std::fprintf(out, "overdraw %ux%u: 覆盖 %.1f%% 像素，平均 %.2f 次/像素，最大 %u 次\n",
+                 width, height, pixels > 0 ? 100.0 * static_cast<double>(coveredPixels) / pixels : 0.0,
+                 averageOverdraw(), maxShadeCount);
+    std::fprintf(out, "片段: 光栅化 %llu，着色 %llu，浪费 %llu（%.1f%%），理想 %llu（可节省 %.1f%%）\n",
+                 static_cast<unsigned long long>(rasterizedFragments),
+                 static_cast<unsigned long long>(shadedFragments),
+                 static_cast<unsigned long long>(wastedFragments),
+                 shadedFragments > 0 ? 100.0 * static_cast<double>(wastedFragments) / static_cast<double>(shadedFragments) : 0.0,
+                 static_cast<unsigned long long>(idealShadedFragments),
+                 shadedFragments > 0
+                     ? 100.0 * (1.0 - static_cast<double>(idealShadedFragments) / static_cast<double>(shadedFragments))
+                     : 0.0);
+
+    std::fprintf(out, "直方图:");
+    for (uint32_t i = 0; i < HistogramBuckets; ++i) {
+        if (histogram[i] > 0) {
+            std::fprintf(out, " %u%s:%llu", i, i + 1 == HistogramBuckets ? "+" : "",
+                         static_cast<unsigned long long>(histogram[i]));
+        }
+    }
+    std::fprintf(out, "\n\n%-12s %8s %12s %12s %12s\n", "queue", "objects", "rasterized", "shaded", "wasted");
+    for (const auto& q : queues) {
+        std::fprintf(out, "%-12s %8u %12llu %12llu %12llu\n", q.name, q.objects,
+                     static_cast<unsigned long long>(q.rasterized),
+                     static_cast<unsigned long long>(q.shaded),
+                     static_cast<unsigned long long>(q.wasted));
+    }
+
+    const auto worst = getWorstObjects(worstCount);
+    if (worst.empty() || objects[worst.front()].wasted == 0) {
+        return;
+    }
+    std::fprintf(out, "\n%-8s %-24s %8s %10s %8s %8s %8s\n",
+                 "draw", "name", "queue", "distance", "shaded", "visible", "wasted");
+    for (uint32_t index : worst) {
+        const auto& o = objects[index];
+        if (o.wasted == 0) {
+            break;
+        }
+        std::fprintf(out, "%-8u %-24s %8u %10.2f %8u %8u %8u\n", o.drawIndex, o.name ? o.name : "",
+                     o.queueID, o.distanceToCamera, o.shaded, o.visible, o.wasted);
+    }
+}
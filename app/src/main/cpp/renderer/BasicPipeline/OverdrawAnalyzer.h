@@ -0,0 +1,225 @@
+/**
+ * @file OverdrawAnalyzer.h
+ * @brief CPU overdraw 与着色开销分析 - 在低分辨率下软件光栅化可见队列
+ *
+ * 按实际提交顺序（队列ID升序、队列内已排序）光栅化每个 RenderObject，
+ * 使用对象自身的深度状态做深度测试，统计:
+ * - 每像素着色次数（通过深度测试的片段数，即 early-z 之后的着色开销）
+ * - 每个对象光栅化/着色/最终可见/浪费的片段数
+ *   浪费 = 着色后被后续对象覆盖的片段（只统计写深度的对象，透明混合不算浪费）
+ * - 理想情况（完美深度预通过）下的着色数，用于评估排序和预通过的收益
+ * - 热度图（PPM）与每对象 CSV
+ *
+ * 不依赖GPU，可在回放捕获时离线运行（BasicPipelineReplay --overdraw）
+ *
+ * 几何体:
+ * 捕获中不含网格数据，默认用代理几何体光栅化:
+ * - Sphere: 包围球（低细分球体）
+ * - Box:    模型空间 [-1, 1]^3 立方体经世界矩阵变换
+ * 设置 OverdrawConfig::meshProvider 后使用真实网格（模型空间三角形）
+ *
+ * 只模拟深度测试；模板测试、Alpha 测试的镂空和面剔除模式不模拟（代理几何体一律剔除背面）
+ */
+
+#pragma once
+
+#include "RenderQueue.h"
+#include "MemoryTracker.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 代理几何体类型
+ */
+enum class OverdrawProxy : uint32_t {
+    Sphere,
+    Box
+};
+
+/**
+ * @brief 模型空间三角形网格（逆时针为正面）
+ */
+struct OverdrawMesh {
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief 分析配置
+ */
+struct OverdrawConfig {
+    /** 光栅化分辨率（通常为屏幕分辨率的 1/4 ~ 1/8） */
+    uint32_t width = 320;
+    uint32_t height = 180;
+
+    OverdrawProxy proxy = OverdrawProxy::Sphere;
+
+    /** 深度缓冲清除值（反向Z时为0） */
+    float clearDepth = 1.0f;
+
+    /**
+     * 返回对象的真实网格（为 nullptr 时使用代理几何体）
+     * 返回的网格在分析期间必须保持有效
+     */
+    std::function<const OverdrawMesh*(const RenderObject&)> meshProvider;
+};
+
+/**
+ * @brief 单个对象的统计
+ */
+struct OverdrawObjectStats {
+    /** 提交顺序 */
+    uint32_t drawIndex = 0;
+
+    const char* name = "Unnamed";
+    uint32_t queueID = 0;
+    uint64_t materialID = 0;
+    Vector3 center = Vector3(0.0f);
+    float distanceToCamera = 0.0f;
+
+    /** 覆盖的片段数（深度测试前） */
+    uint32_t rasterized = 0;
+
+    /** 通过深度测试、需要着色的片段数 */
+    uint32_t shaded = 0;
+
+    /** 帧结束时仍可见的像素数（只统计写深度的对象） */
+    uint32_t visible = 0;
+
+    /** 着色后被覆盖的片段数 */
+    uint32_t wasted = 0;
+
+    bool writesDepth = true;
+};
+
+/**
+ * @brief 单个队列的汇总
+ */
+struct OverdrawQueueStats {
+    const char* name = "";
+    uint32_t queueID = 0;
+    uint32_t objects = 0;
+    uint64_t rasterized = 0;
+    uint64_t shaded = 0;
+    uint64_t wasted = 0;
+};
+
+/**
+ * @brief 一帧的分析结果
+ */
+struct OverdrawResult {
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /** 每像素着色次数（行主序，第0行在顶部） */
+    std::vector<uint16_t> shadeCount;
+
+    uint64_t coveredPixels = 0;
+    uint64_t rasterizedFragments = 0;
+    uint64_t shadedFragments = 0;
+    uint64_t wastedFragments = 0;
+
+    /** 完美深度预通过时的着色数（每个被覆盖像素对写深度对象只着色一次，加上透明片段） */
+    uint64_t idealShadedFragments = 0;
+
+    uint32_t maxShadeCount = 0;
+
+    /** 着色次数直方图，最后一项为 >= HistogramBuckets-1 */
+    static constexpr uint32_t HistogramBuckets = 16;
+    uint64_t histogram[HistogramBuckets] = {};
+
+    std::vector<OverdrawObjectStats> objects;
+    std::vector<OverdrawQueueStats> queues;
+
+    /** 平均每个被覆盖像素的着色次数 */
+    double averageOverdraw() const {
+        return coveredPixels > 0 ? static_cast<double>(shadedFragments) / static_cast<double>(coveredPixels) : 0.0;
+    }
+
+    /**
+     * @brief 按浪费片段数降序返回对象下标
+     */
+    std::vector<uint32_t> getWorstObjects(uint32_t maxCount) const;
+
+    /**
+     * @brief 写入热度图（PPM P6）
+     *
+     * 颜色: 0 黑 → 1 蓝 → 2 青 → 3 绿 → 4 黄 → 6 红 → saturateAt（至少为7）白
+     */
+    bool writeHeatmap(const std::string& path, uint32_t saturateAt = 8) const;
+
+    /**
+     * @brief 写入每对象统计（CSV，按提交顺序）
+     */
+    bool writeObjectsCsv(const std::string& path) const;
+
+    /**
+     * @brief 打印汇总和浪费最多的对象
+     */
+    void writeReport(FILE* out, uint32_t worstCount = 10) const;
+};
+
+/**
+ * @brief CPU overdraw 分析器
+ *
+ * 用法:
+ * @code
+ *
+ * OverdrawAnalyzer analyzer(config);
+ * const OverdrawResult& result = analyzer.analyze(queueManager, viewProjection);
+ * result.writeHeatmap("overdraw.ppm");
+ *
+ * @endcode
+ *
+ * 也可以手动控制提交顺序: begin → drawObject/drawQueue → end
+ */
+class OverdrawAnalyzer {
+public:
+    explicit OverdrawAnalyzer(const OverdrawConfig& config = OverdrawConfig());
+
+    void setConfig(const OverdrawConfig& config);
+    const OverdrawConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief 按提交顺序分析所有队列（队列需已排序）
+     */
+    const OverdrawResult& analyze(const RenderQueueManager& queues, const Matrix4& viewProjection);
+
+    void begin(const Matrix4& viewProjection);
+    void drawQueue(const RenderQueue& queue);
+    void drawObject(const RenderObject& object);
+    const OverdrawResult& end();
+
+    const OverdrawResult& getResult() const { return result_; }
+
+private:
+    void drawMesh(const OverdrawMesh& mesh, const Matrix4& worldViewProjection,
+                  const DepthState& depthState, uint32_t owner);
+    void rasterizeClipped(const Vector4* v, uint32_t count, const DepthState& depthState, uint32_t owner);
+    void rasterizeTriangle(const Vector3& a, const Vector3& b, const Vector3& c,
+                           const DepthState& depthState, uint32_t owner);
+
+    static void buildSphere(OverdrawMesh& mesh);
+    static void buildBox(OverdrawMesh& mesh);
+
+    OverdrawConfig config_;
+    OverdrawResult result_;
+    Matrix4 viewProjection_ = Matrix4(1.0f);
+
+    OverdrawMesh sphere_;
+    OverdrawMesh box_;
+
+    // 帧缓冲
+    TaggedVector<float, MemoryTag::Features> depth_;
+    TaggedVector<uint32_t, MemoryTag::Features> owner_;   // 最后一个写深度的对象（+1，0 表示无）
+
+    /** 不写深度的对象的着色片段数（理想情况下同样需要着色） */
+    uint64_t blendedFragments_ = 0;
+
+    /** 当前 drawQueue 对应的 result_.queues 下标，以及每个对象所属的队列下标 */
+    uint32_t currentQueue_ = ~0u;
+    TaggedVector<uint32_t, MemoryTag::Features> objectQueues_;
+};
@@ -0,0 +1,296 @@
+/**
+ * @file Profiler.cpp
+ * @brief CPU帧分析器实现
+ */
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+uint64_t steadyNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void writeJsonString(FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; s && *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+
+} // namespace
+
+// ============================================================================
+// 初始化与校准
+// ============================================================================
+
+FrameProfiler& FrameProfiler::get() {
+    static FrameProfiler instance;
+    return instance;
+}
+
+FrameProfiler::FrameProfiler() {
+    calibrationTick_ = profilerTimestamp();
+    calibrationNs_ = steadyNowNs();
+    originTick_ = calibrationTick_;
+    lastFrameTick_ = calibrationTick_;
+
+#if defined(PRISMA_PROFILER_CNTVCT)
+    // 通用计时器频率由寄存器直接给出
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    nsPerTick_ = frequency > 0 ? 1.0e9 / static_cast<double>(frequency) : 1.0;
+#elif defined(PRISMA_PROFILER_RDTSC)
+    // 短暂忙等得到初始比例，之后每帧用更长的区间修正
+    const uint64_t startNs = steadyNowNs();
+    while (steadyNowNs() - startNs < 2000000) {
+    }
+    calibrate();
+#else
+    nsPerTick_ = 1.0;
+#endif
+}
+
+void FrameProfiler::calibrate() {
+#if defined(PRISMA_PROFILER_RDTSC)
+    const uint64_t ticks = profilerTimestamp() - calibrationTick_;
+    const uint64_t ns = steadyNowNs() - calibrationNs_;
+    if (ticks > 0 && ns > 0) {
+        nsPerTick_ = static_cast<double>(ns) / static_cast<double>(ticks);
+    }
+#endif
+}
+
+ProfileThreadBuffer* FrameProfiler::registerThread() {
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    threads_.push_back(std::make_unique<ProfileThreadBuffer>(static_cast<uint32_t>(threads_.size())));
+    tlsBuffer_ = threads_.back().get();
+    return tlsBuffer_;
+}
+
+ProfileThreadBuffer* FrameProfiler::createTrack(const char* name) {
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    threads_.push_back(std::make_unique<ProfileThreadBuffer>(static_cast<uint32_t>(threads_.size())));
+    threads_.back()->setName(name);
+    return threads_.back().get();
+}
+
+const char* FrameProfiler::internName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    return internedNames_.insert(name).first->c_str();
+}
+
+void FrameProfiler::setThreadName(const char* name) {
+    ProfileThreadBuffer* buffer = tlsBuffer_ ? tlsBuffer_ : registerThread();
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    buffer->setName(name);
+}
+
+// ============================================================================
+// 帧汇总
+// ============================================================================
+
+void FrameProfiler::accumulate(const char* name, uint64_t ticks) {
+    // 同一区段通常连续出现（循环内），缓存上次查找结果
+    if (name != lastZoneName_) {
+        lastZone_ = &zones_[name];
+        lastZoneName_ = name;
+    }
+
+    ZoneAccumulator& acc = *lastZone_;
+    if (!acc.name) {
+        acc.name = name;
+        acc.window.reserve(StatsWindow);
+    }
+
+    ++acc.totalCalls;
+    ++acc.frameCalls;
+    acc.frameTicks += ticks;
+
+    if (acc.window.size() < StatsWindow) {
+        acc.window.push_back(ticks);
+    } else {
+        acc.window[acc.windowNext] = ticks;
+        acc.windowNext = (acc.windowNext + 1) % StatsWindow;
+    }
+}
+
+void FrameProfiler::endFrame() {
+    const uint64_t frameEnd = profilerTimestamp();
+    const bool capturing = captureFramesLeft_ > 0;
+
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex_);
+        for (auto& thread : threads_) {
+            const uint32_t threadIndex = thread->getThreadIndex();
+            thread->drain([&](const ProfileEvent& e) {
+                accumulate(e.name, e.end - e.begin);
+                if (capturing) {
+                    captured_.push_back({e.name, threadIndex, e.begin, e.end});
+                }
+            });
+        }
+    }
+
+    // 帧本身作为一个区段
+    accumulate(FrameZoneName, frameEnd - lastFrameTick_);
+    if (capturing) {
+        const uint32_t threadIndex = tlsBuffer_ ? tlsBuffer_->getThreadIndex() : 0;
+        captured_.push_back({FrameZoneName, threadIndex, lastFrameTick_, frameEnd});
+        --captureFramesLeft_;
+    }
+    lastFrameTick_ = frameEnd;
+
+    for (auto& [name, acc] : zones_) {
+        acc.lastFrameCalls = acc.frameCalls;
+        acc.lastFrameTicks = acc.frameTicks;
+        acc.frameCalls = 0;
+        acc.frameTicks = 0;
+    }
+
+    ++frameCount_;
+    calibrate();
+}
+
+// ============================================================================
+// 统计
+// ============================================================================
+
+ProfileZoneStats FrameProfiler::makeStats(const ZoneAccumulator& acc) const {
+    ProfileZoneStats stats;
+    stats.name = acc.name;
+    stats.totalCalls = acc.totalCalls;
+    stats.lastFrameCalls = acc.lastFrameCalls;
+    stats.lastFrameNs = ticksToNs(acc.lastFrameTicks);
+
+    if (acc.window.empty()) {
+        return stats;
+    }
+
+    std::vector<uint64_t> sorted = acc.window;
+    std::sort(sorted.begin(), sorted.end());
+
+    uint64_t sum = 0;
+    for (uint64_t v : sorted) sum += v;
+
+    const size_t p99Index = std::min(sorted.size() - 1,
+                                     static_cast<size_t>(static_cast<double>(sorted.size()) * 0.99));
+    stats.minNs = ticksToNs(sorted.front());
+    stats.avgNs = ticksToNs(sum) / static_cast<double>(sorted.size());
+    stats.p99Ns = ticksToNs(sorted[p99Index]);
+    return stats;
+}
+
+std::vector<ProfileZoneStats> FrameProfiler::getZoneStats() const {
+    std::vector<ProfileZoneStats> result;
+    result.reserve(zones_.size());
+    for (const auto& [name, acc] : zones_) {
+        result.push_back(makeStats(acc));
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ProfileZoneStats& a, const ProfileZoneStats& b) {
+                  return std::strcmp(a.name, b.name) < 0;
+              });
+    return result;
+}
+
+bool FrameProfiler::getZoneStats(const char* name, ProfileZoneStats& out) const {
+    // 同名字符串可能位于不同地址，按内容匹配并合并窗口
+    ZoneAccumulator merged;
+    bool found = false;
+
+    for (const auto& [key, acc] : zones_) {
+        if (std::strcmp(key, name) != 0) continue;
+        found = true;
+        merged.name = acc.name;
+        merged.totalCalls += acc.totalCalls;
+        merged.lastFrameCalls += acc.lastFrameCalls;
+        merged.lastFrameTicks += acc.lastFrameTicks;
+        merged.window.insert(merged.window.end(), acc.window.begin(), acc.window.end());
+    }
+
+    if (found) {
+        out = makeStats(merged);
+    }
+    return found;
+}
+
+uint64_t FrameProfiler::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    uint64_t dropped = 0;
+    for (const auto& thread : threads_) {
+        dropped += thread->getDroppedCount();
+    }
+    return dropped;
+}
+
+void FrameProfiler::resetStats() {
+    zones_.clear();
+    lastZoneName_ = nullptr;
+    lastZone_ = nullptr;
+    frameCount_ = 0;
+}
+
+// ============================================================================
+// Chrome Trace
+// ============================================================================
+
+void FrameProfiler::beginCapture(uint32_t frameCount) {
+    captured_.clear();
+    captureFramesLeft_ = frameCount;
+}
+
+bool FrameProfiler::writeChromeTrace(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+
+    std::fprintf(f, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex_);
+        for (const auto& thread : threads_) {
+            if (thread->getName().empty()) continue;
+            std::fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": ",
+                         first ? "" : ",\n", thread->getThreadIndex());
+            writeJsonString(f, thread->getName().c_str());
+            std::fprintf(f, "}}");
+            first = false;
+        }
+    }
+
+    for (const auto& e : captured_) {
+        // Chrome Trace 使用微秒
+        const double ts = ticksToNs(e.begin - originTick_) * 1.0e-3;
+        const double dur = ticksToNs(e.end - e.begin) * 1.0e-3;
+
+        std::fprintf(f, "%s{\"name\": ", first ? "" : ",\n");
+        writeJsonString(f, e.name);
+        if (e.name == FrameZoneName) {
+            // 帧标记同时输出一个全局瞬时事件，便于在时间线上分隔帧
+            std::fprintf(f, ", \"ph\": \"i\", \"s\": \"g\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f},\n{\"name\": ",
+                         e.threadIndex, ts + dur);
+            writeJsonString(f, e.name);
+            std::fprintf(f, ", \"cat\": \"frame\"");
+        } else {
+            std::fprintf(f, ", \"cat\": \"cpu\"");
+        }
+        std::fprintf(f, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+                     e.threadIndex, ts, dur);
+        first = false;
+    }
+
+    std::fprintf(f, "\n]}\n");
+    std::fclose(f);
+    return true;
+}
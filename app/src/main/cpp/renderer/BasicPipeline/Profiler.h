@@ -0,0 +1,384 @@
+/**
+ * @file Profiler.h
+ * @brief CPU帧分析器 - 作用域计时区段、帧标记、Chrome Trace 导出
+ *
+ * 设计:
+ * - 每个线程一个无锁单生产者/单消费者环形缓冲区，记录区段时不加锁
+ * - 时间戳直接读取硬件计数器（x86: rdtsc, ARM64: cntvct_el0）
+ * - 帧结束时（PRISMA_PROFILE_FRAME）由主线程汇总所有缓冲区
+ * - 滚动窗口统计每个区段的 min / avg / p99
+ * - 可捕获若干帧并导出为 Chrome Trace JSON（chrome://tracing 或 Perfetto 打开）
+ *
+ * 未定义 PRISMA_ENABLE_PROFILER 时所有宏展开为空，不产生任何代码
+ *
+ * 用法:
+ * @code
+ *
+ * void OpaquePass::record(VkCommandBuffer cmd) {
+ *     PRISMA_PROFILE_ZONE("OpaquePass::record");
+ *     ...
+ * }
+ *
+ * // 每帧结束
+ * PRISMA_PROFILE_FRAME();
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define PRISMA_PROFILER_RDTSC 1
+#elif defined(__aarch64__)
+    #define PRISMA_PROFILER_CNTVCT 1
+#else
+    #include <chrono>
+#endif
+
+// ============================================================================
+// 时间戳
+// ============================================================================
+
+/**
+ * @brief 读取硬件时间戳（单位: tick）
+ *
+ * 使用 FrameProfiler::ticksToNs 转换为纳秒
+ */
+inline uint64_t profilerTimestamp() {
+#if defined(PRISMA_PROFILER_RDTSC)
+    return __rdtsc();
+#elif defined(PRISMA_PROFILER_CNTVCT)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// ============================================================================
+// 事件与线程缓冲区
+// ============================================================================
+
+/**
+ * @brief 一次区段记录
+ *
+ * name 必须指向静态存储（字符串字面量、__func__ 或生命周期覆盖整个分析过程的字符串）
+ */
+struct ProfileEvent {
+    const char* name = nullptr;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+};
+
+/**
+ * @brief 每线程环形缓冲区（SPSC）
+ *
+ * 生产者: 所属线程（区段结束时写入）
+ * 消费者: 调用 FrameProfiler::endFrame 的线程
+ */
+class ProfileThreadBuffer {
+public:
+    static constexpr uint32_t Capacity = 1u << 15;
+    static constexpr uint32_t Mask = Capacity - 1;
+
+    explicit ProfileThreadBuffer(uint32_t threadIndex)
+        : events_(Capacity), threadIndex_(threadIndex) {}
+
+    /**
+     * @brief 写入一个事件（仅所属线程调用）
+     * 缓冲区满时丢弃并计数
+     */
+    void push(const char* name, uint64_t begin, uint64_t end) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= Capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ProfileEvent& e = events_[head & Mask];
+        e.name = name;
+        e.begin = begin;
+        e.end = end;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 取出所有已写入的事件（仅消费者调用）
+     */
+    template<typename Fn>
+    void drain(Fn&& fn) {
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            fn(events_[tail & Mask]);
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    uint32_t getThreadIndex() const { return threadIndex_; }
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    void setName(const char* name) { name_ = name ? name : ""; }
+    const std::string& getName() const { return name_; }
+
+private:
+    std::vector<ProfileEvent> events_;
+
+    // 读写端分开缓存行，避免伪共享
+    alignas(64) std::atomic<uint32_t> head_{0};
+    alignas(64) std::atomic<uint32_t> tail_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    uint32_t threadIndex_;
+    std::string name_;
+};
+
+// ============================================================================
+// 分析器
+// ============================================================================
+
+/**
+ * @brief 区段统计（滚动窗口）
+ */
+struct ProfileZoneStats {
+    const char* name = nullptr;
+
+    /** 累计调用次数 */
+    uint64_t totalCalls = 0;
+
+    /** 最近一帧内的调用次数与总耗时 */
+    uint32_t lastFrameCalls = 0;
+    double lastFrameNs = 0.0;
+
+    /** 滚动窗口内单次调用耗时 */
+    double minNs = 0.0;
+    double avgNs = 0.0;
+    double p99Ns = 0.0;
+};
+
+/**
+ * @brief CPU帧分析器（全局单例）
+ */
+class FrameProfiler {
+public:
+    /** 每个区段保留的最近采样数 */
+    static constexpr uint32_t StatsWindow = 256;
+
+    /** 帧区段名称（两次 PRISMA_PROFILE_FRAME 之间的耗时） */
+    static constexpr const char* FrameZoneName = "Frame";
+
+    static FrameProfiler& get();
+
+    /**
+     * @brief 记录一个区段（区段结束时调用）
+     */
+    static void recordZone(const char* name, uint64_t begin, uint64_t end) {
+        ProfileThreadBuffer* buffer = tlsBuffer_;
+        if (!buffer) {
+            buffer = get().registerThread();
+        }
+        buffer->push(name, begin, end);
+    }
+
+    /**
+     * @brief 设置当前线程名称（显示在 Chrome Trace 中）
+     */
+    void setThreadName(const char* name);
+
+    /**
+     * @brief 创建一条不绑定线程的时间线（例如 GPU 时间线）
+     *
+     * 返回的缓冲区由调用者所在的单个线程写入，时间戳使用 CPU tick
+     */
+    ProfileThreadBuffer* createTrack(const char* name);
+
+    /**
+     * @brief 把动态生成的名称转为生命周期与分析器相同的字符串
+     */
+    const char* internName(const std::string& name);
+
+    /**
+     * @brief 帧标记：汇总所有线程缓冲区，更新统计
+     */
+    void endFrame();
+
+    // ========================================================================
+    // 统计
+    // ========================================================================
+
+    /**
+     * @brief 获取所有区段的统计
+     */
+    std::vector<ProfileZoneStats> getZoneStats() const;
+
+    /**
+     * @brief 按名称获取区段统计
+     * @return false 如果该区段从未记录
+     */
+    bool getZoneStats(const char* name, ProfileZoneStats& out) const;
+
+    /** 已完成的帧数 */
+    uint64_t getFrameCount() const { return frameCount_; }
+
+    /** 所有线程因缓冲区满而丢弃的事件数 */
+    uint64_t getDroppedCount() const;
+
+    /**
+     * @brief 清空统计（不影响捕获）
+     */
+    void resetStats();
+
+    // ========================================================================
+    // Chrome Trace 捕获
+    // ========================================================================
+
+    /**
+     * @brief 开始捕获接下来的若干帧
+     * @param frameCount 捕获帧数
+     */
+    void beginCapture(uint32_t frameCount);
+
+    /** 是否正在捕获 */
+    bool isCapturing() const { return captureFramesLeft_ > 0; }
+
+    /**
+     * @brief 把已捕获的事件写为 Chrome Trace JSON
+     * @return true 如果写入成功
+     */
+    bool writeChromeTrace(const std::string& path) const;
+
+    /** 已捕获的事件数 */
+    size_t getCapturedEventCount() const { return captured_.size(); }
+
+    // ========================================================================
+    // 时间转换
+    // ========================================================================
+
+    /**
+     * @brief 把 tick 差值转换为纳秒
+     */
+    double ticksToNs(uint64_t ticks) const { return static_cast<double>(ticks) * nsPerTick_; }
+
+    /**
+     * @brief 把纳秒转换为 tick 差值
+     */
+    uint64_t nsToTicks(double ns) const { return static_cast<uint64_t>(ns / nsPerTick_); }
+
+private:
+    FrameProfiler();
+
+    ProfileThreadBuffer* registerThread();
+    void calibrate();
+
+    struct ZoneAccumulator {
+        const char* name = nullptr;
+        uint64_t totalCalls = 0;
+        uint32_t frameCalls = 0;
+        uint64_t frameTicks = 0;
+        uint32_t lastFrameCalls = 0;
+        uint64_t lastFrameTicks = 0;
+
+        /** 最近 StatsWindow 次调用的耗时（tick） */
+        std::vector<uint64_t> window;
+        uint32_t windowNext = 0;
+    };
+
+    struct CapturedEvent {
+        const char* name;
+        uint32_t threadIndex;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    void accumulate(const char* name, uint64_t ticks);
+    ProfileZoneStats makeStats(const ZoneAccumulator& acc) const;
+
+    inline static thread_local ProfileThreadBuffer* tlsBuffer_ = nullptr;
+
+    // 线程缓冲区（注册后不释放，保证生产者指针始终有效）
+    mutable std::mutex threadsMutex_;
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> threads_;
+    std::unordered_set<std::string> internedNames_;
+
+    // 统计（仅在 endFrame 所在线程访问）
+    std::unordered_map<const char*, ZoneAccumulator> zones_;
+    const char* lastZoneName_ = nullptr;
+    ZoneAccumulator* lastZone_ = nullptr;
+    uint64_t frameCount_ = 0;
+    uint64_t lastFrameTick_ = 0;
+
+    // 捕获
+    uint32_t captureFramesLeft_ = 0;
+    std::vector<CapturedEvent> captured_;
+
+    // 时钟校准
+    uint64_t calibrationTick_ = 0;
+    uint64_t calibrationNs_ = 0;
+    uint64_t originTick_ = 0;
+    double nsPerTick_ = 1.0;
+};
+
+/**
+ * @brief 作用域区段（构造时开始，析构时记录）
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name_(name), begin_(profilerTimestamp()) {}
+
+    ~ProfileScope() {
+        FrameProfiler::recordZone(name_, begin_, profilerTimestamp());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t begin_;
+};
+
+// ============================================================================
+// 宏
+// ============================================================================
+
+#define PRISMA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PRISMA_PROFILE_CONCAT(a, b) PRISMA_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(PRISMA_ENABLE_PROFILER) && PRISMA_ENABLE_PROFILER
+
+/** 当前作用域计时，name 需为静态字符串 */
+#define PRISMA_PROFILE_ZONE(name) \
+    ProfileScope PRISMA_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+/** 以当前函数名计时 */
+#define PRISMA_PROFILE_FUNCTION() PRISMA_PROFILE_ZONE(__func__)
+
+/** 帧结束标记 */
+#define PRISMA_PROFILE_FRAME() FrameProfiler::get().endFrame()
+
+/** 设置当前线程名称 */
+#define PRISMA_PROFILE_THREAD(name) FrameProfiler::get().setThreadName(name)
+
+#else
+
+#define PRISMA_PROFILE_ZONE(name) ((void)0)
+#define PRISMA_PROFILE_FUNCTION() ((void)0)
+#define PRISMA_PROFILE_FRAME() ((void)0)
+#define PRISMA_PROFILE_THREAD(name) ((void)0)
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file PrtLighting.cpp
+ * @brief 预计算辐射传输运行时实现
+ */
+
+#include "PrtLighting.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRISMA_PRT_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PRISMA_PRT_NEON 1
+#endif
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+// ============================================================================
+// 4宽 SIMD 封装
+// ============================================================================
+
+#if defined(PRISMA_PRT_SSE2)
+
+#define PRISMA_PRT_SIMD 1
+
+using F4 = __m128;
+
+inline F4 load4(const float* p) { return _mm_loadu_ps(p); }
+inline void store4(float* p, F4 v) { _mm_storeu_ps(p, v); }
+inline F4 splat(float v) { return _mm_set1_ps(v); }
+inline F4 zero4() { return _mm_setzero_ps(); }
+inline F4 madd(F4 a, F4 b, F4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+#elif defined(PRISMA_PRT_NEON)
+
+#define PRISMA_PRT_SIMD 1
+
+using F4 = float32x4_t;
+
+inline F4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, F4 v) { vst1q_f32(p, v); }
+inline F4 splat(float v) { return vdupq_n_f32(v); }
+inline F4 zero4() { return vdupq_n_f32(0.0f); }
+inline F4 madd(F4 a, F4 b, F4 c) { return vmlaq_f32(c, a, b); }
+
+#endif
+
+/** 块内偏移 */
+inline size_t probeOffset(uint32_t channel, uint32_t row, uint32_t column, uint32_t lane) {
+    return ((static_cast<size_t>(channel) * kPrtCoefficients + row) * kPrtCoefficients + column) * kPrtBlockSize + lane;
+}
+
+inline size_t vertexOffset(uint32_t channel, uint32_t coefficient, uint32_t lane) {
+    return (static_cast<size_t>(channel) * kPrtCoefficients + coefficient) * kPrtBlockSize + lane;
+}
+
+} // namespace
+
+// ============================================================================
+// 光照投影
+// ============================================================================
+
+void PrtLightingSH::assign(const SH9RGB& sh) {
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+            coefficients[c][j] = sh.c[j][c];
+        }
+    }
+}
+
+SH9RGB PrtLightingSH::toSH() const {
+    SH9RGB sh;
+    for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+        sh.c[j] = Vector3(coefficients[0][j], coefficients[1][j], coefficients[2][j]);
+    }
+    return sh;
+}
+
+void PrtLightingSH::addDirectional(const Vector3& direction, const Vector3& irradiance) {
+    SH9RGB sh = toSH();
+    AddSHDirectional(sh, direction, irradiance * kPi);
+    assign(sh);
+}
+
+void PrtLightingSH::addUniform(const Vector3& radiance) {
+    SH9RGB sh = toSH();
+    AddSHUniform(sh, radiance);
+    assign(sh);
+}
+
+void PrtLightingSH::clear() {
+    *this = PrtLightingSH();
+}
+
+void ProjectLightingToPrt(const LightingData& lighting, const PrtProjectionSettings& settings, PrtLightingSH& out) {
+    SH9RGB sh;
+    auto skipped = [&](const LightData& light) {
+        return settings.skipBakedLights && light.lightMode == LightMode::Baked;
+    };
+
+    if (settings.includeSky) {
+        AddSHUniform(sh, lighting.ambientColor * lighting.ambientIntensity);
+    }
+
+    if (settings.includeDirectional) {
+        for (const LightData& light : lighting.directionalLights) {
+            if (!skipped(light)) {
+                AddSHDirectional(sh, -light.direction, light.color * (kPi * light.intensity));
+            }
+        }
+    }
+
+    if (settings.includeLocal) {
+        // 局部光源: 在参考点处近似为定向光，衰减与锥形与 calculateLightingAtPoint 一致
+        auto addLocal = [&](const LightData& light, float cone) {
+            const Vector3 toLight = light.position - settings.referencePoint;
+            const float distance = glm::length(toLight);
+            if (distance <= 0.0001f || distance >= light.range) {
+                return;
+            }
+            AddSHDirectional(sh, toLight / distance,
+                             light.color * (kPi * light.intensity * cone * light.calculateAttenuation(distance)));
+        };
+        for (const LightData& light : lighting.pointLights) {
+            if (!skipped(light)) {
+                addLocal(light, 1.0f);
+            }
+        }
+        for (const LightData& light : lighting.spotLights) {
+            if (skipped(light)) {
+                continue;
+            }
+            const Vector3 toPoint = glm::normalize(settings.referencePoint - light.position);
+            const float cosAngle = glm::dot(toPoint, light.direction);
+            const float cosOuter = std::cos(glm::radians(light.outerAngle));
+            const float cosInner = std::cos(glm::radians(light.innerAngle));
+            const float cone = std::clamp((cosAngle - cosOuter) / std::max(cosInner - cosOuter, 0.0001f), 0.0f, 1.0f);
+            if (cone > 0.0f) {
+                addLocal(light, cone);
+            }
+        }
+    }
+
+    if (settings.applyWindow) {
+        ApplySHWindow(sh, SHWindow::Hann);
+    }
+    out.assign(sh);
+}
+
+// ============================================================================
+// 传输数据
+// ============================================================================
+
+void PrtProbeTransfer::resize(uint32_t probeCount) {
+    probeCount_ = probeCount;
+    data_.assign(static_cast<size_t>(getBlockCount()) * BlockFloats, 0.0f);
+}
+
+void PrtProbeTransfer::setProbe(uint32_t probe, const float matrix[3][kPrtCoefficients][kPrtCoefficients]) {
+    float* block = data_.data() + static_cast<size_t>(probe / kPrtBlockSize) * BlockFloats;
+    const uint32_t lane = probe % kPrtBlockSize;
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t i = 0; i < kPrtCoefficients; ++i) {
+            for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                block[probeOffset(c, i, j, lane)] = matrix[c][i][j];
+            }
+        }
+    }
+}
+
+float PrtProbeTransfer::get(uint32_t probe, uint32_t channel, uint32_t row, uint32_t column) const {
+    return getBlock(probe / kPrtBlockSize)[probeOffset(channel, row, column, probe % kPrtBlockSize)];
+}
+
+void PrtVertexTransfer::resize(uint32_t vertexCount) {
+    vertexCount_ = vertexCount;
+    data_.assign(static_cast<size_t>(getBlockCount()) * BlockFloats, 0.0f);
+}
+
+void PrtVertexTransfer::setVertex(uint32_t vertex, const float vector[3][kPrtCoefficients]) {
+    float* block = data_.data() + static_cast<size_t>(vertex / kPrtBlockSize) * BlockFloats;
+    const uint32_t lane = vertex % kPrtBlockSize;
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+            block[vertexOffset(c, j, lane)] = vector[c][j];
+        }
+    }
+}
+
+float PrtVertexTransfer::get(uint32_t vertex, uint32_t channel, uint32_t coefficient) const {
+    return getBlock(vertex / kPrtBlockSize)[vertexOffset(channel, coefficient, vertex % kPrtBlockSize)];
+}
+
+// ============================================================================
+// 重新计算光照
+// ============================================================================
+
+void RelightPrtProbes(const PrtProbeTransfer& transfer, const PrtLightingSH& lighting,
+                      LightingData::LightProbe* probes) {
+    PRISMA_PROFILE_ZONE("RelightPrtProbes");
+
+    const uint32_t probeCount = transfer.getProbeCount();
+    const uint32_t blockCount = transfer.getBlockCount();
+    alignas(16) float result[3][kPrtCoefficients][kPrtBlockSize];
+
+    for (uint32_t b = 0; b < blockCount; ++b) {
+        const float* block = transfer.getBlock(b);
+
+        for (uint32_t c = 0; c < 3; ++c) {
+            const float* light = lighting.coefficients[c];
+            for (uint32_t i = 0; i < kPrtCoefficients; ++i) {
+                const float* row = block + probeOffset(c, i, 0, 0);
+#ifdef PRISMA_PRT_SIMD
+                F4 sum = zero4();
+                for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                    sum = madd(load4(row + j * kPrtBlockSize), splat(light[j]), sum);
+                }
+                store4(result[c][i], sum);
+#else
+                for (uint32_t lane = 0; lane < kPrtBlockSize; ++lane) {
+                    float sum = 0.0f;
+                    for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                        sum += row[j * kPrtBlockSize + lane] * light[j];
+                    }
+                    result[c][i][lane] = sum;
+                }
+#endif
+            }
+        }
+
+        const uint32_t lanes = std::min(kPrtBlockSize, probeCount - b * kPrtBlockSize);
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            Vector3* sh = probes[b * kPrtBlockSize + lane].sphericalHarmonics;
+            for (uint32_t i = 0; i < kPrtCoefficients; ++i) {
+                sh[i] = Vector3(result[0][i][lane], result[1][i][lane], result[2][i][lane]);
+            }
+        }
+    }
+}
+
+void RelightPrtVertices(const PrtVertexTransfer& transfer, const PrtLightingSH& lighting, Vector3* out) {
+    PRISMA_PROFILE_ZONE("RelightPrtVertices");
+
+    const uint32_t vertexCount = transfer.getVertexCount();
+    const uint32_t blockCount = transfer.getBlockCount();
+    alignas(16) float result[3][kPrtBlockSize];
+
+#ifdef PRISMA_PRT_SIMD
+    F4 light[3][kPrtCoefficients];
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+            light[c][j] = splat(lighting.coefficients[c][j]);
+        }
+    }
+#endif
+
+    for (uint32_t b = 0; b < blockCount; ++b) {
+        const float* block = transfer.getBlock(b);
+
+        for (uint32_t c = 0; c < 3; ++c) {
+            const float* coefficients = block + vertexOffset(c, 0, 0);
+#ifdef PRISMA_PRT_SIMD
+            F4 sum = zero4();
+            for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                sum = madd(load4(coefficients + j * kPrtBlockSize), light[c][j], sum);
+            }
+            store4(result[c], sum);
+#else
+            for (uint32_t lane = 0; lane < kPrtBlockSize; ++lane) {
+                float sum = 0.0f;
+                for (uint32_t j = 0; j < kPrtCoefficients; ++j) {
+                    sum += coefficients[j * kPrtBlockSize + lane] * lighting.coefficients[c][j];
+                }
+                result[c][lane] = sum;
+            }
+#endif
+        }
+
+        const uint32_t lanes = std::min(kPrtBlockSize, vertexCount - b * kPrtBlockSize);
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            out[b * kPrtBlockSize + lane] = Vector3(result[0][lane], result[1][lane], result[2][lane]);
+        }
+    }
+}
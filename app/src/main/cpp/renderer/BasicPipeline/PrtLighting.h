@@ -0,0 +1,183 @@
+/**
+ * @file PrtLighting.h
+ * @brief 预计算辐射传输（PRT）运行时 - 时间变化时重新计算静态场景的间接光
+ *
+ * 光照贴图只对烘焙时的光照正确，昼夜变化后就错了；完全动态的 GI 又负担不起。
+ * PRT 把“远处光照 → 场景中某点的光照”这一线性映射离线烘焙成 L2 球谐（9 系数）传输
+ * （Baking/PrtBaker.h，含遮挡与多次漫反射弹射），运行时只需:
+ * 1. 把当前的太阳、天空和 LightingData 光源投影到 SH（ProjectLightingToPrt，每帧一次）
+ * 2. 探针: 9x9 传输矩阵乘光照向量，得到探针处入射辐射度的 SH，写入
+ *    LightingData::LightProbe::sphericalHarmonics（RelightPrtProbes）
+ * 3. 顶点: 9 维传输向量与光照向量点积，得到与光照贴图同约定的光照值
+ *    （diffuse = albedo * 结果，RelightPrtVertices）
+ *
+ * 传输数据按 4 个探针/顶点一块交错存储，内核每次用一组 SSE2/NEON 指令处理一块；
+ * 没有 SIMD 的平台使用同样顺序的标量循环
+ *
+ * 约定:
+ * - 光照 SH 是远处入射辐射度的投影，每通道独立（RGB）
+ * - 定向光按 π * color * intensity 的 δ 函数投影，使顶点结果与
+ *   LightingData::calculateLightingAtPoint 的 color * intensity * NdotL 一致
+ * - 点光源、聚光灯按 PrtProjectionSettings::referencePoint 处的方向和衰减近似为定向光
+ *   （PRT 假设光照来自远处，只适合范围远大于场景的光源）
+ *
+ * 用法:
+ * @code
+ *
+ * // 加载时
+ * PrtProbeTransfer transfer = bakeResult.probes;
+ *
+ * // 时间变化时
+ * PrtLightingSH lightSH;
+ * ProjectLightingToPrt(lightingData, projectionSettings, lightSH);
+ * RelightPrtProbes(transfer, lightSH, lightingData.lightProbes.data());
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "LightingData.h"
+#include "MemoryTracker.h"
+#include "SphericalHarmonics.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+
+/** L2 球谐系数个数（基函数与顺序见 SphericalHarmonics.h） */
+constexpr uint32_t kPrtCoefficients = kSHMaxCoefficients;
+
+/** 传输数据每块的探针/顶点数（SIMD 宽度） */
+constexpr uint32_t kPrtBlockSize = 4;
+
+// ============================================================================
+// 光照投影
+// ============================================================================
+
+/**
+ * @brief 远处入射辐射度的 SH 投影（每通道 9 系数，按通道存储供内核广播）
+ */
+struct PrtLightingSH {
+    float coefficients[3][kPrtCoefficients] = {};
+
+    /** 从 RGB SH 转换（SH9RGB 为每系数一个 Vector3） */
+    void assign(const SH9RGB& sh);
+
+    SH9RGB toSH() const;
+
+    /**
+     * @brief 累加来自 direction 方向的 δ 光源
+     * @param direction 指向光源的单位向量
+     * @param irradiance color * intensity（内部乘 π，见文件头的约定）
+     */
+    void addDirectional(const Vector3& direction, const Vector3& irradiance);
+
+    /** 累加均匀的环境辐射度 */
+    void addUniform(const Vector3& radiance);
+
+    void clear();
+};
+
+/**
+ * @brief 光照投影配置
+ */
+struct PrtProjectionSettings {
+    bool includeDirectional = true;
+    bool includeLocal = true;
+
+    /** 环境光（ambientColor * ambientIntensity）作为均匀天空 */
+    bool includeSky = true;
+
+    /** Baked 光源已经在光照贴图里，默认跳过 */
+    bool skipBakedLights = true;
+
+    /** 点光源、聚光灯的方向与衰减在该点计算 */
+    Vector3 referencePoint = Vector3(0.0f);
+
+    /** 对投影结果加 Hann 窗，减少少量强定向光带来的振铃（负值） */
+    bool applyWindow = false;
+};
+
+/**
+ * @brief 把 LightingData 的光源和环境光投影到 SH
+ */
+void ProjectLightingToPrt(const LightingData& lighting, const PrtProjectionSettings& settings, PrtLightingSH& out);
+
+// ============================================================================
+// 传输数据
+// ============================================================================
+
+/**
+ * @brief 探针传输矩阵
+ *
+ * 每个探针每通道一个 9x9 矩阵 M: 入射辐射度 SH[i] = Σ_j M[i][j] * 光照 SH[j]。
+ * 存储按块 [通道][行][列][块内探针] 交错，块尾不足 4 个探针的部分补 0
+ */
+class PrtProbeTransfer {
+public:
+    /** 每块的浮点数 */
+    static constexpr uint32_t BlockFloats = 3 * kPrtCoefficients * kPrtCoefficients * kPrtBlockSize;
+
+    void resize(uint32_t probeCount);
+
+    uint32_t getProbeCount() const { return probeCount_; }
+    uint32_t getBlockCount() const { return (probeCount_ + kPrtBlockSize - 1) / kPrtBlockSize; }
+
+    /** 写入一个探针的矩阵 matrix[通道][行][列] */
+    void setProbe(uint32_t probe, const float matrix[3][kPrtCoefficients][kPrtCoefficients]);
+
+    float get(uint32_t probe, uint32_t channel, uint32_t row, uint32_t column) const;
+
+    const float* getBlock(uint32_t block) const { return data_.data() + static_cast<size_t>(block) * BlockFloats; }
+
+    size_t getMemoryBytes() const { return data_.size() * sizeof(float); }
+
+private:
+    uint32_t probeCount_ = 0;
+    TaggedVector<float, MemoryTag::Lighting> data_;
+};
+
+/**
+ * @brief 顶点传输向量
+ *
+ * 每个顶点每通道 9 个系数: 光照值 = Σ_j T[j] * 光照 SH[j]（已含余弦、遮挡与弹射，不含该点的 albedo）。
+ * 存储按块 [通道][系数][块内顶点] 交错
+ */
+class PrtVertexTransfer {
+public:
+    static constexpr uint32_t BlockFloats = 3 * kPrtCoefficients * kPrtBlockSize;
+
+    void resize(uint32_t vertexCount);
+
+    uint32_t getVertexCount() const { return vertexCount_; }
+    uint32_t getBlockCount() const { return (vertexCount_ + kPrtBlockSize - 1) / kPrtBlockSize; }
+
+    /** 写入一个顶点的向量 vector[通道][系数] */
+    void setVertex(uint32_t vertex, const float vector[3][kPrtCoefficients]);
+
+    float get(uint32_t vertex, uint32_t channel, uint32_t coefficient) const;
+
+    const float* getBlock(uint32_t block) const { return data_.data() + static_cast<size_t>(block) * BlockFloats; }
+
+    size_t getMemoryBytes() const { return data_.size() * sizeof(float); }
+
+private:
+    uint32_t vertexCount_ = 0;
+    TaggedVector<float, MemoryTag::Lighting> data_;
+};
+
+// ============================================================================
+// 重新计算光照
+// ============================================================================
+
+/**
+ * @brief 用当前光照重新计算探针的 SH
+ * @param probes 至少 transfer.getProbeCount() 个探针，只写 sphericalHarmonics
+ */
+void RelightPrtProbes(const PrtProbeTransfer& transfer, const PrtLightingSH& lighting,
+                      LightingData::LightProbe* probes);
+
+/**
+ * @brief 用当前光照重新计算顶点光照
+ * @param out 至少 transfer.getVertexCount() 个值（与光照贴图同约定）
+ */
+void RelightPrtVertices(const PrtVertexTransfer& transfer, const PrtLightingSH& lighting, Vector3* out);
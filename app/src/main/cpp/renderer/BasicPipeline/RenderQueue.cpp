@@ -0,0 +1,200 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief 渲染队列实现
+ *
+ * 包含渲染队列、队列管理器、以及基于组件存储的队列构建。
+ * submit / submitAll 录制绘制命令，依赖图形API，由渲染后端实现，不在本文件中
+ */
+
+#include "RenderQueue.h"
+#include "RenderableStorage.h"
+#include "Frustum.h"
+#include "CameraSnapshot.h"
+#include "StereoRendering.h"
+
+#include <algorithm>
+
+// ============================================================================
+// 渲染队列实现
+// ============================================================================
+
+RenderQueue::RenderQueue(uint32_t queueID, const char* name)
+    : queueID_(queueID), name_(name) {}
+
+void RenderQueue::addObject(const RenderObject& obj) {
+    objects_.push_back(obj);
+    isSorted_ = false;
+}
+
+void RenderQueue::addObjects(const std::vector<RenderObject>& objects) {
+    objects_.insert(objects_.end(), objects.begin(), objects.end());
+    isSorted_ = false;
+}
+
+void RenderQueue::clear() {
+    // 保留容量，避免每帧重新分配
+    objects_.clear();
+    isSorted_ = false;
+}
+
+void RenderQueue::sort() {
+    if (isSorted_ || sortMode_ == SortMode::None) {
+        isSorted_ = true;
+        return;
+    }
+
+    std::sort(objects_.begin(), objects_.end(), RenderObject::Comparator{sortMode_});
+    isSorted_ = true;
+}
+
+// ============================================================================
+// 渲染队列管理器实现
+// ============================================================================
+
+RenderQueueManager::RenderQueueManager() {
+    backgroundQueue_ = createQueue(RenderQueueId::Background, "Background");
+    opaqueQueue_ = createQueue(RenderQueueId::Opaque, "Opaque");
+    alphaTestQueue_ = createQueue(RenderQueueId::AlphaTest, "AlphaTest");
+    transparentQueue_ = createQueue(RenderQueueId::Transparent, "Transparent");
+    overlayQueue_ = createQueue(RenderQueueId::Overlay, "Overlay");
+
+    opaqueQueue_->setSortMode(SortMode::FrontToBack);
+    alphaTestQueue_->setSortMode(SortMode::MaterialThenDistance);
+    transparentQueue_->setSortMode(SortMode::BackToFront);
+}
+
+void RenderQueueManager::addObject(const RenderObject& obj) {
+    // 按队列ID区间分配，与Unity的队列范围一致
+    RenderQueue* queue;
+    if (obj.queueID < RenderQueueId::Opaque) {
+        queue = backgroundQueue_;
+        stats_.backgroundObjects++;
+    } else if (obj.queueID < RenderQueueId::AlphaTest) {
+        queue = opaqueQueue_;
+        stats_.opaqueObjects++;
+    } else if (obj.queueID < RenderQueueId::Transparent) {
+        queue = alphaTestQueue_;
+        stats_.alphaTestObjects++;
+    } else if (obj.queueID < RenderQueueId::Overlay) {
+        queue = transparentQueue_;
+        stats_.transparentObjects++;
+    } else {
+        queue = overlayQueue_;
+        stats_.overlayObjects++;
+    }
+
+    // 自定义队列优先精确匹配
+    if (queues_.size() > 5) {
+        if (RenderQueue* custom = getQueue(obj.queueID)) {
+            queue = custom;
+        }
+    }
+
+    queue->addObject(obj);
+    stats_.totalObjects++;
+}
+
+RenderQueue* RenderQueueManager::createQueue(uint32_t queueID, const char* name) {
+    if (RenderQueue* existing = getQueue(queueID)) {
+        return existing;
+    }
+
+    queues_.push_back(std::make_unique<RenderQueue>(queueID, name));
+
+    // 保持按队列ID升序，submitAll按此顺序提交
+    std::stable_sort(queues_.begin(), queues_.end(),
+                     [](const std::unique_ptr<RenderQueue>& a, const std::unique_ptr<RenderQueue>& b) {
+                         return a->getQueueID() < b->getQueueID();
+                     });
+
+    return getQueue(queueID);
+}
+
+RenderQueue* RenderQueueManager::getQueue(uint32_t queueID) {
+    for (auto& queue : queues_) {
+        if (queue->getQueueID() == queueID) {
+            return queue.get();
+        }
+    }
+    return nullptr;
+}
+
+void RenderQueueManager::clear() {
+    for (auto& queue : queues_) {
+        queue->clear();
+    }
+    resetStats();
+}
+
+void RenderQueueManager::sortAll() {
+    for (auto& queue : queues_) {
+        queue->sort();
+    }
+}
+
+// ============================================================================
+// 渲染队列构建器实现（组件存储路径）
+// ============================================================================
+
+void RenderQueueBuilder::build(const RenderableStorage& storage,
+                               const Vector3& cameraPosition,
+                               RenderQueueManager& queueManager,
+                               const Frustum* frustum) {
+    const uint32_t count = static_cast<uint32_t>(storage.size());
+    const RenderableBounds* bounds = storage.getBounds();
+    const uint32_t* flags = storage.getFlags();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!(flags[i] & RenderableFlags::Visible)) {
+            continue;
+        }
+
+        if (frustum && !frustum->intersectsSphere(bounds[i].center, bounds[i].radius)) {
+            continue;
+        }
+
+        queueManager.addObject(storage.makeRenderObject(i, cameraPosition));
+    }
+}
+
+void RenderQueueBuilder::build(const RenderableStorage& storage,
+                               const CameraSnapshot& camera,
+                               RenderQueueManager& queueManager) {
+    const uint32_t count = static_cast<uint32_t>(storage.size());
+    const RenderableBounds* bounds = storage.getBounds();
+    const uint32_t* flags = storage.getFlags();
+    const FrustumPlanesSoA& planes = camera.frustumPlanes;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!(flags[i] & RenderableFlags::Visible)) {
+            continue;
+        }
+
+        if (!planes.intersectsSphere(bounds[i].center, bounds[i].radius)) {
+            continue;
+        }
+
+        queueManager.addObject(storage.makeRenderObject(i, camera.position));
+    }
+}
+
+void RenderQueueBuilder::build(const RenderableStorage& storage,
+                               const StereoSnapshot& stereo,
+                               RenderQueueManager& queueManager) {
+    const uint32_t count = static_cast<uint32_t>(storage.size());
+    const RenderableBounds* bounds = storage.getBounds();
+    const uint32_t* flags = storage.getFlags();
+    const FrustumPlanesSoA& planes = stereo.cullingPlanes;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!(flags[i] & RenderableFlags::Visible)) {
+            continue;
+        }
+
+        if (!planes.intersectsSphere(bounds[i].center, bounds[i].radius)) {
+            continue;
+        }
+
+        queueManager.addObject(storage.makeRenderObject(i, stereo.cullingPosition));
+    }
+}
@@ -0,0 +1,382 @@
+/**
+ * @file RenderStats.cpp
+ * @brief 每帧渲染统计实现
+ */
+
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <cstdio>
+
+// ============================================================================
+// PassRenderStats / FrameRenderStats
+// ============================================================================
+
+PassRenderStats& PassRenderStats::operator+=(const PassRenderStats& other) {
+    drawCalls += other.drawCalls;
+    instances += other.instances;
+    triangles += other.triangles;
+    pipelineBinds += other.pipelineBinds;
+    pipelineBindsElided += other.pipelineBindsElided;
+    descriptorBinds += other.descriptorBinds;
+    descriptorBindsElided += other.descriptorBindsElided;
+    return *this;
+}
+
+PassRenderStats FrameRenderStats::total() const {
+    PassRenderStats sum;
+    for (const auto& p : passes) {
+        sum += p;
+    }
+    return sum;
+}
+
+// ============================================================================
+// RenderStatsCollector
+// ============================================================================
+
+RenderStatsCollector::RenderStatsCollector(uint32_t historySize) {
+    setHistorySize(historySize);
+    invalidateBindState();
+}
+
+void RenderStatsCollector::beginFrame(uint64_t frameNumber) {
+    current_ = FrameRenderStats();
+    current_.frameNumber = frameNumber;
+    invalidateBindState();
+}
+
+void RenderStatsCollector::endFrame() {
+    if (history_.empty()) {
+        return;
+    }
+    history_[next_] = current_;
+    next_ = (next_ + 1) % history_.size();
+    count_ = std::min(count_ + 1, history_.size());
+}
+
+bool RenderStatsCollector::trackPipelineBind(RenderStatsPass pass, uint64_t key) {
+    PassRenderStats& p = current_.pass(pass);
+    if (key == boundPipeline_) {
+        ++p.pipelineBindsElided;
+        return false;
+    }
+    boundPipeline_ = key;
+    ++p.pipelineBinds;
+
+    // 切换管线后布局可能不兼容，描述符需重新绑定
+    boundDescriptors_.fill(NoBinding);
+    return true;
+}
+
+bool RenderStatsCollector::trackDescriptorBind(RenderStatsPass pass, uint32_t set, uint64_t key) {
+    PassRenderStats& p = current_.pass(pass);
+    if (set < MaxDescriptorSets && boundDescriptors_[set] == key) {
+        ++p.descriptorBindsElided;
+        return false;
+    }
+    if (set < MaxDescriptorSets) {
+        boundDescriptors_[set] = key;
+    }
+    ++p.descriptorBinds;
+    return true;
+}
+
+void RenderStatsCollector::invalidateBindState() {
+    boundPipeline_ = NoBinding;
+    boundDescriptors_.fill(NoBinding);
+}
+
+const FrameRenderStats& RenderStatsCollector::getLast() const {
+    static const FrameRenderStats empty;
+    if (count_ == 0) {
+        return empty;
+    }
+    return history_[(next_ + history_.size() - 1) % history_.size()];
+}
+
+const FrameRenderStats& RenderStatsCollector::getHistory(size_t index) const {
+    const size_t oldest = (next_ + history_.size() - count_) % history_.size();
+    return history_[(oldest + index) % history_.size()];
+}
+
+FrameRenderStats RenderStatsCollector::getAverage() const {
+    FrameRenderStats avg;
+    if (count_ == 0) {
+        return avg;
+    }
+
+    // 先用 64 位累加，最后除以帧数
+    struct Sum {
+        uint64_t v[7] = {};
+    };
+    std::array<Sum, static_cast<size_t>(RenderStatsPass::Count)> passSums{};
+    std::array<uint64_t, static_cast<size_t>(CullingStage::Count) * 2> cullSums{};
+    uint64_t shadowMaps = 0, cascades = 0, memory = 0, textures = 0, buffers = 0, upload = 0, visible = 0;
+    uint64_t secondaryUpdates = 0, secondaryDeferred = 0, secondaryStaleness = 0;
+    uint64_t latched = 0;
+    double cpuMs = 0.0, secondaryMs = 0.0, latencyEarlyMs = 0.0, latencyMs = 0.0;
+
+    for (size_t i = 0; i < count_; ++i) {
+        const FrameRenderStats& f = getHistory(i);
+        for (size_t p = 0; p < f.passes.size(); ++p) {
+            const PassRenderStats& s = f.passes[p];
+            uint64_t* v = passSums[p].v;
+            v[0] += s.drawCalls;
+            v[1] += s.instances;
+            v[2] += s.triangles;
+            v[3] += s.pipelineBinds;
+            v[4] += s.pipelineBindsElided;
+            v[5] += s.descriptorBinds;
+            v[6] += s.descriptorBindsElided;
+        }
+        for (size_t c = 0; c < f.culling.size(); ++c) {
+            cullSums[c * 2] += f.culling[c].tested;
+            cullSums[c * 2 + 1] += f.culling[c].culled;
+        }
+        shadowMaps += f.shadowMapsRendered;
+        cascades += f.shadowCascadesRendered;
+        memory += f.transientMemoryBytes;
+        textures += f.transientTextures;
+        buffers += f.transientBuffers;
+        upload += f.uploadBytes;
+        visible += f.visibleObjects;
+        cpuMs += f.cpuFrameMs;
+        secondaryUpdates += f.secondaryCameraUpdates;
+        secondaryDeferred += f.secondaryCameraDeferred;
+        secondaryStaleness += f.secondaryCameraMaxStaleness;
+        secondaryMs += f.secondaryCameraCostMs;
+        latencyEarlyMs += f.inputLatencyEarlyMs;
+        latencyMs += f.inputLatencyMs;
+        latched += f.cameraLatched;
+    }
+
+    const uint64_t n = count_;
+    for (size_t p = 0; p < avg.passes.size(); ++p) {
+        const uint64_t* v = passSums[p].v;
+        PassRenderStats& s = avg.passes[p];
+        s.drawCalls = static_cast<uint32_t>(v[0] / n);
+        s.instances = static_cast<uint32_t>(v[1] / n);
+        s.triangles = v[2] / n;
+        s.pipelineBinds = static_cast<uint32_t>(v[3] / n);
+        s.pipelineBindsElided = static_cast<uint32_t>(v[4] / n);
+        s.descriptorBinds = static_cast<uint32_t>(v[5] / n);
+        s.descriptorBindsElided = static_cast<uint32_t>(v[6] / n);
+    }
+    for (size_t c = 0; c < avg.culling.size(); ++c) {
+        avg.culling[c].tested = static_cast<uint32_t>(cullSums[c * 2] / n);
+        avg.culling[c].culled = static_cast<uint32_t>(cullSums[c * 2 + 1] / n);
+    }
+    avg.frameNumber = getLast().frameNumber;
+    avg.shadowMapsRendered = static_cast<uint32_t>(shadowMaps / n);
+    avg.shadowCascadesRendered = static_cast<uint32_t>(cascades / n);
+    avg.transientMemoryBytes = memory / n;
+    avg.transientTextures = static_cast<uint32_t>(textures / n);
+    avg.transientBuffers = static_cast<uint32_t>(buffers / n);
+    avg.uploadBytes = upload / n;
+    avg.visibleObjects = static_cast<uint32_t>(visible / n);
+    avg.cpuFrameMs = static_cast<float>(cpuMs / static_cast<double>(n));
+    avg.secondaryCameraUpdates = static_cast<uint32_t>(secondaryUpdates / n);
+    avg.secondaryCameraDeferred = static_cast<uint32_t>(secondaryDeferred / n);
+    avg.secondaryCameraMaxStaleness = static_cast<uint32_t>(secondaryStaleness / n);
+    avg.secondaryCameraCostMs = static_cast<float>(secondaryMs / static_cast<double>(n));
+    avg.inputLatencyEarlyMs = static_cast<float>(latencyEarlyMs / static_cast<double>(n));
+    avg.inputLatencyMs = static_cast<float>(latencyMs / static_cast<double>(n));
+    avg.cameraLatched = static_cast<uint32_t>(latched / n);
+    return avg;
+}
+
+void RenderStatsCollector::setHistorySize(uint32_t size) {
+    history_.assign(std::max(size, 1u), FrameRenderStats());
+    next_ = 0;
+    count_ = 0;
+}
+
+void RenderStatsCollector::clearHistory() {
+    next_ = 0;
+    count_ = 0;
+}
+
+// ============================================================================
+// 导出
+// ============================================================================
+
+bool RenderStatsCollector::writeCsv(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+
+    std::fprintf(f, "frame,cpuMs,visibleObjects,shadowMaps,shadowCascades,"
+                    "transientBytes,transientTextures,transientBuffers,uploadBytes,"
+                    "secondaryUpdates,secondaryDeferred,secondaryMs,secondaryMaxStale,"
+                    "inputLatencyEarlyMs,inputLatencyMs,cameraLatched");
+    for (uint32_t p = 0; p < static_cast<uint32_t>(RenderStatsPass::Count); ++p) {
+        const char* name = GetRenderStatsPassName(static_cast<RenderStatsPass>(p));
+        std::fprintf(f, ",%s.draws,%s.instances,%s.triangles,%s.pipelineBinds,%s.pipelineElided,"
+                        "%s.descriptorBinds,%s.descriptorElided",
+                     name, name, name, name, name, name, name);
+    }
+    for (uint32_t c = 0; c < static_cast<uint32_t>(CullingStage::Count); ++c) {
+        const char* name = GetCullingStageName(static_cast<CullingStage>(c));
+        std::fprintf(f, ",cull.%s.tested,cull.%s.culled", name, name);
+    }
+    std::fprintf(f, "\n");
+
+    for (size_t i = 0; i < count_; ++i) {
+        const FrameRenderStats& s = getHistory(i);
+        std::fprintf(f, "%llu,%.3f,%u,%u,%u,%llu,%u,%u,%llu,%u,%u,%.3f,%u,%.3f,%.3f,%u",
+                     static_cast<unsigned long long>(s.frameNumber), s.cpuFrameMs, s.visibleObjects,
+                     s.shadowMapsRendered, s.shadowCascadesRendered,
+                     static_cast<unsigned long long>(s.transientMemoryBytes),
+                     s.transientTextures, s.transientBuffers,
+                     static_cast<unsigned long long>(s.uploadBytes),
+                     s.secondaryCameraUpdates, s.secondaryCameraDeferred,
+                     s.secondaryCameraCostMs, s.secondaryCameraMaxStaleness,
+                     s.inputLatencyEarlyMs, s.inputLatencyMs, s.cameraLatched);
+        for (const auto& p : s.passes) {
+            std::fprintf(f, ",%u,%u,%llu,%u,%u,%u,%u",
+                         p.drawCalls, p.instances, static_cast<unsigned long long>(p.triangles),
+                         p.pipelineBinds, p.pipelineBindsElided,
+                         p.descriptorBinds, p.descriptorBindsElided);
+        }
+        for (const auto& c : s.culling) {
+            std::fprintf(f, ",%u,%u", c.tested, c.culled);
+        }
+        std::fprintf(f, "\n");
+    }
+
+    std::fclose(f);
+    return true;
+}
+
+bool RenderStatsCollector::writeJson(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+
+    std::fprintf(f, "{\n  \"frames\": [\n");
+    for (size_t i = 0; i < count_; ++i) {
+        const FrameRenderStats& s = getHistory(i);
+        std::fprintf(f, "    {\"frame\": %llu, \"cpuMs\": %.3f, \"visibleObjects\": %u, "
+                        "\"shadowMaps\": %u, \"shadowCascades\": %u, "
+                        "\"transientBytes\": %llu, \"transientTextures\": %u, \"transientBuffers\": %u, "
+                        "\"uploadBytes\": %llu,\n     \"secondaryCameras\": {\"updates\": %u, \"deferred\": %u, "
+                        "\"costMs\": %.3f, \"maxStaleness\": %u},\n     \"inputLatency\": {\"earlyMs\": %.3f, "
+                        "\"submittedMs\": %.3f, \"latched\": %u},\n     \"passes\": {",
+                     static_cast<unsigned long long>(s.frameNumber), s.cpuFrameMs, s.visibleObjects,
+                     s.shadowMapsRendered, s.shadowCascadesRendered,
+                     static_cast<unsigned long long>(s.transientMemoryBytes),
+                     s.transientTextures, s.transientBuffers,
+                     static_cast<unsigned long long>(s.uploadBytes),
+                     s.secondaryCameraUpdates, s.secondaryCameraDeferred,
+                     s.secondaryCameraCostMs, s.secondaryCameraMaxStaleness,
+                     s.inputLatencyEarlyMs, s.inputLatencyMs, s.cameraLatched);
+
+        for (uint32_t p = 0; p < static_cast<uint32_t>(RenderStatsPass::Count); ++p) {
+            const PassRenderStats& ps = s.passes[p];
+            std::fprintf(f, "%s\"%s\": {\"draws\": %u, \"instances\": %u, \"triangles\": %llu, "
+                            "\"pipelineBinds\": %u, \"pipelineElided\": %u, "
+                            "\"descriptorBinds\": %u, \"descriptorElided\": %u}",
+                         p ? ", " : "", GetRenderStatsPassName(static_cast<RenderStatsPass>(p)),
+                         ps.drawCalls, ps.instances, static_cast<unsigned long long>(ps.triangles),
+                         ps.pipelineBinds, ps.pipelineBindsElided,
+                         ps.descriptorBinds, ps.descriptorBindsElided);
+        }
+
+        std::fprintf(f, "},\n     \"culling\": {");
+        for (uint32_t c = 0; c < static_cast<uint32_t>(CullingStage::Count); ++c) {
+            std::fprintf(f, "%s\"%s\": {\"tested\": %u, \"culled\": %u}",
+                         c ? ", " : "", GetCullingStageName(static_cast<CullingStage>(c)),
+                         s.culling[c].tested, s.culling[c].culled);
+        }
+        std::fprintf(f, "}}%s\n", i + 1 < count_ ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+
+    std::fclose(f);
+    return true;
+}
+
+// ============================================================================
+// 工具函数
+// ============================================================================
+
+uint64_t EstimateTextureBytes(const TextureDesc& desc) {
+    // 压缩格式按 4x4 块计算
+    uint32_t blockBytes = 0;
+    uint32_t bytesPerPixel = 0;
+
+    switch (desc.format) {
+        case TextureFormat::R8:             bytesPerPixel = 1; break;
+        case TextureFormat::RG8:            bytesPerPixel = 2; break;
+        case TextureFormat::RGB8:           bytesPerPixel = 4; break;   // 通常按 RGBA 存储
+        case TextureFormat::RGBA8:
+        case TextureFormat::SRGB8:
+        case TextureFormat::SRGB8_A8:       bytesPerPixel = 4; break;
+        case TextureFormat::R16:
+        case TextureFormat::R16F:
+        case TextureFormat::Depth16:        bytesPerPixel = 2; break;
+        case TextureFormat::RG16:
+        case TextureFormat::RG16F:
+        case TextureFormat::R32F:
+        case TextureFormat::Depth24Stencil8:
+        case TextureFormat::Depth32F:       bytesPerPixel = 4; break;
+        case TextureFormat::RGB16:
+        case TextureFormat::RGB16F:
+        case TextureFormat::RGBA16:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RG32F:          bytesPerPixel = 8; break;
+        case TextureFormat::RGB32F:
+        case TextureFormat::RGBA32F:        bytesPerPixel = 16; break;
+        case TextureFormat::BC1:
+        case TextureFormat::BC4:            blockBytes = 8; break;
+        case TextureFormat::BC2:
+        case TextureFormat::BC3:
+        case TextureFormat::BC5:
+        case TextureFormat::BC6H:
+        case TextureFormat::BC7:            blockBytes = 16; break;
+        case TextureFormat::Unknown:        bytesPerPixel = 4; break;
+    }
+
+    uint64_t total = 0;
+    uint32_t w = std::max(desc.width, 1u);
+    uint32_t h = std::max(desc.height, 1u);
+    const uint32_t mips = std::max(desc.mipLevels, 1u);
+
+    for (uint32_t mip = 0; mip < mips; ++mip) {
+        if (blockBytes > 0) {
+            total += static_cast<uint64_t>((w + 3) / 4) * ((h + 3) / 4) * blockBytes;
+        } else {
+            total += static_cast<uint64_t>(w) * h * bytesPerPixel;
+        }
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+    }
+
+    return total * std::max(desc.depth, 1u);
+}
+
+const char* GetRenderStatsPassName(RenderStatsPass pass) {
+    switch (pass) {
+        case RenderStatsPass::Shadow:       return "Shadow";
+        case RenderStatsPass::DepthPrepass: return "DepthPrepass";
+        case RenderStatsPass::Opaque:       return "Opaque";
+        case RenderStatsPass::Skybox:       return "Skybox";
+        case RenderStatsPass::Transparent:  return "Transparent";
+        case RenderStatsPass::Features:     return "Features";
+        case RenderStatsPass::Count:        break;
+    }
+    return "Unknown";
+}
+
+const char* GetCullingStageName(CullingStage stage) {
+    switch (stage) {
+        case CullingStage::Frustum:      return "Frustum";
+        case CullingStage::Occlusion:    return "Occlusion";
+        case CullingStage::Contribution: return "Contribution";
+        case CullingStage::Count:        break;
+    }
+    return "Unknown";
+}
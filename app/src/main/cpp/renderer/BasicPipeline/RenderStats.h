@@ -0,0 +1,300 @@
+/**
+ * @file RenderStats.h
+ * @brief 每帧渲染统计 - 统一的绘制、绑定、阴影、内存、上传和剔除计数
+ *
+ * 取代分散在 RenderQueueManager::Stats 和 FrustumCuller::Stats 中的计数:
+ * - 每个Pass的绘制调用、实例数、三角形数
+ * - 管线/描述符绑定：实际发出 vs 因状态相同而省略
+ * - 渲染的阴影贴图和级联数
+ * - 临时资源占用的内存
+ * - 上传字节数
+ * - 各剔除阶段（视锥、遮挡、贡献度）的测试/剔除数
+ * - 次级相机的更新/推迟次数、开销与最大陈旧度
+ *
+ * RenderStatsCollector 保存最近若干帧的滚动历史，可导出 CSV / JSON 供离线分析
+ */
+
+#pragma once
+
+#include "RenderHandle.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 统计所属的Pass
+ */
+enum class RenderStatsPass : uint32_t {
+    Shadow,
+    DepthPrepass,
+    Opaque,
+    Skybox,
+    Transparent,
+    Features,       // 所有 IRenderFeature 的绘制
+    Count
+};
+
+/**
+ * @brief 剔除阶段
+ */
+enum class CullingStage : uint32_t {
+    Frustum,        // 视锥剔除
+    Occlusion,      // 遮挡剔除
+    Contribution,   // 屏幕贡献度（过小）剔除
+    Count
+};
+
+/**
+ * @brief 单个Pass的统计
+ */
+struct PassRenderStats {
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;
+    uint64_t triangles = 0;
+
+    uint32_t pipelineBinds = 0;
+    uint32_t pipelineBindsElided = 0;
+
+    uint32_t descriptorBinds = 0;
+    uint32_t descriptorBindsElided = 0;
+
+    PassRenderStats& operator+=(const PassRenderStats& other);
+};
+
+/**
+ * @brief 单个剔除阶段的统计
+ */
+struct CullingStageStats {
+    uint32_t tested = 0;
+    uint32_t culled = 0;
+
+    uint32_t visible() const { return tested - culled; }
+};
+
+/**
+ * @brief 一帧的完整统计
+ */
+struct FrameRenderStats {
+    uint64_t frameNumber = 0;
+
+    /** CPU 帧耗时（毫秒，由调用者通过 setCpuFrameMs 填写，NullFrameRunner 为 beginFrame 到 endFrame 的耗时） */
+    float cpuFrameMs = 0.0f;
+
+    std::array<PassRenderStats, static_cast<size_t>(RenderStatsPass::Count)> passes{};
+
+    // 阴影
+    uint32_t shadowMapsRendered = 0;
+    uint32_t shadowCascadesRendered = 0;
+
+    // 内存
+    uint64_t transientMemoryBytes = 0;
+    uint32_t transientTextures = 0;
+    uint32_t transientBuffers = 0;
+
+    /** 本帧上传到GPU的字节数（常量缓冲、实例数据、纹理流送等） */
+    uint64_t uploadBytes = 0;
+
+    // 剔除
+    std::array<CullingStageStats, static_cast<size_t>(CullingStage::Count)> culling{};
+
+    /** 所有剔除阶段后仍可见的对象数 */
+    uint32_t visibleObjects = 0;
+
+    // 次级相机（见 SecondaryCameraScheduler.h）
+    uint32_t secondaryCameraUpdates = 0;
+    uint32_t secondaryCameraDeferred = 0;
+    float secondaryCameraCostMs = 0.0f;
+    uint32_t secondaryCameraMaxStaleness = 0;
+
+    // 输入延迟（见 LateLatch.h）: 输入采样到提交，不锁存时的延迟与实际使用的相机的延迟
+    float inputLatencyEarlyMs = 0.0f;
+    float inputLatencyMs = 0.0f;
+    uint32_t cameraLatched = 0;
+
+    PassRenderStats& pass(RenderStatsPass p) { return passes[static_cast<size_t>(p)]; }
+    const PassRenderStats& pass(RenderStatsPass p) const { return passes[static_cast<size_t>(p)]; }
+
+    CullingStageStats& cullingStage(CullingStage s) { return culling[static_cast<size_t>(s)]; }
+    const CullingStageStats& cullingStage(CullingStage s) const { return culling[static_cast<size_t>(s)]; }
+
+    /** 所有Pass的合计 */
+    PassRenderStats total() const;
+};
+
+/**
+ * @brief 每帧统计收集器
+ *
+ * 用法:
+ * @code
+ *
+ * stats.beginFrame(frameNumber);
+ * if (stats.trackPipelineBind(RenderStatsPass::Opaque, pipelineKey)) {
+ *     vkCmdBindPipeline(...);
+ * }
+ * stats.recordDraw(RenderStatsPass::Opaque, instanceCount, triangleCount);
+ * stats.endFrame();
+ *
+ * @endcode
+ */
+class RenderStatsCollector {
+public:
+    static constexpr uint32_t DefaultHistorySize = 300;
+
+    explicit RenderStatsCollector(uint32_t historySize = DefaultHistorySize);
+
+    // ========================================================================
+    // 帧
+    // ========================================================================
+
+    /**
+     * @brief 开始新的一帧（清空当前帧计数和绑定状态）
+     */
+    void beginFrame(uint64_t frameNumber);
+
+    /**
+     * @brief 结束当前帧并写入历史
+     */
+    void endFrame();
+
+    // ========================================================================
+    // 记录
+    // ========================================================================
+
+    void recordDraw(RenderStatsPass pass, uint32_t instances = 1, uint64_t triangles = 0) {
+        PassRenderStats& p = current_.pass(pass);
+        ++p.drawCalls;
+        p.instances += instances;
+        p.triangles += triangles;
+    }
+
+    /**
+     * @brief 记录管线绑定请求
+     * @param key 管线标识（材质ID、PipelineHandle 等）
+     * @return true 如果需要实际绑定（与上次不同）
+     */
+    bool trackPipelineBind(RenderStatsPass pass, uint64_t key);
+
+    /**
+     * @brief 记录描述符集绑定请求
+     * @param set 描述符集索引（0-3）
+     * @param key 描述符集标识
+     * @return true 如果需要实际绑定
+     */
+    bool trackDescriptorBind(RenderStatsPass pass, uint32_t set, uint64_t key);
+
+    /**
+     * @brief 使绑定状态失效（切换命令缓冲区或 render pass 后调用）
+     */
+    void invalidateBindState();
+
+    void recordShadowMap(uint32_t cascades = 1) {
+        ++current_.shadowMapsRendered;
+        current_.shadowCascadesRendered += cascades;
+    }
+
+    void setTransientMemory(uint64_t bytes, uint32_t textures, uint32_t buffers) {
+        current_.transientMemoryBytes = bytes;
+        current_.transientTextures = textures;
+        current_.transientBuffers = buffers;
+    }
+
+    void addUploadBytes(uint64_t bytes) { current_.uploadBytes += bytes; }
+
+    void recordCulling(CullingStage stage, uint32_t tested, uint32_t culled) {
+        CullingStageStats& s = current_.cullingStage(stage);
+        s.tested += tested;
+        s.culled += culled;
+    }
+
+    void setVisibleObjects(uint32_t count) { current_.visibleObjects = count; }
+
+    /**
+     * @brief 记录次级相机调度结果（更新次数、推迟次数、估算开销、最大陈旧帧数）
+     */
+    void recordSecondaryCameras(uint32_t updates, uint32_t deferred, float costMs, uint32_t maxStaleness) {
+        current_.secondaryCameraUpdates = updates;
+        current_.secondaryCameraDeferred = deferred;
+        current_.secondaryCameraCostMs = costMs;
+        current_.secondaryCameraMaxStaleness = maxStaleness;
+    }
+
+    /**
+     * @brief 记录输入采样到提交的延迟（毫秒）及本帧相机是否被后期锁存
+     */
+    void recordInputLatency(float earlyMs, float submittedMs, bool latched) {
+        current_.inputLatencyEarlyMs = earlyMs;
+        current_.inputLatencyMs = submittedMs;
+        current_.cameraLatched = latched ? 1 : 0;
+    }
+    void setCpuFrameMs(float ms) { current_.cpuFrameMs = ms; }
+
+    // ========================================================================
+    // 查询
+    // ========================================================================
+
+    /** 正在收集的帧 */
+    const FrameRenderStats& getCurrent() const { return current_; }
+
+    /** 最近完成的一帧（没有历史时返回空统计） */
+    const FrameRenderStats& getLast() const;
+
+    /** 历史帧数 */
+    size_t getHistoryCount() const { return count_; }
+
+    /**
+     * @brief 按时间顺序访问历史
+     * @param index 0 = 最旧
+     */
+    const FrameRenderStats& getHistory(size_t index) const;
+
+    /**
+     * @brief 历史中所有帧的平均值（计数取整）
+     */
+    FrameRenderStats getAverage() const;
+
+    void setHistorySize(uint32_t size);
+    void clearHistory();
+
+    // ========================================================================
+    // 导出
+    // ========================================================================
+
+    /**
+     * @brief 导出为 CSV（每帧一行，每个Pass/剔除阶段展开为独立列）
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /**
+     * @brief 导出为 JSON（{"frames": [...]}）
+     */
+    bool writeJson(const std::string& path) const;
+
+private:
+    FrameRenderStats current_;
+
+    std::vector<FrameRenderStats> history_;
+    size_t next_ = 0;
+    size_t count_ = 0;
+
+    // 绑定状态（每帧重置）
+    static constexpr uint64_t NoBinding = ~0ull;
+    static constexpr uint32_t MaxDescriptorSets = 4;
+    uint64_t boundPipeline_ = NoBinding;
+    std::array<uint64_t, MaxDescriptorSets> boundDescriptors_{};
+};
+
+/**
+ * @brief 估算纹理占用的字节数（含 mip 链，压缩格式按块计算）
+ */
+uint64_t EstimateTextureBytes(const TextureDesc& desc);
+
+/**
+ * @brief 获取Pass名称（用于导出）
+ */
+const char* GetRenderStatsPassName(RenderStatsPass pass);
+
+/**
+ * @brief 获取剔除阶段名称（用于导出）
+ */
+const char* GetCullingStageName(CullingStage stage);
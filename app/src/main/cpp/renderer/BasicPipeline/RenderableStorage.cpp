@@ -0,0 +1,197 @@
+/**
+ * @file RenderableStorage.cpp
+ * @brief 可渲染组件存储实现
+ */
+
+#include "RenderableStorage.h"
+
+#include <cmath>
+
+// ============================================================================
+// 实体管理
+// ============================================================================
+
+RenderableHandle RenderableStorage::create(const RenderableDesc& desc) {
+    uint32_t entityIndex;
+
+    // 优先复用已销毁的实体索引
+    if (!freeEntities_.empty()) {
+        entityIndex = freeEntities_.back();
+        freeEntities_.pop_back();
+    } else {
+        entityIndex = static_cast<uint32_t>(sparse_.size());
+        sparse_.push_back(InvalidIndex);
+        generations_.push_back(0);
+    }
+
+    const uint32_t denseIndex = static_cast<uint32_t>(bounds_.size());
+    sparse_[entityIndex] = denseIndex;
+
+    RenderableHandle handle(entityIndex, generations_[entityIndex]);
+
+    bounds_.push_back({desc.center, desc.radius});
+    worldMatrices_.push_back(desc.worldMatrix);
+    materials_.push_back({desc.material, desc.materialID});
+    geometry_.push_back({desc.geometryHandle, desc.subMeshIndex});
+    queueIDs_.push_back(desc.queueID);
+    flags_.push_back(desc.flags);
+    cold_.push_back({desc.gameObject, desc.name, desc.depthState, desc.stencilState});
+    denseToHandle_.push_back(handle);
+    ++changeVersion_;
+
+    return handle;
+}
+
+void RenderableStorage::destroy(RenderableHandle handle) {
+    const uint32_t denseIndex = getDenseIndex(handle);
+    if (denseIndex == InvalidIndex) return;
+
+    const uint32_t lastIndex = static_cast<uint32_t>(bounds_.size()) - 1;
+
+    // 与末尾元素交换，保持紧密数组无空洞
+    if (denseIndex != lastIndex) {
+        bounds_[denseIndex] = bounds_[lastIndex];
+        worldMatrices_[denseIndex] = worldMatrices_[lastIndex];
+        materials_[denseIndex] = materials_[lastIndex];
+        geometry_[denseIndex] = geometry_[lastIndex];
+        queueIDs_[denseIndex] = queueIDs_[lastIndex];
+        flags_[denseIndex] = flags_[lastIndex];
+        cold_[denseIndex] = cold_[lastIndex];
+        denseToHandle_[denseIndex] = denseToHandle_[lastIndex];
+
+        sparse_[denseToHandle_[denseIndex].GetIndex()] = denseIndex;
+    }
+
+    bounds_.pop_back();
+    worldMatrices_.pop_back();
+    materials_.pop_back();
+    geometry_.pop_back();
+    queueIDs_.pop_back();
+    flags_.pop_back();
+    cold_.pop_back();
+    denseToHandle_.pop_back();
+
+    // 世代递增，使旧句柄失效
+    const uint32_t entityIndex = handle.GetIndex();
+    sparse_[entityIndex] = InvalidIndex;
+    generations_[entityIndex]++;
+    freeEntities_.push_back(entityIndex);
+    ++changeVersion_;
+}
+
+bool RenderableStorage::isValid(RenderableHandle handle) const {
+    return getDenseIndex(handle) != InvalidIndex;
+}
+
+uint32_t RenderableStorage::getDenseIndex(RenderableHandle handle) const {
+    const uint32_t entityIndex = handle.GetIndex();
+    if (entityIndex >= sparse_.size()) return InvalidIndex;
+    if (generations_[entityIndex] != handle.GetGeneration()) return InvalidIndex;
+    return sparse_[entityIndex];
+}
+
+void RenderableStorage::reserve(size_t count) {
+    bounds_.reserve(count);
+    worldMatrices_.reserve(count);
+    materials_.reserve(count);
+    geometry_.reserve(count);
+    queueIDs_.reserve(count);
+    flags_.reserve(count);
+    cold_.reserve(count);
+    denseToHandle_.reserve(count);
+    sparse_.reserve(count);
+    generations_.reserve(count);
+}
+
+void RenderableStorage::clear() {
+    // 所有存活实体的世代递增，旧句柄全部失效
+    for (const auto& handle : denseToHandle_) {
+        const uint32_t entityIndex = handle.GetIndex();
+        sparse_[entityIndex] = InvalidIndex;
+        generations_[entityIndex]++;
+        freeEntities_.push_back(entityIndex);
+    }
+
+    bounds_.clear();
+    worldMatrices_.clear();
+    materials_.clear();
+    geometry_.clear();
+    queueIDs_.clear();
+    flags_.clear();
+    cold_.clear();
+    denseToHandle_.clear();
+    ++changeVersion_;
+}
+
+// ============================================================================
+// 组件修改
+// ============================================================================
+
+void RenderableStorage::setTransform(RenderableHandle handle, const Matrix4& worldMatrix,
+                                     const Vector3& center, float radius) {
+    const uint32_t i = getDenseIndex(handle);
+    if (i == InvalidIndex) return;
+    worldMatrices_[i] = worldMatrix;
+    bounds_[i] = {center, radius};
+    ++changeVersion_;
+}
+
+void RenderableStorage::setMaterial(RenderableHandle handle, Material* material, uint64_t materialID) {
+    const uint32_t i = getDenseIndex(handle);
+    if (i == InvalidIndex) return;
+    materials_[i] = {material, materialID};
+    ++changeVersion_;
+}
+
+void RenderableStorage::setGeometry(RenderableHandle handle, void* geometryHandle, int subMeshIndex) {
+    const uint32_t i = getDenseIndex(handle);
+    if (i == InvalidIndex) return;
+    geometry_[i] = {geometryHandle, subMeshIndex};
+    ++changeVersion_;
+}
+
+void RenderableStorage::setQueueID(RenderableHandle handle, uint32_t queueID) {
+    const uint32_t i = getDenseIndex(handle);
+    if (i == InvalidIndex) return;
+    queueIDs_[i] = queueID;
+    ++changeVersion_;
+}
+
+void RenderableStorage::setFlags(RenderableHandle handle, uint32_t flags) {
+    const uint32_t i = getDenseIndex(handle);
+    if (i == InvalidIndex) return;
+    flags_[i] = flags;
+    ++changeVersion_;
+}
+
+// ============================================================================
+// RenderObject 构建
+// ============================================================================
+
+RenderObject RenderableStorage::makeRenderObject(uint32_t denseIndex,
+                                                 const Vector3& cameraPosition) const {
+    RenderObject obj;
+
+    const auto& cold = cold_[denseIndex];
+    obj.gameObject = cold.gameObject;
+    obj.name = cold.name;
+    obj.depthState = cold.depthState;
+    obj.stencilState = cold.stencilState;
+
+    obj.worldMatrix = worldMatrices_[denseIndex];
+    obj.center = bounds_[denseIndex].center;
+    obj.radius = bounds_[denseIndex].radius;
+
+    obj.material = materials_[denseIndex].material;
+    obj.materialID = materials_[denseIndex].materialID;
+
+    obj.geometryHandle = geometry_[denseIndex].geometryHandle;
+    obj.subMeshIndex = geometry_[denseIndex].subMeshIndex;
+
+    obj.queueID = queueIDs_[denseIndex];
+
+    const Vector3 delta = obj.center - cameraPosition;
+    obj.distanceToCamera = std::sqrt(glm::dot(delta, delta));
+
+    return obj;
+}
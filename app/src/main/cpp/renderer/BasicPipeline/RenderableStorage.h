@@ -0,0 +1,251 @@
+/**
+ * @file RenderableStorage.h
+ * @brief 可渲染组件存储 - 紧密排列的组件数组 + 稀疏集实体映射
+ *
+ * 功能:
+ * - 可渲染数据（包围体、材质、几何体、标志、队列ID）按类型分别连续存储
+ * - 稀疏集（Sparse Set）把实体句柄映射到紧密数组下标，增删均为 O(1)
+ * - 删除时与末尾元素交换，数组始终保持无空洞
+ * - RenderQueueBuilder 直接遍历连续内存，避免 shared_ptr<GameObject> 指针追逐
+ *   和逐对象的组件查找
+ */
+
+#pragma once
+
+#include "../MathTypes.h"
+#include "RenderHandle.h"
+#include "RenderQueue.h"
+#include "DepthState.h"
+#include "StencilState.h"
+#include "MemoryTracker.h"
+#include <vector>
+#include <cstdint>
+
+// 前向声明
+class GameObject;
+class Material;
+
+// ============================================================================
+// 句柄
+// ============================================================================
+
+struct RenderableTag {};
+
+/** 可渲染实体句柄（索引 + 世代） */
+using RenderableHandle = Handle<RenderableTag, uint32_t>;
+
+// ============================================================================
+// 组件数据
+// ============================================================================
+
+/**
+ * @brief 可渲染标志位
+ */
+namespace RenderableFlags {
+    enum : uint32_t {
+        /** 参与渲染 */
+        Visible = 1 << 0,
+
+        /** 投射阴影 */
+        CastShadows = 1 << 1,
+
+        /** 接收阴影 */
+        ReceiveShadows = 1 << 2,
+
+        /** 静态物体（不会移动，可参与烘焙） */
+        Static = 1 << 3,
+
+        /** 默认标志 */
+        Default = Visible | CastShadows | ReceiveShadows
+    };
+}
+
+/**
+ * @brief 世界空间包围球
+ *
+ * 16字节，剔除时按 SIMD 宽度连续读取
+ */
+struct RenderableBounds {
+    Vector3 center;
+    float radius = 0.0f;
+};
+
+/**
+ * @brief 材质组件
+ */
+struct RenderableMaterial {
+    Material* material = nullptr;
+    uint64_t materialID = 0;
+};
+
+/**
+ * @brief 几何体组件
+ */
+struct RenderableGeometry {
+    void* geometryHandle = nullptr;
+    int subMeshIndex = -1;
+};
+
+/**
+ * @brief 冷数据（构建RenderObject时才访问）
+ */
+struct RenderableColdData {
+    GameObject* gameObject = nullptr;
+    const char* name = "Unnamed";
+    DepthState depthState;
+    StencilState stencilState;
+};
+
+/**
+ * @brief 创建可渲染实体的描述
+ */
+struct RenderableDesc {
+    GameObject* gameObject = nullptr;
+    const char* name = "Unnamed";
+
+    Matrix4 worldMatrix = Matrix4(1.0f);
+    Vector3 center = Vector3(0.0f);
+    float radius = 0.0f;
+
+    Material* material = nullptr;
+    uint64_t materialID = 0;
+
+    void* geometryHandle = nullptr;
+    int subMeshIndex = -1;
+
+    uint32_t queueID = RenderQueueId::Opaque;
+    uint32_t flags = RenderableFlags::Default;
+
+    DepthState depthState;
+    StencilState stencilState;
+};
+
+// ============================================================================
+// 存储
+// ============================================================================
+
+/**
+ * @brief 可渲染组件存储
+ *
+ * 布局:
+ *
+ *   sparse_[entityIndex] ──→ denseIndex
+ *                               │
+ *   bounds_     [d0][d1][d2]...◄┘   (热数据，剔除)
+ *   queueIDs_   [d0][d1][d2]...     (热数据，分队列)
+ *   flags_      [d0][d1][d2]...
+ *   materials_  [d0][d1][d2]...     (排序键)
+ *   worldMatrices_ / geometry_ / cold_ ...
+ *
+ * 所有紧密数组下标一致，denseToHandle_ 用于反查实体
+ */
+class RenderableStorage {
+public:
+    static constexpr uint32_t InvalidIndex = ~0u;
+
+    RenderableStorage() = default;
+    ~RenderableStorage() = default;
+
+    // 禁止拷贝（数据量可能很大）
+    RenderableStorage(const RenderableStorage&) = delete;
+    RenderableStorage& operator=(const RenderableStorage&) = delete;
+
+    // ========================================================================
+    // 实体管理
+    // ========================================================================
+
+    /**
+     * @brief 创建可渲染实体
+     * @param desc 初始数据
+     * @return 实体句柄
+     */
+    RenderableHandle create(const RenderableDesc& desc);
+
+    /**
+     * @brief 销毁可渲染实体
+     *
+     * 与末尾元素交换后弹出，保持紧密数组连续
+     */
+    void destroy(RenderableHandle handle);
+
+    /**
+     * @brief 检查句柄是否有效
+     */
+    bool isValid(RenderableHandle handle) const;
+
+    /**
+     * @brief 预留容量
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief 清空所有实体
+     */
+    void clear();
+
+    /** @brief 获取实体数量 */
+    size_t size() const { return bounds_.size(); }
+
+    /** @brief 是否为空 */
+    bool empty() const { return bounds_.empty(); }
+
+    /**
+     * @brief 修改版本（任何创建、销毁、清空或组件修改后递增），用于检测场景是否变化
+     */
+    uint64_t getChangeVersion() const { return changeVersion_; }
+
+    // ========================================================================
+    // 组件修改
+    // ========================================================================
+
+    void setTransform(RenderableHandle handle, const Matrix4& worldMatrix,
+                      const Vector3& center, float radius);
+    void setMaterial(RenderableHandle handle, Material* material, uint64_t materialID);
+    void setGeometry(RenderableHandle handle, void* geometryHandle, int subMeshIndex);
+    void setQueueID(RenderableHandle handle, uint32_t queueID);
+    void setFlags(RenderableHandle handle, uint32_t flags);
+
+    /**
+     * @brief 获取实体在紧密数组中的下标
+     * @return 下标，如果句柄无效则返回 InvalidIndex
+     */
+    uint32_t getDenseIndex(RenderableHandle handle) const;
+
+    // ========================================================================
+    // 紧密数组访问（供批量遍历使用）
+    // ========================================================================
+
+    const RenderableBounds* getBounds() const { return bounds_.data(); }
+    const Matrix4* getWorldMatrices() const { return worldMatrices_.data(); }
+    const RenderableMaterial* getMaterials() const { return materials_.data(); }
+    const RenderableGeometry* getGeometry() const { return geometry_.data(); }
+    const uint32_t* getQueueIDs() const { return queueIDs_.data(); }
+    const uint32_t* getFlags() const { return flags_.data(); }
+    const RenderableColdData* getColdData() const { return cold_.data(); }
+    const RenderableHandle* getHandles() const { return denseToHandle_.data(); }
+
+    /**
+     * @brief 从紧密数组构建RenderObject
+     * @param denseIndex 紧密数组下标
+     * @param cameraPosition 相机位置（用于距离计算）
+     */
+    RenderObject makeRenderObject(uint32_t denseIndex, const Vector3& cameraPosition) const;
+
+private:
+    // 稀疏部分：实体索引 → 紧密下标
+    TaggedVector<uint32_t, MemoryTag::Scene> sparse_;
+    TaggedVector<uint32_t, MemoryTag::Scene> generations_;
+    TaggedVector<uint32_t, MemoryTag::Scene> freeEntities_;
+
+    // 紧密部分：按组件分别存储
+    TaggedVector<RenderableBounds, MemoryTag::Scene> bounds_;
+    TaggedVector<Matrix4, MemoryTag::Scene> worldMatrices_;
+    TaggedVector<RenderableMaterial, MemoryTag::Scene> materials_;
+    TaggedVector<RenderableGeometry, MemoryTag::Scene> geometry_;
+    TaggedVector<uint32_t, MemoryTag::Scene> queueIDs_;
+    TaggedVector<uint32_t, MemoryTag::Scene> flags_;
+    TaggedVector<RenderableColdData, MemoryTag::Scene> cold_;
+    TaggedVector<RenderableHandle, MemoryTag::Scene> denseToHandle_;
+
+    uint64_t changeVersion_ = 0;
+};
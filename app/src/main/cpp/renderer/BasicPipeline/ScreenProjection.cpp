@@ -0,0 +1,394 @@
+/**
+ * @file ScreenProjection.cpp
+ * @brief 屏幕空间投影实现
+ */
+
+#include "ScreenProjection.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRISMA_SCREEN_PROJECTION_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PRISMA_SCREEN_PROJECTION_NEON 1
+#endif
+
+namespace {
+
+// ============================================================================
+// 约定
+// ============================================================================
+
+#ifdef GLM_FORCE_DEPTH_ZERO_TO_ONE
+constexpr float kDepthScale = 1.0f;
+constexpr float kDepthBias = 0.0f;
+#else
+constexpr float kDepthScale = 0.5f;
+constexpr float kDepthBias = 0.5f;
+#endif
+
+/** 裁剪空间 w 的下限（避免除以0） */
+constexpr float kMinClipW = 1e-6f;
+
+/** 深度 → NDC z */
+constexpr float depthToNdc(float depth) {
+    return (depth - kDepthBias) / kDepthScale;
+}
+
+// ============================================================================
+// 标量内核（单点版本与批量尾部共用）
+// ============================================================================
+
+uint8_t projectScalar(const Matrix4& m, float x, float y, float z, float halfWidth, float halfHeight,
+                      float& outX, float& outY, float& outDepth) {
+    const float cx = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0];
+    const float cy = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1];
+    const float cz = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2];
+    const float cw = m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3];
+
+    const float safeW = std::fabs(cw) < kMinClipW ? kMinClipW : cw;
+    const float invW = 1.0f / safeW;
+    const float nx = cx * invW;
+    const float ny = cy * invW;
+    const float nz = cz * invW;
+
+    outX = nx * halfWidth + halfWidth;
+    outY = ny * halfHeight + halfHeight;
+    outDepth = nz * kDepthScale + kDepthBias;
+
+    uint8_t flags = ScreenPointFlags::None;
+    if (cw < kMinClipW) {
+        flags |= ScreenPointFlags::BehindCamera;
+    }
+    if (nx < -1.0f || nx > 1.0f || ny < -1.0f || ny > 1.0f) {
+        flags |= ScreenPointFlags::OffScreen;
+    }
+    if (outDepth < 0.0f || outDepth > 1.0f) {
+        flags |= ScreenPointFlags::DepthClipped;
+    }
+    return flags;
+}
+
+void unprojectScalar(const Matrix4& m, float nx, float ny, float nz, float& outX, float& outY, float& outZ) {
+    const float px = m[0][0] * nx + m[1][0] * ny + m[2][0] * nz + m[3][0];
+    const float py = m[0][1] * nx + m[1][1] * ny + m[2][1] * nz + m[3][1];
+    const float pz = m[0][2] * nx + m[1][2] * ny + m[2][2] * nz + m[3][2];
+    const float pw = m[0][3] * nx + m[1][3] * ny + m[2][3] * nz + m[3][3];
+
+    const float invW = 1.0f / pw;
+    outX = px * invW;
+    outY = py * invW;
+    outZ = pz * invW;
+}
+
+void rayScalar(const Matrix4& m, float nx, float ny, ScreenRay& ray) {
+    Vector3 farPoint;
+    unprojectScalar(m, nx, ny, depthToNdc(0.0f), ray.origin.x, ray.origin.y, ray.origin.z);
+    unprojectScalar(m, nx, ny, depthToNdc(1.0f), farPoint.x, farPoint.y, farPoint.z);
+
+    const float dx = farPoint.x - ray.origin.x;
+    const float dy = farPoint.y - ray.origin.y;
+    const float dz = farPoint.z - ray.origin.z;
+    const float invLength = 1.0f / std::sqrt(dx * dx + dy * dy + dz * dz);
+    ray.direction = Vector3(dx * invLength, dy * invLength, dz * invLength);
+}
+
+// ============================================================================
+// 4宽 SIMD 封装
+// ============================================================================
+
+#if defined(PRISMA_SCREEN_PROJECTION_SSE2)
+
+#define PRISMA_SCREEN_PROJECTION_SIMD 1
+
+using F4 = __m128;
+
+inline F4 load4(const float* p) { return _mm_loadu_ps(p); }
+inline void store4(float* p, F4 v) { _mm_storeu_ps(p, v); }
+inline F4 splat(float v) { return _mm_set1_ps(v); }
+inline F4 add(F4 a, F4 b) { return _mm_add_ps(a, b); }
+inline F4 sub(F4 a, F4 b) { return _mm_sub_ps(a, b); }
+inline F4 mul(F4 a, F4 b) { return _mm_mul_ps(a, b); }
+inline F4 div(F4 a, F4 b) { return _mm_div_ps(a, b); }
+inline F4 sqrt4(F4 v) { return _mm_sqrt_ps(v); }
+inline F4 abs4(F4 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+
+using M4 = __m128;
+
+inline M4 less(F4 a, F4 b) { return _mm_cmplt_ps(a, b); }
+inline M4 greater(F4 a, F4 b) { return _mm_cmpgt_ps(a, b); }
+inline M4 maskOr(M4 a, M4 b) { return _mm_or_ps(a, b); }
+inline F4 select(M4 mask, F4 a, F4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+/** 每个通道的位掩码（真为 bit，假为0） */
+inline void storeFlagBits(M4 behind, M4 offScreen, M4 depthClipped, uint32_t out[4]) {
+    const __m128i bits = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(_mm_castps_si128(behind), _mm_set1_epi32(ScreenPointFlags::BehindCamera)),
+                     _mm_and_si128(_mm_castps_si128(offScreen), _mm_set1_epi32(ScreenPointFlags::OffScreen))),
+        _mm_and_si128(_mm_castps_si128(depthClipped), _mm_set1_epi32(ScreenPointFlags::DepthClipped)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bits);
+}
+
+#elif defined(PRISMA_SCREEN_PROJECTION_NEON)
+
+#define PRISMA_SCREEN_PROJECTION_SIMD 1
+
+using F4 = float32x4_t;
+
+inline F4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, F4 v) { vst1q_f32(p, v); }
+inline F4 splat(float v) { return vdupq_n_f32(v); }
+inline F4 add(F4 a, F4 b) { return vaddq_f32(a, b); }
+inline F4 sub(F4 a, F4 b) { return vsubq_f32(a, b); }
+inline F4 mul(F4 a, F4 b) { return vmulq_f32(a, b); }
+inline F4 div(F4 a, F4 b) { return vdivq_f32(a, b); }
+inline F4 sqrt4(F4 v) { return vsqrtq_f32(v); }
+inline F4 abs4(F4 v) { return vabsq_f32(v); }
+
+using M4 = uint32x4_t;
+
+inline M4 less(F4 a, F4 b) { return vcltq_f32(a, b); }
+inline M4 greater(F4 a, F4 b) { return vcgtq_f32(a, b); }
+inline M4 maskOr(M4 a, M4 b) { return vorrq_u32(a, b); }
+inline F4 select(M4 mask, F4 a, F4 b) { return vbslq_f32(mask, a, b); }
+
+inline void storeFlagBits(M4 behind, M4 offScreen, M4 depthClipped, uint32_t out[4]) {
+    const uint32x4_t bits = vorrq_u32(
+        vorrq_u32(vandq_u32(behind, vdupq_n_u32(ScreenPointFlags::BehindCamera)),
+                  vandq_u32(offScreen, vdupq_n_u32(ScreenPointFlags::OffScreen))),
+        vandq_u32(depthClipped, vdupq_n_u32(ScreenPointFlags::DepthClipped)));
+    vst1q_u32(out, bits);
+}
+
+#endif
+
+#ifdef PRISMA_SCREEN_PROJECTION_SIMD
+
+/** 按列展开的 4x4 矩阵，每个元素广播到4个通道 */
+struct SplatMatrix {
+    F4 m[4][4];
+
+    explicit SplatMatrix(const Matrix4& matrix) {
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 4; ++row) {
+                m[col][row] = splat(matrix[col][row]);
+            }
+        }
+    }
+
+    /** 第 row 行与 (x, y, z, 1) 的点积，运算顺序与标量内核一致 */
+    F4 transformRow(int row, F4 x, F4 y, F4 z) const {
+        return add(add(add(mul(m[0][row], x), mul(m[1][row], y)), mul(m[2][row], z)), m[3][row]);
+    }
+};
+
+#endif
+
+} // namespace
+
+// ============================================================================
+// 单点
+// ============================================================================
+
+Vector3 WorldToScreenPoint(const Matrix4& viewProjection, const Vector3& worldPoint,
+                           uint32_t screenWidth, uint32_t screenHeight, uint8_t* flags) {
+    Vector3 result;
+    const uint8_t pointFlags = projectScalar(viewProjection, worldPoint.x, worldPoint.y, worldPoint.z,
+                                             0.5f * static_cast<float>(screenWidth),
+                                             0.5f * static_cast<float>(screenHeight),
+                                             result.x, result.y, result.z);
+    if (flags) {
+        *flags = pointFlags;
+    }
+    return result;
+}
+
+Vector3 ScreenToWorldPoint(const Matrix4& invViewProjection, const Vector2& screenPoint, float depth,
+                           uint32_t screenWidth, uint32_t screenHeight) {
+    const float scaleX = 2.0f / static_cast<float>(screenWidth);
+    const float scaleY = 2.0f / static_cast<float>(screenHeight);
+
+    Vector3 result;
+    unprojectScalar(invViewProjection, screenPoint.x * scaleX - 1.0f, screenPoint.y * scaleY - 1.0f,
+                    depthToNdc(depth), result.x, result.y, result.z);
+    return result;
+}
+
+ScreenRay ScreenPointToRay(const Matrix4& invViewProjection, const Vector2& screenPoint,
+                           uint32_t screenWidth, uint32_t screenHeight) {
+    const float scaleX = 2.0f / static_cast<float>(screenWidth);
+    const float scaleY = 2.0f / static_cast<float>(screenHeight);
+
+    ScreenRay ray;
+    rayScalar(invViewProjection, screenPoint.x * scaleX - 1.0f, screenPoint.y * scaleY - 1.0f, ray);
+    return ray;
+}
+
+// ============================================================================
+// 批量
+// ============================================================================
+
+uint32_t WorldToScreenPoints(const Matrix4& viewProjection, ConstPointsSoA world, uint32_t count,
+                             uint32_t screenWidth, uint32_t screenHeight,
+                             PointsSoA screen, uint8_t* flags) {
+    const float halfWidth = 0.5f * static_cast<float>(screenWidth);
+    const float halfHeight = 0.5f * static_cast<float>(screenHeight);
+
+    uint32_t visible = 0;
+    uint32_t i = 0;
+
+#ifdef PRISMA_SCREEN_PROJECTION_SIMD
+    const SplatMatrix m(viewProjection);
+    const F4 one = splat(1.0f);
+    const F4 minusOne = splat(-1.0f);
+    const F4 zero = splat(0.0f);
+    const F4 minW = splat(kMinClipW);
+    const F4 halfW = splat(halfWidth);
+    const F4 halfH = splat(halfHeight);
+    const F4 depthScale = splat(kDepthScale);
+    const F4 depthBias = splat(kDepthBias);
+
+    for (; i + 4 <= count; i += 4) {
+        const F4 x = load4(world.x + i);
+        const F4 y = load4(world.y + i);
+        const F4 z = load4(world.z + i);
+
+        const F4 cx = m.transformRow(0, x, y, z);
+        const F4 cy = m.transformRow(1, x, y, z);
+        const F4 cz = m.transformRow(2, x, y, z);
+        const F4 cw = m.transformRow(3, x, y, z);
+
+        const F4 safeW = select(less(abs4(cw), minW), minW, cw);
+        const F4 invW = div(one, safeW);
+        const F4 nx = mul(cx, invW);
+        const F4 ny = mul(cy, invW);
+        const F4 nz = mul(cz, invW);
+
+        const F4 sx = add(mul(nx, halfW), halfW);
+        const F4 sy = add(mul(ny, halfH), halfH);
+        const F4 depth = add(mul(nz, depthScale), depthBias);
+
+        store4(screen.x + i, sx);
+        store4(screen.y + i, sy);
+        store4(screen.z + i, depth);
+
+        const M4 behind = less(cw, minW);
+        const M4 offScreen = maskOr(maskOr(less(nx, minusOne), greater(nx, one)),
+                                    maskOr(less(ny, minusOne), greater(ny, one)));
+        const M4 depthClipped = maskOr(less(depth, zero), greater(depth, one));
+
+        uint32_t bits[4];
+        storeFlagBits(behind, offScreen, depthClipped, bits);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible += bits[lane] == 0;
+            if (flags) {
+                flags[i + lane] = static_cast<uint8_t>(bits[lane]);
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const uint8_t pointFlags = projectScalar(viewProjection, world.x[i], world.y[i], world.z[i],
+                                                 halfWidth, halfHeight,
+                                                 screen.x[i], screen.y[i], screen.z[i]);
+        visible += pointFlags == ScreenPointFlags::None;
+        if (flags) {
+            flags[i] = pointFlags;
+        }
+    }
+
+    return visible;
+}
+
+void ScreenToWorldPoints(const Matrix4& invViewProjection, ConstPointsSoA screen, uint32_t count,
+                         uint32_t screenWidth, uint32_t screenHeight, PointsSoA world) {
+    const float scaleX = 2.0f / static_cast<float>(screenWidth);
+    const float scaleY = 2.0f / static_cast<float>(screenHeight);
+
+    uint32_t i = 0;
+
+#ifdef PRISMA_SCREEN_PROJECTION_SIMD
+    const SplatMatrix m(invViewProjection);
+    const F4 one = splat(1.0f);
+    const F4 sx = splat(scaleX);
+    const F4 sy = splat(scaleY);
+    const F4 depthBias = splat(kDepthBias);
+    const F4 depthScale = splat(kDepthScale);
+
+    for (; i + 4 <= count; i += 4) {
+        const F4 nx = sub(mul(load4(screen.x + i), sx), one);
+        const F4 ny = sub(mul(load4(screen.y + i), sy), one);
+        const F4 nz = div(sub(load4(screen.z + i), depthBias), depthScale);
+
+        const F4 invW = div(one, m.transformRow(3, nx, ny, nz));
+        const F4 px = mul(m.transformRow(0, nx, ny, nz), invW);
+        const F4 py = mul(m.transformRow(1, nx, ny, nz), invW);
+        const F4 pz = mul(m.transformRow(2, nx, ny, nz), invW);
+
+        store4(world.x + i, px);
+        store4(world.y + i, py);
+        store4(world.z + i, pz);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        unprojectScalar(invViewProjection, screen.x[i] * scaleX - 1.0f, screen.y[i] * scaleY - 1.0f,
+                        depthToNdc(screen.z[i]), world.x[i], world.y[i], world.z[i]);
+    }
+}
+
+void ScreenPointsToRays(const Matrix4& invViewProjection, const float* screenX, const float* screenY,
+                        uint32_t count, uint32_t screenWidth, uint32_t screenHeight,
+                        PointsSoA origins, PointsSoA directions) {
+    const float scaleX = 2.0f / static_cast<float>(screenWidth);
+    const float scaleY = 2.0f / static_cast<float>(screenHeight);
+
+    uint32_t i = 0;
+
+#ifdef PRISMA_SCREEN_PROJECTION_SIMD
+    const SplatMatrix m(invViewProjection);
+    const F4 one = splat(1.0f);
+    const F4 sx = splat(scaleX);
+    const F4 sy = splat(scaleY);
+    const F4 nearZ = splat(depthToNdc(0.0f));
+    const F4 farZ = splat(depthToNdc(1.0f));
+
+    for (; i + 4 <= count; i += 4) {
+        const F4 nx = sub(mul(load4(screenX + i), sx), one);
+        const F4 ny = sub(mul(load4(screenY + i), sy), one);
+
+        const F4 invNearW = div(one, m.transformRow(3, nx, ny, nearZ));
+        const F4 ox = mul(m.transformRow(0, nx, ny, nearZ), invNearW);
+        const F4 oy = mul(m.transformRow(1, nx, ny, nearZ), invNearW);
+        const F4 oz = mul(m.transformRow(2, nx, ny, nearZ), invNearW);
+
+        const F4 invFarW = div(one, m.transformRow(3, nx, ny, farZ));
+        const F4 dx = sub(mul(m.transformRow(0, nx, ny, farZ), invFarW), ox);
+        const F4 dy = sub(mul(m.transformRow(1, nx, ny, farZ), invFarW), oy);
+        const F4 dz = sub(mul(m.transformRow(2, nx, ny, farZ), invFarW), oz);
+
+        const F4 invLength = div(one, sqrt4(add(add(mul(dx, dx), mul(dy, dy)), mul(dz, dz))));
+
+        store4(origins.x + i, ox);
+        store4(origins.y + i, oy);
+        store4(origins.z + i, oz);
+        store4(directions.x + i, mul(dx, invLength));
+        store4(directions.y + i, mul(dy, invLength));
+        store4(directions.z + i, mul(dz, invLength));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        ScreenRay ray;
+        rayScalar(invViewProjection, screenX[i] * scaleX - 1.0f, screenY[i] * scaleY - 1.0f, ray);
+        origins.x[i] = ray.origin.x;
+        origins.y[i] = ray.origin.y;
+        origins.z[i] = ray.origin.z;
+        directions.x[i] = ray.direction.x;
+        directions.y[i] = ray.direction.y;
+        directions.z[i] = ray.direction.z;
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file ScreenProjection.h
+ * @brief 世界空间与屏幕空间之间的点投影、反投影和拾取射线（单点与 SoA 批量版本）
+ *
+ * Camera::worldToScreenPoint / screenToWorldPoint / screenPointToRay 的约定在这里定义:
+ * - 屏幕坐标以像素为单位，原点在左下角（与NDC同向，y向上）
+ * - 深度 0 为近平面，1 为远平面（GL 裁剪空间 z 映射到 [0, 1]；
+ *   定义 GLM_FORCE_DEPTH_ZERO_TO_ONE 时直接使用裁剪空间 z）
+ * - 射线原点在近平面上，方向指向远平面上的对应点（单位长度）
+ *
+ * 批量版本一次处理 SoA 数组（x、y、z 各自连续），每4个点用一组 SSE2/NEON 指令，
+ * 尾部与不支持的平台走标量路径。批量与单点版本的运算顺序一致，
+ * 结果在没有 FMA 合并的平台上逐位相同
+ *
+ * 只依赖矩阵，可以在工作线程中配合 CameraSnapshot 使用:
+ * @code
+ *
+ * WorldToScreenPoints(snapshot.unjittered.viewProjection, world, count,
+ *                     snapshot.width, snapshot.height, screen, flags);
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "../../MathTypes.h"
+#include <cstdint>
+
+// ============================================================================
+// 类型
+// ============================================================================
+
+/**
+ * @brief 投影结果标志
+ */
+namespace ScreenPointFlags {
+    enum : uint8_t {
+        None = 0,
+
+        /** 点在相机平面之后（裁剪空间 w <= 0），屏幕坐标为镜像结果，不应直接使用 */
+        BehindCamera = 1 << 0,
+
+        /** 点在视口矩形之外 */
+        OffScreen = 1 << 1,
+
+        /** 深度在 [0, 1] 之外（近平面之前或远平面之后） */
+        DepthClipped = 1 << 2,
+    };
+}
+
+/**
+ * @brief 射线（原点和单位方向）
+ */
+struct ScreenRay {
+    Vector3 origin;
+    Vector3 direction;
+};
+
+/**
+ * @brief 可写的 SoA 点数组（不拥有内存）
+ */
+struct PointsSoA {
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+};
+
+/**
+ * @brief 只读的 SoA 点数组（不拥有内存）
+ */
+struct ConstPointsSoA {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+
+    ConstPointsSoA() = default;
+    ConstPointsSoA(const float* px, const float* py, const float* pz) : x(px), y(py), z(pz) {}
+    ConstPointsSoA(const PointsSoA& points) : x(points.x), y(points.y), z(points.z) {}
+};
+
+// ============================================================================
+// 单点
+// ============================================================================
+
+/**
+ * @brief 世界空间点 → 屏幕空间（像素，z为深度0-1）
+ * @param flags 可选，输出 ScreenPointFlags
+ */
+Vector3 WorldToScreenPoint(const Matrix4& viewProjection, const Vector3& worldPoint,
+                           uint32_t screenWidth, uint32_t screenHeight, uint8_t* flags = nullptr);
+
+/**
+ * @brief 屏幕空间点 + 深度 → 世界空间
+ */
+Vector3 ScreenToWorldPoint(const Matrix4& invViewProjection, const Vector2& screenPoint, float depth,
+                           uint32_t screenWidth, uint32_t screenHeight);
+
+/**
+ * @brief 从屏幕位置发射射线
+ */
+ScreenRay ScreenPointToRay(const Matrix4& invViewProjection, const Vector2& screenPoint,
+                           uint32_t screenWidth, uint32_t screenHeight);
+
+// ============================================================================
+// 批量（SoA）
+// ============================================================================
+
+/**
+ * @brief 批量投影世界空间点
+ *
+ * @param world  输入点
+ * @param screen 输出: x/y 为像素坐标，z 为深度（可与输入数组相同）
+ * @param flags  输出每个点的 ScreenPointFlags（可为 nullptr）
+ * @return 标志为 None 的点数（在屏幕内且未被深度裁剪）
+ */
+uint32_t WorldToScreenPoints(const Matrix4& viewProjection, ConstPointsSoA world, uint32_t count,
+                             uint32_t screenWidth, uint32_t screenHeight,
+                             PointsSoA screen, uint8_t* flags);
+
+/**
+ * @brief 批量反投影屏幕空间点
+ *
+ * @param screen 输入: x/y 为像素坐标，z 为深度（0-1）
+ * @param world  输出世界空间点（可与输入数组相同）
+ */
+void ScreenToWorldPoints(const Matrix4& invViewProjection, ConstPointsSoA screen, uint32_t count,
+                         uint32_t screenWidth, uint32_t screenHeight, PointsSoA world);
+
+/**
+ * @brief 批量生成拾取射线
+ *
+ * @param screenX/screenY 输入像素坐标
+ * @param origins    输出射线原点（近平面）
+ * @param directions 输出单位方向
+ */
+void ScreenPointsToRays(const Matrix4& invViewProjection, const float* screenX, const float* screenY,
+                        uint32_t count, uint32_t screenWidth, uint32_t screenHeight,
+                        PointsSoA origins, PointsSoA directions);
@@ -0,0 +1,326 @@
+/**
+ * @file SecondaryCameraScheduler.cpp
+ * @brief 次级相机调度实现
+ */
+
+#include "SecondaryCameraScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr const char* CameraUpdatePolicyNames[] = {
+    "EveryFrame",
+    "Interval",
+    "OnChange",
+    "Amortized",
+};
+
+/** 条带从未渲染 */
+constexpr uint64_t NeverRendered = ~0ull;
+
+/** 开销滑动平均的权重 */
+constexpr float kCostSmoothing = 0.25f;
+
+bool matricesDiffer(const Matrix4& a, const Matrix4& b, float threshold) {
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            if (std::fabs(a[col][row] - b[col][row]) > threshold) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+const char* GetCameraUpdatePolicyName(CameraUpdatePolicy policy) {
+    const size_t index = static_cast<size_t>(policy);
+    return index < sizeof(CameraUpdatePolicyNames) / sizeof(CameraUpdatePolicyNames[0])
+        ? CameraUpdatePolicyNames[index] : "Unknown";
+}
+
+Matrix4 CropProjection(const Matrix4& projection, const Vector4& viewportRect) {
+    const float width = std::max(viewportRect.z, 1e-6f);
+    const float height = std::max(viewportRect.w, 1e-6f);
+
+    // 把 NDC 子区域 [2x-1, 2(x+w)-1] 映射到 [-1, 1]（在裁剪空间中变换，对透视同样成立）
+    Matrix4 crop(1.0f);
+    crop[0][0] = 1.0f / width;
+    crop[1][1] = 1.0f / height;
+    crop[3][0] = -(2.0f * viewportRect.x + width - 1.0f) / width;
+    crop[3][1] = -(2.0f * viewportRect.y + height - 1.0f) / height;
+    return crop * projection;
+}
+
+// ============================================================================
+// 相机管理
+// ============================================================================
+
+SecondaryCameraHandle SecondaryCameraScheduler::addCamera(const SecondaryCameraDesc& desc) {
+    uint32_t index;
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    CameraSlot& slot = slots_[index];
+    const uint32_t generation = slot.generation;
+    slot = CameraSlot();
+    slot.generation = generation;
+    slot.alive = true;
+    slot.desc = desc;
+    slot.desc.interval = std::max(desc.interval, 1u);
+    slot.stats.name = desc.name;
+    slot.stats.policy = desc.policy;
+
+    const uint32_t slices = desc.policy == CameraUpdatePolicy::Amortized ? slot.desc.interval : 1;
+    slot.sliceFrames.assign(slices, NeverRendered);
+
+    ++liveCount_;
+    return SecondaryCameraHandle(index, generation);
+}
+
+void SecondaryCameraScheduler::removeCamera(SecondaryCameraHandle camera) {
+    CameraSlot* slot = getSlot(camera);
+    if (!slot) {
+        return;
+    }
+    slot->alive = false;
+    ++slot->generation;
+    freeSlots_.push_back(camera.GetIndex());
+    --liveCount_;
+}
+
+bool SecondaryCameraScheduler::isValid(SecondaryCameraHandle camera) const {
+    return getSlot(camera) != nullptr;
+}
+
+void SecondaryCameraScheduler::setEnabled(SecondaryCameraHandle camera, bool enabled) {
+    if (CameraSlot* slot = getSlot(camera)) {
+        slot->enabled = enabled;
+    }
+}
+
+void SecondaryCameraScheduler::setView(SecondaryCameraHandle camera, const Matrix4& viewProjection) {
+    if (CameraSlot* slot = getSlot(camera)) {
+        slot->viewProjection = viewProjection;
+    }
+}
+
+void SecondaryCameraScheduler::markDirty(SecondaryCameraHandle camera) {
+    if (CameraSlot* slot = getSlot(camera)) {
+        slot->dirty = true;
+    }
+}
+
+SecondaryCameraScheduler::CameraSlot* SecondaryCameraScheduler::getSlot(SecondaryCameraHandle camera) {
+    return const_cast<CameraSlot*>(static_cast<const SecondaryCameraScheduler*>(this)->getSlot(camera));
+}
+
+const SecondaryCameraScheduler::CameraSlot* SecondaryCameraScheduler::getSlot(SecondaryCameraHandle camera) const {
+    const uint32_t index = camera.GetIndex();
+    if (index >= slots_.size()) {
+        return nullptr;
+    }
+    const CameraSlot& slot = slots_[index];
+    return slot.alive && slot.generation == camera.GetGeneration() ? &slot : nullptr;
+}
+
+const SecondaryCameraStats* SecondaryCameraScheduler::getStats(SecondaryCameraHandle camera) const {
+    const CameraSlot* slot = getSlot(camera);
+    return slot ? &slot->stats : nullptr;
+}
+
+// ============================================================================
+// 调度
+// ============================================================================
+
+bool SecondaryCameraScheduler::isDue(const CameraSlot& slot, uint64_t frameNumber) const {
+    const uint64_t oldest = *std::min_element(slot.sliceFrames.begin(), slot.sliceFrames.end());
+    if (oldest == NeverRendered) {
+        return true;
+    }
+
+    const SecondaryCameraDesc& desc = slot.desc;
+    if (desc.maxStaleFrames > 0 && frameNumber - oldest >= desc.maxStaleFrames) {
+        return true;
+    }
+
+    switch (desc.policy) {
+        case CameraUpdatePolicy::EveryFrame:
+        case CameraUpdatePolicy::Amortized:
+            return true;
+
+        case CameraUpdatePolicy::Interval:
+            return frameNumber - oldest >= desc.interval;
+
+        case CameraUpdatePolicy::OnChange:
+            return slot.dirty || matricesDiffer(slot.viewProjection, slot.renderedViewProjection,
+                                                desc.changeThreshold);
+    }
+    return false;
+}
+
+void SecondaryCameraScheduler::markUpdated(CameraSlot& slot, uint32_t index, uint64_t frameNumber) {
+    SecondaryCameraUpdate update;
+    update.camera = SecondaryCameraHandle(index, slot.generation);
+
+    if (slot.desc.policy == CameraUpdatePolicy::Amortized) {
+        const uint32_t slices = static_cast<uint32_t>(slot.sliceFrames.size());
+        const float height = 1.0f / static_cast<float>(slices);
+        update.slice = slot.nextSlice;
+        update.sliceCount = slices;
+        update.viewportRect = Vector4(0.0f, static_cast<float>(update.slice) * height, 1.0f, height);
+        slot.sliceFrames[update.slice] = frameNumber;
+        slot.nextSlice = (slot.nextSlice + 1) % slices;
+    } else {
+        slot.sliceFrames[0] = frameNumber;
+    }
+
+    slot.renderedViewProjection = slot.viewProjection;
+    slot.dirty = false;
+    slot.dueSince = NotDue;
+    ++slot.stats.updates;
+    slot.stats.lastUpdateFrame = frameNumber;
+
+    updates_.push_back(update);
+}
+
+const TaggedVector<SecondaryCameraUpdate, MemoryTag::Features>& SecondaryCameraScheduler::schedule(uint64_t frameNumber) {
+    updates_.clear();
+    candidates_.clear();
+    frameStats_ = SecondaryCameraFrameStats();
+    frameStats_.cameras = liveCount_;
+
+    auto estimateCost = [](const CameraSlot& slot) {
+        return slot.stats.updates > 0 && slot.stats.averageCostMs > 0.0f
+            ? slot.stats.averageCostMs : slot.desc.estimatedCostMs;
+    };
+
+    // 1. 找出到期的相机；EveryFrame 直接更新
+    float cost = 0.0f;
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+        CameraSlot& slot = slots_[i];
+        if (!slot.alive || !slot.enabled) {
+            continue;
+        }
+        if (!isDue(slot, frameNumber)) {
+            slot.dueSince = NotDue;
+            continue;
+        }
+        if (slot.dueSince == NotDue) {
+            slot.dueSince = frameNumber;
+        }
+
+        if (slot.desc.policy == CameraUpdatePolicy::EveryFrame) {
+            cost += estimateCost(slot);
+            markUpdated(slot, i, frameNumber);
+        } else {
+            candidates_.push_back(i);
+        }
+    }
+
+    // 2. 等待最久的优先（从未渲染的最先），其次是陈旧度
+    std::sort(candidates_.begin(), candidates_.end(), [this](uint32_t a, uint32_t b) {
+        const CameraSlot& sa = slots_[a];
+        const CameraSlot& sb = slots_[b];
+        const uint64_t oldestA = *std::min_element(sa.sliceFrames.begin(), sa.sliceFrames.end());
+        const uint64_t oldestB = *std::min_element(sb.sliceFrames.begin(), sb.sliceFrames.end());
+        if ((oldestA == NeverRendered) != (oldestB == NeverRendered)) {
+            return oldestA == NeverRendered;
+        }
+        if (sa.dueSince != sb.dueSince) {
+            return sa.dueSince < sb.dueSince;
+        }
+        if (oldestA != oldestB) {
+            return oldestA < oldestB;
+        }
+        return a < b;
+    });
+
+    // 3. 按预算挑选，至少执行一个
+    uint32_t selected = 0;
+    for (uint32_t index : candidates_) {
+        CameraSlot& slot = slots_[index];
+        const float estimate = estimateCost(slot);
+        const bool withinBudget = selected < budget_.maxUpdatesPerFrame &&
+                                  cost + estimate <= budget_.maxCostMsPerFrame;
+
+        if (selected == 0 || withinBudget) {
+            cost += estimate;
+            ++selected;
+            markUpdated(slot, index, frameNumber);
+        } else {
+            ++slot.stats.deferred;
+            ++frameStats_.deferred;
+        }
+    }
+
+    // 4. 陈旧度
+    for (CameraSlot& slot : slots_) {
+        if (!slot.alive) {
+            continue;
+        }
+        const uint64_t oldest = *std::min_element(slot.sliceFrames.begin(), slot.sliceFrames.end());
+        if (oldest == NeverRendered) {
+            slot.stats.staleness = UINT32_MAX;
+            continue;
+        }
+        slot.stats.staleness = static_cast<uint32_t>(std::min<uint64_t>(frameNumber - oldest, UINT32_MAX - 1));
+        slot.stats.maxStaleness = std::max(slot.stats.maxStaleness, slot.stats.staleness);
+        if (slot.enabled) {
+            frameStats_.maxStaleness = std::max(frameStats_.maxStaleness, slot.stats.staleness);
+        }
+    }
+
+    frameStats_.updates = static_cast<uint32_t>(updates_.size());
+    frameStats_.scheduledCostMs = cost;
+    return updates_;
+}
+
+void SecondaryCameraScheduler::reportCost(SecondaryCameraHandle camera, float costMs) {
+    CameraSlot* slot = getSlot(camera);
+    if (!slot) {
+        return;
+    }
+    SecondaryCameraStats& stats = slot->stats;
+    stats.lastCostMs = costMs;
+    stats.averageCostMs = stats.averageCostMs > 0.0f
+        ? stats.averageCostMs + (costMs - stats.averageCostMs) * kCostSmoothing
+        : costMs;
+}
+
+// ============================================================================
+// 报告
+// ============================================================================
+
+void SecondaryCameraScheduler::writeReport(FILE* out) const {
+    std::fprintf(out, "%-20s %-11s %8s %10s %10s %10s %10s %10s\n",
+                 "camera", "policy", "interval", "updates", "deferred", "avg(ms)", "stale", "maxStale");
+
+    for (const CameraSlot& slot : slots_) {
+        if (!slot.alive) {
+            continue;
+        }
+        const SecondaryCameraStats& stats = slot.stats;
+        char stale[16];
+        if (stats.staleness == UINT32_MAX) {
+            std::snprintf(stale, sizeof(stale), "never");
+        } else {
+            std::snprintf(stale, sizeof(stale), "%u", stats.staleness);
+        }
+
+        std::fprintf(out, "%-20s %-11s %8u %10llu %10llu %10.3f %10s %10u%s\n",
+                     stats.name, GetCameraUpdatePolicyName(stats.policy), slot.desc.interval,
+                     static_cast<unsigned long long>(stats.updates),
+                     static_cast<unsigned long long>(stats.deferred),
+                     stats.averageCostMs, stale, stats.maxStaleness,
+                     slot.enabled ? "" : " (disabled)");
+    }
+}
@@ -0,0 +1,243 @@
+/**
+ * @file SecondaryCameraScheduler.h
+ * @brief 次级相机（渲染到纹理）的降频更新与跨帧调度
+ *
+ * 小地图、监控屏幕、镜子等次级相机的内容通常变化缓慢，逐帧全量渲染是浪费。
+ * 每个次级相机选择一种更新策略，渲染结果缓存在它的目标纹理中，未更新的帧直接复用:
+ * - EveryFrame: 每帧更新（不受预算限制）
+ * - Interval:   每 N 帧更新一次
+ * - OnChange:   视图矩阵变化或调用 markDirty() 后更新（可设置最大陈旧帧数强制刷新）
+ * - Amortized:  视图分成 N 个水平条带，每帧只渲染一条，N 帧完成一次完整刷新
+ *
+ * 调度器按每帧预算（更新次数、估算毫秒）挑选到期的相机，按等待时间优先，
+ * 超出预算的相机推迟到后续帧，因此多个相机不会挤在同一帧更新。
+ * 每个相机的开销（reportCost 反馈的滑动平均）和陈旧度（缓存内容最旧部分的帧龄）
+ * 写入 SecondaryCameraStats，帧汇总写入 RenderStats
+ *
+ * 用法:
+ * @code
+ *
+ * SecondaryCameraDesc desc;
+ * desc.name = "Minimap";
+ * desc.policy = CameraUpdatePolicy::Interval;
+ * desc.interval = 4;
+ * SecondaryCameraHandle minimap = scheduler.addCamera(desc);
+ *
+ * // 每帧
+ * scheduler.setView(minimap, minimapViewProjection);
+ * for (const SecondaryCameraUpdate& update : scheduler.schedule(frameNumber)) {
+ *     // 只渲染 update.viewportRect 区域，投影用 CropProjection 裁剪以缩小剔除范围
+ *     ...
+ *     scheduler.reportCost(update.camera, measuredMs);
+ * }
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "RenderHandle.h"
+#include "MemoryTracker.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// ============================================================================
+// 类型
+// ============================================================================
+
+struct SecondaryCameraTag {};
+
+/** 次级相机句柄（索引 + 世代） */
+using SecondaryCameraHandle = Handle<SecondaryCameraTag, uint32_t>;
+
+/**
+ * @brief 更新策略
+ */
+enum class CameraUpdatePolicy : uint32_t {
+    EveryFrame,
+    Interval,
+    OnChange,
+    Amortized
+};
+
+const char* GetCameraUpdatePolicyName(CameraUpdatePolicy policy);
+
+/**
+ * @brief 次级相机描述
+ */
+struct SecondaryCameraDesc {
+    const char* name = "SecondaryCamera";
+
+    CameraUpdatePolicy policy = CameraUpdatePolicy::Interval;
+
+    /** Interval: 更新间隔（帧）；Amortized: 条带数 */
+    uint32_t interval = 4;
+
+    /** OnChange: 视图-投影矩阵任一元素变化超过该值时视为改变 */
+    float changeThreshold = 1e-4f;
+
+    /** 陈旧度达到该帧数时强制更新（0 表示不限制） */
+    uint32_t maxStaleFrames = 0;
+
+    /** 初始估算开销（毫秒，每次更新），之后由 reportCost 修正 */
+    float estimatedCostMs = 1.0f;
+};
+
+/**
+ * @brief 本帧需要执行的一次更新
+ */
+struct SecondaryCameraUpdate {
+    SecondaryCameraHandle camera;
+
+    /** 需要渲染的区域（归一化视口 x, y, width, height，原点在左下角） */
+    Vector4 viewportRect = Vector4(0.0f, 0.0f, 1.0f, 1.0f);
+
+    /** 分摊更新的条带编号与条带数（非分摊时为 0 / 1） */
+    uint32_t slice = 0;
+    uint32_t sliceCount = 1;
+};
+
+/**
+ * @brief 单个次级相机的统计
+ */
+struct SecondaryCameraStats {
+    const char* name = "";
+    CameraUpdatePolicy policy = CameraUpdatePolicy::Interval;
+
+    /** 执行的更新次数（分摊相机按条带计） */
+    uint64_t updates = 0;
+
+    /** 到期但因预算推迟的次数 */
+    uint64_t deferred = 0;
+
+    /** 最近一次更新的帧号 */
+    uint64_t lastUpdateFrame = 0;
+
+    /** 缓存内容最旧部分的帧龄（从未渲染时为 UINT32_MAX） */
+    uint32_t staleness = UINT32_MAX;
+    uint32_t maxStaleness = 0;
+
+    /** 每次更新的开销（毫秒，指数滑动平均）与最近一次 */
+    float averageCostMs = 0.0f;
+    float lastCostMs = 0.0f;
+};
+
+/**
+ * @brief 一帧的调度汇总
+ */
+struct SecondaryCameraFrameStats {
+    uint32_t cameras = 0;
+    uint32_t updates = 0;
+    uint32_t deferred = 0;
+
+    /** 本帧调度的估算开销（毫秒） */
+    float scheduledCostMs = 0.0f;
+
+    /** 所有已渲染过的相机中最大的陈旧度（帧） */
+    uint32_t maxStaleness = 0;
+};
+
+/**
+ * @brief 每帧预算（EveryFrame 相机不受限制，但计入开销）
+ *
+ * 预算不足时仍至少执行一个到期更新，保证每个相机最终都会被更新
+ */
+struct SecondaryCameraBudget {
+    uint32_t maxUpdatesPerFrame = 1;
+    float maxCostMsPerFrame = 2.0f;
+};
+
+/**
+ * @brief 把投影矩阵裁剪到视口子区域（离轴投影）
+ *
+ * 子区域映射到完整的 NDC 范围，剔除只保留该区域内的对象
+ */
+Matrix4 CropProjection(const Matrix4& projection, const Vector4& viewportRect);
+
+// ============================================================================
+// 调度器
+// ============================================================================
+
+/**
+ * @brief 次级相机调度器
+ */
+class SecondaryCameraScheduler {
+public:
+    SecondaryCameraHandle addCamera(const SecondaryCameraDesc& desc);
+    void removeCamera(SecondaryCameraHandle camera);
+    bool isValid(SecondaryCameraHandle camera) const;
+
+    /** 禁用的相机不参与调度（例如不在屏幕上的监控画面） */
+    void setEnabled(SecondaryCameraHandle camera, bool enabled);
+
+    /** 更新相机的视图-投影矩阵（OnChange 策略据此判断变化） */
+    void setView(SecondaryCameraHandle camera, const Matrix4& viewProjection);
+
+    /** 标记内容已改变（场景中相关对象移动等） */
+    void markDirty(SecondaryCameraHandle camera);
+
+    void setBudget(const SecondaryCameraBudget& budget) { budget_ = budget; }
+    const SecondaryCameraBudget& getBudget() const { return budget_; }
+
+    /**
+     * @brief 挑选本帧要执行的更新
+     *
+     * 返回的更新视为已执行（缓存内容的帧号随之更新），调用者应在本帧完成渲染
+     * @param frameNumber 单调递增的帧号
+     */
+    const TaggedVector<SecondaryCameraUpdate, MemoryTag::Features>& schedule(uint64_t frameNumber);
+
+    /**
+     * @brief 反馈一次更新的实际开销（毫秒）
+     */
+    void reportCost(SecondaryCameraHandle camera, float costMs);
+
+    const SecondaryCameraStats* getStats(SecondaryCameraHandle camera) const;
+    const SecondaryCameraFrameStats& getFrameStats() const { return frameStats_; }
+    const TaggedVector<SecondaryCameraUpdate, MemoryTag::Features>& getUpdates() const { return updates_; }
+
+    uint32_t getCameraCount() const { return liveCount_; }
+
+    /**
+     * @brief 打印每个相机的策略、开销与陈旧度
+     */
+    void writeReport(FILE* out) const;
+
+private:
+    struct CameraSlot {
+        SecondaryCameraDesc desc;
+        SecondaryCameraStats stats;
+        uint32_t generation = 0;
+        bool alive = false;
+        bool enabled = true;
+
+        Matrix4 viewProjection = Matrix4(1.0f);
+        Matrix4 renderedViewProjection = Matrix4(1.0f);
+        bool dirty = true;
+
+        /** 开始到期的帧号（未到期时为 NotDue） */
+        uint64_t dueSince = ~0ull;
+
+        /** 每个条带最后一次渲染的帧号（非分摊相机只有一项），~0 表示从未渲染 */
+        TaggedVector<uint64_t, MemoryTag::Features> sliceFrames;
+        uint32_t nextSlice = 0;
+    };
+
+    static constexpr uint64_t NotDue = ~0ull;
+
+    CameraSlot* getSlot(SecondaryCameraHandle camera);
+    const CameraSlot* getSlot(SecondaryCameraHandle camera) const;
+    bool isDue(const CameraSlot& slot, uint64_t frameNumber) const;
+    void markUpdated(CameraSlot& slot, uint32_t index, uint64_t frameNumber);
+
+    TaggedVector<CameraSlot, MemoryTag::Features> slots_;
+    TaggedVector<uint32_t, MemoryTag::Features> freeSlots_;
+    uint32_t liveCount_ = 0;
+
+    SecondaryCameraBudget budget_;
+    TaggedVector<SecondaryCameraUpdate, MemoryTag::Features> updates_;
+    TaggedVector<uint32_t, MemoryTag::Features> candidates_;
+    SecondaryCameraFrameStats frameStats_;
+};
@@ -0,0 +1,72 @@
+/**
+ * @file ShadowCasterCuller.cpp
+ * @brief 阴影投射者剔除实现
+ */
+
+#include "ShadowCasterCuller.h"
+#include "LightingData.h"
+#include "RenderableStorage.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+uint32_t CullShadowCasters(const RenderableStorage& storage, const LightData& light, const ShadowSettings& settings,
+                           const Vector3& cameraPosition, TaggedVector<uint32_t, MemoryTag::Shadows>* casters,
+                           ShadowCasterCullStats* stats) {
+    PRISMA_PROFILE_ZONE("CullShadowCasters");
+
+    if (casters) {
+        casters->clear();
+    }
+    ShadowCasterCullStats local;
+
+    const uint32_t count = static_cast<uint32_t>(storage.size());
+    const RenderableBounds* bounds = storage.getBounds();
+    const uint32_t* flags = storage.getFlags();
+
+    const bool directional = light.type == LightType::Directional;
+    const float shadowDistance = settings.getRealtimeShadowDistance(light);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!(flags[i] & RenderableFlags::CastShadows)) {
+            continue;
+        }
+        ++local.candidates;
+
+        if (!settings.isRealtimeShadowCaster(light, flags[i])) {
+            ++local.shadowmaskSkipped;
+            continue;
+        }
+
+        const Vector3& center = bounds[i].center;
+        const float radius = bounds[i].radius;
+        bool inRange;
+        if (directional) {
+            // 胶囊体（球心沿光照方向的射线）到相机的最近距离
+            const Vector3 toCamera = cameraPosition - center;
+            const float along = std::max(glm::dot(toCamera, light.direction), 0.0f);
+            const Vector3 closest = toCamera - light.direction * along;
+            const float reach = shadowDistance + radius;
+            inRange = glm::dot(closest, closest) <= reach * reach;
+        } else {
+            const Vector3 toLight = light.position - center;
+            const float reach = light.range + radius;
+            inRange = glm::dot(toLight, toLight) <= reach * reach;
+        }
+
+        if (!inRange) {
+            ++local.distanceCulled;
+            continue;
+        }
+
+        ++local.casters;
+        if (casters) {
+            casters->push_back(i);
+        }
+    }
+
+    if (stats) {
+        *stats = local;
+    }
+    return local.casters;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file ShadowCasterCuller.h
+ * @brief 阴影投射者剔除 - 选出一个阴影光源本帧需要渲染进实时阴影贴图的对象
+ *
+ * 规则:
+ * - 没有 RenderableFlags::CastShadows 的对象跳过
+ * - 光源使用烘焙 shadowmask 时（ShadowSettings::usesShadowmask）Static 对象跳过
+ * - 定向光: 投射者的包围球沿光照方向拉伸成无限长的胶囊体，与相机周围实时阴影距离
+ *   （ShadowSettings::getRealtimeShadowDistance）的球体不相交时跳过。
+ *   阴影距离之外、但阴影落入距离之内的高大物体仍然保留
+ * - 点光源、聚光灯: 包围球与光源范围不相交时跳过
+ */
+
+#pragma once
+
+#include "ShadowSettings.h"
+#include "MemoryTracker.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+
+class RenderableStorage;
+struct LightData;
+
+/**
+ * @brief 单个光源的剔除统计
+ */
+struct ShadowCasterCullStats {
+    /** 带 CastShadows 标志的对象 */
+    uint32_t candidates = 0;
+
+    /** 需要渲染的投射者 */
+    uint32_t casters = 0;
+
+    /** 阴影来自 shadowmask 而跳过的静态对象 */
+    uint32_t shadowmaskSkipped = 0;
+
+    /** 超出实时阴影距离或光源范围的对象 */
+    uint32_t distanceCulled = 0;
+};
+
+/**
+ * @brief 剔除一个阴影光源的投射者
+ *
+ * @param storage 可渲染组件存储
+ * @param light 阴影光源
+ * @param settings 阴影设置（shadowmask 与阴影距离）
+ * @param cameraPosition 相机位置（定向光的阴影距离以它为中心）
+ * @param casters 输出投射者的紧密下标（可为 nullptr，只统计）
+ * @return 投射者数
+ */
+uint32_t CullShadowCasters(const RenderableStorage& storage, const LightData& light, const ShadowSettings& settings,
+                           const Vector3& cameraPosition,
+                           TaggedVector<uint32_t, MemoryTag::Shadows>* casters = nullptr,
+                           ShadowCasterCullStats* stats = nullptr);
@@ -0,0 +1,247 @@
+/**
+ * @file ShadowLightSelector.cpp
+ * @brief 阴影光源选择实现
+ */
+
+#include "ShadowLightSelector.h"
+#include "ShadowCasterCuller.h"
+#include "CameraSnapshot.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/** 没有标识的光源的 key: 高 32 位标记，低位为类型（4 位）与列表下标 */
+constexpr uint64_t kIndexKeyFlag = uint64_t(1) << 32;
+constexpr uint32_t kTypeShift = 28;
+
+/** 按 LightData::id 标识光源；id 为 0 时退回 (类型, 列表下标) */
+uint64_t makeKey(const LightData& light, LightType type, uint32_t index) {
+    if (light.id != 0) {
+        return light.id;
+    }
+    return kIndexKeyFlag | (static_cast<uint64_t>(type) << kTypeShift) | index;
+}
+
+/** 颜色亮度（Rec.709） */
+float luminance(const Vector3& color) {
+    return color.x * 0.2126f + color.y * 0.7152f + color.z * 0.0722f;
+}
+
+/**
+ * @brief 影响球在屏幕上的半径占屏幕高度的比例（相机在球内时为 1）
+ * @param projectionScale 投影矩阵的 [1][1]（cot(fov / 2)）
+ */
+float screenCoverage(const LightData& light, float distance, float projectionScale) {
+    if (distance <= light.range) {
+        return 1.0f;
+    }
+    const float tangent = std::sqrt(distance * distance - light.range * light.range);
+    return std::min(0.5f * projectionScale * light.range / tangent, 1.0f);
+}
+
+/** 影响球最近处按光源的实时阴影距离淡出（同 ShadowSettings::calculateShadowFade） */
+float distanceFade(const ShadowSettings& settings, const LightData& light, float distance) {
+    const float shadowDistance = settings.getRealtimeShadowDistance(light);
+    const float nearest = std::max(distance - light.range, 0.0f);
+    if (nearest >= shadowDistance) {
+        return 0.0f;
+    }
+    const float fadeRange = std::min(settings.shadowFadeDistance, shadowDistance);
+    const float fadeStart = shadowDistance - fadeRange;
+    if (nearest <= fadeStart) {
+        return 1.0f;
+    }
+    return 1.0f - (nearest - fadeStart) / fadeRange;
+}
+
+} // namespace
+
+// ============================================================================
+// ShadowLightSelectionStats
+// ============================================================================
+
+void ShadowLightSelectionStats::writeReport(FILE* out) const {
+    std::fprintf(out, "Shadow lights: %u casting, %u culled, %u caster queries (%u without casters)\n",
+                 shadowLights, culledLights, casterQueries, noCasterLights);
+    std::fprintf(out, "Selected: %u (%u held), %u entered, %u left\n",
+                 selectedLights, heldLights, enteredLights, leftLights);
+}
+
+// ============================================================================
+// ShadowLightSelector
+// ============================================================================
+
+void ShadowLightSelector::select(const LightingData& lighting, const CameraSnapshot& camera,
+                                 const ShadowSettings& shadowSettings, const RenderableStorage& storage) {
+    PRISMA_PROFILE_ZONE("ShadowLightSelector::select");
+
+    stats_ = ShadowLightSelectionStats();
+    selection_.clear();
+    candidates_.clear();
+    nextHistory_.clear();
+
+    const uint32_t budget = shadowSettings.enableShadows ? shadowSettings.maxShadowCastingLightsPerFrame : 0;
+
+    // 与 renderShadows 原有顺序一致: 定向光、聚光灯、点光源，按下标
+    static const LightType kListOrder[] = {LightType::Directional, LightType::Spot, LightType::Point};
+    auto listOf = [&](LightType type) -> const LightDataList& {
+        return type == LightType::Directional ? lighting.directionalLights
+             : type == LightType::Spot        ? lighting.spotLights
+                                              : lighting.pointLights;
+    };
+
+    if (!settings_.enabled) {
+        for (LightType type : kListOrder) {
+            const LightDataList& lights = listOf(type);
+            for (uint32_t i = 0; i < lights.size(); ++i) {
+                if (!lights[i].castShadows) continue;
+                ++stats_.shadowLights;
+                if (selection_.size() < budget) {
+                    selection_.push_back({type, i, 0.0f, 0});
+                }
+            }
+        }
+        stats_.selectedLights = static_cast<uint32_t>(selection_.size());
+        history_.clear();
+        return;
+    }
+
+    const float projectionScale = camera.unjittered.projection[1][1];
+
+    for (LightType type : kListOrder) {
+        const LightDataList& lights = listOf(type);
+        for (uint32_t i = 0; i < lights.size(); ++i) {
+            const LightData& light = lights[i];
+            if (!light.castShadows) continue;
+            ++stats_.shadowLights;
+
+            float coverage = 1.0f;
+            float cameraIntensity = 1.0f;
+            float fade = 1.0f;
+            if (type != LightType::Directional) {
+                if (!camera.isSphereVisible(light.position, light.range)) {
+                    ++stats_.culledLights;
+                    continue;
+                }
+                const float distance = glm::length(light.position - camera.position);
+                coverage = screenCoverage(light, distance, projectionScale);
+                cameraIntensity = light.calculateAttenuation(distance);
+                fade = distanceFade(shadowSettings, light, distance);
+            }
+
+            float score = luminance(light.color) * light.intensity
+                        * (settings_.coverageWeight * coverage + settings_.cameraIntensityWeight * cameraIntensity)
+                        * fade;
+            if (!(score > 0.0f)) {
+                ++stats_.culledLights;
+                continue;
+            }
+
+            const uint64_t key = makeKey(light, type, i);
+            bool held = false;
+            if (const History* history = findHistory(key)) {
+                score *= 1.0f + settings_.hysteresis;
+                held = history->frames < settings_.minHoldFrames;
+            }
+            candidates_.push_back({key, type, i, score, 0, held});
+        }
+    }
+
+    // 定向光优先，其次是保持期内的光源，再按分数；相同时按列表顺序
+    auto isDirectional = [](const Candidate& c) { return c.type == LightType::Directional; };
+    auto ranksBefore = [&](const Candidate& a, const Candidate& b) {
+        if (settings_.directionalFirst && isDirectional(a) != isDirectional(b)) {
+            return isDirectional(a);
+        }
+        if (a.held != b.held) {
+            return a.held;
+        }
+        return a.score > b.score;
+    };
+    std::stable_sort(candidates_.begin(), candidates_.end(), ranksBefore);
+
+    // 投射者因子不超过 1，只给排名靠前的候选做投射者计数
+    const float halfCount = std::max(settings_.casterHalfCount, 0.0f);
+    uint32_t queries = 0;
+    for (Candidate& candidate : candidates_) {
+        const bool forced = candidate.held || (settings_.directionalFirst && isDirectional(candidate));
+        if (settings_.maxCasterQueries > 0 && queries >= settings_.maxCasterQueries && !forced) {
+            candidate.score = 0.0f;
+            continue;
+        }
+        ++queries;
+
+        const ShadowLightSelection id{candidate.type, candidate.index, 0.0f, 0};
+        candidate.casters = CullShadowCasters(storage, getLight(lighting, id), shadowSettings, camera.position);
+        if (candidate.casters == 0) {
+            ++stats_.noCasterLights;
+            candidate.score = 0.0f;
+            continue;
+        }
+        const float casters = static_cast<float>(candidate.casters);
+        candidate.score *= casters / (casters + halfCount);
+    }
+    stats_.casterQueries = queries;
+
+    candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(),
+                                     [](const Candidate& c) { return !(c.score > 0.0f); }),
+                      candidates_.end());
+    std::stable_sort(candidates_.begin(), candidates_.end(), ranksBefore);
+
+    const uint32_t count = std::min(budget, static_cast<uint32_t>(candidates_.size()));
+
+    // 落选光源的最高分: 分数低于它而仍被选中的保持期光源计为 held
+    float bestRejected = 0.0f;
+    for (uint32_t i = count; i < candidates_.size(); ++i) {
+        bestRejected = std::max(bestRejected, candidates_[i].score);
+    }
+
+    uint32_t continued = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const Candidate& candidate = candidates_[i];
+        selection_.push_back({candidate.type, candidate.index, candidate.score, candidate.casters});
+
+        const History* history = findHistory(candidate.key);
+        if (history) {
+            ++continued;
+        } else {
+            ++stats_.enteredLights;
+        }
+        if (candidate.held && candidate.score < bestRejected) {
+            ++stats_.heldLights;
+        }
+        nextHistory_.push_back({candidate.key, history ? history->frames + 1 : 1});
+    }
+    stats_.selectedLights = count;
+    stats_.leftLights = static_cast<uint32_t>(history_.size()) - continued;
+
+    std::sort(nextHistory_.begin(), nextHistory_.end(),
+              [](const History& a, const History& b) { return a.key < b.key; });
+    history_.swap(nextHistory_);
+}
+
+const LightData& ShadowLightSelector::getLight(const LightingData& lighting, const ShadowLightSelection& selection) {
+    switch (selection.type) {
+        case LightType::Directional:
+            return lighting.directionalLights[selection.index];
+        case LightType::Spot:
+            return lighting.spotLights[selection.index];
+        default:
+            return lighting.pointLights[selection.index];
+    }
+}
+
+void ShadowLightSelector::reset() {
+    history_.clear();
+    selection_.clear();
+    stats_ = ShadowLightSelectionStats();
+}
+
+const ShadowLightSelector::History* ShadowLightSelector::findHistory(uint64_t key) const {
+    auto it = std::lower_bound(history_.begin(), history_.end(), key,
+                               [](const History& h, uint64_t k) { return h.key < k; });
+    return it != history_.end() && it->key == key ? &*it : nullptr;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file ShadowLightSelector.h
+ * @brief 阴影光源选择 - 按视觉重要性为每帧有限的阴影预算排序投射阴影的光源
+ *
+ * ShadowSettings::shouldRenderShadow 只按下标接受前 maxShadowCastingLightsPerFrame 个光源，
+ * 哪个光源先进入 LightingData 的列表就得到阴影。ShadowLightSelector 每帧为所有 castShadows 的光源打分:
+ *
+ *   score = 亮度 × (coverageWeight × 屏幕覆盖 + cameraIntensityWeight × 相机处衰减)
+ *           × 距离淡出 × 投射者因子
+ *
+ * - 屏幕覆盖: 影响球在屏幕上的半径占屏幕高度的比例（相机在球内、定向光为 1）
+ * - 相机处衰减: LightData::calculateAttenuation(到相机的距离)，相机附近的光源阴影最显眼
+ * - 距离淡出: 影响球到相机的距离按实时阴影距离淡出（ShadowSettings::calculateShadowFade），
+ *   阴影距离之外的光源不参与
+ * - 投射者因子: casters / (casters + casterHalfCount)，投射者由 CullShadowCasters 只计数得到；
+ *   没有投射者的光源不需要阴影贴图，不参与
+ * 影响球在视锥体外的局部光源直接跳过。定向光默认排在所有局部光源之前（级联阴影覆盖整个视野）
+ *
+ * 防闪烁（滞后）:
+ * - 上一帧选中的光源分数乘 (1 + hysteresis)，分数相近的光源不会每帧交替
+ * - 新选中的光源至少保持 minHoldFrames 帧（只要仍是有效候选），优先于其他光源占用预算
+ *
+ * 光源按 LightData::id 标识，跨帧的滞后状态不受列表重排、增删和光源聚合的影响；
+ * 没有标识（id 为 0）的光源退回按 (类型, 列表下标) 标识，要求列表顺序稳定。
+ *
+ * 使用 LightAggregator 时应从聚合后的光源列表（LightAggregator::applyTo 的结果）选择:
+ * 被合并进虚拟光源或区域 SH 的光源不再单独着色，不分配阴影贴图；虚拟光源不投射阴影。
+ * 选择结果的下标指向传入 select 的 LightingData，getLight 必须使用同一份数据。
+ * 每个选择器只服务一个视图；NullFrameRunner 只在单相机帧使用，其他帧仍按下标选择
+ *
+ * 用法:
+ * @code
+ *
+ * ShadowLightSelector selector;
+ * selector.setSettings(settings);
+ *
+ * // 每帧，相机快照构建之后
+ * selector.select(lightingData, cameraSnapshot, shadowSettings, storage);
+ * for (const ShadowLightSelection& s : selector.getSelection()) {
+ *     const LightData& light = selector.getLight(lightingData, s);
+ *     // 按排名顺序分配 atlas 并渲染阴影贴图
+ * }
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "LightingData.h"
+#include "ShadowSettings.h"
+#include "MemoryTracker.h"
+#include <cstdint>
+#include <cstdio>
+
+struct CameraSnapshot;
+class RenderableStorage;
+
+/**
+ * @brief 阴影光源选择配置
+ */
+struct ShadowLightSelectionSettings {
+    bool enabled = true;
+
+    /** 屏幕覆盖项的权重 */
+    float coverageWeight = 1.0f;
+
+    /** 相机处衰减项的权重 */
+    float cameraIntensityWeight = 0.5f;
+
+    /** 投射者因子达到 0.5 时的投射者数 */
+    float casterHalfCount = 4.0f;
+
+    /** 定向光排在所有局部光源之前 */
+    bool directionalFirst = true;
+
+    /** 上一帧选中的光源的分数加成比例 */
+    float hysteresis = 0.25f;
+
+    /** 新选中的光源至少保持的帧数 */
+    uint32_t minHoldFrames = 8;
+
+    /** 每帧做投射者计数的候选上限（按不含投射者因子的分数取前几个；0 不限制） */
+    uint32_t maxCasterQueries = 16;
+};
+
+/**
+ * @brief 一个被选中的阴影光源
+ */
+struct ShadowLightSelection {
+    LightType type = LightType::Point;
+
+    /** 在传入 select 的 LightingData 对应列表中的下标（只在本帧有效） */
+    uint32_t index = 0;
+
+    /** 含滞后加成的分数 */
+    float score = 0.0f;
+
+    uint32_t casters = 0;
+};
+
+/**
+ * @brief 每帧选择统计
+ */
+struct ShadowLightSelectionStats {
+    /** castShadows 的光源 */
+    uint32_t shadowLights = 0;
+
+    /** 影响球在视锥体外或超出阴影距离 */
+    uint32_t culledLights = 0;
+
+    /** 做了投射者计数的光源，以及其中没有投射者的 */
+    uint32_t casterQueries = 0;
+    uint32_t noCasterLights = 0;
+
+    uint32_t selectedLights = 0;
+
+    /** 因 minHoldFrames 保留的光源 */
+    uint32_t heldLights = 0;
+
+    /** 本帧新选中、上一帧选中本帧落选的光源（闪烁指标） */
+    uint32_t enteredLights = 0;
+    uint32_t leftLights = 0;
+
+    void writeReport(FILE* out) const;
+};
+
+/**
+ * @brief 阴影光源选择器
+ */
+class ShadowLightSelector {
+public:
+    void setSettings(const ShadowLightSelectionSettings& settings) { settings_ = settings; }
+    const ShadowLightSelectionSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief 选出本帧的阴影光源（最多 ShadowSettings::maxShadowCastingLightsPerFrame 个）
+     * @param camera 未抖动矩阵用于剔除和屏幕覆盖
+     */
+    void select(const LightingData& lighting, const CameraSnapshot& camera, const ShadowSettings& shadowSettings,
+                const RenderableStorage& storage);
+
+    /** 选中的光源，按排名顺序 */
+    const TaggedVector<ShadowLightSelection, MemoryTag::Shadows>& getSelection() const { return selection_; }
+
+    /** 选择结果对应的光源 */
+    static const LightData& getLight(const LightingData& lighting, const ShadowLightSelection& selection);
+
+    /** 清空跨帧状态（场景切换、光源列表重建时调用） */
+    void reset();
+
+    const ShadowLightSelectionStats& getStats() const { return stats_; }
+
+private:
+    struct Candidate {
+        uint64_t key;
+        LightType type;
+        uint32_t index;
+        float score;
+        uint32_t casters;
+
+        /** 仍在 minHoldFrames 内 */
+        bool held;
+    };
+
+    /** 上一帧选中的光源，按 key 升序 */
+    struct History {
+        uint64_t key;
+
+        /** 连续选中的帧数 */
+        uint32_t frames;
+    };
+
+    const History* findHistory(uint64_t key) const;
+
+    ShadowLightSelectionSettings settings_;
+    ShadowLightSelectionStats stats_;
+
+    TaggedVector<ShadowLightSelection, MemoryTag::Shadows> selection_;
+    TaggedVector<History, MemoryTag::Shadows> history_;
+
+    /** 每帧复用的临时数组 */
+    TaggedVector<Candidate, MemoryTag::Shadows> candidates_;
+    TaggedVector<History, MemoryTag::Shadows> nextHistory_;
+};
@@ -0,0 +1,122 @@
+/**
+ * @file ShadowSettings.cpp
+ * @brief 阴影设置实现
+ */
+
+#include "ShadowSettings.h"
+#include "LightingData.h"
+#include "RenderableStorage.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// 级联分割
+// ============================================================================
+
+TaggedVector<float, MemoryTag::Shadows> CascadedShadowSettings::calculateSplitDistances(float nearPlane,
+                                                                                        float farPlane) const {
+    const uint32_t count = std::clamp(cascadeCount, 1u, 4u);
+
+    TaggedVector<float, MemoryTag::Shadows> splits(count + 1);
+    splits[0] = nearPlane;
+    splits[count] = farPlane;
+
+    const float range = farPlane - nearPlane;
+    const float ratio = farPlane / nearPlane;
+
+    for (uint32_t i = 1; i < count; ++i) {
+        const float p = static_cast<float>(i) / static_cast<float>(count);
+        const float uniformSplit = nearPlane + range * p;
+        const float logSplit = nearPlane * std::pow(ratio, p);
+
+        switch (splitScheme) {
+            case SplitScheme::Uniform:
+                splits[i] = uniformSplit;
+                break;
+
+            case SplitScheme::Logarithmic:
+                splits[i] = logSplit;
+                break;
+
+            case SplitScheme::Manual:
+                splits[i] = (i - 1 < manualSplits.size())
+                    ? nearPlane + range * manualSplits[i - 1]
+                    : uniformSplit;
+                break;
+
+            case SplitScheme::PseudoLogarithmic:
+                // 对数与均匀分割按 0.5 混合（Practical Split Scheme）
+                splits[i] = 0.5f * logSplit + 0.5f * uniformSplit;
+                break;
+        }
+    }
+
+    return splits;
+}
+
+// ============================================================================
+// Shadowmask
+// ============================================================================
+
+bool ShadowSettings::usesShadowmask(const LightData& light) const {
+    return enableShadowmask && light.lightMode == LightMode::Mixed && light.shadowmaskChannel >= 0;
+}
+
+float ShadowSettings::getRealtimeShadowDistance(const LightData& light) const {
+    return usesShadowmask(light) ? std::min(shadowDistance, shadowmaskShadowDistance) : shadowDistance;
+}
+
+bool ShadowSettings::isRealtimeShadowCaster(const LightData& light, uint32_t renderableFlags) const {
+    if (!(renderableFlags & RenderableFlags::CastShadows)) {
+        return false;
+    }
+    // 静态投射者的阴影已烘焙进 shadowmask
+    return !(usesShadowmask(light) && (renderableFlags & RenderableFlags::Static));
+}
+
+float ShadowSettings::combineShadowmask(const LightData& light, float realtimeShadow, float bakedShadow,
+                                       float distance) const {
+    if (!usesShadowmask(light)) {
+        return realtimeShadow;
+    }
+    const float realtimeDistance = getRealtimeShadowDistance(light);
+    const float fadeRange = std::max(std::min(shadowFadeDistance, realtimeDistance), 1e-4f);
+    const float realtimeWeight = std::clamp((realtimeDistance - distance) / fadeRange, 0.0f, 1.0f);
+    return std::min(bakedShadow, 1.0f + (realtimeShadow - 1.0f) * realtimeWeight);
+}
+
+// ============================================================================
+// 阴影 Atlas
+// ============================================================================
+
+ShadowAtlas::Rect ShadowAtlas::allocate(uint32_t shadowWidth, uint32_t shadowHeight) {
+    if (shadowWidth == 0 || shadowHeight == 0 || shadowWidth > width) {
+        return Rect{0, 0, 0, 0};
+    }
+
+    // 当前行放不下，换到下一行
+    if (shelfX + shadowWidth > width) {
+        shelfY += shelfHeight;
+        shelfX = 0;
+        shelfHeight = 0;
+    }
+
+    if (shelfY + shadowHeight > height) {
+        return Rect{0, 0, 0, 0};
+    }
+
+    Rect rect{shelfX, shelfY, shadowWidth, shadowHeight};
+    shelfX += shadowWidth;
+    shelfHeight = std::max(shelfHeight, shadowHeight);
+
+    allocatedRects.push_back(rect);
+    return rect;
+}
+
+void ShadowAtlas::reset() {
+    allocatedRects.clear();
+    shelfX = 0;
+    shelfY = 0;
+    shelfHeight = 0;
+}
@@ -0,0 +1,556 @@
+/**
+ * @file SphericalHarmonics.cpp
+ * @brief 实数球谐函数实现
+ */
+
+#include "SphericalHarmonics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRISMA_SH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PRISMA_SH_NEON 1
+#endif
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/** 基函数常数 */
+constexpr float kY0 = 0.282095f;   // 1 / (2 sqrt(π))
+constexpr float kY1 = 0.488603f;   // sqrt(3 / 4π)
+constexpr float kY2 = 1.092548f;   // sqrt(15 / 4π)
+constexpr float kY20 = 0.315392f;  // sqrt(5 / 16π)
+constexpr float kY22 = 0.546274f;  // sqrt(15 / 16π)
+
+/** 每个频带第一个系数的下标 */
+constexpr uint32_t kBandStart[3] = {0, 1, 4};
+
+template <typename T>
+constexpr uint32_t channelCount() {
+    return std::is_same_v<T, float> ? 1 : 3;
+}
+
+inline float& channel(float& value, uint32_t) { return value; }
+inline float channel(const float& value, uint32_t) { return value; }
+inline float& channel(Vector3& value, uint32_t c) { return value[c]; }
+inline float channel(const Vector3& value, uint32_t c) { return value[c]; }
+
+/** 每个频带乘一个系数 */
+template <typename SH>
+void scaleBands(SH& sh, const float* bandScale) {
+    for (uint32_t l = 0; l < SH::Bands; ++l) {
+        for (uint32_t i = kBandStart[l]; i < kBandStart[l] + 2 * l + 1; ++i) {
+            sh.c[i] = sh.c[i] * bandScale[l];
+        }
+    }
+}
+
+// ============================================================================
+// 4宽 SIMD 封装
+// ============================================================================
+
+#if defined(PRISMA_SH_SSE2)
+
+#define PRISMA_SH_SIMD 1
+
+using F4 = __m128;
+
+inline F4 load4(const float* p) { return _mm_loadu_ps(p); }
+inline void store4(float* p, F4 v) { _mm_storeu_ps(p, v); }
+inline F4 splat(float v) { return _mm_set1_ps(v); }
+inline F4 add(F4 a, F4 b) { return _mm_add_ps(a, b); }
+inline F4 sub(F4 a, F4 b) { return _mm_sub_ps(a, b); }
+inline F4 mul(F4 a, F4 b) { return _mm_mul_ps(a, b); }
+inline F4 div(F4 a, F4 b) { return _mm_div_ps(a, b); }
+inline F4 sqrt4(F4 v) { return _mm_sqrt_ps(v); }
+
+#elif defined(PRISMA_SH_NEON)
+
+#define PRISMA_SH_SIMD 1
+
+using F4 = float32x4_t;
+
+inline F4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, F4 v) { vst1q_f32(p, v); }
+inline F4 splat(float v) { return vdupq_n_f32(v); }
+inline F4 add(F4 a, F4 b) { return vaddq_f32(a, b); }
+inline F4 sub(F4 a, F4 b) { return vsubq_f32(a, b); }
+inline F4 mul(F4 a, F4 b) { return vmulq_f32(a, b); }
+inline F4 div(F4 a, F4 b) { return vdivq_f32(a, b); }
+inline F4 sqrt4(F4 v) { return vsqrtq_f32(v); }
+
+#endif
+
+#ifdef PRISMA_SH_SIMD
+
+/** 4 个方向的前 N 个基函数，运算顺序与 EvaluateSHBasis 一致 */
+template <uint32_t N>
+void evaluateBasis4(F4 x, F4 y, F4 z, F4* basis) {
+    basis[0] = splat(kY0);
+    basis[1] = mul(splat(kY1), y);
+    basis[2] = mul(splat(kY1), z);
+    basis[3] = mul(splat(kY1), x);
+    if constexpr (N == 9) {
+        basis[4] = mul(mul(splat(kY2), x), y);
+        basis[5] = mul(mul(splat(kY2), y), z);
+        basis[6] = mul(splat(kY20), sub(mul(mul(splat(3.0f), z), z), splat(1.0f)));
+        basis[7] = mul(mul(splat(kY2), x), z);
+        basis[8] = mul(splat(kY22), sub(mul(x, x), mul(y, y)));
+    }
+}
+
+float horizontalSum(F4 v) {
+    alignas(16) float lanes[4];
+    store4(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+#endif
+
+/** 小型矩阵求逆（Gauss-Jordan，部分主元） */
+template <uint32_t N>
+void invert(float (&m)[N][N]) {
+    float inverse[N][N] = {};
+    for (uint32_t i = 0; i < N; ++i) {
+        inverse[i][i] = 1.0f;
+    }
+    for (uint32_t col = 0; col < N; ++col) {
+        uint32_t pivot = col;
+        for (uint32_t row = col + 1; row < N; ++row) {
+            if (std::fabs(m[row][col]) > std::fabs(m[pivot][col])) {
+                pivot = row;
+            }
+        }
+        for (uint32_t k = 0; k < N; ++k) {
+            std::swap(m[col][k], m[pivot][k]);
+            std::swap(inverse[col][k], inverse[pivot][k]);
+        }
+        const float invPivot = 1.0f / m[col][col];
+        for (uint32_t k = 0; k < N; ++k) {
+            m[col][k] *= invPivot;
+            inverse[col][k] *= invPivot;
+        }
+        for (uint32_t row = 0; row < N; ++row) {
+            if (row == col) {
+                continue;
+            }
+            const float factor = m[row][col];
+            for (uint32_t k = 0; k < N; ++k) {
+                m[row][k] -= factor * m[col][k];
+                inverse[row][k] -= factor * inverse[col][k];
+            }
+        }
+    }
+    std::copy(&inverse[0][0], &inverse[0][0] + N * N, &m[0][0]);
+}
+
+/**
+ * @brief 频带 l 的 ZH 分解
+ *
+ * 频带 l 的 2l+1 个系数写成固定方向 d_k 上 ZH 波瓣的加权和: f_l = Aᵀ w，A[k][m] = Y_lm(d_k)。
+ * 旋转后波瓣位于 R d_k，g_l = Bᵀ w = Bᵀ A⁻ᵀ f_l，B[k][m] = Y_lm(R d_k)
+ */
+template <uint32_t Band>
+struct ZonalBasis {
+    static constexpr uint32_t Size = 2 * Band + 1;
+
+    Vector3 directions[Size];
+
+    /** A⁻¹ */
+    float inverse[Size][Size];
+
+    ZonalBasis() {
+        if constexpr (Band == 1) {
+            directions[0] = Vector3(1.0f, 0.0f, 0.0f);
+            directions[1] = Vector3(0.0f, 1.0f, 0.0f);
+            directions[2] = Vector3(0.0f, 0.0f, 1.0f);
+        } else {
+            const float s = 0.70710678f;
+            directions[0] = Vector3(1.0f, 0.0f, 0.0f);
+            directions[1] = Vector3(0.0f, 0.0f, 1.0f);
+            directions[2] = Vector3(s, s, 0.0f);
+            directions[3] = Vector3(s, 0.0f, s);
+            directions[4] = Vector3(0.0f, s, s);
+        }
+        for (uint32_t k = 0; k < Size; ++k) {
+            float basis[kSHMaxCoefficients];
+            EvaluateSHBasis(directions[k], basis);
+            for (uint32_t m = 0; m < Size; ++m) {
+                inverse[k][m] = basis[kBandStart[Band] + m];
+            }
+        }
+        invert(inverse);
+    }
+
+    /** 频带旋转矩阵 M = Bᵀ A⁻ᵀ（g_l = M f_l） */
+    void buildRotation(const Matrix4& rotation, float (&out)[Size][Size]) const {
+        float b[Size][Size];
+        for (uint32_t k = 0; k < Size; ++k) {
+            float basis[kSHMaxCoefficients];
+            EvaluateSHBasis(glm::normalize(Vector3(rotation * Vector4(directions[k], 0.0f))), basis);
+            for (uint32_t m = 0; m < Size; ++m) {
+                b[k][m] = basis[kBandStart[Band] + m];
+            }
+        }
+        // M[m][n] = Σ_k B[k][m] * A⁻ᵀ[k][n] = Σ_k B[k][m] * A⁻¹[n][k]
+        for (uint32_t m = 0; m < Size; ++m) {
+            for (uint32_t n = 0; n < Size; ++n) {
+                float sum = 0.0f;
+                for (uint32_t k = 0; k < Size; ++k) {
+                    sum += b[k][m] * inverse[n][k];
+                }
+                out[m][n] = sum;
+            }
+        }
+    }
+};
+
+const ZonalBasis<1>& zonalBasis1() {
+    static const ZonalBasis<1> basis;
+    return basis;
+}
+
+const ZonalBasis<2>& zonalBasis2() {
+    static const ZonalBasis<2> basis;
+    return basis;
+}
+
+} // namespace
+
+// ============================================================================
+// 基函数与求值
+// ============================================================================
+
+void EvaluateSHBasis(const Vector3& d, float basis[kSHMaxCoefficients]) {
+    basis[0] = kY0;
+    basis[1] = kY1 * d.y;
+    basis[2] = kY1 * d.z;
+    basis[3] = kY1 * d.x;
+    basis[4] = kY2 * d.x * d.y;
+    basis[5] = kY2 * d.y * d.z;
+    basis[6] = kY20 * (3.0f * d.z * d.z - 1.0f);
+    basis[7] = kY2 * d.x * d.z;
+    basis[8] = kY22 * (d.x * d.x - d.y * d.y);
+}
+
+template <typename SH>
+typename SH::Value EvaluateSH(const SH& sh, const Vector3& direction) {
+    float basis[kSHMaxCoefficients];
+    EvaluateSHBasis(direction, basis);
+    typename SH::Value result(0.0f);
+    for (uint32_t i = 0; i < SH::Count; ++i) {
+        result += sh.c[i] * basis[i];
+    }
+    return result;
+}
+
+template <typename SH>
+void EvaluateSHBatch(const SH& sh, const float* x, const float* y, const float* z, uint32_t count,
+                     typename SH::Value* out) {
+    using Value = typename SH::Value;
+    constexpr uint32_t channels = channelCount<Value>();
+    uint32_t i = 0;
+
+#ifdef PRISMA_SH_SIMD
+    F4 coefficients[channels][SH::Count];
+    for (uint32_t c = 0; c < channels; ++c) {
+        for (uint32_t j = 0; j < SH::Count; ++j) {
+            coefficients[c][j] = splat(channel(sh.c[j], c));
+        }
+    }
+
+    F4 basis[SH::Count];
+    for (; i + 4 <= count; i += 4) {
+        evaluateBasis4<SH::Count>(load4(x + i), load4(y + i), load4(z + i), basis);
+
+        alignas(16) float result[channels][4];
+        for (uint32_t c = 0; c < channels; ++c) {
+            F4 sum = mul(coefficients[c][0], basis[0]);
+            for (uint32_t j = 1; j < SH::Count; ++j) {
+                sum = add(sum, mul(coefficients[c][j], basis[j]));
+            }
+            store4(result[c], sum);
+        }
+
+        if constexpr (channels == 1) {
+            std::copy(result[0], result[0] + 4, out + i);
+        } else {
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                out[i + lane] = Vector3(result[0][lane], result[1][lane], result[2][lane]);
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        out[i] = EvaluateSH(sh, Vector3(x[i], y[i], z[i]));
+    }
+}
+
+template <typename SH>
+typename SH::Value DotSH(const SH& a, const SH& b) {
+    typename SH::Value result(0.0f);
+    for (uint32_t i = 0; i < SH::Count; ++i) {
+        result += a.c[i] * b.c[i];
+    }
+    return result;
+}
+
+// ============================================================================
+// 投影
+// ============================================================================
+
+template <typename SH>
+void AddSHDirectional(SH& sh, const Vector3& direction, const typename SH::Value& value) {
+    float basis[kSHMaxCoefficients];
+    EvaluateSHBasis(direction, basis);
+    for (uint32_t i = 0; i < SH::Count; ++i) {
+        sh.c[i] += value * basis[i];
+    }
+}
+
+template <typename SH>
+void AddSHUniform(SH& sh, const typename SH::Value& radiance) {
+    // ∫ Y00 dω = 4π * Y00
+    sh.c[0] += radiance * (4.0f * kPi * kY0);
+}
+
+template <typename SH>
+void AddSHZonal(SH& sh, const Vector3& axis, const float* zonal, const typename SH::Value& value) {
+    float basis[kSHMaxCoefficients];
+    EvaluateSHBasis(axis, basis);
+    for (uint32_t l = 0; l < SH::Bands; ++l) {
+        const float scale = std::sqrt(4.0f * kPi / static_cast<float>(2 * l + 1)) * zonal[l];
+        for (uint32_t i = kBandStart[l]; i < kBandStart[l] + 2 * l + 1; ++i) {
+            sh.c[i] += value * (scale * basis[i]);
+        }
+    }
+}
+
+template <typename SH>
+void AddSHCone(SH& sh, const Vector3& direction, float halfAngle, const typename SH::Value& radiance) {
+    // 半角 α 的均匀球冠绕 +z 的 ZH 系数
+    const float cosAngle = std::cos(halfAngle);
+    const float sin2 = 1.0f - cosAngle * cosAngle;
+    const float zonal[3] = {
+        std::sqrt(kPi) * (1.0f - cosAngle),
+        std::sqrt(3.0f * kPi) * 0.5f * sin2,
+        std::sqrt(5.0f * kPi) * 0.5f * cosAngle * sin2,
+    };
+    AddSHZonal(sh, direction, zonal, radiance);
+}
+
+Vector3 GetCubemapTexelDirection(uint32_t face, uint32_t x, uint32_t y, uint32_t size) {
+    const float u = (2.0f * static_cast<float>(x) + 1.0f) / static_cast<float>(size) - 1.0f;
+    const float v = (2.0f * static_cast<float>(y) + 1.0f) / static_cast<float>(size) - 1.0f;
+    Vector3 d;
+    switch (face) {
+        case 0: d = Vector3(1.0f, -v, -u); break;
+        case 1: d = Vector3(-1.0f, -v, u); break;
+        case 2: d = Vector3(u, 1.0f, v); break;
+        case 3: d = Vector3(u, -1.0f, -v); break;
+        case 4: d = Vector3(u, -v, 1.0f); break;
+        default: d = Vector3(-u, -v, -1.0f); break;
+    }
+    return glm::normalize(d);
+}
+
+SH9RGB ProjectCubemapToSH(const Vector3* const faces[6], uint32_t size) {
+    // 方向 = axis + u * uAxis + v * vAxis（与 GetCubemapTexelDirection 相同）
+    static const Vector3 kAxis[6] = {
+        Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1),
+    };
+    static const Vector3 kUAxis[6] = {
+        Vector3(0, 0, -1), Vector3(0, 0, 1), Vector3(1, 0, 0), Vector3(1, 0, 0), Vector3(1, 0, 0), Vector3(-1, 0, 0),
+    };
+    static const Vector3 kVAxis[6] = {
+        Vector3(0, -1, 0), Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1), Vector3(0, -1, 0), Vector3(0, -1, 0),
+    };
+
+    SH9RGB result;
+    if (size == 0) {
+        return result;
+    }
+
+    float sums[3][kSHMaxCoefficients] = {};
+    float totalWeight = 0.0f;
+    const float step = 2.0f / static_cast<float>(size);
+
+#ifdef PRISMA_SH_SIMD
+    F4 accumulators[3][kSHMaxCoefficients];
+    for (auto& channelSums : accumulators) {
+        for (F4& a : channelSums) {
+            a = splat(0.0f);
+        }
+    }
+    F4 weightSum = splat(0.0f);
+    alignas(16) static const float kLaneOffsets[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    const F4 laneU = mul(load4(kLaneOffsets), splat(step));
+#endif
+
+    for (uint32_t face = 0; face < 6; ++face) {
+        const Vector3& axis = kAxis[face];
+        const Vector3& uAxis = kUAxis[face];
+        const Vector3& vAxis = kVAxis[face];
+
+        for (uint32_t y = 0; y < size; ++y) {
+            const float v = (static_cast<float>(y) + 0.5f) * step - 1.0f;
+            const Vector3 rowBase = axis + vAxis * v;
+            const Vector3* row = faces[face] + static_cast<size_t>(y) * size;
+            uint32_t x = 0;
+
+#ifdef PRISMA_SH_SIMD
+            const F4 v2 = splat(1.0f + v * v);
+            for (; x + 4 <= size; x += 4) {
+                const F4 u = add(splat((static_cast<float>(x) + 0.5f) * step - 1.0f), laneU);
+                const F4 dx = add(splat(rowBase.x), mul(u, splat(uAxis.x)));
+                const F4 dy = add(splat(rowBase.y), mul(u, splat(uAxis.y)));
+                const F4 dz = add(splat(rowBase.z), mul(u, splat(uAxis.z)));
+
+                // |d|² = 1 + u² + v²，立体角 ∝ 1 / |d|³
+                const F4 invLength = div(splat(1.0f), sqrt4(add(v2, mul(u, u))));
+                const F4 weight = mul(mul(invLength, invLength), invLength);
+                weightSum = add(weightSum, weight);
+
+                F4 basis[kSHMaxCoefficients];
+                evaluateBasis4<kSHMaxCoefficients>(mul(dx, invLength), mul(dy, invLength), mul(dz, invLength), basis);
+
+                alignas(16) float texels[3][4];
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    texels[0][lane] = row[x + lane].x;
+                    texels[1][lane] = row[x + lane].y;
+                    texels[2][lane] = row[x + lane].z;
+                }
+                for (uint32_t c = 0; c < 3; ++c) {
+                    const F4 weighted = mul(load4(texels[c]), weight);
+                    for (uint32_t j = 0; j < kSHMaxCoefficients; ++j) {
+                        accumulators[c][j] = add(accumulators[c][j], mul(weighted, basis[j]));
+                    }
+                }
+            }
+#endif
+
+            for (; x < size; ++x) {
+                const float u = (static_cast<float>(x) + 0.5f) * step - 1.0f;
+                const Vector3 d = rowBase + uAxis * u;
+                const float invLength = 1.0f / std::sqrt(1.0f + u * u + v * v);
+                const float weight = invLength * invLength * invLength;
+                totalWeight += weight;
+
+                float basis[kSHMaxCoefficients];
+                EvaluateSHBasis(d * invLength, basis);
+                for (uint32_t c = 0; c < 3; ++c) {
+                    const float weighted = row[x][c] * weight;
+                    for (uint32_t j = 0; j < kSHMaxCoefficients; ++j) {
+                        sums[c][j] += weighted * basis[j];
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef PRISMA_SH_SIMD
+    totalWeight += horizontalSum(weightSum);
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t j = 0; j < kSHMaxCoefficients; ++j) {
+            sums[c][j] += horizontalSum(accumulators[c][j]);
+        }
+    }
+#endif
+
+    // 近似立体角归一化到 4π
+    const float scale = 4.0f * kPi / totalWeight;
+    for (uint32_t j = 0; j < kSHMaxCoefficients; ++j) {
+        result.c[j] = Vector3(sums[0][j], sums[1][j], sums[2][j]) * scale;
+    }
+    return result;
+}
+
+// ============================================================================
+// 旋转
+// ============================================================================
+
+SHRotation::SHRotation(const Matrix4& rotation) {
+    zonalBasis1().buildRotation(rotation, band1_);
+    zonalBasis2().buildRotation(rotation, band2_);
+}
+
+template <typename SH>
+SH SHRotation::apply(const SH& sh) const {
+    SH result;
+    result.c[0] = sh.c[0];
+    for (uint32_t m = 0; m < 3; ++m) {
+        for (uint32_t n = 0; n < 3; ++n) {
+            result.c[1 + m] += sh.c[1 + n] * band1_[m][n];
+        }
+    }
+    if constexpr (SH::Count == 9) {
+        for (uint32_t m = 0; m < 5; ++m) {
+            for (uint32_t n = 0; n < 5; ++n) {
+                result.c[4 + m] += sh.c[4 + n] * band2_[m][n];
+            }
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// 卷积与加窗
+// ============================================================================
+
+template <typename SH>
+SH ConvolveSHLambert(const SH& radiance) {
+    static const float kLambert[3] = {kPi, 2.0f * kPi / 3.0f, kPi / 4.0f};
+    SH result = radiance;
+    scaleBands(result, kLambert);
+    return result;
+}
+
+template <typename SH>
+void ApplySHWindow(SH& sh, SHWindow window, float width) {
+    if (width <= 0.0f) {
+        width = static_cast<float>(SH::Bands + 1);
+    }
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+    for (uint32_t l = 1; l < SH::Bands; ++l) {
+        const float t = static_cast<float>(l) / width;
+        if (t >= 1.0f) {
+            scale[l] = 0.0f;
+        } else if (window == SHWindow::Hann) {
+            scale[l] = 0.5f * (1.0f + std::cos(kPi * t));
+        } else {
+            scale[l] = std::sin(kPi * t) / (kPi * t);
+        }
+    }
+    scaleBands(sh, scale);
+}
+
+// ============================================================================
+// 显式实例化
+// ============================================================================
+
+#define PRISMA_SH_INSTANTIATE(SH)                                                                          \
+    template SH::Value EvaluateSH<SH>(const SH&, const Vector3&);                                          \
+    template void EvaluateSHBatch<SH>(const SH&, const float*, const float*, const float*, uint32_t,       \
+                                      SH::Value*);                                                         \
+    template SH::Value DotSH<SH>(const SH&, const SH&);                                                    \
+    template void AddSHDirectional<SH>(SH&, const Vector3&, const SH::Value&);                             \
+    template void AddSHUniform<SH>(SH&, const SH::Value&);                                                 \
+    template void AddSHZonal<SH>(SH&, const Vector3&, const float*, const SH::Value&);                     \
+    template void AddSHCone<SH>(SH&, const Vector3&, float, const SH::Value&);                             \
+    template SH SHRotation::apply<SH>(const SH&) const;                                                    \
+    template SH ConvolveSHLambert<SH>(const SH&);                                                          \
+    template void ApplySHWindow<SH>(SH&, SHWindow, float);
+
+PRISMA_SH_INSTANTIATE(SH4)
+PRISMA_SH_INSTANTIATE(SH9)
+PRISMA_SH_INSTANTIATE(SH4RGB)
+PRISMA_SH_INSTANTIATE(SH9RGB)
+
+#undef PRISMA_SH_INSTANTIATE
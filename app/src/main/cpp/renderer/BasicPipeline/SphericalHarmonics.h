@@ -0,0 +1,210 @@
+/**
+ * @file SphericalHarmonics.h
+ * @brief 实数球谐函数（L1 / L2）- 求值、投影、旋转、卷积与加窗
+ *
+ * 光照探针（LightingData::LightProbe::sphericalHarmonics）、PRT、天空环境光共用这一套:
+ * - 基函数与求值: 单方向求值与 SoA 批量求值（每4个方向一组 SSE2/NEON 指令）
+ * - 投影: 立方体贴图（逐纹素立体角加权，SIMD）；解析光源: δ 方向光、均匀环境光、
+ *   球冠（球形光源、太阳圆盘）与任意带谐（ZH）波瓣
+ * - 旋转: 每个频带用 2l+1 个固定方向的 ZH 波瓣表示，旋转时只需在旋转后的方向上求值
+ *   （Nowrouzezahrai et al. 2012），L2 每次旋转 1 + 9 + 25 次乘加
+ * - Lambert 卷积: 辐射度 SH → 辐照度 SH（各频带乘 π、2π/3、π/4）
+ * - 加窗: Hann / Lanczos 衰减高频，减少 δ 光源和高对比天空投影后的振铃与负值
+ *
+ * 约定:
+ * - 系数顺序 (l, m): (0,0) (1,-1) (1,0) (1,1) (2,-2) (2,-1) (2,0) (2,1) (2,2)，
+ *   对应 1, y, z, x, xy, yz, 3z²-1, xz, x²-y²（与 Sloan "Stupid SH Tricks" 相同）
+ * - 函数 f(ω) 的投影系数 c_i = ∫ f(ω) Y_i(ω) dω，求值 f(ω) ≈ Σ c_i Y_i(ω)
+ * - L1 使用 L2 的前 4 个系数，L1 / L2 之间可以直接截断或补 0
+ *
+ * 用法:
+ * @code
+ *
+ * SH9RGB sky = ProjectCubemapToSH(faces, size);
+ * AddSHDirectional(sky, sunDirection, sunRadiance);
+ * ApplySHWindow(sky, SHWindow::Hann);
+ * SH9RGB irradiance = ConvolveSHLambert(sky);
+ * Vector3 e = EvaluateSH(irradiance, normal);
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "../../MathTypes.h"
+#include <cstdint>
+
+/** L2 基函数个数 */
+constexpr uint32_t kSHMaxCoefficients = 9;
+
+/**
+ * @brief 球谐系数
+ * @tparam T float（单通道）或 Vector3（RGB）
+ * @tparam N 4（L1）或 9（L2）
+ */
+template <typename T, uint32_t N>
+struct SphericalHarmonics {
+    static_assert(N == 4 || N == 9, "only L1 (4) and L2 (9) are supported");
+
+    using Value = T;
+    static constexpr uint32_t Count = N;
+
+    /** 频带数（L1 为 2，L2 为 3） */
+    static constexpr uint32_t Bands = N == 4 ? 2 : 3;
+
+    T c[N];
+
+    SphericalHarmonics() {
+        for (T& v : c) {
+            v = T(0.0f);
+        }
+    }
+
+    SphericalHarmonics& operator+=(const SphericalHarmonics& other) {
+        for (uint32_t i = 0; i < N; ++i) {
+            c[i] += other.c[i];
+        }
+        return *this;
+    }
+
+    SphericalHarmonics& operator*=(float scale) {
+        for (T& v : c) {
+            v = v * scale;
+        }
+        return *this;
+    }
+
+    friend SphericalHarmonics operator+(SphericalHarmonics a, const SphericalHarmonics& b) { return a += b; }
+    friend SphericalHarmonics operator*(SphericalHarmonics a, float scale) { return a *= scale; }
+};
+
+using SH4 = SphericalHarmonics<float, 4>;
+using SH9 = SphericalHarmonics<float, 9>;
+using SH4RGB = SphericalHarmonics<Vector3, 4>;
+using SH9RGB = SphericalHarmonics<Vector3, 9>;
+
+// ============================================================================
+// 基函数与求值
+// ============================================================================
+
+/**
+ * @brief 9 个 L2 基函数（L1 取前 4 个）
+ * @param direction 单位向量
+ */
+void EvaluateSHBasis(const Vector3& direction, float basis[kSHMaxCoefficients]);
+
+/**
+ * @brief 在一个方向上求值
+ */
+template <typename SH>
+typename SH::Value EvaluateSH(const SH& sh, const Vector3& direction);
+
+/**
+ * @brief 在 count 个方向上求值（SoA 单位向量，SIMD）
+ * @param out count 个结果
+ */
+template <typename SH>
+void EvaluateSHBatch(const SH& sh, const float* x, const float* y, const float* z, uint32_t count,
+                     typename SH::Value* out);
+
+/**
+ * @brief 两个函数乘积在球面上的积分 ∫ f g dω（每通道）
+ */
+template <typename SH>
+typename SH::Value DotSH(const SH& a, const SH& b);
+
+// ============================================================================
+// 投影
+// ============================================================================
+
+/**
+ * @brief 累加来自 direction 的 δ 光源（∫ f = value）
+ */
+template <typename SH>
+void AddSHDirectional(SH& sh, const Vector3& direction, const typename SH::Value& value);
+
+/**
+ * @brief 累加均匀辐射度
+ */
+template <typename SH>
+void AddSHUniform(SH& sh, const typename SH::Value& radiance);
+
+/**
+ * @brief 累加以 axis 为轴的带谐函数（ZH）: 系数 c_lm = sqrt(4π / (2l+1)) * zonal[l] * Y_lm(axis) * value
+ * @param zonal 每个频带一个 ZH 系数（轴为 +z 时的 m = 0 系数）
+ */
+template <typename SH>
+void AddSHZonal(SH& sh, const Vector3& axis, const float* zonal, const typename SH::Value& value);
+
+/**
+ * @brief 累加均匀辐射度的球冠（球形光源、太阳圆盘）
+ * @param halfAngle 球冠半角（弧度）；接近 0 时退化为 δ 光源（∫ f = radiance * 立体角）
+ */
+template <typename SH>
+void AddSHCone(SH& sh, const Vector3& direction, float halfAngle, const typename SH::Value& radiance);
+
+/**
+ * @brief 投影立方体贴图
+ *
+ * 面顺序 +X, -X, +Y, -Y, +Z, -Z，每面 size x size 个纹素行优先，方向约定同 OpenGL / Vulkan
+ * 立方体贴图。纹素立体角按 1 / (1 + u² + v²)^(3/2) 近似，并归一化使总和为 4π
+ */
+SH9RGB ProjectCubemapToSH(const Vector3* const faces[6], uint32_t size);
+
+/**
+ * @brief 立方体贴图纹素中心的单位方向（与 ProjectCubemapToSH 同约定）
+ */
+Vector3 GetCubemapTexelDirection(uint32_t face, uint32_t x, uint32_t y, uint32_t size);
+
+// ============================================================================
+// 旋转
+// ============================================================================
+
+/**
+ * @brief SH 旋转（ZH 分解）
+ *
+ * 构造时计算 L1 的 3x3 和 L2 的 5x5 频带矩阵，之后每次旋转只是矩阵乘，可以复用于大量探针
+ */
+class SHRotation {
+public:
+    /**
+     * @param rotation 只使用左上 3x3（正交旋转）。旋转后的函数 g(ω) = f(R⁻¹ω)
+     */
+    explicit SHRotation(const Matrix4& rotation);
+
+    template <typename SH>
+    SH apply(const SH& sh) const;
+
+private:
+    float band1_[3][3];
+    float band2_[5][5];
+};
+
+// ============================================================================
+// 卷积与加窗
+// ============================================================================
+
+/**
+ * @brief Lambert 余弦卷积: 辐射度 → 辐照度（E(n) = ∫ L max(n·ω, 0) dω）
+ *
+ * 光照贴图约定的值（LightingData::calculateLightingAtPoint）为 E / π
+ */
+template <typename SH>
+SH ConvolveSHLambert(const SH& radiance);
+
+/**
+ * @brief 加窗函数
+ */
+enum class SHWindow {
+    /** (1 + cos(π l / w)) / 2 */
+    Hann,
+    /** sinc(π l / w) */
+    Lanczos
+};
+
+/**
+ * @brief 按频带衰减系数
+ * @param width 窗口宽度（频带 l >= width 的系数为 0）；默认 0 取 Bands + 1
+ */
+template <typename SH>
+void ApplySHWindow(SH& sh, SHWindow window, float width = 0.0f);
@@ -0,0 +1,87 @@
+/**
+ * @file StereoRendering.cpp
+ * @brief 单遍立体渲染实现
+ */
+
+#include "StereoRendering.h"
+
+#include <algorithm>
+
+namespace {
+
+/** 视锥体的8个角点 */
+void getCorners(const Frustum& frustum, Vector3* corners) {
+    for (int i = 0; i < 4; ++i) {
+        corners[i] = frustum.nearCorners[i];
+        corners[i + 4] = frustum.farCorners[i];
+    }
+}
+
+/** 平面需要外扩多少才能包含所有角点（>= 0） */
+float requiredSlack(const Plane& plane, const Vector3* corners, int cornerCount) {
+    float slack = 0.0f;
+    for (int i = 0; i < cornerCount; ++i) {
+        slack = std::max(slack, -plane.distanceToPoint(corners[i]));
+    }
+    return slack;
+}
+
+Plane combinePlanes(const Plane& a, const Plane& b, const Vector3* corners, int cornerCount) {
+    const float slackA = requiredSlack(a, corners, cornerCount);
+    const float slackB = requiredSlack(b, corners, cornerCount);
+
+    Plane plane = slackA <= slackB ? a : b;
+    plane.d += std::min(slackA, slackB);
+    return plane;
+}
+
+} // namespace
+
+Matrix4 MakeEyeViewMatrix(const Matrix4& centerView, float interpupillaryDistance, uint32_t eye) {
+    // 眼睛在相机空间中沿 x 偏移 ∓ipd/2，视图矩阵反向平移
+    const float offset = (eye == 0 ? 0.5f : -0.5f) * interpupillaryDistance;
+    return glm::translate(Matrix4(1.0f), Vector3(offset, 0.0f, 0.0f)) * centerView;
+}
+
+Frustum CombineFrustums(const Frustum& a, const Frustum& b) {
+    Vector3 corners[16];
+    getCorners(a, corners);
+    getCorners(b, corners + 8);
+
+    Frustum combined;
+    combined.left = combinePlanes(a.left, b.left, corners, 16);
+    combined.right = combinePlanes(a.right, b.right, corners, 16);
+    combined.bottom = combinePlanes(a.bottom, b.bottom, corners, 16);
+    combined.top = combinePlanes(a.top, b.top, corners, 16);
+    combined.near = combinePlanes(a.near, b.near, corners, 16);
+    combined.far = combinePlanes(a.far, b.far, corners, 16);
+
+    // 角点只用于调试绘制: 左侧取自 a，右侧取自 b
+    for (int i = 0; i < 4; ++i) {
+        const bool leftSide = (i & 1) == 0;
+        combined.nearCorners[i] = leftSide ? a.nearCorners[i] : b.nearCorners[i];
+        combined.farCorners[i] = leftSide ? a.farCorners[i] : b.farCorners[i];
+    }
+    return combined;
+}
+
+StereoSnapshot StereoSnapshot::build(const CameraSnapshotParams& left, const CameraSnapshotParams& right,
+                                     const StereoSnapshot* previous) {
+    StereoSnapshot stereo;
+    stereo.eyes[0] = CameraSnapshot::build(left, previous ? &previous->eyes[0] : nullptr);
+    stereo.eyes[1] = CameraSnapshot::build(right, previous ? &previous->eyes[1] : nullptr);
+
+    stereo.cullingPosition = (stereo.eyes[0].position + stereo.eyes[1].position) * 0.5f;
+    stereo.cullingFrustum = CombineFrustums(stereo.eyes[0].frustum, stereo.eyes[1].frustum);
+    stereo.cullingPlanes = FrustumPlanesSoA::fromFrustum(stereo.cullingFrustum);
+
+    for (uint32_t v = 0; v < ViewCount; ++v) {
+        const CameraSnapshot& eye = stereo.eyes[v];
+        stereo.constants.viewProjection[v] = eye.jittered.viewProjection;
+        stereo.constants.previousViewProjection[v] = eye.previous.viewProjection;
+        stereo.constants.view[v] = eye.jittered.view;
+        stereo.constants.projection[v] = eye.jittered.projection;
+        stereo.constants.cameraPosition[v] = Vector4(eye.position, 1.0f);
+    }
+    return stereo;
+}
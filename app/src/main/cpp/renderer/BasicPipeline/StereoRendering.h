@@ -0,0 +1,106 @@
+/**
+ * @file StereoRendering.h
+ * @brief 立体渲染的 CPU 端 - 两只眼共享一次剔除和一次排序
+ *
+ * 逐眼完整渲染两次会把场景遍历、剔除和排序全部重复一遍。本文件提供的部分:
+ * 1. 由两只眼的视锥体构建一个包含两者的合并剔除视锥体（CombineFrustums）
+ * 2. 用合并视锥体剔除一次，按中心眼距离排序一次（RenderQueueBuilder 的立体重载）
+ * 3. 按视图下标排列的每帧常量 MultiviewConstants
+ *
+ * multiview 渲染通道本身（viewMask = 0b11、按 gl_ViewIndex 广播绘制）不在本目录中，
+ * 需要由图形后端创建；BasicRenderer 目前也没有立体渲染入口。
+ * NullFrameRunner::renderStereoFrame 只模拟单遍录制（每个对象计一次绘制），
+ * 它的耗时不包含真实 multiview 通道的驱动和 GPU 开销
+ *
+ * 用法:
+ * @code
+ *
+ * // 主线程，每帧一次
+ * stereo_ = StereoSnapshot::build(leftParams, rightParams, &stereo_);
+ * renderingData_.stereoSnapshot = &stereo_;
+ * renderingData_.viewCount = StereoSnapshot::ViewCount;
+ * RenderQueueBuilder::build(storage, stereo_, queueManager);
+ *
+ * // 顶点着色器（由后端的 multiview 通道使用）
+ * // gl_Position = views.viewProjection[gl_ViewIndex] * worldPosition;
+ *
+ * @endcode
+ */
+
+#pragma once
+
+#include "CameraSnapshot.h"
+#include "Frustum.h"
+#include "../../MathTypes.h"
+#include <cstdint>
+
+/**
+ * @brief 按视图下标索引的每帧常量（std140 布局，着色器中用 gl_ViewIndex 索引）
+ */
+struct MultiviewConstants {
+    static constexpr uint32_t MaxViews = 2;
+
+    /** 光栅化使用（含抖动） */
+    Matrix4 viewProjection[MaxViews];
+
+    /** 上一帧的未抖动视图-投影矩阵（运动矢量） */
+    Matrix4 previousViewProjection[MaxViews];
+
+    Matrix4 view[MaxViews];
+    Matrix4 projection[MaxViews];
+
+    /** xyz: 眼睛的世界空间位置，w 未使用 */
+    Vector4 cameraPosition[MaxViews];
+};
+
+/**
+ * @brief 由中心眼视图矩阵得到一只眼的视图矩阵（平行双目）
+ *
+ * @param centerView 中心眼（头部）的视图矩阵
+ * @param interpupillaryDistance 瞳距（米）
+ * @param eye 0 为左眼，1 为右眼
+ */
+Matrix4 MakeEyeViewMatrix(const Matrix4& centerView, float interpupillaryDistance, uint32_t eye);
+
+/**
+ * @brief 构建同时包含两个视锥体的合并视锥体（保守）
+ *
+ * 每个平面在两只眼的对应平面中选择外扩最少的一个，再外扩到包含两个视锥体的全部角点。
+ * 平行双目时左平面取自左眼、右平面取自右眼，与两个视锥体的并集几乎一致
+ */
+Frustum CombineFrustums(const Frustum& a, const Frustum& b);
+
+/**
+ * @brief 不可变的每帧立体相机快照
+ */
+struct StereoSnapshot {
+    static constexpr uint32_t ViewCount = MultiviewConstants::MaxViews;
+
+    /** 左眼、右眼 */
+    CameraSnapshot eyes[ViewCount];
+
+    /** 中心眼位置（排序键、LOD） */
+    Vector3 cullingPosition = Vector3(0.0f);
+
+    /** 合并剔除视锥体 */
+    Frustum cullingFrustum;
+    FrustumPlanesSoA cullingPlanes;
+
+    /** 按视图下标排列的每帧常量（供后端的 multiview 渲染通道上传） */
+    MultiviewConstants constants;
+
+    /**
+     * @brief 构建快照
+     * @param previous 上一帧的快照（可为 nullptr；可以与返回值是同一个对象），
+     *                 每只眼的上一帧矩阵取自对应的眼睛
+     */
+    static StereoSnapshot build(const CameraSnapshotParams& left, const CameraSnapshotParams& right,
+                                const StereoSnapshot* previous = nullptr);
+
+    /**
+     * @brief 球体是否对任意一只眼可见（合并视锥体，保守）
+     */
+    bool isSphereVisible(const Vector3& center, float radius) const {
+        return cullingPlanes.intersectsSphere(center, radius);
+    }
+};
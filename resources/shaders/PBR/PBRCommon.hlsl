@@ -1,442 +1,947 @@
-/**
- * @file PBRCommon.hlsl
- * @brief PBR光照模型通用定义和常量
- *
- * 基于GGX/Cook-Torrance BRDF的物理渲染
- * 参考: Disney BRDF, UE4, Unity URP PBR
- */
-
-#ifndef PBR_COMMON_HLSL
-#define PBR_COMMON_HLSL
-
-// ============================================================================
-// 光照特性开关（用于Shader变体和调试）
-// ============================================================================
-
-/**
- * 这些宏定义在编译时确定，通过shader变体系统切换
- * 运行时可通过uniform变量控制开关
- */
-
-// 直接光照开关
-#ifndef ENABLE_DIRECT_LIGHTING
-#define ENABLE_DIRECT_LIGHTING 1
-#endif
-
-// 间接光照开关
-#ifndef ENABLE_INDIRECT_LIGHTING
-#define ENABLE_INDIRECT_LIGHTING 0  // TODO: 暂未实现
-#endif
-
-// 全局反射开关
-#ifndef ENABLE_GLOBAL_REFLECTION
-#define ENABLE_GLOBAL_REFLECTION 0  // TODO: 暂未实现
-#endif
-
-// 全局阴影开关
-#ifndef ENABLE_GLOBAL_SHADOW
-#define ENABLE_GLOBAL_SHADOW 1
-#endif
-
-// 环境光遮蔽开关
-#ifndef ENABLE_AO
-#define ENABLE_AO 0
-#endif
-
-// 发光开关
-#ifndef ENABLE_EMISSION
-#define ENABLE_EMISSION 1
-#endif
-
-// ============================================================================
-
-// ============================================================================
-// 数学常量
-// ============================================================================
-
-#define PI 3.14159265359
-#define TWO_PI 6.28318530718
-#define INV_PI 0.31830988618
-#define HALF_PI 1.57079632679
-
-// ============================================================================
-
-// ============================================================================
-// 光照模型结构
-// ============================================================================
-
-/**
- * @brief 材质属性
- */
-struct MaterialAttributes {
-    // 基础颜色（反照率）
-    float3 albedo;
-
-    // 金属度 (0.0 = 介电质, 1.0 = 金属)
-    float metallic;
-
-    // 粗糙度 (0.0 = 光滑, 1.0 = 粗糙)
-    float roughness;
-
-    // 表面反射率（用于非金属）
-    float3 specular;
-
-    // 发光颜色
-    float3 emission;
-
-    // 环境光遮蔽 (0.0 = 全遮蔽, 1.0 = 无遮蔽)
-    float occlusion;
-
-    // Alpha裁剪阈值
-    float alphaClipThreshold;
-
-    // 是否使用Alpha测试
-    bool useAlphaClip;
-};
-
-/**
- * @brief 光照输入数据
- */
-struct LightInput {
-    // 光源方向（指向光源）
-    float3 direction;
-
-    // 光源颜色（已包含强度）
-    float3 color;
-
-    // 衰减距离（点光源/聚光灯）
-    float distanceAttenuation;
-
-    // 聚光灯角度衰减（聚光灯）
-    float spotAttenuation;
-
-    // 阴影衰减
-    float shadowAttenuation;
-};
-
-/**
- * @brief BRDF参数
- */
-struct BRDFData {
-    float3 diffuse;      // 漫反射反射率
-    float3 specular;     // 镜面反射率
-    float perceptualRoughness;  // 感知粗糙度
-    float roughness;     // 线性粗糙度
-    float roughness2;    // 粗糙度平方
-    float normalizationTerm;    // 镜面反射归一化项
-    float3 grazingTerm;         // 菲涅尔掠射项
-};
-
-// ============================================================================
-// 函数声明
-// ============================================================================
-
-/**
- * @brief 初始化BRDF数据
- *
- * @param material 材质属性
- * @return BRDF数据
- */
-BRDFData InitializeBRDFData(MaterialAttributes material);
-
-/**
- * @brief GGX分布函数 (Trowbridge-Reitz)
- *
- * 描述微表面法线分布
- *
- * @param N 表面法线
- * @param H 半程向量
- * @param roughness 粗糙度
- * @return 分布值 D(N, H)
- */
-float DistributionGGX(float3 N, float3 H, float roughness);
-
-/**
- * @brief 几何遮蔽函数 (Smith)
- *
- * 描述微表面自遮挡
- *
- * @param N 表面法线
- * @param V 视线方向
- * @param L 光照方向
- * @param roughness 粗糙度
- * @return 几何因子 G(N, V, L)
- */
-float GeometrySmith(float3 N, float3 V, float3 L, float roughness);
-
-/**
- * @brief 单向几何遮蔽函数 (Schlick-GGX)
- *
- * @param N 表面法线
- * @param V 视线方向或光照方向
- * @param roughness 粗糙度
- * @return 几何因子
- */
-float GeometrySchlickGGX(float3 N, float3 V, float roughness);
-
-/**
- * @brief 菲涅尔反射函数 (Schlick近似)
- *
- * @param F0 入射角为0度的反射率
- * @param V 视线方向
- * @param H 半程向量
- * @return 菲涅尔反射率 F(V, H)
- */
-float3 FresnelSchlick(float3 F0, float3 V, float3 H);
-
-/**
- * @brief 带粗糙度的菲涅尔反射函数
- *
- * 用于环境光和间接光
- *
- * @param F0 入射角为0度的反射率
- * @param V 视线方向
- * @param roughness 粗糙度
- * @return 菲涅尔反射率
- */
-float3 FresnelSchlickRoughness(float3 F0, float3 V, float roughness);
-
-/**
- * @brief Cook-Torrance BRDF
- *
- * 镜面反射BRDF = D * F * G / (4 * (N·L) * (N·V))
- *
- * @param N 表面法线
- * @param V 视线方向
- * @param L 光照方向
- * @param brdfData BRDF数据
- * @return 镜面反射颜色
- */
-float3 SpecularBRDF(float3 N, float3 V, float3 L, BRDFData brdfData);
-
-/**
- * @brief Lambert漫反射BRDF
- *
- * 漫反射BRDF = albedo / PI
- *
- * @param brdfData BRDF数据
- * @return 漫反射颜色
- */
-float3 DiffuseBRDF(BRDFData brdfData);
-
-/**
- * @brief 计算直接光照
- *
- * @param lightInput 光照输入
- * @param N 表面法线
- * @param V 视线方向
- * @param brdfData BRDF数据
- * @return 光照颜色
- */
-float3 CalculateDirectLighting(LightInput lightInput, float3 N, float3 V, BRDFData brdfData);
-
-/**
- * @brief 计算间接光照（环境光）
- *
- * TODO: 实现光照探针和光照贴图
- *
- * @param N 表面法线
- * @param V 视线方向
- * @param brdfData BRDF数据
- * @param material 材质属性
- * @return 间接光颜色
- */
-float3 CalculateIndirectLighting(float3 N, float3 V, BRDFData brdfData, MaterialAttributes material);
-
-/**
- * @brief 计算全局反射（屏幕空间反射或反射探针）
- *
- * TODO: 实现SSR或反射探针
- *
- * @param N 表面法线
- * @param V 视线方向
- * @param roughness 粗糙度
- * @param positionWS 世界空间位置
- * @return 反射颜色
- */
-float3 CalculateGlobalReflection(float3 N, float3 V, float roughness, float3 positionWS);
-
-/**
- * @brief 计算阴影衰减
- *
- * TODO: 实现阴影贴图采样
- *
- * @param positionWS 世界空间位置
- * @param lightIndex 光源索引
- * @return 阴影衰减 (0.0 = 全阴影, 1.0 = 无阴影)
- */
-float CalculateShadowAttenuation(float3 positionWS, int lightIndex);
-
-// ============================================================================
-// 实现（在include此文件后可用）
-// ============================================================================
-
-BRDFData InitializeBRDFData(MaterialAttributes material) {
-    BRDFData data;
-
-    // 计算感知粗糙度
-    data.perceptualRoughness = material.roughness;
-
-    // 计算线性粗糙度
-    data.roughness = data.perceptualRoughness * data.perceptualRoughness;
-
-    // 粗糙度平方（用于优化）
-    data.roughness2 = data.roughness * data.roughness;
-
-    // 计算菲涅尔F0（0度入射角的反射率）
-    float3 F0 = lerp(material.specular, material.albedo, material.metallic);
-
-    // 漫反射反射率（金属没有漫反射）
-    data.diffuse = lerp(material.albedo, (float3)0.0, material.metallic);
-
-    // 镜面反射反射率
-    data.specular = F0;
-
-    // 归一化项
-    float roughness2 = data.roughness2;
-    float normalizationTerm = data.roughness / (roughness2 + 1.0) * (4.0 / PI) + 0.0001;
-    data.normalizationTerm = normalizationTerm;
-
-    // 掠射项
-    float3 reflectance = max(max(data.specular.r, data.specular.g), data.specular.b);
-    float grazingTerm = saturate((1.0 - data.perceptualRoughness) + reflectance);
-    data.grazingTerm = (float3)grazingTerm;
-
-    return data;
-}
-
-float DistributionGGX(float3 N, float3 H, float roughness) {
-    float a = roughness * roughness;
-    float a2 = a * a;
-    float NdotH = max(dot(N, H), 0.0);
-    float NdotH2 = NdotH * NdotH;
-
-    float num = a2;
-    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
-    denom = PI * denom * denom;
-
-    return num / denom;
-}
-
-float GeometrySchlickGGX(float3 N, float3 V, float roughness) {
-    float NdotV = max(dot(N, V), 0.0);
-    float r = (roughness + 1.0);
-    float k = (r * r) / 8.0;
-
-    float num = NdotV;
-    float denom = NdotV * (1.0 - k) + k;
-
-    return num / denom;
-}
-
-float GeometrySmith(float3 N, float3 V, float3 L, float roughness) {
-    float ggx2 = GeometrySchlickGGX(N, V, roughness);
-    float ggx1 = GeometrySchlickGGX(N, L, roughness);
-
-    return ggx1 * ggx2;
-}
-
-float3 FresnelSchlick(float3 F0, float3 V, float3 H) {
-    float cosTheta = max(dot(V, H), 0.0);
-    float x = 1.0 - cosTheta;
-    float x5 = x * x;
-    x5 = x5 * x5 * x;
-
-    return F0 + (1.0 - F0) * x5;
-}
-
-float3 FresnelSchlickRoughness(float3 F0, float3 V, float roughness) {
-    float cosTheta = max(dot(V, float3(0, 0, 1)), 0.0);
-    float x = 1.0 - cosTheta;
-    float x5 = x * x;
-    x5 = x5 * x5 * x;
-
-    return F0 + (max((float3)(1.0 - roughness), F0) - F0) * x5;
-}
-
-float3 SpecularBRDF(float3 N, float3 V, float3 L, BRDFData brdfData) {
-    float3 H = normalize(V + L);
-
-    // GGX分布
-    float D = DistributionGGX(N, H, brdfData.roughness);
-
-    // Smith几何遮蔽
-    float G = GeometrySmith(N, V, L, brdfData.roughness);
-
-    // Schlick菲涅尔
-    float3 F = FresnelSchlick(brdfData.specular, V, H);
-
-    // Cook-Torrance BRDF
-    float3 numerator = D * F * G;
-    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
-    float3 specular = numerator / denominator;
-
-    return specular * brdfData.normalizationTerm;
-}
-
-float3 DiffuseBRDF(BRDFData brdfData) {
-    return brdfData.diffuse * INV_PI;
-}
-
-float3 CalculateDirectLighting(LightInput lightInput, float3 N, float3 V, BRDFData brdfData) {
-#if ENABLE_DIRECT_LIGHTING
-    float3 L = lightInput.direction;
-    float3 H = normalize(V + L);
-
-    float NdotL = max(dot(N, L), 0.0);
-    float NdotV = max(dot(N, V), 0.0);
-
-    if (NdotL <= 0.0 || NdotV <= 0.0) {
-        return (float3)0.0;
-    }
-
-    // 计算BRDF
-    float3 diffuse = DiffuseBRDF(brdfData);
-    float3 specular = SpecularBRDF(N, V, L, brdfData);
-
-    // 组合漫反射和镜面反射
-    float3 brdf = diffuse + specular;
-
-    // 应用光照颜色和衰减
-    float3 lightColor = lightInput.color;
-    float attenuation = lightInput.distanceAttenuation * lightInput.spotAttenuation;
-
-#if ENABLE_GLOBAL_SHADOW
-    attenuation *= lightInput.shadowAttenuation;
-#endif
-
-    return brdf * lightColor * attenuation * NdotL;
-#else
-    return (float3)0.0;
-#endif
-}
-
-float3 CalculateIndirectLighting(float3 N, float3 V, BRDFData brdfData, MaterialAttributes material) {
-#if ENABLE_INDIRECT_LIGHTING
-    // TODO: 实现光照探针、光照贴图
-    // 暂时使用简单的环境光
-    return (float3)0.0;
-#else
-    return (float3)0.0;
-#endif
-}
-
-float3 CalculateGlobalReflection(float3 N, float3 V, float roughness, float3 positionWS) {
-#if ENABLE_GLOBAL_REFLECTION
-    // TODO: 实现屏幕空间反射或反射探针
-    return (float3)0.0;
-#else
-    return (float3)0.0;
-#endif
-}
-
-float CalculateShadowAttenuation(float3 positionWS, int lightIndex) {
-#if ENABLE_GLOBAL_SHADOW
-    // TODO: 实现阴影贴图采样
-    return 1.0;  // 暂无阴影
-#else
-    return 1.0;
-#endif
-}
-
-#endif // PBR_COMMON_HLSL
+/**
+ * @file PBRCommon.hlsl
+ * @brief PBR光照模型通用定义和常量
+ *
+ * 基于GGX/Cook-Torrance BRDF的物理渲染
+ * 参考: Disney BRDF, UE4, Unity URP PBR
+ */
+
+#ifndef PBR_COMMON_HLSL
+#define PBR_COMMON_HLSL
+
+// ============================================================================
+// 光照特性开关（用于Shader变体和调试）
+// ============================================================================
+
+/**
+ * 这些宏定义在编译时确定，通过shader变体系统切换
+ * 运行时可通过uniform变量控制开关
+ */
+
+// 直接光照开关
+#ifndef ENABLE_DIRECT_LIGHTING
+#define ENABLE_DIRECT_LIGHTING 1
+#endif
+
+// 间接光照开关（只有调用方传入的均匀环境光，光照探针与光照贴图暂未实现）
+#ifndef ENABLE_INDIRECT_LIGHTING
+#define ENABLE_INDIRECT_LIGHTING 0
+#endif
+
+// 全局反射开关
+#ifndef ENABLE_GLOBAL_REFLECTION
+#define ENABLE_GLOBAL_REFLECTION 0  // TODO: 暂未实现
+#endif
+
+// 全局阴影开关
+#ifndef ENABLE_GLOBAL_SHADOW
+#define ENABLE_GLOBAL_SHADOW 1
+#endif
+
+// 环境光遮蔽开关
+#ifndef ENABLE_AO
+#define ENABLE_AO 0
+#endif
+
+// 烘焙环境光遮蔽开关（AoBaker 的顶点遮蔽或 shadowmask 的 a 通道，只作用于间接光，需同时开启 ENABLE_INDIRECT_LIGHTING）
+#ifndef ENABLE_BAKED_AO
+#define ENABLE_BAKED_AO 0
+#endif
+
+// Shadowmask 开关（光照贴图静态接收者的 Mixed 光源: 静态投射者的阴影来自烘焙的 shadowmask）
+#ifndef ENABLE_SHADOWMASK
+#define ENABLE_SHADOWMASK 0
+#endif
+
+// 发光开关
+#ifndef ENABLE_EMISSION
+#define ENABLE_EMISSION 1
+#endif
+
+// 区域光（LTC）开关
+#ifndef ENABLE_AREA_LIGHTS
+#define ENABLE_AREA_LIGHTS 1
+#endif
+
+// ============================================================================
+
+// ============================================================================
+// 数学常量
+// ============================================================================
+
+#define PI 3.14159265359
+#define TWO_PI 6.28318530718
+#define INV_PI 0.31830988618
+#define HALF_PI 1.57079632679
+
+// LTC 查找表（assets/textures/LTC/ltc_1.ktx、ltc_2.ktx，与 AreaLighting.h 的 kLtcTableSize 一致）
+#define LTC_LUT_SIZE 64.0
+#define LTC_LUT_SCALE ((LTC_LUT_SIZE - 1.0) / LTC_LUT_SIZE)
+#define LTC_LUT_BIAS (0.5 / LTC_LUT_SIZE)
+
+// ============================================================================
+
+// ============================================================================
+// 光照模型结构
+// ============================================================================
+
+/**
+ * @brief 材质属性
+ */
+struct MaterialAttributes {
+    // 基础颜色（反照率）
+    float3 albedo;
+
+    // 金属度 (0.0 = 介电质, 1.0 = 金属)
+    float metallic;
+
+    // 粗糙度 (0.0 = 光滑, 1.0 = 粗糙)
+    float roughness;
+
+    // 表面反射率（用于非金属）
+    float3 specular;
+
+    // 发光颜色
+    float3 emission;
+
+    // 环境光遮蔽 (0.0 = 全遮蔽, 1.0 = 无遮蔽)
+    float occlusion;
+
+    // Alpha裁剪阈值
+    float alphaClipThreshold;
+
+    // 是否使用Alpha测试
+    bool useAlphaClip;
+};
+
+/**
+ * @brief 光照输入数据
+ */
+struct LightInput {
+    // 光源方向（指向光源）
+    float3 direction;
+
+    // 光源颜色（已包含强度）
+    float3 color;
+
+    // 衰减距离（点光源/聚光灯）
+    float distanceAttenuation;
+
+    // 聚光灯角度衰减（聚光灯）
+    float spotAttenuation;
+
+    // 阴影衰减
+    float shadowAttenuation;
+};
+
+/**
+ * @brief 区域光输入数据（同 LightData 的区域光字段）
+ */
+struct AreaLightInput {
+    // 发光面中心
+    float3 position;
+
+    // 发光面法线（正面朝向）
+    float3 normal;
+
+    // 宽度方向（与法线正交）
+    float3 tangent;
+
+    // 宽、高（圆盘为两个方向的直径）
+    float2 size;
+
+    // 辐射亮度（已包含强度）
+    float3 color;
+
+    // 平滑截断半径
+    float range;
+
+    // 0 = 矩形, 1 = 圆盘
+    int shape;
+
+    // 背面也发光
+    bool twoSided;
+};
+
+/**
+ * @brief BRDF参数
+ */
+struct BRDFData {
+    float3 diffuse;      // 漫反射反射率
+    float3 specular;     // 镜面反射率
+    float perceptualRoughness;  // 感知粗糙度
+    float roughness;     // 线性粗糙度
+    float roughness2;    // 粗糙度平方
+    float normalizationTerm;    // 镜面反射归一化项
+    float3 grazingTerm;         // 菲涅尔掠射项
+};
+
+// ============================================================================
+// 函数声明
+// ============================================================================
+
+/**
+ * @brief 初始化BRDF数据
+ *
+ * @param material 材质属性
+ * @return BRDF数据
+ */
+BRDFData InitializeBRDFData(MaterialAttributes material);
+
+/**
+ * @brief GGX分布函数 (Trowbridge-Reitz)
+ *
+ * 描述微表面法线分布
+ *
+ * @param N 表面法线
+ * @param H 半程向量
+ * @param roughness 粗糙度
+ * @return 分布值 D(N, H)
+ */
+float DistributionGGX(float3 N, float3 H, float roughness);
+
+/**
+ * @brief 几何遮蔽函数 (Smith)
+ *
+ * 描述微表面自遮挡
+ *
+ * @param N 表面法线
+ * @param V 视线方向
+ * @param L 光照方向
+ * @param roughness 粗糙度
+ * @return 几何因子 G(N, V, L)
+ */
+float GeometrySmith(float3 N, float3 V, float3 L, float roughness);
+
+/**
+ * @brief 单向几何遮蔽函数 (Schlick-GGX)
+ *
+ * @param N 表面法线
+ * @param V 视线方向或光照方向
+ * @param roughness 粗糙度
+ * @return 几何因子
+ */
+float GeometrySchlickGGX(float3 N, float3 V, float roughness);
+
+/**
+ * @brief 菲涅尔反射函数 (Schlick近似)
+ *
+ * @param F0 入射角为0度的反射率
+ * @param V 视线方向
+ * @param H 半程向量
+ * @return 菲涅尔反射率 F(V, H)
+ */
+float3 FresnelSchlick(float3 F0, float3 V, float3 H);
+
+/**
+ * @brief 带粗糙度的菲涅尔反射函数
+ *
+ * 用于环境光和间接光
+ *
+ * @param F0 入射角为0度的反射率
+ * @param V 视线方向
+ * @param roughness 粗糙度
+ * @return 菲涅尔反射率
+ */
+float3 FresnelSchlickRoughness(float3 F0, float3 V, float roughness);
+
+/**
+ * @brief Cook-Torrance BRDF
+ *
+ * 镜面反射BRDF = D * F * G / (4 * (N·L) * (N·V))
+ *
+ * @param N 表面法线
+ * @param V 视线方向
+ * @param L 光照方向
+ * @param brdfData BRDF数据
+ * @return 镜面反射颜色
+ */
+float3 SpecularBRDF(float3 N, float3 V, float3 L, BRDFData brdfData);
+
+/**
+ * @brief Lambert漫反射BRDF
+ *
+ * 漫反射BRDF = albedo / PI
+ *
+ * @param brdfData BRDF数据
+ * @return 漫反射颜色
+ */
+float3 DiffuseBRDF(BRDFData brdfData);
+
+/**
+ * @brief 计算直接光照
+ *
+ * @param lightInput 光照输入
+ * @param N 表面法线
+ * @param V 视线方向
+ * @param brdfData BRDF数据
+ * @return 光照颜色
+ */
+float3 CalculateDirectLighting(LightInput lightInput, float3 N, float3 V, BRDFData brdfData);
+
+/**
+ * @brief 均匀环境光下镜面反射的方向反照率（Karis 2014 的移动端解析近似）
+ *
+ * @param F0 入射角为0度的反射率
+ * @param perceptualRoughness 感知粗糙度
+ * @param NdotV 法线与视线夹角的余弦
+ * @return 方向反照率
+ */
+float3 EnvironmentBRDFApprox(float3 F0, float perceptualRoughness, float NdotV);
+
+/**
+ * @brief 计算间接光照（环境光）
+ *
+ * 环境光视为均匀天空，与 LightingData::calculateLightingAtPoint、LightmapBaker 的天空一致。
+ * 漫反射与镜面项都乘 material.occlusion（遮蔽贴图与烘焙的环境光遮蔽）。
+ * 本文件不声明常量缓冲，ambientRadiance 由调用方从自己的每帧常量传入
+ *
+ * @param N 表面法线
+ * @param V 视线方向
+ * @param brdfData BRDF数据
+ * @param material 材质属性
+ * @param ambientRadiance 环境光辐射亮度（LightingData::ambientColor * ambientIntensity）
+ * @return 间接光颜色
+ */
+float3 CalculateIndirectLighting(float3 N, float3 V, BRDFData brdfData, MaterialAttributes material,
+                                 float3 ambientRadiance);
+
+/**
+ * @brief 把烘焙的环境光遮蔽乘到材质遮蔽上
+ *
+ * 静态网格的遮蔽由 AoBaker 离线烘焙: 每顶点 8 位（顶点属性 UNORM8，插值后传入），
+ * 或光照贴图网格的 shadowmask.a（BakeSettings::occlusion）。与 SSAO 不同，
+ * 它只作用于间接光（ENABLE_INDIRECT_LIGHTING 关闭时没有效果），不随相机变化
+ *
+ * @param material 材质属性（occlusion 已包含遮蔽贴图）
+ * @param bakedOcclusion 烘焙的遮蔽 (0.0 = 全遮蔽, 1.0 = 无遮蔽)
+ */
+void ApplyBakedOcclusion(inout MaterialAttributes material, float bakedOcclusion);
+
+/**
+ * @brief 计算全局反射（屏幕空间反射或反射探针）
+ *
+ * TODO: 实现SSR或反射探针
+ *
+ * @param N 表面法线
+ * @param V 视线方向
+ * @param roughness 粗糙度
+ * @param positionWS 世界空间位置
+ * @return 反射颜色
+ */
+float3 CalculateGlobalReflection(float3 N, float3 V, float roughness, float3 positionWS);
+
+/**
+ * @brief 计算阴影衰减
+ *
+ * TODO: 实现阴影贴图采样
+ *
+ * @param positionWS 世界空间位置
+ * @param lightIndex 光源索引
+ * @return 阴影衰减 (0.0 = 全阴影, 1.0 = 无阴影)
+ */
+float CalculateShadowAttenuation(float3 positionWS, int lightIndex);
+
+/**
+ * @brief 读取光源的烘焙 shadowmask 可见度
+ *
+ * @param lightmapUV 光照贴图UV（与光照贴图相同的图集坐标）
+ * @param channel LightData::shadowmaskChannel（< 0 表示没有通道）
+ * @return 静态投射者的阴影 (0.0 = 全阴影, 1.0 = 无阴影)
+ */
+float SampleShadowmask(float2 lightmapUV, int channel);
+
+/**
+ * @brief 合并实时阴影与烘焙的 shadowmask（与 CPU 的 ShadowSettings::combineShadowmask 一致）
+ *
+ * 启用 shadowmask 后实时阴影贴图只包含动态投射者，静态投射者只在 shadowmask 中，
+ * 因此实时阴影距离内取两者的较小值；实时阴影在距离末端 fadeDistance 内淡出到 1，
+ * 之外只剩 shadowmask
+ *
+ * @param realtimeShadow 实时阴影衰减（动态投射者）
+ * @param bakedShadow shadowmask 可见度（静态投射者）
+ * @param viewDistance 到相机的距离
+ * @param realtimeDistance ShadowSettings::getRealtimeShadowDistance
+ * @param fadeDistance ShadowSettings::shadowFadeDistance
+ * @return 阴影衰减 (0.0 = 全阴影, 1.0 = 无阴影)
+ */
+float CombineShadowmask(float realtimeShadow, float bakedShadow, float viewDistance,
+                        float realtimeDistance, float fadeDistance);
+
+/**
+ * @brief Mixed 光源在光照贴图静态接收者上的阴影衰减
+ *
+ * ENABLE_SHADOWMASK 时按 CombineShadowmask 合并实时阴影与 shadowmask，否则等同于 CalculateShadowAttenuation。
+ * 动态接收者没有光照贴图UV，只使用实时阴影
+ */
+float CalculateShadowmaskAttenuation(float3 positionWS, int lightIndex, float2 lightmapUV, int shadowmaskChannel,
+                                     float viewDistance, float realtimeDistance, float fadeDistance);
+
+/**
+ * @brief 计算区域光照（LTC，Heitz 2016 / Heitz & Hill 2017）
+ *
+ * 与 CPU 的 EvaluateAreaLightLtc 逐步一致:
+ * - 矩形: 四个角点经 M⁻¹ 变换后裁剪到地平线以上，对边积分求和
+ * - 圆盘: 变换后的椭圆求等效球体，查 LtcAmplitudeLut.w 得到地平线裁剪后的形状因子
+ * 漫反射使用同样的积分（M⁻¹ 为单位矩阵），不受阴影影响
+ * 镜面项在 N·V ≥ 0.5（kLtcMinValidNdotV）时误差为 3-10%（按粗糙度，粗糙度 0.5 附近最大），
+ * 更掠射的视角为 10-50%（各粗糙度的实测值见 AreaLighting.h）
+ *
+ * @param light 区域光输入
+ * @param positionWS 世界空间位置
+ * @param N 表面法线
+ * @param V 视线方向
+ * @param brdfData BRDF数据
+ * @return 光照颜色
+ */
+float3 CalculateAreaLighting(AreaLightInput light, float3 positionWS, float3 N, float3 V, BRDFData brdfData);
+
+// ============================================================================
+// 实现（在include此文件后可用）
+// ============================================================================
+
+BRDFData InitializeBRDFData(MaterialAttributes material) {
+    BRDFData data;
+
+    // 计算感知粗糙度
+    data.perceptualRoughness = material.roughness;
+
+    // 计算线性粗糙度
+    data.roughness = data.perceptualRoughness * data.perceptualRoughness;
+
+    // 粗糙度平方（用于优化）
+    data.roughness2 = data.roughness * data.roughness;
+
+    // 计算菲涅尔F0（0度入射角的反射率）
+    float3 F0 = lerp(material.specular, material.albedo, material.metallic);
+
+    // 漫反射反射率（金属没有漫反射）
+    data.diffuse = lerp(material.albedo, (float3)0.0, material.metallic);
+
+    // 镜面反射反射率
+    data.specular = F0;
+
+    // 归一化项
+    float roughness2 = data.roughness2;
+    float normalizationTerm = data.roughness / (roughness2 + 1.0) * (4.0 / PI) + 0.0001;
+    data.normalizationTerm = normalizationTerm;
+
+    // 掠射项
+    float3 reflectance = max(max(data.specular.r, data.specular.g), data.specular.b);
+    float grazingTerm = saturate((1.0 - data.perceptualRoughness) + reflectance);
+    data.grazingTerm = (float3)grazingTerm;
+
+    return data;
+}
+
+float DistributionGGX(float3 N, float3 H, float roughness) {
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH * NdotH;
+
+    float num = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return num / denom;
+}
+
+float GeometrySchlickGGX(float3 N, float3 V, float roughness) {
+    float NdotV = max(dot(N, V), 0.0);
+    float r = (roughness + 1.0);
+    float k = (r * r) / 8.0;
+
+    float num = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+
+    return num / denom;
+}
+
+float GeometrySmith(float3 N, float3 V, float3 L, float roughness) {
+    float ggx2 = GeometrySchlickGGX(N, V, roughness);
+    float ggx1 = GeometrySchlickGGX(N, L, roughness);
+
+    return ggx1 * ggx2;
+}
+
+float3 FresnelSchlick(float3 F0, float3 V, float3 H) {
+    float cosTheta = max(dot(V, H), 0.0);
+    float x = 1.0 - cosTheta;
+    float x5 = x * x;
+    x5 = x5 * x5 * x;
+
+    return F0 + (1.0 - F0) * x5;
+}
+
+float3 FresnelSchlickRoughness(float3 F0, float3 V, float roughness) {
+    float cosTheta = max(dot(V, float3(0, 0, 1)), 0.0);
+    float x = 1.0 - cosTheta;
+    float x5 = x * x;
+    x5 = x5 * x5 * x;
+
+    return F0 + (max((float3)(1.0 - roughness), F0) - F0) * x5;
+}
+
+float3 SpecularBRDF(float3 N, float3 V, float3 L, BRDFData brdfData) {
+    float3 H = normalize(V + L);
+
+    // GGX分布
+    float D = DistributionGGX(N, H, brdfData.roughness);
+
+    // Smith几何遮蔽
+    float G = GeometrySmith(N, V, L, brdfData.roughness);
+
+    // Schlick菲涅尔
+    float3 F = FresnelSchlick(brdfData.specular, V, H);
+
+    // Cook-Torrance BRDF
+    float3 numerator = D * F * G;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    float3 specular = numerator / denominator;
+
+    return specular * brdfData.normalizationTerm;
+}
+
+float3 DiffuseBRDF(BRDFData brdfData) {
+    return brdfData.diffuse * INV_PI;
+}
+
+float3 CalculateDirectLighting(LightInput lightInput, float3 N, float3 V, BRDFData brdfData) {
+#if ENABLE_DIRECT_LIGHTING
+    float3 L = lightInput.direction;
+    float3 H = normalize(V + L);
+
+    float NdotL = max(dot(N, L), 0.0);
+    float NdotV = max(dot(N, V), 0.0);
+
+    if (NdotL <= 0.0 || NdotV <= 0.0) {
+        return (float3)0.0;
+    }
+
+    // 计算BRDF
+    float3 diffuse = DiffuseBRDF(brdfData);
+    float3 specular = SpecularBRDF(N, V, L, brdfData);
+
+    // 组合漫反射和镜面反射
+    float3 brdf = diffuse + specular;
+
+    // 应用光照颜色和衰减
+    float3 lightColor = lightInput.color;
+    float attenuation = lightInput.distanceAttenuation * lightInput.spotAttenuation;
+
+#if ENABLE_GLOBAL_SHADOW
+    attenuation *= lightInput.shadowAttenuation;
+#endif
+
+    return brdf * lightColor * attenuation * NdotL;
+#else
+    return (float3)0.0;
+#endif
+}
+
+float3 EnvironmentBRDFApprox(float3 F0, float perceptualRoughness, float NdotV) {
+    const float4 c0 = float4(-1.0, -0.0275, -0.572, 0.022);
+    const float4 c1 = float4(1.0, 0.0425, 1.04, -0.04);
+    float4 r = perceptualRoughness * c0 + c1;
+    float a004 = min(r.x * r.x, exp2(-9.28 * NdotV)) * r.x + r.y;
+    float2 AB = float2(-1.04, 1.04) * a004 + r.zw;
+    return F0 * AB.x + AB.y;
+}
+
+float3 CalculateIndirectLighting(float3 N, float3 V, BRDFData brdfData, MaterialAttributes material,
+                                 float3 ambientRadiance) {
+#if ENABLE_INDIRECT_LIGHTING
+    // 均匀天空: 辐照度为 π * ambientRadiance，Lambert 漫反射为 反照率 * ambientRadiance
+    float NdotV = saturate(dot(N, V));
+    float3 diffuse = brdfData.diffuse * ambientRadiance;
+    float3 specular = EnvironmentBRDFApprox(brdfData.specular, brdfData.perceptualRoughness, NdotV) * ambientRadiance;
+    float3 ambient = diffuse + specular;
+#if ENABLE_AO || ENABLE_BAKED_AO
+    ambient *= material.occlusion;
+#endif
+    return ambient;
+#else
+    return (float3)0.0;
+#endif
+}
+
+void ApplyBakedOcclusion(inout MaterialAttributes material, float bakedOcclusion) {
+#if ENABLE_BAKED_AO
+    material.occlusion *= saturate(bakedOcclusion);
+#endif
+}
+
+float3 CalculateGlobalReflection(float3 N, float3 V, float roughness, float3 positionWS) {
+#if ENABLE_GLOBAL_REFLECTION
+    // TODO: 实现屏幕空间反射或反射探针
+    return (float3)0.0;
+#else
+    return (float3)0.0;
+#endif
+}
+
+float CalculateShadowAttenuation(float3 positionWS, int lightIndex) {
+#if ENABLE_GLOBAL_SHADOW
+    // TODO: 实现阴影贴图采样
+    return 1.0;  // 暂无阴影
+#else
+    return 1.0;
+#endif
+}
+
+#if ENABLE_SHADOWMASK
+
+// LightmapBaker 输出的 <prefix>_<图集编号>_shadowmask.ktx（每通道一个 Mixed 光源，
+// BakeSettings::occlusion 时 a 为环境光遮蔽），与光照贴图共用UV
+Texture2D ShadowmaskTexture;
+SamplerState ShadowmaskSampler;
+
+float SampleShadowmask(float2 lightmapUV, int channel) {
+    if (channel < 0 || channel > 3) {
+        return 1.0;
+    }
+    float4 mask = ShadowmaskTexture.Sample(ShadowmaskSampler, lightmapUV);
+    return mask[channel];
+}
+
+#else
+
+float SampleShadowmask(float2 lightmapUV, int channel) {
+    return 1.0;
+}
+
+#endif
+
+float CombineShadowmask(float realtimeShadow, float bakedShadow, float viewDistance,
+                        float realtimeDistance, float fadeDistance) {
+    float fadeRange = max(min(fadeDistance, realtimeDistance), 1e-4);
+    float realtimeWeight = saturate((realtimeDistance - viewDistance) / fadeRange);
+    return min(bakedShadow, lerp(1.0, realtimeShadow, realtimeWeight));
+}
+
+float CalculateShadowmaskAttenuation(float3 positionWS, int lightIndex, float2 lightmapUV, int shadowmaskChannel,
+                                     float viewDistance, float realtimeDistance, float fadeDistance) {
+    float realtimeShadow = CalculateShadowAttenuation(positionWS, lightIndex);
+#if ENABLE_SHADOWMASK
+    if (shadowmaskChannel >= 0) {
+        float bakedShadow = SampleShadowmask(lightmapUV, shadowmaskChannel);
+        return CombineShadowmask(realtimeShadow, bakedShadow, viewDistance, realtimeDistance, fadeDistance);
+    }
+#endif
+    return realtimeShadow;
+}
+
+#if ENABLE_AREA_LIGHTS
+
+// ltc_1: M⁻¹ 的 (m00, m20, m02, m22)；ltc_2: (方向反照率, 菲涅尔项, 0, 球体地平线裁剪比例)
+// RGBA32F 在部分移动 GPU 上不能线性过滤，加载时可转换为 RGBA16F
+Texture2D LtcMatrixLut;
+Texture2D LtcAmplitudeLut;
+SamplerState LtcLinearClampSampler;
+
+/**
+ * @brief 一条边对向量形状因子的贡献（v1、v2 为单位向量，θ / sinθ 的有理近似）
+ */
+float3 LtcIntegrateEdge(float3 v1, float3 v2) {
+    float x = dot(v1, v2);
+    float y = abs(x);
+    float a = 0.8543985 + (0.4965155 + 0.0145206 * y) * y;
+    float b = 3.4175940 + (4.1616724 + y) * y;
+    float v = a / b;
+    float thetaSinTheta = (x > 0.0) ? v : 0.5 * rsqrt(max(1.0 - x * x, 1e-7)) - v;
+    return cross(v1, v2) * thetaSinTheta;
+}
+
+/**
+ * @brief 把四边形裁剪到 z >= 0 的半空间，返回顶点数（0、3、4 或 5）
+ */
+int LtcClipQuadToHorizon(inout float3 L[5]) {
+    int config = 0;
+    if (L[0].z > 0.0) config += 1;
+    if (L[1].z > 0.0) config += 2;
+    if (L[2].z > 0.0) config += 4;
+    if (L[3].z > 0.0) config += 8;
+
+    int n = 0;
+    if (config == 1) {
+        n = 3;
+        L[1] = -L[1].z * L[0] + L[0].z * L[1];
+        L[2] = -L[3].z * L[0] + L[0].z * L[3];
+    } else if (config == 2) {
+        n = 3;
+        L[0] = -L[0].z * L[1] + L[1].z * L[0];
+        L[2] = -L[2].z * L[1] + L[1].z * L[2];
+    } else if (config == 3) {
+        n = 4;
+        L[2] = -L[2].z * L[1] + L[1].z * L[2];
+        L[3] = -L[3].z * L[0] + L[0].z * L[3];
+    } else if (config == 4) {
+        n = 3;
+        L[0] = -L[3].z * L[2] + L[2].z * L[3];
+        L[1] = -L[1].z * L[2] + L[2].z * L[1];
+    } else if (config == 6) {
+        n = 4;
+        L[0] = -L[0].z * L[1] + L[1].z * L[0];
+        L[3] = -L[3].z * L[2] + L[2].z * L[3];
+    } else if (config == 7) {
+        n = 5;
+        L[4] = -L[3].z * L[0] + L[0].z * L[3];
+        L[3] = -L[3].z * L[2] + L[2].z * L[3];
+    } else if (config == 8) {
+        n = 3;
+        L[0] = -L[0].z * L[3] + L[3].z * L[0];
+        L[1] = -L[2].z * L[3] + L[3].z * L[2];
+        L[2] = L[3];
+    } else if (config == 9) {
+        n = 4;
+        L[1] = -L[1].z * L[0] + L[0].z * L[1];
+        L[2] = -L[2].z * L[3] + L[3].z * L[2];
+    } else if (config == 11) {
+        n = 5;
+        L[4] = L[3];
+        L[3] = -L[2].z * L[3] + L[3].z * L[2];
+        L[2] = -L[2].z * L[1] + L[1].z * L[2];
+    } else if (config == 12) {
+        n = 4;
+        L[1] = -L[1].z * L[2] + L[2].z * L[1];
+        L[0] = -L[0].z * L[3] + L[3].z * L[0];
+    } else if (config == 13) {
+        n = 5;
+        L[4] = L[3];
+        L[3] = L[2];
+        L[2] = -L[1].z * L[2] + L[2].z * L[1];
+        L[1] = -L[1].z * L[0] + L[0].z * L[1];
+    } else if (config == 14) {
+        n = 5;
+        L[4] = -L[0].z * L[3] + L[3].z * L[0];
+        L[0] = -L[0].z * L[1] + L[1].z * L[0];
+    } else if (config == 15) {
+        n = 4;
+    }
+    return n;
+}
+
+/**
+ * @brief 矩形经 M⁻¹ 变换后地平线以上部分的形状因子
+ */
+float LtcRectFormFactor(float3 center, float3 axisX, float3 axisY, float3x3 Minv) {
+    float3 L[5];
+    L[0] = mul(Minv, center - axisX - axisY);
+    L[1] = mul(Minv, center + axisX - axisY);
+    L[2] = mul(Minv, center + axisX + axisY);
+    L[3] = mul(Minv, center - axisX + axisY);
+    L[4] = L[3];
+
+    int n = LtcClipQuadToHorizon(L);
+    if (n == 0) {
+        return 0.0;
+    }
+
+    // 不足 5 个顶点时用首个顶点闭合
+    if (n == 3) {
+        L[3] = L[0];
+    }
+    if (n == 4) {
+        L[4] = L[0];
+    }
+
+    L[0] = normalize(L[0]);
+    L[1] = normalize(L[1]);
+    L[2] = normalize(L[2]);
+    L[3] = normalize(L[3]);
+    L[4] = normalize(L[4]);
+
+    float3 sum = LtcIntegrateEdge(L[0], L[1]) + LtcIntegrateEdge(L[1], L[2]) + LtcIntegrateEdge(L[2], L[3]);
+    if (n >= 4) {
+        sum += LtcIntegrateEdge(L[3], L[4]);
+    }
+    if (n == 5) {
+        sum += LtcIntegrateEdge(L[4], L[0]);
+    }
+
+    // 绕向随着色点在正面还是背面而反转
+    return abs(sum.z);
+}
+
+/**
+ * @brief 三次方程 coefs.x + coefs.y x + coefs.z x² + coefs.w x³ = 0 的三个实根（Blinn 2007），y 为最小根
+ */
+float3 LtcSolveCubic(float4 coefs) {
+    coefs.xyz /= coefs.w;
+    coefs.yz /= 3.0;
+
+    float A = 1.0;
+    float B = coefs.z;
+    float C = coefs.y;
+    float D = coefs.x;
+
+    float3 delta = float3(-coefs.z * coefs.z + coefs.y, -coefs.y * coefs.z + coefs.x,
+                          coefs.z * coefs.x - coefs.y * coefs.y);
+    float discriminant = 4.0 * delta.x * delta.z - delta.y * delta.y;
+    float sqrtDiscriminant = sqrt(max(discriminant, 0.0));
+
+    float2 xlc;
+    {
+        float cA = delta.x;
+        float dA = -2.0 * B * delta.x + delta.y;
+        float theta = atan2(sqrtDiscriminant, -dA) / 3.0;
+        float x1 = 2.0 * sqrt(max(-cA, 0.0)) * cos(theta);
+        float x3 = 2.0 * sqrt(max(-cA, 0.0)) * cos(theta + (2.0 / 3.0) * PI);
+        float xl = ((x1 + x3) > 2.0 * B) ? x1 : x3;
+        xlc = float2(xl - B, A);
+    }
+
+    float2 xsc;
+    {
+        float cD = delta.z;
+        float dD = -D * delta.y + 2.0 * C * delta.z;
+        float theta = atan2(D * sqrtDiscriminant, -dD) / 3.0;
+        float x1 = 2.0 * sqrt(max(-cD, 0.0)) * cos(theta);
+        float x3 = 2.0 * sqrt(max(-cD, 0.0)) * cos(theta + (2.0 / 3.0) * PI);
+        float xs = (x1 + x3 < 2.0 * C) ? x1 : x3;
+        xsc = float2(-D, xs + C);
+    }
+
+    float E = xlc.y * xsc.y;
+    float F = -xlc.x * xsc.y - xlc.y * xsc.x;
+    float G = xlc.x * xsc.x;
+    float2 xmc = float2(C * F - B * G, -B * F + C * E);
+
+    float3 root = float3(xsc.x / xsc.y, xmc.x / xmc.y, xlc.x / xlc.y);
+    if (root.x < root.y && root.x < root.z) {
+        root.xyz = root.yxz;
+    } else if (root.z < root.x && root.z < root.y) {
+        root.xyz = root.xzy;
+    }
+    return root;
+}
+
+/**
+ * @brief 圆盘（椭圆）经 M⁻¹ 变换后的等效球体形状因子（地平线裁剪查 ltc_2.w）
+ */
+float LtcDiskFormFactor(float3 center, float3 axisX, float3 axisY, float3x3 Minv) {
+    float3 C = mul(Minv, center);
+    float3 V1 = mul(Minv, axisX);
+    float3 V2 = mul(Minv, axisY);
+
+    // 半轴的 Gram 矩阵特征分解，得到正交的主轴
+    float a, b;
+    float d11 = dot(V1, V1);
+    float d22 = dot(V2, V2);
+    float d12 = dot(V1, V2);
+    if (abs(d12) / sqrt(d11 * d22) > 0.0001) {
+        float tr = d11 + d22;
+        float det = sqrt(max(-d12 * d12 + d11 * d22, 0.0));
+        float u = 0.5 * sqrt(max(tr - 2.0 * det, 0.0));
+        float v = 0.5 * sqrt(tr + 2.0 * det);
+        float eMax = (u + v) * (u + v);
+        float eMin = (u - v) * (u - v);
+
+        float3 V1p, V2p;
+        if (d11 > d22) {
+            V1p = d12 * V1 + (eMax - d11) * V2;
+            V2p = d12 * V1 + (eMin - d11) * V2;
+        } else {
+            V1p = d12 * V2 + (eMax - d22) * V1;
+            V2p = d12 * V2 + (eMin - d22) * V1;
+        }
+        a = 1.0 / eMax;
+        b = 1.0 / eMin;
+        V1 = normalize(V1p);
+        V2 = normalize(V2p);
+    } else {
+        a = 1.0 / d11;
+        b = 1.0 / d22;
+        V1 *= sqrt(a);
+        V2 *= sqrt(b);
+    }
+
+    float3 V3 = cross(V1, V2);
+    if (dot(C, V3) < 0.0) {
+        V3 = -V3;
+    }
+
+    float L = dot(V3, C);
+    if (L <= 0.0) {
+        return 0.0;
+    }
+    float x0 = dot(V1, C) / L;
+    float y0 = dot(V2, C) / L;
+    a *= L * L;
+    b *= L * L;
+
+    float c0 = a * b;
+    float c1 = a * b * (1.0 + x0 * x0 + y0 * y0) - a - b;
+    float c2 = 1.0 - a * (1.0 + x0 * x0) - b * (1.0 + y0 * y0);
+    float3 roots = LtcSolveCubic(float4(c0, c1, c2, 1.0));
+    float e1 = roots.x;
+    float e2 = roots.y;
+    float e3 = roots.z;
+
+    float3 averageDirection = float3(a * x0 / (a - e2), b * y0 / (b - e2), 1.0);
+    averageDirection = normalize(V1 * averageDirection.x + V2 * averageDirection.y + V3 * averageDirection.z);
+
+    float L1 = sqrt(-e2 / e3);
+    float L2 = sqrt(-e2 / e1);
+    float formFactor = min(L1 * L2 * rsqrt((1.0 + L1 * L1) * (1.0 + L2 * L2)), 1.0);
+
+    float2 uv = float2(averageDirection.z * 0.5 + 0.5, formFactor) * LTC_LUT_SCALE + LTC_LUT_BIAS;
+    return formFactor * LtcAmplitudeLut.SampleLevel(LtcLinearClampSampler, uv, 0.0).w;
+}
+
+/** @brief 按形状选择积分 */
+float LtcFormFactor(AreaLightInput light, float3 center, float3 axisX, float3 axisY, float3x3 Minv) {
+    return light.shape == 0 ? LtcRectFormFactor(center, axisX, axisY, Minv)
+                            : LtcDiskFormFactor(center, axisX, axisY, Minv);
+}
+
+#endif // ENABLE_AREA_LIGHTS
+
+float3 CalculateAreaLighting(AreaLightInput light, float3 positionWS, float3 N, float3 V, BRDFData brdfData) {
+#if ENABLE_AREA_LIGHTS
+    float3 offset = positionWS - light.position;
+    if (dot(light.normal, offset) <= 0.0 && !light.twoSided) {
+        return (float3)0.0;
+    }
+
+    // 以 range 为半径的平滑截断
+    float ratio2 = dot(offset, offset) / max(light.range * light.range, 1e-8);
+    float window = saturate(1.0 - ratio2 * ratio2);
+    window *= window;
+
+    // 着色点局部坐标系（T1 在 N、V 平面内）
+    float NdotV = saturate(dot(N, V));
+    float3 T1 = V - N * NdotV;
+    if (dot(T1, T1) < 1e-8) {
+        T1 = abs(N.x) < 0.9 ? float3(1, 0, 0) : float3(0, 1, 0);
+        T1 = T1 - N * dot(T1, N);
+    }
+    T1 = normalize(T1);
+    float3 T2 = cross(N, T1);
+    float3x3 toLocal = float3x3(T1, T2, N);
+
+    float3 center = mul(toLocal, light.position - positionWS);
+    float3 axisX = mul(toLocal, light.tangent * (0.5 * light.size.x));
+    float3 axisY = mul(toLocal, cross(light.normal, light.tangent) * (0.5 * light.size.y));
+
+    float2 uv = float2(brdfData.perceptualRoughness, sqrt(1.0 - NdotV)) * LTC_LUT_SCALE + LTC_LUT_BIAS;
+    float4 t1 = LtcMatrixLut.SampleLevel(LtcLinearClampSampler, uv, 0.0);
+    float4 t2 = LtcAmplitudeLut.SampleLevel(LtcLinearClampSampler, uv, 0.0);
+    float3x3 Minv = float3x3(
+        t1.x, 0.0, t1.z,
+        0.0,  1.0, 0.0,
+        t1.y, 0.0, t1.w);
+    float3x3 identity = float3x3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0);
+
+    float diffuse = LtcFormFactor(light, center, axisX, axisY, identity);
+    float specular = LtcFormFactor(light, center, axisX, axisY, Minv);
+    float3 specularColor = brdfData.specular * t2.x + (1.0 - brdfData.specular) * t2.y;
+
+    return (brdfData.diffuse * diffuse + specularColor * specular) * light.color * window;
+#else
+    return (float3)0.0;
+#endif
+}
+
+#endif // PBR_COMMON_HLSL